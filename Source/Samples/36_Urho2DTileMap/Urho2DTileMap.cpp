@@ -30,7 +30,6 @@
 #include <Urho3D/Graphics/Renderer.h>
 #include <Urho3D/Resource/ResourceCache.h>
 #include <Urho3D/Scene/Scene.h>
-#include <Urho3D/Urho2D/StaticSprite2D.h>
 #include <Urho3D/UI/Text.h>
 #include <Urho3D/Urho2D/TileMap2D.h>
 #include <Urho3D/Urho2D/TileMapLayer2D.h>
@@ -194,23 +193,22 @@ void Urho2DTileMap::HandleMouseButtonDown(StringHash eventType, VariantMap& even
     int x, y;
     if (map->PositionToTileIndex(x, y, pos))
     {
-        // Get tile's sprite. Note that layer.GetTile(x, y).sprite is read-only, so we get the sprite through tile's node
-        Node* n = layer->GetTileNode(x, y);
-        if (!n)
+        // Tile data is read-only, so change the sprite rendered by the layer instead
+        Tile2D* tile = layer->GetTile(x, y);
+        if (!tile)
             return;
-        auto* sprite = n->GetComponent<StaticSprite2D>();
 
         if (input->GetMouseButtonDown(MOUSEB_RIGHT))
         {
             // Swap grass and water
-            if (layer->GetTile(x, y)->GetGid() < 9) // First 8 sprites in the "isometric_grass_and_water.png" tileset are mostly grass and from 9 to 24 they are mostly water
-                sprite->SetSprite(layer->GetTile(0, 0)->GetSprite()); // Replace grass by water sprite used in top tile
+            if (tile->GetGid() < 9) // First 8 sprites in the "isometric_grass_and_water.png" tileset are mostly grass and from 9 to 24 they are mostly water
+                layer->SetTileSprite(x, y, layer->GetTile(0, 0)->GetSprite()); // Replace grass by water sprite used in top tile
             else
-                sprite->SetSprite(layer->GetTile(24, 24)->GetSprite()); // Replace water by grass sprite used in bottom tile
+                layer->SetTileSprite(x, y, layer->GetTile(24, 24)->GetSprite()); // Replace water by grass sprite used in bottom tile
         }
         else
         {
-            sprite->SetSprite(nullptr); // 'Remove' sprite
+            layer->SetTileSprite(x, y, nullptr); // 'Remove' sprite
         }
     }
 }
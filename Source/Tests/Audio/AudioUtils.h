@@ -0,0 +1,41 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include <Urho3D/Audio/Sound.h>
+#include <Urho3D/Math/RandomEngine.h>
+
+using namespace Urho3D;
+
+namespace Tests
+{
+
+/// Create looped 16-bit mono sound from samples.
+inline SharedPtr<Sound> CreateLoopedSound(Context* context, unsigned frequency, const ea::vector<short>& data)
+{
+    auto sound = MakeShared<Sound>(context);
+    sound->SetData(data.data(), data.size() * sizeof(short));
+    sound->SetFormat(frequency, true, false);
+    sound->SetLooped(true);
+    return sound;
+}
+
+/// Create looped 16-bit mono sound filled with constant value.
+inline SharedPtr<Sound> CreateConstantSound(Context* context, unsigned frequency, unsigned numFrames, short value)
+{
+    return CreateLoopedSound(context, frequency, ea::vector<short>(numFrames, value));
+}
+
+/// Create looped 16-bit mono sound with noise.
+inline SharedPtr<Sound> CreateNoiseSound(
+    Context* context, unsigned frequency, unsigned numFrames, RandomEngine& randomEngine)
+{
+    ea::vector<short> data(numFrames);
+    for (short& value : data)
+        value = static_cast<short>(randomEngine.GetInt(-8192, 8192));
+    return CreateLoopedSound(context, frequency, data);
+}
+
+} // namespace Tests
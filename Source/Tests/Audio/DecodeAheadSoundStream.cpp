@@ -0,0 +1,125 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Audio/DecodeAheadSoundStream.h>
+#include <Urho3D/Audio/SoundStreamDecoder.h>
+#include <Urho3D/Core/Timer.h>
+
+namespace
+{
+
+/// Stream that produces 16-bit sample indices up to the limit.
+class CountingSoundStream : public SoundStream
+{
+public:
+    explicit CountingSoundStream(unsigned numSamples)
+        : numSamples_(numSamples)
+    {
+        SetFormat(44100, true, false);
+        SetStopAtEnd(true);
+    }
+
+    bool Seek(unsigned sample_number) override
+    {
+        position_ = Min(sample_number, numSamples_);
+        return true;
+    }
+
+    unsigned GetData(signed char* dest, unsigned numBytes) override
+    {
+        auto* samples = reinterpret_cast<short*>(dest);
+        const unsigned count = Min(numBytes / 2, numSamples_ - position_);
+        for (unsigned i = 0; i < count; ++i)
+            samples[i] = static_cast<short>(position_++);
+        return count * 2;
+    }
+
+    bool IsDecodeAheadSupported() const override { return true; }
+
+private:
+    const unsigned numSamples_;
+    unsigned position_{};
+};
+
+/// Read all data from the stream in portions of given size.
+ea::vector<short> ReadSamples(SoundStream* stream, unsigned portionSize)
+{
+    ea::vector<short> result;
+    ea::vector<short> buffer(portionSize);
+    while (const unsigned numBytes = stream->GetData(reinterpret_cast<signed char*>(buffer.data()), portionSize * 2))
+        result.insert(result.end(), buffer.begin(), buffer.begin() + numBytes / 2);
+    return result;
+}
+
+}
+
+TEST_CASE("Decode-ahead sound stream produces data of wrapped stream")
+{
+    static const unsigned numSamples = 10000;
+    ea::vector<short> expectedSamples(numSamples);
+    for (unsigned i = 0; i < numSamples; ++i)
+        expectedSamples[i] = static_cast<short>(i);
+
+    SECTION("Data is decoded in place if not decoded ahead")
+    {
+        auto stream = MakeShared<DecodeAheadSoundStream>(new CountingSoundStream(numSamples), 1000);
+        CHECK(ReadSamples(stream, 300) == expectedSamples);
+        CHECK(stream->GetNumUnderrunBytes() == numSamples * 2);
+        CHECK(stream->IsEndOfStream());
+    }
+
+    SECTION("Data decoded ahead is consumed first")
+    {
+        auto stream = MakeShared<DecodeAheadSoundStream>(new CountingSoundStream(numSamples), 1000);
+        CHECK(stream->DecodeAhead(600) == 600);
+
+        ea::vector<short> samples(200);
+        auto* dest = reinterpret_cast<signed char*>(samples.data());
+        CHECK(stream->GetData(dest, 400) == 400);
+        CHECK(stream->GetNumUnderrunBytes() == 0);
+        CHECK(stream->GetData(dest, 400) == 400);
+        CHECK(stream->GetNumUnderrunBytes() == 200);
+        CHECK(samples == ea::vector<short>(expectedSamples.begin() + 200, expectedSamples.begin() + 400));
+
+        // Ring buffer wraps around
+        CHECK(stream->DecodeAhead(2000) == 1000);
+        CHECK(ReadSamples(stream, 128) == ea::vector<short>(expectedSamples.begin() + 400, expectedSamples.end()));
+    }
+
+    SECTION("Decode-ahead data is discarded on seek")
+    {
+        auto stream = MakeShared<DecodeAheadSoundStream>(new CountingSoundStream(numSamples), 1000);
+        stream->DecodeAhead(1000);
+        CHECK(stream->GetBufferNumBytes() == 1000);
+        REQUIRE(stream->Seek(numSamples - 100));
+        CHECK(stream->GetBufferNumBytes() == 0);
+
+        const ea::vector<short> samples = ReadSamples(stream, 64);
+        CHECK(samples == ea::vector<short>(expectedSamples.end() - 100, expectedSamples.end()));
+    }
+
+#ifdef URHO3D_THREADING
+    SECTION("Decoder thread fills the stream ahead of playback")
+    {
+        auto decoder = MakeShared<SoundStreamDecoder>();
+        auto stream = MakeShared<DecodeAheadSoundStream>(new CountingSoundStream(numSamples), 4000);
+        decoder->AddStream(stream);
+
+        HiresTimer timer;
+        while (stream->GetBufferNumBytes() < stream->GetBufferSize() && timer.GetUSec(false) < 5000000)
+            Time::Sleep(1);
+        CHECK(stream->GetBufferNumBytes() == stream->GetBufferSize());
+
+        CHECK(ReadSamples(stream, 256) == expectedSamples);
+
+        // Stream is released by decoder when no longer used
+        stream = nullptr;
+        while (decoder->GetNumStreams() != 0 && timer.GetUSec(false) < 5000000)
+            Time::Sleep(1);
+        CHECK(decoder->GetNumStreams() == 0);
+    }
+#endif
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "AudioUtils.h"
+
+#include <Urho3D/Audio/Audio.h>
+#include <Urho3D/Audio/Sound.h>
+#include <Urho3D/Audio/SoundSource.h>
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/Scene/Scene.h>
+
+TEST_CASE("Audio is mixed offline by engine clock and on demand")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto audio = context->GetSubsystem<Audio>();
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+
+    static const int mixRate = 22050;
+
+    REQUIRE(audio->SetOfflineMode(mixRate, SPK_STEREO, false));
+    REQUIRE(audio->IsInitialized());
+    REQUIRE(audio->IsOffline());
+    REQUIRE(audio->IsPlaying());
+    audio->SetOfflineRecording(true);
+    audio->ResetMixStatistics();
+
+    auto scene = MakeShared<Scene>(context);
+    auto source = scene->CreateComponent<SoundSource>();
+    source->Play(Tests::CreateConstantSound(context, mixRate, 512, 1000));
+
+    // Fractional samples are carried over to the next frame
+    audio->Update(0.25f);
+    CHECK(audio->GetOfflineOutput().size() == 5512 * 2);
+    audio->Update(0.25f);
+    CHECK(audio->GetOfflineOutput().size() == 11025 * 2);
+    CHECK(audio->GetFrameMixStatistics().numSamples_ == 5512);
+
+    // Render faster than real time
+    audio->RenderOffline(1000);
+    audio->Update(0.0f);
+
+    const ea::vector<short>& output = audio->GetOfflineOutput();
+    REQUIRE(output.size() == 12025 * 2);
+    for (const short value : output)
+        REQUIRE(value == 1000);
+
+    const AudioMixStatistics& frameStats = audio->GetFrameMixStatistics();
+    CHECK(frameStats.numMixes_ == 2);
+    CHECK(frameStats.numSamples_ == 5513 + 1000);
+
+    const AudioMixStatistics& totalStats = audio->GetTotalMixStatistics();
+    CHECK(totalStats.numMixes_ == 3);
+    CHECK(totalStats.numSamples_ == 12025);
+    CHECK(totalStats.maxRealVoices_ == 1);
+    CHECK(totalStats.maxVirtualVoices_ == 0);
+    CHECK(totalStats.maxMixTimeUSec_ <= totalStats.mixTimeUSec_);
+
+    // Saved output is loaded back as sound
+    const ea::string fileName = Format("{}OfflineAudioTest-{}.wav", fileSystem->GetTemporaryDir(), GenerateUUID());
+    REQUIRE(audio->SaveOfflineOutput(fileName));
+    {
+        File file(context, fileName);
+        auto sound = MakeShared<Sound>(context);
+        REQUIRE(sound->Load(file));
+        CHECK(sound->GetIntFrequency() == mixRate);
+        CHECK(sound->IsSixteenBit());
+        CHECK(sound->IsStereo());
+        CHECK(sound->GetDataSize() == 12025 * 2 * sizeof(short));
+        CHECK(reinterpret_cast<const short*>(sound->GetStart())[100] == 1000);
+    }
+    fileSystem->Delete(fileName);
+
+    // Output without recording keeps only the last mixed samples
+    audio->SetOfflineRecording(false);
+    audio->RenderOffline(100);
+    CHECK(audio->GetOfflineOutput().size() == 100 * 2);
+
+    audio->Close();
+    CHECK_FALSE(audio->IsInitialized());
+    CHECK_FALSE(audio->IsOffline());
+    CHECK_FALSE(audio->IsPlaying());
+}
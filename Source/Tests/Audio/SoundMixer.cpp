@@ -0,0 +1,145 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "AudioUtils.h"
+
+#include <Urho3D/Audio/Audio.h>
+#include <Urho3D/Audio/Sound.h>
+#include <Urho3D/Audio/SoundSource.h>
+#include <Urho3D/Scene/Scene.h>
+
+TEST_CASE("Sound sources are mixed into float buffer with panning")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto audio = context->GetSubsystem<Audio>();
+
+    static const int mixRate = 44100;
+    static const unsigned numFrames = 1000;
+
+    auto scene = MakeShared<Scene>(context);
+    auto sound = Tests::CreateConstantSound(context, mixRate, 512, 1000);
+
+    auto source = scene->CreateComponent<SoundSource>();
+    source->SetGain(0.5f);
+    source->SetPanning(0.5f);
+    source->Play(sound);
+
+    ea::vector<float> buffer(numFrames * 2);
+    audio->MixSoundSources(buffer.data(), numFrames, mixRate, SPK_STEREO, true);
+
+    for (unsigned i = 0; i < numFrames; ++i)
+    {
+        REQUIRE(buffer[i * 2] == Catch::Approx(1000.0f * 0.5f * 0.5f));
+        REQUIRE(buffer[i * 2 + 1] == Catch::Approx(1000.0f * 0.5f * 1.5f));
+    }
+
+    buffer.resize(numFrames * 6);
+    audio->MixSoundSources(buffer.data(), numFrames, mixRate, SPK_SURROUND_5_1, false);
+
+    for (unsigned i = 0; i < numFrames; ++i)
+    {
+        const float* frame = &buffer[i * 6];
+        REQUIRE(frame[0] == Catch::Approx(1000.0f * 0.5f * 0.5f));
+        REQUIRE(frame[1] == Catch::Approx(1000.0f * 0.5f * 1.5f));
+        REQUIRE(frame[2] == 0.0f);
+        REQUIRE(frame[3] == 0.0f);
+        REQUIRE(frame[4] == Catch::Approx(1000.0f * 0.5f * 0.5f));
+        REQUIRE(frame[5] == Catch::Approx(1000.0f * 0.5f * 1.5f));
+    }
+}
+
+TEST_CASE("Sound sources over voice limit are virtualized")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto audio = context->GetSubsystem<Audio>();
+
+    static const int mixRate = 44100;
+    static const unsigned numFrames = 1024;
+    static const unsigned numSources = 8;
+
+    auto scene = MakeShared<Scene>(context);
+    auto sound = Tests::CreateConstantSound(context, mixRate, 4096, 100);
+
+    ea::vector<SoundSource*> sources;
+    for (unsigned i = 0; i < numSources; ++i)
+    {
+        auto source = scene->CreateComponent<SoundSource>();
+        source->SetGain(0.1f * (i + 1));
+        source->Play(sound);
+        sources.push_back(source);
+    }
+    sources[0]->SetPriority(1);
+
+    audio->SetMaxRealVoices(4);
+    ea::vector<float> buffer(numFrames);
+    audio->MixSoundSources(buffer.data(), numFrames, mixRate, SPK_MONO, false);
+    audio->SetMaxRealVoices(0);
+
+    CHECK(audio->GetNumRealVoices() == 4);
+    CHECK(audio->GetNumVirtualVoices() == 4);
+
+    // Prioritized source and three loudest sources are mixed
+    const float expectedValue = 100.0f * (0.1f + 0.6f + 0.7f + 0.8f);
+    CHECK(buffer.front() == Catch::Approx(expectedValue));
+    CHECK(buffer.back() == Catch::Approx(expectedValue));
+    for (unsigned i = 0; i < numSources; ++i)
+    {
+        CHECK(sources[i]->IsVirtualized() == (i >= 1 && i <= 4));
+        CHECK(sources[i]->GetPositionAttr() == static_cast<int>(numFrames * sizeof(short)));
+    }
+}
+
+TEST_CASE("Disabled and paused sound sources do not take real voices")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto audio = context->GetSubsystem<Audio>();
+
+    static const int mixRate = 44100;
+    static const unsigned numFrames = 1024;
+
+    auto scene = MakeShared<Scene>(context);
+    auto pausedScene = MakeShared<Scene>(context);
+    pausedScene->SetUpdateEnabled(false);
+    auto sound = Tests::CreateConstantSound(context, mixRate, 4096, 100);
+
+    // Loudest sources are disabled or paused
+    auto disabledSource = scene->CreateComponent<SoundSource>();
+    disabledSource->SetGain(1.0f);
+    disabledSource->Play(sound);
+    disabledSource->SetEnabled(false);
+
+    auto pausedSource = pausedScene->CreateComponent<SoundSource>();
+    pausedSource->SetGain(0.9f);
+    pausedSource->Play(sound);
+
+    auto quietSourceA = scene->CreateComponent<SoundSource>();
+    quietSourceA->SetGain(0.1f);
+    quietSourceA->Play(sound);
+
+    auto quietSourceB = scene->CreateComponent<SoundSource>();
+    quietSourceB->SetGain(0.2f);
+    quietSourceB->Play(sound);
+
+    CHECK(disabledSource->IsPlaying());
+    CHECK_FALSE(disabledSource->IsPlayingEffective());
+    CHECK(pausedSource->IsPlaying());
+    CHECK_FALSE(pausedSource->IsPlayingEffective());
+
+    audio->SetMaxRealVoices(2);
+    ea::vector<float> buffer(numFrames);
+    audio->MixSoundSources(buffer.data(), numFrames, mixRate, SPK_MONO, false);
+    audio->SetMaxRealVoices(0);
+
+    CHECK(audio->GetNumRealVoices() == 2);
+    CHECK(audio->GetNumVirtualVoices() == 0);
+    CHECK(buffer.front() == Catch::Approx(100.0f * (0.1f + 0.2f)));
+    CHECK(buffer.back() == Catch::Approx(100.0f * (0.1f + 0.2f)));
+    CHECK_FALSE(quietSourceA->IsVirtualized());
+    CHECK_FALSE(quietSourceB->IsVirtualized());
+
+    // Disabled and paused sources keep their playback position
+    CHECK(disabledSource->GetPositionAttr() == 0);
+    CHECK(pausedSource->GetPositionAttr() == 0);
+}
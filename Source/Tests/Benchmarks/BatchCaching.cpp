@@ -0,0 +1,35 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../UI/UIUtils.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/UI/UIBatch.h>
+
+TEST_CASE("UI batch caching performance is measured")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto root = Tests::CreateImageGrid(context, 100);
+
+    const auto measure = [&](const char* name, bool useCache)
+    {
+        ea::vector<UIBatch> batches;
+        ea::vector<float> vertexData;
+
+        HiresTimer timer;
+        const unsigned numUpdates = Tests::CollectBatches(root, batches, vertexData, useCache);
+        const long long elapsedUSec = timer.GetUSec(false);
+
+        WARN(Format("{}: {} elements, {} regenerated in {:.3f} ms", name, root->GetNumChildren(), numUpdates,
+            elapsedUSec / 1000.0).c_str());
+    };
+
+    measure("Uncached", false);
+    measure("Cached, first frame", true);
+    measure("Cached, static frame", true);
+
+    root->GetChild(5000u)->SetColor(Color::RED);
+    measure("Cached, one element changed", true);
+}
@@ -0,0 +1,44 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#if URHO3D_PHYSICS2D
+
+#include "../CommonUtils.h"
+#include "../Physics2D/Physics2DUtils.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Physics2D/PhysicsWorld2D.h>
+#include <Urho3D/Scene/Scene.h>
+
+TEST_CASE("PhysicsWorld2D contact processing performance is measured")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    static const unsigned numObjects = 20000;
+    static const unsigned numSteps = 120;
+
+    const auto measure = [&](const char* name, bool events, bool report, bool multiThreaded)
+    {
+        auto scene = Tests::CreatePile(context, numObjects, 200);
+        auto physicsWorld = scene->GetComponent<PhysicsWorld2D>();
+        physicsWorld->SetContactEventsEnabled(events);
+        physicsWorld->SetContactReportEnabled(report);
+        physicsWorld->SetMultiThreaded(multiThreaded);
+
+        unsigned numReportedContacts = 0;
+        HiresTimer timer;
+        for (unsigned i = 0; i < numSteps; ++i)
+        {
+            physicsWorld->Update(1.0f / 60.0f);
+            numReportedContacts += physicsWorld->GetContactReport().size();
+        }
+        WARN(Format("{}: {} bodies, {} steps in {:.3f} ms, {} reported contacts", name, numObjects, numSteps,
+            timer.GetUSec(false) / 1000.0, numReportedContacts).c_str());
+    };
+
+    measure("Events", true, false, false);
+    measure("Report", false, true, false);
+    measure("Report, multi-threaded", false, true, true);
+}
+
+#endif
@@ -0,0 +1,44 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../SceneUtils.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Scene/Scene.h>
+
+TEST_CASE("Cooked scene load time is compared to other formats")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = Tests::CreateTestScene(context, 10000);
+
+    VectorBuffer xmlData;
+    VectorBuffer jsonData;
+    VectorBuffer binaryData;
+    VectorBuffer cookedData;
+    REQUIRE(scene->SaveXML(xmlData));
+    REQUIRE(scene->SaveJSON(jsonData));
+    REQUIRE(scene->Save(binaryData));
+    REQUIRE(scene->SaveCooked(cookedData));
+
+    const auto measureLoad = [&](const char* format, const VectorBuffer& data)
+    {
+        auto loadedScene = MakeShared<Scene>(context);
+        MemoryBuffer readBuffer(data);
+
+        HiresTimer timer;
+        REQUIRE(loadedScene->Load(readBuffer));
+        const long long elapsedUSec = timer.GetUSec(false);
+
+        REQUIRE(loadedScene->GetNumChildren() == 10000);
+        WARN(Format("{}: {} bytes, loaded in {} ms", format, data.GetSize(), elapsedUSec / 1000).c_str());
+    };
+
+    measureLoad("XML", xmlData);
+    measureLoad("JSON", jsonData);
+    measureLoad("Binary", binaryData);
+    measureLoad("Cooked", cookedData);
+}
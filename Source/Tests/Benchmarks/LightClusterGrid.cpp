@@ -0,0 +1,45 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../Graphics/GraphicsUtils.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/RenderPipeline/LightClusterGrid.h>
+#include <Urho3D/Scene/Node.h>
+
+TEST_CASE("Light cluster grid build time is measured")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+
+    auto cameraNode = MakeShared<Node>(context);
+    auto camera = cameraNode->CreateComponent<Camera>();
+    camera->SetAspectRatio(16.0f / 9.0f);
+    camera->SetFarClip(300.0f);
+
+    RandomEngine random(0);
+    const ea::vector<Sphere> lightBounds = Tests::CreateRandomLightBounds(1000, random);
+
+    auto grid = MakeShared<LightClusterGrid>(context);
+    const auto measureBuild = [&](const char* name, WorkQueue* queue)
+    {
+        static const unsigned numIterations = 100;
+        grid->Build(camera, lightBounds, queue);
+
+        HiresTimer timer;
+        for (unsigned i = 0; i < numIterations; ++i)
+            grid->Build(camera, lightBounds, queue);
+        const long long elapsedUSec = timer.GetUSec(false);
+
+        WARN(Format("{}: {} lights, {} light indices, built in {:.3f} ms", name, lightBounds.size(),
+            grid->GetNumLightIndices(), elapsedUSec / 1000.0 / numIterations).c_str());
+    };
+
+    measureBuild("Single thread", nullptr);
+    measureBuild("Work queue", workQueue);
+}
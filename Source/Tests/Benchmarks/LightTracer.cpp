@@ -0,0 +1,86 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#if URHO3D_GLOW
+
+#include "../Glow/GlowUtils.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Glow/LightTracer.h>
+#include <Urho3D/Glow/RaytracerScene.h>
+#include <Urho3D/Graphics/Light.h>
+#include <Urho3D/Math/TetrahedralMesh.h>
+#include <Urho3D/Scene/Scene.h>
+
+#include <thread>
+
+TEST_CASE("Lightmap light tracing performance is measured")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    static const unsigned lightmapSize = 256;
+    static const float floorSize = 40.0f;
+
+    // Create floor and grid of lightmapped boxes casting shadows
+    auto scene = MakeShared<Scene>(context);
+    const ea::vector<Component*> geometries = Tests::CreateFloorWithBoxes(scene, floorSize, 4);
+    Light* light = Tests::CreateBakedDirectionalLight(scene, 2.0f);
+
+    const auto raytracerScene = Tests::CreateRaytracingSceneWithWhiteBackground(context, geometries);
+    REQUIRE(raytracerScene);
+
+    const LightmapChartGeometryBuffer geometryBuffer = Tests::CreateFloorGeometryBuffer(lightmapSize, floorSize);
+    const ea::vector<unsigned> geometryBufferToRaytracer{M_MAX_UNSIGNED, 0};
+    const unsigned numTexels = lightmapSize * lightmapSize;
+
+    const unsigned numTasks = ea::max(1u, std::thread::hardware_concurrency());
+    DirectLightTracingSettings directSettings{16};
+    directSettings.numTasks_ = numTasks;
+    IndirectLightTracingSettings indirectSettings{16, 2};
+    indirectSettings.numTasks_ = numTasks;
+
+    // Measure direct light
+    const BakedLight bakedLight{light};
+    LightmapChartBakedDirect bakedDirect{lightmapSize};
+    {
+        HiresTimer timer;
+        BakeDirectLightForCharts(
+            bakedDirect, geometryBuffer, *raytracerScene, geometryBufferToRaytracer, bakedLight, directSettings);
+        const long long elapsedUSec = timer.GetUSec(false);
+
+        const double numRays = static_cast<double>(numTexels) * directSettings.maxSamples_;
+        WARN(Format("Direct light: {} texels, {} samples, traced in {:.3f} ms, {:.2f} Mrays/s", numTexels,
+            directSettings.maxSamples_, elapsedUSec / 1000.0, numRays / elapsedUSec).c_str());
+    }
+
+    // Measure indirect light
+    const TetrahedralMesh lightProbesMesh;
+    const LightProbeCollectionBakedData lightProbesData;
+    const ea::vector<const LightmapChartBakedDirect*> bakedDirectCharts{&bakedDirect};
+    LightmapChartBakedIndirect bakedIndirect{lightmapSize};
+    {
+        HiresTimer timer;
+        BakeIndirectLightForCharts(bakedIndirect, bakedDirectCharts, geometryBuffer, lightProbesMesh, lightProbesData,
+            *raytracerScene, geometryBufferToRaytracer, indirectSettings);
+        const long long elapsedUSec = timer.GetUSec(false);
+
+        const double numPaths = static_cast<double>(numTexels) * indirectSettings.maxSamples_;
+        WARN(Format("Indirect light: {} texels, {} samples, {} bounces, traced in {:.3f} ms, {:.2f} Mpaths/s",
+            numTexels, indirectSettings.maxSamples_, indirectSettings.maxBounces_, elapsedUSec / 1000.0,
+            numPaths / elapsedUSec).c_str());
+    }
+
+    unsigned numLitTexels = 0;
+    for (const Vector3& directLight : bakedDirect.directLight_)
+    {
+        if (directLight != Vector3::ZERO)
+            ++numLitTexels;
+    }
+    CHECK(numLitTexels > 0);
+    CHECK(numLitTexels < numTexels);
+}
+
+#endif
@@ -0,0 +1,47 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#if URHO3D_GLOW
+
+#include "../Glow/GlowUtils.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Glow/LightmapFilter.h>
+
+#include <thread>
+
+TEST_CASE("Lightmap filter quality and performance are measured")
+{
+    static const unsigned lightmapSize = 1024;
+    static const unsigned numTexels = lightmapSize * lightmapSize;
+    const LightmapChartGeometryBuffer geometryBuffer = Tests::CreateWallsGeometryBuffer(lightmapSize);
+    const unsigned numTasks = ea::max(1u, std::thread::hardware_concurrency());
+
+    const LightmapChartBakedIndirect bakedIndirect = Tests::CreateNoisyWallsLight(geometryBuffer);
+
+    ea::vector<Vector4> outputBuffer(numTexels);
+    WARN(Format("Unfiltered: RMSE {:.4f}", Tests::CalculateWallsLightError(bakedIndirect.light_, geometryBuffer)).c_str());
+
+    for (const int kernelRadius : {2, 5})
+    {
+        for (const LightmapFilterMethod method : {LightmapFilterMethod::Gauss, LightmapFilterMethod::ATrous})
+        {
+            EdgeStoppingGaussFilterParameters params;
+            params.kernelRadius_ = kernelRadius;
+            params.method_ = method;
+
+            HiresTimer timer;
+            FilterIndirectLight(bakedIndirect, outputBuffer, geometryBuffer, params, numTasks);
+            const long long elapsedUSec = timer.GetUSec(false);
+
+            WARN(Format("{} filter, radius {}: {} texels filtered in {:.3f} ms, RMSE {:.4f}",
+                method == LightmapFilterMethod::Gauss ? "Gauss" : "A-trous", kernelRadius, numTexels,
+                elapsedUSec / 1000.0, Tests::CalculateWallsLightError(outputBuffer, geometryBuffer)).c_str());
+        }
+    }
+}
+
+#endif
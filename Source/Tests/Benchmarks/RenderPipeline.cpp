@@ -0,0 +1,117 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../Graphics/GraphicsUtils.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/GraphicsEvents.h>
+#include <Urho3D/Graphics/Renderer.h>
+#include <Urho3D/Graphics/Viewport.h>
+#include <Urho3D/RenderAPI/RenderDevice.h>
+#include <Urho3D/RenderPipeline/RenderPipeline.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Resource/XMLFile.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+/// Same content as 20_HugeObjectCount sample without groups.
+SharedPtr<Scene> CreateHugeObjectCountScene(Context* context, Node* cameraNode)
+{
+    auto scene = MakeShared<Scene>(context);
+    Tests::CreateLitBoxGrid(scene, 125, 0.3f, 0.25f);
+
+    cameraNode->SetPosition(Vector3(0.0f, 10.0f, -100.0f));
+    cameraNode->GetComponent<Camera>()->SetFarClip(300.0f);
+    return scene;
+}
+
+/// Same content as 108_RenderingShowcase sample.
+SharedPtr<Scene> CreateRenderingShowcaseScene(Context* context, Node* cameraNode)
+{
+    auto cache = context->GetSubsystem<ResourceCache>();
+
+    auto scene = MakeShared<Scene>(context);
+    auto xmlFile = cache->GetResource<XMLFile>("Scenes/RenderingShowcase_2_Dynamic.xml");
+    REQUIRE(xmlFile);
+    REQUIRE(scene->LoadXML(xmlFile->GetRoot()));
+
+    cameraNode->SetPosition({0.0f, 4.0f, 8.0f});
+    cameraNode->LookAt(Vector3::ZERO);
+    return scene;
+}
+
+} // namespace
+
+TEST_CASE("RenderPipeline CPU time is measured with null render backend")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateNullBackendContext);
+    auto renderer = context->GetSubsystem<Renderer>();
+    auto renderDevice = context->GetSubsystem<RenderDevice>();
+    REQUIRE(renderDevice);
+    REQUIRE(renderDevice->GetBackend() == RenderBackend::Null);
+
+    // Accumulate time spent in view update and rendering
+    Serializable subscriber(context);
+    HiresTimer stageTimer;
+    long long updateUSec = 0;
+    long long renderUSec = 0;
+    subscriber.SubscribeToEvent(E_BEGINVIEWUPDATE, [&] { stageTimer.Reset(); });
+    subscriber.SubscribeToEvent(E_ENDVIEWUPDATE, [&] { updateUSec += stageTimer.GetUSec(false); });
+    subscriber.SubscribeToEvent(E_BEGINVIEWRENDER, [&] { stageTimer.Reset(); });
+    subscriber.SubscribeToEvent(E_ENDVIEWRENDER, [&] { renderUSec += stageTimer.GetUSec(false); });
+
+    const auto measureScene = [&](const char* name, SharedPtr<Scene> (*createScene)(Context*, Node*))
+    {
+        auto cameraNode = MakeShared<Node>(context);
+        auto camera = cameraNode->CreateComponent<Camera>();
+        auto scene = createScene(context, cameraNode);
+        auto viewport = MakeShared<Viewport>(context, scene, camera);
+        renderer->SetViewport(0, viewport);
+
+        // Warm up caches, pipeline states and batch queues
+        for (unsigned i = 0; i < 10; ++i)
+            Tests::RunFrame(context, 0.01f);
+
+        RenderPipelineView* view = viewport->GetRenderPipelineView();
+        REQUIRE(view);
+
+        static const unsigned numFrames = 100;
+        updateUSec = 0;
+        renderUSec = 0;
+        RenderPipelineStats stageStats;
+        unsigned numDraws = 0;
+        HiresTimer frameTimer;
+        for (unsigned i = 0; i < numFrames; ++i)
+        {
+            Tests::RunFrame(context, 0.01f);
+            numDraws += renderDevice->GetStats().numDraws_;
+
+            const RenderPipelineStats& stats = view->GetStats();
+            stageStats.occlusionAndVisibilityTime_ += stats.occlusionAndVisibilityTime_;
+            stageStats.drawableProcessingTime_ += stats.drawableProcessingTime_;
+            stageStats.batchCompositionTime_ += stats.batchCompositionTime_;
+            stageStats.batchRenderingTime_ += stats.batchRenderingTime_;
+        }
+        const long long frameUSec = frameTimer.GetUSec(false);
+
+        renderer->SetViewport(0, nullptr);
+
+        const auto toMSec = [](long long usec) { return usec / 1000.0 / numFrames; };
+        CHECK(numDraws > 0);
+        WARN(Format("{}: frame {:.3f} ms, {} draws\n"
+                    "  view update {:.3f} ms: visibility {:.3f} ms, drawables {:.3f} ms, batch composition {:.3f} ms\n"
+                    "  view render {:.3f} ms: batch rendering {:.3f} ms",
+            name, toMSec(frameUSec), numDraws / numFrames, toMSec(updateUSec),
+            toMSec(stageStats.occlusionAndVisibilityTime_), toMSec(stageStats.drawableProcessingTime_),
+            toMSec(stageStats.batchCompositionTime_), toMSec(renderUSec), toMSec(stageStats.batchRenderingTime_))
+                 .c_str());
+    };
+
+    measureScene("HugeObjectCount", CreateHugeObjectCountScene);
+    measureScene("RenderingShowcase", CreateRenderingShowcaseScene);
+}
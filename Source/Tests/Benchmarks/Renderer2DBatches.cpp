@@ -0,0 +1,39 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../Urho2D/Urho2DUtils.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Urho2D/Renderer2D.h>
+
+#include <EASTL/sort.h>
+
+TEST_CASE("Renderer2D source batch sorting performance is measured")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto renderer = MakeShared<Renderer2D>(context);
+    const auto materials = Tests::CreateMaterials(context, 16);
+
+    static const unsigned numBatches = 200000;
+    SetRandomSeed(1);
+    const ea::vector<SourceBatch2D> sourceBatches = Tests::CreateSourceBatches(materials, numBatches, 10, 100000);
+
+    {
+        ea::vector<const SourceBatch2D*> sortedBatches = Tests::GetPointers(sourceBatches);
+        HiresTimer timer;
+        ea::quick_sort(sortedBatches.begin(), sortedBatches.end(), Tests::CompareSourceBatches);
+        WARN(Format("Comparison sort: {} source batches in {:.3f} ms", numBatches, timer.GetUSec(false) / 1000.0).c_str());
+    }
+
+    {
+        ea::vector<const SourceBatch2D*> sortedBatches = Tests::GetPointers(sourceBatches);
+        renderer->SortSourceBatches(sortedBatches);
+
+        sortedBatches = Tests::GetPointers(sourceBatches);
+        HiresTimer timer;
+        renderer->SortSourceBatches(sortedBatches);
+        WARN(Format("Radix sort: {} source batches in {:.3f} ms", numBatches, timer.GetUSec(false) / 1000.0).c_str());
+    }
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../Audio/AudioUtils.h"
+
+#include <Urho3D/Audio/Audio.h>
+#include <Urho3D/Audio/Sound.h>
+#include <Urho3D/Audio/SoundSource.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Scene/Scene.h>
+
+TEST_CASE("Sound mixer performance is measured")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto audio = context->GetSubsystem<Audio>();
+
+    static const int mixRate = 44100;
+    static const unsigned fragmentSize = 1024;
+    static const unsigned numSources = 320;
+    static const unsigned numFragments = 43;
+
+    RandomEngine randomEngine{0};
+    auto scene = MakeShared<Scene>(context);
+    auto sound = Tests::CreateNoiseSound(context, 22050, 22050, randomEngine);
+
+    for (unsigned i = 0; i < numSources; ++i)
+    {
+        // Emulate 3D sound sources with doppler effect
+        auto source = scene->CreateComponent<SoundSource>();
+        source->SetFrequency(sound->GetFrequency() * randomEngine.GetFloat(0.9f, 1.1f));
+        source->SetAttenuation(randomEngine.GetFloat(0.0f, 1.0f));
+        source->SetPanning(randomEngine.GetFloat(-1.0f, 1.0f));
+        source->SetReach(randomEngine.GetFloat(-1.0f, 1.0f));
+        source->Play(sound);
+    }
+
+    for (const SpeakerMode speakerMode : {SPK_STEREO, SPK_SURROUND_5_1})
+    {
+        for (const unsigned maxRealVoices : {0u, 64u})
+        {
+            ea::vector<float> buffer(fragmentSize * AUDIO_NUM_CHANNELS[speakerMode]);
+            audio->SetMaxRealVoices(maxRealVoices);
+
+            HiresTimer timer;
+            for (unsigned i = 0; i < numFragments; ++i)
+                audio->MixSoundSources(buffer.data(), fragmentSize, mixRate, speakerMode, true);
+            const long long elapsedUSec = timer.GetUSec(false);
+
+            const double mixedMSec = 1000.0 * numFragments * fragmentSize / mixRate;
+            WARN(Format("{} channels, {} sources, {} real voices: {:.3f} ms of audio mixed in {:.3f} ms",
+                AUDIO_NUM_CHANNELS[speakerMode], numSources, audio->GetNumRealVoices(), mixedMSec,
+                elapsedUSec / 1000.0).c_str());
+        }
+    }
+
+    audio->SetMaxRealVoices(0);
+}
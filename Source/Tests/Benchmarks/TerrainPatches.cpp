@@ -0,0 +1,34 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../Graphics/GraphicsUtils.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Graphics/Terrain.h>
+#include <Urho3D/Resource/Image.h>
+#include <Urho3D/Scene/Scene.h>
+
+TEST_CASE("Terrain patch generation performance is measured")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    static const int heightMapSize = 2049;
+    auto heightMap = Tests::CreateHeightMap(context, heightMapSize);
+
+    {
+        HiresTimer timer;
+        Tests::CreateTerrain(scene, heightMap, 32, 4, false);
+        WARN(Format("Sync: {0}x{0} terrain created in {1:.3f} ms", heightMapSize, timer.GetUSec(false) / 1000.0).c_str());
+    }
+
+    {
+        HiresTimer timer;
+        Terrain* terrain = Tests::CreateTerrain(scene, heightMap, 32, 4, true);
+        const double createTime = timer.GetUSec(false) / 1000.0;
+        terrain->CompletePatchGeneration();
+        WARN(Format("Async: {0}x{0} terrain created in {1:.3f} ms, completed in {2:.3f} ms", heightMapSize, createTime,
+            timer.GetUSec(false) / 1000.0).c_str());
+    }
+}
@@ -0,0 +1,51 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../Math/MathUtils.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Math/TetrahedralMesh.h>
+
+TEST_CASE("Tetrahedral mesh sampling performance is measured")
+{
+    RandomEngine randomEngine{0};
+    TetrahedralMesh mesh = Tests::CreateJitteredGridMesh(24, 4.0f, randomEngine);
+
+    ea::vector<float> values;
+    for (const Vector3& vertex : mesh.vertices_)
+        values.push_back(Tests::GetTestValue(vertex));
+
+    // Objects jump far between frames, e.g. after teleport or for new objects
+    static const unsigned numPositions = 20000;
+    ea::vector<Vector3> positions(numPositions);
+    for (Vector3& position : positions)
+        position = randomEngine.GetVector3(Vector3::ZERO, Vector3::ONE * 96.0f);
+
+    const auto measure = [&](const char* name, bool isBatch)
+    {
+        ea::vector<unsigned> hints(numPositions, 0);
+        ea::vector<Vector4> weights(numPositions);
+
+        HiresTimer timer;
+        if (isBatch)
+            mesh.GetInterpolationFactors(positions, hints, weights);
+        else
+        {
+            for (unsigned i = 0; i < numPositions; ++i)
+                weights[i] = mesh.GetInterpolationFactors(positions[i], hints[i]);
+        }
+        const long long elapsedUSec = timer.GetUSec(false);
+
+        WARN(Format("{}: {} positions sampled in {:.3f} ms", name, numPositions, elapsedUSec / 1000.0).c_str());
+    };
+
+    measure("Per-object", false);
+    measure("Batch", true);
+
+    mesh.BuildLookupGrid(32);
+    measure("Per-object with lookup grid", false);
+    measure("Batch with lookup grid", true);
+}
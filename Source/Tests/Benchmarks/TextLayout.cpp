@@ -0,0 +1,43 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../UI/UIUtils.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/UI/Font.h>
+#include <Urho3D/UI/TextLayout.h>
+
+TEST_CASE("Text layout cache performance is measured")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto font = MakeShared<Font>(context);
+    auto face = MakeShared<Tests::TestFontFace>(font);
+
+    static const unsigned numLines = 1000;
+    ea::string text;
+    ea::vector<ea::vector<unsigned>> texts;
+    for (unsigned i = 0; i < numLines; ++i)
+    {
+        text += Format("Log line {}: the quick brown fox jumps over the lazy dog\n", i);
+        texts.push_back(Tests::ToUnicode(text));
+    }
+
+    {
+        HiresTimer timer;
+        TextLayout layout;
+        for (const auto& lines : texts)
+            layout.Calculate(face, lines, 300);
+        WARN(Format("Full layout: {} appended lines in {:.3f} ms", numLines, timer.GetUSec(false) / 1000.0).c_str());
+    }
+
+    {
+        HiresTimer timer;
+        TextLayoutCache cache;
+        SharedPtr<TextLayout> layout;
+        for (const auto& lines : texts)
+            layout = cache.GetLayout(face, lines, 300, layout);
+        WARN(Format("Incremental layout: {} appended lines in {:.3f} ms", numLines, timer.GetUSec(false) / 1000.0).c_str());
+    }
+}
@@ -0,0 +1,73 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../Urho2D/Urho2DUtils.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Urho2D/StaticSprite2D.h>
+#include <Urho3D/Urho2D/TileMap2D.h>
+#include <Urho3D/Urho2D/TileMapChunk2D.h>
+#include <Urho3D/Urho2D/TileMapLayer2D.h>
+#include <Urho3D/Urho2D/TmxFile2D.h>
+
+TEST_CASE("Tile map chunk performance is measured")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    static const int mapSize = 512;
+
+    SharedPtr<TmxFile2D> tmxFile;
+    {
+        HiresTimer timer;
+        tmxFile = Tests::CreateTileMap(context, mapSize, mapSize);
+        WARN(Format("{0}x{0} tmx file loaded in {1:.3f} ms", mapSize, timer.GetUSec(false) / 1000.0).c_str());
+    }
+
+    auto scene = MakeShared<Scene>(context);
+    auto tileMap = scene->CreateChild("TileMap")->CreateComponent<TileMap2D>();
+    {
+        HiresTimer timer;
+        tileMap->SetTmxFile(tmxFile);
+        WARN(Format("Chunks: layer created in {:.3f} ms", timer.GetUSec(false) / 1000.0).c_str());
+    }
+
+    TileMapLayer2D* layer = tileMap->GetLayer(0);
+
+    // Reference: node with sprite per tile, as tile layers used to be created
+    {
+        auto referenceScene = MakeShared<Scene>(context);
+        Node* layerNode = referenceScene->CreateChild("Layer");
+        const TileMapInfo2D& info = tileMap->GetInfo();
+
+        HiresTimer timer;
+        for (int y = 0; y < mapSize; ++y)
+        {
+            for (int x = 0; x < mapSize; ++x)
+            {
+                Node* tileNode = layerNode->CreateTemporaryChild("Tile");
+                tileNode->SetPosition(info.TileIndexToPosition(x, y).ToVector3());
+                auto staticSprite = tileNode->CreateComponent<StaticSprite2D>();
+                staticSprite->SetSprite(layer->GetTile(x, y)->GetSprite());
+                staticSprite->SetOrderInLayer(y * mapSize + x);
+            }
+        }
+        WARN(Format("Node per tile: layer created in {:.3f} ms", timer.GetUSec(false) / 1000.0).c_str());
+    }
+
+    const auto updateChunks = [&](const char* name)
+    {
+        HiresTimer timer;
+        unsigned numVertices = 0;
+        for (int y = 0; y < mapSize; y += DEFAULT_TILE_MAP_CHUNK_SIZE)
+            numVertices += Tests::GetNumVertices(layer->GetChunk(0, y));
+        WARN(Format("Chunks, {}: {} chunks, {} vertices in {:.3f} ms", name, layer->GetNumChunks(), numVertices,
+            timer.GetUSec(false) / 1000.0).c_str());
+    };
+
+    updateChunks("first frame");
+    updateChunks("static frame");
+    layer->SetTileSprite(100, 100, nullptr);
+    updateChunks("one tile changed");
+}
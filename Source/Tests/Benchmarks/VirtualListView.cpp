@@ -0,0 +1,48 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../UI/UIUtils.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/UI/ListView.h>
+
+TEST_CASE("Virtual ListView performance is measured")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    static const unsigned numItems = 50000;
+
+    auto listView = MakeShared<ListView>(context);
+    listView->SetSize(400, 600);
+
+    {
+        HiresTimer timer;
+        listView->DisableInternalLayoutUpdate();
+        for (unsigned i = 0; i < numItems; ++i)
+        {
+            auto item = MakeShared<UIElement>(context);
+            item->SetFixedHeight(20);
+            listView->AddItem(item);
+        }
+        listView->EnableInternalLayoutUpdate();
+        listView->UpdateInternalLayout();
+        WARN(Format("Regular: {} items populated in {:.3f} ms", numItems, timer.GetUSec(false) / 1000.0).c_str());
+    }
+
+    listView->RemoveAllItems();
+
+    unsigned numBinds = 0;
+    {
+        HiresTimer timer;
+        Tests::SetupVirtualListView(listView, numItems, 20, numBinds);
+        WARN(Format("Virtual: {} items populated in {:.3f} ms", numItems, timer.GetUSec(false) / 1000.0).c_str());
+    }
+
+    {
+        HiresTimer timer;
+        for (unsigned i = 0; i < 1000; ++i)
+            listView->SetViewPosition(0, (i * 7919) % (numItems * 20));
+        WARN(Format("Virtual: 1000 scrolls in {:.3f} ms, {} rows bound", timer.GetUSec(false) / 1000.0, numBinds).c_str());
+    }
+}
@@ -27,6 +27,7 @@
 #include "Urho3D/Input/Input.h"
 
 #include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/Engine/Engine.h>
 #include <Urho3D/Engine/EngineDefs.h>
 #include <Urho3D/IO/IOEvents.h>
@@ -51,6 +52,29 @@ void PrintError(VariantMap& args)
     }
 }
 
+SharedPtr<Context> CreateCompleteContextWithWorkerThreads(unsigned numWorkerThreads)
+{
+    auto context = MakeShared<Context>();
+    auto engine = new Engine(context);
+
+    // Engine doesn't change the number of threads once WorkQueue is initialized
+    if (numWorkerThreads > 0)
+        context->GetSubsystem<WorkQueue>()->Initialize(numWorkerThreads);
+
+    auto fs = context->GetSubsystem<FileSystem>();
+    auto exeDir = GetParentPath(fs->GetProgramFileName());
+    StringVariantMap parameters;
+    parameters[EP_HEADLESS] = true;
+    parameters[EP_LOG_QUIET] = true;
+    parameters[EP_RESOURCE_PATHS] = "CoreData;Data";
+    parameters[EP_RESOURCE_PREFIX_PATHS] = Format("{};{}", exeDir, GetParentPath(exeDir));
+    const bool engineInitialized = engine->Initialize(parameters, {});
+
+    engine->SubscribeToEvent(E_LOGMESSAGE, PrintError);
+    REQUIRE(engineInitialized);
+    return context;
+}
+
 }
 
 static SharedPtr<Context> sharedContext;
@@ -75,13 +99,28 @@ void ResetContext()
 }
 
 SharedPtr<Context> CreateCompleteContext()
+{
+    return CreateCompleteContextWithWorkerThreads(0);
+}
+
+SharedPtr<Context> CreateMultithreadedContext()
+{
+    // Worker threads are created even on single-core machines
+    return CreateCompleteContextWithWorkerThreads(3);
+}
+
+SharedPtr<Context> CreateNullBackendContext()
 {
     auto context = MakeShared<Context>();
     auto engine = new Engine(context);
     auto fs = context->GetSubsystem<FileSystem>();
     auto exeDir = GetParentPath(fs->GetProgramFileName());
     StringVariantMap parameters;
-    parameters[EP_HEADLESS] = true;
+    parameters[EP_RENDER_BACKEND] = static_cast<int>(RenderBackend::Null);
+    parameters[EP_WINDOW_WIDTH] = 1920;
+    parameters[EP_WINDOW_HEIGHT] = 1080;
+    parameters[EP_FRAME_LIMITER] = false;
+    parameters[EP_SOUND] = false;
     parameters[EP_LOG_QUIET] = true;
     parameters[EP_RESOURCE_PATHS] = "CoreData;Data";
     parameters[EP_RESOURCE_PREFIX_PATHS] = Format("{};{}", exeDir, GetParentPath(exeDir));
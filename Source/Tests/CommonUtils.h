@@ -58,6 +58,12 @@ void ResetContext();
 /// Create test context with all subsystems ready.
 SharedPtr<Context> CreateCompleteContext();
 
+/// Create test context with all subsystems ready and worker threads regardless of the number of CPUs.
+SharedPtr<Context> CreateMultithreadedContext();
+
+/// Create test context with null render backend. Render pipeline is executed without GPU.
+SharedPtr<Context> CreateNullBackendContext();
+
 /// Run frame with given time step.
 void RunFrame(Context* context, float timeStep, float maxTimeStep = M_LARGE_VALUE);
 
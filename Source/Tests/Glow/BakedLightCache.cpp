@@ -0,0 +1,207 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#if URHO3D_GLOW
+
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Glow/BakedLightCache.h>
+#include <Urho3D/Glow/RaytracerScene.h>
+#include <Urho3D/Graphics/Material.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+BakedSceneChunk CreateTestChunk(unsigned lightmapIndex, unsigned lightmapSize)
+{
+    BakedSceneChunk bakedChunk;
+    bakedChunk.lightmaps_ = {lightmapIndex};
+    bakedChunk.requiredDirectLightmaps_ = {lightmapIndex, lightmapIndex + 1};
+
+    LightmapChartGeometryBuffer geometryBuffer{lightmapIndex, lightmapSize};
+    for (unsigned i = 0; i < geometryBuffer.positions_.size(); ++i)
+    {
+        geometryBuffer.positions_[i] = Vector3{static_cast<float>(i), static_cast<float>(lightmapIndex), 0.0f};
+        geometryBuffer.geometryIds_[i] = i % 3;
+    }
+    geometryBuffer.seams_.push_back(LightmapSeam{{Vector2::ZERO, Vector2::ONE}, {Vector2::ONE, Vector2::ZERO}});
+    bakedChunk.geometryBuffers_.push_back(ea::move(geometryBuffer));
+    bakedChunk.geometryBufferToRaytracer_ = {M_MAX_UNSIGNED, 0, 1};
+
+    BakedLight bakedLight;
+    bakedLight.lightType_ = LIGHT_SPOT;
+    bakedLight.color_ = Color::RED;
+    bakedLight.position_ = Vector3{1.0f, 2.0f, 3.0f};
+    bakedLight.rotation_ = Quaternion{45.0f, Vector3::UP};
+    bakedChunk.bakedLights_.push_back(bakedLight);
+
+    bakedChunk.lightProbesCollection_.worldPositions_ = {Vector3::ONE * static_cast<float>(lightmapIndex)};
+    bakedChunk.lightProbesCollection_.offsets_ = {0};
+    bakedChunk.lightProbesCollection_.counts_ = {1};
+    bakedChunk.lightProbesCollection_.names_ = {"Probes"};
+    bakedChunk.lightProbesCollection_.lightMasks_ = {M_MAX_UNSIGNED};
+    bakedChunk.lightProbesCollection_.backgroundIds_ = {0};
+    bakedChunk.numUniqueLightProbes_ = 1;
+    return bakedChunk;
+}
+
+/// Cast ray down onto the scene.
+RaytracerRayHit CastRayDown(const RaytracerScene& raytracerScene, const Vector2& position)
+{
+    return raytracerScene.CastRay(Vector3{position.x_, 10.0f, position.y_}, Vector3::DOWN, 20.0f);
+}
+
+}
+
+TEST_CASE("Disk light cache spills data to file and loads it back")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+
+    static const unsigned numLightmaps = 8;
+    static const unsigned lightmapSize = 32;
+    static const unsigned long long memoryLimit = 256 * 1024;
+
+    const ea::string fileName = Format("{}LightBakingCacheTest-{}.bin", fileSystem->GetTemporaryDir(), GenerateUUID());
+    {
+        BakedLightDiskCache cache{fileName, memoryLimit};
+
+        for (unsigned i = 0; i < numLightmaps; ++i)
+        {
+            cache.StoreBakedChunk(IntVector3{static_cast<int>(i), 0, 0}, CreateTestChunk(i, lightmapSize));
+
+            LightmapChartBakedDirect bakedDirect{lightmapSize};
+            ea::fill(bakedDirect.directLight_.begin(), bakedDirect.directLight_.end(), Vector3::ONE * i);
+            cache.StoreDirectLight(i, ea::move(bakedDirect));
+
+            BakedLightmap bakedLightmap{lightmapSize};
+            ea::fill(bakedLightmap.lightmap_.begin(), bakedLightmap.lightmap_.end(), Vector3::UP * i);
+            cache.StoreLightmap(i, ea::move(bakedLightmap));
+        }
+
+        CHECK(cache.GetFileSize() > 0);
+        CHECK(fileSystem->FileExists(fileName));
+
+        // Load in reverse order so that every load needs to map spilled data
+        for (unsigned i = numLightmaps; i-- > 0;)
+        {
+            const auto bakedChunk = cache.LoadBakedChunk(IntVector3{static_cast<int>(i), 0, 0});
+            REQUIRE(bakedChunk);
+            REQUIRE(bakedChunk->geometryBuffers_.size() == 1);
+            CHECK(bakedChunk->lightmaps_ == ea::vector<unsigned>{i});
+            CHECK(bakedChunk->geometryBuffers_[0].lightmapSize_ == lightmapSize);
+            CHECK(bakedChunk->geometryBuffers_[0].positions_[5] == Vector3(5.0f, static_cast<float>(i), 0.0f));
+            CHECK(bakedChunk->geometryBuffers_[0].geometryIds_[5] == 2);
+            CHECK(bakedChunk->geometryBuffers_[0].seams_.size() == 1);
+            REQUIRE(bakedChunk->bakedLights_.size() == 1);
+            CHECK(bakedChunk->bakedLights_[0].lightType_ == LIGHT_SPOT);
+            CHECK(bakedChunk->bakedLights_[0].rotation_.Equals(Quaternion{45.0f, Vector3::UP}));
+            CHECK(bakedChunk->lightProbesCollection_.names_ == ea::vector<ea::string>{"Probes"});
+            CHECK(bakedChunk->numUniqueLightProbes_ == 1);
+
+            const auto bakedDirect = cache.LoadDirectLight(i);
+            REQUIRE(bakedDirect);
+            CHECK(bakedDirect->lightmapSize_ == lightmapSize);
+            CHECK(bakedDirect->directLight_.back() == Vector3::ONE * i);
+
+            const auto bakedLightmap = cache.LoadLightmap(i);
+            REQUIRE(bakedLightmap);
+            CHECK(bakedLightmap->lightmap_.front() == Vector3::UP * i);
+
+            CHECK(cache.GetMemoryUsage() <= memoryLimit);
+        }
+
+        CHECK_FALSE(cache.LoadLightmap(numLightmaps));
+        CHECK_FALSE(cache.LoadBakedChunk(IntVector3{-1, 0, 0}));
+    }
+
+    CHECK_FALSE(fileSystem->FileExists(fileName));
+}
+
+TEST_CASE("Disk light cache rebuilds raytracer scenes of evicted chunks")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+    auto resourceCache = context->GetSubsystem<ResourceCache>();
+
+    auto scene = MakeShared<Scene>(context);
+    ea::vector<Component*> geometries;
+    for (const char* modelName : {"Models/Plane.mdl", "Models/Box.mdl"})
+    {
+        auto staticModel = scene->CreateChild("Geometry")->CreateComponent<StaticModel>();
+        staticModel->GetNode()->SetScale(4.0f);
+        staticModel->SetModel(resourceCache->GetResource<Model>(modelName));
+        staticModel->SetMaterial(resourceCache->GetResource<Material>("Materials/DefaultWhite.xml"));
+        staticModel->SetBakeLightmap(true);
+        geometries.push_back(staticModel);
+    }
+
+    const auto backgrounds = ea::make_shared<ea::vector<BakedSceneBackground>>(1);
+    const SharedPtr<RaytracerScene> raytracerScene = CreateRaytracingScene(context, geometries, 1, backgrounds);
+    REQUIRE(raytracerScene);
+
+    const ea::string fileName = Format("{}LightBakingCacheTest-{}.bin", fileSystem->GetTemporaryDir(), GenerateUUID());
+    {
+        BakedLightDiskCache cache{fileName, 1};
+
+        BakedSceneChunk bakedChunk = CreateTestChunk(0, 8);
+        bakedChunk.raytracerScene_ = raytracerScene;
+        cache.StoreBakedChunk(IntVector3::ZERO, ea::move(bakedChunk));
+        cache.StoreBakedChunk(IntVector3::ONE, CreateTestChunk(1, 8));
+        REQUIRE(cache.GetFileSize() > 0);
+
+        // Chunk is evicted and the only raytracer scene reference is held here
+        CHECK(raytracerScene->Refs() == 1);
+
+        const auto loadedChunk = cache.LoadBakedChunk(IntVector3::ZERO);
+        REQUIRE(loadedChunk);
+        const RaytracerScene* loadedScene = loadedChunk->raytracerScene_;
+        REQUIRE(loadedScene);
+        CHECK(loadedScene != raytracerScene);
+        CHECK(loadedScene->GetBackgrounds() == backgrounds);
+        CHECK(loadedScene->GetMaxDistance() == raytracerScene->GetMaxDistance());
+
+        const ea::vector<RaytracerGeometry>& expectedGeometries = raytracerScene->GetGeometries();
+        const ea::vector<RaytracerGeometry>& loadedGeometries = loadedScene->GetGeometries();
+        REQUIRE(loadedGeometries.size() == expectedGeometries.size());
+        for (unsigned i = 0; i < loadedGeometries.size(); ++i)
+        {
+            CHECK(loadedGeometries[i].objectIndex_ == expectedGeometries[i].objectIndex_);
+            CHECK(loadedGeometries[i].raytracerGeometryId_ == i);
+            CHECK(loadedGeometries[i].numTriangles_ == expectedGeometries[i].numTriangles_);
+            CHECK(loadedGeometries[i].mask_ == expectedGeometries[i].mask_);
+        }
+
+        // Rays hit the same triangles and interpolate the same lightmap UVs
+        unsigned numHits = 0;
+        for (int x = -4; x <= 4; ++x)
+        {
+            for (int z = -4; z <= 4; ++z)
+            {
+                const Vector2 position{x * 0.45f, z * 0.45f};
+                const RaytracerRayHit expectedHit = CastRayDown(*raytracerScene, position);
+                const RaytracerRayHit loadedHit = CastRayDown(*loadedScene, position);
+                REQUIRE(loadedHit.geometryId_ == expectedHit.geometryId_);
+                if (expectedHit.geometryId_ == M_MAX_UNSIGNED)
+                    continue;
+
+                ++numHits;
+                CHECK(loadedHit.primitiveId_ == expectedHit.primitiveId_);
+                CHECK(loadedHit.distance_ == expectedHit.distance_);
+                CHECK(loadedHit.lightmapUV_ == expectedHit.lightmapUV_);
+            }
+        }
+        CHECK(numHits > 0);
+    }
+
+    CHECK_FALSE(fileSystem->FileExists(fileName));
+}
+
+#endif
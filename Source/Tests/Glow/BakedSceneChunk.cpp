@@ -0,0 +1,147 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#if URHO3D_GLOW
+
+#include <Urho3D/Glow/BakedSceneChunk.h>
+#include <Urho3D/Glow/BakedSceneCollector.h>
+#include <Urho3D/Graphics/Material.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/Graphics/Zone.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+/// Create group of lightmapped boxes.
+void CreateBoxes(Scene* scene, const Vector3& center, Model* model, Material* material)
+{
+    for (int x = -2; x <= 2; ++x)
+    {
+        Node* boxNode = scene->CreateChild("Box");
+        boxNode->SetPosition(center + Vector3{x * 2.0f, 0.0f, 0.0f});
+        auto boxModel = boxNode->CreateComponent<StaticModel>();
+        boxModel->SetModel(model);
+        boxModel->SetMaterial(material);
+        boxModel->SetBakeLightmap(true);
+    }
+}
+
+ea::unordered_map<IntVector3, unsigned long long> CalculateChunkHashes(
+    Scene* scene, const LightBakingSettings& settings)
+{
+    // Commit zones to the octree as the frame update would do
+    scene->GetComponent<Octree>()->Update(FrameInfo{});
+
+    DefaultBakedSceneCollector collector;
+    collector.LockScene(scene, settings.incremental_.chunkSize_);
+
+    // Combine hashes the same way IncrementalLightBaker does to find dirty chunks
+    const unsigned long long settingsHash = CalculateLightBakingSettingsHash(settings);
+    ea::unordered_map<IntVector3, unsigned long long> chunkHashes;
+    for (const IntVector3& chunk : collector.GetChunks())
+    {
+        unsigned long long hash = CalculateBakedSceneChunkHash(collector, chunk, settings);
+        CombineHash(hash, settingsHash);
+        chunkHashes[chunk] = hash;
+    }
+
+    collector.UnlockScene();
+    return chunkHashes;
+}
+
+}
+
+TEST_CASE("Baked scene chunk hash changes only for chunks with changed content")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto cache = context->GetSubsystem<ResourceCache>();
+
+    // Resources with the same names and different content in each group
+    const auto leftModel = cache->GetResource<Model>("Models/Box.mdl")->Clone("Models/Box.mdl");
+    const auto rightModel = cache->GetResource<Model>("Models/Box.mdl")->Clone("Models/Box.mdl");
+    const auto leftMaterial = cache->GetResource<Material>("Materials/DefaultWhite.xml")->Clone();
+    const auto rightMaterial = cache->GetResource<Material>("Materials/DefaultWhite.xml")->Clone();
+
+    auto scene = MakeShared<Scene>(context);
+    scene->CreateComponent<Octree>();
+    auto zone = scene->CreateComponent<Zone>();
+    zone->SetBoundingBox(BoundingBox{-1000.0f, 1000.0f});
+
+    CreateBoxes(scene, Vector3{-100.0f, 0.0f, 0.0f}, leftModel, leftMaterial);
+    CreateBoxes(scene, Vector3{100.0f, 0.0f, 0.0f}, rightModel, rightMaterial);
+
+    LightBakingSettings settings;
+    settings.incremental_.chunkSize_ = Vector3::ONE * 100.0f;
+    settings.incremental_.indirectPadding_ = 4.0f;
+
+    const auto originalHashes = CalculateChunkHashes(scene, settings);
+    REQUIRE(originalHashes.size() == 2);
+    const IntVector3 leftChunk = IntVector3::ZERO;
+    const IntVector3 rightChunk = IntVector3{1, 0, 0};
+    REQUIRE(originalHashes.contains(leftChunk));
+    REQUIRE(originalHashes.contains(rightChunk));
+
+    // Unchanged scene keeps hashes
+    CHECK(CalculateChunkHashes(scene, settings) == originalHashes);
+
+    // Model content is changed without renaming
+    leftModel->SetBoundingBox(BoundingBox{-Vector3::ONE, Vector3::ONE});
+    const auto modelChangedHashes = CalculateChunkHashes(scene, settings);
+    CHECK(modelChangedHashes.at(leftChunk) != originalHashes.at(leftChunk));
+    CHECK(modelChangedHashes.at(rightChunk) == originalHashes.at(rightChunk));
+
+    // Material parameter is changed without renaming
+    rightMaterial->SetShaderParameter("MatDiffColor", Color::RED);
+    const auto materialChangedHashes = CalculateChunkHashes(scene, settings);
+    CHECK(materialChangedHashes.at(leftChunk) == modelChangedHashes.at(leftChunk));
+    CHECK(materialChangedHashes.at(rightChunk) != modelChangedHashes.at(rightChunk));
+}
+
+TEST_CASE("Baked scene chunks are rebaked when filter or stitching settings are changed")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto cache = context->GetSubsystem<ResourceCache>();
+
+    auto scene = MakeShared<Scene>(context);
+    scene->CreateComponent<Octree>();
+    auto zone = scene->CreateComponent<Zone>();
+    zone->SetBoundingBox(BoundingBox{-1000.0f, 1000.0f});
+
+    CreateBoxes(scene, Vector3::ZERO, cache->GetResource<Model>("Models/Box.mdl"),
+        cache->GetResource<Material>("Materials/DefaultWhite.xml"));
+
+    LightBakingSettings settings;
+    settings.incremental_.chunkSize_ = Vector3::ONE * 100.0f;
+    settings.incremental_.indirectPadding_ = 4.0f;
+
+    const auto originalHashes = CalculateChunkHashes(scene, settings);
+    REQUIRE(originalHashes.size() == 1);
+    CHECK(CalculateChunkHashes(scene, settings) == originalHashes);
+
+    const auto isRebaked = [&](const ea::function<void(LightBakingSettings& settings)>& modify)
+    {
+        LightBakingSettings modifiedSettings = settings;
+        modify(modifiedSettings);
+        return CalculateChunkHashes(scene, modifiedSettings) != originalHashes;
+    };
+
+    CHECK(isRebaked([](LightBakingSettings& s) { s.indirectFilter_.method_ = LightmapFilterMethod::ATrous; }));
+    CHECK(isRebaked([](LightBakingSettings& s) { s.indirectFilter_.luminanceSigma_ *= 2.0f; }));
+    CHECK(isRebaked([](LightBakingSettings& s) { s.indirectFilter_.normalPower_ *= 2.0f; }));
+    CHECK(isRebaked([](LightBakingSettings& s) { s.indirectFilter_.positionSigma_ *= 2.0f; }));
+    CHECK(isRebaked([](LightBakingSettings& s) { s.directFilter_.upscale_ = 2; }));
+    CHECK(isRebaked([](LightBakingSettings& s) { s.stitching_.blendFactor_ = 0.25f; }));
+    CHECK(isRebaked([](LightBakingSettings& s) { s.stitching_.stitchSeamsTechniqueName_ = "Techniques/Other.xml"; }));
+
+    // Number of tasks doesn't affect baked lighting
+    CHECK_FALSE(isRebaked([](LightBakingSettings& s) { s.indirectChartTracing_.numTasks_ = 7; }));
+}
+
+#endif
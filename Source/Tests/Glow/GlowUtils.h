@@ -0,0 +1,161 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include <Urho3D/Glow/LightTracer.h>
+#include <Urho3D/Glow/LightmapGeometryBuffer.h>
+#include <Urho3D/Glow/RaytracerScene.h>
+#include <Urho3D/Graphics/Light.h>
+#include <Urho3D/Graphics/Material.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+
+using namespace Urho3D;
+
+namespace Tests
+{
+
+/// Create lightmapped floor and grid of lightmapped boxes casting shadows. Return created geometries.
+inline ea::vector<Component*> CreateFloorWithBoxes(Scene* scene, float floorSize, int gridRadius)
+{
+    auto cache = scene->GetSubsystem<ResourceCache>();
+    auto material = cache->GetResource<Material>("Materials/DefaultWhite.xml");
+
+    ea::vector<Component*> geometries;
+
+    Node* floorNode = scene->CreateChild("Floor");
+    floorNode->SetScale(Vector3{floorSize, 1.0f, floorSize});
+    auto floorModel = floorNode->CreateComponent<StaticModel>();
+    floorModel->SetModel(cache->GetResource<Model>("Models/Plane.mdl"));
+    floorModel->SetMaterial(material);
+    floorModel->SetBakeLightmap(true);
+    geometries.push_back(floorModel);
+
+    for (int x = -gridRadius; x <= gridRadius; ++x)
+    {
+        for (int z = -gridRadius; z <= gridRadius; ++z)
+        {
+            Node* boxNode = scene->CreateChild("Box");
+            boxNode->SetPosition(Vector3{x * 4.0f, 1.0f, z * 4.0f});
+            boxNode->SetScale(Vector3{1.0f, 2.0f + (x + z + gridRadius * 2) % 3, 1.0f});
+            auto boxModel = boxNode->CreateComponent<StaticModel>();
+            boxModel->SetModel(cache->GetResource<Model>("Models/Box.mdl"));
+            boxModel->SetMaterial(material);
+            boxModel->SetBakeLightmap(true);
+            geometries.push_back(boxModel);
+        }
+    }
+    return geometries;
+}
+
+/// Create baked directional light.
+inline Light* CreateBakedDirectionalLight(Scene* scene, float radius)
+{
+    Node* lightNode = scene->CreateChild("Light");
+    lightNode->SetDirection(Vector3{0.6f, -1.0f, 0.8f});
+    auto light = lightNode->CreateComponent<Light>();
+    light->SetLightType(LIGHT_DIRECTIONAL);
+    light->SetLightMode(LM_BAKED);
+    light->SetRadius(radius);
+    return light;
+}
+
+/// Create raytracing scene for geometries with white background.
+inline SharedPtr<RaytracerScene> CreateRaytracingSceneWithWhiteBackground(
+    Context* context, const ea::vector<Component*>& geometries)
+{
+    const auto backgrounds = ea::make_shared<ea::vector<BakedSceneBackground>>(1);
+    (*backgrounds)[0].intensity_ = 1.0f;
+    (*backgrounds)[0].color_ = Color::WHITE;
+    return CreateRaytracingScene(context, geometries, 1, backgrounds);
+}
+
+/// Create geometry buffer covering the floor of the scene with texels facing up.
+inline LightmapChartGeometryBuffer CreateFloorGeometryBuffer(unsigned lightmapSize, float floorSize)
+{
+    LightmapChartGeometryBuffer geometryBuffer{0, lightmapSize};
+    for (unsigned index = 0; index < lightmapSize * lightmapSize; ++index)
+    {
+        const IntVector2 location = geometryBuffer.IndexToLocation(index);
+        const Vector2 uv = (location.ToVector2() + Vector2::ONE * 0.5f) / static_cast<float>(lightmapSize);
+        const Vector2 position = (uv - Vector2::ONE * 0.5f) * floorSize;
+
+        geometryBuffer.positions_[index] = Vector3{position.x_, 0.01f, position.y_};
+        geometryBuffer.smoothNormals_[index] = Vector3::UP;
+        geometryBuffer.faceNormals_[index] = Vector3::UP;
+        geometryBuffer.geometryIds_[index] = 1;
+        geometryBuffer.lightMasks_[index] = M_MAX_UNSIGNED;
+        geometryBuffer.backgroundIds_[index] = 0;
+        geometryBuffer.albedo_[index] = Vector3::ONE * 0.5f;
+    }
+    return geometryBuffer;
+}
+
+/// Create geometry buffer with two walls separated by empty texels. The walls face different directions.
+inline LightmapChartGeometryBuffer CreateWallsGeometryBuffer(unsigned lightmapSize)
+{
+    LightmapChartGeometryBuffer geometryBuffer{0, lightmapSize};
+    for (unsigned index = 0; index < lightmapSize * lightmapSize; ++index)
+    {
+        const IntVector2 location = geometryBuffer.IndexToLocation(index);
+        const int border = static_cast<int>(lightmapSize / 2);
+        if (location.x_ == border)
+            continue;
+
+        const bool isLeft = location.x_ < border;
+        geometryBuffer.positions_[index] = Vector3{location.x_ * 0.1f, location.y_ * 0.1f, 0.0f};
+        geometryBuffer.smoothNormals_[index] = isLeft ? Vector3::BACK : Vector3::RIGHT;
+        geometryBuffer.faceNormals_[index] = geometryBuffer.smoothNormals_[index];
+        geometryBuffer.geometryIds_[index] = isLeft ? 1 : 2;
+    }
+    return geometryBuffer;
+}
+
+/// Return expected noise-free light on the walls.
+inline Vector3 GetReferenceLight(const IntVector2& location, unsigned lightmapSize)
+{
+    const bool isLeft = location.x_ < static_cast<int>(lightmapSize / 2);
+    const float gradient = static_cast<float>(location.y_) / lightmapSize;
+    return isLeft ? Vector3{1.0f, 0.5f, 0.25f} * gradient : Vector3{0.2f, 0.2f, 1.0f};
+}
+
+/// Create reference light on the walls with multiplicative noise.
+inline LightmapChartBakedIndirect CreateNoisyWallsLight(const LightmapChartGeometryBuffer& geometryBuffer)
+{
+    const unsigned lightmapSize = geometryBuffer.lightmapSize_;
+    RandomEngine randomEngine{0};
+    LightmapChartBakedIndirect bakedIndirect{lightmapSize};
+    for (unsigned index = 0; index < lightmapSize * lightmapSize; ++index)
+    {
+        if (geometryBuffer.geometryIds_[index] == 0)
+            continue;
+
+        const Vector3 reference = GetReferenceLight(geometryBuffer.IndexToLocation(index), lightmapSize);
+        bakedIndirect.light_[index] = Vector4{reference * randomEngine.GetFloat(0.5f, 1.5f), 1.0f};
+    }
+    return bakedIndirect;
+}
+
+/// Return RMS error of the light on the walls.
+inline double CalculateWallsLightError(
+    const ea::vector<Vector4>& light, const LightmapChartGeometryBuffer& geometryBuffer)
+{
+    const unsigned lightmapSize = geometryBuffer.lightmapSize_;
+    double errorSquared = 0.0;
+    for (unsigned index = 0; index < lightmapSize * lightmapSize; ++index)
+    {
+        if (geometryBuffer.geometryIds_[index] == 0)
+            continue;
+
+        const Vector3 reference = GetReferenceLight(geometryBuffer.IndexToLocation(index), lightmapSize);
+        errorSquared += (light[index].ToVector3() - reference).LengthSquared();
+    }
+    return Sqrt(errorSquared / (lightmapSize * lightmapSize));
+}
+
+} // namespace Tests
@@ -0,0 +1,75 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#if URHO3D_GLOW
+
+#include "GlowUtils.h"
+
+#include <Urho3D/Glow/LightTracer.h>
+#include <Urho3D/Glow/RaytracerScene.h>
+#include <Urho3D/Graphics/Light.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+/// Return whether the ray from the light to the position is not occluded. Traced with single ray query.
+bool IsLitBySingleRay(const RaytracerScene& raytracerScene, const Vector3& position, const Vector3& lightDirection)
+{
+    const Vector3 rayOffset = raytracerScene.GetMaxDistance() * lightDirection;
+    return raytracerScene.CastRay(position - rayOffset, rayOffset, 1.0f).geometryId_ == M_MAX_UNSIGNED;
+}
+
+}
+
+TEST_CASE("Direct light traced in ray packets matches single ray queries")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    static const unsigned lightmapSize = 64;
+    static const float floorSize = 16.0f;
+
+    // Create floor and grid of boxes casting hard shadows
+    auto scene = MakeShared<Scene>(context);
+    const ea::vector<Component*> geometries = Tests::CreateFloorWithBoxes(scene, floorSize, 1);
+    Light* light = Tests::CreateBakedDirectionalLight(scene, 0.0f);
+
+    const auto raytracerScene = Tests::CreateRaytracingSceneWithWhiteBackground(context, geometries);
+    REQUIRE(raytracerScene);
+
+    const LightmapChartGeometryBuffer geometryBuffer = Tests::CreateFloorGeometryBuffer(lightmapSize, floorSize);
+    const ea::vector<unsigned> geometryBufferToRaytracer{M_MAX_UNSIGNED, 0};
+
+    // Hard shadows are traced with one sample per texel, so each packet covers several texels
+    DirectLightTracingSettings directSettings;
+    directSettings.numTasks_ = 2;
+
+    const BakedLight bakedLight{light};
+    LightmapChartBakedDirect bakedDirect{lightmapSize};
+    BakeDirectLightForCharts(
+        bakedDirect, geometryBuffer, *raytracerScene, geometryBufferToRaytracer, bakedLight, directSettings);
+
+    const Vector3 lightColor = bakedLight.color_.ToVector3();
+    const float lightIntensity = Vector3::UP.DotProduct(-bakedLight.direction_);
+
+    unsigned numLitTexels = 0;
+    unsigned numMismatchedTexels = 0;
+    for (unsigned index = 0; index < lightmapSize * lightmapSize; ++index)
+    {
+        const bool isLit = IsLitBySingleRay(*raytracerScene, geometryBuffer.positions_[index], bakedLight.direction_);
+        const Vector3 expectedLight = isLit ? lightColor * lightIntensity : Vector3::ZERO;
+        if (!bakedDirect.directLight_[index].Equals(expectedLight, 0.001f))
+            ++numMismatchedTexels;
+        if (isLit)
+            ++numLitTexels;
+    }
+
+    CHECK(numLitTexels > 0);
+    CHECK(numLitTexels < lightmapSize * lightmapSize);
+    CHECK(numMismatchedTexels == 0);
+}
+
+#endif
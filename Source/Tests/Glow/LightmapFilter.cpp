@@ -0,0 +1,116 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#if URHO3D_GLOW
+
+#include "GlowUtils.h"
+
+#include <Urho3D/Glow/LightmapFilter.h>
+
+TEST_CASE("A-trous lightmap filter preserves constant light")
+{
+    static const unsigned lightmapSize = 37;
+    const LightmapChartGeometryBuffer geometryBuffer = Tests::CreateWallsGeometryBuffer(lightmapSize);
+
+    EdgeStoppingGaussFilterParameters params;
+    params.kernelRadius_ = 5;
+    params.method_ = LightmapFilterMethod::ATrous;
+
+    LightmapChartBakedIndirect bakedIndirect{lightmapSize};
+    ea::fill(bakedIndirect.light_.begin(), bakedIndirect.light_.end(), Vector4{0.5f, 1.0f, 2.0f, 1.0f});
+
+    ea::vector<Vector4> outputBuffer(lightmapSize * lightmapSize);
+    FilterIndirectLight(bakedIndirect, outputBuffer, geometryBuffer, params, 3);
+
+    for (unsigned index = 0; index < outputBuffer.size(); ++index)
+    {
+        if (geometryBuffer.geometryIds_[index] != 0)
+            REQUIRE(outputBuffer[index].Equals(Vector4{0.5f, 1.0f, 2.0f, 1.0f}, 0.0001f));
+        else
+            REQUIRE(outputBuffer[index] == Vector4::ZERO);
+    }
+}
+
+TEST_CASE("A-trous lightmap filter does not blur across normal edges")
+{
+    static const unsigned lightmapSize = 32;
+    const LightmapChartGeometryBuffer geometryBuffer = Tests::CreateWallsGeometryBuffer(lightmapSize);
+
+    EdgeStoppingGaussFilterParameters params;
+    params.kernelRadius_ = 5;
+    params.method_ = LightmapFilterMethod::ATrous;
+
+    LightmapChartBakedDirect bakedDirect{lightmapSize};
+    for (unsigned index = 0; index < bakedDirect.directLight_.size(); ++index)
+    {
+        const bool isLeft = geometryBuffer.IndexToLocation(index).x_ < static_cast<int>(lightmapSize / 2);
+        bakedDirect.directLight_[index] = isLeft ? Vector3::ONE : Vector3::ZERO;
+    }
+
+    ea::vector<Vector3> outputBuffer(lightmapSize * lightmapSize);
+    FilterDirectLight(bakedDirect, outputBuffer, geometryBuffer, params, 1);
+
+    for (unsigned index = 0; index < outputBuffer.size(); ++index)
+    {
+        if (geometryBuffer.geometryIds_[index] != 0)
+            REQUIRE(outputBuffer[index].Equals(bakedDirect.directLight_[index], 0.0001f));
+    }
+}
+
+TEST_CASE("A-trous lightmap filter has the same output with and without SIMD")
+{
+    static const unsigned lightmapSize = 45;
+    static const unsigned numTexels = lightmapSize * lightmapSize;
+    const LightmapChartGeometryBuffer geometryBuffer = Tests::CreateWallsGeometryBuffer(lightmapSize);
+    const LightmapChartBakedIndirect bakedIndirect = Tests::CreateNoisyWallsLight(geometryBuffer);
+
+    // Zero normal power doesn't attenuate taps with orthogonal normals, so they have to be dropped explicitly
+    for (const float normalPower : {0.0f, 4.0f})
+    {
+        EdgeStoppingGaussFilterParameters params;
+        params.kernelRadius_ = 5;
+        params.normalPower_ = normalPower;
+        params.method_ = LightmapFilterMethod::ATrous;
+
+        ea::vector<Vector4> outputBuffer(numTexels);
+        FilterIndirectLight(bakedIndirect, outputBuffer, geometryBuffer, params, 1);
+
+        params.useSIMD_ = false;
+        ea::vector<Vector4> referenceOutputBuffer(numTexels);
+        FilterIndirectLight(bakedIndirect, referenceOutputBuffer, geometryBuffer, params, 1);
+
+        for (unsigned index = 0; index < numTexels; ++index)
+            REQUIRE(outputBuffer[index].Equals(referenceOutputBuffer[index], 0.001f));
+    }
+}
+
+TEST_CASE("A-trous lightmap filter reduces noise as well as Gauss filter")
+{
+    static const unsigned lightmapSize = 64;
+    static const unsigned numTexels = lightmapSize * lightmapSize;
+    const LightmapChartGeometryBuffer geometryBuffer = Tests::CreateWallsGeometryBuffer(lightmapSize);
+    const LightmapChartBakedIndirect bakedIndirect = Tests::CreateNoisyWallsLight(geometryBuffer);
+
+    const auto filterAndCalculateError = [&](LightmapFilterMethod method)
+    {
+        EdgeStoppingGaussFilterParameters params;
+        params.kernelRadius_ = 5;
+        params.method_ = method;
+
+        ea::vector<Vector4> outputBuffer(numTexels);
+        FilterIndirectLight(bakedIndirect, outputBuffer, geometryBuffer, params, 2);
+        return Tests::CalculateWallsLightError(outputBuffer, geometryBuffer);
+    };
+
+    const double unfilteredError = Tests::CalculateWallsLightError(bakedIndirect.light_, geometryBuffer);
+    const double gaussError = filterAndCalculateError(LightmapFilterMethod::Gauss);
+    const double aTrousError = filterAndCalculateError(LightmapFilterMethod::ATrous);
+    CHECK(gaussError < unfilteredError * 0.5);
+    CHECK(aTrousError < unfilteredError * 0.5);
+    CHECK(aTrousError < gaussError * 1.5);
+}
+
+#endif
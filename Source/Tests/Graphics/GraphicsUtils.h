@@ -0,0 +1,95 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include <Urho3D/Graphics/Light.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/Graphics/Terrain.h>
+#include <Urho3D/Graphics/Zone.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Math/Sphere.h>
+#include <Urho3D/Resource/Image.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+
+using namespace Urho3D;
+
+namespace Tests
+{
+
+/// Create 8-bit heightmap with hills.
+inline SharedPtr<Image> CreateHeightMap(Context* context, int size)
+{
+    ea::vector<unsigned char> data(size * size);
+    for (int y = 0; y < size; ++y)
+    {
+        for (int x = 0; x < size; ++x)
+        {
+            const float height = 0.5f + 0.25f * Sin(x * 7.0f) * Cos(y * 5.0f) + 0.25f * Sin((x + y) * 31.0f);
+            data[y * size + x] = static_cast<unsigned char>(Clamp(height, 0.0f, 1.0f) * 255.0f);
+        }
+    }
+
+    auto image = MakeShared<Image>(context);
+    image->SetSize(size, size, 1);
+    image->SetData(data.data());
+    return image;
+}
+
+/// Create terrain with given parameters in new child node.
+inline Terrain* CreateTerrain(Scene* scene, Image* heightMap, int patchSize, unsigned maxLodLevels, bool async)
+{
+    auto terrain = scene->CreateChild("Terrain")->CreateComponent<Terrain>();
+    terrain->SetPatchSize(patchSize);
+    terrain->SetMaxLodLevels(maxLodLevels);
+    terrain->SetAsyncPatchGeneration(async);
+    terrain->SetHeightMap(heightMap);
+    return terrain;
+}
+
+/// Create octree, zone, directional light and square grid of boxes in XZ plane. Return created box nodes.
+inline ea::vector<Node*> CreateLitBoxGrid(Scene* scene, int halfSize, float spacing, float boxScale)
+{
+    auto cache = scene->GetSubsystem<ResourceCache>();
+    scene->CreateComponent<Octree>();
+
+    auto zone = scene->CreateChild("Zone")->CreateComponent<Zone>();
+    zone->SetBoundingBox(BoundingBox(-1000.0f, 1000.0f));
+
+    Node* lightNode = scene->CreateChild("DirectionalLight");
+    lightNode->SetDirection(Vector3(-0.6f, -1.0f, -0.8f));
+    lightNode->CreateComponent<Light>()->SetLightType(LIGHT_DIRECTIONAL);
+
+    ea::vector<Node*> boxNodes;
+    for (int y = -halfSize; y < halfSize; ++y)
+    {
+        for (int x = -halfSize; x < halfSize; ++x)
+        {
+            Node* boxNode = scene->CreateChild("Box");
+            boxNode->SetPosition(Vector3(x * spacing, 0.0f, y * spacing));
+            boxNode->SetScale(boxScale);
+            boxNode->CreateComponent<StaticModel>()->SetModel(cache->GetResource<Model>("Models/Box.mdl"));
+            boxNodes.push_back(boxNode);
+        }
+    }
+    return boxNodes;
+}
+
+/// Create bounding spheres of lights scattered in front of default camera.
+inline ea::vector<Sphere> CreateRandomLightBounds(unsigned numLights, RandomEngine& random)
+{
+    ea::vector<Sphere> lightBounds;
+    for (unsigned i = 0; i < numLights; ++i)
+    {
+        const Vector3 position{
+            random.GetFloat(-100.0f, 100.0f), random.GetFloat(-10.0f, 10.0f), random.GetFloat(0.0f, 300.0f)};
+        lightBounds.push_back(Sphere{position, random.GetFloat(2.0f, 10.0f)});
+    }
+    return lightBounds;
+}
+
+} // namespace Tests
@@ -0,0 +1,154 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "GraphicsUtils.h"
+
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/RenderPipeline/LightClusterGrid.h>
+#include <Urho3D/Scene/Node.h>
+
+namespace
+{
+
+bool IsLightInCluster(const LightClusterGrid& grid, const IntVector3& cluster, unsigned lightIndex)
+{
+    const auto lights = grid.GetClusterLights(grid.GetClusterIndex(cluster));
+    return ea::find(lights.begin(), lights.end(), lightIndex) != lights.end();
+}
+
+unsigned GetTotalNumLightsInClusters(const LightClusterGrid& grid)
+{
+    unsigned result = 0;
+    for (unsigned i = 0; i < grid.GetNumClusters(); ++i)
+        result += grid.GetClusterLights(i).size();
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("Light cluster grid assigns lights to clusters of perspective camera")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto cameraNode = MakeShared<Node>(context);
+    auto camera = cameraNode->CreateComponent<Camera>();
+    camera->SetFov(90.0f);
+    camera->SetAspectRatio(1.0f);
+    camera->SetNearClip(1.0f);
+    camera->SetFarClip(100.0f);
+
+    auto grid = MakeShared<LightClusterGrid>(context);
+    REQUIRE(grid->GetSettings().gridSize_ == IntVector3(16, 9, 24));
+
+    // Slice 12 covers depths from 10 to ~12.1 units
+    const Sphere lightBounds[] = {
+        Sphere{Vector3(0.0f, 0.0f, 10.5f), 0.5f},
+        Sphere{Vector3(0.0f, 0.0f, -10.0f), 1.0f},
+        Sphere{Vector3(0.0f, 0.0f, 200.0f), 1.0f},
+    };
+    grid->Build(camera, lightBounds, nullptr);
+
+    REQUIRE(grid->GetNumClusters() == 16 * 9 * 24);
+    CHECK(IsLightInCluster(*grid, {7, 4, 12}, 0));
+    CHECK(IsLightInCluster(*grid, {8, 4, 12}, 0));
+    CHECK_FALSE(IsLightInCluster(*grid, {0, 0, 12}, 0));
+    CHECK_FALSE(IsLightInCluster(*grid, {8, 4, 0}, 0));
+    CHECK_FALSE(IsLightInCluster(*grid, {8, 4, 23}, 0));
+
+    // Lights behind camera and beyond far plane are ignored
+    for (unsigned i = 0; i < grid->GetNumClusters(); ++i)
+    {
+        for (unsigned lightIndex : grid->GetClusterLights(i))
+            CHECK(lightIndex == 0);
+    }
+    CHECK(GetTotalNumLightsInClusters(*grid) == grid->GetNumLightIndices());
+}
+
+TEST_CASE("Light cluster grid assigns lights to clusters of orthographic camera")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto cameraNode = MakeShared<Node>(context);
+    auto camera = cameraNode->CreateComponent<Camera>();
+    camera->SetOrthographic(true);
+    camera->SetOrthoSize(20.0f);
+    camera->SetAspectRatio(1.0f);
+    camera->SetNearClip(0.0f);
+    camera->SetFarClip(96.0f);
+
+    auto grid = MakeShared<LightClusterGrid>(context);
+    LightClusterGridSettings settings;
+    settings.gridSize_ = {16, 16, 24};
+    grid->SetSettings(settings);
+
+    // Slices are 4 units deep, tiles are 1.25 units wide
+    const Sphere lightBounds[] = {
+        Sphere{Vector3(5.6f, -5.6f, 50.0f), 0.5f},
+    };
+    grid->Build(camera, lightBounds, nullptr);
+
+    CHECK(IsLightInCluster(*grid, {12, 3, 12}, 0));
+    CHECK_FALSE(IsLightInCluster(*grid, {3, 3, 12}, 0));
+    CHECK_FALSE(IsLightInCluster(*grid, {12, 12, 12}, 0));
+    CHECK_FALSE(IsLightInCluster(*grid, {12, 3, 14}, 0));
+    CHECK(GetTotalNumLightsInClusters(*grid) == grid->GetNumLightIndices());
+}
+
+TEST_CASE("Light cluster grid limits number of lights per cluster")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto cameraNode = MakeShared<Node>(context);
+    auto camera = cameraNode->CreateComponent<Camera>();
+    camera->SetFarClip(100.0f);
+
+    auto grid = MakeShared<LightClusterGrid>(context);
+    LightClusterGridSettings settings;
+    settings.maxLightsPerCluster_ = 4;
+    grid->SetSettings(settings);
+
+    const ea::vector<Sphere> lightBounds(10, Sphere{Vector3(0.0f, 0.0f, 10.0f), 2.0f});
+    grid->Build(camera, lightBounds, context->GetSubsystem<WorkQueue>());
+
+    unsigned numFullClusters = 0;
+    for (unsigned i = 0; i < grid->GetNumClusters(); ++i)
+    {
+        const unsigned numLights = grid->GetClusterLights(i).size();
+        CHECK(numLights <= 4);
+        if (numLights == 4)
+            ++numFullClusters;
+    }
+    CHECK(numFullClusters > 0);
+}
+
+TEST_CASE("Light cluster grid is built identically with and without work queue")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto cameraNode = MakeShared<Node>(context);
+    auto camera = cameraNode->CreateComponent<Camera>();
+    camera->SetAspectRatio(16.0f / 9.0f);
+    camera->SetFarClip(300.0f);
+
+    RandomEngine random(0);
+    const ea::vector<Sphere> lightBounds = Tests::CreateRandomLightBounds(200, random);
+
+    auto singleThreadGrid = MakeShared<LightClusterGrid>(context);
+    singleThreadGrid->Build(camera, lightBounds, nullptr);
+
+    auto workQueueGrid = MakeShared<LightClusterGrid>(context);
+    workQueueGrid->Build(camera, lightBounds, context->GetSubsystem<WorkQueue>());
+
+    REQUIRE(singleThreadGrid->GetNumLightIndices() > 0);
+    REQUIRE(workQueueGrid->GetNumLightIndices() == singleThreadGrid->GetNumLightIndices());
+    for (unsigned i = 0; i < singleThreadGrid->GetNumClusters(); ++i)
+    {
+        const auto expectedLights = singleThreadGrid->GetClusterLights(i);
+        const auto actualLights = workQueueGrid->GetClusterLights(i);
+        REQUIRE(actualLights.size() == expectedLights.size());
+        REQUIRE(ea::equal(expectedLights.begin(), expectedLights.end(), actualLights.begin()));
+    }
+}
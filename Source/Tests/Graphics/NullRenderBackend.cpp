@@ -0,0 +1,54 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "GraphicsUtils.h"
+
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/Light.h>
+#include <Urho3D/Graphics/Renderer.h>
+#include <Urho3D/Graphics/Viewport.h>
+#include <Urho3D/RenderAPI/RenderDevice.h>
+#include <Urho3D/RenderPipeline/RenderPipeline.h>
+#include <Urho3D/Scene/Scene.h>
+
+TEST_CASE("Render pipeline is executed with null render backend")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateNullBackendContext);
+    auto renderer = context->GetSubsystem<Renderer>();
+    auto renderDevice = context->GetSubsystem<RenderDevice>();
+    REQUIRE(renderDevice);
+    REQUIRE(renderDevice->GetBackend() == RenderBackend::Null);
+
+    auto scene = MakeShared<Scene>(context);
+    const ea::vector<Node*> boxNodes = Tests::CreateLitBoxGrid(scene, 5, 2.0f, 1.0f);
+    scene->GetChild("DirectionalLight")->GetComponent<Light>()->SetCastShadows(true);
+
+    Node* cameraNode = scene->CreateChild("Camera");
+    cameraNode->SetPosition(Vector3(0.0f, 20.0f, -20.0f));
+    cameraNode->LookAt(Vector3::ZERO);
+    auto viewport = MakeShared<Viewport>(context, scene, cameraNode->CreateComponent<Camera>());
+    renderer->SetViewport(0, viewport);
+
+    Tests::RunFrame(context, 0.01f);
+    Tests::RunFrame(context, 0.01f);
+
+    RenderPipelineView* view = viewport->GetRenderPipelineView();
+    REQUIRE(view);
+    CHECK(view->GetStats().numGeometries_ == 100);
+    CHECK(view->GetStats().numLights_ == 1);
+
+    // Draw commands are counted but not executed
+    const unsigned numDrawsWithBoxes = renderDevice->GetStats().numDraws_;
+    CHECK(numDrawsWithBoxes > 0);
+
+    for (Node* boxNode : boxNodes)
+        boxNode->SetEnabled(false);
+    Tests::RunFrame(context, 0.01f);
+
+    CHECK(view->GetStats().numGeometries_ == 0);
+    CHECK(renderDevice->GetStats().numDraws_ < numDrawsWithBoxes);
+
+    renderer->SetViewport(0, nullptr);
+}
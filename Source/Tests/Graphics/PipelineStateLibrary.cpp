@@ -0,0 +1,91 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/PipelineStateLibrary.h>
+#include <Urho3D/Graphics/Shader.h>
+#include <Urho3D/Graphics/ShaderVariation.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Resource/ResourceCache.h>
+
+namespace
+{
+
+GraphicsPipelineStateDesc CreatePipelineStateDesc(Shader* shader, const ea::string& defines, CullMode cullMode)
+{
+    GraphicsPipelineStateDesc desc;
+    desc.debugName_ = Format("{} {}", shader->GetName(), defines);
+    desc.colorWriteEnabled_ = true;
+    desc.depthWriteEnabled_ = true;
+    desc.depthCompareFunction_ = CMP_LESSEQUAL;
+    desc.cullMode_ = cullMode;
+    desc.blendMode_ = BLEND_ALPHA;
+    desc.primitiveType_ = TRIANGLE_LIST;
+    desc.vertexShader_ = shader->GetVariation(VS, defines);
+    desc.pixelShader_ = shader->GetVariation(PS, defines);
+    return desc;
+}
+
+} // namespace
+
+TEST_CASE("PipelineStateLibrary loaded from file creates pipeline states ahead of rendering")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateNullBackendContext);
+    auto cache = context->GetSubsystem<ResourceCache>();
+    auto pipelineStateCache = context->GetSubsystem<PipelineStateCache>();
+
+    auto shader = cache->GetResource<Shader>("Shaders/GLSL/v2/Unlit.glsl");
+    REQUIRE(shader);
+
+    const ea::vector<GraphicsPipelineStateDesc> descs{
+        CreatePipelineStateDesc(shader, "DIFFMAP", CULL_CCW),
+        CreatePipelineStateDesc(shader, "DIFFMAP", CULL_NONE),
+        CreatePipelineStateDesc(shader, "VERTEXCOLOR", CULL_CCW),
+    };
+
+    // Record the library as the application would do and save it
+    VectorBuffer buffer;
+    {
+        auto library = MakeShared<PipelineStateLibrary>(context);
+        library->StartRecording();
+        for (const GraphicsPipelineStateDesc& desc : descs)
+            CHECK(pipelineStateCache->GetGraphicsPipelineState(desc));
+        library->StopRecording();
+
+        REQUIRE(library->GetEntries().size() == descs.size());
+        REQUIRE(library->Save(buffer, InternalResourceFormat::Json));
+        buffer.Seek(0);
+    }
+
+    // Recorded pipeline states are released, so only warmup may create them again
+    unsigned numCreatedStates = 0;
+    auto receiver = MakeShared<RefCounted>();
+    pipelineStateCache->OnPipelineStateCreated.Subscribe(receiver.Get(), [&](PipelineState*) { ++numCreatedStates; });
+
+    auto library = MakeShared<PipelineStateLibrary>(context);
+    REQUIRE(library->Load(buffer));
+    REQUIRE(library->GetEntries().size() == descs.size());
+
+    library->StartWarmup();
+    library->CompleteWarmup();
+    CHECK_FALSE(library->IsWarmupInProgress());
+    CHECK(library->GetNumWarmedPipelineStates() == descs.size());
+    CHECK(numCreatedStates == descs.size());
+
+    // Rendering gets ready pipeline states from the cache without creating them on demand
+    for (const GraphicsPipelineStateDesc& desc : descs)
+    {
+        CHECK_FALSE(desc.vertexShader_->IsCompilationPending());
+        CHECK_FALSE(desc.pixelShader_->IsCompilationPending());
+
+        const SharedPtr<PipelineState> pipelineState = pipelineStateCache->GetGraphicsPipelineState(desc);
+        REQUIRE(pipelineState);
+        CHECK(pipelineState->IsValid());
+    }
+    CHECK(numCreatedStates == descs.size());
+
+    pipelineStateCache->OnPipelineStateCreated.Unsubscribe(receiver);
+    library->ReleaseWarmedPipelineStates();
+}
@@ -0,0 +1,148 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/Material.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/Renderer.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/Graphics/Technique.h>
+#include <Urho3D/Graphics/Viewport.h>
+#include <Urho3D/Graphics/Zone.h>
+#include <Urho3D/RenderPipeline/RenderPipeline.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+/// Create material with single technique.
+SharedPtr<Material> CreateMaterial(Context* context, const ea::string& techniqueName)
+{
+    auto cache = context->GetSubsystem<ResourceCache>();
+    auto material = MakeShared<Material>(context);
+    material->SetTechnique(0, cache->GetResource<Technique>(techniqueName));
+    return material;
+}
+
+}
+
+TEST_CASE("Retained batches are discarded when drawable batches or visibility are changed")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateNullBackendContext);
+    auto cache = context->GetSubsystem<ResourceCache>();
+    auto renderer = context->GetSubsystem<Renderer>();
+
+    auto scene = MakeShared<Scene>(context);
+    scene->CreateComponent<Octree>();
+
+    auto renderPipeline = scene->CreateComponent<RenderPipeline>();
+    RenderPipelineSettings settings = renderPipeline->GetSettings();
+    settings.sceneProcessor_.retainStaticBatches_ = true;
+    renderPipeline->SetSettings(settings);
+
+    auto zone = scene->CreateChild("Zone")->CreateComponent<Zone>();
+    zone->SetBoundingBox(BoundingBox(-1000.0f, 1000.0f));
+
+    auto otherZone = scene->CreateChild("OtherZone")->CreateComponent<Zone>();
+    otherZone->SetBoundingBox(BoundingBox(Vector3{-10.0f, -10.0f, 5.0f}, Vector3{10.0f, 10.0f, 15.0f}));
+    otherZone->SetPriority(1);
+
+    // Unlit batches don't depend on lights and can be retained
+    const auto unlitMaterial = CreateMaterial(context, "Techniques/NoTextureUnlit.xml");
+    const auto litMaterial = CreateMaterial(context, "Techniques/NoTexture.xml");
+
+    static const unsigned numBoxes = 5;
+    ea::vector<Node*> boxNodes;
+    for (unsigned i = 0; i < numBoxes; ++i)
+    {
+        Node* boxNode = scene->CreateChild("Box");
+        boxNode->SetPosition(Vector3{i * 2.0f - 4.0f, 0.0f, 0.0f});
+        auto boxModel = boxNode->CreateComponent<StaticModel>();
+        boxModel->SetModel(cache->GetResource<Model>("Models/Box.mdl"));
+        boxModel->SetMaterial(unlitMaterial);
+        boxNodes.push_back(boxNode);
+    }
+
+    Node* cameraNode = scene->CreateChild("Camera");
+    cameraNode->SetPosition(Vector3(0.0f, 20.0f, -20.0f));
+    cameraNode->LookAt(Vector3::ZERO);
+    auto viewport = MakeShared<Viewport>(context, scene, cameraNode->CreateComponent<Camera>());
+    renderer->SetViewport(0, viewport);
+
+    Tests::RunFrame(context, 0.01f);
+    RenderPipelineView* view = viewport->GetRenderPipelineView();
+    REQUIRE(view);
+
+    const auto renderFrame = [&]
+    {
+        Tests::RunFrame(context, 0.01f);
+        return view->GetStats().numRetainedGeometries_;
+    };
+
+    // Batches are retained starting from the second frame
+    renderFrame();
+    renderFrame();
+    REQUIRE(view->GetStats().numGeometries_ == numBoxes);
+    REQUIRE(view->GetStats().numRetainedGeometries_ == numBoxes);
+
+    auto boxModel = boxNodes[0]->GetComponent<StaticModel>();
+
+    SECTION("moved drawable keeps retained batches")
+    {
+        boxNodes[0]->Translate(Vector3{0.0f, 1.0f, 0.0f});
+        CHECK(renderFrame() == numBoxes);
+    }
+
+    SECTION("retained batches are discarded when material is changed")
+    {
+        const auto otherMaterial = CreateMaterial(context, "Techniques/NoTextureUnlit.xml");
+        boxModel->SetMaterial(otherMaterial);
+        CHECK(renderFrame() == numBoxes - 1);
+        CHECK(renderFrame() == numBoxes);
+    }
+
+    SECTION("retained batches are discarded when technique of material is changed")
+    {
+        unlitMaterial->SetTechnique(0, cache->GetResource<Technique>("Techniques/DiffUnlit.xml"));
+        CHECK(renderFrame() == 0);
+        CHECK(renderFrame() == numBoxes);
+    }
+
+    SECTION("retained batches are discarded when zone is changed")
+    {
+        boxNodes[0]->SetPosition(Vector3{0.0f, 0.0f, 10.0f});
+        CHECK(renderFrame() == numBoxes - 1);
+        CHECK(renderFrame() == numBoxes);
+    }
+
+    SECTION("retained batches are discarded when drawable becomes lit")
+    {
+        boxModel->SetMaterial(litMaterial);
+        CHECK(renderFrame() == numBoxes - 1);
+        CHECK(renderFrame() == numBoxes - 1);
+        CHECK(view->GetStats().numGeometries_ == numBoxes);
+
+        boxModel->SetMaterial(unlitMaterial);
+        CHECK(renderFrame() == numBoxes - 1);
+        CHECK(renderFrame() == numBoxes);
+    }
+
+    SECTION("retained batches are discarded when drawable is invisible for a frame")
+    {
+        // Last drawable is hidden so indices of other drawables are not changed
+        boxNodes.back()->SetEnabled(false);
+        CHECK(renderFrame() == numBoxes - 1);
+        CHECK(view->GetStats().numGeometries_ == numBoxes - 1);
+
+        boxNodes.back()->SetEnabled(true);
+        CHECK(renderFrame() == numBoxes - 1);
+        CHECK(renderFrame() == numBoxes);
+    }
+
+    renderer->SetViewport(0, nullptr);
+}
@@ -0,0 +1,54 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/Graphics.h>
+#include <Urho3D/Graphics/Shader.h>
+#include <Urho3D/Graphics/ShaderCompilationQueue.h>
+#include <Urho3D/Graphics/ShaderVariation.h>
+#include <Urho3D/Resource/ResourceCache.h>
+
+TEST_CASE("ShaderCompilationQueue compiles queued shader variations")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateNullBackendContext);
+    auto cache = context->GetSubsystem<ResourceCache>();
+    ShaderCompilationQueue* queue = context->GetSubsystem<Graphics>()->GetShaderCompilationQueue();
+    REQUIRE(queue->IsEmpty());
+
+    auto shader = cache->GetResource<Shader>("Shaders/GLSL/v2/Unlit.glsl");
+    REQUIRE(shader);
+
+    // Statistics are accumulated over the lifetime of the queue
+    const ShaderCompilationStats initialStats = queue->GetStats();
+
+    ea::vector<SharedPtr<ShaderVariation>> variations;
+    for (const char* defines : {"", "DIFFMAP", "VERTEXCOLOR", "DIFFMAP VERTEXCOLOR"})
+    {
+        for (ShaderType type : {VS, PS})
+        {
+            ShaderVariation* variation = shader->GetVariation(type, defines);
+            queue->EnqueueCompilation(variation);
+            variations.emplace_back(variation);
+        }
+    }
+
+    const unsigned numVariations = variations.size();
+    CHECK_FALSE(queue->IsEmpty());
+    CHECK(queue->GetStats().numPending_ == numVariations);
+    CHECK(queue->GetStats().maxPending_ >= numVariations);
+    for (ShaderVariation* variation : variations)
+        CHECK(variation->IsCompilationPending());
+
+    queue->CompleteAll();
+
+    const ShaderCompilationStats& stats = queue->GetStats();
+    CHECK(queue->IsEmpty());
+    CHECK(stats.numPending_ == 0);
+    CHECK(stats.numCompiled_ == initialStats.numCompiled_ + numVariations);
+    CHECK(stats.numFailed_ == initialStats.numFailed_);
+    CHECK(stats.totalCompileTimeMs_ >= initialStats.totalCompileTimeMs_);
+    for (ShaderVariation* variation : variations)
+        CHECK_FALSE(variation->IsCompilationPending());
+}
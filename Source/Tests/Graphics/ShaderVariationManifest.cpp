@@ -0,0 +1,109 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/ShaderVariationManifest.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Resource/JSONFile.h>
+
+namespace
+{
+
+SharedPtr<ShaderVariationManifest> SaveAndLoad(ShaderVariationManifest* manifest, InternalResourceFormat format)
+{
+    VectorBuffer buffer;
+    REQUIRE(manifest->Save(buffer, format));
+    buffer.Seek(0);
+
+    auto loadedManifest = MakeShared<ShaderVariationManifest>(manifest->GetContext());
+    REQUIRE(loadedManifest->Load(buffer));
+    return loadedManifest;
+}
+
+} // namespace
+
+TEST_CASE("ShaderVariationManifest ignores duplicate variations")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const ShaderVariationManifestEntry entryA{"Shaders/GLSL/LitSolid.glsl", VS, "DIRLIGHT PERPIXEL"};
+    const ShaderVariationManifestEntry entryB{"Shaders/GLSL/LitSolid.glsl", PS, "DIRLIGHT PERPIXEL"};
+    const ShaderVariationManifestEntry entryC{"Shaders/GLSL/Unlit.glsl", VS, ""};
+
+    auto manifest = MakeShared<ShaderVariationManifest>(context);
+    CHECK_FALSE(manifest->IsDirty());
+    CHECK(manifest->AddVariation(entryA));
+    CHECK(manifest->AddVariation(entryB));
+    CHECK_FALSE(manifest->AddVariation(entryA));
+    CHECK(manifest->IsDirty());
+    CHECK(manifest->GetVariations() == ea::vector<ShaderVariationManifestEntry>{entryA, entryB});
+
+    manifest->ResetDirty();
+    CHECK_FALSE(manifest->AddVariation(entryB));
+    CHECK_FALSE(manifest->IsDirty());
+
+    auto otherManifest = MakeShared<ShaderVariationManifest>(context);
+    otherManifest->AddVariation(entryB);
+    otherManifest->AddVariation(entryC);
+
+    manifest->Merge(*otherManifest);
+    CHECK(manifest->GetVariations() == ea::vector<ShaderVariationManifestEntry>{entryA, entryB, entryC});
+
+    manifest->Clear();
+    CHECK(manifest->GetVariations().empty());
+    CHECK(manifest->AddVariation(entryA));
+}
+
+TEST_CASE("ShaderVariationManifest is saved and loaded")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto manifest = MakeShared<ShaderVariationManifest>(context);
+    manifest->AddVariation({"Shaders/GLSL/LitSolid.glsl", VS, "DIRLIGHT PERPIXEL"});
+    manifest->AddVariation({"Shaders/GLSL/LitSolid.glsl", PS, "DIRLIGHT PERPIXEL"});
+    manifest->AddVariation({"Shaders/GLSL/Unlit.glsl", VS, ""});
+
+    for (const auto format : {InternalResourceFormat::Json, InternalResourceFormat::Xml, InternalResourceFormat::Binary})
+    {
+        auto loadedManifest = SaveAndLoad(manifest, format);
+        CHECK(loadedManifest->GetVariations() == manifest->GetVariations());
+        CHECK_FALSE(loadedManifest->IsDirty());
+
+        // Index is restored on load
+        CHECK_FALSE(loadedManifest->AddVariation({"Shaders/GLSL/Unlit.glsl", VS, ""}));
+        CHECK(loadedManifest->AddVariation({"Shaders/GLSL/Unlit.glsl", PS, ""}));
+    }
+}
+
+TEST_CASE("ShaderVariationManifest drops duplicate variations on load")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto manifest = MakeShared<ShaderVariationManifest>(context);
+    manifest->AddVariation({"Shaders/GLSL/LitSolid.glsl", VS, "DIRLIGHT PERPIXEL"});
+    manifest->AddVariation({"Shaders/GLSL/Unlit.glsl", VS, ""});
+
+    // Simulate manifests merged by hand
+    VectorBuffer buffer;
+    REQUIRE(manifest->Save(buffer, InternalResourceFormat::Json));
+    buffer.Seek(0);
+
+    auto jsonFile = MakeShared<JSONFile>(context);
+    REQUIRE(jsonFile->Load(buffer));
+    JSONValue variations = jsonFile->GetRoot().Get("variations");
+    REQUIRE(variations.Size() == 2);
+    const ea::vector<JSONValue> originalVariations = variations.GetArray();
+    for (const JSONValue& variation : originalVariations)
+        variations.Push(variation);
+    jsonFile->GetRoot().Set("variations", variations);
+
+    VectorBuffer mergedBuffer;
+    REQUIRE(jsonFile->Save(mergedBuffer));
+    mergedBuffer.Seek(0);
+
+    auto loadedManifest = MakeShared<ShaderVariationManifest>(context);
+    REQUIRE(loadedManifest->Load(mergedBuffer));
+    CHECK(loadedManifest->GetVariations() == manifest->GetVariations());
+}
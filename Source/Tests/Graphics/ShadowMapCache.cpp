@@ -0,0 +1,223 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/Light.h>
+#include <Urho3D/Graphics/Material.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/Renderer.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/Graphics/StaticModelGroup.h>
+#include <Urho3D/Graphics/Viewport.h>
+#include <Urho3D/Graphics/Zone.h>
+#include <Urho3D/RenderPipeline/RenderPipeline.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+/// Create spot light with fixed shadow map size looking at the origin.
+Node* CreateSpotLight(Scene* scene, const Vector3& position)
+{
+    Node* lightNode = scene->CreateChild("SpotLight");
+    lightNode->SetPosition(position);
+    lightNode->LookAt(Vector3::ZERO);
+    auto light = lightNode->CreateComponent<Light>();
+    light->SetLightType(LIGHT_SPOT);
+    light->SetRange(50.0f);
+    light->SetFov(90.0f);
+    light->SetCastShadows(true);
+    light->SetShadowFocus(FocusParameters{true, true, false, DEFAULT_SHADOWQUANTIZE, DEFAULT_SHADOWMINVIEW});
+    return lightNode;
+}
+
+}
+
+TEST_CASE("Cached shadow maps are re-rendered only when content is changed")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateNullBackendContext);
+    auto cache = context->GetSubsystem<ResourceCache>();
+    auto renderer = context->GetSubsystem<Renderer>();
+
+    auto scene = MakeShared<Scene>(context);
+    scene->CreateComponent<Octree>();
+
+    // Single cached spot light fills the whole atlas page
+    auto renderPipeline = scene->CreateComponent<RenderPipeline>();
+    RenderPipelineSettings settings = renderPipeline->GetSettings();
+    settings.shadowMapAllocator_.cacheShadowMaps_ = true;
+    settings.shadowMapAllocator_.maxCachedShadowAtlasPages_ = 1;
+    settings.shadowMapAllocator_.shadowAtlasPageSize_ = 512;
+    settings.sceneProcessor_.spotShadowSize_ = 512;
+    renderPipeline->SetSettings(settings);
+
+    auto zone = scene->CreateChild("Zone")->CreateComponent<Zone>();
+    zone->SetBoundingBox(BoundingBox(-1000.0f, 1000.0f));
+
+    Node* floorNode = scene->CreateChild("Floor");
+    floorNode->SetScale(Vector3{20.0f, 1.0f, 20.0f});
+    floorNode->CreateComponent<StaticModel>()->SetModel(cache->GetResource<Model>("Models/Plane.mdl"));
+
+    const auto boxMaterial = cache->GetResource<Material>("Materials/DefaultWhite.xml")->Clone();
+    Node* boxNode = scene->CreateChild("Box");
+    boxNode->SetPosition(Vector3{0.0f, 0.5f, 0.0f});
+    auto boxModel = boxNode->CreateComponent<StaticModel>();
+    boxModel->SetModel(cache->GetResource<Model>("Models/Box.mdl"));
+    boxModel->SetMaterial(boxMaterial);
+    boxModel->SetCastShadows(true);
+
+    // Instanced shadow caster has one transform per instance
+    auto boxGroup = scene->CreateChild("BoxGroup")->CreateComponent<StaticModelGroup>();
+    boxGroup->SetModel(cache->GetResource<Model>("Models/Box.mdl"));
+    boxGroup->SetCastShadows(true);
+    ea::vector<Node*> instanceNodes;
+    for (float x : {-2.0f, 2.0f})
+    {
+        Node* instanceNode = scene->CreateChild("BoxInstance");
+        instanceNode->SetPosition(Vector3{x, 0.5f, 0.0f});
+        boxGroup->AddInstanceNode(instanceNode);
+        instanceNodes.push_back(instanceNode);
+    }
+
+    Node* lightNode = CreateSpotLight(scene, Vector3{0.0f, 10.0f, -5.0f});
+
+    Node* cameraNode = scene->CreateChild("Camera");
+    cameraNode->SetPosition(Vector3(0.0f, 10.0f, -10.0f));
+    cameraNode->LookAt(Vector3::ZERO);
+    auto viewport = MakeShared<Viewport>(context, scene, cameraNode->CreateComponent<Camera>());
+    renderer->SetViewport(0, viewport);
+
+    Tests::RunFrame(context, 0.01f);
+    RenderPipelineView* view = viewport->GetRenderPipelineView();
+    REQUIRE(view);
+
+    const auto renderFrame = [&]
+    {
+        Tests::RunFrame(context, 0.01f);
+        return view->GetStats().numRenderedShadowMaps_;
+    };
+
+    // Shadow map is rendered once and then reused
+    renderFrame();
+    REQUIRE(view->GetStats().numShadowedLights_ == 1);
+    CHECK(renderFrame() == 0);
+    CHECK(renderFrame() == 0);
+
+    SECTION("shadow map is re-rendered when shadow caster is moved")
+    {
+        boxNode->Translate(Vector3{1.0f, 0.0f, 0.0f});
+        CHECK(renderFrame() == 1);
+        CHECK(renderFrame() == 0);
+    }
+
+    SECTION("shadow map is re-rendered when any instance of instanced shadow caster is moved")
+    {
+        instanceNodes.back()->Translate(Vector3{0.0f, 0.0f, 1.0f});
+        CHECK(renderFrame() == 1);
+        CHECK(renderFrame() == 0);
+    }
+
+    SECTION("shadow map is re-rendered when light is moved")
+    {
+        lightNode->Translate(Vector3{1.0f, 0.0f, 0.0f});
+        CHECK(renderFrame() == 1);
+        CHECK(renderFrame() == 0);
+    }
+
+    SECTION("shadow map is re-rendered when material of shadow caster is changed")
+    {
+        boxMaterial->SetShaderParameter("MatDiffColor", Color::RED);
+        CHECK(renderFrame() == 1);
+        CHECK(renderFrame() == 0);
+    }
+
+    SECTION("shadow map that doesn't fit into cache is transient and doesn't evict cached one")
+    {
+        Node* secondLightNode = CreateSpotLight(scene, Vector3{0.0f, 10.0f, 5.0f});
+        CHECK(renderFrame() == 1);
+        REQUIRE(view->GetStats().numShadowedLights_ == 2);
+        CHECK(renderFrame() == 1);
+        CHECK(renderFrame() == 1);
+
+        secondLightNode->Remove();
+        CHECK(renderFrame() == 0);
+    }
+
+    SECTION("unused shadow map is evicted when cache is overflown")
+    {
+        // Cached region of removed light is reclaimed on the next frame
+        lightNode->Remove();
+        CreateSpotLight(scene, Vector3{0.0f, 10.0f, 5.0f});
+        CHECK(renderFrame() == 1);
+        CHECK(renderFrame() == 1);
+        CHECK(renderFrame() == 0);
+    }
+
+    renderer->SetViewport(0, nullptr);
+}
+
+TEST_CASE("Cached shadow maps are kept when there are more cacheable lights than cache can hold")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateNullBackendContext);
+    auto cache = context->GetSubsystem<ResourceCache>();
+    auto renderer = context->GetSubsystem<Renderer>();
+
+    auto scene = MakeShared<Scene>(context);
+    scene->CreateComponent<Octree>();
+
+    // Cache page fits 4 spot lights
+    static const unsigned numCachedLights = 4;
+    auto renderPipeline = scene->CreateComponent<RenderPipeline>();
+    RenderPipelineSettings settings = renderPipeline->GetSettings();
+    settings.shadowMapAllocator_.cacheShadowMaps_ = true;
+    settings.shadowMapAllocator_.maxCachedShadowAtlasPages_ = 1;
+    settings.shadowMapAllocator_.shadowAtlasPageSize_ = 1024;
+    settings.sceneProcessor_.spotShadowSize_ = 512;
+    renderPipeline->SetSettings(settings);
+
+    auto zone = scene->CreateChild("Zone")->CreateComponent<Zone>();
+    zone->SetBoundingBox(BoundingBox(-1000.0f, 1000.0f));
+
+    Node* floorNode = scene->CreateChild("Floor");
+    floorNode->SetScale(Vector3{20.0f, 1.0f, 20.0f});
+    floorNode->CreateComponent<StaticModel>()->SetModel(cache->GetResource<Model>("Models/Plane.mdl"));
+
+    Node* boxNode = scene->CreateChild("Box");
+    boxNode->SetPosition(Vector3{0.0f, 0.5f, 0.0f});
+    auto boxModel = boxNode->CreateComponent<StaticModel>();
+    boxModel->SetModel(cache->GetResource<Model>("Models/Box.mdl"));
+    boxModel->SetCastShadows(true);
+
+    for (unsigned i = 0; i <= numCachedLights; ++i)
+        CreateSpotLight(scene, Vector3{i * 2.0f - 4.0f, 10.0f, -5.0f});
+
+    Node* cameraNode = scene->CreateChild("Camera");
+    cameraNode->SetPosition(Vector3(0.0f, 10.0f, -10.0f));
+    cameraNode->LookAt(Vector3::ZERO);
+    auto viewport = MakeShared<Viewport>(context, scene, cameraNode->CreateComponent<Camera>());
+    renderer->SetViewport(0, viewport);
+
+    Tests::RunFrame(context, 0.01f);
+    RenderPipelineView* view = viewport->GetRenderPipelineView();
+    REQUIRE(view);
+
+    const auto renderFrame = [&]
+    {
+        Tests::RunFrame(context, 0.01f);
+        return view->GetStats().numRenderedShadowMaps_;
+    };
+
+    renderFrame();
+    REQUIRE(view->GetStats().numShadowedLights_ == numCachedLights + 1);
+
+    // Only the light that doesn't fit into cache is rendered every frame
+    for (unsigned i = 0; i < 10; ++i)
+        CHECK(renderFrame() == 1);
+
+    renderer->SetViewport(0, nullptr);
+}
@@ -0,0 +1,110 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "GraphicsUtils.h"
+
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/Graphics/Terrain.h>
+#include <Urho3D/Graphics/TerrainPatch.h>
+#include <Urho3D/Graphics/VertexBuffer.h>
+#include <Urho3D/Resource/Image.h>
+#include <Urho3D/Scene/Scene.h>
+
+#include <atomic>
+#include <thread>
+
+TEST_CASE("Terrain patches are generated with extended LOD levels")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    auto heightMap = Tests::CreateHeightMap(context, 257);
+
+    Terrain* terrain = Tests::CreateTerrain(scene, heightMap, 128, 6, false);
+    CHECK(terrain->GetMaxLodLevels() == 6);
+    CHECK(terrain->GetNumPatches() == IntVector2(2, 2));
+    CHECK(terrain->GetNumPendingPatches() == 0);
+
+    // Patch size limits number of LOD levels: 128, 64, 32, 16, 8 and 4 quads per side
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        TerrainPatch* patch = terrain->GetPatch(i);
+        REQUIRE(patch);
+        REQUIRE(patch->GetLodErrors().size() == 6);
+        CHECK(patch->GetLodErrors()[0] == 0.0f);
+        CHECK(patch->GetLodErrors()[5] >= patch->GetLodErrors()[1]);
+        CHECK(patch->GetBoundingBox().Defined());
+        CHECK(patch->GetVertexBuffer()->GetVertexCount() == 129 * 129);
+    }
+
+    terrain->SetMaxLodLevels(16);
+    CHECK(terrain->GetMaxLodLevels() == 6);
+}
+
+TEST_CASE("Terrain patches generated asynchronously match synchronous generation")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    auto heightMap = Tests::CreateHeightMap(context, 513);
+
+    Terrain* syncTerrain = Tests::CreateTerrain(scene, heightMap, 32, 4, false);
+    Terrain* asyncTerrain = Tests::CreateTerrain(scene, heightMap, 32, 4, true);
+
+    const unsigned numPatches = syncTerrain->GetNumPatches().x_ * syncTerrain->GetNumPatches().y_;
+    REQUIRE(numPatches == 16 * 16);
+    if (context->GetSubsystem<WorkQueue>()->IsMultithreaded())
+        CHECK(asyncTerrain->GetNumPendingPatches() == numPatches);
+
+    // Patches that are still pending are generated again when the terrain is recreated
+    asyncTerrain->ApplyHeightMap();
+    asyncTerrain->CompletePatchGeneration();
+    CHECK(asyncTerrain->GetNumPendingPatches() == 0);
+
+    for (unsigned i = 0; i < numPatches; ++i)
+    {
+        TerrainPatch* syncPatch = syncTerrain->GetPatch(i);
+        TerrainPatch* asyncPatch = asyncTerrain->GetPatch(i);
+        REQUIRE(syncPatch);
+        REQUIRE(asyncPatch);
+        CHECK(syncPatch->GetCoordinates() == asyncPatch->GetCoordinates());
+        CHECK(syncPatch->GetBoundingBox() == asyncPatch->GetBoundingBox());
+        CHECK(syncPatch->GetLodErrors() == asyncPatch->GetLodErrors());
+        CHECK(asyncPatch->GetVertexBuffer()->GetVertexCount() == 33 * 33);
+    }
+}
+
+TEST_CASE("Terrain waits only for its own patches and stops generation when removed")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateMultithreadedContext);
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+    REQUIRE(workQueue->IsMultithreaded());
+
+    auto scene = MakeShared<Scene>(context);
+    auto heightMap = Tests::CreateHeightMap(context, 513);
+
+    // Unrelated task that is not finished until the terrain is ready
+    std::atomic<bool> isTerrainReady{};
+    workQueue->PostTask([&]() { while (!isTerrainReady) std::this_thread::yield(); }, TaskPriority::Low);
+
+    Terrain* terrain = Tests::CreateTerrain(scene, heightMap, 32, 4, true);
+    terrain->CompletePatchGeneration();
+    isTerrainReady = true;
+    CHECK(terrain->GetNumPendingPatches() == 0);
+
+    // Removed terrain keeps pending patches, but doesn't wait for them anymore
+    Terrain* removedTerrain = Tests::CreateTerrain(scene, heightMap, 32, 4, true);
+    Terrain* destroyedTerrain = Tests::CreateTerrain(scene, heightMap, 32, 4, true);
+    REQUIRE(removedTerrain->GetNumPendingPatches() != 0);
+    REQUIRE(removedTerrain->HasSubscribedToEvent(E_UPDATE));
+
+    const SharedPtr<Terrain> removedTerrainHolder{removedTerrain};
+    removedTerrain->GetNode()->RemoveComponent(removedTerrain);
+    CHECK(removedTerrain->GetNumPendingPatches() != 0);
+    CHECK_FALSE(removedTerrain->HasSubscribedToEvent(E_UPDATE));
+
+    destroyedTerrain->GetNode()->Remove();
+    workQueue->CompleteAll();
+    Tests::RunFrame(context, 0.1f);
+}
@@ -0,0 +1,38 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Math/Frustum.h>
+#include <Urho3D/Math/RandomEngine.h>
+
+TEST_CASE("Frustum tests arrays of bounding boxes same as individual boxes")
+{
+    Frustum frustum;
+    frustum.Define(60.0f, 1.5f, 1.0f, 0.5f, 50.0f, Matrix3x4(Vector3(1.0f, 2.0f, 3.0f), Quaternion(30.0f, Vector3::UP), 1.0f));
+
+    RandomEngine random(0);
+    ea::vector<BoundingBox> boxes;
+    for (unsigned i = 0; i < 203; ++i)
+    {
+        const Vector3 center{random.GetFloat(-60.0f, 60.0f), random.GetFloat(-60.0f, 60.0f), random.GetFloat(-60.0f, 60.0f)};
+        const Vector3 halfSize{random.GetFloat(0.1f, 5.0f), random.GetFloat(0.1f, 5.0f), random.GetFloat(0.1f, 5.0f)};
+        boxes.emplace_back(center - halfSize, center + halfSize);
+    }
+
+    ea::vector<bool> result(boxes.size());
+    frustum.AreInsideFast(boxes, result);
+
+    unsigned numInside = 0;
+    for (unsigned i = 0; i < boxes.size(); ++i)
+    {
+        const bool isInside = frustum.IsInsideFast(boxes[i]) != OUTSIDE;
+        CHECK(result[i] == isInside);
+        if (isInside)
+            ++numInside;
+    }
+
+    CHECK(numInside > 0);
+    CHECK(numInside < boxes.size());
+}
@@ -0,0 +1,45 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Math/TetrahedralMesh.h>
+
+using namespace Urho3D;
+
+namespace Tests
+{
+
+/// Create mesh from regular grid of vertices with random jitter.
+inline TetrahedralMesh CreateJitteredGridMesh(int gridSize, float cellSize, RandomEngine& randomEngine)
+{
+    ea::vector<Vector3> vertices;
+    for (int z = 0; z <= gridSize; ++z)
+    {
+        for (int y = 0; y <= gridSize; ++y)
+        {
+            for (int x = 0; x <= gridSize; ++x)
+            {
+                const bool isBorder = x == 0 || y == 0 || z == 0 || x == gridSize || y == gridSize || z == gridSize;
+                const Vector3 jitter =
+                    isBorder ? Vector3::ZERO : randomEngine.GetVector3(-Vector3::ONE, Vector3::ONE) * 0.25f;
+                const Vector3 position{static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)};
+                vertices.push_back((position + jitter) * cellSize);
+            }
+        }
+    }
+
+    TetrahedralMesh mesh;
+    mesh.Define(vertices);
+    return mesh;
+}
+
+/// Linear function that is interpolated exactly inside the mesh.
+inline float GetTestValue(const Vector3& position)
+{
+    return position.x_ + 2.0f * position.y_ - 3.0f * position.z_;
+}
+
+} // namespace Tests
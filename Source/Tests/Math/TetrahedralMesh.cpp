@@ -0,0 +1,49 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "MathUtils.h"
+
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Math/TetrahedralMesh.h>
+
+TEST_CASE("Tetrahedral mesh is sampled in batch with lookup grid")
+{
+    RandomEngine randomEngine{0};
+    TetrahedralMesh mesh = Tests::CreateJitteredGridMesh(6, 2.0f, randomEngine);
+    REQUIRE(mesh.numInnerTetrahedrons_ > 0);
+
+    ea::vector<float> values;
+    for (const Vector3& vertex : mesh.vertices_)
+        values.push_back(Tests::GetTestValue(vertex));
+
+    static const unsigned numPositions = 500;
+    ea::vector<Vector3> positions;
+    for (unsigned i = 0; i < numPositions; ++i)
+        positions.push_back(randomEngine.GetVector3(Vector3::ONE, Vector3::ONE * 11.0f));
+
+    for (const bool useLookupGrid : {false, true})
+    {
+        if (useLookupGrid)
+            mesh.BuildLookupGrid(8);
+
+        ea::vector<unsigned> hints(numPositions, M_MAX_UNSIGNED);
+        ea::vector<Vector4> weights(numPositions);
+        mesh.GetInterpolationFactors(positions, hints, weights);
+
+        for (unsigned i = 0; i < numPositions; ++i)
+        {
+            REQUIRE(hints[i] < mesh.numInnerTetrahedrons_);
+
+            const Tetrahedron& tetrahedron = mesh.tetrahedrons_[hints[i]];
+            float value = 0.0f;
+            for (unsigned j = 0; j < 4; ++j)
+                value += values[tetrahedron.indices_[j]] * weights[i].Data()[j];
+            REQUIRE(value == Catch::Approx(Tests::GetTestValue(positions[i])).margin(0.001f));
+
+            unsigned hint = M_MAX_UNSIGNED;
+            REQUIRE(mesh.Sample(values, positions[i], hint) == Catch::Approx(value).margin(0.001f));
+        }
+    }
+}
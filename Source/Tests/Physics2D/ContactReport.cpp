@@ -0,0 +1,223 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#if URHO3D_PHYSICS2D
+
+#include "../CommonUtils.h"
+#include "Physics2DUtils.h"
+
+#include <Urho3D/Physics2D/PhysicsEvents2D.h>
+#include <Urho3D/Physics2D/PhysicsWorld2D.h>
+#include <Urho3D/Physics2D/RigidBody2D.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+/// Create row of touching boxes resting on the ground and a ball moving towards it.
+SharedPtr<Scene> CreateSleepingRow(Context* context, unsigned numBoxes)
+{
+    auto scene = MakeShared<Scene>(context);
+    auto physicsWorld = scene->CreateComponent<PhysicsWorld2D>();
+    physicsWorld->SetContactReportEnabled(true);
+    Tests::CreateGround(scene, 20.0f);
+
+    for (unsigned i = 0; i < numBoxes; ++i)
+        Tests::CreateObject(scene, Vector2(i * 0.32f, 0.66f), true);
+    Tests::CreateObject(scene, Vector2(-4.0f, 0.66f), false);
+    return scene;
+}
+
+unsigned CountContacts(const ea::vector<PhysicsContact2D>& contacts, PhysicsContactType2D type)
+{
+    return ea::count_if(contacts.begin(), contacts.end(),
+        [type](const PhysicsContact2D& contact) { return contact.type_ == type; });
+}
+
+}
+
+TEST_CASE("PhysicsWorld2D reports contacts without events")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    auto physicsWorld = scene->CreateComponent<PhysicsWorld2D>();
+    physicsWorld->SetContactEventsEnabled(false);
+    physicsWorld->SetContactReportEnabled(true);
+
+    RigidBody2D* ground = Tests::CreateGround(scene, 10.0f);
+    RigidBody2D* ball = Tests::CreateObject(scene, Vector2(0.0f, 0.66f), false);
+
+    unsigned numEvents = 0;
+    scene->SubscribeToEvent(physicsWorld, E_PHYSICSBEGINCONTACT2D, [&] { ++numEvents; });
+    scene->SubscribeToEvent(physicsWorld, E_PHYSICSUPDATECONTACT2D, [&] { ++numEvents; });
+
+    unsigned numBegins = 0;
+    unsigned numPersists = 0;
+    for (unsigned i = 0; i < 60; ++i)
+    {
+        physicsWorld->Update(1.0f / 60.0f);
+
+        const ea::vector<PhysicsContact2D>& contacts = physicsWorld->GetContactReport();
+        for (const PhysicsContact2D& contact : contacts)
+        {
+            CHECK(((contact.bodyA_ == ground && contact.bodyB_ == ball)
+                || (contact.bodyA_ == ball && contact.bodyB_ == ground)));
+            CHECK(contact.shapeA_ != nullptr);
+            CHECK(contact.shapeB_ != nullptr);
+            CHECK(contact.numPoints_ > 0);
+        }
+
+        const unsigned numStepBegins = CountContacts(contacts, PhysicsContactType2D::Begin);
+        const unsigned numStepPersists = CountContacts(contacts, PhysicsContactType2D::Persist);
+        CHECK(numStepBegins + numStepPersists == contacts.size());
+        CHECK((numPersists == 0 || numStepPersists == 1));
+        numBegins += numStepBegins;
+        numPersists += numStepPersists;
+    }
+
+    CHECK(numEvents == 0);
+    CHECK(numBegins == 1);
+    CHECK(numPersists > 0);
+
+    // Moving the ball away ends the contact. Contacts of sleeping bodies are not updated, so wake the ball up
+    ball->GetNode()->SetPosition2D(Vector2(0.0f, 5.0f));
+    ball->SetAwake(true);
+    physicsWorld->Update(1.0f / 60.0f);
+    const ea::vector<PhysicsContact2D>& contacts = physicsWorld->GetContactReport();
+    REQUIRE(contacts.size() == 1);
+    CHECK(contacts[0].type_ == PhysicsContactType2D::End);
+
+    physicsWorld->Update(1.0f / 60.0f);
+    CHECK(physicsWorld->GetContactReport().empty());
+}
+
+TEST_CASE("PhysicsWorld2D multi-threaded contact evaluation matches single-threaded")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto singleThreadedScene = Tests::CreatePile(context, 200, 10);
+    auto multiThreadedScene = Tests::CreatePile(context, 200, 10);
+    auto singleThreadedWorld = singleThreadedScene->GetComponent<PhysicsWorld2D>();
+    auto multiThreadedWorld = multiThreadedScene->GetComponent<PhysicsWorld2D>();
+    multiThreadedWorld->SetMultiThreaded(true);
+
+    for (unsigned i = 0; i < 120; ++i)
+    {
+        singleThreadedWorld->Update(1.0f / 60.0f);
+        multiThreadedWorld->Update(1.0f / 60.0f);
+    }
+
+    const auto& singleThreadedNodes = singleThreadedScene->GetChildren();
+    const auto& multiThreadedNodes = multiThreadedScene->GetChildren();
+    REQUIRE(singleThreadedNodes.size() == multiThreadedNodes.size());
+    for (unsigned i = 0; i < singleThreadedNodes.size(); ++i)
+    {
+        CHECK(singleThreadedNodes[i]->GetPosition2D() == multiThreadedNodes[i]->GetPosition2D());
+        CHECK(singleThreadedNodes[i]->GetRotation2D() == multiThreadedNodes[i]->GetRotation2D());
+    }
+}
+
+TEST_CASE("PhysicsWorld2D multi-threaded contact evaluation matches single-threaded when sleeping bodies are hit")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto singleThreadedScene = CreateSleepingRow(context, 16);
+    auto multiThreadedScene = CreateSleepingRow(context, 16);
+    auto singleThreadedWorld = singleThreadedScene->GetComponent<PhysicsWorld2D>();
+    auto multiThreadedWorld = multiThreadedScene->GetComponent<PhysicsWorld2D>();
+    multiThreadedWorld->SetMultiThreaded(true);
+
+    const auto getBodies = [](Scene* scene)
+    {
+        ea::vector<RigidBody2D*> bodies;
+        for (Node* node : scene->GetChildren())
+            bodies.push_back(node->GetComponent<RigidBody2D>());
+        return bodies;
+    };
+    const ea::vector<RigidBody2D*> singleThreadedBodies = getBodies(singleThreadedScene);
+    const ea::vector<RigidBody2D*> multiThreadedBodies = getBodies(multiThreadedScene);
+    REQUIRE(singleThreadedBodies.size() == multiThreadedBodies.size());
+
+    const auto checkReportsEqual = [&]()
+    {
+        const auto getIndex = [](const ea::vector<RigidBody2D*>& bodies, RigidBody2D* body)
+        { return static_cast<unsigned>(bodies.index_of(body)); };
+
+        const ea::vector<PhysicsContact2D>& singleThreadedReport = singleThreadedWorld->GetContactReport();
+        const ea::vector<PhysicsContact2D>& multiThreadedReport = multiThreadedWorld->GetContactReport();
+        REQUIRE(singleThreadedReport.size() == multiThreadedReport.size());
+        for (unsigned i = 0; i < singleThreadedReport.size(); ++i)
+        {
+            const PhysicsContact2D& expected = singleThreadedReport[i];
+            const PhysicsContact2D& actual = multiThreadedReport[i];
+            CHECK(expected.type_ == actual.type_);
+            CHECK(getIndex(singleThreadedBodies, expected.bodyA_) == getIndex(multiThreadedBodies, actual.bodyA_));
+            CHECK(getIndex(singleThreadedBodies, expected.bodyB_) == getIndex(multiThreadedBodies, actual.bodyB_));
+            CHECK(expected.numPoints_ == actual.numPoints_);
+            CHECK(expected.worldNormal_ == actual.worldNormal_);
+        }
+    };
+
+    // Let the row fall asleep
+    for (unsigned i = 0; i < 180; ++i)
+    {
+        singleThreadedWorld->Update(1.0f / 60.0f);
+        multiThreadedWorld->Update(1.0f / 60.0f);
+        checkReportsEqual();
+    }
+
+    for (unsigned i = 0; i + 1 < singleThreadedBodies.size(); ++i)
+    {
+        if (singleThreadedBodies[i]->GetBodyType() == BT_DYNAMIC)
+            REQUIRE_FALSE(singleThreadedBodies[i]->IsAwake());
+    }
+
+    // Push the ball into the row, contacts between sleeping boxes are woken up in the middle of collide
+    singleThreadedBodies.back()->SetLinearVelocity(Vector2(20.0f, 0.0f));
+    multiThreadedBodies.back()->SetLinearVelocity(Vector2(20.0f, 0.0f));
+    for (unsigned i = 0; i < 60; ++i)
+    {
+        singleThreadedWorld->Update(1.0f / 60.0f);
+        multiThreadedWorld->Update(1.0f / 60.0f);
+        checkReportsEqual();
+    }
+
+    unsigned numAwakeBoxes = 0;
+    for (unsigned i = 0; i < singleThreadedBodies.size(); ++i)
+    {
+        const Vector2 expectedPosition = singleThreadedBodies[i]->GetNode()->GetPosition2D();
+        CHECK(expectedPosition == multiThreadedBodies[i]->GetNode()->GetPosition2D());
+        if (singleThreadedBodies[i]->GetBodyType() == BT_DYNAMIC && singleThreadedBodies[i]->IsAwake())
+            ++numAwakeBoxes;
+    }
+    CHECK(numAwakeBoxes > 1);
+}
+
+TEST_CASE("PhysicsWorld2D reports contacts ended between steps")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    auto physicsWorld = scene->CreateComponent<PhysicsWorld2D>();
+    physicsWorld->SetContactReportEnabled(true);
+
+    RigidBody2D* ground = Tests::CreateGround(scene, 10.0f);
+    RigidBody2D* ball = Tests::CreateObject(scene, Vector2(0.0f, 0.66f), false);
+    for (unsigned i = 0; i < 10; ++i)
+        physicsWorld->Update(1.0f / 60.0f);
+    REQUIRE(CountContacts(physicsWorld->GetContactReport(), PhysicsContactType2D::Persist) == 1);
+
+    // Removing the ball ends the contact outside of the step
+    ball->GetNode()->Remove();
+    physicsWorld->Update(1.0f / 60.0f);
+
+    const ea::vector<PhysicsContact2D>& contacts = physicsWorld->GetContactReport();
+    REQUIRE(contacts.size() == 1);
+    CHECK(contacts[0].type_ == PhysicsContactType2D::End);
+    CHECK((contacts[0].bodyA_ == ground || contacts[0].bodyB_ == ground));
+    CHECK((contacts[0].bodyA_.Expired() || contacts[0].bodyB_.Expired()));
+    CHECK((contacts[0].shapeA_.Expired() || contacts[0].shapeB_.Expired()));
+
+    physicsWorld->Update(1.0f / 60.0f);
+    CHECK(physicsWorld->GetContactReport().empty());
+}
+
+#endif
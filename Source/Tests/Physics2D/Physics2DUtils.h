@@ -0,0 +1,75 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include <Urho3D/Math/Random.h>
+#include <Urho3D/Physics2D/CollisionBox2D.h>
+#include <Urho3D/Physics2D/CollisionCircle2D.h>
+#include <Urho3D/Physics2D/PhysicsWorld2D.h>
+#include <Urho3D/Physics2D/RigidBody2D.h>
+#include <Urho3D/Scene/Scene.h>
+
+using namespace Urho3D;
+
+namespace Tests
+{
+
+/// Create static ground box.
+inline RigidBody2D* CreateGround(Scene* scene, float width)
+{
+    Node* groundNode = scene->CreateChild("Ground");
+    auto body = groundNode->CreateComponent<RigidBody2D>();
+    auto shape = groundNode->CreateComponent<CollisionBox2D>();
+    shape->SetSize(Vector2(width, 1.0f));
+    shape->SetFriction(0.5f);
+    return body;
+}
+
+/// Create dynamic box or ball.
+inline RigidBody2D* CreateObject(Scene* scene, const Vector2& position, bool isBox)
+{
+    Node* node = scene->CreateChild("RigidBody");
+    node->SetPosition2D(position);
+
+    auto body = node->CreateComponent<RigidBody2D>();
+    body->SetBodyType(BT_DYNAMIC);
+
+    CollisionShape2D* shape = nullptr;
+    if (isBox)
+    {
+        auto box = node->CreateComponent<CollisionBox2D>();
+        box->SetSize(Vector2(0.32f, 0.32f));
+        shape = box;
+    }
+    else
+    {
+        auto circle = node->CreateComponent<CollisionCircle2D>();
+        circle->SetRadius(0.16f);
+        shape = circle;
+    }
+    shape->SetDensity(1.0f);
+    shape->SetFriction(0.5f);
+    shape->SetRestitution(0.1f);
+    return body;
+}
+
+/// Create pile of objects falling to the ground, same as in Physics2D sample.
+inline SharedPtr<Scene> CreatePile(Context* context, unsigned numObjects, unsigned numColumns)
+{
+    auto scene = MakeShared<Scene>(context);
+    scene->CreateComponent<PhysicsWorld2D>();
+    CreateGround(scene, numColumns * 0.5f + 2.0f);
+
+    SetRandomSeed(1);
+    for (unsigned i = 0; i < numObjects; ++i)
+    {
+        const float x = (i % numColumns) * 0.5f - numColumns * 0.25f + Random(-0.1f, 0.1f);
+        const float y = 1.0f + (i / numColumns) * 0.4f;
+        CreateObject(scene, Vector2(x, y), i % 2 == 0);
+    }
+    return scene;
+}
+
+} // namespace Tests
@@ -0,0 +1,51 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "../SceneUtils.h"
+
+#include <Urho3D/Graphics/Light.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Scene/CookedScene.h>
+#include <Urho3D/Scene/Scene.h>
+
+TEST_CASE("Cooked scene is loaded with the same content")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = Tests::CreateTestScene(context, 10);
+    scene->CreateTemporaryChild("Temporary");
+
+    VectorBuffer buffer;
+    REQUIRE(scene->SaveCooked(buffer));
+
+    MemoryBuffer readBuffer(buffer);
+    REQUIRE(IsCookedScene(readBuffer));
+
+    auto loadedScene = MakeShared<Scene>(context);
+    REQUIRE(loadedScene->Load(readBuffer));
+
+    REQUIRE(loadedScene->GetNumChildren() == 10);
+    for (unsigned i = 0; i < 10; ++i)
+    {
+        const Node* node = loadedScene->GetChild(i);
+        REQUIRE(node->GetName() == Format("Node_{}", i));
+        CHECK(node->GetPosition() == Vector3(static_cast<float>(i), 1.0f, 2.0f));
+        CHECK(node->HasTag("Tag"));
+        CHECK(node->GetVar("Index") == Variant(static_cast<int>(i)));
+
+        auto staticModel = node->GetComponent<StaticModel>();
+        REQUIRE(staticModel);
+        CHECK(staticModel->GetLodBias() == 0.5f + i);
+        CHECK(staticModel->GetCastShadows() == (i % 2 == 0));
+
+        const Node* child = node->GetChild("Child");
+        REQUIRE(child);
+        auto light = child->GetComponent<Light>();
+        REQUIRE(!!light == (i % 3 == 0));
+        if (light)
+            CHECK(light->GetRange() == static_cast<float>(i + 1));
+    }
+}
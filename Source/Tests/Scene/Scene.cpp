@@ -23,8 +23,10 @@
 #include "../CommonUtils.h"
 #include "../SceneUtils.h"
 
+#include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/Graphics/StaticModel.h>
 #include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
 
 TEST_CASE("Scene lookup")
 {
@@ -105,3 +107,74 @@ TEST_CASE("Scene LoadXML from old XML")
 //    auto scene = MakeShared<Scene>(context);
 //    REQUIRE(!scene->LoadXML(xml));
 //}
+
+namespace
+{
+
+struct MemoryFile : public RefCounted, public VectorBuffer {};
+
+/// Save scene with root-level nodes that have components and children.
+AbstractFilePtr CreateSceneFileForAsyncLoading(Context* context, unsigned numNodes)
+{
+    auto scene = MakeShared<Scene>(context);
+    for (unsigned i = 0; i < numNodes; ++i)
+    {
+        Node* node = scene->CreateChild(Format("Child_{}", i));
+        node->CreateComponent<StaticModel>()->SetLodBias(1.0f + i);
+        node->CreateChild("Child")->CreateComponent<StaticModel>();
+    }
+
+    const AbstractFilePtr file{new MemoryFile()};
+    REQUIRE(scene->Save(*file));
+    file->Seek(0);
+    return file;
+}
+
+void CheckAsyncLoadedScene(Context* context, Scene* loadedScene, unsigned numNodes)
+{
+    for (unsigned i = 0; i < 1000 && loadedScene->IsAsyncLoading(); ++i)
+        Tests::RunFrame(context, 0.01f, 0.01f);
+
+    REQUIRE_FALSE(loadedScene->IsAsyncLoading());
+    REQUIRE(loadedScene->GetNumChildren() == numNodes);
+    for (unsigned i = 0; i < numNodes; ++i)
+    {
+        const Node* node = loadedScene->GetChild(i);
+        CHECK(node->GetName() == Format("Child_{}", i));
+        REQUIRE(node->GetComponent<StaticModel>());
+        CHECK(node->GetComponent<StaticModel>()->GetLodBias() == 1.0f + i);
+        REQUIRE(node->GetNumChildren() == 1);
+        CHECK(node->GetChild(0u)->GetComponent<StaticModel>());
+    }
+}
+
+}
+
+TEST_CASE("Scene LoadAsync from binary file")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const AbstractFilePtr file = CreateSceneFileForAsyncLoading(context, 20);
+
+    auto loadedScene = MakeShared<Scene>(context);
+    REQUIRE(loadedScene->LoadAsync(file, LOAD_SCENE));
+    CheckAsyncLoadedScene(context, loadedScene, 20);
+}
+
+TEST_CASE("Scene LoadAsync from binary file deserializes nodes in worker threads")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateMultithreadedContext);
+    REQUIRE(context->GetSubsystem<WorkQueue>()->IsMultithreaded());
+    const AbstractFilePtr file = CreateSceneFileForAsyncLoading(context, 200);
+
+    auto loadedScene = MakeShared<Scene>(context);
+    loadedScene->SetAsyncLoadingMs(1);
+
+    // Interrupted loading doesn't access the file after it's stopped
+    REQUIRE(loadedScene->LoadAsync(file, LOAD_SCENE));
+    Tests::RunFrame(context, 0.01f, 0.01f);
+    loadedScene->StopAsyncLoading();
+
+    file->Seek(0);
+    REQUIRE(loadedScene->LoadAsync(file, LOAD_SCENE));
+    CheckAsyncLoadedScene(context, loadedScene, 200);
+}
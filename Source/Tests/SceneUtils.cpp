@@ -22,6 +22,8 @@
 
 #include "SceneUtils.h"
 
+#include <Urho3D/Graphics/Light.h>
+#include <Urho3D/Graphics/StaticModel.h>
 #include <Urho3D/Resource/XMLFile.h>
 #include <Urho3D/Scene/Component.h>
 #include <Urho3D/Scene/PrefabWriter.h>
@@ -38,6 +40,27 @@ void SerializeAndDeserializeScene(Scene* scene)
     scene->LoadXML(xmlRoot);
 }
 
+SharedPtr<Scene> CreateTestScene(Context* context, unsigned numNodes)
+{
+    auto scene = MakeShared<Scene>(context);
+    for (unsigned i = 0; i < numNodes; ++i)
+    {
+        Node* node = scene->CreateChild(Format("Node_{}", i));
+        node->SetPosition(Vector3(static_cast<float>(i), 1.0f, 2.0f));
+        node->AddTag("Tag");
+        node->SetVar("Index", static_cast<int>(i));
+
+        auto staticModel = node->CreateComponent<StaticModel>();
+        staticModel->SetLodBias(0.5f + i);
+        staticModel->SetCastShadows(i % 2 == 0);
+
+        Node* child = node->CreateChild("Child");
+        if (i % 3 == 0)
+            child->CreateComponent<Light>()->SetRange(static_cast<float>(i + 1));
+    }
+    return scene;
+}
+
 SharedPtr<PrefabResource> ConvertNodeToPrefab(Node* node)
 {
     auto prefab = MakeShared<PrefabResource>(node->GetContext());
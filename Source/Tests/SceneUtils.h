@@ -33,6 +33,9 @@ namespace Tests
 /// Serialize and deserialize Scene. Should preserve functional state of nodes and components.
 void SerializeAndDeserializeScene(Scene* scene);
 
+/// Create scene with given number of nodes with tags, variables, static models and lights.
+SharedPtr<Scene> CreateTestScene(Context* context, unsigned numNodes);
+
 /// Convert Node to prefab.
 SharedPtr<PrefabResource> ConvertNodeToPrefab(Node* node);
 
@@ -0,0 +1,153 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "UIUtils.h"
+
+#include <Urho3D/UI/BorderImage.h>
+#include <Urho3D/UI/Button.h>
+#include <Urho3D/UI/UI.h>
+#include <Urho3D/UI/UIBatch.h>
+
+namespace
+{
+
+/// Compare vertex data bitwise. Packed colors may be NaN when interpreted as floats.
+bool IsSameVertexData(const ea::vector<float>& lhs, const ea::vector<float>& rhs)
+{
+    return lhs.size() == rhs.size() && (lhs.empty() || memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(float)) == 0);
+}
+
+}
+
+TEST_CASE("UI element batches are cached until element is changed")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto root = Tests::CreateImageGrid(context, 10);
+
+    ea::vector<UIBatch> batches;
+    ea::vector<float> vertexData;
+    CHECK(root->IsHierarchyBatchesDirty());
+    root->ResetHierarchyBatchesDirty();
+    CHECK(Tests::CollectBatches(root, batches, vertexData, true) == 100);
+
+    // Nothing is regenerated if nothing is changed
+    batches.clear();
+    vertexData.clear();
+    CHECK_FALSE(root->IsHierarchyBatchesDirty());
+    CHECK(Tests::CollectBatches(root, batches, vertexData, true) == 0);
+    CHECK_FALSE(root->IsHierarchyBatchesDirty());
+
+    // Only changed elements are regenerated
+    root->GetChild(42u)->SetColor(Color::RED);
+    root->GetChild(7u)->SetPosition(100, 100);
+    CHECK(root->IsHierarchyBatchesDirty());
+    root->ResetHierarchyBatchesDirty();
+
+    ea::vector<UIBatch> cachedBatches;
+    ea::vector<float> cachedVertexData;
+    CHECK(Tests::CollectBatches(root, cachedBatches, cachedVertexData, true) == 2);
+
+    // Cached output is the same as regenerated one
+    ea::vector<UIBatch> referenceBatches;
+    ea::vector<float> referenceVertexData;
+    Tests::CollectBatches(root, referenceBatches, referenceVertexData, false);
+
+    CHECK(IsSameVertexData(cachedVertexData, referenceVertexData));
+    REQUIRE(cachedBatches.size() == referenceBatches.size());
+    for (unsigned i = 0; i < cachedBatches.size(); ++i)
+    {
+        CHECK(cachedBatches[i].vertexStart_ == referenceBatches[i].vertexStart_);
+        CHECK(cachedBatches[i].vertexEnd_ == referenceBatches[i].vertexEnd_);
+        CHECK(cachedBatches[i].vertexData_ == &cachedVertexData);
+    }
+
+    // Removed element dirties the hierarchy
+    root->ResetHierarchyBatchesDirty();
+    root->RemoveChildAtIndex(0);
+    CHECK(root->IsHierarchyBatchesDirty());
+}
+
+TEST_CASE("UI hierarchy batches are marked dirty up to the first dirty ancestor")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto root = MakeShared<UIElement>(context);
+    UIElement* parent = root->CreateChild<UIElement>();
+    UIElement* child = parent->CreateChild<UIElement>();
+    UIElement* leaf = child->CreateChild<UIElement>();
+    UIElement* otherParent = root->CreateChild<UIElement>();
+
+    root->ResetHierarchyBatchesDirty();
+    for (UIElement* element : {root.Get(), parent, child, leaf, otherParent})
+        CHECK_FALSE(element->IsHierarchyBatchesDirty());
+
+    // Whole path to the root is marked
+    leaf->MarkHierarchyBatchesDirty();
+    for (UIElement* element : {root.Get(), parent, child, leaf})
+        CHECK(element->IsHierarchyBatchesDirty());
+    CHECK_FALSE(otherParent->IsHierarchyBatchesDirty());
+
+    root->ResetHierarchyBatchesDirty();
+    for (UIElement* element : {root.Get(), parent, child, leaf})
+        CHECK_FALSE(element->IsHierarchyBatchesDirty());
+
+    child->MarkHierarchyBatchesDirty();
+    CHECK_FALSE(leaf->IsHierarchyBatchesDirty());
+    CHECK(parent->IsHierarchyBatchesDirty());
+
+    // Element that is already dirty dirties its new parent when moved
+    root->ResetHierarchyBatchesDirty();
+    leaf->MarkHierarchyBatchesDirty();
+    otherParent->ResetHierarchyBatchesDirty();
+    leaf->SetParent(otherParent);
+    CHECK(otherParent->IsHierarchyBatchesDirty());
+    CHECK(root->IsHierarchyBatchesDirty());
+}
+
+TEST_CASE("UI batches are updated when cached element is hovered and pressed")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateNullBackendContext);
+    auto ui = context->GetSubsystem<UI>();
+    ui->SetBatchCaching(true);
+
+    auto button = ui->GetRoot()->CreateChild<Button>();
+    button->SetPosition(10, 10);
+    button->SetSize(50, 20);
+    button->SetHoverOffset(0, 20);
+    button->SetPressedOffset(0, 40);
+    const IntVector2 buttonPosition = button->GetScreenPosition() + IntVector2{5, 5};
+
+    ui->RenderUpdate();
+    const ea::vector<float> idleVertexData = ui->GetVertexData();
+    REQUIRE_FALSE(idleVertexData.empty());
+
+    ui->RenderUpdate();
+    CHECK(ui->GetNumElementBatchUpdates() == 0);
+    CHECK(IsSameVertexData(ui->GetVertexData(), idleVertexData));
+
+    // Hover is applied in this frame and reset in the next one
+    button->OnHover(IntVector2::ZERO, buttonPosition, MOUSEB_NONE, QUAL_NONE, nullptr);
+    ui->RenderUpdate();
+    const ea::vector<float> hoverVertexData = ui->GetVertexData();
+    CHECK(ui->GetNumElementBatchUpdates() == 1);
+    CHECK_FALSE(IsSameVertexData(hoverVertexData, idleVertexData));
+
+    ui->RenderUpdate();
+    CHECK(IsSameVertexData(ui->GetVertexData(), idleVertexData));
+
+    button->OnClickBegin(IntVector2::ZERO, buttonPosition, MOUSEB_LEFT, MOUSEB_LEFT, QUAL_NONE, nullptr);
+    ui->RenderUpdate();
+    CHECK(button->IsPressed());
+    CHECK_FALSE(IsSameVertexData(ui->GetVertexData(), idleVertexData));
+    CHECK_FALSE(IsSameVertexData(ui->GetVertexData(), hoverVertexData));
+
+    // Button released over the element keeps hovering
+    button->OnClickEnd(IntVector2::ZERO, buttonPosition, MOUSEB_LEFT, MOUSEB_NONE, QUAL_NONE, nullptr, button);
+    ui->RenderUpdate();
+    CHECK_FALSE(button->IsPressed());
+    CHECK(IsSameVertexData(ui->GetVertexData(), hoverVertexData));
+
+    button->Remove();
+    ui->SetBatchCaching(false);
+}
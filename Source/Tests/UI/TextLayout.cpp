@@ -0,0 +1,116 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "UIUtils.h"
+
+#include <Urho3D/UI/Font.h>
+#include <Urho3D/UI/FontFace.h>
+#include <Urho3D/UI/TextLayout.h>
+
+namespace
+{
+
+void CheckLayoutsEqual(const TextLayout& lhs, const TextLayout& rhs)
+{
+    CHECK(lhs.printText_ == rhs.printText_);
+    CHECK(lhs.printToText_ == rhs.printToText_);
+    CHECK(lhs.glyphs_ == rhs.glyphs_);
+    CHECK(lhs.kernings_ == rhs.kernings_);
+    CHECK(lhs.rowWidths_ == rhs.rowWidths_);
+    CHECK(lhs.lastRowWidth_ == rhs.lastRowWidth_);
+    CHECK(lhs.width_ == rhs.width_);
+}
+
+}
+
+TEST_CASE("Text layout is word wrapped and measured")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto font = MakeShared<Font>(context);
+    auto face = MakeShared<Tests::TestFontFace>(font);
+
+    TextLayout layout;
+    layout.Calculate(face, Tests::ToUnicode("AV ab\ncd efgh"), 45);
+
+    CHECK(layout.printText_ == Tests::ToUnicode("AV\nab\ncd\nefgh"));
+    CHECK(layout.rowWidths_ == (ea::vector<float>{18.0f, 20.0f, 20.0f}));
+    CHECK(layout.lastRowWidth_ == 40);
+    CHECK(layout.width_ == 40);
+    CHECK(layout.kernings_[0] == -2.0f);
+    CHECK(layout.glyphs_[2] == nullptr);
+
+    ea::vector<float> rowWidths;
+    layout.GetRowWidths(rowWidths);
+    CHECK(rowWidths.size() == 4);
+}
+
+TEST_CASE("Text layouts are cached and extended when text is appended")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto font = MakeShared<Font>(context);
+    auto face = MakeShared<Tests::TestFontFace>(font);
+
+    const ea::vector<unsigned> text = Tests::ToUnicode("Hello world\nThis is a log line that wraps");
+    const ea::vector<unsigned> appendedText =
+        Tests::ToUnicode("Hello world\nThis is a log line that wraps\nAnd next one AV");
+
+    for (const int maxWidth : {M_MAX_INT, 100, 35})
+    {
+        TextLayoutCache cache(text.size() + appendedText.size());
+
+        const SharedPtr<TextLayout> layout = cache.GetLayout(face, text, maxWidth, nullptr);
+        CHECK(cache.GetNumMisses() == 1);
+        CHECK(cache.GetLayout(face, text, maxWidth, nullptr) == layout);
+        CHECK(cache.GetNumHits() == 1);
+
+        // Appended text reuses previous layout and matches layout calculated from scratch
+        const SharedPtr<TextLayout> appendedLayout = cache.GetLayout(face, appendedText, maxWidth, layout);
+        CHECK(cache.GetNumAppends() == 1);
+
+        TextLayout referenceLayout;
+        referenceLayout.Calculate(face, appendedText, maxWidth);
+        CheckLayoutsEqual(*appendedLayout, referenceLayout);
+
+        // Least recently used layout is evicted
+        cache.GetLayout(face, Tests::ToUnicode("Other text"), maxWidth, nullptr);
+        CHECK(cache.GetSize() == 2);
+        CHECK(cache.GetLayout(face, text, maxWidth, nullptr) != layout);
+        CHECK(cache.GetNumMisses() == 3);
+    }
+}
+
+TEST_CASE("Text layout cache is bounded by number of characters")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto font = MakeShared<Font>(context);
+    auto face = MakeShared<Tests::TestFontFace>(font);
+
+    TextLayoutCache cache(100);
+    for (unsigned i = 0; i < 10; ++i)
+        cache.GetLayout(face, Tests::ToUnicode(Format("Line {:5}", i)), M_MAX_INT, nullptr);
+    CHECK(cache.GetSize() == 10);
+    CHECK(cache.GetNumCharacters() == 100);
+
+    // Least recently used layouts are evicted until the new one fits: 7 old lines and the new one
+    cache.GetLayout(face, Tests::ToUnicode(ea::string(30, 'a')), M_MAX_INT, nullptr);
+    CHECK(cache.GetSize() == 8);
+    CHECK(cache.GetNumCharacters() == 100);
+
+    // Growing text keeps only the latest layout if it exceeds the limit
+    ea::string longText;
+    SharedPtr<TextLayout> longLayout;
+    for (unsigned i = 0; i < 20; ++i)
+    {
+        longText += "Log line\n";
+        longLayout = cache.GetLayout(face, Tests::ToUnicode(longText), M_MAX_INT, longLayout);
+    }
+    CHECK(cache.GetNumAppends() == 19);
+    CHECK(cache.GetSize() == 1);
+    CHECK(cache.GetNumCharacters() == longText.size());
+
+    cache.Clear();
+    CHECK(cache.GetSize() == 0);
+    CHECK(cache.GetNumCharacters() == 0);
+}
@@ -0,0 +1,104 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include <Urho3D/UI/BorderImage.h>
+#include <Urho3D/UI/Font.h>
+#include <Urho3D/UI/FontFace.h>
+#include <Urho3D/UI/ListView.h>
+#include <Urho3D/UI/UIBatch.h>
+
+using namespace Urho3D;
+
+namespace Tests
+{
+
+/// Create root element with grid of static images.
+inline SharedPtr<UIElement> CreateImageGrid(Context* context, int gridSize)
+{
+    auto root = MakeShared<UIElement>(context);
+    root->SetSize(gridSize * 4, gridSize * 4);
+    for (int y = 0; y < gridSize; ++y)
+    {
+        for (int x = 0; x < gridSize; ++x)
+        {
+            auto image = root->CreateChild<BorderImage>();
+            image->SetPosition(x * 4, y * 4);
+            image->SetSize(3, 3);
+            image->SetColor(Color(x / static_cast<float>(gridSize), y / static_cast<float>(gridSize), 0.5f));
+        }
+    }
+    return root;
+}
+
+/// Collect batches from element hierarchy similarly to UI. Return number of regenerated elements.
+inline unsigned CollectBatches(
+    UIElement* element, ea::vector<UIBatch>& batches, ea::vector<float>& vertexData, bool useCache)
+{
+    const IntRect scissor{0, 0, 4096, 4096};
+
+    unsigned numUpdates = 0;
+    for (UIElement* child : element->GetChildren())
+    {
+        if (!useCache)
+        {
+            child->GetBatches(batches, vertexData, scissor);
+            ++numUpdates;
+        }
+        else if (child->GetCachedBatches(batches, vertexData, scissor))
+            ++numUpdates;
+
+        numUpdates += CollectBatches(child, batches, vertexData, useCache);
+    }
+    return numUpdates;
+}
+
+/// Font face with fixed-width ASCII glyphs and kerning for one pair.
+class TestFontFace : public FontFace
+{
+public:
+    explicit TestFontFace(Font* font)
+        : FontFace(font)
+    {
+        for (unsigned c = ' '; c < 128; ++c)
+        {
+            FontGlyph glyph;
+            glyph.advanceX_ = 10.0f;
+            glyph.page_ = 0;
+            glyphMapping_[c] = glyph;
+        }
+        kerningMapping_[('A' << 16u) + 'V'] = -2.0f;
+        rowHeight_ = 16.0f;
+    }
+
+    bool Load(const unsigned char* fontData, unsigned fontDataSize, float pointSize) override { return true; }
+};
+
+/// Convert ASCII text to code points.
+inline ea::vector<unsigned> ToUnicode(const ea::string& text)
+{
+    ea::vector<unsigned> result;
+    for (const char c : text)
+        result.push_back(static_cast<unsigned>(c));
+    return result;
+}
+
+/// Variable of virtual ListView row that stores bound item index.
+static const ea::string itemIndexVar{"ItemIndex"};
+
+/// Enable virtual mode with rows that remember bound item index.
+inline void SetupVirtualListView(ListView* listView, unsigned numItems, int itemHeight, unsigned& numBinds)
+{
+    Context* context = listView->GetContext();
+    const auto factory = [context] { return MakeShared<UIElement>(context); };
+    const auto binder = [&numBinds](UIElement* row, unsigned index)
+    {
+        row->SetVar(itemIndexVar, index);
+        ++numBinds;
+    };
+    listView->SetVirtualItems(numItems, itemHeight, factory, binder);
+}
+
+} // namespace Tests
@@ -0,0 +1,69 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "UIUtils.h"
+
+#include <Urho3D/UI/ListView.h>
+
+TEST_CASE("Virtual ListView creates only visible rows")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto listView = MakeShared<ListView>(context);
+    listView->SetSize(200, 100);
+    listView->SetHighlightMode(HM_ALWAYS);
+
+    unsigned numBinds = 0;
+    Tests::SetupVirtualListView(listView, 50000, 20, numBinds);
+
+    REQUIRE(listView->IsVirtual());
+    CHECK(listView->GetNumItems() == 50000);
+    CHECK(listView->GetNumVirtualRows() > 0);
+    CHECK(listView->GetNumVirtualRows() <= 7);
+    CHECK(numBinds == listView->GetNumVirtualRows());
+    CHECK(listView->GetContentElement()->GetHeight() == 50000 * 20);
+
+    REQUIRE(listView->GetItem(0));
+    CHECK(listView->GetItem(0)->GetVar(Tests::itemIndexVar).GetUInt() == 0);
+    CHECK(listView->GetItem(49999) == nullptr);
+
+    // Scrolling by one item rebinds one row
+    numBinds = 0;
+    listView->SetViewPosition(0, 20);
+    CHECK(numBinds == 1);
+    CHECK(listView->GetItem(0) == nullptr);
+
+    // Scrolling far away rebinds each row once
+    numBinds = 0;
+    listView->SetViewPosition(0, 25000 * 20);
+    CHECK(numBinds == listView->GetNumVirtualRows());
+    UIElement* item = listView->GetItem(25000);
+    REQUIRE(item);
+    CHECK(item->GetVar(Tests::itemIndexVar).GetUInt() == 25000);
+    CHECK(item->GetPosition().y_ == 25000 * 20);
+    CHECK(listView->FindItem(item) == 25000);
+
+    // Selection is scrolled into view and applied to bound row
+    listView->SetSelection(40000);
+    CHECK(listView->GetSelection() == 40000);
+    REQUIRE(listView->GetSelectedItem());
+    CHECK(listView->GetSelectedItem()->IsSelected());
+    CHECK(listView->GetSelectedItem()->GetVar(Tests::itemIndexVar).GetUInt() == 40000);
+
+    listView->ChangeSelection(5);
+    CHECK(listView->GetSelection() == 40005);
+    REQUIRE(listView->GetItem(40005));
+    CHECK(listView->GetItem(40005)->IsSelected());
+
+    // Selection of removed items is cleared
+    listView->SetNumVirtualItems(1000);
+    CHECK(listView->GetNumItems() == 1000);
+    CHECK(listView->GetSelections().empty());
+    CHECK(listView->GetItem(999));
+
+    listView->ResetVirtualItems();
+    CHECK_FALSE(listView->IsVirtual());
+    CHECK(listView->GetNumItems() == 0);
+}
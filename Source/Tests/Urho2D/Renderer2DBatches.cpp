@@ -0,0 +1,104 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "Urho2DUtils.h"
+
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/Geometry.h>
+#include <Urho3D/Graphics/Material.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/Renderer.h>
+#include <Urho3D/Graphics/Viewport.h>
+#include <Urho3D/RenderPipeline/ShaderConsts.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Urho2D/Renderer2D.h>
+#include <Urho3D/Urho2D/Sprite2D.h>
+#include <Urho3D/Urho2D/StaticSprite2D.h>
+
+#include <EASTL/sort.h>
+
+TEST_CASE("Renderer2D sorts source batches by draw order, distance and material")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto renderer = MakeShared<Renderer2D>(context);
+    const auto materials = Tests::CreateMaterials(context, 5);
+
+    SetRandomSeed(1);
+    for (const unsigned numDistances : {1u, 4u, 1000u})
+    {
+        const ea::vector<SourceBatch2D> sourceBatches = Tests::CreateSourceBatches(materials, 1000, 3, numDistances);
+
+        ea::vector<const SourceBatch2D*> sortedBatches = Tests::GetPointers(sourceBatches);
+        renderer->SortSourceBatches(sortedBatches);
+
+        ea::vector<const SourceBatch2D*> referenceBatches = Tests::GetPointers(sourceBatches);
+        ea::stable_sort(referenceBatches.begin(), referenceBatches.end(), Tests::CompareSourceBatches);
+
+        CHECK(sortedBatches == referenceBatches);
+    }
+}
+
+TEST_CASE("Renderer2D builds one view batch per material group")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateNullBackendContext);
+    auto cache = context->GetSubsystem<ResourceCache>();
+    auto renderer = context->GetSubsystem<Renderer>();
+
+    auto scene = MakeShared<Scene>(context);
+    scene->CreateComponent<Octree>();
+
+    // Each layer uses single sprite, neighbour layers use different sprites
+    static const unsigned numLayers = 3;
+    static const unsigned numSpritesInLayer = 4;
+    Sprite2D* sprites[] = {
+        cache->GetResource<Sprite2D>("Urho2D/Box.png"), cache->GetResource<Sprite2D>("Urho2D/Ball.png")};
+    REQUIRE(sprites[0]);
+    REQUIRE(sprites[1]);
+    for (unsigned layer = 0; layer < numLayers; ++layer)
+    {
+        for (unsigned i = 0; i < numSpritesInLayer; ++i)
+        {
+            Node* spriteNode = scene->CreateChild("Sprite");
+            spriteNode->SetPosition(Vector3{i * 0.5f, layer * 0.5f, 0.0f});
+            auto staticSprite = spriteNode->CreateComponent<StaticSprite2D>();
+            staticSprite->SetSprite(sprites[layer % 2]);
+            staticSprite->SetLayer(layer);
+        }
+    }
+
+    Node* cameraNode = scene->CreateChild("Camera");
+    cameraNode->SetPosition(Vector3{0.0f, 0.0f, -10.0f});
+    auto camera = cameraNode->CreateComponent<Camera>();
+    camera->SetOrthographic(true);
+    camera->SetOrthoSize(20.0f);
+    auto viewport = MakeShared<Viewport>(context, scene, camera);
+    renderer->SetViewport(0, viewport);
+
+    Tests::RunFrame(context, 0.01f);
+    Tests::RunFrame(context, 0.01f);
+
+    auto renderer2D = scene->GetComponent<Renderer2D>();
+    REQUIRE(renderer2D);
+
+    // View batches cover consecutive index and vertex ranges
+    const auto& batches = renderer2D->GetBatches();
+    REQUIRE(batches.size() == numLayers);
+    unsigned indexStart = 0;
+    unsigned vertexStart = 0;
+    for (unsigned i = 0; i < batches.size(); ++i)
+    {
+        const Geometry* geometry = batches[i].geometry_;
+        CHECK(batches[i].material_->GetTexture(ShaderResources::Albedo) == sprites[i % 2]->GetTexture());
+        CHECK(geometry->GetIndexStart() == indexStart);
+        CHECK(geometry->GetIndexCount() == numSpritesInLayer * 6);
+        CHECK(geometry->GetVertexStart() == vertexStart);
+        CHECK(geometry->GetVertexCount() == numSpritesInLayer * 4);
+        indexStart += geometry->GetIndexCount();
+        vertexStart += geometry->GetVertexCount();
+    }
+
+    renderer->SetViewport(0, nullptr);
+}
@@ -0,0 +1,181 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../CommonUtils.h"
+#include "Urho2DUtils.h"
+
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/Graphics/Material.h>
+#include <Urho3D/Graphics/Texture2D.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Urho2D/Renderer2D.h>
+#include <Urho3D/Urho2D/Sprite2D.h>
+#include <Urho3D/Urho2D/TileMap2D.h>
+#include <Urho3D/Urho2D/TileMapChunk2D.h>
+#include <Urho3D/Urho2D/TileMapLayer2D.h>
+#include <Urho3D/Urho2D/TmxFile2D.h>
+
+namespace
+{
+
+/// Create 4x2 orthogonal tile map with two tilesets. Tiles are bigger than cells and overlap.
+SharedPtr<TmxFile2D> CreateOverlappingTileMap(Context* context)
+{
+    const ea::string data = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<map version=\"1.0\" orientation=\"orthogonal\" width=\"4\" height=\"2\" tilewidth=\"32\" tileheight=\"32\">\n"
+        "<tileset firstgid=\"1\" name=\"grass\" tilewidth=\"64\" tileheight=\"64\">\n"
+        "<image source=\"isometric_grass_and_water.png\" width=\"256\" height=\"512\"/>\n"
+        "</tileset>\n"
+        "<tileset firstgid=\"33\" name=\"aster\" tilewidth=\"64\" tileheight=\"64\">\n"
+        "<image source=\"Aster.png\" width=\"64\" height=\"64\"/>\n"
+        "</tileset>\n"
+        "<layer name=\"Tiles\" width=\"4\" height=\"2\">\n"
+        "<data encoding=\"csv\">\n"
+        "1,33,1,33,\n"
+        "33,33,1,1\n"
+        "</data>\n</layer>\n</map>\n";
+
+    auto tmxFile = MakeShared<TmxFile2D>(context);
+    tmxFile->SetName("Urho2D/GeneratedOverlappingTileMap.tmx");
+    MemoryBuffer buffer(data.data(), data.size());
+    REQUIRE(tmxFile->Load(buffer));
+    return tmxFile;
+}
+
+}
+
+TEST_CASE("Tile map layer is rendered in chunks")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    auto tileMap = scene->CreateChild("TileMap")->CreateComponent<TileMap2D>();
+    tileMap->SetTmxFile(Tests::CreateTileMap(context, 40, 40));
+
+    TileMapLayer2D* layer = tileMap->GetLayer(0);
+    REQUIRE(layer);
+    CHECK(layer->GetNode()->GetNumChildren() == 1);
+    REQUIRE(layer->GetNumChunks() == 3);
+
+    TileMapChunk2D* firstChunk = layer->GetChunk(0, 0);
+    TileMapChunk2D* lastChunk = layer->GetChunk(39, 39);
+    REQUIRE(firstChunk);
+    REQUIRE(lastChunk);
+    CHECK(layer->GetChunk(39, 0) == firstChunk);
+    CHECK(firstChunk->GetTileRect() == IntRect(0, 0, 40, 16));
+    CHECK(lastChunk->GetTileRect() == IntRect(0, 32, 40, 40));
+    CHECK(Tests::GetNumVertices(firstChunk) == 40 * 16 * 4);
+    CHECK(Tests::GetNumVertices(lastChunk) == 40 * 8 * 4);
+    CHECK(firstChunk->GetLayer() == lastChunk->GetLayer());
+    CHECK(firstChunk->GetOrderInLayer() < lastChunk->GetOrderInLayer());
+    CHECK(layer->GetTileNode(0, 0) == nullptr);
+
+    ea::vector<unsigned> numRebuilds;
+    for (int y = 0; y < 40; y += 16)
+    {
+        Tests::GetNumVertices(layer->GetChunk(0, y));
+        numRebuilds.push_back(layer->GetChunk(0, y)->GetNumRebuilds());
+    }
+
+    // Only the chunk with changed tile is rebuilt
+    TileMapChunk2D* changedChunk = layer->GetChunk(20, 20);
+    layer->SetTileSprite(20, 20, nullptr);
+    CHECK(layer->GetTileSprite(20, 20).sprite_ == nullptr);
+    CHECK(Tests::GetNumVertices(changedChunk) == 40 * 16 * 4 - 4);
+
+    unsigned index = 0;
+    for (int y = 0; y < 40; y += 16)
+    {
+        TileMapChunk2D* chunk = layer->GetChunk(0, y);
+        Tests::GetNumVertices(chunk);
+        CHECK(chunk->GetNumRebuilds() == numRebuilds[index++] + (chunk == changedChunk ? 1 : 0));
+    }
+
+    layer->SetTileSprite(20, 20, layer->GetTile(21, 20)->GetSprite());
+    CHECK(Tests::GetNumVertices(changedChunk) == 40 * 16 * 4);
+}
+
+TEST_CASE("Tiles are drawn in row-major order across chunk boundaries")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    auto tileMap = scene->CreateChild("TileMap")->CreateComponent<TileMap2D>();
+    tileMap->SetTmxFile(Tests::CreateTileMap(context, 20, 20));
+
+    TileMapLayer2D* layer = tileMap->GetLayer(0);
+    REQUIRE(layer);
+    REQUIRE(layer->GetNumChunks() == 2);
+
+    // Collect batches of all chunks in the order they are drawn
+    ea::vector<const SourceBatch2D*> sortedBatches;
+    for (int y = 20 - 1; y >= 0; y -= 16)
+    {
+        for (const SourceBatch2D& sourceBatch : layer->GetChunk(0, y)->GetSourceBatches())
+            sortedBatches.push_back(&sourceBatch);
+    }
+    scene->GetComponent<Renderer2D>()->SortSourceBatches(sortedBatches);
+
+    ea::vector<Vector3> tileOrigins;
+    for (const SourceBatch2D* sourceBatch : sortedBatches)
+    {
+        for (unsigned i = 0; i < sourceBatch->vertices_.size(); i += 4)
+            tileOrigins.push_back(sourceBatch->vertices_[i].position_);
+    }
+    REQUIRE(tileOrigins.size() == 20 * 20);
+
+    // Tile (16, 0) is drawn before tile (15, 1), and the last tile of chunk row before the first tile of next row
+    const TileMapInfo2D& info = tileMap->GetInfo();
+    const Vector3 offset = tileOrigins[0] - info.TileIndexToPosition(0, 0).ToVector3();
+    for (int y = 0; y < 20; ++y)
+    {
+        for (int x = 0; x < 20; ++x)
+        {
+            const Vector3 expectedOrigin = info.TileIndexToPosition(x, y).ToVector3() + offset;
+            CHECK(tileOrigins[y * 20 + x].Equals(expectedOrigin));
+        }
+    }
+}
+
+TEST_CASE("Overlapping tiles of different tilesets are drawn in tile order")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    auto tileMap = scene->CreateChild("TileMap")->CreateComponent<TileMap2D>();
+    tileMap->SetTmxFile(CreateOverlappingTileMap(context));
+
+    TileMapLayer2D* layer = tileMap->GetLayer(0);
+    REQUIRE(layer);
+    TileMapChunk2D* chunk = layer->GetChunk(0, 0);
+    REQUIRE(chunk);
+
+    Texture2D* grassTexture = layer->GetTileSprite(0, 0).sprite_->GetTexture();
+    Texture2D* asterTexture = layer->GetTileSprite(1, 0).sprite_->GetTexture();
+    REQUIRE(grassTexture);
+    REQUIRE(asterTexture);
+    REQUIRE(grassTexture != asterTexture);
+
+    auto renderer = scene->GetComponent<Renderer2D>();
+    REQUIRE(renderer);
+    Material* grassMaterial = renderer->GetMaterial(grassTexture, BLEND_ALPHA);
+    Material* asterMaterial = renderer->GetMaterial(asterTexture, BLEND_ALPHA);
+
+    // Each run of tiles with the same texture is a separate batch
+    const ea::vector<SourceBatch2D>& sourceBatches = chunk->GetSourceBatches();
+    REQUIRE(sourceBatches.size() == 5);
+    const ea::vector<Material*> expectedMaterials{grassMaterial, asterMaterial, grassMaterial, asterMaterial, grassMaterial};
+    const ea::vector<unsigned> expectedNumVertices{4, 4, 4, 12, 8};
+    for (unsigned i = 0; i < sourceBatches.size(); ++i)
+    {
+        CHECK(sourceBatches[i].material_ == expectedMaterials[i]);
+        CHECK(sourceBatches[i].vertices_.size() == expectedNumVertices[i]);
+        CHECK(sourceBatches[i].subOrder_ == i);
+    }
+
+    // Sorting by material doesn't reorder batches of the chunk
+    ea::vector<const SourceBatch2D*> sortedBatches;
+    for (auto iter = sourceBatches.rbegin(); iter != sourceBatches.rend(); ++iter)
+        sortedBatches.push_back(&*iter);
+    renderer->SortSourceBatches(sortedBatches);
+    for (unsigned i = 0; i < sourceBatches.size(); ++i)
+        CHECK(sortedBatches[i] == &sourceBatches[i]);
+}
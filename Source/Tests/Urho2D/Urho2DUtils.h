@@ -0,0 +1,104 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/Material.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/Math/Random.h>
+#include <Urho3D/Urho2D/Renderer2D.h>
+#include <Urho3D/Urho2D/TileMapChunk2D.h>
+#include <Urho3D/Urho2D/TmxFile2D.h>
+
+using namespace Urho3D;
+
+namespace Tests
+{
+
+/// Reference order of source batches, same as comparison-based sort used before.
+inline bool CompareSourceBatches(const SourceBatch2D* lhs, const SourceBatch2D* rhs)
+{
+    if (lhs->drawOrder_ != rhs->drawOrder_)
+        return lhs->drawOrder_ < rhs->drawOrder_;
+
+    if (lhs->distance_ != rhs->distance_)
+        return lhs->distance_ > rhs->distance_;
+
+    return lhs->material_->GetNameHash() < rhs->material_->GetNameHash();
+}
+
+/// Create materials with distinct names.
+inline ea::vector<SharedPtr<Material>> CreateMaterials(Context* context, unsigned count)
+{
+    ea::vector<SharedPtr<Material>> materials;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        auto material = MakeShared<Material>(context);
+        material->SetName(Format("Materials/Sprite{}.xml", i));
+        materials.push_back(material);
+    }
+    return materials;
+}
+
+/// Create source batches with random draw orders, distances and materials.
+inline ea::vector<SourceBatch2D> CreateSourceBatches(
+    const ea::vector<SharedPtr<Material>>& materials, unsigned count, int maxDrawOrder, unsigned numDistances)
+{
+    ea::vector<SourceBatch2D> sourceBatches(count);
+    for (SourceBatch2D& sourceBatch : sourceBatches)
+    {
+        sourceBatch.drawOrder_ = Random(-maxDrawOrder, maxDrawOrder + 1) * 0x100000;
+        sourceBatch.distance_ = static_cast<float>(Random(static_cast<int>(numDistances))) * 0.5f - 1.0f;
+        sourceBatch.material_ = materials[Random(static_cast<int>(materials.size()))];
+    }
+    return sourceBatches;
+}
+
+/// Return pointers to source batches.
+inline ea::vector<const SourceBatch2D*> GetPointers(const ea::vector<SourceBatch2D>& sourceBatches)
+{
+    ea::vector<const SourceBatch2D*> result;
+    for (const SourceBatch2D& sourceBatch : sourceBatches)
+        result.push_back(&sourceBatch);
+    return result;
+}
+
+/// Create orthogonal tile map with one fully filled layer.
+inline SharedPtr<TmxFile2D> CreateTileMap(Context* context, int width, int height)
+{
+    ea::string data = Format("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<map version=\"1.0\" orientation=\"orthogonal\" width=\"{0}\" height=\"{1}\" tilewidth=\"64\" tileheight=\"64\">\n"
+        "<tileset firstgid=\"1\" name=\"tiles\" tilewidth=\"64\" tileheight=\"64\">\n"
+        "<image source=\"isometric_grass_and_water.png\" width=\"256\" height=\"512\"/>\n"
+        "</tileset>\n"
+        "<layer name=\"Tiles\" width=\"{0}\" height=\"{1}\">\n"
+        "<data encoding=\"csv\">\n", width, height);
+
+    for (int i = 0; i < width * height; ++i)
+    {
+        data += ea::to_string(1 + i % 24);
+        if (i + 1 < width * height)
+            data += ',';
+    }
+    data += "\n</data>\n</layer>\n</map>\n";
+
+    auto tmxFile = MakeShared<TmxFile2D>(context);
+    tmxFile->SetName("Urho2D/GeneratedTileMap.tmx");
+    MemoryBuffer buffer(data.data(), data.size());
+    REQUIRE(tmxFile->Load(buffer));
+    return tmxFile;
+}
+
+/// Return total number of vertices in the chunk.
+inline unsigned GetNumVertices(TileMapChunk2D* chunk)
+{
+    unsigned numVertices = 0;
+    for (const SourceBatch2D& sourceBatch : chunk->GetSourceBatches())
+        numVertices += sourceBatch.vertices_.size();
+    return numVertices;
+}
+
+} // namespace Tests
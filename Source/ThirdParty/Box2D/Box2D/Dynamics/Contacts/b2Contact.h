@@ -147,6 +147,7 @@ public:
 
 protected:
 	friend class b2ContactManager;
+	friend class b2ContactUpdateTask;
 	friend class b2World;
 	friend class b2ContactSolver;
 	friend class b2Body;
@@ -190,6 +191,13 @@ protected:
 
 	void Update(b2ContactListener* listener);
 
+	// Urho3D: Update is split in two parts so that manifolds may be evaluated in parallel
+	/// Evaluate the new manifold. Only writes the manifold of this contact.
+	/// @return true if the contact is touching.
+	bool UpdateManifold(b2Manifold* oldManifold);
+	/// Update flags, wake up bodies and notify the listener after UpdateManifold.
+	void FinishUpdate(b2ContactListener* listener, const b2Manifold& oldManifold, bool touching);
+
 	static b2ContactRegister s_registers[b2Shape::e_typeCount][b2Shape::e_typeCount];
 	static bool s_initialized;
 
@@ -25,6 +25,45 @@
 b2ContactFilter b2_defaultFilter;
 b2ContactListener b2_defaultListener;
 
+/// Contact visited by the parallel collide and the action deferred to the serial pass.
+struct b2ContactUpdate
+{
+	enum Action
+	{
+		/// Contact persists in the broad-phase, manifold is evaluated in parallel.
+		e_update,
+		/// Contact is filtered out or ceased to overlap in the broad-phase.
+		e_destroy,
+		/// Both bodies are asleep. The contact is revisited if a body is woken up by preceding contacts.
+		e_sleeping
+	};
+
+	b2Contact* contact;
+	b2Manifold oldManifold;
+	Action action;
+	bool touching;
+};
+
+/// Evaluate manifolds of contact range.
+class b2ContactUpdateTask : public b2ParallelTask
+{
+public:
+	explicit b2ContactUpdateTask(b2ContactUpdate* updates) : m_updates(updates) {}
+
+	void Execute(int32 begin, int32 end) override
+	{
+		for (int32 i = begin; i < end; ++i)
+		{
+			b2ContactUpdate& update = m_updates[i];
+			if (update.action == b2ContactUpdate::e_update)
+				update.touching = update.contact->UpdateManifold(&update.oldManifold);
+		}
+	}
+
+private:
+	b2ContactUpdate* m_updates;
+};
+
 b2ContactManager::b2ContactManager()
 {
 	m_contactList = nullptr;
@@ -32,6 +71,14 @@ b2ContactManager::b2ContactManager()
 	m_contactFilter = &b2_defaultFilter;
 	m_contactListener = &b2_defaultListener;
 	m_allocator = nullptr;
+	m_parallelExecutor = nullptr;
+	m_contactUpdates = nullptr;
+	m_contactUpdateCapacity = 0;
+}
+
+b2ContactManager::~b2ContactManager()
+{
+	b2Free(m_contactUpdates);
 }
 
 void b2ContactManager::Destroy(b2Contact* c)
@@ -104,6 +151,12 @@ void b2ContactManager::Destroy(b2Contact* c)
 // contact list.
 void b2ContactManager::Collide()
 {
+	if (m_parallelExecutor)
+	{
+		CollideParallel();
+		return;
+	}
+
 	// Update awake contacts.
 	b2Contact* c = m_contactList;
 	while (c)
@@ -169,6 +222,98 @@ void b2ContactManager::Collide()
 	}
 }
 
+void b2ContactManager::CollideParallel()
+{
+	if (m_contactUpdateCapacity < m_contactCount)
+	{
+		b2Free(m_contactUpdates);
+		m_contactUpdateCapacity = b2Max(m_contactCount, 2 * m_contactUpdateCapacity);
+		m_contactUpdates = (b2ContactUpdate*)b2Alloc(m_contactUpdateCapacity * sizeof(b2ContactUpdate));
+	}
+
+	// Classify contacts same way as Collide does, but defer all the changes to the serial pass.
+	int32 updateCount = 0;
+	for (b2Contact* c = m_contactList; c; c = c->GetNext())
+	{
+		b2Fixture* fixtureA = c->GetFixtureA();
+		b2Fixture* fixtureB = c->GetFixtureB();
+		int32 indexA = c->GetChildIndexA();
+		int32 indexB = c->GetChildIndexB();
+		b2Body* bodyA = fixtureA->GetBody();
+		b2Body* bodyB = fixtureB->GetBody();
+
+		b2ContactUpdate& update = m_contactUpdates[updateCount++];
+		update.contact = c;
+
+		if (c->m_flags & b2Contact::e_filterFlag)
+		{
+			if (bodyB->ShouldCollide(bodyA) == false ||
+				(m_contactFilter && m_contactFilter->ShouldCollide(fixtureA, fixtureB) == false))
+			{
+				update.action = b2ContactUpdate::e_destroy;
+				continue;
+			}
+
+			c->m_flags &= ~b2Contact::e_filterFlag;
+		}
+
+		bool activeA = bodyA->IsAwake() && bodyA->m_type != b2_staticBody;
+		bool activeB = bodyB->IsAwake() && bodyB->m_type != b2_staticBody;
+		if (activeA == false && activeB == false)
+		{
+			update.action = b2ContactUpdate::e_sleeping;
+			continue;
+		}
+
+		int32 proxyIdA = fixtureA->m_proxies[indexA].proxyId;
+		int32 proxyIdB = fixtureB->m_proxies[indexB].proxyId;
+		bool overlap = m_broadPhase.TestOverlap(proxyIdA, proxyIdB);
+		update.action = overlap ? b2ContactUpdate::e_update : b2ContactUpdate::e_destroy;
+	}
+
+	// Narrow-phase is independent for each contact.
+	b2ContactUpdateTask task(m_contactUpdates);
+	m_parallelExecutor->ParallelFor(updateCount, task);
+
+	// Flags, body wake up, destruction and listener callbacks are processed in the same order as in Collide.
+	for (int32 i = 0; i < updateCount; ++i)
+	{
+		const b2ContactUpdate& update = m_contactUpdates[i];
+		b2Contact* c = update.contact;
+		switch (update.action)
+		{
+		case b2ContactUpdate::e_update:
+			c->FinishUpdate(m_contactListener, update.oldManifold, update.touching);
+			break;
+
+		case b2ContactUpdate::e_destroy:
+			Destroy(c);
+			break;
+
+		case b2ContactUpdate::e_sleeping:
+		{
+			// Collide would process this contact if a body was woken up by one of preceding contacts.
+			b2Fixture* fixtureA = c->GetFixtureA();
+			b2Fixture* fixtureB = c->GetFixtureB();
+			b2Body* bodyA = fixtureA->GetBody();
+			b2Body* bodyB = fixtureB->GetBody();
+			bool activeA = bodyA->IsAwake() && bodyA->m_type != b2_staticBody;
+			bool activeB = bodyB->IsAwake() && bodyB->m_type != b2_staticBody;
+			if (activeA == false && activeB == false)
+				break;
+
+			int32 proxyIdA = fixtureA->m_proxies[c->GetChildIndexA()].proxyId;
+			int32 proxyIdB = fixtureB->m_proxies[c->GetChildIndexB()].proxyId;
+			if (m_broadPhase.TestOverlap(proxyIdA, proxyIdB) == false)
+				Destroy(c);
+			else
+				c->Update(m_contactListener);
+			break;
+		}
+		}
+	}
+}
+
 void b2ContactManager::FindNewContacts()
 {
 	m_broadPhase.UpdatePairs(this);
@@ -26,12 +26,15 @@ class b2Contact;
 class b2ContactFilter;
 class b2ContactListener;
 class b2BlockAllocator;
+class b2ParallelExecutor;
+struct b2ContactUpdate;
 
 // Delegate of b2World.
 class BOX2D_API b2ContactManager
 {
 public:
 	b2ContactManager();
+	~b2ContactManager();
 
 	// Broad-phase callback.
 	void AddPair(void* proxyUserDataA, void* proxyUserDataB);
@@ -48,6 +51,14 @@ public:
 	b2ContactFilter* m_contactFilter;
 	b2ContactListener* m_contactListener;
 	b2BlockAllocator* m_allocator;
+
+	// Urho3D: contact manifolds are evaluated in parallel if executor is set
+	b2ParallelExecutor* m_parallelExecutor;
+	b2ContactUpdate* m_contactUpdates;
+	int32 m_contactUpdateCapacity;
+
+private:
+	void CollideParallel();
 };
 
 #endif
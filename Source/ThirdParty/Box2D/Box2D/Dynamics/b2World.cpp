@@ -99,6 +99,11 @@ void b2World::SetContactListener(b2ContactListener* listener)
 	m_contactManager.m_contactListener = listener;
 }
 
+void b2World::SetParallelExecutor(b2ParallelExecutor* executor)
+{
+	m_contactManager.m_parallelExecutor = executor;
+}
+
 void b2World::SetDebugDraw(b2Draw* debugDraw)
 {
 	m_debugDraw = debugDraw;
@@ -62,6 +62,12 @@ public:
 	/// remain in scope.
 	void SetContactListener(b2ContactListener* listener);
 
+	// Urho3D: added parallel contact update
+	/// Register an executor used to evaluate contact manifolds on multiple threads.
+	/// Listener callbacks are still called from the stepping thread.
+	/// The executor is owned by you and must remain in scope. Pass nullptr to disable.
+	void SetParallelExecutor(b2ParallelExecutor* executor);
+
 	/// Register a routine for debug drawing. The debug draw functions are called
 	/// inside with b2World::DrawDebugData method. The debug draw object is owned
 	/// by you and must remain in scope.
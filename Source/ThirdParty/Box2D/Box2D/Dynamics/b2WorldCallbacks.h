@@ -153,4 +153,28 @@ public:
 									const b2Vec2& normal, float32 fraction) = 0;
 };
 
+// Urho3D: added interface to run independent parts of the world step in parallel
+/// Range of independent work items.
+/// See b2ParallelExecutor
+class BOX2D_API b2ParallelTask
+{
+public:
+	virtual ~b2ParallelTask() {}
+
+	/// Process items in range [begin, end). May be called from any thread.
+	virtual void Execute(int32 begin, int32 end) = 0;
+};
+
+/// Implement this class to process independent work items of the world step
+/// on multiple threads. See b2World::SetParallelExecutor
+class BOX2D_API b2ParallelExecutor
+{
+public:
+	virtual ~b2ParallelExecutor() {}
+
+	/// Call task.Execute for non-overlapping ranges covering [0, count).
+	/// Must not return until all the ranges are processed.
+	virtual void ParallelFor(int32 count, b2ParallelTask& task) = 0;
+};
+
 #endif
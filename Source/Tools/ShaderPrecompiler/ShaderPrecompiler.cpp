@@ -0,0 +1,203 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Core/StringUtils.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/Engine/Engine.h>
+#include <Urho3D/Engine/EngineDefs.h>
+#include <Urho3D/Graphics/Shader.h>
+#include <Urho3D/Graphics/ShaderVariation.h>
+#include <Urho3D/Graphics/ShaderVariationManifest.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/RenderAPI/RenderAPIUtils.h>
+#include <Urho3D/Resource/ResourceCache.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+namespace
+{
+
+struct PrecompilerTask
+{
+    ea::string outputName_;
+    ShaderCompilationJob job_;
+    ShaderCompilationResult result_;
+};
+
+ea::optional<RenderBackend> ParseRenderBackend(const ea::string& name)
+{
+    for (unsigned i = 0; i < static_cast<unsigned>(RenderBackend::Count); ++i)
+    {
+        const auto backend = static_cast<RenderBackend>(i);
+        // Null backend doesn't consume shaders
+        if (backend != RenderBackend::Null && ToString(backend).comparei(name) == 0)
+            return backend;
+    }
+    return ea::nullopt;
+}
+
+} // namespace
+
+int main(int argc, char** argv);
+void Run(const ea::vector<ea::string>& arguments);
+
+int main(int argc, char** argv)
+{
+    ea::vector<ea::string> arguments;
+
+    #ifdef WIN32
+    arguments = ParseArguments(GetCommandLineW());
+    #else
+    arguments = ParseArguments(argc, argv);
+    #endif
+
+    Run(arguments);
+    return 0;
+}
+
+void Run(const ea::vector<ea::string>& arguments)
+{
+    if (arguments.size() < 2)
+    {
+        ErrorExit(
+            "Usage: ShaderPrecompiler <manifest file> <output directory> [options]\n"
+            "\n"
+            "Options:\n"
+            "-backend <name>   Render backend to compile for: D3D11, D3D12, OpenGL or Vulkan. May be repeated.\n"
+            "                  All backends are compiled if not specified.\n"
+            "-resources <list> Semicolon-separated resource directories, default is \"CoreData;Data\".\n"
+            "-prefix <list>    Semicolon-separated resource prefix paths, default is the current directory.\n"
+            "\n"
+            "Manifest file is recorded by the application launched with --shader-manifest option.\n"
+            "Compiled bytecode is written in the layout expected by the shader cache directory.\n"
+        );
+    }
+
+    const ea::string manifestFileName = arguments[0];
+    const ea::string outputDir = AddTrailingSlash(arguments[1]);
+
+    ea::vector<RenderBackend> backends;
+    ea::string resourcePaths = "CoreData;Data";
+    ea::string resourcePrefixPaths;
+
+    for (unsigned i = 2; i < arguments.size(); ++i)
+    {
+        const ea::string& option = arguments[i];
+        const bool hasValue = i + 1 < arguments.size();
+        if (option == "-backend" && hasValue)
+        {
+            const ea::string& backendName = arguments[++i];
+            const auto backend = ParseRenderBackend(backendName);
+            if (!backend)
+                ErrorExit(Format("Unknown render backend '{}'", backendName));
+            backends.push_back(*backend);
+        }
+        else if (option == "-resources" && hasValue)
+            resourcePaths = arguments[++i];
+        else if (option == "-prefix" && hasValue)
+            resourcePrefixPaths = arguments[++i];
+        else
+            ErrorExit(Format("Unknown option '{}'", option));
+    }
+
+    if (backends.empty())
+    {
+        for (unsigned i = 0; i < static_cast<unsigned>(RenderBackend::Count); ++i)
+        {
+            const auto backend = static_cast<RenderBackend>(i);
+            if (backend != RenderBackend::Null)
+                backends.push_back(backend);
+        }
+    }
+
+    auto context = MakeShared<Context>();
+    auto engine = MakeShared<Engine>(context);
+
+    StringVariantMap parameters;
+    parameters[EP_HEADLESS] = true;
+    parameters[EP_RESOURCE_PATHS] = resourcePaths;
+    if (!resourcePrefixPaths.empty())
+        parameters[EP_RESOURCE_PREFIX_PATHS] = resourcePrefixPaths;
+    if (!engine->Initialize(parameters, {}))
+        ErrorExit("Failed to initialize engine");
+
+    auto fs = context->GetSubsystem<FileSystem>();
+    auto cache = context->GetSubsystem<ResourceCache>();
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+
+    auto manifest = MakeShared<ShaderVariationManifest>(context);
+    {
+        File file(context, manifestFileName);
+        if (!file.IsOpen() || !manifest->Load(file))
+            ErrorExit(Format("Failed to load shader manifest '{}'", manifestFileName));
+    }
+
+    ea::vector<PrecompilerTask> tasks;
+    for (const ShaderVariationManifestEntry& entry : manifest->GetVariations())
+    {
+        auto shader = cache->GetResource<Shader>(entry.shaderName_);
+        if (!shader)
+        {
+            PrintLine(Format("Skipping missing shader '{}'", entry.shaderName_), true);
+            continue;
+        }
+
+        for (RenderBackend backend : backends)
+        {
+            const ShaderTranslationPolicy policy = SelectShaderTranslationPolicy(backend, ea::nullopt);
+
+            PrecompilerTask& task = tasks.emplace_back();
+            task.outputName_ = outputDir
+                + ShaderVariation::GetCachedVariationName(
+                    shader->GetShaderName(), entry.type_, entry.defines_, backend, "bytecode");
+            task.job_ = ShaderVariation::PrepareCompilationJob(shader, entry.type_, entry.defines_, backend, policy);
+        }
+    }
+
+    PrintLine(Format("Compiling {} shader variations for {} backend(s)...", tasks.size(), backends.size()));
+
+    ForEachParallel(workQueue, tasks, [](unsigned /*index*/, PrecompilerTask& task)
+    {
+        ShaderVariation::CompileJob(task.job_, task.result_);
+    });
+
+    unsigned numCompiled = 0;
+    unsigned numFailed = 0;
+    for (const PrecompilerTask& task : tasks)
+    {
+        if (!task.result_.success_)
+        {
+            PrintLine(Format("Failed to compile '{}'", task.job_.variationName_), true);
+            ++numFailed;
+            continue;
+        }
+
+        fs->CreateDirsRecursive(GetPath(task.outputName_));
+
+        File file(context, task.outputName_, FILE_WRITE);
+        if (!file.IsOpen() || !task.result_.bytecode_.SaveToFile(file))
+        {
+            PrintLine(Format("Failed to write '{}'", task.outputName_), true);
+            ++numFailed;
+            continue;
+        }
+
+        ++numCompiled;
+    }
+
+    PrintLine(Format("Compiled {} shader variations, {} failed", numCompiled, numFailed));
+
+    engine->Exit();
+    if (numFailed > 0)
+        ErrorExit();
+}
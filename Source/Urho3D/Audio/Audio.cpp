@@ -27,14 +27,23 @@
 #include "../Audio/Sound.h"
 #include "../Audio/SoundListener.h"
 #include "../Audio/SoundSource3D.h"
+#include "../Audio/SoundStreamDecoder.h"
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
 #include "../Core/ProcessUtils.h"
 #include "../Core/Profiler.h"
+#include "../Core/Timer.h"
+#include "../IO/File.h"
 #include "../IO/Log.h"
 
+#include <EASTL/sort.h>
+
 #include <SDL.h>
 
+#ifdef URHO3D_SSE
+    #include <emmintrin.h>
+#endif
+
 #include "../DebugNew.h"
 
 #ifdef _MSC_VER
@@ -51,13 +60,24 @@ static const StringHash SOUND_MASTER_HASH("Master");
 
 static void SDLAudioCallback(void* userdata, Uint8* stream, int len);
 
-static const int AUDIO_NUM_CHANNELS[] = {
-    6, // Auto, just aim for 5.1
-    1, // mono
-    2, // stereo
-    4, // quadrophonic
-    6, // 5.1
-};
+/// Convert mixed samples to 16-bit output with clipping.
+static void ConvertMixedSamples(short dest[], const float src[], unsigned count)
+{
+    unsigned i = 0;
+#ifdef URHO3D_SSE
+    const __m128 minValue = _mm_set1_ps(-32768.0f);
+    const __m128 maxValue = _mm_set1_ps(32767.0f);
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128 lo = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), minValue), maxValue);
+        const __m128 hi = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4), minValue), maxValue);
+        const __m128i packed = _mm_packs_epi32(_mm_cvttps_epi32(lo), _mm_cvttps_epi32(hi));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), packed);
+    }
+#endif
+    for (; i < count; ++i)
+        dest[i] = (short)Clamp(src[i], -32768.0f, 32767.0f);
+}
 
 // SM_AUTO is BAD!
 static const SpeakerMode CHANNELS_TO_MODE[] = {
@@ -88,6 +108,31 @@ static const char* SPEAKER_MODE_NAMES[] = {
     "5.1 Surround",
 };
 
+void AudioMixStatistics::AddMix(unsigned samples, long long mixTimeUSec, unsigned numRealVoices, unsigned numVirtualVoices)
+{
+    ++numMixes_;
+    numSamples_ += samples;
+    mixTimeUSec_ += mixTimeUSec;
+    maxMixTimeUSec_ = Max(maxMixTimeUSec_, mixTimeUSec);
+    maxRealVoices_ = Max(maxRealVoices_, numRealVoices);
+    maxVirtualVoices_ = Max(maxVirtualVoices_, numVirtualVoices);
+}
+
+void AudioMixStatistics::Merge(const AudioMixStatistics& other)
+{
+    numMixes_ += other.numMixes_;
+    numSamples_ += other.numSamples_;
+    mixTimeUSec_ += other.mixTimeUSec_;
+    maxMixTimeUSec_ = Max(maxMixTimeUSec_, other.maxMixTimeUSec_);
+    maxRealVoices_ = Max(maxRealVoices_, other.maxRealVoices_);
+    maxVirtualVoices_ = Max(maxVirtualVoices_, other.maxVirtualVoices_);
+}
+
+double AudioMixStatistics::GetMixTimePerSecond(int mixRate) const
+{
+    return numSamples_ != 0 ? static_cast<double>(mixTimeUSec_) * mixRate / numSamples_ : 0.0;
+}
+
 Audio::Audio(Context* context) :
     Object(context)
 {
@@ -105,6 +150,7 @@ Audio::Audio(Context* context) :
 Audio::~Audio()
 {
     Release();
+    streamDecoder_.Reset();
     context_->ReleaseSDL();
 }
 
@@ -201,7 +247,7 @@ bool Audio::SetMode(int bufferLengthMSec, int mixRate, SpeakerMode speakerMode,
     fragmentSize_ = Min(NextPowerOfTwo((unsigned)mixRate >> 6u), (unsigned)obtained.samples);
     mixRate_ = obtained.freq;
     interpolation_ = interpolation;
-    clipBuffer_.reset(new int[fragmentSize_ * AUDIO_NUM_CHANNELS[speakerMode_]]);
+    mixBuffer_.reset(new float[fragmentSize_ * AUDIO_NUM_CHANNELS[speakerMode_]]);
 
     URHO3D_LOGINFO("Set audio mode " + ea::to_string(mixRate_) + " Hz " + SPEAKER_MODE_NAMES[speakerMode_] + " " +
             (interpolation_ ? "interpolated" : ""));
@@ -209,8 +255,96 @@ bool Audio::SetMode(int bufferLengthMSec, int mixRate, SpeakerMode speakerMode,
     return Play();
 }
 
+bool Audio::SetOfflineMode(int mixRate, SpeakerMode speakerMode, bool interpolation)
+{
+    Release();
+
+    // There is no device to negotiate channels with
+    if (speakerMode == SPK_AUTO)
+        speakerMode = SPK_STEREO;
+
+    offline_ = true;
+    speakerMode_ = speakerMode;
+    sampleSize_ = sizeof(short) * AUDIO_NUM_CHANNELS[speakerMode_];
+    mixRate_ = Clamp(mixRate, MIN_MIXRATE, MAX_MIXRATE);
+    fragmentSize_ = NextPowerOfTwo((unsigned)mixRate_ >> 6u);
+    bufferLengthMSec_ = 0;
+    interpolation_ = interpolation;
+    mixBuffer_.reset(new float[fragmentSize_ * AUDIO_NUM_CHANNELS[speakerMode_]]);
+    offlineSampleRemainder_ = 0.0;
+
+    URHO3D_LOGINFO("Set offline audio mode " + ea::to_string(mixRate_) + " Hz " + SPEAKER_MODE_NAMES[speakerMode_] + " " +
+            (interpolation_ ? "interpolated" : ""));
+
+    return Play();
+}
+
+void Audio::RenderOffline(unsigned samples)
+{
+    if (!offline_ || !samples)
+        return;
+
+    MutexLock lock(audioMutex_);
+
+    // Without recording keep only the last mixed samples
+    const unsigned offset = offlineRecording_ ? offlineOutput_.size() : 0;
+    offlineOutput_.resize(offset + samples * AUDIO_NUM_CHANNELS[speakerMode_]);
+    MixOutput(offlineOutput_.data() + offset, samples);
+}
+
+void Audio::SetOfflineRecording(bool enable)
+{
+    MutexLock lock(audioMutex_);
+    if (offlineRecording_ != enable)
+    {
+        offlineRecording_ = enable;
+        offlineOutput_.clear();
+    }
+}
+
+void Audio::ClearOfflineOutput()
+{
+    MutexLock lock(audioMutex_);
+    offlineOutput_.clear();
+}
+
+bool Audio::SaveOfflineOutput(const ea::string& fileName) const
+{
+    File file(context_, fileName, FILE_WRITE);
+    if (!file.IsOpen())
+        return false;
+
+    const unsigned numChannels = AUDIO_NUM_CHANNELS[speakerMode_];
+    const unsigned dataLength = offlineOutput_.size() * sizeof(short);
+
+    file.WriteFileID("RIFF");
+    file.WriteUInt(36 + dataLength);
+    file.WriteFileID("WAVE");
+    file.WriteFileID("fmt ");
+    file.WriteUInt(16);
+    file.WriteUShort(1);
+    file.WriteUShort(numChannels);
+    file.WriteUInt(mixRate_);
+    file.WriteUInt(mixRate_ * numChannels * sizeof(short));
+    file.WriteUShort(numChannels * sizeof(short));
+    file.WriteUShort(16);
+    file.WriteFileID("data");
+    file.WriteUInt(dataLength);
+    return file.Write(offlineOutput_.data(), dataLength) == dataLength;
+}
+
+void Audio::ResetMixStatistics()
+{
+    MutexLock lock(audioMutex_);
+    currentMixStatistics_ = {};
+    frameMixStatistics_ = {};
+    totalMixStatistics_ = {};
+}
+
 bool Audio::RefreshMode()
 {
+    if (offline_)
+        return SetOfflineMode(mixRate_, speakerMode_, interpolation_);
     return SetMode(bufferLengthMSec_, mixRate_, speakerMode_, interpolation_);
 }
 
@@ -221,11 +355,26 @@ void Audio::Close()
 
 void Audio::Update(float timeStep)
 {
+    {
+        MutexLock lock(audioMutex_);
+        frameMixStatistics_ = currentMixStatistics_;
+        totalMixStatistics_.Merge(currentMixStatistics_);
+        currentMixStatistics_ = {};
+    }
+
     if (!playing_)
         return;
 
     UpdateInternal(timeStep);
 
+    if (offline_)
+    {
+        offlineSampleRemainder_ += static_cast<double>(timeStep) * mixRate_;
+        const auto samples = static_cast<unsigned>(offlineSampleRemainder_);
+        offlineSampleRemainder_ -= samples;
+        RenderOffline(samples);
+    }
+
     for (int i = 0; i < microphones_.size(); ++i)
     {
         if (auto mic = microphones_[i].Lock())
@@ -245,13 +394,14 @@ bool Audio::Play()
     if (playing_)
         return true;
 
-    if (!deviceID_)
+    if (!deviceID_ && !offline_)
     {
         URHO3D_LOGERROR("No audio mode set, can not start playback");
         return false;
     }
 
-    SDL_PauseAudioDevice(deviceID_, 0);
+    if (deviceID_)
+        SDL_PauseAudioDevice(deviceID_, 0);
 
     // Update sound sources before resuming playback to make sure 3D positions are up to date
     UpdateInternal(0.0f);
@@ -309,6 +459,12 @@ void Audio::StopSound(Sound* sound)
     }
 }
 
+void Audio::SetMaxRealVoices(unsigned maxRealVoices)
+{
+    MutexLock lock(audioMutex_);
+    maxRealVoices_ = maxRealVoices;
+}
+
 float Audio::GetMasterGain(const ea::string& type) const
 {
     // By definition previously unknown types return full volume
@@ -345,6 +501,24 @@ void Audio::RemoveSoundSource(SoundSource* soundSource)
     }
 }
 
+SharedPtr<SoundStream> Audio::CreateDecodeAheadStream(SoundStream* stream)
+{
+#ifdef URHO3D_THREADING
+    if (!stream || !decodeAheadLengthMSec_ || !stream->IsDecodeAheadSupported())
+        return SharedPtr<SoundStream>(stream);
+
+    const unsigned bufferSize = stream->GetSampleSize() * stream->GetIntFrequency() * decodeAheadLengthMSec_ / 1000;
+    auto decodeAheadStream = MakeShared<DecodeAheadSoundStream>(stream, bufferSize);
+
+    if (!streamDecoder_)
+        streamDecoder_ = MakeShared<SoundStreamDecoder>();
+    streamDecoder_->AddStream(decodeAheadStream);
+    return decodeAheadStream;
+#else
+    return SharedPtr<SoundStream>(stream);
+#endif
+}
+
 float Audio::GetSoundSourceMasterGain(StringHash typeHash) const
 {
     auto masterIt = masterGain_.find(SOUND_MASTER_HASH);
@@ -371,44 +545,78 @@ void SDLAudioCallback(void* userdata, Uint8* stream, int len)
 
 void Audio::MixOutput(void* dest, unsigned samples)
 {
-    if (!playing_ || !clipBuffer_)
+    if (!playing_ || !mixBuffer_)
     {
         memset(dest, 0, samples * (size_t)sampleSize_);
         return;
     }
 
+    HiresTimer mixTimer;
+    const unsigned numChannels = AUDIO_NUM_CHANNELS[speakerMode_];
+    const unsigned totalSamples = samples;
+    unsigned maxRealVoices = 0;
+    unsigned maxVirtualVoices = 0;
     while (samples)
     {
-        // If sample count exceeds the fragment (clip buffer) size, split the work
-        unsigned workSamples = Min(samples, fragmentSize_);
-        unsigned clipSamples = workSamples;
-        if (speakerMode_ != SPK_MONO)
-            clipSamples = AUDIO_NUM_CHANNELS[speakerMode_] * fragmentSize_;
-
-        // Clear clip buffer
-        int* clipPtr = clipBuffer_.get();
-        memset(clipPtr, 0, clipSamples * sizeof(int));
-
-        // Mix samples to clip buffer
-        for (auto i = soundSources_.begin(); i != soundSources_.end(); ++i)
-        {
-            SoundSource* source = *i;
+        // If sample count exceeds the fragment (mix buffer) size, split the work
+        const unsigned workSamples = Min(samples, fragmentSize_);
+        MixSoundSources(mixBuffer_.get(), workSamples, mixRate_, speakerMode_, interpolation_);
+        maxRealVoices = Max(maxRealVoices, numRealVoices_);
+        maxVirtualVoices = Max(maxVirtualVoices, numVirtualVoices_);
+
+        // Copy output from mix buffer to destination
+        ConvertMixedSamples(static_cast<short*>(dest), mixBuffer_.get(), workSamples * numChannels);
+        samples -= workSamples;
+        ((unsigned char*&)dest) += sampleSize_ * workSamples;
+    }
 
-            // Check for pause if necessary
-            if (!pausedSoundTypes_.empty())
-            {
-                if (pausedSoundTypes_.contains(source->GetSoundType()))
-                    continue;
-            }
+    currentMixStatistics_.AddMix(totalSamples, mixTimer.GetUSec(false), maxRealVoices, maxVirtualVoices);
+}
 
-            source->Mix(clipPtr, workSamples, mixRate_, speakerMode_, interpolation_);
+void Audio::MixSoundSources(float dest[], unsigned samples, int mixRate, SpeakerMode speakerMode, bool interpolation)
+{
+    memset(dest, 0, samples * AUDIO_NUM_CHANNELS[speakerMode] * sizeof(float));
+
+    playingSoundSources_.clear();
+    for (SoundSource* source : soundSources_)
+    {
+        // Disabled and paused sources produce no output and should not take real voices
+        if (!source->IsPlayingEffective())
+            continue;
+
+        // Check for pause if necessary
+        if (!pausedSoundTypes_.empty())
+        {
+            if (pausedSoundTypes_.contains(source->GetSoundType()))
+                continue;
         }
-        // Copy output from clip buffer to destination
-        auto* destPtr = (short*)dest;
-        while (clipSamples--)
-            *destPtr++ = (short)Clamp(*clipPtr++, -32768, 32767);
-        samples -= workSamples;
-        ((unsigned char*&)dest) += sampleSize_ * workSamples;
+
+        playingSoundSources_.push_back(source);
+    }
+
+    // If there are too many sound sources, mix only the most important ones
+    const unsigned numPlayingSoundSources = playingSoundSources_.size();
+    numRealVoices_ = maxRealVoices_ != 0 ? Min(maxRealVoices_, numPlayingSoundSources) : numPlayingSoundSources;
+    numVirtualVoices_ = numPlayingSoundSources - numRealVoices_;
+    if (numVirtualVoices_ > 0)
+    {
+        const auto isMoreImportant = [](const SoundSource* lhs, const SoundSource* rhs)
+        {
+            if (lhs->GetPriority() != rhs->GetPriority())
+                return lhs->GetPriority() > rhs->GetPriority();
+            if (lhs->GetAudibility() != rhs->GetAudibility())
+                return lhs->GetAudibility() > rhs->GetAudibility();
+            return lhs < rhs;
+        };
+        ea::nth_element(playingSoundSources_.begin(), playingSoundSources_.begin() + numRealVoices_,
+            playingSoundSources_.end(), isMoreImportant);
+    }
+
+    // Virtual voices only advance playback position
+    for (unsigned i = 0; i < numPlayingSoundSources; ++i)
+    {
+        float* voiceDest = i < numRealVoices_ ? dest : nullptr;
+        playingSoundSources_[i]->Mix(voiceDest, samples, mixRate, speakerMode, interpolation);
     }
 }
 
@@ -427,7 +635,13 @@ void Audio::Release()
     {
         SDL_CloseAudioDevice(deviceID_);
         deviceID_ = 0;
-        clipBuffer_.reset();
+        mixBuffer_.reset();
+    }
+
+    if (offline_)
+    {
+        offline_ = false;
+        mixBuffer_.reset();
     }
 }
 
@@ -37,6 +37,32 @@ class Microphone;
 class Sound;
 class SoundListener;
 class SoundSource;
+class SoundStream;
+class SoundStreamDecoder;
+
+/// Statistics of audio mixing.
+struct URHO3D_API AudioMixStatistics
+{
+    /// Number of mixing calls.
+    unsigned numMixes_{};
+    /// Number of mixed samples.
+    unsigned long long numSamples_{};
+    /// Total mixing time in microseconds.
+    long long mixTimeUSec_{};
+    /// Max time of single mixing call in microseconds.
+    long long maxMixTimeUSec_{};
+    /// Max number of sound sources mixed at once.
+    unsigned maxRealVoices_{};
+    /// Max number of virtualized sound sources.
+    unsigned maxVirtualVoices_{};
+
+    /// Accumulate single mixing call.
+    void AddMix(unsigned samples, long long mixTimeUSec, unsigned numRealVoices, unsigned numVirtualVoices);
+    /// Accumulate other statistics.
+    void Merge(const AudioMixStatistics& other);
+    /// Return average mixing time per second of mixed audio in microseconds.
+    double GetMixTimePerSecond(int mixRate) const;
+};
 
 /// %Audio subsystem.
 class URHO3D_API Audio : public Object
@@ -51,6 +77,19 @@ public:
 
     /// Initialize sound output with specified buffer length and output mode.
     bool SetMode(int bufferLengthMSec, int mixRate, SpeakerMode mode, bool interpolation = true);
+    /// Initialize offline sound output without audio device. Sound is mixed on Update according to time step,
+    /// so it runs as fast as the engine clock does. Use RenderOffline to mix regardless of time step.
+    bool SetOfflineMode(int mixRate, SpeakerMode mode, bool interpolation = true);
+    /// Mix specified number of samples of offline output immediately.
+    void RenderOffline(unsigned samples);
+    /// Set whether to keep all offline output in memory. Otherwise only the last mixed samples are kept.
+    void SetOfflineRecording(bool enable);
+    /// Clear offline output kept in memory.
+    void ClearOfflineOutput();
+    /// Save offline output kept in memory to WAV file.
+    bool SaveOfflineOutput(const ea::string& fileName) const;
+    /// Reset mixing statistics.
+    void ResetMixStatistics();
     /// Re-initialize sound output with same parameters.
     bool RefreshMode();
     /// Shutdown this audio device, likely because we've lost it.
@@ -75,6 +114,18 @@ public:
     void SetListener(SoundListener* listener);
     /// Stop any sound source playing a certain sound clip.
     void StopSound(Sound* sound);
+    /// Set max number of sound sources mixed at once. Other playing sound sources are virtualized:
+    /// they keep advancing playback position without producing output. 0 means unlimited.
+    /// @property
+    void SetMaxRealVoices(unsigned maxRealVoices);
+    /// Set length of data decoded ahead of playback on worker thread for compressed sound streams. 0 disables decode-ahead.
+    /// Applies to streams started after the change.
+    /// @property
+    void SetDecodeAheadLength(unsigned lengthMSec) { decodeAheadLengthMSec_ = lengthMSec; }
+    /// Set max length of compressed sounds in seconds that are decoded into memory at load instead of streaming.
+    /// 0 disables decoding at load. Applies to sounds loaded after the change.
+    /// @property
+    void SetMaxPredecodedSoundLength(float length) { maxPredecodedSoundLength_ = Max(length, 0.0f); }
 
     /// Return byte size of one sample.
     /// @property
@@ -88,6 +139,24 @@ public:
     /// @property
     unsigned GetBufferLengthMS() const { return bufferLengthMSec_; }
 
+    /// Return max number of sound sources mixed at once.
+    /// @property
+    unsigned GetMaxRealVoices() const { return maxRealVoices_; }
+
+    /// Return length of data decoded ahead of playback for compressed sound streams.
+    /// @property
+    unsigned GetDecodeAheadLength() const { return decodeAheadLengthMSec_; }
+
+    /// Return max length of compressed sounds decoded at load.
+    /// @property
+    float GetMaxPredecodedSoundLength() const { return maxPredecodedSoundLength_; }
+
+    /// Return number of sound sources that produced output during last mix.
+    unsigned GetNumRealVoices() const { return numRealVoices_; }
+
+    /// Return number of sound sources virtualized during last mix.
+    unsigned GetNumVirtualVoices() const { return numVirtualVoices_; }
+
     /// Return whether output is interpolated.
     /// @property
     bool GetInterpolation() const { return interpolation_; }
@@ -102,7 +171,22 @@ public:
 
     /// Return whether an audio stream has been reserved.
     /// @property
-    bool IsInitialized() const { return deviceID_ != 0; }
+    bool IsInitialized() const { return deviceID_ != 0 || offline_; }
+
+    /// Return whether sound is mixed offline without audio device.
+    bool IsOffline() const { return offline_; }
+
+    /// Return whether all offline output is kept in memory.
+    bool IsOfflineRecording() const { return offlineRecording_; }
+
+    /// Return offline output kept in memory as interleaved 16-bit samples.
+    const ea::vector<short>& GetOfflineOutput() const { return offlineOutput_; }
+
+    /// Return mixing statistics of last frame.
+    const AudioMixStatistics& GetFrameMixStatistics() const { return frameMixStatistics_; }
+
+    /// Return mixing statistics accumulated since last reset.
+    const AudioMixStatistics& GetTotalMixStatistics() const { return totalMixStatistics_; }
 
     /// Return master gain for a specific sound source type. Unknown sound types will return full gain (1).
     /// @property
@@ -129,11 +213,17 @@ public:
     /// Return audio thread mutex.
     Mutex& GetMutex() { return audioMutex_; }
 
+    /// Return stream wrapped for decoding ahead of playback if enabled and supported by the stream, otherwise the stream itself. Called by SoundSource.
+    SharedPtr<SoundStream> CreateDecodeAheadStream(SoundStream* stream);
+
     /// Return sound type specific gain multiplied by master gain.
     float GetSoundSourceMasterGain(StringHash typeHash) const;
 
     /// Mix sound sources into the buffer.
     void MixOutput(void* dest, unsigned samples);
+    /// Mix sound sources into floating point buffer in 16-bit sample range. Buffer contents are overwritten.
+    /// Doesn't depend on audio output and may be used for offline mixing. Audio mutex should be locked if output is active.
+    void MixSoundSources(float dest[], unsigned samples, int mixRate, SpeakerMode speakerMode, bool interpolation);
 
     /// Returns a pretty-name list of all attached microphones.
     StringVector EnumerateMicrophones() const;
@@ -150,8 +240,8 @@ private:
     /// Actually update sound sources with the specific timestep. Called internally.
     void UpdateInternal(float timeStep);
 
-    /// Clipping buffer for mixing.
-    ea::unique_ptr<int[]> clipBuffer_;
+    /// Floating point buffer for mixing.
+    ea::unique_ptr<float[]> mixBuffer_;
     /// Audio thread mutex.
     Mutex audioMutex_;
     /// SDL audio device ID.
@@ -170,12 +260,40 @@ private:
     SpeakerMode speakerMode_{SpeakerMode::SPK_AUTO};
     /// Playing flag.
     bool playing_{};
+    /// Offline output flag.
+    bool offline_{};
+    /// Whether to keep all offline output in memory.
+    bool offlineRecording_{};
+    /// Offline output.
+    ea::vector<short> offlineOutput_;
+    /// Fractional number of samples not mixed yet in offline mode.
+    double offlineSampleRemainder_{};
+    /// Mixing statistics of current frame. Updated from audio thread.
+    AudioMixStatistics currentMixStatistics_;
+    /// Mixing statistics of last frame.
+    AudioMixStatistics frameMixStatistics_;
+    /// Mixing statistics since last reset.
+    AudioMixStatistics totalMixStatistics_;
     /// Master gain by sound source type.
     ea::unordered_map<StringHash, Variant> masterGain_;
     /// Paused sound types.
     ea::hash_set<StringHash> pausedSoundTypes_;
     /// Sound sources.
     ea::vector<SoundSource*> soundSources_;
+    /// Sound sources playing during current mix.
+    ea::vector<SoundSource*> playingSoundSources_;
+    /// Max number of sound sources mixed at once.
+    unsigned maxRealVoices_{};
+    /// Number of sound sources that produced output during last mix.
+    unsigned numRealVoices_{};
+    /// Number of sound sources virtualized during last mix.
+    unsigned numVirtualVoices_{};
+    /// Length of data decoded ahead of playback.
+    unsigned decodeAheadLengthMSec_{200};
+    /// Max length of compressed sounds decoded at load.
+    float maxPredecodedSoundLength_{};
+    /// Decoder of sound streams. Created on demand.
+    SharedPtr<SoundStreamDecoder> streamDecoder_;
     /// Sound listener.
     WeakPtr<SoundListener> listener_;
     /// List of microphones being tracked.
@@ -0,0 +1,142 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../Precompiled.h"
+
+#include "../Audio/DecodeAheadSoundStream.h"
+#include "../Math/MathDefs.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+DecodeAheadSoundStream::DecodeAheadSoundStream(SoundStream* stream, unsigned bufferSize)
+    : stream_(stream)
+{
+    assert(stream);
+
+    SetFormat(stream->GetIntFrequency(), stream->IsSixteenBit(), stream->IsStereo());
+    SetStopAtEnd(stream->GetStopAtEnd());
+
+    // Keep whole samples in the buffer
+    const unsigned sampleSize = GetSampleSize();
+    buffer_.resize(Max(bufferSize / sampleSize, 1u) * sampleSize);
+}
+
+DecodeAheadSoundStream::~DecodeAheadSoundStream() = default;
+
+bool DecodeAheadSoundStream::Seek(unsigned sample_number)
+{
+    MutexLock decoderLock(decoderMutex_);
+    if (!stream_->Seek(sample_number))
+        return false;
+
+    MutexLock bufferLock(bufferMutex_);
+    readPosition_ = 0;
+    numBufferedBytes_ = 0;
+    endOfStream_ = false;
+    return true;
+}
+
+unsigned DecodeAheadSoundStream::GetData(signed char* dest, unsigned numBytes)
+{
+    unsigned outBytes = 0;
+    {
+        MutexLock bufferLock(bufferMutex_);
+        outBytes = ReadBuffer(dest, numBytes);
+        if (outBytes == numBytes || endOfStream_)
+            return outBytes;
+    }
+
+    // Decode the rest in place. Check the ring buffer again because the decoder may have filled it meanwhile
+    MutexLock decoderLock(decoderMutex_);
+    {
+        MutexLock bufferLock(bufferMutex_);
+        outBytes += ReadBuffer(dest + outBytes, numBytes - outBytes);
+        if (outBytes == numBytes || endOfStream_)
+            return outBytes;
+    }
+
+    const unsigned underrunBytes = numBytes - outBytes;
+    const unsigned decodedBytes = stream_->GetData(dest + outBytes, underrunBytes);
+    numUnderrunBytes_ += decodedBytes;
+    if (decodedBytes < underrunBytes)
+    {
+        MutexLock bufferLock(bufferMutex_);
+        endOfStream_ = true;
+    }
+    return outBytes + decodedBytes;
+}
+
+unsigned DecodeAheadSoundStream::DecodeAhead(unsigned maxBytes)
+{
+    MutexLock decoderLock(decoderMutex_);
+
+    unsigned numBytes = 0;
+    {
+        MutexLock bufferLock(bufferMutex_);
+        if (endOfStream_)
+            return 0;
+        numBytes = Min(maxBytes, buffer_.size() - numBufferedBytes_);
+    }
+
+    // Decode whole samples only
+    const unsigned sampleSize = GetSampleSize();
+    numBytes = numBytes / sampleSize * sampleSize;
+    if (numBytes == 0)
+        return 0;
+
+    // Decode outside of the buffer lock so the mixing thread can keep reading decoded data
+    decodeBuffer_.resize(numBytes);
+    const unsigned decodedBytes = stream_->GetData(decodeBuffer_.data(), numBytes);
+
+    MutexLock bufferLock(bufferMutex_);
+    WriteBuffer(decodeBuffer_.data(), decodedBytes);
+    if (decodedBytes < numBytes)
+        endOfStream_ = true;
+    return decodedBytes;
+}
+
+unsigned DecodeAheadSoundStream::GetBufferNumBytes() const
+{
+    MutexLock bufferLock(bufferMutex_);
+    return numBufferedBytes_;
+}
+
+bool DecodeAheadSoundStream::IsEndOfStream() const
+{
+    MutexLock bufferLock(bufferMutex_);
+    return endOfStream_ && numBufferedBytes_ == 0;
+}
+
+unsigned DecodeAheadSoundStream::ReadBuffer(signed char* dest, unsigned numBytes)
+{
+    const unsigned bufferSize = buffer_.size();
+    const unsigned outBytes = Min(numBytes, numBufferedBytes_);
+
+    // Copy in up to two parts if data wraps around the end of the buffer
+    const unsigned firstPartSize = Min(outBytes, bufferSize - readPosition_);
+    memcpy(dest, buffer_.data() + readPosition_, firstPartSize);
+    memcpy(dest + firstPartSize, buffer_.data(), outBytes - firstPartSize);
+
+    readPosition_ = (readPosition_ + outBytes) % bufferSize;
+    numBufferedBytes_ -= outBytes;
+    return outBytes;
+}
+
+void DecodeAheadSoundStream::WriteBuffer(const signed char* src, unsigned numBytes)
+{
+    const unsigned bufferSize = buffer_.size();
+    assert(numBytes <= bufferSize - numBufferedBytes_);
+
+    const unsigned writePosition = (readPosition_ + numBufferedBytes_) % bufferSize;
+    const unsigned firstPartSize = Min(numBytes, bufferSize - writePosition);
+    memcpy(buffer_.data() + writePosition, src, firstPartSize);
+    memcpy(buffer_.data(), src + firstPartSize, numBytes - firstPartSize);
+
+    numBufferedBytes_ += numBytes;
+}
+
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "../Audio/SoundStream.h"
+#include "../Container/Ptr.h"
+#include "../Core/Mutex.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+/// Sound stream that decodes another stream ahead of playback into a ring buffer.
+/// The ring buffer is filled by SoundStreamDecoder on a worker thread.
+/// If the ring buffer runs dry, the rest of requested data is decoded in place.
+class URHO3D_API DecodeAheadSoundStream : public SoundStream
+{
+public:
+    /// Construct from wrapped stream and ring buffer size in bytes.
+    DecodeAheadSoundStream(SoundStream* stream, unsigned bufferSize);
+    /// Destruct.
+    ~DecodeAheadSoundStream() override;
+
+    /// Seek to sample number and discard decoded data. Return true on success.
+    bool Seek(unsigned sample_number) override;
+    /// Produce sound data into destination. Return number of bytes produced. Called by SoundSource from the mixing thread.
+    unsigned GetData(signed char* dest, unsigned numBytes) override;
+
+    /// Decode data into the ring buffer, at most specified amount of bytes. Return number of bytes decoded. Called by SoundStreamDecoder.
+    unsigned DecodeAhead(unsigned maxBytes);
+
+    /// Return wrapped stream.
+    SoundStream* GetStream() const { return stream_; }
+    /// Return ring buffer size in bytes.
+    unsigned GetBufferSize() const { return buffer_.size(); }
+    /// Return amount of decoded data in the ring buffer in bytes.
+    unsigned GetBufferNumBytes() const;
+    /// Return whether wrapped stream has no more data.
+    bool IsEndOfStream() const;
+    /// Return total amount of data decoded in place because the ring buffer ran dry, in bytes.
+    unsigned GetNumUnderrunBytes() const { return numUnderrunBytes_; }
+
+private:
+    /// Copy data from the ring buffer. Buffer mutex should be locked.
+    unsigned ReadBuffer(signed char* dest, unsigned numBytes);
+    /// Copy data into the ring buffer. Buffer mutex should be locked.
+    void WriteBuffer(const signed char* src, unsigned numBytes);
+
+    /// Wrapped stream.
+    SharedPtr<SoundStream> stream_;
+    /// Mutex for access to the wrapped stream. Held while decoding.
+    Mutex decoderMutex_;
+    /// Mutex for access to the ring buffer.
+    mutable Mutex bufferMutex_;
+    /// Ring buffer.
+    ea::vector<signed char> buffer_;
+    /// Read position in the ring buffer.
+    unsigned readPosition_{};
+    /// Amount of decoded data in the ring buffer.
+    unsigned numBufferedBytes_{};
+    /// Whether wrapped stream has no more data.
+    bool endOfStream_{};
+    /// Temporary buffer for decoding ahead.
+    ea::vector<signed char> decodeBuffer_;
+    /// Total amount of data decoded in place.
+    unsigned numUnderrunBytes_{};
+};
+
+}
@@ -45,6 +45,8 @@ public:
 
     /// Produce sound data into destination. Return number of bytes produced. Called by SoundSource from the mixing thread.
     unsigned GetData(signed char* dest, unsigned numBytes) override;
+    /// Return whether the stream may be decoded ahead of playback on a worker thread.
+    bool IsDecodeAheadSupported() const override { return true; }
 
 protected:
     /// Decoder state.
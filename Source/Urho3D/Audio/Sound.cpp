@@ -22,6 +22,7 @@
 
 #include "../Precompiled.h"
 
+#include "../Audio/Audio.h"
 #include "../Audio/OggVorbisSoundStream.h"
 #include "../Audio/Sound.h"
 #include "../Core/Context.h"
@@ -120,6 +121,17 @@ bool Sound::LoadOggVorbis(Deserializer& source)
     compressedLength_ = stb_vorbis_stream_length_in_seconds(vorbis);
     frequency_ = info.sample_rate;
     stereo_ = info.channels > 1;
+
+    // Decode short sounds at load to avoid decoding while playing
+    auto* audio = GetSubsystem<Audio>();
+    const float maxPredecodedLength = audio ? audio->GetMaxPredecodedSoundLength() : 0.0f;
+    if (maxPredecodedLength > 0.0f && compressedLength_ <= maxPredecodedLength)
+    {
+        DecodeOggVorbis(vorbis);
+        stb_vorbis_close(vorbis);
+        return dataSize_ != 0;
+    }
+
     stb_vorbis_close(vorbis);
 
     data_.swap(data);
@@ -310,6 +322,25 @@ void Sound::FixInterpolation()
     }
 }
 
+void Sound::DecodeOggVorbis(void* decoder)
+{
+    auto* vorbis = static_cast<stb_vorbis*>(decoder);
+
+    const unsigned numChannels = stereo_ ? 2 : 1;
+    const unsigned numSamples = stb_vorbis_stream_length_in_samples(vorbis) * numChannels;
+    if (!numSamples)
+        return;
+
+    SetSize(numSamples * sizeof(short));
+    SetFormat(frequency_, true, stereo_);
+
+    auto* dest = reinterpret_cast<short*>(data_.get());
+    const auto numDecodedSamples =
+        (unsigned)stb_vorbis_get_samples_short_interleaved(vorbis, numChannels, dest, numSamples) * numChannels;
+    if (numDecodedSamples < numSamples)
+        memset(dest + numDecodedSamples, 0, (numSamples - numDecodedSamples) * sizeof(short));
+}
+
 SharedPtr<SoundStream> Sound::GetDecoderStream() const
 {
     return compressed_ ? SharedPtr<SoundStream>(new OggVorbisSoundStream(this)) : SharedPtr<SoundStream>();
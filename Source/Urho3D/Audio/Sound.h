@@ -54,6 +54,7 @@ public:
     /// Load WAV format sound data.
     bool LoadWav(Deserializer& source);
     /// Load Ogg Vorbis format sound data. Does not decode at load, but will rather be decoded while playing.
+    /// Sounds not longer than Audio::GetMaxPredecodedSoundLength are decoded at load.
     bool LoadOggVorbis(Deserializer& source);
     /// Set sound size in bytes. Also resets the sound to be uncompressed and one-shot.
     void SetSize(unsigned dataSize);
@@ -122,6 +123,8 @@ public:
 private:
     /// Load optional parameters from an XML file.
     void LoadParameters();
+    /// Decode Ogg Vorbis data into uncompressed sound data.
+    void DecodeOggVorbis(void* decoder);
 
     /// Sound data.
     ea::shared_array<signed char> data_;
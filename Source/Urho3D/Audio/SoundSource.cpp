@@ -34,6 +34,10 @@
 #include <Urho3D/Scene/Scene.h>
 #include <Urho3D/Scene/SceneEvents.h>
 
+#ifdef URHO3D_SSE
+    #include <emmintrin.h>
+#endif
+
 #include <Urho3D/DebugNew.h>
 
 namespace Urho3D
@@ -48,64 +52,293 @@ static const int SOUND_SOURCE_LOW_FREQ_CHANNEL[] = {
     3, // SPK_SURROUND_5_1
 };
 
-#define INC_POS_LOOPED() \
-    pos += intAdd; \
-    fractPos += fractAdd; \
-    if (fractPos > 65535) \
-    { \
-        fractPos &= 65535; \
-        ++pos; \
-    } \
-    while (pos >= end) \
-        pos -= (end - repeat); \
-
-#define INC_POS_ONESHOT() \
-    pos += intAdd; \
-    fractPos += fractAdd; \
-    if (fractPos > 65535) \
-    { \
-        fractPos &= 65535; \
-        ++pos; \
-    } \
-    if (pos >= end) \
-    { \
-        pos = 0; \
-        break; \
-    } \
-
-#define INC_POS_STEREO_LOOPED() \
-    pos += ((unsigned)intAdd << 1u); \
-    fractPos += fractAdd; \
-    if (fractPos > 65535) \
-    { \
-        fractPos &= 65535; \
-        pos += 2; \
-    } \
-    while (pos >= end) \
-        pos -= (end - repeat); \
-
-#define INC_POS_STEREO_ONESHOT() \
-    pos += ((unsigned)intAdd << 1u); \
-    fractPos += fractAdd; \
-    if (fractPos > 65535) \
-    { \
-        fractPos &= 65535; \
-        pos += 2; \
-    } \
-    if (pos >= end) \
-    { \
-        pos = 0; \
-        break; \
-    } \
-
-#define GET_IP_SAMPLE() (((((int)pos[1] - (int)pos[0]) * fractPos) / 65536) + (int)pos[0])
-
-#define GET_IP_SAMPLE_LEFT() (((((int)pos[2] - (int)pos[0]) * fractPos) / 65536) + (int)pos[0])
-
-#define GET_IP_SAMPLE_RIGHT() (((((int)pos[3] - (int)pos[1]) * fractPos) / 65536) + (int)pos[1])
-
 static const int STREAM_SAFETY_SAMPLES = 4;
 
+/// Number of frames resampled at once.
+static const unsigned MIX_CHUNK_FRAMES = 256;
+
+/// Min gain that produces audible output. Lower gains were rounded to zero by the legacy integer mixer.
+static const float MIN_AUDIBLE_GAIN = 1.0f / 512.0f;
+
+namespace
+{
+
+/// Return scale that converts samples to 16-bit range.
+template <class T> float GetSampleScale() { return sizeof(T) == 1 ? 256.0f : 1.0f; }
+
+/// Convert contiguous samples to floating point, optionally interpolating towards the next frame.
+template <class T>
+void ConvertSamples(float dest[], const T* src, unsigned count, unsigned numChannels, float fract)
+{
+    const float scale = GetSampleScale<T>();
+    unsigned i = 0;
+#ifdef URHO3D_SSE
+    if constexpr (sizeof(T) == 2)
+    {
+        const __m128 scaleVec = _mm_set1_ps(scale);
+        const __m128 fractVec = _mm_set1_ps(fract);
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128 lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16));
+            __m128 hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(packed, packed), 16));
+            if (fract != 0.0f)
+            {
+                const __m128i nextPacked = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + numChannels));
+                const __m128 nextLo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(nextPacked, nextPacked), 16));
+                const __m128 nextHi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(nextPacked, nextPacked), 16));
+                lo = _mm_add_ps(lo, _mm_mul_ps(_mm_sub_ps(nextLo, lo), fractVec));
+                hi = _mm_add_ps(hi, _mm_mul_ps(_mm_sub_ps(nextHi, hi), fractVec));
+            }
+            _mm_storeu_ps(dest + i, _mm_mul_ps(lo, scaleVec));
+            _mm_storeu_ps(dest + i + 4, _mm_mul_ps(hi, scaleVec));
+        }
+    }
+#endif
+    for (; i < count; ++i)
+        dest[i] = (src[i] + (src[i + numChannels] - src[i]) * fract) * scale;
+}
+
+/// Resample sound data to floating point frames in 16-bit range and advance playback position.
+/// Return number of frames produced. Less frames are produced and position is reset if one-shot sound ends.
+template <class T>
+unsigned ResampleFrames(float dest[], unsigned numFrames, const T*& pos, int& fractPos, const T* end,
+    const T* repeat, bool looped, unsigned numChannels, int intAdd, int fractAdd, bool interpolation)
+{
+    // Fast path for sounds played at mixing rate: convert whole runs of contiguous samples
+    if (intAdd == 1 && fractAdd == 0)
+    {
+        const float fract = interpolation ? fractPos / 65536.0f : 0.0f;
+        unsigned frame = 0;
+        while (frame < numFrames)
+        {
+            if (pos >= end)
+            {
+                if (!looped)
+                {
+                    pos = nullptr;
+                    return frame;
+                }
+                while (pos >= end)
+                    pos -= end - repeat;
+            }
+
+            const auto numRemainingFrames = static_cast<unsigned>(end - pos) / numChannels;
+            const unsigned numRunFrames = Clamp(numRemainingFrames, 1u, numFrames - frame);
+            ConvertSamples(dest + frame * numChannels, pos, numRunFrames * numChannels, numChannels, fract);
+            pos += numRunFrames * numChannels;
+            frame += numRunFrames;
+        }
+
+        if (pos >= end)
+        {
+            if (!looped)
+                pos = nullptr;
+            else
+            {
+                while (pos >= end)
+                    pos -= end - repeat;
+            }
+        }
+        return numFrames;
+    }
+
+    const float scale = GetSampleScale<T>();
+    const float fractScale = 1.0f / 65536.0f;
+    for (unsigned frame = 0; frame < numFrames; ++frame)
+    {
+        float* frameDest = dest + frame * numChannels;
+        const float fract = interpolation ? fractPos * fractScale : 0.0f;
+        for (unsigned channel = 0; channel < numChannels; ++channel)
+            frameDest[channel] = (pos[channel] + (pos[channel + numChannels] - pos[channel]) * fract) * scale;
+
+        pos += intAdd * numChannels;
+        fractPos += fractAdd;
+        if (fractPos > 65535)
+        {
+            fractPos &= 65535;
+            pos += numChannels;
+        }
+
+        if (pos >= end)
+        {
+            if (!looped)
+            {
+                pos = nullptr;
+                return frame + 1;
+            }
+            while (pos >= end)
+                pos -= end - repeat;
+        }
+    }
+    return numFrames;
+}
+
+/// Mix mono frames into interleaved buffer.
+void MixMonoFrames(float dest[], const float src[], unsigned numFrames, unsigned numChannels, const float gains[])
+{
+    unsigned frame = 0;
+#ifdef URHO3D_SSE
+    switch (numChannels)
+    {
+    case 1:
+    {
+        const __m128 gain = _mm_set1_ps(gains[0]);
+        for (; frame + 4 <= numFrames; frame += 4)
+        {
+            float* frameDest = dest + frame;
+            const __m128 value = _mm_mul_ps(_mm_loadu_ps(src + frame), gain);
+            _mm_storeu_ps(frameDest, _mm_add_ps(_mm_loadu_ps(frameDest), value));
+        }
+        break;
+    }
+    case 2:
+    {
+        const __m128 gain = _mm_setr_ps(gains[0], gains[1], gains[0], gains[1]);
+        for (; frame + 4 <= numFrames; frame += 4)
+        {
+            float* frameDest = dest + frame * 2;
+            const __m128 value = _mm_loadu_ps(src + frame);
+            const __m128 value01 = _mm_mul_ps(_mm_unpacklo_ps(value, value), gain);
+            const __m128 value23 = _mm_mul_ps(_mm_unpackhi_ps(value, value), gain);
+            _mm_storeu_ps(frameDest, _mm_add_ps(_mm_loadu_ps(frameDest), value01));
+            _mm_storeu_ps(frameDest + 4, _mm_add_ps(_mm_loadu_ps(frameDest + 4), value23));
+        }
+        break;
+    }
+    case 4:
+    {
+        const __m128 gain = _mm_loadu_ps(gains);
+        for (; frame < numFrames; ++frame)
+        {
+            float* frameDest = dest + frame * 4;
+            const __m128 value = _mm_mul_ps(_mm_set1_ps(src[frame]), gain);
+            _mm_storeu_ps(frameDest, _mm_add_ps(_mm_loadu_ps(frameDest), value));
+        }
+        break;
+    }
+    case 6:
+    {
+        // Two frames are mixed at once as three vectors
+        const __m128 gain0 = _mm_loadu_ps(gains);
+        const __m128 gain1 = _mm_setr_ps(gains[4], gains[5], gains[0], gains[1]);
+        const __m128 gain2 = _mm_loadu_ps(gains + 2);
+        for (; frame + 2 <= numFrames; frame += 2)
+        {
+            float* frameDest = dest + frame * 6;
+            const __m128 value0 = _mm_set1_ps(src[frame]);
+            const __m128 value1 = _mm_set1_ps(src[frame + 1]);
+            const __m128 value01 = _mm_shuffle_ps(value0, value1, _MM_SHUFFLE(0, 0, 0, 0));
+            _mm_storeu_ps(frameDest, _mm_add_ps(_mm_loadu_ps(frameDest), _mm_mul_ps(value0, gain0)));
+            _mm_storeu_ps(frameDest + 4, _mm_add_ps(_mm_loadu_ps(frameDest + 4), _mm_mul_ps(value01, gain1)));
+            _mm_storeu_ps(frameDest + 8, _mm_add_ps(_mm_loadu_ps(frameDest + 8), _mm_mul_ps(value1, gain2)));
+        }
+        break;
+    }
+    default:
+        break;
+    }
+#endif
+    for (; frame < numFrames; ++frame)
+    {
+        for (unsigned channel = 0; channel < numChannels; ++channel)
+            dest[frame * numChannels + channel] += src[frame] * gains[channel];
+    }
+}
+
+/// Mix interleaved stereo frames into interleaved buffer.
+void MixStereoFrames(float dest[], const float src[], unsigned numFrames, unsigned numChannels,
+    const float leftGains[], const float rightGains[])
+{
+    unsigned frame = 0;
+#ifdef URHO3D_SSE
+    switch (numChannels)
+    {
+    case 1:
+    {
+        const __m128 leftGain = _mm_set1_ps(leftGains[0]);
+        const __m128 rightGain = _mm_set1_ps(rightGains[0]);
+        for (; frame + 4 <= numFrames; frame += 4)
+        {
+            float* frameDest = dest + frame;
+            const __m128 value01 = _mm_loadu_ps(src + frame * 2);
+            const __m128 value23 = _mm_loadu_ps(src + frame * 2 + 4);
+            const __m128 left = _mm_shuffle_ps(value01, value23, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 right = _mm_shuffle_ps(value01, value23, _MM_SHUFFLE(3, 1, 3, 1));
+            const __m128 value = _mm_add_ps(_mm_mul_ps(left, leftGain), _mm_mul_ps(right, rightGain));
+            _mm_storeu_ps(frameDest, _mm_add_ps(_mm_loadu_ps(frameDest), value));
+        }
+        break;
+    }
+    case 2:
+    {
+        const __m128 directGain = _mm_setr_ps(leftGains[0], rightGains[1], leftGains[0], rightGains[1]);
+        const __m128 crossGain = _mm_setr_ps(rightGains[0], leftGains[1], rightGains[0], leftGains[1]);
+        for (; frame + 2 <= numFrames; frame += 2)
+        {
+            float* frameDest = dest + frame * 2;
+            const __m128 direct = _mm_loadu_ps(src + frame * 2);
+            const __m128 cross = _mm_shuffle_ps(direct, direct, _MM_SHUFFLE(2, 3, 0, 1));
+            const __m128 value = _mm_add_ps(_mm_mul_ps(direct, directGain), _mm_mul_ps(cross, crossGain));
+            _mm_storeu_ps(frameDest, _mm_add_ps(_mm_loadu_ps(frameDest), value));
+        }
+        break;
+    }
+    case 4:
+    {
+        const __m128 leftGain = _mm_loadu_ps(leftGains);
+        const __m128 rightGain = _mm_loadu_ps(rightGains);
+        for (; frame < numFrames; ++frame)
+        {
+            float* frameDest = dest + frame * 4;
+            const __m128 left = _mm_mul_ps(_mm_set1_ps(src[frame * 2]), leftGain);
+            const __m128 right = _mm_mul_ps(_mm_set1_ps(src[frame * 2 + 1]), rightGain);
+            _mm_storeu_ps(frameDest, _mm_add_ps(_mm_loadu_ps(frameDest), _mm_add_ps(left, right)));
+        }
+        break;
+    }
+    case 6:
+    {
+        // Two frames are mixed at once as three vectors
+        const __m128 leftGain0 = _mm_loadu_ps(leftGains);
+        const __m128 leftGain1 = _mm_setr_ps(leftGains[4], leftGains[5], leftGains[0], leftGains[1]);
+        const __m128 leftGain2 = _mm_loadu_ps(leftGains + 2);
+        const __m128 rightGain0 = _mm_loadu_ps(rightGains);
+        const __m128 rightGain1 = _mm_setr_ps(rightGains[4], rightGains[5], rightGains[0], rightGains[1]);
+        const __m128 rightGain2 = _mm_loadu_ps(rightGains + 2);
+        for (; frame + 2 <= numFrames; frame += 2)
+        {
+            float* frameDest = dest + frame * 6;
+            const __m128 left0 = _mm_set1_ps(src[frame * 2]);
+            const __m128 right0 = _mm_set1_ps(src[frame * 2 + 1]);
+            const __m128 left1 = _mm_set1_ps(src[frame * 2 + 2]);
+            const __m128 right1 = _mm_set1_ps(src[frame * 2 + 3]);
+            const __m128 left01 = _mm_shuffle_ps(left0, left1, _MM_SHUFFLE(0, 0, 0, 0));
+            const __m128 right01 = _mm_shuffle_ps(right0, right1, _MM_SHUFFLE(0, 0, 0, 0));
+            const __m128 value0 = _mm_add_ps(_mm_mul_ps(left0, leftGain0), _mm_mul_ps(right0, rightGain0));
+            const __m128 value1 = _mm_add_ps(_mm_mul_ps(left01, leftGain1), _mm_mul_ps(right01, rightGain1));
+            const __m128 value2 = _mm_add_ps(_mm_mul_ps(left1, leftGain2), _mm_mul_ps(right1, rightGain2));
+            _mm_storeu_ps(frameDest, _mm_add_ps(_mm_loadu_ps(frameDest), value0));
+            _mm_storeu_ps(frameDest + 4, _mm_add_ps(_mm_loadu_ps(frameDest + 4), value1));
+            _mm_storeu_ps(frameDest + 8, _mm_add_ps(_mm_loadu_ps(frameDest + 8), value2));
+        }
+        break;
+    }
+    default:
+        break;
+    }
+#endif
+    for (; frame < numFrames; ++frame)
+    {
+        const float left = src[frame * 2];
+        const float right = src[frame * 2 + 1];
+        for (unsigned channel = 0; channel < numChannels; ++channel)
+            dest[frame * numChannels + channel] += left * leftGains[channel] + right * rightGains[channel];
+    }
+}
+
+}
+
 extern const char* autoRemoveModeNames[];
 
 SoundSource::SoundSource(Context* context) :
@@ -150,6 +383,7 @@ void SoundSource::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE("Reach", float, reach_, 0.0f, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Low Frequency Effect", bool, lowFrequency_, false, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Ignore Scene Time Scale", bool, ignoreSceneTimeScale_, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Priority", int, priority_, 0, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Is Playing", IsPlaying, SetPlayingAttr, bool, false, AM_DEFAULT);
     URHO3D_ENUM_ATTRIBUTE("Autoremove Mode", autoRemove_, autoRemoveModeNames, REMOVE_DISABLED, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Play Position", GetPositionAttr, SetPositionAttr, int, 0, AM_DEFAULT);
@@ -312,6 +546,11 @@ bool SoundSource::IsPlaying() const
     return (sound_ || soundStream_) && position_ != nullptr;
 }
 
+bool SoundSource::IsPlayingEffective() const
+{
+    return IsPlaying() && GetEffectiveTimeScale() != 0.0f;
+}
+
 void SoundSource::SetPlayPosition(signed char* pos)
 {
     // Setting play position on a stream is not supported
@@ -327,6 +566,11 @@ void SoundSource::SetIgnoreSceneTimeScale(bool ignoreSceneTimeScale)
     ignoreSceneTimeScale_ = ignoreSceneTimeScale;
 }
 
+void SoundSource::SetPriority(int priority)
+{
+    priority_ = priority;
+}
+
 void SoundSource::Update(float timeStep)
 {
     if (!audio_)
@@ -368,7 +612,7 @@ void SoundSource::Update(float timeStep)
     }
 }
 
-void SoundSource::Mix(int dest[], unsigned samples, int mixRate, SpeakerMode mode, bool interpolation)
+void SoundSource::Mix(float dest[], unsigned samples, int mixRate, SpeakerMode mode, bool interpolation)
 {
     if (!position_ || (!sound_ && !soundStream_))
         return;
@@ -412,81 +656,15 @@ void SoundSource::Mix(int dest[], unsigned samples, int mixRate, SpeakerMode mod
     if (!sound)
         return;
 
-    // Choose the correct mixing routine
-    if (!sound->IsStereo())
-    {
-        if (interpolation)
-        {
-            switch (mode)
-            {
-            case SPK_AUTO:
-                assert(!"SPK_AUTO");
-                break;
-            case SPK_MONO:
-                if (!lowFrequency_)
-                    MixMonoToMonoIP(sound, dest, samples, mixRate, effectiveFrequency);
-                break;
-            case SPK_STEREO:
-                if (!lowFrequency_)
-                    MixMonoToStereoIP(sound, dest, samples, mixRate, effectiveFrequency);
-                break;
-            case SPK_QUADROPHONIC:
-                if (!lowFrequency_)
-                    MixMonoToSurroundIP(sound, dest, samples, mixRate, effectiveFrequency, mode);
-                break;
-            case SPK_SURROUND_5_1:
-                if (lowFrequency_)
-                    MixMonoToMonoIP(sound, dest, samples, mixRate, SOUND_SOURCE_LOW_FREQ_CHANNEL[mode], 6);
-                else
-                    MixMonoToSurroundIP(sound, dest, samples, mixRate, effectiveFrequency, mode);
-                break;
-            }
-        }
-        else
-        {
-            switch (mode)
-            {
-            case SPK_AUTO:
-                assert(!"SPK_AUTO");
-                break;
-            case SPK_MONO:
-                if (!lowFrequency_)
-                    MixMonoToStereo(sound, dest, samples, mixRate, effectiveFrequency);
-                break;
-            case SPK_STEREO:
-                if (!lowFrequency_)
-                    MixMonoToMono(sound, dest, samples, mixRate, effectiveFrequency);
-                break;
-            case SPK_QUADROPHONIC:
-                if (!lowFrequency_)
-                    MixMonoToSurround(sound, dest, samples, mixRate, effectiveFrequency, mode);
-                break;
-            case SPK_SURROUND_5_1:
-                if (lowFrequency_)
-                    MixMonoToMono(
-                        sound, dest, samples, mixRate, effectiveFrequency, SOUND_SOURCE_LOW_FREQ_CHANNEL[mode], 6);
-                else
-                    MixMonoToSurround(sound, dest, samples, mixRate, effectiveFrequency, mode);
-                break;
-            }
-        }
-    }
+    float leftGains[MAX_SPEAKER_CHANNELS];
+    float rightGains[MAX_SPEAKER_CHANNELS];
+    virtualized_ = !dest;
+    if (!dest || !CalculateChannelGains(mode, sound->IsStereo(), leftGains, rightGains))
+        MixZeroVolume(sound, samples, mixRate, effectiveFrequency);
     else
     {
-        if (interpolation)
-        {
-            if (mode == SPK_MONO)
-                MixStereoToMonoIP(sound, dest, samples, mixRate, effectiveFrequency);
-            else
-                MixStereoToMultiIP(sound, dest, samples, mixRate, effectiveFrequency, mode);
-        }
-        else
-        {
-            if (mode == SPK_MONO)
-                MixStereoToMono(sound, dest, samples, mixRate, effectiveFrequency);
-            else
-                MixStereoToMulti(sound, dest, samples, mixRate, effectiveFrequency, mode);
-        }
+        MixFrames(sound, dest, samples, mixRate, effectiveFrequency, AUDIO_NUM_CHANNELS[mode], interpolation,
+            leftGains, rightGains);
     }
 
     // Update the time position. In stream mode, copy unused data back to the beginning of the stream buffer
@@ -613,7 +791,8 @@ void SoundSource::PlayLockless(const SharedPtr<SoundStream>& stream)
         streamBuffer_->SetFormat(stream->GetIntFrequency(), stream->IsSixteenBit(), stream->IsStereo());
         streamBuffer_->SetLooped(true);
 
-        soundStream_ = stream;
+        // Compressed streams are decoded ahead of playback if possible
+        soundStream_ = audio_ ? audio_->CreateDecodeAheadStream(stream) : stream;
         unusedStreamSize_ = 0;
         position_ = streamBuffer_->GetStart();
         fractPosition_ = 0;
@@ -654,1182 +833,111 @@ void SoundSource::SetPlayPositionLockless(signed char* pos)
     timePosition_ = ((float)(int)(size_t)(pos - sound_->GetStart())) / (sound_->GetSampleSize() * sound_->GetFrequency());
 }
 
-void SoundSource::MixMonoToMono(
-    Sound* sound, int dest[], unsigned samples, int mixRate, float effectiveFrequency, int channel, int channelCount)
-{
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    auto vol = RoundToInt(256.0f * totalGain);
-    if (!vol)
-    {
-        MixZeroVolume(sound, samples, mixRate, effectiveFrequency);
-        return;
-    }
-
-    float add = effectiveFrequency / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
-    if (sound->IsSixteenBit())
-    {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                dest += channel;
-                *dest = *dest + (*pos * vol) / 256;
-                dest += channelCount - channel;
-                INC_POS_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                dest += channel;
-                *dest = *dest + (*pos * vol) / 256;
-                dest += channelCount - channel;
-                INC_POS_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
-    else
-    {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                dest += channel;
-                *dest = *dest + *pos * vol;
-                dest += channelCount - channel;
-                INC_POS_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                dest += channel;
-                *dest = *dest + *pos * vol;
-                dest += channelCount - channel;
-                INC_POS_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-    fractPosition_ = fractPos;
-}
-
-void SoundSource::MixMonoToStereo(Sound* sound, int dest[], unsigned samples, int mixRate, float effectiveFrequency)
+bool SoundSource::CalculateChannelGains(SpeakerMode mode, bool stereo, float leftGains[], float rightGains[]) const
 {
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    auto leftVol = (int)((-panning_ + 1.0f) * (256.0f * totalGain + 0.5f));
-    auto rightVol = (int)((panning_ + 1.0f) * (256.0f * totalGain + 0.5f));
-    if (!leftVol && !rightVol)
-    {
-        MixZeroVolume(sound, samples, mixRate, effectiveFrequency);
-        return;
-    }
+    ea::fill(leftGains, leftGains + MAX_SPEAKER_CHANNELS, 0.0f);
+    ea::fill(rightGains, rightGains + MAX_SPEAKER_CHANNELS, 0.0f);
 
-    float add = effectiveFrequency / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
+    if (mode == SPK_AUTO)
+        return false;
 
-    if (sound->IsSixteenBit())
-    {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
+    const float totalGain = masterGain_ * attenuation_ * gain_;
+    // Rear channels follow front channels in quadrophonic mode and front center and LFE in 5.1 mode
+    const unsigned rearChannel = mode == SPK_SURROUND_5_1 ? 4 : 2;
 
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + (*pos * leftVol) / 256;
-                ++dest;
-                *dest = *dest + (*pos * rightVol) / 256;
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + (*pos * leftVol) / 256;
-                ++dest;
-                *dest = *dest + (*pos * rightVol) / 256;
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
-    else
+    if (!stereo)
     {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
+        const float leftGain = (-panning_ + 1.0f) * totalGain;
+        const float rightGain = (panning_ + 1.0f) * totalGain;
+        const float frontReach = reach_ + 1.0f;
+        const float rearReach = -reach_ + 1.0f;
 
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + *pos * leftVol;
-                ++dest;
-                *dest = *dest + *pos * rightVol;
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
+        if (lowFrequency_)
         {
-            while (samples--)
-            {
-                *dest = *dest + *pos * leftVol;
-                ++dest;
-                *dest = *dest + *pos * rightVol;
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = pos;
+            // Low frequency sources are audible only on LFE channel
+            if (mode == SPK_SURROUND_5_1)
+                leftGains[SOUND_SOURCE_LOW_FREQ_CHANNEL[mode]] = totalGain;
         }
-    }
-
-    fractPosition_ = fractPos;
-}
-
-void SoundSource::MixMonoToMonoIP(Sound* sound, int dest[], unsigned samples, int mixRate, float effectiveFrequency, int channel, int channelCount)
-{
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    auto vol = RoundToInt(256.0f * totalGain);
-    if (!vol)
-    {
-        MixZeroVolume(sound, samples, mixRate, effectiveFrequency);
-        return;
-    }
-
-    float add = effectiveFrequency / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
-    if (sound->IsSixteenBit())
-    {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
+        else if (mode == SPK_MONO)
+            leftGains[0] = totalGain;
+        else if (mode == SPK_STEREO)
         {
-            while (samples--)
-            {
-                dest += channel;
-                *dest = *dest + (GET_IP_SAMPLE() * vol) / 256;
-                dest += channelCount - channel;
-                INC_POS_LOOPED();
-            }
-            position_ = (signed char*)pos;
+            leftGains[0] = leftGain;
+            leftGains[1] = rightGain;
         }
         else
         {
-            while (samples--)
-            {
-                dest += channel;
-                *dest = *dest + (GET_IP_SAMPLE() * vol) / 256;
-                dest += channelCount - channel;
-                INC_POS_ONESHOT();
-            }
-            position_ = (signed char*)pos;
+            leftGains[0] = leftGain * frontReach;
+            leftGains[1] = rightGain * frontReach;
+            leftGains[rearChannel] = leftGain * rearReach;
+            leftGains[rearChannel + 1] = rightGain * rearReach;
+            if (mode == SPK_SURROUND_5_1)
+                leftGains[2] = Lerp(leftGains[0], leftGains[1], 0.5f) * Clamp(reach_, 0.0f, 1.0f);
         }
     }
     else
     {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
+        // Stereo sources are not panned. Front center and LFE are omitted
+        if (mode == SPK_MONO)
         {
-            while (samples--)
-            {
-                dest += channel;
-                *dest = *dest + GET_IP_SAMPLE() * vol;
-                dest += channelCount - channel;
-                INC_POS_LOOPED();
-            }
-            position_ = pos;
+            leftGains[0] = totalGain * 0.5f;
+            rightGains[0] = totalGain * 0.5f;
         }
         else
         {
-            while (samples--)
+            leftGains[0] = totalGain;
+            rightGains[1] = totalGain;
+            if (mode != SPK_STEREO)
             {
-                dest += channel;
-                *dest = *dest + GET_IP_SAMPLE() * vol;
-                dest += channelCount - channel;
-                INC_POS_ONESHOT();
+                leftGains[rearChannel] = totalGain;
+                rightGains[rearChannel + 1] = totalGain;
             }
-            position_ = pos;
         }
     }
 
-    fractPosition_ = fractPos;
+    const float maxGain = ea::max(*ea::max_element(leftGains, leftGains + MAX_SPEAKER_CHANNELS),
+        *ea::max_element(rightGains, rightGains + MAX_SPEAKER_CHANNELS));
+    return maxGain >= MIN_AUDIBLE_GAIN;
 }
 
-void SoundSource::MixMonoToStereoIP(Sound* sound, int dest[], unsigned samples, int mixRate, float effectiveFrequency)
+void SoundSource::MixFrames(Sound* sound, float dest[], unsigned samples, int mixRate, float effectiveFrequency,
+    unsigned numChannels, bool interpolation, const float leftGains[], const float rightGains[])
 {
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    auto leftVol = (int)((-panning_ + 1.0f) * (256.0f * totalGain + 0.5f));
-    auto rightVol = (int)((panning_ + 1.0f) * (256.0f * totalGain + 0.5f));
-    if (!leftVol && !rightVol)
-    {
-        MixZeroVolume(sound, samples, mixRate, effectiveFrequency);
-        return;
-    }
-
-    float add = effectiveFrequency / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
+    const float add = effectiveFrequency / (float)mixRate;
+    const auto intAdd = (int)add;
+    const auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
+    const bool stereo = sound->IsStereo();
+    const unsigned numSourceChannels = stereo ? 2 : 1;
     int fractPos = fractPosition_;
 
-    if (sound->IsSixteenBit())
+    float frames[MIX_CHUNK_FRAMES * 2];
+    while (samples > 0 && position_)
     {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
+        const unsigned numFrames = Min(samples, MIX_CHUNK_FRAMES);
 
-        if (sound->IsLooped())
+        unsigned numResampledFrames{};
+        if (sound->IsSixteenBit())
         {
-            while (samples--)
-            {
-                int s = GET_IP_SAMPLE();
-                *dest = *dest + (s * leftVol) / 256;
-                ++dest;
-                *dest = *dest + (s * rightVol) / 256;
-                ++dest;
-                INC_POS_LOOPED();
-            }
+            auto pos = (const short*)position_;
+            numResampledFrames = ResampleFrames(frames, numFrames, pos, fractPos, (const short*)sound->GetEnd(),
+                (const short*)sound->GetRepeat(), sound->IsLooped(), numSourceChannels, intAdd, fractAdd, interpolation);
             position_ = (signed char*)pos;
         }
         else
         {
-            while (samples--)
-            {
-                int s = GET_IP_SAMPLE();
-                *dest = *dest + (s * leftVol) / 256;
-                ++dest;
-                *dest = *dest + (s * rightVol) / 256;
-                ++dest;
-                INC_POS_ONESHOT();
-            }
+            auto pos = (const signed char*)position_;
+            numResampledFrames = ResampleFrames(frames, numFrames, pos, fractPos, (const signed char*)sound->GetEnd(),
+                (const signed char*)sound->GetRepeat(), sound->IsLooped(), numSourceChannels, intAdd, fractAdd, interpolation);
             position_ = (signed char*)pos;
         }
-    }
-    else
-    {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
 
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                int s = GET_IP_SAMPLE();
-                *dest = *dest + s * leftVol;
-                ++dest;
-                *dest = *dest + s * rightVol;
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = pos;
-        }
+        if (stereo)
+            MixStereoFrames(dest, frames, numResampledFrames, numChannels, leftGains, rightGains);
         else
-        {
-            while (samples--)
-            {
-                int s = GET_IP_SAMPLE();
-                *dest = *dest + s * leftVol;
-                ++dest;
-                *dest = *dest + s * rightVol;
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
-}
-
-void SoundSource::MixStereoToMono(Sound* sound, int dest[], unsigned samples, int mixRate, float effectiveFrequency)
-{
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    auto vol = RoundToInt(256.0f * totalGain);
-    if (!vol)
-    {
-        MixZeroVolume(sound, samples, mixRate, effectiveFrequency);
-        return;
-    }
+            MixMonoFrames(dest, frames, numResampledFrames, numChannels, leftGains);
 
-    float add = effectiveFrequency / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
-    if (sound->IsSixteenBit())
-    {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                int s = ((int)pos[0] + (int)pos[1]) / 2;
-                *dest = *dest + (s * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                int s = ((int)pos[0] + (int)pos[1]) / 2;
-                *dest = *dest + (s * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
-    else
-    {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                int s = ((int)pos[0] + (int)pos[1]) / 2;
-                *dest = *dest + s * vol;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                int s = ((int)pos[0] + (int)pos[1]) / 2;
-                *dest = *dest + s * vol;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
-}
-
-void SoundSource::MixStereoToStereo(Sound* sound, int dest[], unsigned samples, int mixRate, float effectiveFrequency)
-{
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    auto vol = RoundToInt(256.0f * totalGain);
-    if (!vol)
-    {
-        MixZeroVolume(sound, samples, mixRate, effectiveFrequency);
-        return;
-    }
-
-    float add = effectiveFrequency / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
-    if (sound->IsSixteenBit())
-    {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + (pos[0] * vol) / 256;
-                ++dest;
-                *dest = *dest + (pos[1] * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + (pos[0] * vol) / 256;
-                ++dest;
-                *dest = *dest + (pos[1] * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
-    else
-    {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + pos[0] * vol;
-                ++dest;
-                *dest = *dest + pos[1] * vol;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + pos[0] * vol;
-                ++dest;
-                *dest = *dest + pos[1] * vol;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
-}
-
-void SoundSource::MixStereoToMonoIP(Sound* sound, int dest[], unsigned samples, int mixRate, float effectiveFrequency)
-{
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    auto vol = RoundToInt(256.0f * totalGain);
-    if (!vol)
-    {
-        MixZeroVolume(sound, samples, mixRate, effectiveFrequency);
-        return;
-    }
-
-    float add = effectiveFrequency / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
-    if (sound->IsSixteenBit())
-    {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                int s = (GET_IP_SAMPLE_LEFT() + GET_IP_SAMPLE_RIGHT()) / 2;
-                *dest = *dest + (s * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                int s = (GET_IP_SAMPLE_LEFT() + GET_IP_SAMPLE_RIGHT()) / 2;
-                *dest = *dest + (s * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
-    else
-    {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                int s = (GET_IP_SAMPLE_LEFT() + GET_IP_SAMPLE_RIGHT()) / 2;
-                *dest = *dest + s * vol;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                int s = (GET_IP_SAMPLE_LEFT() + GET_IP_SAMPLE_RIGHT()) / 2;
-                *dest = *dest + s * vol;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
-}
-
-void SoundSource::MixStereoToStereoIP(Sound* sound, int dest[], unsigned samples, int mixRate, float effectiveFrequency)
-{
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    auto vol = RoundToInt(256.0f * totalGain);
-    if (!vol)
-    {
-        MixZeroVolume(sound, samples, mixRate, effectiveFrequency);
-        return;
-    }
-
-    float add = effectiveFrequency / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
-    if (sound->IsSixteenBit())
-    {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + (GET_IP_SAMPLE_LEFT() * vol) / 256;
-                ++dest;
-                *dest = *dest + (GET_IP_SAMPLE_RIGHT() * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + (GET_IP_SAMPLE_LEFT() * vol) / 256;
-                ++dest;
-                *dest = *dest + (GET_IP_SAMPLE_RIGHT() * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
-    else
-    {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + GET_IP_SAMPLE_LEFT() * vol;
-                ++dest;
-                *dest = *dest + GET_IP_SAMPLE_RIGHT() * vol;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + GET_IP_SAMPLE_LEFT() * vol;
-                ++dest;
-                *dest = *dest + GET_IP_SAMPLE_RIGHT() * vol;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
-}
-
-void SoundSource::MixMonoToSurround(
-    Sound* sound, int* dest, unsigned samples, int mixRate, float effectiveFrequency, SpeakerMode speakerMode)
-{
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    int frontLeftVol = (int)(((-panning_ + 1.0f) * (reach_ + 1.0f)) * (256.0f * totalGain + 0.5f));
-    int frontRightVol = (int)(((panning_ + 1.0f) * (reach_ + 1.0f)) * (256.0f * totalGain + 0.5f));
-    int rearLeftVol = (int)(((-panning_ + 1.0f) * (-reach_ + 1.0f)) * (256.0f * totalGain + 0.5f));
-    int rearRightVol = (int)(((panning_ + 1.0f) * (-reach_ + 1.0f)) * (256.0f * totalGain + 0.5f));
-    int centerVol = Lerp(frontLeftVol, frontRightVol, 0.5f) * Clamp(reach_, 0.0f, 1.0f);
-
-    if (!frontLeftVol && !frontRightVol && !rearLeftVol && !rearRightVol)
-    {
-        MixZeroVolume(sound, samples, mixRate, effectiveFrequency);
-        return;
-    }
-
-    float add = effectiveFrequency / (float)mixRate;
-    int intAdd = (int)add;
-    int fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
-    if (sound->IsSixteenBit())
-    {
-        short* pos = (short*)position_;
-        short* end = (short*)sound->GetEnd();
-        short* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + (*pos * frontLeftVol) / 256; // FL
-                ++dest;
-                *dest = *dest + (*pos * frontRightVol) / 256; // FR
-                ++dest;
-
-                if (speakerMode == SPK_SURROUND_5_1)
-                {
-                    *dest = *dest + (*pos * centerVol) / 256; // FC
-                    ++dest;
-                    ++dest; // LFE
-                }
-
-                *dest = *dest + (*pos * rearLeftVol) / 256; // RL
-                ++dest;
-                *dest = *dest + (*pos * rearRightVol) / 256; // RR
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + (*pos * frontLeftVol) / 256; // FL
-                ++dest;
-                *dest = *dest + (*pos * frontRightVol) / 256; // FR
-                ++dest;
-
-                if (speakerMode == SPK_SURROUND_5_1)
-                {
-                    *dest = *dest + (*pos * centerVol) / 256; // FC
-                    ++dest;
-                    ++dest; // LFE
-                }
-
-                *dest = *dest + (*pos * rearLeftVol) / 256; // RL
-                ++dest;
-                *dest = *dest + (*pos * rearRightVol) / 256; // RR
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
-    else
-    {
-        signed char* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + *pos * frontLeftVol; // FL
-                ++dest;
-                *dest = *dest + *pos * frontRightVol; // FR
-                ++dest;
-
-                if (speakerMode == SPK_SURROUND_5_1)
-                {
-                    *dest = *dest + *pos * centerVol; // FC
-                    ++dest;
-                    ++dest; // LFE
-                }
-
-                *dest = *dest + *pos * rearLeftVol; // RL
-                ++dest;
-                *dest = *dest + *pos * rearRightVol; // RR
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + *pos * frontLeftVol; // FL
-                ++dest;
-                *dest = *dest + *pos * frontRightVol; // FR
-                ++dest;
-
-                if (speakerMode == SPK_SURROUND_5_1)
-                {
-                    *dest = *dest + *pos * centerVol; // FC
-                    ++dest;
-                    ++dest; // LFE
-                }
-
-                *dest = *dest + *pos * rearLeftVol; // RL
-                ++dest;
-                *dest = *dest + *pos * rearRightVol; // RR
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
-}
-
-void SoundSource::MixMonoToSurroundIP(
-    Sound* sound, int* dest, unsigned samples, int mixRate, float effectiveFrequency, SpeakerMode speakerMode)
-{
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    int frontLeftVol = (int)(((-panning_ + 1.0f) * (reach_ + 1.0f)) * (256.0f * totalGain + 0.5f));
-    int frontRightVol = (int)(((panning_ + 1.0f) * (reach_ + 1.0f)) * (256.0f * totalGain + 0.5f));
-    int rearLeftVol = (int)(((-panning_ + 1.0f) * (-reach_ + 1.0f)) * (256.0f * totalGain + 0.05f));
-    int rearRightVol = (int)(((panning_ + 1.0f) * (-reach_ + 1.0f)) * (256.0f * totalGain + 0.5f));
-    int centerVol = Lerp(frontLeftVol, frontRightVol, 0.5f) * Clamp(reach_, 0.0f, 1.0f);
-
-    if (!frontLeftVol && !frontRightVol && !rearLeftVol && !rearRightVol)
-    {
-        MixZeroVolume(sound, samples, mixRate, effectiveFrequency);
-        return;
-    }
-
-    float add = effectiveFrequency / (float)mixRate;
-    int intAdd = (int)add;
-    int fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
-    if (sound->IsSixteenBit())
-    {
-        short* pos = (short*)position_;
-        short* end = (short*)sound->GetEnd();
-        short* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                int s = GET_IP_SAMPLE();
-                *dest = *dest + (s * frontLeftVol) / 256; // FL
-                ++dest;
-                *dest = *dest + (s * frontRightVol) / 256; // FR
-                ++dest;
-
-                if (speakerMode == SPK_SURROUND_5_1)
-                {
-                    *dest = *dest + (s * centerVol) / 256; // FC
-                    ++dest;
-                    ++dest; // LFE
-                }
-
-                *dest = *dest + (s * rearLeftVol) / 256; // RL
-                ++dest;
-                *dest = *dest + (s * rearRightVol) / 256; // RR
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                int s = GET_IP_SAMPLE();
-                *dest = *dest + (s * frontLeftVol) / 256; // FL
-                ++dest;
-                *dest = *dest + (s * frontRightVol) / 256; // FR
-                ++dest;
-
-                if (speakerMode == SPK_SURROUND_5_1)
-                {
-                    *dest = *dest + (s * centerVol) / 256; // FC
-                    ++dest;
-                    ++dest; // LFE
-                }
-
-                *dest = *dest + (s * rearLeftVol) / 256; // RL
-                ++dest;
-                *dest = *dest + (s * rearRightVol) / 256; // RR
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
-    else
-    {
-        signed char* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                int s = GET_IP_SAMPLE();
-                *dest = *dest + s * frontLeftVol; // FL
-                ++dest;
-                *dest = *dest + s * frontRightVol; // FR
-                ++dest;
-
-                if (speakerMode == SPK_SURROUND_5_1)
-                {
-                    *dest = *dest + s * centerVol; // FC
-                    ++dest;
-                    ++dest; // LFE
-                }
-
-                *dest = *dest + s * rearLeftVol; // RL
-                ++dest;
-                *dest = *dest + s * rearRightVol; // RR
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                int s = GET_IP_SAMPLE();
-                *dest = *dest + s * frontLeftVol; // FL
-                ++dest;
-                *dest = *dest + s * frontRightVol; // FR
-                ++dest;
-
-                if (speakerMode == SPK_SURROUND_5_1)
-                {
-                    *dest = *dest + s * centerVol; // FC
-                    ++dest; // FC
-                    ++dest; // LFE
-                }
-
-                *dest = *dest + s * rearLeftVol; // RL
-                ++dest;
-                *dest = *dest + s * rearRightVol; // RR
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
-}
-
-void SoundSource::MixStereoToMulti(
-    Sound* sound, int* dest, unsigned samples, int mixRate, float effectiveFrequency, SpeakerMode speakers)
-{
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    int vol = (int)(256.0f * totalGain + 0.5f);
-    if (!vol)
-    {
-        MixZeroVolume(sound, samples, mixRate, effectiveFrequency);
-        return;
-    }
-
-    float add = effectiveFrequency / (float)mixRate;
-    int intAdd = (int)add;
-    int fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
-    if (sound->IsSixteenBit())
-    {
-        short* pos = (short*)position_;
-        short* end = (short*)sound->GetEnd();
-        short* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + (pos[0] * vol) / 256; // FL
-                ++dest;
-                *dest = *dest + (pos[1] * vol) / 256; // FR
-                ++dest;
-
-                if (speakers > SPK_STEREO)
-                {
-                    if (speakers == SPK_SURROUND_5_1)
-                    {
-                        ++dest; // FC
-                        ++dest; // LFE
-                    }
-
-                    *dest = *dest + (pos[0] * vol) / 256; // RL
-                    ++dest;
-                    *dest = *dest + (pos[1] * vol) / 256; // RR
-                    ++dest;
-                }
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + (pos[0] * vol) / 256; // FL
-                ++dest;
-                *dest = *dest + (pos[1] * vol) / 256; // FR
-                ++dest;
-                if (speakers > SPK_STEREO)
-                {
-                    if (speakers == SPK_SURROUND_5_1)
-                    {
-                        ++dest; // FC
-                        ++dest; // LFE
-                    }
-                    *dest = *dest + (pos[0] * vol) / 256; // RL
-                    ++dest;
-                    *dest = *dest + (pos[1] * vol) / 256; // RR
-                    ++dest;
-                }
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
-    else
-    {
-        signed char* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + pos[0] * vol; // FL
-                ++dest;
-                *dest = *dest + pos[1] * vol; // FR
-                ++dest;
-                if (speakers > SPK_STEREO)
-                {
-                    if (speakers == SPK_SURROUND_5_1)
-                    {
-                        ++dest; // FC
-                        ++dest; // LFE
-                    }
-                    *dest = *dest + pos[0] * vol; // RL
-                    ++dest;
-                    *dest = *dest + pos[1] * vol; // RR
-                    ++dest;
-                }
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + pos[0] * vol; // FL
-                ++dest;
-                *dest = *dest + pos[1] * vol; // FR
-                ++dest;
-                if (speakers > SPK_STEREO)
-                {
-                    if (speakers == SPK_SURROUND_5_1)
-                    {
-                        ++dest; // FC
-                        ++dest; // LFE
-                    }
-
-                    *dest = *dest + pos[0] * vol; // RL
-                    ++dest;
-                    *dest = *dest + pos[1] * vol; // RR
-                    ++dest;
-                }
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
-}
-
-void SoundSource::MixStereoToMultiIP(
-    Sound* sound, int* dest, unsigned samples, int mixRate, float effectiveFrequency, SpeakerMode speakers)
-{
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    int vol = (int)(256.0f * totalGain + 0.5f);
-    if (!vol)
-    {
-        MixZeroVolume(sound, samples, mixRate, effectiveFrequency);
-        return;
-    }
-
-    float add = effectiveFrequency / (float)mixRate;
-    int intAdd = (int)add;
-    int fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
-    if (sound->IsSixteenBit())
-    {
-        short* pos = (short*)position_;
-        short* end = (short*)sound->GetEnd();
-        short* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + (GET_IP_SAMPLE_LEFT() * vol) / 256; // FL
-                ++dest;
-                *dest = *dest + (GET_IP_SAMPLE_RIGHT() * vol) / 256; // FR
-                ++dest;
-                if (speakers > SPK_STEREO)
-                {
-                    if (speakers == SPK_SURROUND_5_1)
-                    {
-                        *dest = *dest + (((GET_IP_SAMPLE_LEFT() * vol) + GET_IP_SAMPLE_RIGHT() * vol) / 256) / 2;
-                        ++dest; // FC
-                        *dest = *dest + (((GET_IP_SAMPLE_LEFT() * vol) + GET_IP_SAMPLE_RIGHT() * vol) / 256) / 2;
-                        ++dest; // LFE
-                    }
-
-                    *dest = *dest + (GET_IP_SAMPLE_LEFT() * vol) / 256; // RL
-                    ++dest;
-                    *dest = *dest + (GET_IP_SAMPLE_RIGHT() * vol) / 256; // RR
-                    ++dest;
-                }
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + (GET_IP_SAMPLE_LEFT() * vol) / 256; // FL
-                ++dest;
-                *dest = *dest + (GET_IP_SAMPLE_RIGHT() * vol) / 256; // FR
-                ++dest;
-                if (speakers > SPK_STEREO)
-                {
-                    if (speakers == SPK_SURROUND_5_1)
-                    {
-                        ++dest; // FC
-                        ++dest; // LFE
-                    }
-
-                    *dest = *dest + (GET_IP_SAMPLE_LEFT() * vol) / 256; // RL
-                    ++dest;
-                    *dest = *dest + (GET_IP_SAMPLE_RIGHT() * vol) / 256; // RR
-                    ++dest;
-                }
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
-    else
-    {
-        signed char* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + GET_IP_SAMPLE_LEFT() * vol; // FL
-                ++dest;
-                *dest = *dest + GET_IP_SAMPLE_RIGHT() * vol; // FR
-                ++dest;
-                if (speakers > SPK_STEREO)
-                {
-                    if (speakers == SPK_SURROUND_5_1)
-                    {
-                        ++dest; // FC
-                        ++dest; // LFE
-                    }
-
-                    *dest = *dest + GET_IP_SAMPLE_LEFT() * vol; // RL
-                    ++dest;
-                    *dest = *dest + GET_IP_SAMPLE_RIGHT() * vol; // RR
-                    ++dest;
-                }
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + GET_IP_SAMPLE_LEFT() * vol; // FL
-                ++dest;
-                *dest = *dest + GET_IP_SAMPLE_RIGHT() * vol; // FR
-                ++dest;
-                if (speakers > SPK_STEREO)
-                {
-                    if (speakers == SPK_SURROUND_5_1)
-                    {
-                        ++dest; // FC
-                        ++dest; // LFE
-                    }
-
-                    *dest = *dest + GET_IP_SAMPLE_LEFT() * vol; // RL
-                    ++dest;
-                    *dest = *dest + GET_IP_SAMPLE_RIGHT() * vol; // RR
-                    ++dest;
-                }
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = pos;
-        }
+        dest += numFrames * numChannels;
+        samples -= numFrames;
     }
 
     fractPosition_ = fractPos;
@@ -90,6 +90,9 @@ public:
     void SetPlayPosition(signed char* pos);
     /// Enable or disable ignore scene time scale mode.
     void SetIgnoreSceneTimeScale(bool ignoreSceneTimeScale);
+    /// Set priority. When there are more playing sound sources than real voices, sources with higher priority are mixed first.
+    /// @property
+    void SetPriority(int priority);
 
     /// Return sound.
     /// @property
@@ -137,14 +140,27 @@ public:
     /// Return true if sound source ignores scene time scale.
     bool GetIgnoreSceneTimeScale() const { return ignoreSceneTimeScale_; }
 
+    /// Return priority.
+    /// @property
+    int GetPriority() const { return priority_; }
+
+    /// Return audibility used to choose between sound sources of same priority when voice limit is exceeded.
+    float GetAudibility() const { return masterGain_ * attenuation_ * gain_; }
+
+    /// Return whether the sound source was advanced without producing output during last mix because of voice limit.
+    bool IsVirtualized() const { return virtualized_; }
+
     /// Return whether is playing.
     /// @property
     bool IsPlaying() const;
+    /// Return whether is playing and advancing, i.e. not disabled and not paused together with the scene.
+    bool IsPlayingEffective() const;
 
     /// Update the sound source. Perform subclass specific operations. Called by Audio.
     virtual void Update(float timeStep);
-    /// Mix sound source output to a 32-bit clipping buffer. Called by Audio.
-    void Mix(int dest[], unsigned samples, int mixRate, SpeakerMode mode, bool interpolation);
+    /// Mix sound source output to a floating point buffer in 16-bit sample range. Called by Audio.
+    /// If destination is null, playback position is advanced without producing output.
+    void Mix(float dest[], unsigned samples, int mixRate, SpeakerMode mode, bool interpolation);
     /// Update the effective master gain. Called internally and by Audio when the master gain changes.
     void UpdateMasterGain();
 
@@ -194,36 +210,11 @@ private:
     void StopLockless();
     /// Set new playback position without locking the audio mutex. Called internally.
     void SetPlayPositionLockless(signed char* pos);
-    /// Mix mono sample to mono buffer.
-    void MixMonoToMono(Sound* sound, int dest[], unsigned samples, int mixRate, float effectiveFrequency,
-        int channel = 0, int channelCount = 1);
-    /// Mix mono sample to stereo buffer.
-    void MixMonoToStereo(Sound* sound, int dest[], unsigned samples, int mixRate, float effectiveFrequency);
-    /// Mix mono sample to mono buffer interpolated.
-    void MixMonoToMonoIP(Sound* sound, int dest[], unsigned samples, int mixRate, float effectiveFrequency,
-        int channel = 0, int channelCount = 1);
-    /// Mix mono sample to stereo buffer interpolated.
-    void MixMonoToStereoIP(Sound* sound, int dest[], unsigned samples, int mixRate, float effectiveFrequency);
-    /// Mix stereo sample to mono buffer.
-    void MixStereoToMono(Sound* sound, int dest[], unsigned samples, int mixRate, float effectiveFrequency);
-    /// Mix stereo sample to stereo buffer.
-    void MixStereoToStereo(Sound* sound, int dest[], unsigned samples, int mixRate, float effectiveFrequency);
-    /// Mix stereo sample to mono buffer interpolated.
-    void MixStereoToMonoIP(Sound* sound, int dest[], unsigned samples, int mixRate, float effectiveFrequency);
-    /// Mix stereo sample to stereo buffer interpolated.
-    void MixStereoToStereoIP(Sound* sound, int dest[], unsigned samples, int mixRate, float effectiveFrequency);
-    /// Mix a mono track to surround buffer.
-    void MixMonoToSurround(
-        Sound* sound, int* dest, unsigned samples, int mixRate, float effectiveFrequency, SpeakerMode speakers);
-    /// Mix a mono track into a surround buffer.
-    void MixMonoToSurroundIP(
-        Sound* sound, int* dest, unsigned samples, int mixRate, float effectiveFrequency, SpeakerMode speakers);
-    /// Mix stereo sample into multichannel. Front-center and LFE are ommitted.
-    void MixStereoToMulti(
-        Sound* sound, int* dest, unsigned samples, int mixRate, float effectiveFrequency, SpeakerMode speakers);
-    /// Mix stereo sample into multichannel. Front-center and LFE are ommitted.
-    void MixStereoToMultiIP(
-        Sound* sound, int* dest, unsigned samples, int mixRate, float effectiveFrequency, SpeakerMode speakers);
+    /// Calculate gains of left and right (or mono) input channel for each output channel. Return false if inaudible.
+    bool CalculateChannelGains(SpeakerMode mode, bool stereo, float leftGains[], float rightGains[]) const;
+    /// Resample sound and mix it into the buffer with specified gains.
+    void MixFrames(Sound* sound, float dest[], unsigned samples, int mixRate, float effectiveFrequency,
+        unsigned numChannels, bool interpolation, const float leftGains[], const float rightGains[]);
     /// Advance playback pointer without producing audible output.
     void MixZeroVolume(Sound* sound, unsigned samples, int mixRate, float effectiveFrequency);
     /// Advance playback pointer to simulate audio playback in headless mode.
@@ -247,6 +238,10 @@ private:
     int unusedStreamSize_;
     /// Ignore scene time scale and play sound even if scene is paused.
     bool ignoreSceneTimeScale_{false};
+    /// Priority of the voice.
+    int priority_{};
+    /// Whether the sound source was virtualized during last mix.
+    bool virtualized_{};
 };
 
 }
@@ -41,6 +41,9 @@ public:
 
     /// Produce sound data into destination. Return number of bytes produced. Called by SoundSource from the mixing thread.
     virtual unsigned GetData(signed char* dest, unsigned numBytes) = 0;
+    /// Return whether the stream may be decoded ahead of playback on a worker thread.
+    /// Streams that produce data depending on the main thread state should not be decoded ahead.
+    virtual bool IsDecodeAheadSupported() const { return false; }
 
     /// Set sound data format.
     void SetFormat(unsigned frequency, bool sixteenBit, bool stereo);
@@ -0,0 +1,81 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../Precompiled.h"
+
+#include "../Audio/SoundStreamDecoder.h"
+#include "../Core/Profiler.h"
+#include "../Core/Timer.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+/// Max amount of data decoded for one stream at once. Limits the wait of the mixing thread on underrun.
+static const unsigned MAX_DECODE_CHUNK_SIZE = 16 * 1024;
+/// Sleep time when all streams are filled.
+static const unsigned DECODER_SLEEP_MSEC = 5;
+
+SoundStreamDecoder::SoundStreamDecoder()
+    : Thread("SoundStreamDecoder")
+{
+}
+
+SoundStreamDecoder::~SoundStreamDecoder()
+{
+    Stop();
+}
+
+void SoundStreamDecoder::ThreadFunction()
+{
+    URHO3D_PROFILE_THREAD("SoundStreamDecoder Thread");
+
+    while (shouldRun_)
+    {
+        if (!DecodeStreams())
+            Time::Sleep(DECODER_SLEEP_MSEC);
+    }
+}
+
+void SoundStreamDecoder::AddStream(DecodeAheadSoundStream* stream)
+{
+    {
+        MutexLock lock(streamsMutex_);
+        streams_.emplace_back(stream);
+    }
+
+    if (!IsStarted())
+        Run();
+}
+
+unsigned SoundStreamDecoder::GetNumStreams() const
+{
+    MutexLock lock(streamsMutex_);
+    return streams_.size();
+}
+
+bool SoundStreamDecoder::DecodeStreams()
+{
+    {
+        MutexLock lock(streamsMutex_);
+
+        // Release streams that are not played anymore. Nobody can acquire new reference to such stream
+        ea::erase_if(streams_, [](const SharedPtr<DecodeAheadSoundStream>& stream) { return stream->Refs() == 1; });
+        threadStreams_ = streams_;
+    }
+
+    bool anyDecoded = false;
+    for (DecodeAheadSoundStream* stream : threadStreams_)
+    {
+        if (stream->DecodeAhead(MAX_DECODE_CHUNK_SIZE) > 0)
+            anyDecoded = true;
+    }
+
+    // Don't hold references outside of the lock
+    threadStreams_.clear();
+    return anyDecoded;
+}
+
+}
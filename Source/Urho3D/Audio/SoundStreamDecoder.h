@@ -0,0 +1,48 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "../Audio/DecodeAheadSoundStream.h"
+#include "../Core/Mutex.h"
+#include "../Core/Thread.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+/// Worker thread that keeps ring buffers of decode-ahead sound streams filled. Owned by Audio.
+/// Streams are released automatically when the decoder holds the last reference.
+/// @nobind
+class URHO3D_API SoundStreamDecoder : public RefCounted, public Thread
+{
+public:
+    /// Construct.
+    SoundStreamDecoder();
+    /// Destruct. Stop the thread.
+    ~SoundStreamDecoder() override;
+
+    /// Stream decoding loop.
+    void ThreadFunction() override;
+
+    /// Add stream to keep filled. Start the thread if not started yet.
+    void AddStream(DecodeAheadSoundStream* stream);
+
+    /// Return number of streams being decoded.
+    unsigned GetNumStreams() const;
+
+private:
+    /// Decode data for all streams once. Return whether any data was decoded.
+    bool DecodeStreams();
+
+    /// Mutex for the streams.
+    mutable Mutex streamsMutex_;
+    /// Streams being decoded.
+    ea::vector<SharedPtr<DecodeAheadSoundStream>> streams_;
+    /// Streams being decoded by the thread.
+    ea::vector<SharedPtr<DecodeAheadSoundStream>> threadStreams_;
+};
+
+}
@@ -1036,6 +1036,9 @@ using ImGuiConfigFlags = unsigned;
 %ignore Urho3D::PhysicsWorld2D::DrawTransform;
 %ignore Urho3D::PhysicsWorld2D::DrawPoint;
 
+// b2ParallelExecutor implementation
+%ignore Urho3D::PhysicsWorld2D::ParallelFor;
+
 %include "generated/Urho3D/_pre_physics2d.i"
 %include "Urho3D/Physics2D/CollisionShape2D.h"
 %include "Urho3D/Physics2D/CollisionPolygon2D.h"
@@ -100,6 +100,7 @@
 #include "../Utility/AnimationVelocityExtractor.h"
 #include "../Utility/AssetPipeline.h"
 #include "../Utility/AssetTransformer.h"
+#include "../Utility/SceneCooker.h"
 #include "../Utility/SceneViewerApplication.h"
 #ifdef URHO3D_ACTIONS
 #include "../Actions/ActionManager.h"
@@ -311,6 +312,7 @@ Engine::Engine(Context* context) :
     context_->AddFactoryReflection<AssetPipeline>();
     context_->AddFactoryReflection<AssetTransformer>();
     AnimationVelocityExtractor::RegisterObject(context_);
+    SceneCooker::RegisterObject(context_);
 
     SubscribeToEvent(E_EXITREQUESTED, URHO3D_HANDLER(Engine, HandleExitRequested));
     SubscribeToEvent(E_ENDFRAME, URHO3D_HANDLER(Engine, HandleEndFrame));
@@ -456,6 +458,8 @@ bool Engine::Initialize(const StringVariantMap& applicationParameters, const Str
         graphicsSettings.validateShaders_ = GetParameter(EP_VALIDATE_SHADERS).GetBool();
         graphicsSettings.discardShaderCache_ = GetParameter(EP_DISCARD_SHADER_CACHE).GetBool();
         graphicsSettings.cacheShaders_ = GetParameter(EP_SAVE_SHADER_CACHE).GetBool();
+        graphicsSettings.asyncShaderCompilation_ = GetParameter(EP_ASYNC_SHADER_COMPILATION).GetBool();
+        graphicsSettings.shaderManifestFile_ = FileIdentifier::FromUri(GetParameter(EP_SHADER_MANIFEST).GetString());
 
         WindowSettings windowSettings;
         const int width = GetParameter(EP_WINDOW_WIDTH).GetInt();
@@ -531,7 +535,7 @@ bool Engine::Initialize(const StringVariantMap& applicationParameters, const Str
         renderer->SetTextureFilterMode((TextureFilterMode)GetParameter(EP_TEXTURE_FILTER_MODE).GetInt());
         renderer->SetTextureAnisotropy(GetParameter(EP_TEXTURE_ANISOTROPY).GetInt());
 
-        if (GetParameter(EP_SOUND).GetBool())
+        if (GetParameter(EP_SOUND).GetBool() && !GetParameter(EP_SOUND_OFFLINE).GetBool())
         {
             GetSubsystem<Audio>()->SetMode(
                 GetParameter(EP_SOUND_BUFFER).GetInt(),
@@ -567,10 +571,24 @@ bool Engine::Initialize(const StringVariantMap& applicationParameters, const Str
         GetSubsystem<Network>()->SetPackageCacheDir(GetParameter(EP_PACKAGE_CACHE_DIR).GetString());
 #endif
 
+    // Initialize offline audio. Doesn't need audio device, so it's available in headless mode too
+    if (GetParameter(EP_SOUND).GetBool() && GetParameter(EP_SOUND_OFFLINE).GetBool())
+    {
+        auto audio = GetSubsystem<Audio>();
+        audio->SetOfflineMode(
+            GetParameter(EP_SOUND_MIX_RATE).GetInt(),
+            (SpeakerMode)GetParameter(EP_SOUND_MODE).GetInt(),
+            GetParameter(EP_SOUND_INTERPOLATION).GetBool()
+        );
+        audio->SetOfflineRecording(!GetParameter(EP_SOUND_OFFLINE_FILE).GetString().empty());
+    }
+
     if (HasParameter(EP_TIME_OUT))
         timeOut_ = GetParameter(EP_TIME_OUT).GetInt() * 1000000LL;
 
-    if (!headless_)
+    // SystemUI is not supported by null render backend
+    auto renderDevice = GetSubsystem<RenderDevice>();
+    if (!headless_ && renderDevice && renderDevice->GetBackend() != RenderBackend::Null)
     {
 #ifdef URHO3D_SYSTEMUI
         context_->RegisterSubsystem(new SystemUI(context_,
@@ -784,6 +802,9 @@ Console* Engine::CreateConsole()
         return nullptr;
 
 #ifdef URHO3D_SYSTEMUI
+    if (!GetSubsystem<SystemUI>())
+        return nullptr;
+
     // Return existing console if possible
     auto* console = GetSubsystem<Console>();
     if (!console)
@@ -804,6 +825,9 @@ DebugHud* Engine::CreateDebugHud()
         return nullptr;
 
 #ifdef URHO3D_SYSTEMUI
+    if (!GetSubsystem<SystemUI>())
+        return nullptr;
+
     // Return existing debug HUD if possible
     auto* debugHud = GetSubsystem<DebugHud>();
     if (!debugHud)
@@ -1148,6 +1172,7 @@ void Engine::DefineParameters(CLI::App& commandLine, StringVariantMap& enginePar
     addFlag("--nosound", EP_SOUND, false, "Disable sound");
     addFlag("--noip", EP_SOUND_INTERPOLATION, false, "Disable sound interpolation");
     addOptionInt("--speakermode", EP_SOUND_MODE, "Force sound speaker output mode (default is automatic)");
+    addFlag("--sound-offline", EP_SOUND_OFFLINE, true, "Mix sound without audio device according to engine clock");
     addFlag("--nothreads", EP_WORKER_THREADS, false, "Disable multithreading");
     addFlag("-v,--vsync", EP_VSYNC, true, "Enable vsync");
     addFlag("-w,--windowed", EP_BORDERLESS, false, "Windowed mode");
@@ -1170,6 +1195,7 @@ void Engine::DefineParameters(CLI::App& commandLine, StringVariantMap& enginePar
     addOptionInt("-m,--multisample", EP_MULTI_SAMPLE, "Multisampling samples");
     addOptionInt("-b,--sound-buffer", EP_SOUND_BUFFER, "Sound buffer size");
     addOptionInt("-r,--mix-rate", EP_SOUND_MIX_RATE, "Sound mixing rate");
+    addOptionString("--sound-offline-file", EP_SOUND_OFFLINE_FILE, "Save offline sound output to WAV file on exit");
     addOptionString("--pp,--prefix-paths", EP_RESOURCE_PREFIX_PATHS, "Resource prefix paths")->envname("URHO3D_PREFIX_PATH")->type_name("path1;path2;...");
     addOptionString("--pr,--resource-paths", EP_RESOURCE_PATHS, "Resource paths")->type_name("path1;path2;...");
     addOptionString("--pf,--resource-packages", EP_RESOURCE_PACKAGES, "Resource packages")->type_name("path1;path2;...");
@@ -1208,12 +1234,15 @@ void Engine::DefineParameters(CLI::App& commandLine, StringVariantMap& enginePar
     addFlag("--log-shader-sources", EP_SHADER_LOG_SOURCES, true, "Log shader sources into shader cache directory");
     addFlag("--discard-shader-cache", EP_DISCARD_SHADER_CACHE, true, "Discard all cached shader bytecode and logged shader sources");
     addFlag("--no-save-shader-cache", EP_SAVE_SHADER_CACHE, false, "Disable saving shader bytecode to cache directory");
+    addFlag("--async-shaders", EP_ASYNC_SHADER_COMPILATION, true, "Compile shaders on worker threads");
+    addOptionString("--shader-manifest", EP_SHADER_MANIFEST, "Record requested shader variations to file")->type_name("uri");
     addFlag("--xr", EP_XR, true, "Launch the engine in XR mode");
 
     addFlag("--d3d11", EP_RENDER_BACKEND, static_cast<int>(RenderBackend::D3D11), "Use Direct3D11 rendering backend");
     addFlag("--d3d12", EP_RENDER_BACKEND, static_cast<int>(RenderBackend::D3D12), "Use Direct3D12 rendering backend");
     addFlag("--opengl", EP_RENDER_BACKEND, static_cast<int>(RenderBackend::OpenGL), "Use OpenGL rendering backend");
     addFlag("--vulkan", EP_RENDER_BACKEND, static_cast<int>(RenderBackend::Vulkan), "Use Vulkan rendering backend");
+    addFlag("--null-backend", EP_RENDER_BACKEND, static_cast<int>(RenderBackend::Null), "Use null rendering backend without GPU");
 
     // Define --win32-console command line argument.
     // Actual argument handling is done at ParseArguments function from ProcessUtils.cpp.
@@ -1267,6 +1296,7 @@ void Engine::PopulateDefaultParameters()
 
     engineParameters_->DefineVariable(EP_APPLICATION_NAME, "Unspecified Application");
     engineParameters_->DefineVariable(EP_APPLICATION_PREFERENCES_DIR, EMPTY_STRING);
+    engineParameters_->DefineVariable(EP_ASYNC_SHADER_COMPILATION, false);
     engineParameters_->DefineVariable(EP_AUTOLOAD_PATHS, "Autoload").CommandLinePriority();
     engineParameters_->DefineVariable(EP_CONFIG_NAME, "EngineParameters.json");
     engineParameters_->DefineVariable(EP_BORDERLESS, true).Overridable();
@@ -1299,11 +1329,14 @@ void Engine::PopulateDefaultParameters()
     engineParameters_->DefineVariable(EP_SHADER_CACHE_DIR, "conf://ShaderCache");
     engineParameters_->DefineVariable(EP_SHADER_POLICY).SetOptional<int>();
     engineParameters_->DefineVariable(EP_SHADER_LOG_SOURCES, false);
+    engineParameters_->DefineVariable(EP_SHADER_MANIFEST, EMPTY_STRING);
     engineParameters_->DefineVariable(EP_SOUND, true);
     engineParameters_->DefineVariable(EP_SOUND_BUFFER, 100);
     engineParameters_->DefineVariable(EP_SOUND_INTERPOLATION, true);
     engineParameters_->DefineVariable(EP_SOUND_MIX_RATE, 44100);
     engineParameters_->DefineVariable(EP_SOUND_MODE, SpeakerMode::SPK_AUTO);
+    engineParameters_->DefineVariable(EP_SOUND_OFFLINE, false);
+    engineParameters_->DefineVariable(EP_SOUND_OFFLINE_FILE, EMPTY_STRING);
     engineParameters_->DefineVariable(EP_SYSTEMUI_FLAGS, 0u);
     engineParameters_->DefineVariable(EP_TEXTURE_ANISOTROPY, 4).Overridable();
     engineParameters_->DefineVariable(EP_TEXTURE_FILTER_MODE, FILTER_TRILINEAR).Overridable();
@@ -1352,9 +1385,24 @@ void Engine::DoExit()
     if (graphics)
     {
         graphics->SavePipelineStateCache(FileIdentifier::FromUri(GetParameter(EP_PSO_CACHE).GetString()));
+        graphics->SaveShaderVariationManifest();
         graphics->Close();
     }
 
+    auto* audio = GetSubsystem<Audio>();
+    if (audio && audio->IsOffline())
+    {
+        const AudioMixStatistics& stats = audio->GetTotalMixStatistics();
+        URHO3D_LOGINFO("Offline audio mixed {} samples in {:.3f} ms, {:.3f} ms per second of audio, max {:.3f} ms per mix, "
+            "max {} real and {} virtual voices", stats.numSamples_, stats.mixTimeUSec_ / 1000.0,
+            stats.GetMixTimePerSecond(audio->GetMixRate()) / 1000.0, stats.maxMixTimeUSec_ / 1000.0, stats.maxRealVoices_,
+            stats.maxVirtualVoices_);
+
+        const ea::string& fileName = GetParameter(EP_SOUND_OFFLINE_FILE).GetString();
+        if (!fileName.empty())
+            audio->SaveOfflineOutput(fileName);
+    }
+
     SaveConfigFile();
 
     exiting_ = true;
@@ -34,6 +34,7 @@ namespace Urho3D
 /// @{
 URHO3D_GLOBAL_CONSTANT(ConstString EP_APPLICATION_NAME{"ApplicationName"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_APPLICATION_PREFERENCES_DIR{"ApplicationPreferencesDir"});
+URHO3D_GLOBAL_CONSTANT(ConstString EP_ASYNC_SHADER_COMPILATION{"AsyncShaderCompilation"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_AUTOLOAD_PATHS{"AutoloadPaths"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_BORDERLESS{"Borderless"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_CONFIG_NAME{"ConfigName"});
@@ -65,11 +66,14 @@ URHO3D_GLOBAL_CONSTANT(ConstString EP_RESOURCE_ROOT_FILE{"ResourceRootFile"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_SAVE_SHADER_CACHE{"SaveShaderCache"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_SHADER_CACHE_DIR{"ShaderCacheDir"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_SHADER_LOG_SOURCES{"ShaderLogSource"});
+URHO3D_GLOBAL_CONSTANT(ConstString EP_SHADER_MANIFEST{"ShaderManifest"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_SHADER_POLICY{"ShaderPolicy"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_SOUND_BUFFER{"SoundBuffer"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_SOUND_INTERPOLATION{"SoundInterpolation"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_SOUND_MIX_RATE{"SoundMixRate"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_SOUND_MODE{"SoundMode"});
+URHO3D_GLOBAL_CONSTANT(ConstString EP_SOUND_OFFLINE_FILE{"SoundOfflineFile"});
+URHO3D_GLOBAL_CONSTANT(ConstString EP_SOUND_OFFLINE{"SoundOffline"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_SOUND{"Sound"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_SYSTEMUI_FLAGS{"SystemUIFlags"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_TEXTURE_ANISOTROPY{"TextureAnisotropy"});
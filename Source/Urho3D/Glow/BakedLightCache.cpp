@@ -26,9 +26,364 @@
 
 #include "../Glow/BakedLightCache.h"
 
+#include "../IO/FileSystem.h"
+#include "../IO/Log.h"
+#include "../IO/MemoryBuffer.h"
+#include "../IO/VectorBuffer.h"
+
+#include <type_traits>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 namespace Urho3D
 {
 
+namespace
+{
+
+/// Write vector of trivially copyable elements.
+template <class T>
+void WriteRawVector(Serializer& dest, const ea::vector<T>& data)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Vector element must be trivially copyable");
+    dest.WriteVLE(data.size());
+    dest.Write(data.data(), data.size() * sizeof(T));
+}
+
+/// Read vector of trivially copyable elements.
+template <class T>
+void ReadRawVector(Deserializer& source, ea::vector<T>& data)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Vector element must be trivially copyable");
+    data.resize(source.ReadVLE());
+    source.Read(data.data(), data.size() * sizeof(T));
+}
+
+/// Return size of vector data in bytes.
+template <class T>
+unsigned long long GetVectorSize(const ea::vector<T>& data)
+{
+    return data.size() * sizeof(T);
+}
+
+void WriteBakedLight(Serializer& dest, const BakedLight& light)
+{
+    dest.WriteUInt(light.lightType_);
+    dest.WriteUInt(light.lightMode_);
+    dest.WriteUInt(light.lightMask_);
+    dest.WriteColor(light.color_);
+    dest.WriteFloat(light.indirectBrightness_);
+    dest.WriteFloat(light.fov_);
+    dest.WriteFloat(light.cutoff_);
+    dest.WriteFloat(light.distance_);
+    dest.WriteFloat(light.radius_);
+    dest.WriteFloat(light.angle_);
+    dest.WriteFloat(light.halfAngleTan_);
+    dest.WriteVector3(light.position_);
+    dest.WriteVector3(light.direction_);
+    dest.WriteQuaternion(light.rotation_);
+}
+
+BakedLight ReadBakedLight(Deserializer& source)
+{
+    BakedLight light;
+    light.lightType_ = static_cast<LightType>(source.ReadUInt());
+    light.lightMode_ = static_cast<LightMode>(source.ReadUInt());
+    light.lightMask_ = source.ReadUInt();
+    light.color_ = source.ReadColor();
+    light.indirectBrightness_ = source.ReadFloat();
+    light.fov_ = source.ReadFloat();
+    light.cutoff_ = source.ReadFloat();
+    light.distance_ = source.ReadFloat();
+    light.radius_ = source.ReadFloat();
+    light.angle_ = source.ReadFloat();
+    light.halfAngleTan_ = source.ReadFloat();
+    light.position_ = source.ReadVector3();
+    light.direction_ = source.ReadVector3();
+    light.rotation_ = source.ReadQuaternion();
+    return light;
+}
+
+void WriteGeometryBuffer(Serializer& dest, const LightmapChartGeometryBuffer& geometryBuffer)
+{
+    dest.WriteUInt(geometryBuffer.index_);
+    dest.WriteUInt(geometryBuffer.lightmapSize_);
+    WriteRawVector(dest, geometryBuffer.positions_);
+    WriteRawVector(dest, geometryBuffer.smoothPositions_);
+    WriteRawVector(dest, geometryBuffer.smoothNormals_);
+    WriteRawVector(dest, geometryBuffer.faceNormals_);
+    WriteRawVector(dest, geometryBuffer.geometryIds_);
+    WriteRawVector(dest, geometryBuffer.lightMasks_);
+    WriteRawVector(dest, geometryBuffer.backgroundIds_);
+    WriteRawVector(dest, geometryBuffer.texelRadiuses_);
+    WriteRawVector(dest, geometryBuffer.albedo_);
+    WriteRawVector(dest, geometryBuffer.emission_);
+    WriteRawVector(dest, geometryBuffer.seams_);
+}
+
+void ReadGeometryBuffer(Deserializer& source, LightmapChartGeometryBuffer& geometryBuffer)
+{
+    geometryBuffer.index_ = source.ReadUInt();
+    geometryBuffer.lightmapSize_ = source.ReadUInt();
+    ReadRawVector(source, geometryBuffer.positions_);
+    ReadRawVector(source, geometryBuffer.smoothPositions_);
+    ReadRawVector(source, geometryBuffer.smoothNormals_);
+    ReadRawVector(source, geometryBuffer.faceNormals_);
+    ReadRawVector(source, geometryBuffer.geometryIds_);
+    ReadRawVector(source, geometryBuffer.lightMasks_);
+    ReadRawVector(source, geometryBuffer.backgroundIds_);
+    ReadRawVector(source, geometryBuffer.texelRadiuses_);
+    ReadRawVector(source, geometryBuffer.albedo_);
+    ReadRawVector(source, geometryBuffer.emission_);
+    ReadRawVector(source, geometryBuffer.seams_);
+}
+
+unsigned long long GetGeometryBufferSize(const LightmapChartGeometryBuffer& geometryBuffer)
+{
+    return GetVectorSize(geometryBuffer.positions_) + GetVectorSize(geometryBuffer.smoothPositions_)
+        + GetVectorSize(geometryBuffer.smoothNormals_) + GetVectorSize(geometryBuffer.faceNormals_)
+        + GetVectorSize(geometryBuffer.geometryIds_) + GetVectorSize(geometryBuffer.lightMasks_)
+        + GetVectorSize(geometryBuffer.backgroundIds_) + GetVectorSize(geometryBuffer.texelRadiuses_)
+        + GetVectorSize(geometryBuffer.albedo_) + GetVectorSize(geometryBuffer.emission_)
+        + GetVectorSize(geometryBuffer.seams_);
+}
+
+/// Write baked chunk. Backgrounds of raytracer scene are not written.
+void WriteBakedChunk(Serializer& dest, const BakedSceneChunk& bakedChunk)
+{
+    dest.WriteBool(bakedChunk.raytracerScene_ != nullptr);
+    if (bakedChunk.raytracerScene_)
+        WriteRaytracingScene(dest, *bakedChunk.raytracerScene_);
+
+    WriteRawVector(dest, bakedChunk.lightmaps_);
+    WriteRawVector(dest, bakedChunk.requiredDirectLightmaps_);
+
+    dest.WriteVLE(bakedChunk.geometryBuffers_.size());
+    for (const LightmapChartGeometryBuffer& geometryBuffer : bakedChunk.geometryBuffers_)
+        WriteGeometryBuffer(dest, geometryBuffer);
+    WriteRawVector(dest, bakedChunk.geometryBufferToRaytracer_);
+
+    dest.WriteVLE(bakedChunk.bakedLights_.size());
+    for (const BakedLight& bakedLight : bakedChunk.bakedLights_)
+        WriteBakedLight(dest, bakedLight);
+
+    const LightProbeCollectionForBaking& lightProbes = bakedChunk.lightProbesCollection_;
+    WriteRawVector(dest, lightProbes.worldPositions_);
+    WriteRawVector(dest, lightProbes.offsets_);
+    WriteRawVector(dest, lightProbes.counts_);
+    dest.WriteVLE(lightProbes.names_.size());
+    for (const ea::string& name : lightProbes.names_)
+        dest.WriteString(name);
+    WriteRawVector(dest, lightProbes.lightMasks_);
+    WriteRawVector(dest, lightProbes.backgroundIds_);
+
+    dest.WriteUInt(bakedChunk.numUniqueLightProbes_);
+}
+
+/// Read baked chunk and rebuild raytracer scene.
+void ReadBakedChunk(Deserializer& source, BakedSceneChunk& bakedChunk, Context* context,
+    const BakedSceneBackgroundArrayPtr& backgrounds)
+{
+    if (source.ReadBool())
+        bakedChunk.raytracerScene_ = ReadRaytracingScene(context, source, backgrounds);
+
+    ReadRawVector(source, bakedChunk.lightmaps_);
+    ReadRawVector(source, bakedChunk.requiredDirectLightmaps_);
+
+    bakedChunk.geometryBuffers_.resize(source.ReadVLE());
+    for (LightmapChartGeometryBuffer& geometryBuffer : bakedChunk.geometryBuffers_)
+        ReadGeometryBuffer(source, geometryBuffer);
+    ReadRawVector(source, bakedChunk.geometryBufferToRaytracer_);
+
+    bakedChunk.bakedLights_.resize(source.ReadVLE());
+    for (BakedLight& bakedLight : bakedChunk.bakedLights_)
+        bakedLight = ReadBakedLight(source);
+
+    LightProbeCollectionForBaking& lightProbes = bakedChunk.lightProbesCollection_;
+    ReadRawVector(source, lightProbes.worldPositions_);
+    ReadRawVector(source, lightProbes.offsets_);
+    ReadRawVector(source, lightProbes.counts_);
+    lightProbes.names_.resize(source.ReadVLE());
+    for (ea::string& name : lightProbes.names_)
+        name = source.ReadString();
+    ReadRawVector(source, lightProbes.lightMasks_);
+    ReadRawVector(source, lightProbes.backgroundIds_);
+
+    bakedChunk.numUniqueLightProbes_ = source.ReadUInt();
+}
+
+unsigned long long GetBakedChunkSize(const BakedSceneChunk& bakedChunk)
+{
+    unsigned long long size = GetVectorSize(bakedChunk.lightmaps_) + GetVectorSize(bakedChunk.requiredDirectLightmaps_)
+        + GetVectorSize(bakedChunk.geometryBufferToRaytracer_) + GetVectorSize(bakedChunk.bakedLights_)
+        + GetVectorSize(bakedChunk.lightProbesCollection_.worldPositions_);
+    for (const LightmapChartGeometryBuffer& geometryBuffer : bakedChunk.geometryBuffers_)
+        size += GetGeometryBufferSize(geometryBuffer);
+    if (bakedChunk.raytracerScene_)
+        size += GetRaytracingSceneSize(*bakedChunk.raytracerScene_);
+    return size;
+}
+
+void WriteDirectLight(Serializer& dest, const LightmapChartBakedDirect& bakedDirect)
+{
+    dest.WriteUInt(bakedDirect.lightmapSize_);
+    WriteRawVector(dest, bakedDirect.directLight_);
+    WriteRawVector(dest, bakedDirect.surfaceLight_);
+    WriteRawVector(dest, bakedDirect.albedo_);
+}
+
+void ReadDirectLight(Deserializer& source, LightmapChartBakedDirect& bakedDirect)
+{
+    bakedDirect.lightmapSize_ = source.ReadUInt();
+    bakedDirect.realLightmapSize_ = static_cast<float>(bakedDirect.lightmapSize_);
+    ReadRawVector(source, bakedDirect.directLight_);
+    ReadRawVector(source, bakedDirect.surfaceLight_);
+    ReadRawVector(source, bakedDirect.albedo_);
+}
+
+unsigned long long GetDirectLightSize(const LightmapChartBakedDirect& bakedDirect)
+{
+    return GetVectorSize(bakedDirect.directLight_) + GetVectorSize(bakedDirect.surfaceLight_)
+        + GetVectorSize(bakedDirect.albedo_);
+}
+
+void WriteLightmap(Serializer& dest, const BakedLightmap& bakedLightmap)
+{
+    dest.WriteUInt(bakedLightmap.lightmapSize_);
+    WriteRawVector(dest, bakedLightmap.lightmap_);
+}
+
+void ReadLightmap(Deserializer& source, BakedLightmap& bakedLightmap)
+{
+    bakedLightmap.lightmapSize_ = source.ReadUInt();
+    ReadRawVector(source, bakedLightmap.lightmap_);
+}
+
+unsigned long long GetLightmapSize(const BakedLightmap& bakedLightmap)
+{
+    return GetVectorSize(bakedLightmap.lightmap_);
+}
+
+}
+
+/// Spill file with native handle. Data is appended via write calls and read via memory mapping.
+struct BakedLightDiskCache::SpillFile
+{
+#ifdef _WIN32
+    HANDLE handle_{INVALID_HANDLE_VALUE};
+#else
+    int handle_{-1};
+#endif
+
+    /// Read-only view of file region.
+    struct MappedRegion
+    {
+        void* view_{};
+        unsigned long long viewSize_{};
+        const unsigned char* data_{};
+    };
+
+    /// Open file for reading and writing. Existing file is truncated.
+    bool Open(const ea::string& fileName)
+    {
+#ifdef _WIN32
+        handle_ = CreateFileW(GetWideNativePath(fileName).c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+            nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+        return handle_ != INVALID_HANDLE_VALUE;
+#else
+        handle_ = open(GetNativePath(fileName).c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        return handle_ != -1;
+#endif
+    }
+
+    /// Close and remove file.
+    void Close(const ea::string& fileName)
+    {
+#ifdef _WIN32
+        if (handle_ != INVALID_HANDLE_VALUE)
+            CloseHandle(handle_);
+#else
+        if (handle_ != -1)
+        {
+            close(handle_);
+            unlink(GetNativePath(fileName).c_str());
+        }
+#endif
+    }
+
+    /// Write data at given offset.
+    bool Write(unsigned long long offset, const unsigned char* data, unsigned size)
+    {
+        while (size > 0)
+        {
+#ifdef _WIN32
+            OVERLAPPED overlapped{};
+            overlapped.Offset = static_cast<DWORD>(offset);
+            overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+            DWORD numWritten = 0;
+            if (!WriteFile(handle_, data, size, &numWritten, &overlapped) || numWritten == 0)
+                return false;
+#else
+            const ssize_t numWritten = pwrite(handle_, data, size, static_cast<off_t>(offset));
+            if (numWritten <= 0)
+                return false;
+#endif
+            offset += numWritten;
+            data += numWritten;
+            size -= numWritten;
+        }
+        return true;
+    }
+
+    /// Map file region to memory.
+    bool Map(unsigned long long offset, unsigned size, MappedRegion& region)
+    {
+#ifdef _WIN32
+        SYSTEM_INFO systemInfo;
+        GetSystemInfo(&systemInfo);
+        const unsigned long long alignedOffset = offset - offset % systemInfo.dwAllocationGranularity;
+
+        HANDLE mapping = CreateFileMappingW(handle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+            return false;
+
+        region.view_ = MapViewOfFile(mapping, FILE_MAP_READ, static_cast<DWORD>(alignedOffset >> 32),
+            static_cast<DWORD>(alignedOffset), static_cast<SIZE_T>(offset - alignedOffset + size));
+        CloseHandle(mapping);
+        if (!region.view_)
+            return false;
+#else
+        static const unsigned long long pageSize = sysconf(_SC_PAGESIZE);
+        const unsigned long long alignedOffset = offset - offset % pageSize;
+
+        void* view = mmap(nullptr, offset - alignedOffset + size, PROT_READ, MAP_PRIVATE, handle_,
+            static_cast<off_t>(alignedOffset));
+        if (view == MAP_FAILED)
+            return false;
+        region.view_ = view;
+        region.viewSize_ = offset - alignedOffset + size;
+#endif
+        region.data_ = static_cast<const unsigned char*>(region.view_) + (offset - alignedOffset);
+        return true;
+    }
+
+    /// Unmap file region.
+    void Unmap(const MappedRegion& region)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(region.view_);
+#else
+        munmap(region.view_, region.viewSize_);
+#endif
+    }
+};
+
 BakedLightCache::~BakedLightCache() = default;
 
 void BakedLightMemoryCache::StoreBakedChunk(const IntVector3& chunk, BakedSceneChunk bakedChunk)
@@ -64,4 +419,210 @@ ea::shared_ptr<const BakedLightmap> BakedLightMemoryCache::LoadLightmap(unsigned
     return iter != lightmapCache_.end() ? iter->second : nullptr;
 }
 
+BakedLightDiskCache::BakedLightDiskCache(const ea::string& fileName, unsigned long long memoryLimit)
+    : fileName_(fileName)
+    , memoryLimit_(memoryLimit)
+{
+}
+
+BakedLightDiskCache::~BakedLightDiskCache()
+{
+    if (file_)
+        file_->Close(fileName_);
+}
+
+void BakedLightDiskCache::StoreBakedChunk(const IntVector3& chunk, BakedSceneChunk bakedChunk)
+{
+    if (bakedChunk.raytracerScene_)
+    {
+        context_ = bakedChunk.raytracerScene_->GetContext();
+        backgrounds_[chunk] = bakedChunk.raytracerScene_->GetBackgrounds();
+    }
+
+    const unsigned long long size = GetBakedChunkSize(bakedChunk);
+    StoreRecord({RecordType::BakedChunk, chunk}, ea::make_shared<BakedSceneChunk>(ea::move(bakedChunk)), size, true);
+}
+
+ea::shared_ptr<const BakedSceneChunk> BakedLightDiskCache::LoadBakedChunk(const IntVector3& chunk)
+{
+    return ea::static_pointer_cast<const BakedSceneChunk>(LoadRecord({RecordType::BakedChunk, chunk}));
+}
+
+void BakedLightDiskCache::StoreDirectLight(unsigned lightmapIndex, LightmapChartBakedDirect bakedDirect)
+{
+    const unsigned long long size = GetDirectLightSize(bakedDirect);
+    StoreRecord({RecordType::DirectLight, IntVector3{static_cast<int>(lightmapIndex), 0, 0}},
+        ea::make_shared<LightmapChartBakedDirect>(ea::move(bakedDirect)), size, true);
+}
+
+ea::shared_ptr<const LightmapChartBakedDirect> BakedLightDiskCache::LoadDirectLight(unsigned lightmapIndex)
+{
+    const RecordKey key{RecordType::DirectLight, IntVector3{static_cast<int>(lightmapIndex), 0, 0}};
+    return ea::static_pointer_cast<const LightmapChartBakedDirect>(LoadRecord(key));
+}
+
+void BakedLightDiskCache::StoreLightmap(unsigned lightmapIndex, BakedLightmap bakedLightmap)
+{
+    const unsigned long long size = GetLightmapSize(bakedLightmap);
+    StoreRecord({RecordType::Lightmap, IntVector3{static_cast<int>(lightmapIndex), 0, 0}},
+        ea::make_shared<BakedLightmap>(ea::move(bakedLightmap)), size, true);
+}
+
+ea::shared_ptr<const BakedLightmap> BakedLightDiskCache::LoadLightmap(unsigned lightmapIndex)
+{
+    const RecordKey key{RecordType::Lightmap, IntVector3{static_cast<int>(lightmapIndex), 0, 0}};
+    return ea::static_pointer_cast<const BakedLightmap>(LoadRecord(key));
+}
+
+void BakedLightDiskCache::StoreRecord(
+    const RecordKey& key, ea::shared_ptr<const void> data, unsigned long long size, bool dirty)
+{
+    // Stored record replaces both resident and saved versions
+    if (dirty)
+        fileIndex_.erase(key);
+
+    auto iter = residentRecords_.find(key);
+    if (iter != residentRecords_.end())
+    {
+        memoryUsage_ -= iter->second.size_;
+        lruList_.erase(iter->second.lruIterator_);
+        residentRecords_.erase(iter);
+    }
+
+    lruList_.push_front(key);
+
+    ResidentRecord& record = residentRecords_[key];
+    record.data_ = ea::move(data);
+    record.size_ = size;
+    record.dirty_ = dirty;
+    record.lruIterator_ = lruList_.begin();
+    memoryUsage_ += size;
+
+    EvictRecords();
+}
+
+ea::shared_ptr<const void> BakedLightDiskCache::FindResidentRecord(const RecordKey& key)
+{
+    const auto iter = residentRecords_.find(key);
+    if (iter == residentRecords_.end())
+        return nullptr;
+
+    lruList_.splice(lruList_.begin(), lruList_, iter->second.lruIterator_);
+    return iter->second.data_;
+}
+
+ea::shared_ptr<const void> BakedLightDiskCache::LoadRecord(const RecordKey& key)
+{
+    if (ea::shared_ptr<const void> data = FindResidentRecord(key))
+        return data;
+
+    const auto iter = fileIndex_.find(key);
+    if (iter == fileIndex_.end())
+        return nullptr;
+
+    const RecordLocation& location = iter->second;
+    SpillFile::MappedRegion region;
+    if (!file_->Map(location.offset_, location.size_, region))
+    {
+        URHO3D_LOGERROR("Cannot map light baking cache file '{}'", fileName_);
+        return nullptr;
+    }
+
+    MemoryBuffer source(region.data_, location.size_);
+    ea::shared_ptr<const void> data;
+    unsigned long long size{};
+    switch (key.type_)
+    {
+    case RecordType::BakedChunk:
+    {
+        auto bakedChunk = ea::make_shared<BakedSceneChunk>();
+        ReadBakedChunk(source, *bakedChunk, context_, backgrounds_[key.index_]);
+        size = GetBakedChunkSize(*bakedChunk);
+        data = ea::move(bakedChunk);
+        break;
+    }
+    case RecordType::DirectLight:
+    {
+        auto bakedDirect = ea::make_shared<LightmapChartBakedDirect>();
+        ReadDirectLight(source, *bakedDirect);
+        size = GetDirectLightSize(*bakedDirect);
+        data = ea::move(bakedDirect);
+        break;
+    }
+    case RecordType::Lightmap:
+    {
+        auto bakedLightmap = ea::make_shared<BakedLightmap>();
+        ReadLightmap(source, *bakedLightmap);
+        size = GetLightmapSize(*bakedLightmap);
+        data = ea::move(bakedLightmap);
+        break;
+    }
+    }
+
+    file_->Unmap(region);
+
+    StoreRecord(key, data, size, false);
+    return data;
+}
+
+void BakedLightDiskCache::EvictRecords()
+{
+    // Keep at least one record so the data that was just stored or loaded stays in memory
+    while (memoryUsage_ > memoryLimit_ && lruList_.size() > 1)
+    {
+        const RecordKey key = lruList_.back();
+        const auto iter = residentRecords_.find(key);
+        assert(iter != residentRecords_.end());
+
+        const ResidentRecord& record = iter->second;
+        if (record.dirty_ && !SaveRecord(key, record))
+            break;
+
+        memoryUsage_ -= record.size_;
+        lruList_.pop_back();
+        residentRecords_.erase(iter);
+    }
+}
+
+bool BakedLightDiskCache::SaveRecord(const RecordKey& key, const ResidentRecord& record)
+{
+    if (!file_)
+    {
+        file_ = ea::make_unique<SpillFile>();
+        if (!file_->Open(fileName_))
+        {
+            URHO3D_LOGERROR("Cannot create light baking cache file '{}'", fileName_);
+            file_ = nullptr;
+            memoryLimit_ = ea::numeric_limits<unsigned long long>::max();
+            return false;
+        }
+    }
+
+    VectorBuffer buffer;
+    switch (key.type_)
+    {
+    case RecordType::BakedChunk:
+        WriteBakedChunk(buffer, *static_cast<const BakedSceneChunk*>(record.data_.get()));
+        break;
+    case RecordType::DirectLight:
+        WriteDirectLight(buffer, *static_cast<const LightmapChartBakedDirect*>(record.data_.get()));
+        break;
+    case RecordType::Lightmap:
+        WriteLightmap(buffer, *static_cast<const BakedLightmap*>(record.data_.get()));
+        break;
+    }
+
+    const RecordLocation location{fileSize_, buffer.GetSize()};
+    if (!file_->Write(location.offset_, buffer.GetData(), location.size_))
+    {
+        URHO3D_LOGERROR("Cannot write light baking cache file '{}'", fileName_);
+        memoryLimit_ = ea::numeric_limits<unsigned long long>::max();
+        return false;
+    }
+
+    fileSize_ += location.size_;
+    fileIndex_[key] = location;
+    return true;
+}
+
 }
@@ -32,7 +32,9 @@
 #include "../Graphics/LightProbeGroup.h"
 #include "../Math/Vector3.h"
 
+#include <EASTL/list.h>
 #include <EASTL/shared_ptr.h>
+#include <EASTL/unique_ptr.h>
 
 namespace Urho3D
 {
@@ -105,4 +107,111 @@ private:
     ea::unordered_map<unsigned, ea::shared_ptr<const BakedLightmap>> lightmapCache_;
 };
 
+/// Disk-backed lightmap cache.
+/// Data is spilled to a single file and loaded back via memory mapping on demand.
+/// Only recently used data is kept in memory, the rest is evicted when memory limit is exceeded.
+/// Raytracer scenes of evicted baked chunks are rebuilt from spilled geometry on load.
+class URHO3D_API BakedLightDiskCache : public BakedLightCache
+{
+public:
+    /// Construct. Spill file is created on first eviction and removed on destruction.
+    BakedLightDiskCache(const ea::string& fileName, unsigned long long memoryLimit);
+    /// Destruct.
+    ~BakedLightDiskCache() override;
+
+    /// Store baked scene chunk in the cache.
+    void StoreBakedChunk(const IntVector3& chunk, BakedSceneChunk bakedChunk) override;
+    /// Load baked scene chunk.
+    ea::shared_ptr<const BakedSceneChunk> LoadBakedChunk(const IntVector3& chunk) override;
+
+    /// Store direct light for the lightmap chart.
+    void StoreDirectLight(unsigned lightmapIndex, LightmapChartBakedDirect bakedDirect) override;
+    /// Load direct light for the lightmap chart.
+    ea::shared_ptr<const LightmapChartBakedDirect> LoadDirectLight(unsigned lightmapIndex) override;
+
+    /// Store baked lightmap.
+    void StoreLightmap(unsigned lightmapIndex, BakedLightmap bakedLightmap) override;
+    /// Load baked lightmap.
+    ea::shared_ptr<const BakedLightmap> LoadLightmap(unsigned lightmapIndex) override;
+
+    /// Return size of the data kept in memory, in bytes. Raytracer scenes are counted without acceleration structures.
+    unsigned long long GetMemoryUsage() const { return memoryUsage_; }
+    /// Return size of the spill file, in bytes.
+    unsigned long long GetFileSize() const { return fileSize_; }
+
+private:
+    struct SpillFile;
+
+    /// Type of cached record.
+    enum class RecordType
+    {
+        BakedChunk,
+        DirectLight,
+        Lightmap
+    };
+
+    /// Key of cached record.
+    struct RecordKey
+    {
+        RecordType type_{};
+        IntVector3 index_;
+
+        bool operator==(const RecordKey& rhs) const { return type_ == rhs.type_ && index_ == rhs.index_; }
+        unsigned ToHash() const { return index_.ToHash() * 3 + static_cast<unsigned>(type_); }
+    };
+
+    /// Location of the record in spill file.
+    struct RecordLocation
+    {
+        unsigned long long offset_{};
+        unsigned size_{};
+    };
+
+    /// Record kept in memory.
+    struct ResidentRecord
+    {
+        /// Record data, one of the cached types.
+        ea::shared_ptr<const void> data_;
+        /// Approximate size of record data in memory.
+        unsigned long long size_{};
+        /// Whether the record is not saved to spill file yet.
+        bool dirty_{};
+        /// Position in LRU list.
+        ea::list<RecordKey>::iterator lruIterator_;
+    };
+
+    /// Store record in memory and evict old records if needed.
+    void StoreRecord(const RecordKey& key, ea::shared_ptr<const void> data, unsigned long long size, bool dirty);
+    /// Find record in memory and mark it as recently used.
+    ea::shared_ptr<const void> FindResidentRecord(const RecordKey& key);
+    /// Map record from spill file. Return null if record is not stored.
+    ea::shared_ptr<const void> LoadRecord(const RecordKey& key);
+    /// Evict least recently used records until memory usage fits the limit.
+    void EvictRecords();
+    /// Save record to spill file.
+    bool SaveRecord(const RecordKey& key, const ResidentRecord& record);
+
+    /// Spill file name.
+    ea::string fileName_;
+    /// Max size of data kept in memory.
+    unsigned long long memoryLimit_{};
+    /// Spill file, opened on demand.
+    ea::unique_ptr<SpillFile> file_;
+    /// Current size of spill file.
+    unsigned long long fileSize_{};
+
+    /// Index of records saved to spill file.
+    ea::unordered_map<RecordKey, RecordLocation> fileIndex_;
+    /// Records kept in memory.
+    ea::unordered_map<RecordKey, ResidentRecord> residentRecords_;
+    /// Keys of resident records, most recently used first.
+    ea::list<RecordKey> lruList_;
+    /// Current size of resident records.
+    unsigned long long memoryUsage_{};
+    /// Context used to rebuild raytracer scenes.
+    Context* context_{};
+    /// Backgrounds of raytracer scenes, shared between chunks and kept in memory.
+    ea::unordered_map<IntVector3, BakedSceneBackgroundArrayPtr> backgrounds_;
+};
+
 }
@@ -29,10 +29,15 @@
 #include "../Glow/Helpers.h"
 #include "../Glow/LightTracer.h"
 #include "../Graphics/Drawable.h"
+#include "../Graphics/Material.h"
+#include "../Graphics/Model.h"
+#include "../Graphics/StaticModel.h"
 #include "../Graphics/Terrain.h"
 #include "../Graphics/TerrainPatch.h"
 #include "../Graphics/Zone.h"
 #include "../IO/Log.h"
+#include "../IO/VirtualFileSystem.h"
+#include "../Resource/Image.h"
 
 #include <EASTL/sort.h>
 
@@ -136,6 +141,127 @@ ea::vector<LightProbeGroup*> CollectLightProbeGroupsInChunk(
     return lightProbeGroupsInChunk;
 }
 
+/// Hash array of floats.
+void HashFloats(unsigned long long& hash, const float* data, unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i)
+        CombineHash(hash, MakeHash(data[i]));
+}
+
+/// Hash resource name and version of its content: file modification time and memory use.
+void HashResource(unsigned long long& hash, Resource* resource)
+{
+    CombineHash(hash, MakeHash(GetResourceName(resource)));
+    if (!resource)
+        return;
+
+    auto vfs = resource->GetSubsystem<VirtualFileSystem>();
+    if (vfs && !resource->GetName().empty())
+        CombineHash(hash, vfs->GetLastModifiedTime(FileIdentifier::FromUri(resource->GetName()), false));
+    CombineHash(hash, resource->GetMemoryUse());
+}
+
+/// Hash material properties that affect baking.
+void HashMaterial(unsigned long long& hash, Material* material)
+{
+    HashResource(hash, material);
+    if (material)
+    {
+        CombineHash(hash, material->GetShaderParameterHash());
+        for (const auto& item : material->GetTextures())
+            HashResource(hash, item.second.value_);
+    }
+}
+
+/// Hash geometry properties that affect baking.
+void HashGeometry(unsigned long long& hash, Component* geometry)
+{
+    HashFloats(hash, geometry->GetNode()->GetWorldTransform().Data(), 12);
+    if (auto staticModel = dynamic_cast<StaticModel*>(geometry))
+    {
+        Model* model = staticModel->GetModel();
+        HashResource(hash, model);
+        if (model)
+        {
+            HashFloats(hash, model->GetBoundingBox().min_.Data(), 3);
+            HashFloats(hash, model->GetBoundingBox().max_.Data(), 3);
+        }
+        for (unsigned i = 0; i < staticModel->GetNumGeometries(); ++i)
+            HashMaterial(hash, staticModel->GetMaterial(i));
+        CombineHash(hash, staticModel->GetBakeLightmapEffective());
+        CombineHash(hash, staticModel->GetLightmapIndex());
+        HashFloats(hash, staticModel->GetLightmapScaleOffset().Data(), 4);
+    }
+    else if (auto terrain = dynamic_cast<Terrain*>(geometry))
+    {
+        HashResource(hash, terrain->GetHeightMap());
+        HashFloats(hash, terrain->GetSpacing().Data(), 3);
+        CombineHash(hash, terrain->GetPatchSize());
+        HashMaterial(hash, terrain->GetMaterial());
+        CombineHash(hash, terrain->GetBakeLightmapEffective());
+        CombineHash(hash, terrain->GetLightmapIndex());
+        HashFloats(hash, terrain->GetLightmapScaleOffset().Data(), 4);
+    }
+
+    if (auto drawable = dynamic_cast<Drawable*>(geometry))
+    {
+        CombineHash(hash, drawable->GetCastShadows());
+        CombineHash(hash, drawable->GetLightMask());
+    }
+}
+
+/// Hash light properties that affect baking.
+void HashLight(unsigned long long& hash, Light* light)
+{
+    const BakedLight bakedLight{light};
+    CombineHash(hash, bakedLight.lightType_);
+    CombineHash(hash, bakedLight.lightMode_);
+    CombineHash(hash, bakedLight.lightMask_);
+    HashFloats(hash, bakedLight.color_.Data(), 4);
+    CombineHash(hash, MakeHash(bakedLight.indirectBrightness_));
+    CombineHash(hash, MakeHash(bakedLight.fov_));
+    CombineHash(hash, MakeHash(bakedLight.distance_));
+    CombineHash(hash, MakeHash(bakedLight.radius_));
+    CombineHash(hash, MakeHash(bakedLight.angle_));
+    HashFloats(hash, bakedLight.position_.Data(), 3);
+    HashFloats(hash, bakedLight.direction_.Data(), 3);
+}
+
+/// Hash light probe group properties that affect baking.
+void HashLightProbeGroup(unsigned long long& hash, BakedSceneCollector& collector, const IntVector3& chunk,
+    LightProbeGroup* lightProbeGroup)
+{
+    HashFloats(hash, lightProbeGroup->GetNode()->GetWorldTransform().Data(), 12);
+    for (const LightProbe& lightProbe : lightProbeGroup->GetLightProbes())
+        HashFloats(hash, lightProbe.position_.Data(), 3);
+
+    Zone* zone = collector.GetLightProbeGroupZone(chunk, lightProbeGroup);
+    CombineHash(hash, lightProbeGroup->GetLightMask());
+    CombineHash(hash, zone->GetLightMask());
+    CombineHash(hash, collector.GetZoneBackground(chunk, zone));
+}
+
+/// Hash lightmap filter parameters.
+void HashFilterParameters(unsigned long long& hash, const EdgeStoppingGaussFilterParameters& params)
+{
+    CombineHash(hash, params.kernelRadius_);
+    CombineHash(hash, params.upscale_);
+    CombineHash(hash, MakeHash(params.luminanceSigma_));
+    CombineHash(hash, MakeHash(params.normalPower_));
+    CombineHash(hash, MakeHash(params.positionSigma_));
+    CombineHash(hash, static_cast<unsigned>(params.method_));
+    CombineHash(hash, params.useSIMD_);
+}
+
+/// Hash indirect light tracing settings.
+void HashIndirectTracingSettings(unsigned long long& hash, const IndirectLightTracingSettings& settings)
+{
+    CombineHash(hash, settings.maxSamples_);
+    CombineHash(hash, settings.maxBounces_);
+    CombineHash(hash, MakeHash(settings.scaledPositionBounceBias_));
+    CombineHash(hash, MakeHash(settings.constPositionBounceBias_));
+}
+
 /// Create mapping from geometry buffer to raytracing scene.
 ea::vector<unsigned> CreateGeometryMapping(
     const GeometryIDToObjectMappingVector& idToObject, const ea::vector<RaytracerGeometry>& raytracerGeometries)
@@ -306,4 +432,102 @@ BakedSceneChunk CreateBakedSceneChunk(Context* context,
     return bakedChunk;
 }
 
+unsigned long long CalculateBakedSceneChunkHash(
+    BakedSceneCollector& collector, const IntVector3& chunk, const LightBakingSettings& settings)
+{
+    // Collect objects the same way as for baking.
+    // Lights are collected for indirect volume because they affect light bounced from neighbor geometries.
+    const ea::vector<Component*> uniqueGeometries = collector.GetUniqueGeometries(chunk);
+    const ea::vector<LightProbeGroup*> uniqueLightProbeGroups = collector.GetUniqueLightProbeGroups(chunk);
+
+    const ea::vector<Light*> lightsInChunk = CollectLightsInChunk(collector, chunk);
+    const ea::vector<LightProbeGroup*> lightProbeGroupsInChunk = CollectLightProbeGroupsInChunk(
+        collector, chunk, uniqueLightProbeGroups);
+
+    const ea::vector<Component*> geometriesInChunk = CollectGeometriesInChunk(
+        collector, chunk, uniqueGeometries, lightsInChunk,
+        settings.incremental_.directionalLightShadowDistance_, settings.incremental_.indirectPadding_);
+
+    BoundingBox indirectBoundingBox = collector.GetChunkBoundingBox(chunk);
+    indirectBoundingBox.min_ -= Vector3::ONE * settings.incremental_.indirectPadding_;
+    indirectBoundingBox.max_ += Vector3::ONE * settings.incremental_.indirectPadding_;
+    const ea::vector<Light*> lightsInIndirectVolume = collector.GetLightsInBoundingBox(chunk, indirectBoundingBox);
+
+    // Hash objects. Order of unique objects matters, order of other objects doesn't.
+    unsigned long long hash = 0;
+    CombineHash(hash, uniqueGeometries.size());
+    for (Component* geometry : uniqueGeometries)
+        HashGeometry(hash, geometry);
+
+    unsigned long long relevantGeometriesHash = 0;
+    for (unsigned i = uniqueGeometries.size(); i < geometriesInChunk.size(); ++i)
+    {
+        unsigned long long geometryHash = 0;
+        HashGeometry(geometryHash, geometriesInChunk[i]);
+        relevantGeometriesHash += geometryHash;
+    }
+    CombineHash(hash, relevantGeometriesHash);
+
+    unsigned long long lightsHash = 0;
+    for (Light* light : lightsInIndirectVolume)
+    {
+        unsigned long long lightHash = 0;
+        HashLight(lightHash, light);
+        lightsHash += lightHash;
+    }
+    CombineHash(hash, lightsHash);
+
+    CombineHash(hash, uniqueLightProbeGroups.size());
+    for (LightProbeGroup* lightProbeGroup : lightProbeGroupsInChunk)
+        HashLightProbeGroup(hash, collector, chunk, lightProbeGroup);
+
+    for (const BakedSceneBackground& background : *collector.GetBackgrounds())
+    {
+        CombineHash(hash, MakeHash(background.intensity_));
+        HashFloats(hash, background.color_.Data(), 4);
+        HashResource(hash, background.image_);
+    }
+
+    return hash;
+}
+
+unsigned long long CalculateLightBakingSettingsHash(const LightBakingSettings& settings)
+{
+    // Numbers of tasks don't affect results and are not hashed
+    unsigned long long hash = 0;
+    CombineHash(hash, settings.charting_.lightmapSize_);
+    CombineHash(hash, settings.charting_.padding_);
+    CombineHash(hash, MakeHash(settings.charting_.texelDensity_));
+    CombineHash(hash, MakeHash(settings.charting_.minObjectScale_));
+    CombineHash(hash, settings.charting_.defaultChartSize_);
+
+    CombineHash(hash, StringHash(settings.geometryBufferBaking_.renderPathName_).Value());
+    CombineHash(hash, StringHash(settings.geometryBufferBaking_.materialName_).Value());
+    CombineHash(hash, settings.geometryBufferBaking_.uvChannel_);
+    CombineHash(hash, MakeHash(settings.geometryBufferBaking_.constantPositionBias_));
+    CombineHash(hash, MakeHash(settings.geometryBufferBaking_.scaledPositionBias_));
+    CombineHash(hash, MakeHash(settings.geometryBufferPreprocessing_.constPositionBackfaceBias_));
+    CombineHash(hash, MakeHash(settings.geometryBufferPreprocessing_.scaledPositionBackfaceBias_));
+
+    CombineHash(hash, settings.directChartTracing_.maxSamples_);
+    CombineHash(hash, settings.directProbesTracing_.maxSamples_);
+    HashIndirectTracingSettings(hash, settings.indirectChartTracing_);
+    HashIndirectTracingSettings(hash, settings.indirectProbesTracing_);
+
+    HashFilterParameters(hash, settings.directFilter_);
+    HashFilterParameters(hash, settings.indirectFilter_);
+
+    CombineHash(hash, settings.stitching_.numIterations_);
+    CombineHash(hash, MakeHash(settings.stitching_.blendFactor_));
+    CombineHash(hash, StringHash(settings.stitching_.stitchBackgroundModelName_).Value());
+    CombineHash(hash, StringHash(settings.stitching_.stitchBackgroundTechniqueName_).Value());
+    CombineHash(hash, StringHash(settings.stitching_.stitchSeamsTechniqueName_).Value());
+
+    CombineHash(hash, MakeHash(settings.properties_.emissionBrightness_));
+    CombineHash(hash, MakeHash(settings.incremental_.chunkSize_));
+    CombineHash(hash, MakeHash(settings.incremental_.indirectPadding_));
+    CombineHash(hash, MakeHash(settings.incremental_.directionalLightShadowDistance_));
+    return hash;
+}
+
 }
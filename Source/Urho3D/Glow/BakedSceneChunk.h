@@ -65,6 +65,14 @@ struct BakedSceneChunk
     unsigned numUniqueLightProbes_{};
 };
 
+/// Calculate hash of scene content that affects baked lighting of the chunk:
+/// geometries and their materials, lights, light probes and backgrounds.
+URHO3D_API unsigned long long CalculateBakedSceneChunkHash(
+    BakedSceneCollector& collector, const IntVector3& chunk, const LightBakingSettings& settings);
+
+/// Calculate hash of light baking settings that affect baked lighting.
+URHO3D_API unsigned long long CalculateLightBakingSettingsHash(const LightBakingSettings& settings);
+
 /// Create baked scene chunk.
 URHO3D_API BakedSceneChunk CreateBakedSceneChunk(Context* context,
     BakedSceneCollector& collector, const IntVector3& chunk, const LightBakingSettings& settings);
@@ -148,6 +148,7 @@ struct IncrementalLightBaker::Impl
         auto fileSystem = context_->GetSubsystem<FileSystem>();
 
         numLightmapCharts_ = 0;
+        missingLightmaps_.clear();
 
         for (const IntVector3& chunk : chunks_)
         {
@@ -174,6 +175,7 @@ struct IncrementalLightBaker::Impl
             }
 
             // Update base index
+            chunkLightmaps_[chunk] = {numLightmapCharts_, charts.size()};
             numLightmapCharts_ += charts.size();
         }
 
@@ -186,6 +188,7 @@ struct IncrementalLightBaker::Impl
 
             if (!vfs->Exists(fileName))
             {
+                missingLightmaps_.insert(i);
                 Image placeholderImage(context_);
                 placeholderImage.SetSize(1, 1, 4);
                 placeholderImage.SetPixel(0, 0, Color::BLACK);
@@ -200,15 +203,79 @@ struct IncrementalLightBaker::Impl
         }
     }
 
+    /// Find chunks that were changed since last bake.
+    void FindDirtyChunks()
+    {
+        const ea::unordered_map<IntVector3, unsigned long long> previousChunkHashes = LoadChunkHashes();
+
+        auto vfs = context_->GetSubsystem<VirtualFileSystem>();
+        const unsigned long long settingsHash = CalculateLightBakingSettingsHash(settings_);
+
+        chunkHashes_.clear();
+        dirtyChunks_.clear();
+        for (const IntVector3& chunk : chunks_)
+        {
+            unsigned long long hash = CalculateBakedSceneChunkHash(*collector_, chunk, settings_);
+            CombineHash(hash, settingsHash);
+            chunkHashes_[chunk] = hash;
+
+            const auto iter = previousChunkHashes.find(chunk);
+            bool isDirty = iter == previousChunkHashes.end() || iter->second != hash;
+
+            // Rebake if any output is missing
+            const ChunkLightmaps& lightmaps = chunkLightmaps_[chunk];
+            for (unsigned i = 0; i < lightmaps.count_ && !isDirty; ++i)
+                isDirty = missingLightmaps_.contains(lightmaps.first_ + i);
+
+            const unsigned numLightProbeGroups = collector_->GetUniqueLightProbeGroups(chunk).size();
+            for (unsigned i = 0; i < numLightProbeGroups && !isDirty; ++i)
+                isDirty = !vfs->Exists(GetLightProbeBakedDataFileName(chunk, i));
+
+            if (isDirty)
+                dirtyChunks_.push_back(chunk);
+        }
+
+        URHO3D_LOGINFO("{} of {} light baking chunks are changed", dirtyChunks_.size(), chunks_.size());
+    }
+
     /// Generate baking chunks.
+    /// Chunks are generated for dirty chunks and for chunks that own direct lightmaps required by dirty chunks.
     void GenerateBakingChunks()
     {
+        bakedChunks_.clear();
         numLightmapsTotal_ = 0;
-        for (const IntVector3& chunk : chunks_)
+        numDirectLightmapsTotal_ = 0;
+
+        ea::hash_set<unsigned> requiredDirectLightmaps;
+        for (const IntVector3& chunk : dirtyChunks_)
         {
             BakedSceneChunk bakedChunk = CreateBakedSceneChunk(context_, *collector_, chunk, settings_);
             numLightmapsTotal_ += bakedChunk.lightmaps_.size();
+            numDirectLightmapsTotal_ += bakedChunk.lightmaps_.size();
+            requiredDirectLightmaps.insert(
+                bakedChunk.requiredDirectLightmaps_.begin(), bakedChunk.requiredDirectLightmaps_.end());
             cache_->StoreBakedChunk(chunk, ea::move(bakedChunk));
+            bakedChunks_.push_back(chunk);
+        }
+
+        const ea::hash_set<IntVector3> dirtyChunks(dirtyChunks_.begin(), dirtyChunks_.end());
+        for (const IntVector3& chunk : chunks_)
+        {
+            if (dirtyChunks.contains(chunk))
+                continue;
+
+            const ChunkLightmaps& lightmaps = chunkLightmaps_[chunk];
+            bool isRequired = false;
+            for (unsigned i = 0; i < lightmaps.count_ && !isRequired; ++i)
+                isRequired = requiredDirectLightmaps.contains(lightmaps.first_ + i);
+
+            if (isRequired)
+            {
+                BakedSceneChunk bakedChunk = CreateBakedSceneChunk(context_, *collector_, chunk, settings_);
+                numDirectLightmapsTotal_ += bakedChunk.lightmaps_.size();
+                cache_->StoreBakedChunk(chunk, ea::move(bakedChunk));
+                bakedChunks_.push_back(chunk);
+            }
         }
     }
 
@@ -217,9 +284,9 @@ struct IncrementalLightBaker::Impl
     {
         status_.phase_.store(IncrementalLightBakerPhase::BakingDirectLighting, std::memory_order_relaxed);
         status_.processedElements_.store(0, std::memory_order_relaxed);
-        status_.totalElements_.store(numLightmapsTotal_, std::memory_order_relaxed);
+        status_.totalElements_.store(numDirectLightmapsTotal_, std::memory_order_relaxed);
 
-        for (const IntVector3 chunk : chunks_)
+        for (const IntVector3 chunk : bakedChunks_)
         {
             const ea::shared_ptr<const BakedSceneChunk> bakedChunk = cache_->LoadBakedChunk(chunk);
 
@@ -267,7 +334,7 @@ struct IncrementalLightBaker::Impl
         LightProbeCollectionBakedData lightProbesBakedData;
         LightmapChartBakedIndirect bakedIndirect{ settings_.charting_.lightmapSize_ };
 
-        for (const IntVector3 chunk : chunks_)
+        for (const IntVector3 chunk : dirtyChunks_)
         {
             if (stopToken.IsStopped())
                 return false;
@@ -367,6 +434,7 @@ struct IncrementalLightBaker::Impl
         }
 
         status_.phase_.store(IncrementalLightBakerPhase::Finalizing, std::memory_order_relaxed);
+        bakeFinished_ = true;
         return true;
     }
 
@@ -389,8 +457,8 @@ struct IncrementalLightBaker::Impl
             return;
         }
 
-        // Process all chunks
-        for (const IntVector3 chunk : chunks_)
+        // Process changed chunks
+        for (const IntVector3 chunk : dirtyChunks_)
         {
             const ea::shared_ptr<const BakedSceneChunk> bakedChunk = cache_->LoadBakedChunk(chunk);
             for (unsigned i = 0; i < bakedChunk->lightmaps_.size(); ++i)
@@ -433,9 +501,59 @@ struct IncrementalLightBaker::Impl
         }
     }
 
+    /// Save hashes of baked chunks. Chunks are not considered baked if baking was interrupted.
+    void SaveChunkHashes()
+    {
+        if (!bakeFinished_)
+            return;
+
+        const FileIdentifier fileName = outputDirectory_ + settings_.incremental_.chunkHashesFileName_;
+        auto vfs = context_->GetSubsystem<VirtualFileSystem>();
+        AbstractFilePtr file = vfs->OpenFile(fileName, FILE_WRITE);
+        if (!file)
+        {
+            URHO3D_LOGERROR("Cannot save chunk hashes to '{}'", fileName.ToUri());
+            return;
+        }
+
+        file->WriteVLE(chunkHashes_.size());
+        for (const auto& [chunk, hash] : chunkHashes_)
+        {
+            file->WriteIntVector3(chunk);
+            file->WriteUInt64(hash);
+        }
+    }
+
     const IncrementalLightBakerStatus& GetStatus() const { return status_; }
 
 private:
+    /// Range of lightmaps owned by chunk.
+    struct ChunkLightmaps
+    {
+        unsigned first_{};
+        unsigned count_{};
+    };
+
+    /// Load hashes of chunks baked last time.
+    ea::unordered_map<IntVector3, unsigned long long> LoadChunkHashes() const
+    {
+        ea::unordered_map<IntVector3, unsigned long long> result;
+
+        const FileIdentifier fileName = outputDirectory_ + settings_.incremental_.chunkHashesFileName_;
+        auto vfs = context_->GetSubsystem<VirtualFileSystem>();
+        AbstractFilePtr file = vfs->Exists(fileName) ? vfs->OpenFile(fileName, FILE_READ) : nullptr;
+        if (!file)
+            return result;
+
+        const unsigned numChunks = file->ReadVLE();
+        for (unsigned i = 0; i < numChunks && !file->IsEof(); ++i)
+        {
+            const IntVector3 chunk = file->ReadIntVector3();
+            result[chunk] = file->ReadUInt64();
+        }
+        return result;
+    }
+
     FileIdentifier GetOutputDirectory() const
     {
         if (!settings_.incremental_.outputDirectory_.empty())
@@ -483,9 +601,23 @@ private:
     ea::vector<IntVector3> chunks_;
     /// Number of lightmap charts.
     unsigned numLightmapCharts_{};
+    /// Lightmaps owned by each chunk.
+    ea::unordered_map<IntVector3, ChunkLightmaps> chunkLightmaps_;
+    /// Lightmaps that had no baked image before baking.
+    ea::hash_set<unsigned> missingLightmaps_;
+
+    /// Content hashes of all chunks.
+    ea::unordered_map<IntVector3, unsigned long long> chunkHashes_;
+    /// Chunks changed since last bake.
+    ea::vector<IntVector3> dirtyChunks_;
+    /// Chunks with generated baking data: dirty chunks and their neighbors required for indirect lighting.
+    ea::vector<IntVector3> bakedChunks_;
+    /// Whether the baking is finished.
+    bool bakeFinished_{};
 
     IncrementalLightBakerStatus status_;
     unsigned numLightmapsTotal_{};
+    unsigned numDirectLightmapsTotal_{};
 };
 
 ea::string IncrementalLightBakerStatus::ToString() const
@@ -525,6 +657,7 @@ bool IncrementalLightBaker::Initialize(const LightBakingSettings& settings,
 void IncrementalLightBaker::ProcessScene()
 {
     impl_->GenerateChartsAndUpdateScene();
+    impl_->FindDirtyChunks();
     impl_->GenerateBakingChunks();
 }
 
@@ -542,6 +675,7 @@ bool IncrementalLightBaker::Bake(StopToken stopToken)
 void IncrementalLightBaker::CommitScene()
 {
     impl_->StitchAndSaveImages();
+    impl_->SaveChunkHashes();
 }
 
 const IncrementalLightBakerStatus& IncrementalLightBaker::GetStatus() const
@@ -219,18 +219,76 @@ void GeometryBufferPreprocessFilter(const RTCFilterFunctionNArguments* args)
         args->valid[0] = 0;
 }
 
+/// Number of rays traced together in one packet. Embree is built for SSE2 only, so 4-wide packets are native.
+static const unsigned RayPacketSize = 4;
+/// Size of the tile of elements traced together. Rays from neighbor lightmap texels are more coherent.
+/// @{
+static const unsigned TracingTileWidth = 2;
+static const unsigned TracingTileHeight = 2;
+/// @}
+
+/// Return number of tile rows for elements arranged in 2D grid of given width.
+unsigned GetNumTileRows(unsigned numElements, unsigned gridWidth)
+{
+    const unsigned gridHeight = (numElements + gridWidth - 1) / gridWidth;
+    return (gridHeight + TracingTileHeight - 1) / TracingTileHeight;
+}
+
+/// Iterate elements arranged in 2D grid of given width tile by tile.
+template <class T>
+void ForEachElementInTiles(unsigned fromTileRow, unsigned toTileRow,
+    unsigned numElements, unsigned gridWidth, const T& callback)
+{
+    for (unsigned tileRow = fromTileRow; tileRow < toTileRow; ++tileRow)
+    {
+        const unsigned fromY = tileRow * TracingTileHeight;
+        for (unsigned fromX = 0; fromX < gridWidth; fromX += TracingTileWidth)
+        {
+            const unsigned toX = ea::min(fromX + TracingTileWidth, gridWidth);
+            for (unsigned y = fromY; y < fromY + TracingTileHeight; ++y)
+            {
+                for (unsigned x = fromX; x < toX; ++x)
+                {
+                    const unsigned elementIndex = y * gridWidth + x;
+                    if (elementIndex < numElements)
+                        callback(elementIndex);
+                }
+            }
+        }
+    }
+}
+
+/// Initialize ray of the packet. Ray ID is equal to the index of the ray in the packet.
+void SetPacketRay(RTCRayHit4& rayHit, unsigned rayIndex,
+    const Vector3& origin, const Vector3& direction, float maxDistance, unsigned mask)
+{
+    rayHit.ray.org_x[rayIndex] = origin.x_;
+    rayHit.ray.org_y[rayIndex] = origin.y_;
+    rayHit.ray.org_z[rayIndex] = origin.z_;
+    rayHit.ray.dir_x[rayIndex] = direction.x_;
+    rayHit.ray.dir_y[rayIndex] = direction.y_;
+    rayHit.ray.dir_z[rayIndex] = direction.z_;
+    rayHit.ray.tnear[rayIndex] = 0.0f;
+    rayHit.ray.tfar[rayIndex] = maxDistance;
+    rayHit.ray.time[rayIndex] = 0.0f;
+    rayHit.ray.mask[rayIndex] = mask;
+    rayHit.ray.id[rayIndex] = rayIndex;
+    rayHit.ray.flags[rayIndex] = 0;
+    rayHit.hit.geomID[rayIndex] = RTC_INVALID_GEOMETRY_ID;
+}
+
 /// Base context for direct light tracing.
 struct DirectTracingContextBase : public RTCIntersectContext
 {
-    /// Incoming light accumulator.
+    /// Incoming light accumulators, one per ray in packet.
     Vector3* incomingLight_{};
 };
 
 /// Ray tracing context for direct light baking for charts.
 struct DirectTracingContextForCharts : public DirectTracingContextBase
 {
-    /// Current geometry.
-    const RaytracerGeometry* currentGeometry_{};
+    /// Current geometries, one per ray in packet.
+    const RaytracerGeometry* currentGeometries_[RayPacketSize]{};
     /// Geometry index.
     const ea::vector<RaytracerGeometry>* geometryIndex_{};
 };
@@ -239,21 +297,24 @@ struct DirectTracingContextForCharts : public DirectTracingContextBase
 void TracingFilterForChartsDirect(const RTCFilterFunctionNArguments* args)
 {
     const auto& ctx = *static_cast<const DirectTracingContextForCharts*>(args->context);
-    auto& hit = *reinterpret_cast<RTCHit*>(args->hit);
-    assert(args->N == 1);
+    for (unsigned i = 0; i < args->N; ++i)
+    {
+        // Ignore invalid
+        if (args->valid[i] == 0)
+            continue;
 
-    // Ignore invalid
-    if (args->valid[0] == 0)
-        return;
+        const unsigned rayIndex = RTCRayN_id(args->ray, args->N, i);
+        const RTCHit hit = rtcGetHitFromHitN(args->hit, args->N, i);
 
-    // Ignore if unwanted LOD
-    const RaytracerGeometry& hitGeometry = (*ctx.geometryIndex_)[hit.geomID];
-    if (IsUnwantedLod(*ctx.currentGeometry_, hitGeometry))
-        args->valid[0] = 0;
+        // Ignore if unwanted LOD
+        const RaytracerGeometry& hitGeometry = (*ctx.geometryIndex_)[hit.geomID];
+        if (IsUnwantedLod(*ctx.currentGeometries_[rayIndex], hitGeometry))
+            args->valid[i] = 0;
 
-    // Accumulate and ignore if transparent
-    if (IsTransparedForDirect(hitGeometry, hit, *ctx.incomingLight_))
-        args->valid[0] = 0;
+        // Accumulate and ignore if transparent
+        if (IsTransparedForDirect(hitGeometry, hit, ctx.incomingLight_[rayIndex]))
+            args->valid[i] = 0;
+    }
 }
 
 /// Ray tracing context for direct light baking for light probes.
@@ -267,21 +328,24 @@ struct DirectTracingContextForLightProbes : public DirectTracingContextBase
 void TracingFilterForLightProbesDirect(const RTCFilterFunctionNArguments* args)
 {
     const auto& ctx = *static_cast<const DirectTracingContextForLightProbes*>(args->context);
-    auto& hit = *reinterpret_cast<RTCHit*>(args->hit);
-    assert(args->N == 1);
+    for (unsigned i = 0; i < args->N; ++i)
+    {
+        // Ignore invalid
+        if (args->valid[i] == 0)
+            continue;
 
-    // Ignore invalid
-    if (args->valid[0] == 0)
-        return;
+        const unsigned rayIndex = RTCRayN_id(args->ray, args->N, i);
+        const RTCHit hit = rtcGetHitFromHitN(args->hit, args->N, i);
 
-    // Ignore if LOD
-    const RaytracerGeometry& hitGeometry = (*ctx.geometryIndex_)[hit.geomID];
-    if (hitGeometry.lodIndex_ != 0)
-        args->valid[0] = 0;
+        // Ignore if LOD
+        const RaytracerGeometry& hitGeometry = (*ctx.geometryIndex_)[hit.geomID];
+        if (hitGeometry.lodIndex_ != 0)
+            args->valid[i] = 0;
 
-    // Accumulate and ignore if transparent
-    if (IsTransparedForDirect(hitGeometry, hit, *ctx.incomingLight_))
-        args->valid[0] = 0;
+        // Accumulate and ignore if transparent
+        if (IsTransparedForDirect(hitGeometry, hit, ctx.incomingLight_[rayIndex]))
+            args->valid[i] = 0;
+    }
 }
 
 /// Ray generator for directional light.
@@ -404,17 +468,15 @@ struct ChartDirectTracingKernel
     bool bakeIndirect_{};
     unsigned lightMask_{};
 
-    /// Current smooth interpolated normal.
-    Vector3 currentSmoothNormal_;
-    /// Current geometry ID.
-    unsigned currentGeometryId_;
-
-    /// Accumulated light.
-    Vector3 accumulatedLight_;
+    /// Current geometry.
+    const RaytracerGeometry* currentGeometry_{};
 
     /// Return number of elements to trace.
     unsigned GetNumElements() const { return bakedDirect_->directLight_.size(); }
 
+    /// Return width of elements grid.
+    unsigned GetGridWidth() const { return bakedDirect_->lightmapSize_; }
+
     /// Return number of samples.
     unsigned GetNumSamples() const { return numSamples_; }
 
@@ -426,51 +488,41 @@ struct ChartDirectTracingKernel
     {
         DirectTracingContextForCharts rayContext;
         rtcInitIntersectContext(&rayContext);
+        rayContext.flags = RTC_INTERSECT_CONTEXT_FLAG_COHERENT;
         rayContext.geometryIndex_ = raytracerGeometries_;
         rayContext.filter = TracingFilterForChartsDirect;
         return rayContext;
     }
 
     /// Begin tracing element.
-    bool BeginElement(unsigned elementIndex, DirectTracingContextForCharts& rayContext, Vector3& position)
+    bool BeginElement(unsigned elementIndex, Vector3& position)
     {
         const unsigned geometryId = geometryBuffer_->geometryIds_[elementIndex];
         const unsigned objectLightMask = geometryBuffer_->lightMasks_[elementIndex];
         if (!geometryId || (objectLightMask & lightMask_) == 0)
             return false;
 
-        // Initialize per-element data in ray context
+        // Initialize per-element data
         const unsigned raytracerGeometryId = (*geometryBufferToRaytracer_)[geometryId];
-        rayContext.currentGeometry_ = &(*raytracerGeometries_)[raytracerGeometryId];
-
-        // Initialize current geometry data
-        const Vector3& faceNormal = geometryBuffer_->faceNormals_[elementIndex];
+        currentGeometry_ = &(*raytracerGeometries_)[raytracerGeometryId];
         position = geometryBuffer_->positions_[elementIndex];
 
-        // Initialize per-element state
-        currentSmoothNormal_ = geometryBuffer_->smoothNormals_[elementIndex];
-        currentGeometryId_ = geometryId;
-
-        accumulatedLight_ = Vector3::ZERO;
-
         return true;
     };
 
-    /// Begin sample.
-    void BeginSample(unsigned /*sampleIndex*/) {}
-
-    /// End sample.
-    void EndSample(const Vector3& light, const Vector3& direction)
+    /// Begin sample traced by given ray in packet.
+    void BeginSample(unsigned rayIndex, DirectTracingContextForCharts& rayContext)
     {
-        const float intensity = ea::max(0.0f, currentSmoothNormal_.DotProduct(direction));
-        accumulatedLight_ += light * intensity;
+        rayContext.currentGeometries_[rayIndex] = currentGeometry_;
     }
 
-    /// End tracing element.
-    void EndElement(unsigned elementIndex)
+    /// End sample. Samples of the element may be finished after other elements are started.
+    void EndSample(unsigned elementIndex, const Vector3& light, const Vector3& direction)
     {
+        const Vector3& smoothNormal = geometryBuffer_->smoothNormals_[elementIndex];
+        const float intensity = ea::max(0.0f, smoothNormal.DotProduct(direction));
         const float weight = 1.0f / numSamples_;
-        const Vector3 directLight = accumulatedLight_ * weight;
+        const Vector3 directLight = light * (intensity * weight);
 
         if (bakeDirect_)
             bakedDirect_->directLight_[elementIndex] += directLight;
@@ -500,12 +552,12 @@ struct LightProbeDirectTracingKernel
     bool bakeDirect_{};
     unsigned lightMask_{};
 
-    /// Accumulated light SH.
-    SphericalHarmonicsColor9 accumulatedLightSH_;
-
     /// Return number of elements to trace.
     unsigned GetNumElements() const { return bakedData_->Size(); }
 
+    /// Return width of elements grid. Light probes are traced in linear order.
+    unsigned GetGridWidth() const { return TracingTileWidth; }
+
     /// Return number of samples.
     unsigned GetNumSamples() const { return numSamples_; }
 
@@ -517,107 +569,122 @@ struct LightProbeDirectTracingKernel
     {
         DirectTracingContextForLightProbes rayContext;
         rtcInitIntersectContext(&rayContext);
+        rayContext.flags = RTC_INTERSECT_CONTEXT_FLAG_COHERENT;
         rayContext.geometryIndex_ = raytracerGeometries_;
         rayContext.filter = TracingFilterForLightProbesDirect;
         return rayContext;
     }
 
     /// Begin tracing element.
-    bool BeginElement(unsigned elementIndex, DirectTracingContextForLightProbes& /*rayContext*/, Vector3& position)
+    bool BeginElement(unsigned elementIndex, Vector3& position)
     {
         const unsigned probeLightMask = collection_->lightMasks_[elementIndex];
         if ((probeLightMask & lightMask_) == 0)
             return false;
 
         position = collection_->worldPositions_[elementIndex];
-
-        accumulatedLightSH_ = {};
-
         return true;
     };
 
-    /// Begin sample. Return position, normal and initial ray direction.
-    void BeginSample(unsigned /*sampleIndex*/)
-    {
-    }
-
-    /// End sample.
-    void EndSample(const Vector3& light, const Vector3& direction)
+    /// Begin sample traced by given ray in packet.
+    void BeginSample(unsigned /*rayIndex*/, DirectTracingContextForLightProbes& /*rayContext*/)
     {
-        accumulatedLightSH_ += SphericalHarmonicsColor9(direction, light);
     }
 
-    /// End tracing element.
-    void EndElement(unsigned elementIndex)
+    /// End sample. Samples of the element may be finished after other elements are started.
+    void EndSample(unsigned elementIndex, const Vector3& light, const Vector3& direction)
     {
         if (bakeDirect_)
         {
             const float weight = M_PI / numSamples_;
-
-            const SphericalHarmonicsDot9 sh{ accumulatedLightSH_ * weight };
+            const SphericalHarmonicsDot9 sh{ SphericalHarmonicsColor9(direction, light) * weight };
             bakedData_->sphericalHarmonics_[elementIndex] += sh;
         }
     }
 };
 
+/// Packet of rays for direct light tracing.
+struct DirectRayPacket
+{
+    /// Rays and hits.
+    RTCRayHit4 rayHit_;
+    /// Ray validity mask.
+    alignas(16) int valid_[RayPacketSize]{};
+    /// Number of rays in packet.
+    unsigned size_{};
+
+    /// Per-ray data
+    /// @{
+    unsigned elementIndices_[RayPacketSize]{};
+    Vector3 incomingLight_[RayPacketSize];
+    Vector3 incomingLightDirections_[RayPacketSize];
+    /// @}
+};
+
 /// Trace direct lighting.
+/// Samples of nearby elements are traced together in packets of coherent rays.
 template <class T, class U>
 void TraceDirectLight(T sharedKernel, U sharedGenerator,
     const RaytracerScene& raytracerScene, const DirectLightTracingSettings& settings)
 {
     RTCScene scene = raytracerScene.GetEmbreeScene();
-    const ea::vector<RaytracerGeometry>& raytracerGeometries = raytracerScene.GetGeometries();
+    const unsigned numElements = sharedKernel.GetNumElements();
+    const unsigned gridWidth = sharedKernel.GetGridWidth();
 
-    ParallelFor(sharedKernel.GetNumElements(), settings.numTasks_,
-        [&](unsigned fromIndex, unsigned toIndex)
+    ParallelFor(GetNumTileRows(numElements, gridWidth), settings.numTasks_,
+        [&](unsigned fromTileRow, unsigned toTileRow)
     {
         auto kernel = sharedKernel;
         auto generator = sharedGenerator;
 
+        DirectRayPacket packet;
         auto rayContext = sharedKernel.GetRayContext();
+        rayContext.incomingLight_ = packet.incomingLight_;
 
-        Vector3 incomingLightIntensity;
-        rayContext.incomingLight_ = &incomingLightIntensity;
+        const auto tracePacket = [&]()
+        {
+            for (unsigned i = 0; i < RayPacketSize; ++i)
+                packet.valid_[i] = i < packet.size_ ? -1 : 0;
 
-        RTCRayHit rayHit;
-        rayHit.ray.mask = sharedKernel.GetGeometryMask();
-        rayHit.ray.tnear = 0.0f;
-        rayHit.ray.time = 0.0f;
-        rayHit.ray.id = 0;
-        rayHit.ray.flags = 0;
+            rtcIntersect4(packet.valid_, scene, &rayContext, &packet.rayHit_);
+
+            for (unsigned i = 0; i < packet.size_; ++i)
+            {
+                if (packet.rayHit_.hit.geomID[i] == RTC_INVALID_GEOMETRY_ID)
+                    kernel.EndSample(packet.elementIndices_[i], packet.incomingLight_[i], packet.incomingLightDirections_[i]);
+            }
+
+            packet.size_ = 0;
+        };
 
-        for (unsigned elementIndex = fromIndex; elementIndex < toIndex; ++elementIndex)
+        ForEachElementInTiles(fromTileRow, toTileRow, numElements, gridWidth,
+            [&](unsigned elementIndex)
         {
             Vector3 position;
-            if (!kernel.BeginElement(elementIndex, rayContext, position))
-                continue;
+            if (!kernel.BeginElement(elementIndex, position))
+                return;
 
             for (unsigned sampleIndex = 0; sampleIndex < kernel.GetNumSamples(); ++sampleIndex)
             {
-                kernel.BeginSample(sampleIndex);
+                const unsigned rayIndex = packet.size_;
 
                 Vector3 rayOffset;
-                Vector3 incomingLightDirection;
-                if (!generator.Generate(position, rayOffset, incomingLightIntensity, incomingLightDirection))
+                if (!generator.Generate(position, rayOffset,
+                    packet.incomingLight_[rayIndex], packet.incomingLightDirections_[rayIndex]))
                     continue;
 
-                // Cast direct ray
-                rayHit.ray.dir_x = rayOffset.x_;
-                rayHit.ray.dir_y = rayOffset.y_;
-                rayHit.ray.dir_z = rayOffset.z_;
-                rayHit.ray.org_x = position.x_ - rayOffset.x_;
-                rayHit.ray.org_y = position.y_ - rayOffset.y_;
-                rayHit.ray.org_z = position.z_ - rayOffset.z_;
-                rayHit.ray.tfar = 1.0f;
-                rayHit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
-                rtcIntersect1(scene, &rayContext, &rayHit);
+                // Queue direct ray
+                kernel.BeginSample(rayIndex, rayContext);
+                packet.elementIndices_[rayIndex] = elementIndex;
+                SetPacketRay(packet.rayHit_, rayIndex, position - rayOffset, rayOffset, 1.0f, kernel.GetGeometryMask());
 
-                if (rayHit.hit.geomID == RTC_INVALID_GEOMETRY_ID)
-                    kernel.EndSample(incomingLightIntensity, incomingLightDirection);
+                if (++packet.size_ == RayPacketSize)
+                    tracePacket();
             }
+        });
 
-            kernel.EndElement(elementIndex);
-        }
+        if (packet.size_ > 0)
+            tracePacket();
     });
 }
 
@@ -632,17 +699,18 @@ struct IndirectTracingContext : public RTCIntersectContext
 void TracingFilterIndirect(const RTCFilterFunctionNArguments* args)
 {
     const auto& ctx = *static_cast<const IndirectTracingContext*>(args->context);
-    auto& hit = *reinterpret_cast<RTCHit*>(args->hit);
-    assert(args->N == 1);
-
-    // Ignore invalid
-    if (args->valid[0] == 0)
-        return;
-
-    // Ignore if transparent
-    const RaytracerGeometry& hitGeometry = (*ctx.geometryIndex_)[hit.geomID];
-    if (IsTransparentForIndirect(hitGeometry, hit))
-        args->valid[0] = 0;
+    for (unsigned i = 0; i < args->N; ++i)
+    {
+        // Ignore invalid
+        if (args->valid[i] == 0)
+            continue;
+
+        // Ignore if transparent
+        const RTCHit hit = rtcGetHitFromHitN(args->hit, args->N, i);
+        const RaytracerGeometry& hitGeometry = (*ctx.geometryIndex_)[hit.geomID];
+        if (IsTransparentForIndirect(hitGeometry, hit))
+            args->valid[i] = 0;
+    }
 }
 
 /// Indirect light tracing for charts: tracing kernel.
@@ -674,17 +742,12 @@ struct ChartIndirectTracingKernel
     unsigned lightProbesMeshHint_{};
     /// @}
 
-    /// Static within sample:
-    /// @{
-    Vector3 currentSampleDirection_;
-    /// @}
-
-    /// Accumulated indirect light value.
-    Vector4 accumulatedIndirectLight_;
-
     /// Return number of elements to trace.
     unsigned GetNumElements() const { return bakedIndirect_->light_.size(); }
 
+    /// Return width of elements grid.
+    unsigned GetGridWidth() const { return bakedIndirect_->lightmapSize_; }
+
     /// Return number of samples.
     unsigned GetNumSamples() const { return settings_->maxSamples_; }
 
@@ -714,8 +777,6 @@ struct ChartIndirectTracingKernel
             return false;
         }
 
-        accumulatedIndirectLight_ = Vector4::ZERO;
-
         return true;
     };
 
@@ -729,20 +790,13 @@ struct ChartIndirectTracingKernel
         faceNormal = currentFaceNormal_;
         smoothNormal = currentSmoothNormal_;
         albedo = Vector3::ONE;
-        currentSampleDirection_ = RandomHemisphereDirectionCos(currentFaceNormal_);
-        rayDirection = currentSampleDirection_;
-    }
-
-    /// End sample.
-    void EndSample(const Vector3& light)
-    {
-        accumulatedIndirectLight_ += Vector4{light, 1.0f};
+        rayDirection = RandomHemisphereDirectionCos(currentFaceNormal_);
     }
 
-    /// End tracing element.
-    void EndElement(unsigned elementIndex)
+    /// End sample. Samples of the element may be finished after other elements are started.
+    void EndSample(unsigned elementIndex, const Vector3& /*sampleDirection*/, const Vector3& light)
     {
-        bakedIndirect_->light_[elementIndex] += accumulatedIndirectLight_;
+        bakedIndirect_->light_[elementIndex] += Vector4{light, 1.0f};
     }
 };
 
@@ -760,15 +814,12 @@ struct LightProbeIndirectTracingKernel
     Vector3 currentPosition_;
     unsigned backgroundId_{};
 
-    /// Current sample direction.
-    Vector3 currentSampleDirection_;
-
-    /// Accumulated indirect light (SH).
-    SphericalHarmonicsColor9 accumulatedLightSH_;
-
     /// Return number of elements to trace.
     unsigned GetNumElements() const { return bakedData_->Size(); }
 
+    /// Return width of elements grid. Light probes are traced in linear order.
+    unsigned GetGridWidth() const { return TracingTileWidth; }
+
     /// Return number of samples.
     unsigned GetNumSamples() const { return settings_->maxSamples_; }
 
@@ -777,8 +828,6 @@ struct LightProbeIndirectTracingKernel
     {
         currentPosition_ = collection_->worldPositions_[elementIndex];
         backgroundId_ = collection_->backgroundIds_[elementIndex];
-
-        accumulatedLightSH_ = {};
         return true;
     };
 
@@ -788,39 +837,61 @@ struct LightProbeIndirectTracingKernel
     void BeginSample(unsigned /*sampleIndex*/,
         Vector3& position, Vector3& faceNormal, Vector3& smoothNormal, Vector3& rayDirection, Vector3& albedo)
     {
-        RandomDirection3(currentSampleDirection_);
+        Vector3 sampleDirection;
+        RandomDirection3(sampleDirection);
 
         position = currentPosition_;
-        faceNormal = currentSampleDirection_;
-        smoothNormal = currentSampleDirection_;
-        rayDirection = currentSampleDirection_;
+        faceNormal = sampleDirection;
+        smoothNormal = sampleDirection;
+        rayDirection = sampleDirection;
         albedo = Vector3::ONE;
     }
 
-    /// End sample.
-    void EndSample(const Vector3& light)
-    {
-        accumulatedLightSH_ += SphericalHarmonicsColor9(currentSampleDirection_, light);
-    }
-
-    /// End tracing element.
-    void EndElement(unsigned elementIndex)
+    /// End sample. Samples of the element may be finished after other elements are started.
+    void EndSample(unsigned elementIndex, const Vector3& sampleDirection, const Vector3& light)
     {
         const float weight = 4.0f * M_PI / GetNumSamples();
-        const SphericalHarmonicsDot9 sh{ accumulatedLightSH_ * weight };
+        const SphericalHarmonicsDot9 sh{ SphericalHarmonicsColor9(sampleDirection, light) * weight };
         bakedData_->sphericalHarmonics_[elementIndex] += sh;
     }
 };
 
+/// Packet of rays for indirect light tracing. Each ray follows its own path until it's terminated.
+struct IndirectRayPacket
+{
+    /// Rays and hits.
+    RTCRayHit4 rayHit_;
+    /// Ray validity mask. Ray is valid while its path is not terminated.
+    alignas(16) int valid_[RayPacketSize]{};
+    /// Number of rays in packet.
+    unsigned size_{};
+
+    /// Per-path data
+    /// @{
+    unsigned elementIndices_[RayPacketSize]{};
+    unsigned backgroundIndices_[RayPacketSize]{};
+    unsigned numBounces_[RayPacketSize]{};
+    Vector3 sampleDirections_[RayPacketSize];
+    Vector3 positions_[RayPacketSize];
+    Vector3 rayDirections_[RayPacketSize];
+    Vector3 incomingFactors_[RayPacketSize];
+    Vector3 sampleColors_[RayPacketSize];
+    /// @}
+};
+
 /// Trace indirect lighting.
+/// Samples are traced together in packets, one bounce of all paths at a time.
 template <class T>
 void TraceIndirectLight(T sharedKernel, const ea::vector<const LightmapChartBakedDirect*>& bakedDirect,
     const RaytracerScene& raytracerScene, const IndirectLightTracingSettings& settings)
 {
     assert(settings.maxBounces_ <= IndirectLightTracingSettings::MaxBounces);
 
-    ParallelFor(sharedKernel.GetNumElements(), settings.numTasks_,
-        [&](unsigned fromIndex, unsigned toIndex)
+    const unsigned numElements = sharedKernel.GetNumElements();
+    const unsigned gridWidth = sharedKernel.GetGridWidth();
+
+    ParallelFor(GetNumTileRows(numElements, gridWidth), settings.numTasks_,
+        [&](unsigned fromTileRow, unsigned toTileRow)
     {
         T kernel = sharedKernel;
 
@@ -829,106 +900,134 @@ void TraceIndirectLight(T sharedKernel, const ea::vector<const LightmapChartBake
         const auto& geometryIndex = raytracerScene.GetGeometries();
         const auto& backgrounds = raytracerScene.GetBackgrounds();
 
-        RTCRayHit rayHit;
+        IndirectRayPacket packet;
         IndirectTracingContext rayContext;
         rtcInitIntersectContext(&rayContext);
         rayContext.geometryIndex_ = &geometryIndex;
         rayContext.filter = TracingFilterIndirect;
 
-        rayHit.ray.tnear = 0.0f;
-        rayHit.ray.time = 0.0f;
-        rayHit.ray.id = 0;
-        rayHit.ray.mask = RaytracerScene::PrimaryLODGeometry;
-        rayHit.ray.flags = 0;
+        // Process hit of the ray. Return true if the path should be continued.
+        const auto processHit = [&](unsigned i)
+        {
+            const RTCRayHit4& rayHit = packet.rayHit_;
+            const Vector3& rayDirection = packet.rayDirections_[i];
+            Vector3& sampleColor = packet.sampleColors_[i];
+            Vector3& incomingFactor = packet.incomingFactors_[i];
+
+            // If hit background, pick light and break
+            if (rayHit.hit.geomID[i] == RTC_INVALID_GEOMETRY_ID)
+            {
+                const BakedSceneBackground& background = (*backgrounds)[packet.backgroundIndices_[i]];
+                sampleColor += incomingFactor * background.SampleLinear(rayDirection);
+                return false;
+            }
+
+            // Check normal orientation
+            const Vector3 hitNormal{ rayHit.hit.Ng_x[i], rayHit.hit.Ng_y[i], rayHit.hit.Ng_z[i] };
+            if (rayDirection.DotProduct(hitNormal) > 0.0f)
+                return false;
+
+            // Sample lightmap UV
+            const RaytracerGeometry& geometry = geometryIndex[rayHit.hit.geomID[i]];
+            Vector2 lightmapUV;
+            rtcInterpolate0(geometry.embreeGeometry_, rayHit.hit.primID[i], rayHit.hit.u[i], rayHit.hit.v[i],
+                RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE, RaytracerScene::LightmapUVAttribute, &lightmapUV.x_, 2);
+
+            // Modify incoming flux
+            const unsigned lightmapIndex = geometry.lightmapIndex_;
+            const IntVector2 sampleLocation = bakedDirect[lightmapIndex]->GetNearestLocation(lightmapUV);
+            sampleColor += incomingFactor * bakedDirect[lightmapIndex]->GetSurfaceLight(sampleLocation);
+            ++packet.numBounces_[i];
+
+            if (packet.numBounces_[i] >= settings.maxBounces_)
+                return false;
+
+            // Update albedo for hit surface
+            incomingFactor *= bakedDirect[lightmapIndex]->GetAlbedo(sampleLocation);
+
+            // Move to hit position
+            Vector3& position = packet.positions_[i];
+            position += rayDirection * rayHit.ray.tfar[i];
+
+            // Offset position a bit
+            const Vector3 normalizedHitNormal = hitNormal.Normalized();
+            const float bias = settings.scaledPositionBounceBias_ * CalculateBiasScale(position);
+            position.x_ += Sign(normalizedHitNormal.x_) * bias + normalizedHitNormal.x_ * settings.constPositionBounceBias_;
+            position.y_ += Sign(normalizedHitNormal.y_) * bias + normalizedHitNormal.y_ * settings.constPositionBounceBias_;
+            position.z_ += Sign(normalizedHitNormal.z_) * bias + normalizedHitNormal.z_ * settings.constPositionBounceBias_;
+
+            // Find new direction to sample
+            packet.rayDirections_[i] = RandomHemisphereDirectionCos(normalizedHitNormal);
+            return true;
+        };
 
-        for (unsigned elementIndex = fromIndex; elementIndex < toIndex; ++elementIndex)
+        const auto tracePacket = [&]()
         {
-            if (!kernel.BeginElement(elementIndex))
-                continue;
+            for (unsigned i = 0; i < RayPacketSize; ++i)
+                packet.valid_[i] = i < packet.size_ ? -1 : 0;
 
-            const BakedSceneBackground& background = (*backgrounds)[kernel.GetElementBackgroundIndex()];
-            for (unsigned sampleIndex = 0; sampleIndex < kernel.GetNumSamples(); ++sampleIndex)
+            bool hasActiveRays = true;
+            while (hasActiveRays)
             {
-                Vector3 currentPosition;
-                Vector3 currentFaceNormal;
-                Vector3 currentSmoothNormal;
-                Vector3 currentRayDirection;
-                Vector3 sampleColor;
-                Vector3 incomingFactor;
-                kernel.BeginSample(sampleIndex,
-                    currentPosition, currentFaceNormal, currentSmoothNormal, currentRayDirection, incomingFactor);
-
-                int numBounces = 0;
-                for (unsigned bounceIndex = 0; bounceIndex < settings.maxBounces_; ++bounceIndex)
+                for (unsigned i = 0; i < packet.size_; ++i)
                 {
-                    rayHit.ray.org_x = currentPosition.x_;
-                    rayHit.ray.org_y = currentPosition.y_;
-                    rayHit.ray.org_z = currentPosition.z_;
-                    rayHit.ray.dir_x = currentRayDirection.x_;
-                    rayHit.ray.dir_y = currentRayDirection.y_;
-                    rayHit.ray.dir_z = currentRayDirection.z_;
-                    rayHit.ray.tfar = maxDistance;
-                    rayHit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
-                    rtcIntersect1(scene, &rayContext, &rayHit);
-
-                    // If hit background, pick light and break
-                    if (rayHit.hit.geomID == RTC_INVALID_GEOMETRY_ID)
+                    if (packet.valid_[i])
                     {
-                        sampleColor += incomingFactor * background.SampleLinear(currentRayDirection);
-                        ++numBounces;
-                        break;
+                        SetPacketRay(packet.rayHit_, i, packet.positions_[i], packet.rayDirections_[i],
+                            maxDistance, RaytracerScene::PrimaryLODGeometry);
                     }
+                }
 
-                    // Check normal orientation
-                    if (currentRayDirection.DotProduct({ rayHit.hit.Ng_x, rayHit.hit.Ng_y, rayHit.hit.Ng_z }) > 0.0f)
-                        break;
-
-                    // Sample lightmap UV
-                    const RaytracerGeometry& geometry = geometryIndex[rayHit.hit.geomID];
-                    Vector2 lightmapUV;
-                    rtcInterpolate0(geometry.embreeGeometry_, rayHit.hit.primID, rayHit.hit.u, rayHit.hit.v,
-                        RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE, RaytracerScene::LightmapUVAttribute, &lightmapUV.x_, 2);
+                rtcIntersect4(packet.valid_, scene, &rayContext, &packet.rayHit_);
 
-                    // Modify incoming flux
-                    const unsigned lightmapIndex = geometry.lightmapIndex_;
-                    const IntVector2 sampleLocation = bakedDirect[lightmapIndex]->GetNearestLocation(lightmapUV);
-                    sampleColor += incomingFactor * bakedDirect[lightmapIndex]->GetSurfaceLight(sampleLocation);
-                    ++numBounces;
+                hasActiveRays = false;
+                for (unsigned i = 0; i < packet.size_; ++i)
+                {
+                    if (!packet.valid_[i])
+                        continue;
 
-                    // Go to next hemisphere
-                    if (numBounces < settings.maxBounces_)
-                    {
-                        // Update albedo for hit surface
-                        incomingFactor *= bakedDirect[lightmapIndex]->GetAlbedo(sampleLocation);
-
-                        // Move to hit position
-                        currentPosition.x_ = rayHit.ray.org_x + rayHit.ray.dir_x * rayHit.ray.tfar;
-                        currentPosition.y_ = rayHit.ray.org_y + rayHit.ray.dir_y * rayHit.ray.tfar;
-                        currentPosition.z_ = rayHit.ray.org_z + rayHit.ray.dir_z * rayHit.ray.tfar;
-
-                        // Offset position a bit
-                        const Vector3 hitNormal = Vector3(rayHit.hit.Ng_x, rayHit.hit.Ng_y, rayHit.hit.Ng_z).Normalized();
-                        const float bias = settings.scaledPositionBounceBias_ * CalculateBiasScale(currentPosition);
-                        currentPosition.x_ += Sign(hitNormal.x_) * bias + hitNormal.x_ * settings.constPositionBounceBias_;
-                        currentPosition.y_ += Sign(hitNormal.y_) * bias + hitNormal.y_ * settings.constPositionBounceBias_;
-                        currentPosition.z_ += Sign(hitNormal.z_) * bias + hitNormal.z_ * settings.constPositionBounceBias_;
-
-                        // Update smooth normal
-                        rtcInterpolate0(geometry.embreeGeometry_, rayHit.hit.primID, rayHit.hit.u, rayHit.hit.v,
-                            RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE, RaytracerScene::NormalAttribute, &currentSmoothNormal.x_, 3);
-                        currentSmoothNormal = currentSmoothNormal.Normalized();
-
-                        // Update face normal and find new direction to sample
-                        currentFaceNormal = hitNormal;
-                        currentRayDirection = RandomHemisphereDirectionCos(currentFaceNormal);
-                    }
+                    if (processHit(i))
+                        hasActiveRays = true;
+                    else
+                        packet.valid_[i] = 0;
                 }
+            }
 
-                // Accumulate samples
-                kernel.EndSample(sampleColor);
+            for (unsigned i = 0; i < packet.size_; ++i)
+                kernel.EndSample(packet.elementIndices_[i], packet.sampleDirections_[i], packet.sampleColors_[i]);
+
+            packet.size_ = 0;
+        };
+
+        ForEachElementInTiles(fromTileRow, toTileRow, numElements, gridWidth,
+            [&](unsigned elementIndex)
+        {
+            if (!kernel.BeginElement(elementIndex))
+                return;
+
+            for (unsigned sampleIndex = 0; sampleIndex < kernel.GetNumSamples(); ++sampleIndex)
+            {
+                const unsigned rayIndex = packet.size_;
+
+                Vector3 faceNormal;
+                Vector3 smoothNormal;
+                kernel.BeginSample(sampleIndex, packet.positions_[rayIndex], faceNormal, smoothNormal,
+                    packet.rayDirections_[rayIndex], packet.incomingFactors_[rayIndex]);
+
+                // Queue path
+                packet.elementIndices_[rayIndex] = elementIndex;
+                packet.backgroundIndices_[rayIndex] = kernel.GetElementBackgroundIndex();
+                packet.numBounces_[rayIndex] = 0;
+                packet.sampleDirections_[rayIndex] = packet.rayDirections_[rayIndex];
+                packet.sampleColors_[rayIndex] = Vector3::ZERO;
+
+                if (++packet.size_ == RayPacketSize)
+                    tracePacket();
             }
-            kernel.EndElement(elementIndex);
-        }
+        });
+
+        if (packet.size_ > 0)
+            tracePacket();
     });
 }
 
@@ -28,6 +28,10 @@
 
 #include <EASTL/span.h>
 
+#ifdef URHO3D_SSE
+    #include <emmintrin.h>
+#endif
+
 namespace Urho3D
 {
 
@@ -141,18 +145,397 @@ void FilterArray(const ea::vector<T>& input, ea::vector<T>& output,
     });
 }
 
+/// Radius of a-trous kernel in taps.
+static const int ATrousRadius = 2;
+/// Weights of a-trous B3 spline kernel.
+static const float ATrousKernel[ATrousRadius + 1] = { 3.0f / 8.0f, 1.0f / 4.0f, 1.0f / 16.0f };
+
+/// Return number of a-trous passes needed to cover given kernel radius.
+unsigned GetNumATrousPasses(int kernelRadius)
+{
+    unsigned numPasses = 0;
+    for (int coveredRadius = 0; coveredRadius < kernelRadius; coveredRadius += ATrousRadius << numPasses)
+        ++numPasses;
+    return numPasses;
+}
+
+/// Geometry buffer data used by a-trous filter, in SoA layout.
+struct ATrousGuide
+{
+    /// Size of the lightmap.
+    int size_{};
+    /// Texel positions.
+    ea::vector<float> positions_[3];
+    /// Texel normals.
+    ea::vector<float> normals_[3];
+    /// 1 for texels covered by geometry, 0 otherwise.
+    ea::vector<float> masks_;
+};
+
+/// Color data filtered by a-trous filter, in SoA layout.
+template <unsigned N>
+struct ATrousColor
+{
+    /// Color channels.
+    ea::vector<float> channels_[N];
+    /// Color luminance.
+    ea::vector<float> luminances_;
+
+    /// Resize buffer.
+    void Resize(unsigned size)
+    {
+        for (ea::vector<float>& channel : channels_)
+            channel.resize(size);
+        luminances_.resize(size);
+    }
+
+    /// Update luminance of texel.
+    void UpdateLuminance(unsigned index)
+    {
+        luminances_[index] = Color{ channels_[0][index], channels_[1][index], channels_[2][index] }.Luma();
+    }
+};
+
+/// Parameters of single a-trous pass.
+struct ATrousPassParameters
+{
+    /// Distance between taps in texels.
+    int step_{};
+    /// Inverse luminance sigma.
+    float invLuminanceSigma_{};
+    /// Inverse position sigma for each tap offset.
+    float invPositionSigmas_[ATrousRadius + 1][ATrousRadius + 1]{};
+    /// Normal power.
+    float normalPower_{};
+};
+
+/// Initialize a-trous guide from geometry buffer.
+void InitializeATrousGuide(ATrousGuide& guide, const LightmapChartGeometryBuffer& geometryBuffer)
+{
+    const unsigned numTexels = geometryBuffer.positions_.size();
+    guide.size_ = static_cast<int>(geometryBuffer.lightmapSize_);
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        guide.positions_[i].resize(numTexels);
+        guide.normals_[i].resize(numTexels);
+    }
+    guide.masks_.resize(numTexels);
+
+    for (unsigned index = 0; index < numTexels; ++index)
+    {
+        const Vector3& position = geometryBuffer.positions_[index];
+        const Vector3& normal = geometryBuffer.smoothNormals_[index];
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            guide.positions_[i][index] = position.Data()[i];
+            guide.normals_[i][index] = normal.Data()[i];
+        }
+        guide.masks_[index] = geometryBuffer.geometryIds_[index] != 0 ? 1.0f : 0.0f;
+    }
+}
+
+/// Apply a-trous filter to single texel.
+template <unsigned N>
+void FilterTexelATrous(const ATrousColor<N>& input, ATrousColor<N>& output,
+    const ATrousGuide& guide, const ATrousPassParameters& pass, int x, int y)
+{
+    const int index = y * guide.size_ + x;
+    if (guide.masks_[index] == 0.0f)
+    {
+        for (unsigned c = 0; c < N; ++c)
+            output.channels_[c][index] = 0.0f;
+        output.luminances_[index] = 0.0f;
+        return;
+    }
+
+    const float centerLuminance = input.luminances_[index];
+    const Vector3 centerPosition{ guide.positions_[0][index], guide.positions_[1][index], guide.positions_[2][index] };
+    const Vector3 centerNormal{ guide.normals_[0][index], guide.normals_[1][index], guide.normals_[2][index] };
+
+    float colorSum[N]{};
+    float weightSum = 0.0f;
+    for (int dy = -ATrousRadius; dy <= ATrousRadius; ++dy)
+    {
+        const int otherY = y + dy * pass.step_;
+        if (otherY < 0 || otherY >= guide.size_)
+            continue;
+
+        for (int dx = -ATrousRadius; dx <= ATrousRadius; ++dx)
+        {
+            const int otherX = x + dx * pass.step_;
+            if (otherX < 0 || otherX >= guide.size_)
+                continue;
+
+            const int otherIndex = otherY * guide.size_ + otherX;
+            if (guide.masks_[otherIndex] == 0.0f)
+                continue;
+
+            const Vector3 otherPosition{
+                guide.positions_[0][otherIndex], guide.positions_[1][otherIndex], guide.positions_[2][otherIndex] };
+            const Vector3 otherNormal{
+                guide.normals_[0][otherIndex], guide.normals_[1][otherIndex], guide.normals_[2][otherIndex] };
+
+            // Taps with (almost) orthogonal or opposite normals are ignored, same as in SIMD version
+            const float normalDot = centerNormal.DotProduct(otherNormal);
+            if (normalDot <= M_LARGE_EPSILON)
+                continue;
+
+            const float colorWeight = Abs(centerLuminance - input.luminances_[otherIndex]) * pass.invLuminanceSigma_;
+            const float positionWeight = (centerPosition - otherPosition).LengthSquared()
+                * pass.invPositionSigmas_[Abs(dy)][Abs(dx)];
+            const float normalWeight = Pow(normalDot, pass.normalPower_);
+            const float weight = std::exp(0.0f - colorWeight - positionWeight) * normalWeight
+                * ATrousKernel[Abs(dx)] * ATrousKernel[Abs(dy)];
+
+            for (unsigned c = 0; c < N; ++c)
+                colorSum[c] += input.channels_[c][otherIndex] * weight;
+            weightSum += weight;
+        }
+    }
+
+    const float invWeightSum = 1.0f / ea::max(M_EPSILON, weightSum);
+    for (unsigned c = 0; c < N; ++c)
+        output.channels_[c][index] = colorSum[c] * invWeightSum;
+    output.UpdateLuminance(index);
+}
+
+#ifdef URHO3D_SSE
+/// Binary logarithm of e.
+static const float Log2E = 1.44269504f;
+
+/// Approximate 2^x for 4 values.
+inline __m128 FastExp2(__m128 x)
+{
+    x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-126.0f)), _mm_set1_ps(126.0f));
+
+    // Split into integer and fractional parts
+    __m128 integerPart = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+    integerPart = _mm_sub_ps(integerPart, _mm_and_ps(_mm_cmpgt_ps(integerPart, x), _mm_set1_ps(1.0f)));
+    const __m128 fractionalPart = _mm_sub_ps(x, integerPart);
+
+    // Polynomial approximation of 2^x on [0, 1)
+    __m128 result = _mm_set1_ps(1.8775767e-3f);
+    result = _mm_add_ps(_mm_mul_ps(result, fractionalPart), _mm_set1_ps(8.9893397e-3f));
+    result = _mm_add_ps(_mm_mul_ps(result, fractionalPart), _mm_set1_ps(5.5826318e-2f));
+    result = _mm_add_ps(_mm_mul_ps(result, fractionalPart), _mm_set1_ps(2.4015361e-1f));
+    result = _mm_add_ps(_mm_mul_ps(result, fractionalPart), _mm_set1_ps(6.9315308e-1f));
+    result = _mm_add_ps(_mm_mul_ps(result, fractionalPart), _mm_set1_ps(9.9999994e-1f));
+
+    const __m128i exponent = _mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(integerPart), _mm_set1_epi32(127)), 23);
+    return _mm_mul_ps(result, _mm_castsi128_ps(exponent));
+}
+
+/// Approximate log2(x) for 4 positive normalized values.
+inline __m128 FastLog2(__m128 x)
+{
+    const __m128i bits = _mm_castps_si128(x);
+    const __m128 exponent = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)));
+    const __m128 mantissa = _mm_or_ps(
+        _mm_castsi128_ps(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF))), _mm_set1_ps(1.0f));
+
+    // Polynomial approximation of log2(x) / (x - 1) on [1, 2)
+    __m128 result = _mm_set1_ps(0.0596515482674574969533f);
+    result = _mm_add_ps(_mm_mul_ps(result, mantissa), _mm_set1_ps(-0.465725644288844778798f));
+    result = _mm_add_ps(_mm_mul_ps(result, mantissa), _mm_set1_ps(1.48116647521213171641f));
+    result = _mm_add_ps(_mm_mul_ps(result, mantissa), _mm_set1_ps(-2.52074962577807006663f));
+    result = _mm_add_ps(_mm_mul_ps(result, mantissa), _mm_set1_ps(2.8882704548164776201f));
+    result = _mm_mul_ps(result, _mm_sub_ps(mantissa, _mm_set1_ps(1.0f)));
+    return _mm_add_ps(result, exponent);
+}
+
+/// Apply a-trous filter to 4 consecutive texels in the row. All taps should be inside the row.
+template <unsigned N>
+void FilterTexelsATrousSSE(const ATrousColor<N>& input, ATrousColor<N>& output,
+    const ATrousGuide& guide, const ATrousPassParameters& pass, int x, int y)
+{
+    const int index = y * guide.size_ + x;
+
+    const __m128 centerMask = _mm_cmpgt_ps(_mm_loadu_ps(&guide.masks_[index]), _mm_setzero_ps());
+    const __m128 centerLuminance = _mm_loadu_ps(&input.luminances_[index]);
+    const __m128 centerPositionX = _mm_loadu_ps(&guide.positions_[0][index]);
+    const __m128 centerPositionY = _mm_loadu_ps(&guide.positions_[1][index]);
+    const __m128 centerPositionZ = _mm_loadu_ps(&guide.positions_[2][index]);
+    const __m128 centerNormalX = _mm_loadu_ps(&guide.normals_[0][index]);
+    const __m128 centerNormalY = _mm_loadu_ps(&guide.normals_[1][index]);
+    const __m128 centerNormalZ = _mm_loadu_ps(&guide.normals_[2][index]);
+
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 minNormalDot = _mm_set1_ps(M_LARGE_EPSILON);
+    const __m128 invLuminanceSigma = _mm_set1_ps(pass.invLuminanceSigma_ * Log2E);
+    const __m128 normalPower = _mm_set1_ps(pass.normalPower_);
+
+    __m128 colorSum[N];
+    for (unsigned c = 0; c < N; ++c)
+        colorSum[c] = _mm_setzero_ps();
+    __m128 weightSum = _mm_setzero_ps();
+
+    for (int dy = -ATrousRadius; dy <= ATrousRadius; ++dy)
+    {
+        const int otherY = y + dy * pass.step_;
+        if (otherY < 0 || otherY >= guide.size_)
+            continue;
+
+        for (int dx = -ATrousRadius; dx <= ATrousRadius; ++dx)
+        {
+            const int otherIndex = otherY * guide.size_ + x + dx * pass.step_;
+
+            const __m128 deltaX = _mm_sub_ps(centerPositionX, _mm_loadu_ps(&guide.positions_[0][otherIndex]));
+            const __m128 deltaY = _mm_sub_ps(centerPositionY, _mm_loadu_ps(&guide.positions_[1][otherIndex]));
+            const __m128 deltaZ = _mm_sub_ps(centerPositionZ, _mm_loadu_ps(&guide.positions_[2][otherIndex]));
+            const __m128 distanceSquared = _mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(deltaX, deltaX), _mm_mul_ps(deltaY, deltaY)), _mm_mul_ps(deltaZ, deltaZ));
+
+            const __m128 normalDot = _mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(centerNormalX, _mm_loadu_ps(&guide.normals_[0][otherIndex])),
+                _mm_mul_ps(centerNormalY, _mm_loadu_ps(&guide.normals_[1][otherIndex]))),
+                _mm_mul_ps(centerNormalZ, _mm_loadu_ps(&guide.normals_[2][otherIndex])));
+
+            const __m128 luminanceDelta = _mm_and_ps(absMask,
+                _mm_sub_ps(centerLuminance, _mm_loadu_ps(&input.luminances_[otherIndex])));
+
+            // exp(-a - b) * pow(dot, p) is evaluated as single 2^x
+            const __m128 invPositionSigma = _mm_set1_ps(pass.invPositionSigmas_[Abs(dy)][Abs(dx)] * Log2E);
+            const __m128 exponent = _mm_sub_ps(
+                _mm_mul_ps(normalPower, FastLog2(_mm_max_ps(normalDot, minNormalDot))),
+                _mm_add_ps(_mm_mul_ps(luminanceDelta, invLuminanceSigma), _mm_mul_ps(distanceSquared, invPositionSigma)));
+
+            const __m128 kernel = _mm_set1_ps(ATrousKernel[Abs(dx)] * ATrousKernel[Abs(dy)]);
+            const __m128 otherMask = _mm_loadu_ps(&guide.masks_[otherIndex]);
+            const __m128 validMask = _mm_cmpgt_ps(normalDot, minNormalDot);
+            const __m128 weight = _mm_and_ps(validMask, _mm_mul_ps(_mm_mul_ps(FastExp2(exponent), kernel), otherMask));
+
+            for (unsigned c = 0; c < N; ++c)
+                colorSum[c] = _mm_add_ps(colorSum[c], _mm_mul_ps(_mm_loadu_ps(&input.channels_[c][otherIndex]), weight));
+            weightSum = _mm_add_ps(weightSum, weight);
+        }
+    }
+
+    const __m128 invWeightSum = _mm_and_ps(centerMask,
+        _mm_div_ps(_mm_set1_ps(1.0f), _mm_max_ps(weightSum, _mm_set1_ps(M_EPSILON))));
+    for (unsigned c = 0; c < N; ++c)
+        _mm_storeu_ps(&output.channels_[c][index], _mm_mul_ps(colorSum[c], invWeightSum));
+
+    const __m128 luminance = _mm_add_ps(_mm_add_ps(
+        _mm_mul_ps(_mm_loadu_ps(&output.channels_[0][index]), _mm_set1_ps(0.299f)),
+        _mm_mul_ps(_mm_loadu_ps(&output.channels_[1][index]), _mm_set1_ps(0.587f))),
+        _mm_mul_ps(_mm_loadu_ps(&output.channels_[2][index]), _mm_set1_ps(0.114f)));
+    _mm_storeu_ps(&output.luminances_[index], luminance);
+}
+#endif
+
+/// Apply a-trous filter pass to all texels.
+template <unsigned N>
+void FilterPassATrous(const ATrousColor<N>& input, ATrousColor<N>& output,
+    const ATrousGuide& guide, const ATrousPassParameters& pass, bool useSIMD, unsigned numTasks)
+{
+    ParallelFor(guide.size_, numTasks,
+        [&](unsigned fromRow, unsigned toRow)
+    {
+        for (int y = static_cast<int>(fromRow); y < static_cast<int>(toRow); ++y)
+        {
+            int x = 0;
+#ifdef URHO3D_SSE
+            // Process texels whose taps are all inside the row in groups of 4
+            if (useSIMD)
+            {
+                const int margin = ATrousRadius * pass.step_;
+                for (; x < margin && x < guide.size_; ++x)
+                    FilterTexelATrous(input, output, guide, pass, x, y);
+                for (; x + 4 <= guide.size_ - margin; x += 4)
+                    FilterTexelsATrousSSE(input, output, guide, pass, x, y);
+            }
+#endif
+            for (; x < guide.size_; ++x)
+                FilterTexelATrous(input, output, guide, pass, x, y);
+        }
+    });
+}
+
+/// Apply edge stopping a-trous filter to array.
+template <class T>
+void FilterArrayATrous(const ea::vector<T>& input, ea::vector<T>& output,
+    const LightmapChartGeometryBuffer& geometryBuffer,
+    const EdgeStoppingGaussFilterParameters& params, unsigned numTasks)
+{
+    static constexpr unsigned N = sizeof(T) / sizeof(float);
+    const unsigned numTexels = input.size();
+
+    ATrousGuide guide;
+    InitializeATrousGuide(guide, geometryBuffer);
+
+    // Convert input to SoA layout
+    ATrousColor<N> buffers[2];
+    buffers[0].Resize(numTexels);
+    buffers[1].Resize(numTexels);
+    for (unsigned index = 0; index < numTexels; ++index)
+    {
+        for (unsigned c = 0; c < N; ++c)
+            buffers[0].channels_[c][index] = input[index].Data()[c];
+        buffers[0].UpdateLuminance(index);
+    }
+
+    // Apply passes with growing step
+    const unsigned numPasses = GetNumATrousPasses(params.kernelRadius_);
+    for (unsigned passIndex = 0; passIndex < numPasses; ++passIndex)
+    {
+        ATrousPassParameters pass;
+        pass.step_ = (1 << passIndex) * ea::max(1, params.upscale_);
+        pass.invLuminanceSigma_ = 1.0f / params.luminanceSigma_;
+        pass.normalPower_ = params.normalPower_;
+        for (int dy = 0; dy <= ATrousRadius; ++dy)
+        {
+            for (int dx = 0; dx <= ATrousRadius; ++dx)
+            {
+                const float positionSigma = Vector2{ static_cast<float>(dx), static_cast<float>(dy) }.Length()
+                    * static_cast<float>(1 << passIndex) * params.positionSigma_;
+                pass.invPositionSigmas_[dy][dx] = positionSigma > M_EPSILON ? 1.0f / positionSigma : 0.0f;
+            }
+        }
+
+        FilterPassATrous(buffers[passIndex % 2], buffers[(passIndex + 1) % 2], guide, pass, params.useSIMD_, numTasks);
+    }
+
+    // Convert output to AoS layout
+    const ATrousColor<N>& result = buffers[numPasses % 2];
+    for (unsigned index = 0; index < numTexels; ++index)
+    {
+        float* value = &output[index].x_;
+        for (unsigned c = 0; c < N; ++c)
+            value[c] = guide.masks_[index] != 0.0f ? result.channels_[c][index] : 0.0f;
+    }
+}
+
+/// Apply edge stopping filter to array.
+template <class T>
+void FilterArrayWithMethod(const ea::vector<T>& input, ea::vector<T>& output,
+    const LightmapChartGeometryBuffer& geometryBuffer,
+    const EdgeStoppingGaussFilterParameters& params, unsigned numTasks)
+{
+    switch (params.method_)
+    {
+    case LightmapFilterMethod::ATrous:
+        FilterArrayATrous(input, output, geometryBuffer, params, numTasks);
+        break;
+
+    case LightmapFilterMethod::Gauss:
+    default:
+        FilterArray(input, output, geometryBuffer, params, numTasks);
+        break;
+    }
+}
+
 }
 
 void FilterDirectLight(const LightmapChartBakedDirect& bakedDirect, ea::vector<Vector3>& outputBuffer,
     const LightmapChartGeometryBuffer& geometryBuffer, const EdgeStoppingGaussFilterParameters& params, unsigned numTasks)
 {
-    FilterArray(bakedDirect.directLight_, outputBuffer, geometryBuffer, params, numTasks);
+    FilterArrayWithMethod(bakedDirect.directLight_, outputBuffer, geometryBuffer, params, numTasks);
 }
 
 void FilterIndirectLight(const LightmapChartBakedIndirect& bakedIndirect, ea::vector<Vector4>& outputBuffer,
     const LightmapChartGeometryBuffer& geometryBuffer, const EdgeStoppingGaussFilterParameters& params, unsigned numTasks)
 {
-    FilterArray(bakedIndirect.light_, outputBuffer, geometryBuffer, params, numTasks);
+    FilterArrayWithMethod(bakedIndirect.light_, outputBuffer, geometryBuffer, params, numTasks);
 }
 
 }
@@ -29,11 +29,15 @@
 #include "../Graphics/TerrainPatch.h"
 #include "../Glow/RaytracerScene.h"
 #include "../Glow/Helpers.h"
+#include "../IO/Deserializer.h"
 #include "../IO/Log.h"
+#include "../IO/Serializer.h"
 
 #include <embree3/rtcore.h>
 #include <embree3/rtcore_ray.h>
 
+#include <EASTL/fixed_vector.h>
+
 #include <future>
 
 using namespace embree3;
@@ -341,7 +345,7 @@ RTCGeometry CreateEmbreeGeometryForTerrain(RTCDevice embreeDevice, const Raytrac
     }
 
     unsigned* indices = reinterpret_cast<unsigned*>(rtcSetNewGeometryBuffer(embreeGeometry, RTC_BUFFER_TYPE_INDEX,
-        0, RTC_FORMAT_UINT3, sizeof(unsigned) * 3, numQuads * 2 * 3));
+        0, RTC_FORMAT_UINT3, sizeof(unsigned) * 3, numQuads * 2));
 
     const unsigned maxZ = numPatches.y_ * patchSize;
     const unsigned maxX = numPatches.x_ * patchSize;
@@ -416,6 +420,10 @@ ea::vector<RaytracerGeometry> CreateRaytracerGeometriesForStaticModel(RTCDevice
             params.lightmapping_.primaryLod_ = lodIndex == 0;
 
             raytracerGeometry.embreeGeometry_ = CreateEmbreeGeometryForGeometryView(embreeDevice, params);
+            raytracerGeometry.numVertices_ = geometryLODView.vertices_.size();
+            raytracerGeometry.numTriangles_ = geometryLODView.indices_.size() / 3;
+            raytracerGeometry.mask_ = params.lightmapping_.GetMask();
+            raytracerGeometry.hasLightmapUVsAndNormals_ = params.lightmapping_.AreLightmapUVsAndNormalsNeeded();
             result.push_back(raytracerGeometry);
         }
     }
@@ -457,10 +465,103 @@ ea::vector<RaytracerGeometry> CreateRaytracerGeometriesForTerrain(RTCDevice embr
     params.terrain_ = terrain;
     params.material_ = raytracerGeometry.material_;
 
+    const IntVector2 terrainSize = terrain->GetNumVertices();
+    const IntVector2 numPatches = terrain->GetNumPatches();
+    const int patchSize = terrain->GetPatchSize();
+
     raytracerGeometry.embreeGeometry_ = CreateEmbreeGeometryForTerrain(embreeDevice, params);
+    raytracerGeometry.numVertices_ = static_cast<unsigned>(terrainSize.x_ * terrainSize.y_);
+    raytracerGeometry.numTriangles_ = static_cast<unsigned>(numPatches.x_ * numPatches.y_ * patchSize * patchSize * 2);
+    raytracerGeometry.mask_ = params.lightmapping_.GetMask();
+    raytracerGeometry.hasLightmapUVsAndNormals_ = params.lightmapping_.AreLightmapUVsAndNormalsNeeded();
     return { raytracerGeometry };
 }
 
+
+/// Load diffuse images of raytracer geometries.
+void LoadDiffuseImages(Context* context, ea::vector<RaytracerGeometry>& geometries)
+{
+    ea::hash_map<ea::string, SharedPtr<Image>> diffuseImages;
+    for (const RaytracerGeometry& raytracerGeometry : geometries)
+        diffuseImages[raytracerGeometry.material_.diffuseImageName_] = nullptr;
+
+    auto cache = context->GetSubsystem<ResourceCache>();
+    for (auto& nameAndImage : diffuseImages)
+    {
+        if (!nameAndImage.first.empty())
+        {
+            auto image = cache->GetResource<Image>(nameAndImage.first);
+            nameAndImage.second = image->GetDecompressedImage();
+        }
+    }
+
+    for (RaytracerGeometry& raytracerGeometry : geometries)
+    {
+        raytracerGeometry.material_.diffuseImage_ = diffuseImages[raytracerGeometry.material_.diffuseImageName_];
+        if (raytracerGeometry.material_.diffuseImage_)
+        {
+            raytracerGeometry.material_.diffuseImageWidth_ = raytracerGeometry.material_.diffuseImage_->GetWidth();
+            raytracerGeometry.material_.diffuseImageHeight_ = raytracerGeometry.material_.diffuseImage_->GetHeight();
+        }
+    }
+}
+
+/// Description of Embree geometry buffer.
+struct EmbreeBufferDesc
+{
+    RTCBufferType type_{};
+    unsigned slot_{};
+    RTCFormat format_{};
+    unsigned elementSize_{};
+    unsigned numElements_{};
+};
+
+/// Return descriptions of all Embree buffers of the geometry.
+ea::fixed_vector<EmbreeBufferDesc, 5> GetEmbreeBuffers(const RaytracerGeometry& raytracerGeometry)
+{
+    const unsigned numVertices = raytracerGeometry.numVertices_;
+
+    ea::fixed_vector<EmbreeBufferDesc, 5> result;
+    result.push_back({RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vector3), numVertices});
+    if (raytracerGeometry.hasLightmapUVsAndNormals_)
+    {
+        result.push_back({RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE, RaytracerScene::LightmapUVAttribute, RTC_FORMAT_FLOAT2,
+            sizeof(Vector2), numVertices});
+        result.push_back({RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE, RaytracerScene::NormalAttribute, RTC_FORMAT_FLOAT3,
+            sizeof(Vector3), numVertices});
+    }
+    if (raytracerGeometry.material_.storeUV_)
+    {
+        result.push_back({RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE, RaytracerScene::UVAttribute, RTC_FORMAT_FLOAT2,
+            sizeof(Vector2), numVertices});
+    }
+    result.push_back({RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, sizeof(unsigned) * 3,
+        raytracerGeometry.numTriangles_});
+    return result;
+}
+
+void WriteRaytracingGeometryMaterial(Serializer& dest, const RaytracingGeometryMaterial& material)
+{
+    dest.WriteBool(material.opaque_);
+    dest.WriteVector3(material.diffuseColor_);
+    dest.WriteFloat(material.alpha_);
+    dest.WriteBool(material.storeUV_);
+    dest.WriteVector4(material.uOffset_);
+    dest.WriteVector4(material.vOffset_);
+    dest.WriteString(material.diffuseImageName_);
+}
+
+void ReadRaytracingGeometryMaterial(Deserializer& source, RaytracingGeometryMaterial& material)
+{
+    material.opaque_ = source.ReadBool();
+    material.diffuseColor_ = source.ReadVector3();
+    material.alpha_ = source.ReadFloat();
+    material.storeUV_ = source.ReadBool();
+    material.uOffset_ = source.ReadVector4();
+    material.vOffset_ = source.ReadVector4();
+    material.diffuseImageName_ = source.ReadString();
+}
+
 }
 
 RaytracerScene::~RaytracerScene()
@@ -471,6 +572,46 @@ RaytracerScene::~RaytracerScene()
         rtcReleaseDevice(device_);
 }
 
+RaytracerRayHit RaytracerScene::CastRay(
+    const Vector3& origin, const Vector3& direction, float maxDistance, unsigned mask) const
+{
+    RTCRayHit rayHit;
+    rayHit.ray.org_x = origin.x_;
+    rayHit.ray.org_y = origin.y_;
+    rayHit.ray.org_z = origin.z_;
+    rayHit.ray.dir_x = direction.x_;
+    rayHit.ray.dir_y = direction.y_;
+    rayHit.ray.dir_z = direction.z_;
+    rayHit.ray.tnear = 0.0f;
+    rayHit.ray.tfar = maxDistance;
+    rayHit.ray.time = 0.0f;
+    rayHit.ray.mask = mask;
+    rayHit.ray.id = 0;
+    rayHit.ray.flags = 0;
+    rayHit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+
+    RTCIntersectContext rayContext;
+    rtcInitIntersectContext(&rayContext);
+    rtcIntersect1(scene_, &rayContext, &rayHit);
+
+    RaytracerRayHit result;
+    if (rayHit.hit.geomID == RTC_INVALID_GEOMETRY_ID)
+        return result;
+
+    result.geometryId_ = rayHit.hit.geomID;
+    result.primitiveId_ = rayHit.hit.primID;
+    result.distance_ = rayHit.ray.tfar;
+    result.barycentric_ = {rayHit.hit.u, rayHit.hit.v};
+
+    const RaytracerGeometry& raytracerGeometry = geometries_[rayHit.hit.geomID];
+    if (raytracerGeometry.hasLightmapUVsAndNormals_)
+    {
+        rtcInterpolate0(raytracerGeometry.embreeGeometry_, rayHit.hit.primID, rayHit.hit.u, rayHit.hit.v,
+            RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE, LightmapUVAttribute, &result.lightmapUV_.x_, 2);
+    }
+    return result;
+}
+
 SharedPtr<RaytracerScene> CreateRaytracingScene(Context* context, const ea::vector<Component*>& geometries,
     unsigned lightmapUVChannel, const BakedSceneBackgroundArrayPtr& backgrounds)
 {
@@ -525,7 +666,6 @@ SharedPtr<RaytracerScene> CreateRaytracingScene(Context* context, const ea::vect
     }
 
     // Collect and attach Embree geometries
-    ea::hash_map<ea::string, SharedPtr<Image>> diffuseImages;
     ea::vector<RaytracerGeometry> geometryIndex;
     for (auto& task : createRaytracerGeometriesTasks)
     {
@@ -538,7 +678,6 @@ SharedPtr<RaytracerScene> CreateRaytracingScene(Context* context, const ea::vect
             geometryIndex.resize(geomID + 1);
             geometryIndex[geomID] = raytracerGeometry;
             geometryIndex[geomID].raytracerGeometryId_ = geomID;
-            diffuseImages[raytracerGeometry.material_.diffuseImageName_] = nullptr;
         }
     }
 
@@ -546,25 +685,7 @@ SharedPtr<RaytracerScene> CreateRaytracingScene(Context* context, const ea::vect
     rtcCommitScene(scene);
 
     // Load images
-    auto cache = context->GetSubsystem<ResourceCache>();
-    for (auto& nameAndImage : diffuseImages)
-    {
-        if (!nameAndImage.first.empty())
-        {
-            auto image = cache->GetResource<Image>(nameAndImage.first);
-            nameAndImage.second = image->GetDecompressedImage();
-        }
-    }
-
-    for (RaytracerGeometry& raytracerGeometry : geometryIndex)
-    {
-        raytracerGeometry.material_.diffuseImage_ = diffuseImages[raytracerGeometry.material_.diffuseImageName_];
-        if (raytracerGeometry.material_.diffuseImage_)
-        {
-            raytracerGeometry.material_.diffuseImageWidth_ = raytracerGeometry.material_.diffuseImage_->GetWidth();
-            raytracerGeometry.material_.diffuseImageHeight_ = raytracerGeometry.material_.diffuseImage_->GetHeight();
-        }
-    }
+    LoadDiffuseImages(context, geometryIndex);
 
     // Calculate max distance between objects
     BoundingBox boundingBox;
@@ -582,4 +703,88 @@ SharedPtr<RaytracerScene> CreateRaytracingScene(Context* context, const ea::vect
     return MakeShared<RaytracerScene>(context, device, scene, ea::move(geometryIndex), backgrounds, maxDistance);
 }
 
+void WriteRaytracingScene(Serializer& dest, const RaytracerScene& raytracerScene)
+{
+    const ea::vector<RaytracerGeometry>& geometries = raytracerScene.GetGeometries();
+    dest.WriteFloat(raytracerScene.GetMaxDistance());
+    dest.WriteVLE(geometries.size());
+    for (const RaytracerGeometry& raytracerGeometry : geometries)
+    {
+        dest.WriteUInt(raytracerGeometry.objectIndex_);
+        dest.WriteUInt(raytracerGeometry.geometryIndex_);
+        dest.WriteUInt(raytracerGeometry.lodIndex_);
+        dest.WriteUInt(raytracerGeometry.numLods_);
+        dest.WriteUInt(raytracerGeometry.lightmapIndex_);
+        dest.WriteUInt(raytracerGeometry.numVertices_);
+        dest.WriteUInt(raytracerGeometry.numTriangles_);
+        dest.WriteUInt(raytracerGeometry.mask_);
+        dest.WriteBool(raytracerGeometry.hasLightmapUVsAndNormals_);
+        WriteRaytracingGeometryMaterial(dest, raytracerGeometry.material_);
+
+        for (const EmbreeBufferDesc& buffer : GetEmbreeBuffers(raytracerGeometry))
+        {
+            const void* data = rtcGetGeometryBufferData(raytracerGeometry.embreeGeometry_, buffer.type_, buffer.slot_);
+            dest.Write(data, buffer.elementSize_ * buffer.numElements_);
+        }
+    }
+}
+
+SharedPtr<RaytracerScene> ReadRaytracingScene(
+    Context* context, Deserializer& source, const BakedSceneBackgroundArrayPtr& backgrounds)
+{
+    const float maxDistance = source.ReadFloat();
+
+    const RTCDevice device = rtcNewDevice("");
+    const RTCScene scene = rtcNewScene(device);
+    rtcSetSceneFlags(scene, RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION);
+
+    ea::vector<RaytracerGeometry> geometryIndex(source.ReadVLE());
+    for (RaytracerGeometry& raytracerGeometry : geometryIndex)
+    {
+        raytracerGeometry.objectIndex_ = source.ReadUInt();
+        raytracerGeometry.geometryIndex_ = source.ReadUInt();
+        raytracerGeometry.lodIndex_ = source.ReadUInt();
+        raytracerGeometry.numLods_ = source.ReadUInt();
+        raytracerGeometry.lightmapIndex_ = source.ReadUInt();
+        raytracerGeometry.numVertices_ = source.ReadUInt();
+        raytracerGeometry.numTriangles_ = source.ReadUInt();
+        raytracerGeometry.mask_ = source.ReadUInt();
+        raytracerGeometry.hasLightmapUVsAndNormals_ = source.ReadBool();
+        ReadRaytracingGeometryMaterial(source, raytracerGeometry.material_);
+
+        RTCGeometry embreeGeometry = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_TRIANGLE);
+        rtcSetGeometryVertexAttributeCount(embreeGeometry, RaytracerScene::MaxAttributes);
+        for (const EmbreeBufferDesc& buffer : GetEmbreeBuffers(raytracerGeometry))
+        {
+            void* data = rtcSetNewGeometryBuffer(embreeGeometry, buffer.type_, buffer.slot_, buffer.format_,
+                buffer.elementSize_, buffer.numElements_);
+            source.Read(data, buffer.elementSize_ * buffer.numElements_);
+        }
+        rtcSetGeometryMask(embreeGeometry, raytracerGeometry.mask_);
+        rtcCommitGeometry(embreeGeometry);
+
+        // Geometries are attached to empty scene in the original order, so IDs are the same
+        raytracerGeometry.embreeGeometry_ = embreeGeometry;
+        raytracerGeometry.raytracerGeometryId_ = rtcAttachGeometry(scene, embreeGeometry);
+        rtcReleaseGeometry(embreeGeometry);
+    }
+
+    rtcCommitScene(scene);
+
+    LoadDiffuseImages(context, geometryIndex);
+
+    return MakeShared<RaytracerScene>(context, device, scene, ea::move(geometryIndex), backgrounds, maxDistance);
+}
+
+unsigned long long GetRaytracingSceneSize(const RaytracerScene& raytracerScene)
+{
+    unsigned long long size = 0;
+    for (const RaytracerGeometry& raytracerGeometry : raytracerScene.GetGeometries())
+    {
+        for (const EmbreeBufferDesc& buffer : GetEmbreeBuffers(raytracerGeometry))
+            size += buffer.elementSize_ * buffer.numElements_;
+    }
+    return size;
+}
+
 }
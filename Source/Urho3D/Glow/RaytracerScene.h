@@ -39,8 +39,10 @@ namespace Urho3D
 {
 
 class Context;
+class Deserializer;
 class Node;
 class Component;
+class Serializer;
 
 /// Material of raytracing geometry.
 struct RaytracingGeometryMaterial
@@ -102,6 +104,14 @@ struct RaytracerGeometry
     unsigned raytracerGeometryId_{};
     /// Internal geometry pointer.
     embree3::RTCGeometry embreeGeometry_{};
+    /// Number of vertices in Embree geometry.
+    unsigned numVertices_{};
+    /// Number of triangles in Embree geometry.
+    unsigned numTriangles_{};
+    /// Embree geometry mask.
+    unsigned mask_{};
+    /// Whether the lightmap UV and smooth normal attributes are stored.
+    bool hasLightmapUVsAndNormals_{};
     /// Material.
     RaytracingGeometryMaterial material_;
 };
@@ -118,6 +128,21 @@ inline bool CompareRaytracerGeometryByObject(const RaytracerGeometry& lhs, const
     return lhs.lodIndex_ < rhs.lodIndex_;
 }
 
+/// Closest hit of single ray.
+struct RaytracerRayHit
+{
+    /// Raytracer geometry ID. M_MAX_UNSIGNED if nothing is hit.
+    unsigned geometryId_{M_MAX_UNSIGNED};
+    /// Triangle index in geometry.
+    unsigned primitiveId_{};
+    /// Distance to hit in units of ray direction length.
+    float distance_{};
+    /// Barycentric coordinates of hit in triangle.
+    Vector2 barycentric_;
+    /// Lightmap UV at hit. Zero if geometry has no lightmap UVs.
+    Vector2 lightmapUV_;
+};
+
 /// Scene for ray tracing.
 class URHO3D_API RaytracerScene : public RefCounted
 {
@@ -167,6 +192,11 @@ public:
     /// Return max distance between two points.
     float GetMaxDistance() const { return maxDistance_; }
 
+    /// Trace single ray from origin to origin + direction * maxDistance and return the closest hit.
+    /// Slow for bulk queries, use Embree scene directly instead.
+    RaytracerRayHit CastRay(const Vector3& origin, const Vector3& direction, float maxDistance,
+        unsigned mask = AllGeometry) const;
+
 private:
     /// Context.
     Context* context_{};
@@ -186,4 +216,12 @@ private:
 URHO3D_API SharedPtr<RaytracerScene> CreateRaytracingScene(Context* context,
     const ea::vector<Component*>& geometries, unsigned uvChannel, const BakedSceneBackgroundArrayPtr& background);
 
+/// Write geometries of the scene for raytracing. Backgrounds are not written.
+URHO3D_API void WriteRaytracingScene(Serializer& dest, const RaytracerScene& raytracerScene);
+/// Read geometries written by WriteRaytracingScene and rebuild the scene for raytracing.
+URHO3D_API SharedPtr<RaytracerScene> ReadRaytracingScene(
+    Context* context, Deserializer& source, const BakedSceneBackgroundArrayPtr& backgrounds);
+/// Return approximate size of the geometry data of the scene for raytracing, in bytes.
+URHO3D_API unsigned long long GetRaytracingSceneSize(const RaytracerScene& raytracerScene);
+
 }
@@ -32,9 +32,21 @@
 #include "../Resource/ResourceCache.h"
 #include "../Scene/Scene.h"
 
+#ifdef URHO3D_SSE
+    #include <xmmintrin.h>
+#endif
+
 namespace Urho3D
 {
 
+namespace
+{
+
+/// Max number of cells along each axis of light probes lookup grid.
+static const unsigned LightProbesLookupGridSize = 32;
+
+}
+
 GlobalIllumination::GlobalIllumination(Context* context) :
     Component(context)
 {
@@ -95,6 +107,7 @@ void GlobalIllumination::CompileLightProbes()
 
     // Add padding to avoid vertex collision
     lightProbesMesh_.Define(collection.worldPositions_);
+    InitializeLightProbesMesh();
 
     // Store in file
     auto cache = context_->GetSubsystem<ResourceCache>();
@@ -125,6 +138,55 @@ SphericalHarmonicsDot9 GlobalIllumination::SampleAmbientSH(const Vector3& positi
     return lightProbesMesh_.Sample(lightProbesBakedData_.sphericalHarmonics_, position, hint);
 }
 
+void GlobalIllumination::SampleAmbientSH(ea::span<const Vector3> positions, ea::span<unsigned> hints,
+    ea::span<SphericalHarmonicsDot9> result) const
+{
+    static_assert(sizeof(SphericalHarmonicsDot9) == 7 * sizeof(Vector4), "Unexpected layout of SphericalHarmonicsDot9");
+
+    const unsigned numPositions = positions.size();
+    thread_local ea::vector<Vector4> weights;
+    weights.resize(numPositions);
+    lightProbesMesh_.GetInterpolationFactors(positions, hints, weights);
+
+    const auto& sphericalHarmonics = lightProbesBakedData_.sphericalHarmonics_;
+    const unsigned numTetrahedrons = lightProbesMesh_.tetrahedrons_.size();
+    for (unsigned i = 0; i < numPositions; ++i)
+    {
+        const unsigned tetIndex = hints[i];
+        if (tetIndex >= numTetrahedrons)
+        {
+            result[i] = {};
+            continue;
+        }
+
+        const Tetrahedron& tetrahedron = lightProbesMesh_.tetrahedrons_[tetIndex];
+        const unsigned numVertices = tetIndex < lightProbesMesh_.numInnerTetrahedrons_ ? 4 : 3;
+
+#ifdef URHO3D_SSE
+        __m128 values[7];
+        for (__m128& value : values)
+            value = _mm_setzero_ps();
+
+        for (unsigned j = 0; j < numVertices; ++j)
+        {
+            const __m128 weight = _mm_set1_ps(weights[i].Data()[j]);
+            const float* source = &sphericalHarmonics[tetrahedron.indices_[j]].Ar_.x_;
+            for (unsigned k = 0; k < 7; ++k)
+                values[k] = _mm_add_ps(values[k], _mm_mul_ps(_mm_loadu_ps(source + k * 4), weight));
+        }
+
+        float* destination = &result[i].Ar_.x_;
+        for (unsigned k = 0; k < 7; ++k)
+            _mm_storeu_ps(destination + k * 4, values[k]);
+#else
+        SphericalHarmonicsDot9 value{};
+        for (unsigned j = 0; j < numVertices; ++j)
+            value += sphericalHarmonics[tetrahedron.indices_[j]] * weights[i].Data()[j];
+        result[i] = value;
+#endif
+    }
+}
+
 Vector3 GlobalIllumination::SampleAverageAmbient(const Vector3& position, unsigned& hint) const
 {
     return lightProbesMesh_.Sample(lightProbesBakedData_.ambient_, position, hint);
@@ -165,7 +227,15 @@ void GlobalIllumination::ReloadData()
     {
         lightProbesMesh_ = {};
         lightProbesBakedData_.Clear();
+        return;
     }
+
+    InitializeLightProbesMesh();
+}
+
+void GlobalIllumination::InitializeLightProbesMesh()
+{
+    lightProbesMesh_.BuildLookupGrid(LightProbesLookupGridSize);
 }
 
 }
@@ -57,6 +57,9 @@ public:
 
     /// Sample ambient spherical harmonics.
     SphericalHarmonicsDot9 SampleAmbientSH(const Vector3& position, unsigned& hint) const;
+    /// Sample ambient spherical harmonics for multiple positions. Hints are updated.
+    void SampleAmbientSH(ea::span<const Vector3> positions, ea::span<unsigned> hints,
+        ea::span<SphericalHarmonicsDot9> result) const;
     /// Sample average ambient lighting.
     Vector3 SampleAverageAmbient(const Vector3& position, unsigned& hint) const;
 
@@ -76,6 +79,8 @@ public:
 private:
     /// Reload GI data.
     void ReloadData();
+    /// Initialize light probes mesh after loading.
+    void InitializeLightProbesMesh();
 
     /// Emission indirect brightness.
     float emissionBrightness_{ 1.0f };
@@ -45,9 +45,12 @@
 #include "../Graphics/OutlineGroup.h"
 #include "../Graphics/ParticleEffect.h"
 #include "../Graphics/ParticleEmitter.h"
+#include "../Graphics/PipelineStateLibrary.h"
 #include "../Graphics/ReflectionProbe.h"
 #include "../Graphics/RibbonTrail.h"
 #include "../Graphics/Shader.h"
+#include "../Graphics/ShaderCompilationQueue.h"
+#include "../Graphics/ShaderVariationManifest.h"
 #include "../Graphics/Skybox.h"
 #include "../Graphics/StaticModelGroup.h"
 #include "../Graphics/Technique.h"
@@ -114,6 +117,7 @@ Graphics::Graphics(Context* context)
     , shaderPath_("Shaders/HLSL/")
     , shaderExtension_(".hlsl")
     , apiName_("Diligent")
+    , shaderCompilationQueue_(MakeShared<ShaderCompilationQueue>(context))
 {
     // TODO: This can be used to have DPI scaling work on Windows, but it leads to blurry fonts
     // SDL_SetHint(SDL_HINT_WINDOWS_DPI_SCALING, "1");
@@ -150,6 +154,16 @@ void Graphics::Configure(const GraphicsSettings& settings)
                 fs->Delete(absoluteFileName);
         }
     }
+
+    // Keep variations recorded during previous runs
+    shaderVariationManifest_ = nullptr;
+    if (settings_.shaderManifestFile_)
+    {
+        auto vfs = GetSubsystem<VirtualFileSystem>();
+        shaderVariationManifest_ = MakeShared<ShaderVariationManifest>(context_);
+        if (vfs->Exists(settings_.shaderManifestFile_))
+            shaderVariationManifest_->LoadFile(settings_.shaderManifestFile_);
+    }
 }
 
 bool Graphics::SetScreenMode(const WindowSettings& windowSettings)
@@ -359,6 +373,17 @@ void Graphics::SavePipelineStateCache(const FileIdentifier& fileName)
         file->Write(cachedData.data(), cachedData.size());
 }
 
+void Graphics::SaveShaderVariationManifest()
+{
+    if (!shaderVariationManifest_ || !shaderVariationManifest_->IsDirty())
+        return;
+
+    if (shaderVariationManifest_->SaveFile(settings_.shaderManifestFile_))
+        shaderVariationManifest_->ResetDirty();
+    else
+        URHO3D_LOGERROR("Failed to save shader variation manifest to '{}'", settings_.shaderManifestFile_.ToUri());
+}
+
 bool Graphics::ToggleFullscreen()
 {
     ea::swap(primaryWindowSettings_, secondaryWindowSettings_);
@@ -698,7 +723,9 @@ void RegisterGraphicsLibrary(Context* context)
     Animation::RegisterObject(context);
     Material::RegisterObject(context);
     Model::RegisterObject(context);
+    PipelineStateLibrary::RegisterObject(context);
     Shader::RegisterObject(context);
+    ShaderVariationManifest::RegisterObject(context);
     Technique::RegisterObject(context);
     Texture2D::RegisterObject(context);
     Texture2DArray::RegisterObject(context);
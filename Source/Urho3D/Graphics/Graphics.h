@@ -47,7 +47,9 @@ class Image;
 class IndexBuffer;
 class RenderSurface;
 class Shader;
+class ShaderCompilationQueue;
 class ShaderVariation;
+class ShaderVariationManifest;
 class Texture;
 class Texture2D;
 class Texture2DArray;
@@ -76,6 +78,10 @@ struct GraphicsSettings : public RenderDeviceSettings
     bool discardShaderCache_{};
     /// Whether to cache shaders compiled during this run on the disk.
     bool cacheShaders_{};
+    /// Whether to compile shaders on worker threads. Pending shaders are rendered with placeholder shader.
+    bool asyncShaderCompilation_{};
+    /// File to record all requested shader variations to. Recording is disabled if empty.
+    FileIdentifier shaderManifestFile_;
 };
 
 /// %Graphics subsystem. Manages the application window, rendering state and GPU resources.
@@ -122,6 +128,8 @@ public:
     void InitializePipelineStateCache(const FileIdentifier& fileName);
     /// Save pipeline state cache.
     void SavePipelineStateCache(const FileIdentifier& fileName);
+    /// Save recorded shader variations, if recording is enabled.
+    void SaveShaderVariationManifest();
 
     /// Toggle between full screen and windowed mode. Return true if successful.
     bool ToggleFullscreen();
@@ -285,6 +293,8 @@ public:
     /// @{
     RenderBackend GetRenderBackend() const;
     const GraphicsSettings& GetSettings() const { return settings_; }
+    ShaderCompilationQueue* GetShaderCompilationQueue() const { return shaderCompilationQueue_; }
+    ShaderVariationManifest* GetShaderVariationManifest() const { return shaderVariationManifest_; }
     /// @}
 
 private:
@@ -330,6 +340,8 @@ private:
     GraphicsSettings settings_;
 
     SharedPtr<RenderDevice> renderDevice_;
+    SharedPtr<ShaderCompilationQueue> shaderCompilationQueue_;
+    SharedPtr<ShaderVariationManifest> shaderVariationManifest_;
 
     /// Max number of bones which can be skinned on GPU. Zero means default value.
     static unsigned maxBonesHWSkinned;
@@ -27,12 +27,14 @@
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
 #include "../Core/StopToken.h"
+#include "../Core/ProcessUtils.h"
 #include "../Core/Timer.h"
 #include "../Graphics/GlobalIllumination.h"
 #include "../Graphics/Octree.h"
 #include "../Graphics/Renderer.h"
 #include "../Graphics/Skybox.h"
 #include "../Graphics/Zone.h"
+#include "../IO/FileSystem.h"
 #include "../IO/Log.h"
 #include "../Scene/Scene.h"
 
@@ -55,6 +57,27 @@ static const char* qualityNames[] =
     nullptr
 };
 
+static const char* filterMethodNames[] =
+{
+    "Gauss",
+    "A-Trous",
+    nullptr
+};
+
+#if URHO3D_GLOW
+/// Create cache for intermediate baking data.
+ea::unique_ptr<BakedLightCache> CreateBakedLightCache(Context* context, const IncrementalLightBakerSettings& settings)
+{
+    if (settings.cacheMemoryLimit_ == 0)
+        return ea::make_unique<BakedLightMemoryCache>();
+
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+    const ea::string fileName = Format("{}LightBakingCache-{}.bin", fileSystem->GetTemporaryDir(), GenerateUUID());
+    const unsigned long long memoryLimit = static_cast<unsigned long long>(settings.cacheMemoryLimit_) * 1024 * 1024;
+    return ea::make_unique<BakedLightDiskCache>(fileName, memoryLimit);
+}
+#endif
+
 }
 
 /// State of async light baker task.
@@ -69,8 +92,8 @@ struct LightBaker::TaskData
 #if URHO3D_GLOW
     /// Scene collector.
     DefaultBakedSceneCollector sceneCollector_;
-    /// Memory cache
-    BakedLightMemoryCache cache_;
+    /// Intermediate data cache.
+    ea::unique_ptr<BakedLightCache> cache_;
     /// Baker.
     IncrementalLightBaker baker_;
 #endif
@@ -109,9 +132,12 @@ void LightBaker::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE("Indirect Samples (Light Probes)", unsigned, settings_.indirectProbesTracing_.maxSamples_, defaultSettings.indirectProbesTracing_.maxSamples_, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Filter Radius (Direct)", unsigned, settings_.directFilter_.kernelRadius_, defaultSettings.directFilter_.kernelRadius_, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Filter Radius (Indirect)", unsigned, settings_.indirectFilter_.kernelRadius_, defaultSettings.indirectFilter_.kernelRadius_, AM_DEFAULT);
+    URHO3D_ENUM_ATTRIBUTE("Filter Method (Direct)", settings_.directFilter_.method_, filterMethodNames, defaultSettings.directFilter_.method_, AM_DEFAULT);
+    URHO3D_ENUM_ATTRIBUTE("Filter Method (Indirect)", settings_.indirectFilter_.method_, filterMethodNames, defaultSettings.indirectFilter_.method_, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Chunk Size", Vector3, settings_.incremental_.chunkSize_, defaultSettings.incremental_.chunkSize_, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Chunk Indirect Padding", float, settings_.incremental_.indirectPadding_, defaultSettings.incremental_.indirectPadding_, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Chunk Shadow Distance", float, settings_.incremental_.directionalLightShadowDistance_, defaultSettings.incremental_.directionalLightShadowDistance_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Cache Memory Limit (MB)", unsigned, settings_.incremental_.cacheMemoryLimit_, defaultSettings.incremental_.cacheMemoryLimit_, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Stitch Iterations", unsigned, settings_.stitching_.numIterations_, defaultSettings.stitching_.numIterations_, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Constant Normal Offset", float, settings_.geometryBufferBaking_.constantPositionBias_, defaultSettings.geometryBufferBaking_.constantPositionBias_, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Position Scaled Normal Offset", float, settings_.geometryBufferBaking_.scaledPositionBias_, defaultSettings.geometryBufferBaking_.scaledPositionBias_, AM_DEFAULT);
@@ -202,7 +228,8 @@ void LightBaker::Update()
 
         auto taskData = ea::make_shared<TaskData>();
         taskData->weakSelf_ = this;
-        if (!taskData->baker_.Initialize(settings_, GetScene(), &taskData->sceneCollector_, &taskData->cache_))
+        taskData->cache_ = CreateBakedLightCache(context_, settings_.incremental_);
+        if (!taskData->baker_.Initialize(settings_, GetScene(), &taskData->sceneCollector_, taskData->cache_.get()))
         {
             URHO3D_LOGERROR("Cannot initialize light baking");
             state_ = InternalState::NotStarted;
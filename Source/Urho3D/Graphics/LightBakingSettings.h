@@ -126,6 +126,15 @@ struct IndirectLightTracingSettings
     float constPositionBounceBias_{ 0.0f };
 };
 
+/// Lightmap filtering method.
+enum class LightmapFilterMethod
+{
+    /// Dense edge-stopping Gauss kernel. Cost grows quadratically with kernel radius.
+    Gauss,
+    /// Sparse edge-stopping a-trous wavelet kernel applied in several passes with growing step.
+    ATrous,
+};
+
 /// Parameters for indirect light filtering.
 struct EdgeStoppingGaussFilterParameters
 {
@@ -139,6 +148,10 @@ struct EdgeStoppingGaussFilterParameters
     float normalPower_{ 4.0f };
     /// Position weight. The lesser value is, the more color details are preserved on position edges.
     float positionSigma_{ 1.0f };
+    /// Filtering method.
+    LightmapFilterMethod method_{ LightmapFilterMethod::Gauss };
+    /// Whether to use SIMD version of the filter when available.
+    bool useSIMD_{ true };
 };
 
 /// Lightmap stitching settings.
@@ -183,6 +196,11 @@ struct IncrementalLightBakerSettings
     /// Placeholders 1-3: x, y and z components of chunk index.
     /// Placeholder 4: light probe group index within chunk.
     ea::string lightProbeGroupNameFormat_{ "Binary/LightProbeGroup-{}-{}-{}-{}.bin" };
+    /// File with content hashes of baked chunks. Used to rebake only changed chunks.
+    ea::string chunkHashesFileName_{ "Binary/ChunkHashes.bin" };
+    /// Max size of intermediate baking data kept in memory, in megabytes.
+    /// The rest is spilled to temporary file. If zero, all data is kept in memory.
+    unsigned cacheMemoryLimit_{};
 };
 
 /// Aggregated light baking settings.
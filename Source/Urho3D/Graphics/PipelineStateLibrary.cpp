@@ -0,0 +1,314 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Graphics/PipelineStateLibrary.h"
+
+#include "Urho3D/Core/Context.h"
+#include "Urho3D/Core/CoreEvents.h"
+#include "Urho3D/Core/WorkQueue.h"
+#include "Urho3D/Graphics/Graphics.h"
+#include "Urho3D/Graphics/Shader.h"
+#include "Urho3D/Graphics/ShaderCompilationQueue.h"
+#include "Urho3D/Graphics/ShaderVariation.h"
+#include "Urho3D/IO/ArchiveSerialization.h"
+#include "Urho3D/IO/Log.h"
+#include "Urho3D/RenderAPI/RenderAPIUtils.h"
+#include "Urho3D/Resource/ResourceCache.h"
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+SharedPtr<RawShader>* GetShaderSlot(GraphicsPipelineStateDesc& desc, ShaderType type)
+{
+    switch (type)
+    {
+    case VS: return &desc.vertexShader_;
+    case PS: return &desc.pixelShader_;
+    case GS: return &desc.geometryShader_;
+    case HS: return &desc.hullShader_;
+    case DS: return &desc.domainShader_;
+    default: return nullptr;
+    }
+}
+
+bool HasPendingShaders(const GraphicsPipelineStateDesc& desc)
+{
+    for (RawShader* shader : {desc.vertexShader_, desc.pixelShader_, desc.domainShader_, desc.hullShader_,
+             desc.geometryShader_})
+    {
+        if (shader && shader->IsCompilationPending())
+            return true;
+    }
+    return false;
+}
+
+} // namespace
+
+ea::optional<PipelineStateLibraryEntry> PipelineStateLibraryEntry::FromDesc(const GraphicsPipelineStateDesc& desc)
+{
+    PipelineStateLibraryEntry entry;
+    entry.desc_ = desc;
+
+    for (ShaderType type : {VS, PS, GS, HS, DS})
+    {
+        SharedPtr<RawShader>& shader = *GetShaderSlot(entry.desc_, type);
+        if (!shader)
+            continue;
+
+        const auto shaderVariation = dynamic_cast<ShaderVariation*>(shader.Get());
+        Shader* owner = shaderVariation ? shaderVariation->GetOwner() : nullptr;
+        if (!owner)
+            return ea::nullopt;
+
+        entry.shaders_.push_back({owner->GetName(), type, shaderVariation->GetDefines()});
+        shader = nullptr;
+    }
+
+    return entry;
+}
+
+ea::optional<GraphicsPipelineStateDesc> PipelineStateLibraryEntry::ToDesc(Context* context) const
+{
+    auto cache = context->GetSubsystem<ResourceCache>();
+
+    GraphicsPipelineStateDesc desc = desc_;
+    for (const ShaderVariationManifestEntry& shaderEntry : shaders_)
+    {
+        SharedPtr<RawShader>* slot = GetShaderSlot(desc, shaderEntry.type_);
+        auto shader = cache->GetResource<Shader>(shaderEntry.shaderName_);
+        if (!slot || !shader)
+            return ea::nullopt;
+
+        *slot = shader->GetVariation(shaderEntry.type_, shaderEntry.defines_);
+    }
+
+    if (!desc.IsInitialized())
+        return ea::nullopt;
+
+    return desc;
+}
+
+void PipelineStateLibraryEntry::SerializeInBlock(Archive& archive)
+{
+    SerializeValue(archive, "name", desc_.debugName_);
+
+    SerializeValue(archive, "colorWriteEnabled", desc_.colorWriteEnabled_);
+    SerializeValue(archive, "blendMode", desc_.blendMode_);
+    SerializeValue(archive, "alphaToCoverageEnabled", desc_.alphaToCoverageEnabled_);
+
+    SerializeValue(archive, "fillMode", desc_.fillMode_);
+    SerializeValue(archive, "cullMode", desc_.cullMode_);
+    SerializeValue(archive, "constantDepthBias", desc_.constantDepthBias_);
+    SerializeValue(archive, "slopeScaledDepthBias", desc_.slopeScaledDepthBias_);
+    SerializeValue(archive, "scissorTestEnabled", desc_.scissorTestEnabled_);
+    SerializeValue(archive, "lineAntiAlias", desc_.lineAntiAlias_);
+
+    SerializeValue(archive, "depthWriteEnabled", desc_.depthWriteEnabled_);
+    SerializeValue(archive, "stencilTestEnabled", desc_.stencilTestEnabled_);
+    SerializeValue(archive, "depthCompareFunction", desc_.depthCompareFunction_);
+    SerializeValue(archive, "stencilCompareFunction", desc_.stencilCompareFunction_);
+    SerializeValue(archive, "stencilOperationOnPassed", desc_.stencilOperationOnPassed_);
+    SerializeValue(archive, "stencilOperationOnStencilFailed", desc_.stencilOperationOnStencilFailed_);
+    SerializeValue(archive, "stencilOperationOnDepthFailed", desc_.stencilOperationOnDepthFailed_);
+    SerializeValue(archive, "stencilCompareMask", desc_.stencilCompareMask_);
+    SerializeValue(archive, "stencilWriteMask", desc_.stencilWriteMask_);
+
+    SerializeValue(archive, "inputLayout", desc_.inputLayout_);
+    SerializeValue(archive, "primitiveType", desc_.primitiveType_);
+    SerializeValue(archive, "output", desc_.output_);
+    SerializeValue(archive, "samplers", desc_.samplers_);
+    SerializeValue(archive, "readOnlyDepth", desc_.readOnlyDepth_);
+
+    SerializeValue(archive, "shaders", shaders_);
+}
+
+unsigned PipelineStateLibraryEntry::ToHash() const
+{
+    unsigned hash = desc_.ToHash();
+    for (const ShaderVariationManifestEntry& shaderEntry : shaders_)
+        CombineHash(hash, shaderEntry.ToHash());
+    return hash;
+}
+
+PipelineStateLibrary::PipelineStateLibrary(Context* context)
+    : SimpleResource(context)
+    , finishedStates_(MakeShared<FinishedPipelineStates>())
+{
+}
+
+PipelineStateLibrary::~PipelineStateLibrary()
+{
+    ReleaseWarmedPipelineStates();
+}
+
+void PipelineStateLibrary::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<PipelineStateLibrary>();
+}
+
+bool PipelineStateLibrary::AddPipelineState(const GraphicsPipelineStateDesc& desc)
+{
+    auto entry = PipelineStateLibraryEntry::FromDesc(desc);
+    if (!entry || !index_.insert(*entry).second)
+        return false;
+
+    entries_.push_back(ea::move(*entry));
+    return true;
+}
+
+void PipelineStateLibrary::Clear()
+{
+    entries_.clear();
+    index_.clear();
+}
+
+void PipelineStateLibrary::StartRecording()
+{
+    auto pipelineStateCache = GetSubsystem<PipelineStateCache>();
+    if (isRecording_ || !pipelineStateCache)
+        return;
+
+    pipelineStateCache->OnPipelineStateCreated.Subscribe(this, &PipelineStateLibrary::OnPipelineStateCreated);
+    isRecording_ = true;
+}
+
+void PipelineStateLibrary::StopRecording()
+{
+    auto pipelineStateCache = GetSubsystem<PipelineStateCache>();
+    if (!isRecording_ || !pipelineStateCache)
+        return;
+
+    pipelineStateCache->OnPipelineStateCreated.Unsubscribe(this);
+    isRecording_ = false;
+}
+
+void PipelineStateLibrary::OnPipelineStateCreated(PipelineState* pipelineState)
+{
+    if (const GraphicsPipelineStateDesc* desc = pipelineState->GetDesc().AsGraphics())
+        AddPipelineState(*desc);
+}
+
+void PipelineStateLibrary::StartWarmup()
+{
+    if (!GetSubsystem<PipelineStateCache>())
+        return;
+
+    for (const PipelineStateLibraryEntry& entry : entries_)
+    {
+        if (auto desc = entry.ToDesc(context_))
+            pendingStates_.push_back(ea::move(*desc));
+        else
+            URHO3D_LOGWARNING("Cannot warm up pipeline state '{}' because shaders are missing", entry.desc_.debugName_);
+    }
+
+    SubscribeToEvent(E_BEGINFRAME, [this] { UpdateWarmup(); });
+    ScheduleReadyStates();
+}
+
+void PipelineStateLibrary::UpdateWarmup()
+{
+    AttachFinishedStates();
+    ScheduleReadyStates();
+
+    if (!IsWarmupInProgress())
+        UnsubscribeFromEvent(E_BEGINFRAME);
+}
+
+void PipelineStateLibrary::CompleteWarmup()
+{
+    auto workQueue = GetSubsystem<WorkQueue>();
+    auto graphics = GetSubsystem<Graphics>();
+
+    while (IsWarmupInProgress())
+    {
+        if (graphics)
+            graphics->GetShaderCompilationQueue()->CompleteAll();
+        workQueue->CompleteAll();
+        UpdateWarmup();
+    }
+}
+
+void PipelineStateLibrary::ReleaseWarmedPipelineStates()
+{
+    pendingStates_.clear();
+
+    // Pipeline states should be released on the main thread
+    if (numStatesInProgress_ > 0)
+    {
+        auto workQueue = GetSubsystem<WorkQueue>();
+        workQueue->CompleteAll();
+        AttachFinishedStates();
+    }
+
+    warmedStates_.clear();
+    UnsubscribeFromEvent(E_BEGINFRAME);
+}
+
+void PipelineStateLibrary::ScheduleReadyStates()
+{
+    auto workQueue = GetSubsystem<WorkQueue>();
+    auto pipelineStateCache = GetSubsystem<PipelineStateCache>();
+    const bool isThreaded = pipelineStateCache->IsThreadedCreationSupported();
+
+    const auto isScheduled = [&](const GraphicsPipelineStateDesc& desc)
+    {
+        if (HasPendingShaders(desc))
+            return false;
+
+        if (!isThreaded)
+        {
+            warmedStates_.push_back(pipelineStateCache->GetGraphicsPipelineState(desc));
+            return true;
+        }
+
+        ++numStatesInProgress_;
+        auto task = [pipelineStateCache, finishedStates = finishedStates_, desc = PipelineStateDesc{desc}]()
+        {
+            SharedPtr<PipelineState> pipelineState = pipelineStateCache->CreateDetachedPipelineState(desc);
+
+            MutexLock lock(finishedStates->mutex_);
+            finishedStates->items_.push_back(ea::move(pipelineState));
+        };
+        workQueue->PostTask(ea::move(task), TaskPriority::Low);
+        return true;
+    };
+
+    ea::erase_if(pendingStates_, isScheduled);
+}
+
+void PipelineStateLibrary::AttachFinishedStates()
+{
+    auto pipelineStateCache = GetSubsystem<PipelineStateCache>();
+
+    {
+        MutexLock lock(finishedStates_->mutex_);
+        ea::swap(finishedStatesBuffer_, finishedStates_->items_);
+    }
+
+    for (PipelineState* pipelineState : finishedStatesBuffer_)
+    {
+        warmedStates_.push_back(pipelineStateCache->AttachPipelineState(pipelineState));
+        --numStatesInProgress_;
+    }
+
+    // Duplicate pipeline states are destroyed here
+    finishedStatesBuffer_.clear();
+}
+
+void PipelineStateLibrary::SerializeInBlock(Archive& archive)
+{
+    SerializeOptionalValue(archive, "pipelineStates", entries_);
+
+    if (archive.IsInput())
+        RemoveDuplicateEntries(entries_, index_);
+}
+
+} // namespace Urho3D
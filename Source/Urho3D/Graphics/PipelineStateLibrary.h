@@ -0,0 +1,123 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Core/Mutex.h"
+#include "Urho3D/Graphics/ShaderVariationManifest.h"
+#include "Urho3D/RenderAPI/PipelineState.h"
+#include "Urho3D/Resource/Resource.h"
+
+#include <EASTL/unordered_set.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+/// Graphics pipeline state description that can be saved to file.
+/// Shaders are referenced by resource name and defines instead of GPU objects.
+struct URHO3D_API PipelineStateLibraryEntry
+{
+    /// Pipeline state description without shaders.
+    GraphicsPipelineStateDesc desc_;
+    /// Shader variations used by pipeline state.
+    ea::vector<ShaderVariationManifestEntry> shaders_;
+
+    /// Create entry from pipeline state description. Return nullopt if any shader is not a ShaderVariation.
+    static ea::optional<PipelineStateLibraryEntry> FromDesc(const GraphicsPipelineStateDesc& desc);
+    /// Create pipeline state description. Shaders are loaded from resource cache.
+    /// Return nullopt if any shader cannot be loaded.
+    ea::optional<GraphicsPipelineStateDesc> ToDesc(Context* context) const;
+
+    void SerializeInBlock(Archive& archive);
+
+    /// Operators.
+    /// @{
+    auto Tie() const { return ea::tie(desc_, shaders_); }
+    bool operator==(const PipelineStateLibraryEntry& rhs) const { return Tie() == rhs.Tie(); }
+    bool operator!=(const PipelineStateLibraryEntry& rhs) const { return Tie() != rhs.Tie(); }
+    unsigned ToHash() const;
+    /// @}
+};
+
+/// Collection of graphics pipeline states used by the application, e.g. while rendering specific scene.
+/// Pipeline states are recorded when created by PipelineStateCache and can be recreated in worker threads later,
+/// so rendering of the first frames doesn't stall on pipeline state creation.
+///
+/// Typical usage is to record one library per scene and to warm it up while the scene is loading.
+class URHO3D_API PipelineStateLibrary : public SimpleResource
+{
+    URHO3D_OBJECT(PipelineStateLibrary, SimpleResource);
+
+public:
+    explicit PipelineStateLibrary(Context* context);
+    ~PipelineStateLibrary() override;
+    static void RegisterObject(Context* context);
+
+    /// Add pipeline state to the library. Duplicates are ignored. Return true if the state was added.
+    bool AddPipelineState(const GraphicsPipelineStateDesc& desc);
+    /// Remove all pipeline states.
+    void Clear();
+
+    /// Start recording of all graphics pipeline states created by PipelineStateCache.
+    void StartRecording();
+    /// Stop recording of pipeline states.
+    void StopRecording();
+
+    /// Start creation of all pipeline states in the library. Shader variations are requested immediately.
+    /// Pipeline states are created in worker threads if supported by the backend and in the main thread otherwise.
+    /// Created pipeline states are kept alive until ReleaseWarmedPipelineStates is called.
+    void StartWarmup();
+    /// Add finished pipeline states to the cache and start creation of states whose shaders are ready.
+    /// Called automatically at the beginning of the frame during warmup.
+    void UpdateWarmup();
+    /// Wait until all pipeline states are created. Should be called from the main thread.
+    void CompleteWarmup();
+    /// Release pipeline states created by warmup.
+    /// Pipeline states still used by renderer stay in the cache.
+    void ReleaseWarmedPipelineStates();
+
+    /// Return pipeline states in order of addition.
+    const ea::vector<PipelineStateLibraryEntry>& GetEntries() const { return entries_; }
+    /// Return whether the library is recording new pipeline states.
+    bool IsRecording() const { return isRecording_; }
+    /// Return whether the warmup is in progress.
+    bool IsWarmupInProgress() const { return !pendingStates_.empty() || numStatesInProgress_ > 0; }
+    /// Return number of pipeline states created by warmup so far.
+    unsigned GetNumWarmedPipelineStates() const { return warmedStates_.size(); }
+
+    /// Implement SimpleResource.
+    /// @{
+    void SerializeInBlock(Archive& archive) override;
+    /// @}
+
+protected:
+    const char* GetRootBlockName() const override { return "pipelineStates"; }
+
+private:
+    /// Storage for pipeline states created in worker threads. It may outlive the library.
+    struct FinishedPipelineStates : public RefCounted
+    {
+        Mutex mutex_;
+        ea::vector<SharedPtr<PipelineState>> items_;
+    };
+
+    void OnPipelineStateCreated(PipelineState* pipelineState);
+    void ScheduleReadyStates();
+    void AttachFinishedStates();
+
+    ea::vector<PipelineStateLibraryEntry> entries_;
+    ea::unordered_set<PipelineStateLibraryEntry> index_;
+    bool isRecording_{};
+
+    /// Pipeline states waiting for shader compilation.
+    ea::vector<GraphicsPipelineStateDesc> pendingStates_;
+    /// Number of pipeline states being created in worker threads.
+    unsigned numStatesInProgress_{};
+    SharedPtr<FinishedPipelineStates> finishedStates_;
+    ea::vector<SharedPtr<PipelineState>> finishedStatesBuffer_;
+    ea::vector<SharedPtr<PipelineState>> warmedStates_;
+};
+
+} // namespace Urho3D
@@ -25,9 +25,11 @@
 #include <EASTL/sort.h>
 
 #include "../Core/Context.h"
+#include "../Core/Mutex.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/Shader.h"
 #include "../Graphics/ShaderVariation.h"
+#include "../Graphics/ShaderVariationManifest.h"
 #include "../IO/Deserializer.h"
 #include "../IO/Log.h"
 #include "../IO/VirtualFileSystem.h"
@@ -111,6 +113,9 @@ ea::string NormalizeDefines(ea::string_view defines)
     return ea::string::joined(definesVec, " ");
 }
 
+/// Shader variations are compiled and report errors in worker threads, so the file list is shared.
+Mutex fileToIndexMappingMutex;
+
 }
 
 ea::unordered_map<ea::string, unsigned> Shader::fileToIndexMapping;
@@ -138,9 +143,9 @@ void Shader::RegisterObject(Context* context)
 
 bool Shader::BeginLoad(Deserializer& source)
 {
+    // Graphics is optional so shaders can be loaded by offline tools
     auto* graphics = GetSubsystem<Graphics>();
-    if (!graphics)
-        return false;
+    const bool validateShaders = graphics && graphics->GetSettings().validateShaders_;
 
     // Load the shader source code and resolve any includes
     ea::string shaderCode;
@@ -148,7 +153,7 @@ bool Shader::BeginLoad(Deserializer& source)
     ProcessSource(shaderCode, timeStamp, source);
 
     // Validate shader code
-    if (graphics->GetSettings().validateShaders_)
+    if (validateShaders)
     {
         static const auto characterMask = GenerateAllowedCharacterMask();
         static const unsigned maxSnippetSize = 5;
@@ -219,6 +224,11 @@ ShaderVariation* Shader::GetVariation(ShaderType type, ea::string_view defines)
     ++numVariations_;
     RefreshMemoryUse();
 
+    // Record variation for offline precompilation
+    auto graphics = GetSubsystem<Graphics>();
+    if (ShaderVariationManifest* manifest = graphics ? graphics->GetShaderVariationManifest() : nullptr)
+        manifest->AddVariation({GetName(), type, definesNormalized});
+
     return variation;
 }
 
@@ -227,15 +237,21 @@ void Shader::ProcessSource(ea::string& code, FileTime& timeStamp, Deserializer&
     auto* cache = GetSubsystem<ResourceCache>();
     auto* vfs = GetSubsystem<VirtualFileSystem>();
     auto* graphics = GetSubsystem<Graphics>();
+    const bool validateShaders = graphics && graphics->GetSettings().validateShaders_;
 
     const ea::string& fileName = source.GetName();
     // TODO: Support HLSL and MSL shaders.
     const bool isGLSL = true;
 
     // Add file to index
-    unsigned& fileIndex = fileToIndexMapping[fileName];
-    if (!fileIndex)
-        fileIndex = fileToIndexMapping.size();
+    unsigned fileIndex{};
+    {
+        MutexLock lock(fileToIndexMappingMutex);
+        unsigned& mappedIndex = fileToIndexMapping[fileName];
+        if (!mappedIndex)
+            mappedIndex = fileToIndexMapping.size();
+        fileIndex = mappedIndex;
+    }
 
     // If the source if a non-packaged file, store the timestamp
     const FileTime sourceTimeStamp = vfs->GetLastModifiedTime(FileIdentifier::FromUri(source.GetName()), false);
@@ -272,7 +288,7 @@ void Shader::ProcessSource(ea::string& code, FileTime& timeStamp, Deserializer&
                 line.erase(line.end() - 1);
 
             // If shader validation is enabled, trim comments manually to avoid validating comment contents
-            if (!graphics->GetSettings().validateShaders_ || !line.trimmed().starts_with("//"))
+            if (!validateShaders || !line.trimmed().starts_with("//"))
                 code += line;
 
             ++numNewLines;
@@ -301,7 +317,11 @@ void Shader::RefreshMemoryUse()
 
 ea::string Shader::GetShaderFileList()
 {
-    ea::vector<ea::pair<ea::string, unsigned>> fileList(fileToIndexMapping.begin(), fileToIndexMapping.end());
+    ea::vector<ea::pair<ea::string, unsigned>> fileList;
+    {
+        MutexLock lock(fileToIndexMappingMutex);
+        fileList.assign(fileToIndexMapping.begin(), fileToIndexMapping.end());
+    }
     ea::sort(fileList.begin(), fileList.end(),
         [](const ea::pair<ea::string, unsigned>& lhs, const ea::pair<ea::string, unsigned>& rhs)
     {
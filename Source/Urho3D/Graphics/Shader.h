@@ -63,7 +63,7 @@ public:
     /// Return the latest timestamp of the shader code and its includes.
     FileTime GetTimeStamp() const { return timeStamp_; }
 
-    /// Return global list of shader files.
+    /// Return global list of shader files. Safe to call from any thread.
     static ea::string GetShaderFileList();
 
 private:
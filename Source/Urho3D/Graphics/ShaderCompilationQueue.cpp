@@ -0,0 +1,99 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Graphics/ShaderCompilationQueue.h"
+
+#include "Urho3D/Core/CoreEvents.h"
+#include "Urho3D/Core/Timer.h"
+#include "Urho3D/Core/WorkQueue.h"
+#include "Urho3D/IO/Log.h"
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+ShaderCompilationQueue::ShaderCompilationQueue(Context* context)
+    : Object(context)
+    , finishedCompilations_(MakeShared<FinishedCompilations>())
+{
+    SubscribeToEvent(E_BEGINFRAME, [this] { Update(); });
+}
+
+void ShaderCompilationQueue::EnqueueCompilation(ShaderVariation* shaderVariation)
+{
+    auto workQueue = GetSubsystem<WorkQueue>();
+
+    const unsigned queueIndex = nextQueueIndex_++;
+    const unsigned requestId = shaderVariation->asyncRequestId_;
+    pendingShaders_[queueIndex] = shaderVariation;
+    shaderVariation->SetCompilationPending(true);
+
+    stats_.numPending_ = pendingShaders_.size();
+    stats_.maxPending_ = ea::max(stats_.maxPending_, stats_.numPending_);
+
+    auto task = [job = shaderVariation->PrepareCompilationJob(), finishedCompilations = finishedCompilations_,
+        queueIndex, requestId]()
+    {
+        HiresTimer timer;
+
+        FinishedCompilation item;
+        item.queueIndex_ = queueIndex;
+        item.requestId_ = requestId;
+        ShaderVariation::CompileJob(job, item.result_);
+        item.compileTimeMs_ = timer.GetUSec(false) / 1000.0f;
+
+        MutexLock lock(finishedCompilations->mutex_);
+        finishedCompilations->items_.push_back(ea::move(item));
+    };
+    workQueue->PostTask(ea::move(task), TaskPriority::Low);
+}
+
+void ShaderCompilationQueue::Update()
+{
+    {
+        MutexLock lock(finishedCompilations_->mutex_);
+        ea::swap(finishedCompilationsBuffer_, finishedCompilations_->items_);
+    }
+
+    for (const FinishedCompilation& item : finishedCompilationsBuffer_)
+    {
+        if (item.result_.success_)
+            ++stats_.numCompiled_;
+        else
+            ++stats_.numFailed_;
+        stats_.totalCompileTimeMs_ += item.compileTimeMs_;
+        stats_.maxCompileTimeMs_ = ea::max(stats_.maxCompileTimeMs_, item.compileTimeMs_);
+
+        const auto iter = pendingShaders_.find(item.queueIndex_);
+        if (iter == pendingShaders_.end())
+        {
+            URHO3D_LOGERROR("Unexpected shader compilation result");
+            continue;
+        }
+
+        const WeakPtr<ShaderVariation> shaderVariation = iter->second;
+        pendingShaders_.erase(iter);
+
+        if (shaderVariation)
+            shaderVariation->OnAsyncCompilationFinished(item.requestId_, item.result_);
+    }
+
+    finishedCompilationsBuffer_.clear();
+    stats_.numPending_ = pendingShaders_.size();
+}
+
+void ShaderCompilationQueue::CompleteAll()
+{
+    auto workQueue = GetSubsystem<WorkQueue>();
+    while (!pendingShaders_.empty())
+    {
+        workQueue->CompleteAll();
+        Update();
+    }
+}
+
+} // namespace Urho3D
@@ -0,0 +1,85 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Container/Ptr.h"
+#include "Urho3D/Core/Mutex.h"
+#include "Urho3D/Core/Object.h"
+#include "Urho3D/Graphics/ShaderVariation.h"
+
+#include <EASTL/unordered_map.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+/// Statistics of asynchronous shader compilation.
+struct ShaderCompilationStats
+{
+    /// Number of shader variations waiting for compilation.
+    unsigned numPending_{};
+    /// Peak number of shader variations waiting for compilation.
+    unsigned maxPending_{};
+    /// Total number of successfully compiled shader variations.
+    unsigned numCompiled_{};
+    /// Total number of shader variations that failed to compile.
+    unsigned numFailed_{};
+    /// Total time spent on compilation in worker threads, in milliseconds.
+    float totalCompileTimeMs_{};
+    /// Longest compilation time of single shader variation, in milliseconds.
+    float maxCompileTimeMs_{};
+};
+
+/// Compiles shader variations on worker threads.
+/// Shader variation is marked as pending until compiled bytecode is applied on the main thread at the beginning of the frame.
+/// Pipeline states that use pending shaders stay invalid and are recreated automatically when shaders are ready.
+class URHO3D_API ShaderCompilationQueue : public Object
+{
+    URHO3D_OBJECT(ShaderCompilationQueue, Object);
+
+public:
+    explicit ShaderCompilationQueue(Context* context);
+
+    /// Start asynchronous compilation of shader variation.
+    void EnqueueCompilation(ShaderVariation* shaderVariation);
+    /// Apply results of finished compilations. Called automatically at the beginning of the frame.
+    void Update();
+    /// Wait until all pending shader variations are compiled and applied. Should be called from the main thread.
+    void CompleteAll();
+
+    /// Return whether there are no pending shader variations.
+    bool IsEmpty() const { return pendingShaders_.empty(); }
+    /// Return statistics.
+    const ShaderCompilationStats& GetStats() const { return stats_; }
+
+private:
+    /// Compilation result waiting to be applied on the main thread.
+    struct FinishedCompilation
+    {
+        unsigned queueIndex_{};
+        unsigned requestId_{};
+        float compileTimeMs_{};
+        ShaderCompilationResult result_;
+    };
+
+    /// Storage for finished compilations shared with worker threads. It may outlive the queue.
+    struct FinishedCompilations : public RefCounted
+    {
+        Mutex mutex_;
+        ea::vector<FinishedCompilation> items_;
+    };
+
+    /// Pending shader variations by index in queue.
+    ea::unordered_map<unsigned, WeakPtr<ShaderVariation>> pendingShaders_;
+    /// Next index in queue.
+    unsigned nextQueueIndex_{};
+
+    SharedPtr<FinishedCompilations> finishedCompilations_;
+    ea::vector<FinishedCompilation> finishedCompilationsBuffer_;
+
+    ShaderCompilationStats stats_;
+};
+
+} // namespace Urho3D
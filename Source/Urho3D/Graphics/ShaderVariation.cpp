@@ -27,6 +27,7 @@
 #include "Urho3D/Core/ProcessUtils.h"
 #include "Urho3D/Graphics/Graphics.h"
 #include "Urho3D/Graphics/Shader.h"
+#include "Urho3D/Graphics/ShaderCompilationQueue.h"
 #include "Urho3D/IO/Log.h"
 #include "Urho3D/IO/VirtualFileSystem.h"
 #include "Urho3D/RenderAPI/RenderAPIUtils.h"
@@ -90,6 +91,71 @@ template <class T> ConstByteSpan ToByteSpan(const T& value)
     return {dataBytes, sizeInBytes};
 }
 
+ea::string PrepareGLSLShaderCode(const ea::string& originalShaderCode, ShaderType shaderType, const ea::string& defines,
+    RenderBackend renderBackend, ShaderTranslationPolicy translationPolicy)
+{
+    ea::string shaderCode;
+
+    const bool skipVersionTag = translationPolicy != ShaderTranslationPolicy::Verbatim;
+
+    // Check if the shader code contains a version define
+    const auto versionTag = FindVersionTag(originalShaderCode);
+    if (!skipVersionTag)
+    {
+        if (versionTag)
+        {
+            // If version define found, insert it first
+            const ea::string versionDefine =
+                originalShaderCode.substr(versionTag->first, versionTag->second - versionTag->first);
+            shaderCode += versionDefine + "\n";
+        }
+        else
+        {
+            const bool isOpenGLES = IsOpenGLESBackend(renderBackend);
+            const bool isCompute = shaderType == CS;
+
+            static const char* versions[2][2] = {
+                {"#version 410\n", "#version 430\n"},
+                {"#version 300 es\n", "#version 310 es\n"},
+            };
+
+            shaderCode += versions[isOpenGLES][isCompute];
+        }
+    }
+
+    static const char* shaderTypeDefines[] = {
+        "#define COMPILEVS\n", // VS
+        "#define COMPILEPS\n", // PS
+        "#define COMPILEGS\n", // GS
+        "#define COMPILEHS\n", // HS
+        "#define COMPILEDS\n", // DS
+        "#define COMPILECS\n", // CS
+    };
+    shaderCode += shaderTypeDefines[shaderType];
+
+    shaderCode += Format("#define URHO3D_{}\n", ToString(renderBackend).to_upper());
+
+    // Prepend the defines to the shader code
+    const StringVector defineVec = defines.split(' ');
+    for (const ea::string& define : defineVec)
+    {
+        const ea::string defineString = "#define " + define.replaced('=', ' ') + " \n";
+        shaderCode += defineString;
+    }
+
+    // When version define found, do not insert it a second time
+    if (!versionTag)
+        shaderCode += originalShaderCode;
+    else
+    {
+        shaderCode += originalShaderCode.substr(0, versionTag->first);
+        shaderCode += "//";
+        shaderCode += originalShaderCode.substr(versionTag->first);
+    }
+
+    return shaderCode;
+}
+
 } // namespace
 
 ShaderVariation::ShaderVariation(Shader* owner, ShaderType type, const ea::string& defines)
@@ -123,6 +189,10 @@ bool ShaderVariation::Create()
 {
     Destroy();
 
+    // Discard results of pending asynchronous compilation, if any
+    ++asyncRequestId_;
+    SetCompilationPending(false);
+
     if (!graphics_)
         return false;
 
@@ -132,12 +202,26 @@ bool ShaderVariation::Create()
         return false;
     }
 
+    // Null backend doesn't consume shaders, don't waste time on compilation
+    if (graphics_->GetRenderBackend() == RenderBackend::Null)
+    {
+        CreateFromBinary({GetShaderType()});
+        return true;
+    }
+
     const GraphicsSettings& settings = graphics_->GetSettings();
     const FileIdentifier& cacheDir = settings.shaderCacheDir_;
     const FileIdentifier binaryShaderName = cacheDir + GetCachedVariationName("bytecode");
 
     if (!LoadByteCode(binaryShaderName))
     {
+        // Compile shader in background if allowed, bytecode will be saved when it's ready
+        if (settings.asyncShaderCompilation_)
+        {
+            graphics_->GetShaderCompilationQueue()->EnqueueCompilation(this);
+            return true;
+        }
+
         // Compile shader if don't have valid bytecode
         if (!CompileFromSource())
         {
@@ -154,36 +238,76 @@ bool ShaderVariation::Create()
     return true;
 }
 
+void ShaderVariation::CompleteCompilation()
+{
+    if (!IsCompilationPending())
+        return;
+
+    ShaderCompilationResult result;
+    CompileJob(PrepareCompilationJob(), result);
+    OnAsyncCompilationFinished(asyncRequestId_, result);
+}
+
 bool ShaderVariation::CompileFromSource()
 {
-    const ea::string& originalShaderCode = owner_->GetSourceCode();
-    const ea::string sourceCode = PrepareGLSLShaderCode(originalShaderCode);
+    const ShaderCompilationJob job = PrepareCompilationJob();
+
+    ShaderCompilationResult result;
+    CompileJob(job, result);
+
+    return ApplyCompilationResult(result);
+}
+
+void ShaderVariation::OnAsyncCompilationFinished(unsigned requestId, const ShaderCompilationResult& result)
+{
+    // Shader was reloaded or compiled synchronously in the meantime
+    if (requestId != asyncRequestId_ || !IsCompilationPending() || !owner_)
+        return;
+
+    SetCompilationPending(false);
+    if (!ApplyCompilationResult(result))
+    {
+        // Notify everyone if compilation failed
+        CreateFromBinary({GetShaderType()});
+        return;
+    }
+
+    const GraphicsSettings& settings = graphics_->GetSettings();
+    if (settings.cacheShaders_ && owner_->GetTimeStamp())
+        SaveByteCode(settings.shaderCacheDir_ + GetCachedVariationName("bytecode"));
+}
+
+ShaderCompilationJob ShaderVariation::PrepareCompilationJob() const
+{
+    return PrepareCompilationJob(owner_, GetShaderType(), defines_, graphics_->GetRenderBackend(),
+        graphics_->GetSettings().shaderTranslationPolicy_);
+}
 
-    ea::string_view translatedSource;
-    const SpirVShader* translatedSpirv{};
-    ConstByteSpan translatedBytecode;
-    const bool processed = ProcessShaderSource(translatedSource, translatedSpirv, translatedBytecode, sourceCode);
+ShaderCompilationJob ShaderVariation::PrepareCompilationJob(const Shader* shader, ShaderType type,
+    const ea::string& defines, RenderBackend renderBackend, ShaderTranslationPolicy translationPolicy)
+{
+    ShaderCompilationJob job;
+    job.variationName_ = Format("{}({})", shader->GetShaderName(), defines);
+    job.type_ = type;
+    job.renderBackend_ = renderBackend;
+    job.translationPolicy_ = translationPolicy;
+    job.sourceCode_ = PrepareGLSLShaderCode(shader->GetSourceCode(), type, defines, renderBackend, translationPolicy);
+    return job;
+}
 
+bool ShaderVariation::ApplyCompilationResult(const ShaderCompilationResult& result)
+{
     const FileIdentifier& cacheDir = graphics_->GetSettings().shaderCacheDir_;
     const FileIdentifier loggedSourceShaderName = cacheDir + GetCachedVariationName("glsl");
-    LogShaderSource(loggedSourceShaderName, defines_, translatedSource);
+    LogShaderSource(loggedSourceShaderName, defines_, result.translatedSource_);
 
-    if (!processed)
+    if (!result.success_)
         return false;
 
-    const RenderBackend renderBackend = graphics_->GetRenderBackend();
-
-    ShaderBytecode bytecode;
-    bytecode.type_ = GetShaderType();
-    bytecode.mime_ = GetCompiledShaderMIME(renderBackend);
-    bytecode.bytecode_.assign(translatedBytecode.begin(), translatedBytecode.end());
-    if (translatedSpirv && GetShaderType() == VS)
-        bytecode.vertexAttributes_ = GetVertexAttributesFromSpirV(*translatedSpirv);
-
-    CreateFromBinary(bytecode);
+    CreateFromBinary(result.bytecode_);
     if (!GetHandle())
     {
-        if (renderBackend == RenderBackend::OpenGL)
+        if (graphics_->GetRenderBackend() == RenderBackend::OpenGL)
             URHO3D_LOGINFO("Shader files:\n{}", Shader::GetShaderFileList());
         return false;
     }
@@ -244,112 +368,51 @@ void ShaderVariation::SaveByteCode(const FileIdentifier& binaryShaderName)
 
 ea::string ShaderVariation::GetCachedVariationName(ea::string_view extension) const
 {
-    const ea::string backendName = ToString(graphics_->GetRenderBackend()).to_lower();
-    const ea::string shortName = owner_->GetShaderName();
-    const ea::string shaderTypeName = ToString(GetShaderType()).to_lower();
-    const StringHash definesHash{defines_};
-    return Format("{}_{}_{}_{}.{}", shortName, shaderTypeName, definesHash.ToString(), backendName, extension);
+    return GetCachedVariationName(
+        owner_->GetShaderName(), GetShaderType(), defines_, graphics_->GetRenderBackend(), extension);
 }
 
-bool ShaderVariation::NeedShaderTranslation() const
+ea::string ShaderVariation::GetCachedVariationName(const ea::string& shaderName, ShaderType type,
+    const ea::string& defines, RenderBackend renderBackend, ea::string_view extension)
 {
-    const ShaderTranslationPolicy policy = graphics_->GetSettings().shaderTranslationPolicy_;
-    return policy != ShaderTranslationPolicy::Verbatim;
+    const ea::string backendName = ToString(renderBackend).to_lower();
+    const ea::string shaderTypeName = ToString(type).to_lower();
+    const StringHash definesHash{defines};
+    return Format("{}_{}_{}_{}.{}", shaderName, shaderTypeName, definesHash.ToString(), backendName, extension);
 }
 
-bool ShaderVariation::NeedShaderOptimization() const
+void ShaderVariation::CompileJob(const ShaderCompilationJob& job, ShaderCompilationResult& result)
 {
-    const ShaderTranslationPolicy policy = graphics_->GetSettings().shaderTranslationPolicy_;
-    return policy == ShaderTranslationPolicy::Optimize;
-}
+    const ea::string_view originalShaderCode = job.sourceCode_;
+    const SpirVShader* translatedSpirv = nullptr;
+    ConstByteSpan translatedBytecode = ToByteSpan(originalShaderCode);
 
-ea::string ShaderVariation::PrepareGLSLShaderCode(const ea::string& originalShaderCode) const
-{
-    ea::string shaderCode;
+    result = {};
+    result.translatedSource_ = job.sourceCode_;
 
-    const RenderBackend renderBackend = graphics_->GetRenderBackend();
-    const bool skipVersionTag = NeedShaderTranslation();
+    const RenderBackend renderBackend = job.renderBackend_;
 
-    // Check if the shader code contains a version define
-    const auto versionTag = FindVersionTag(originalShaderCode);
-    if (!skipVersionTag)
+    // Null backend doesn't consume shaders, empty bytecode is enough
+    if (renderBackend == RenderBackend::Null)
     {
-        if (versionTag)
-        {
-            // If version define found, insert it first
-            const ea::string versionDefine =
-                originalShaderCode.substr(versionTag->first, versionTag->second - versionTag->first);
-            shaderCode += versionDefine + "\n";
-        }
-        else
-        {
-            const bool isOpenGLES = IsOpenGLESBackend(renderBackend);
-            const bool isCompute = GetShaderType() == CS;
-
-            static const char* versions[2][2] = {
-                {"#version 410\n", "#version 430\n"},
-                {"#version 300 es\n", "#version 310 es\n"},
-            };
-
-            shaderCode += versions[isOpenGLES][isCompute];
-        }
-    }
-
-    static const char* shaderTypeDefines[] = {
-        "#define COMPILEVS\n", // VS
-        "#define COMPILEPS\n", // PS
-        "#define COMPILEGS\n", // GS
-        "#define COMPILEHS\n", // HS
-        "#define COMPILEDS\n", // DS
-        "#define COMPILECS\n", // CS
-    };
-    shaderCode += shaderTypeDefines[GetShaderType()];
-
-    shaderCode += Format("#define URHO3D_{}\n", ToString(renderBackend).to_upper());
-
-    // Prepend the defines to the shader code
-    const StringVector defineVec = defines_.split(' ');
-    for (const ea::string& define : defineVec)
-    {
-        const ea::string defineString = "#define " + define.replaced('=', ' ') + " \n";
-        shaderCode += defineString;
-    }
-
-    // When version define found, do not insert it a second time
-    if (!versionTag)
-        shaderCode += originalShaderCode;
-    else
-    {
-        shaderCode += originalShaderCode.substr(0, versionTag->first);
-        shaderCode += "//";
-        shaderCode += originalShaderCode.substr(versionTag->first);
+        result.success_ = true;
+        result.bytecode_.type_ = job.type_;
+        return;
     }
-
-    return shaderCode;
-}
-
-bool ShaderVariation::ProcessShaderSource(ea::string_view& translatedSource, const SpirVShader*& translatedSpirv,
-    ConstByteSpan& translatedBytecode, ea::string_view originalShaderCode)
-{
-    translatedSource = originalShaderCode;
-    translatedSpirv = nullptr;
-    translatedBytecode = ToByteSpan(originalShaderCode);
-
-    const RenderBackend renderBackend = graphics_->GetRenderBackend();
     const TargetShaderLanguage targetShaderLanguage = GetTargetShaderLanguage(renderBackend);
-    const bool needShaderTranslation = NeedShaderTranslation();
-    const bool needShaderOptimization = NeedShaderOptimization();
+    const bool needShaderTranslation = job.translationPolicy_ != ShaderTranslationPolicy::Verbatim;
+    const bool needShaderOptimization = job.translationPolicy_ == ShaderTranslationPolicy::Optimize;
 
 #ifdef URHO3D_SHADER_TRANSLATOR
     if (needShaderTranslation)
     {
         static thread_local SpirVShader spirvShader;
-        ParseUniversalShader(spirvShader, GetShaderType(), originalShaderCode, {}, targetShaderLanguage);
+        ParseUniversalShader(spirvShader, job.type_, originalShaderCode, {}, targetShaderLanguage);
         if (!spirvShader)
         {
-            URHO3D_LOGERROR("Failed to convert shader {} from GLSL to SPIR-V:\n{}{}", GetShaderVariationName(),
+            URHO3D_LOGERROR("Failed to convert shader {} from GLSL to SPIR-V:\n{}{}", job.variationName_,
                 Shader::GetShaderFileList(), spirvShader.compilerOutput_);
-            return false;
+            return;
         }
 
         translatedSpirv = &spirvShader;
@@ -360,8 +423,8 @@ bool ShaderVariation::ProcessShaderSource(ea::string_view& translatedSource, con
             ea::string optimizerOutput;
             if (!OptimizeSpirVShader(spirvShader, optimizerOutput, targetShaderLanguage))
             {
-                URHO3D_LOGERROR("Failed to optimize SPIR-V shader {}:\n{}", GetShaderVariationName(), optimizerOutput);
-                return false;
+                URHO3D_LOGERROR("Failed to optimize SPIR-V shader {}:\n{}", job.variationName_, optimizerOutput);
+                return;
             }
         }
     #endif
@@ -378,22 +441,22 @@ bool ShaderVariation::ProcessShaderSource(ea::string_view& translatedSource, con
             TranslateSpirVShader(targetShader, spirvShader, targetShaderLanguage);
             if (!targetShader)
             {
-                URHO3D_LOGERROR("Failed to convert shader {} from SPIR-V to HLSL:\n{}{}", GetShaderVariationName(),
+                URHO3D_LOGERROR("Failed to convert shader {} from SPIR-V to HLSL:\n{}{}", job.variationName_,
                     Shader::GetShaderFileList(), targetShader.compilerOutput_);
-                return false;
+                return;
             }
 
-            translatedSource = targetShader.sourceCode_;
+            result.translatedSource_ = targetShader.sourceCode_;
             if (renderBackend == RenderBackend::D3D11 || renderBackend == RenderBackend::D3D12)
             {
                 // On D3D backends, compile the translated source code
                 static thread_local ByteVector hlslBytecode;
                 ea::string compilerOutput;
-                if (!CompileHLSLToBinary(hlslBytecode, compilerOutput, targetShader.sourceCode_, GetShaderType()))
+                if (!CompileHLSLToBinary(hlslBytecode, compilerOutput, targetShader.sourceCode_, job.type_))
                 {
-                    URHO3D_LOGERROR("Failed to compile HLSL shader {}:\n{}{}", GetShaderVariationName(),
+                    URHO3D_LOGERROR("Failed to compile HLSL shader {}:\n{}{}", job.variationName_,
                         Shader::GetShaderFileList(), compilerOutput);
-                    return false;
+                    return;
                 }
 
                 translatedBytecode = hlslBytecode;
@@ -407,7 +470,12 @@ bool ShaderVariation::ProcessShaderSource(ea::string_view& translatedSource, con
     }
 #endif
 
-    return true;
+    result.success_ = true;
+    result.bytecode_.type_ = job.type_;
+    result.bytecode_.mime_ = GetCompiledShaderMIME(renderBackend);
+    result.bytecode_.bytecode_.assign(translatedBytecode.begin(), translatedBytecode.end());
+    if (translatedSpirv && job.type_ == VS)
+        result.bytecode_.vertexAttributes_ = GetVertexAttributesFromSpirV(*translatedSpirv);
 }
 
 } // namespace Urho3D
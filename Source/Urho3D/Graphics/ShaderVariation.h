@@ -37,8 +37,34 @@ namespace Urho3D
 {
 
 class Shader;
+class ShaderCompilationQueue;
 struct FileIdentifier;
-struct SpirVShader;
+
+/// Self-contained description of shader variation compilation. Can be processed on any thread.
+struct ShaderCompilationJob
+{
+    /// Full shader variation name, used for logging.
+    ea::string variationName_;
+    /// Type of the shader.
+    ShaderType type_{};
+    /// Target render backend.
+    RenderBackend renderBackend_{};
+    /// Shader translation policy.
+    ShaderTranslationPolicy translationPolicy_{};
+    /// GLSL source code with all defines and version tag prepended.
+    ea::string sourceCode_;
+};
+
+/// Result of shader variation compilation.
+struct ShaderCompilationResult
+{
+    /// Whether the compilation succeeded.
+    bool success_{};
+    /// Compiled bytecode for the target render backend.
+    ShaderBytecode bytecode_;
+    /// Translated shader source, used for logging.
+    ea::string translatedSource_;
+};
 
 /// Vertex or pixel shader on the GPU.
 class URHO3D_API ShaderVariation
@@ -47,6 +73,8 @@ class URHO3D_API ShaderVariation
 public:
     ShaderVariation(Shader* owner, ShaderType type, const ea::string& defines);
 
+    /// Return source shader.
+    Shader* GetOwner() const { return owner_; }
     /// Return shader name (as used in resources).
     ea::string GetShaderName() const;
     /// Return full shader variation name with defines.
@@ -54,14 +82,25 @@ public:
     /// Return defines used to create the shader.
     const ea::string& GetDefines() const { return defines_; }
 
+    /// Compile the shader synchronously if it is still waiting for asynchronous compilation.
+    /// Result of background compilation will be discarded.
+    void CompleteCompilation();
+
+    /// Prepare compilation of shader variation for specified backend.
+    static ShaderCompilationJob PrepareCompilationJob(const Shader* shader, ShaderType type, const ea::string& defines,
+        RenderBackend renderBackend, ShaderTranslationPolicy translationPolicy);
+    /// Compile shader from source. Doesn't access any engine state and may be called from any thread.
+    static void CompileJob(const ShaderCompilationJob& job, ShaderCompilationResult& result);
+    /// Return file name of cached shader variation, relative to shader cache directory.
+    static ea::string GetCachedVariationName(const ea::string& shaderName, ShaderType type, const ea::string& defines,
+        RenderBackend renderBackend, ea::string_view extension);
+
 private:
-    ea::string GetCachedVariationName(ea::string_view extension) const;
-    bool NeedShaderTranslation() const;
-    bool NeedShaderOptimization() const;
+    friend class ShaderCompilationQueue;
 
-    ea::string PrepareGLSLShaderCode(const ea::string& originalShaderCode) const;
-    bool ProcessShaderSource(ea::string_view& translatedSource, const SpirVShader*& translatedSpirv,
-        ConstByteSpan& translatedBytecode, ea::string_view originalShaderCode);
+    ea::string GetCachedVariationName(ea::string_view extension) const;
+    ShaderCompilationJob PrepareCompilationJob() const;
+    bool ApplyCompilationResult(const ShaderCompilationResult& result);
 
     void OnReloaded();
     bool Create();
@@ -69,12 +108,17 @@ private:
     bool LoadByteCode(const FileIdentifier& binaryShaderName);
     void SaveByteCode(const FileIdentifier& binaryShaderName);
 
+    /// Called by ShaderCompilationQueue when asynchronous compilation is finished.
+    void OnAsyncCompilationFinished(unsigned requestId, const ShaderCompilationResult& result);
+
     /// Cached pointer to Graphics subsystem.
     WeakPtr<Graphics> graphics_;
     /// Source shader.
     WeakPtr<Shader> owner_;
     /// Defines to use when compiling the shader.
     ea::string defines_;
+    /// Identifier of the latest asynchronous compilation request. Older results are discarded.
+    unsigned asyncRequestId_{};
 };
 
 } // namespace Urho3D
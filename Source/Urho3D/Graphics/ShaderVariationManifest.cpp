@@ -0,0 +1,81 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Graphics/ShaderVariationManifest.h"
+
+#include "Urho3D/Core/Context.h"
+#include "Urho3D/IO/ArchiveSerialization.h"
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+void ShaderVariationManifestEntry::SerializeInBlock(Archive& archive)
+{
+    SerializeValue(archive, "shader", shaderName_);
+    SerializeValue(archive, "type", type_);
+    SerializeValue(archive, "defines", defines_);
+}
+
+unsigned ShaderVariationManifestEntry::ToHash() const
+{
+    unsigned hash = 0;
+    CombineHash(hash, MakeHash(shaderName_));
+    CombineHash(hash, MakeHash(type_));
+    CombineHash(hash, MakeHash(defines_));
+    return hash;
+}
+
+ShaderVariationManifest::ShaderVariationManifest(Context* context)
+    : SimpleResource(context)
+{
+}
+
+ShaderVariationManifest::~ShaderVariationManifest()
+{
+}
+
+void ShaderVariationManifest::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<ShaderVariationManifest>();
+}
+
+bool ShaderVariationManifest::AddVariation(const ShaderVariationManifestEntry& entry)
+{
+    if (!index_.insert(entry).second)
+        return false;
+
+    variations_.push_back(entry);
+    dirty_ = true;
+    return true;
+}
+
+void ShaderVariationManifest::Merge(const ShaderVariationManifest& other)
+{
+    for (const ShaderVariationManifestEntry& entry : other.variations_)
+        AddVariation(entry);
+}
+
+void ShaderVariationManifest::Clear()
+{
+    variations_.clear();
+    index_.clear();
+    dirty_ = true;
+}
+
+void ShaderVariationManifest::SerializeInBlock(Archive& archive)
+{
+    SerializeOptionalValue(archive, "variations", variations_);
+
+    if (archive.IsInput())
+    {
+        RemoveDuplicateEntries(variations_, index_);
+        dirty_ = false;
+    }
+}
+
+} // namespace Urho3D
@@ -0,0 +1,83 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Graphics/GraphicsDefs.h"
+#include "Urho3D/Resource/Resource.h"
+
+#include <EASTL/unordered_set.h>
+
+namespace Urho3D
+{
+
+/// Shader variation requested by the application.
+struct URHO3D_API ShaderVariationManifestEntry
+{
+    /// Shader resource name.
+    ea::string shaderName_;
+    /// Shader type.
+    ShaderType type_{};
+    /// Normalized shader defines.
+    ea::string defines_;
+
+    void SerializeInBlock(Archive& archive);
+
+    /// Operators.
+    /// @{
+    auto Tie() const { return ea::tie(shaderName_, type_, defines_); }
+    bool operator==(const ShaderVariationManifestEntry& rhs) const { return Tie() == rhs.Tie(); }
+    bool operator!=(const ShaderVariationManifestEntry& rhs) const { return Tie() != rhs.Tie(); }
+    unsigned ToHash() const;
+    /// @}
+};
+
+/// Remove repeated entries keeping the first occurrence and rebuild the index of unique entries.
+/// Used on load because resource files with entries may be merged by hand.
+template <class T> void RemoveDuplicateEntries(ea::vector<T>& entries, ea::unordered_set<T>& index)
+{
+    index.clear();
+    ea::erase_if(entries, [&index](const T& entry) { return !index.insert(entry).second; });
+}
+
+/// List of shader variations requested by the application at runtime.
+/// It is recorded by Graphics when enabled and used to precompile shaders ahead of time.
+class URHO3D_API ShaderVariationManifest : public SimpleResource
+{
+    URHO3D_OBJECT(ShaderVariationManifest, SimpleResource);
+
+public:
+    explicit ShaderVariationManifest(Context* context);
+    ~ShaderVariationManifest() override;
+    static void RegisterObject(Context* context);
+
+    /// Add shader variation. Duplicates are ignored. Return true if the variation is new.
+    bool AddVariation(const ShaderVariationManifestEntry& entry);
+    /// Add all shader variations from another manifest.
+    void Merge(const ShaderVariationManifest& other);
+    /// Remove all shader variations.
+    void Clear();
+
+    /// Return shader variations in order of addition.
+    const ea::vector<ShaderVariationManifestEntry>& GetVariations() const { return variations_; }
+    /// Return whether the manifest was modified since it was loaded or saved.
+    bool IsDirty() const { return dirty_; }
+    /// Mark manifest as saved.
+    void ResetDirty() { dirty_ = false; }
+
+    /// Implement SimpleResource.
+    /// @{
+    void SerializeInBlock(Archive& archive) override;
+    /// @}
+
+protected:
+    const char* GetRootBlockName() const override { return "shaderVariations"; }
+
+private:
+    ea::vector<ShaderVariationManifestEntry> variations_;
+    ea::unordered_set<ShaderVariationManifestEntry> index_;
+    bool dirty_{};
+};
+
+} // namespace Urho3D
@@ -22,8 +22,12 @@
 
 #include "../Precompiled.h"
 
+#include "../Core/Assert.h"
 #include "../Core/Context.h"
+#include "../Core/CoreEvents.h"
+#include "../Core/Mutex.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/DrawableEvents.h"
 #include "../Graphics/Geometry.h"
 #include "../Graphics/IndexBuffer.h"
@@ -39,6 +43,9 @@
 #include "../Scene/Node.h"
 #include "../Scene/Scene.h"
 
+#include <atomic>
+#include <thread>
+
 #include "../DebugNew.h"
 
 namespace Urho3D
@@ -46,14 +53,19 @@ namespace Urho3D
 
 static const Vector3 DEFAULT_SPACING(1.0f, 0.25f, 1.0f);
 static const unsigned MIN_LOD_LEVELS = 1;
-static const unsigned MAX_LOD_LEVELS = 4;
+static const unsigned DEFAULT_MAX_LOD_LEVELS = 4;
 static const int DEFAULT_PATCH_SIZE = 32;
 static const int MIN_PATCH_SIZE = 4;
 static const int MAX_PATCH_SIZE = 128;
+/// LOD levels halve the patch size down to MIN_PATCH_SIZE: 128, 64, 32, 16, 8 and 4.
+static const unsigned MAX_LOD_LEVELS = 6;
 static const unsigned STITCH_NORTH = 1;
 static const unsigned STITCH_SOUTH = 2;
 static const unsigned STITCH_WEST = 4;
 static const unsigned STITCH_EAST = 8;
+static const unsigned DEFAULT_MAX_PATCH_UPDATES_PER_FRAME = 16;
+static const unsigned NUM_PATCHES_PER_TASK = 4;
+static const unsigned NUM_PATCHES_PER_BATCH = 64;
 
 inline void GrowUpdateRegion(IntRect& updateRegion, int x, int y)
 {
@@ -75,6 +87,254 @@ inline void GrowUpdateRegion(IntRect& updateRegion, int x, int y)
     }
 }
 
+/// Terrain parameters and height data needed to generate patch geometry. Read-only once filled.
+struct TerrainGeometrySource
+{
+    ea::shared_array<float> heightData_;
+    IntVector2 numVertices_;
+    Vector3 spacing_;
+    int patchSize_{};
+    unsigned numLodLevels_{};
+    /// LOD level used for occlusion, clamped to existing levels.
+    unsigned occlusionLodLevel_{};
+    bool bakeLightmap_{};
+};
+
+/// Patch geometry generated outside of the main thread.
+struct TerrainPatchGeometry
+{
+    IntVector2 coordinates_;
+    VertexMaskFlags vertexMask_;
+    ea::vector<float> vertexData_;
+    ea::shared_array<unsigned char> positionData_;
+    ea::shared_array<unsigned char> occlusionPositionData_;
+    BoundingBox boundingBox_;
+    ea::vector<float> lodErrors_;
+};
+
+/// Patches generated in worker threads during asynchronous patch generation.
+struct TerrainPatchQueue : public RefCounted
+{
+    TerrainGeometrySource source_;
+    Mutex mutex_;
+    ea::vector<TerrainPatchGeometry> patches_;
+    /// Coordinates of all patches to generate.
+    ea::vector<IntVector2> coordinates_;
+    /// Index of the next patch to be taken for generation.
+    std::atomic<unsigned> nextPatch_{};
+    /// Number of patches generated and added to the queue.
+    std::atomic<unsigned> numGeneratedPatches_{};
+    /// Set by the main thread to stop generation.
+    std::atomic<bool> cancelled_{};
+};
+
+static float SampleRawHeight(const float* heightData, const IntVector2& numVertices, int x, int z)
+{
+    if (!heightData)
+        return 0.0f;
+
+    x = Clamp(x, 0, numVertices.x_ - 1);
+    z = Clamp(z, 0, numVertices.y_ - 1);
+    return heightData[z * numVertices.x_ + x];
+}
+
+static float SampleLodHeight(const float* heightData, const IntVector2& numVertices, int x, int z, unsigned lodLevel)
+{
+    unsigned offset = 1u << lodLevel;
+    auto xFrac = (float)(x % offset) / offset;
+    auto zFrac = (float)(z % offset) / offset;
+    float h1, h2, h3;
+
+    if (xFrac + zFrac >= 1.0f)
+    {
+        h1 = SampleRawHeight(heightData, numVertices, x + offset, z + offset);
+        h2 = SampleRawHeight(heightData, numVertices, x, z + offset);
+        h3 = SampleRawHeight(heightData, numVertices, x + offset, z);
+        xFrac = 1.0f - xFrac;
+        zFrac = 1.0f - zFrac;
+    }
+    else
+    {
+        h1 = SampleRawHeight(heightData, numVertices, x, z);
+        h2 = SampleRawHeight(heightData, numVertices, x + offset, z);
+        h3 = SampleRawHeight(heightData, numVertices, x, z + offset);
+    }
+
+    return h1 * (1.0f - xFrac - zFrac) + h2 * xFrac + h3 * zFrac;
+}
+
+static Vector3 SampleRawNormal(const float* heightData, const IntVector2& numVertices, const Vector3& spacing, int x, int z)
+{
+    const auto getHeight = [&](int x, int z) { return SampleRawHeight(heightData, numVertices, x, z); };
+
+    float baseHeight = getHeight(x, z);
+    float nSlope = getHeight(x, z - 1) - baseHeight;
+    float neSlope = getHeight(x + 1, z - 1) - baseHeight;
+    float eSlope = getHeight(x + 1, z) - baseHeight;
+    float seSlope = getHeight(x + 1, z + 1) - baseHeight;
+    float sSlope = getHeight(x, z + 1) - baseHeight;
+    float swSlope = getHeight(x - 1, z + 1) - baseHeight;
+    float wSlope = getHeight(x - 1, z) - baseHeight;
+    float nwSlope = getHeight(x - 1, z - 1) - baseHeight;
+    float up = 0.5f * (spacing.x_ + spacing.z_);
+
+    return (Vector3(0.0f, up, nSlope) +
+            Vector3(-neSlope, up, neSlope) +
+            Vector3(-eSlope, up, 0.0f) +
+            Vector3(-seSlope, up, -seSlope) +
+            Vector3(0.0f, up, -sSlope) +
+            Vector3(swSlope, up, -swSlope) +
+            Vector3(wSlope, up, 0.0f) +
+            Vector3(nwSlope, up, nwSlope)).Normalized();
+}
+
+/// Generate vertex data and LOD errors of a patch. Safe to call from any thread.
+static void GeneratePatchGeometry(const TerrainGeometrySource& source, const IntVector2& coords, TerrainPatchGeometry& geometry)
+{
+    const float* heightData = source.heightData_.get();
+    const IntVector2& numVertices = source.numVertices_;
+    const Vector3& spacing = source.spacing_;
+    const int patchSize = source.patchSize_;
+    const auto row = (unsigned)(patchSize + 1);
+
+    geometry.coordinates_ = coords;
+
+    // Scale in lightmap is intentionally ignored here
+    // because lightmapper itself needs Terrain with lightmap UV but without lightmapping during rendering
+    geometry.vertexMask_ = MASK_POSITION | MASK_NORMAL | MASK_TEXCOORD1 | MASK_TANGENT;
+    if (source.bakeLightmap_)
+        geometry.vertexMask_ |= MASK_TEXCOORD2;
+
+    geometry.vertexData_.resize(row * row * VertexBuffer::GetVertexSize(geometry.vertexMask_) / sizeof(float));
+    geometry.positionData_ = ea::shared_array<unsigned char>(new unsigned char[row * row * sizeof(Vector3)]);
+    geometry.occlusionPositionData_ = ea::shared_array<unsigned char>(new unsigned char[row * row * sizeof(Vector3)]);
+    geometry.boundingBox_.Clear();
+
+    float* vertexData = geometry.vertexData_.data();
+    auto* positionData = (float*)geometry.positionData_.get();
+    auto* occlusionData = (float*)geometry.occlusionPositionData_.get();
+
+    const int lodExpand = (1 << source.occlusionLodLevel_) - 1;
+    const int halfLodExpand = (1 << source.occlusionLodLevel_) / 2;
+
+    for (int z = 0; z <= patchSize; ++z)
+    {
+        for (int x = 0; x <= patchSize; ++x)
+        {
+            int xPos = coords.x_ * patchSize + x;
+            int zPos = coords.y_ * patchSize + z;
+
+            // Position
+            Vector3 position((float)x * spacing.x_, SampleRawHeight(heightData, numVertices, xPos, zPos), (float)z * spacing.z_);
+            *vertexData++ = position.x_;
+            *vertexData++ = position.y_;
+            *vertexData++ = position.z_;
+            *positionData++ = position.x_;
+            *positionData++ = position.y_;
+            *positionData++ = position.z_;
+
+            geometry.boundingBox_.Merge(position);
+
+            // For vertices that are part of the occlusion LOD, calculate the minimum height in the neighborhood
+            // to prevent false positive occlusion due to inaccuracy between occlusion LOD & visible LOD
+            float minHeight = position.y_;
+            if (halfLodExpand > 0 && (x & lodExpand) == 0 && (z & lodExpand) == 0)
+            {
+                int minX = Max(xPos - halfLodExpand, 0);
+                int maxX = Min(xPos + halfLodExpand, numVertices.x_ - 1);
+                int minZ = Max(zPos - halfLodExpand, 0);
+                int maxZ = Min(zPos + halfLodExpand, numVertices.y_ - 1);
+                for (int nZ = minZ; nZ <= maxZ; ++nZ)
+                {
+                    for (int nX = minX; nX <= maxX; ++nX)
+                        minHeight = Min(minHeight, SampleRawHeight(heightData, numVertices, nX, nZ));
+                }
+            }
+            *occlusionData++ = position.x_;
+            *occlusionData++ = minHeight;
+            *occlusionData++ = position.z_;
+
+            // Normal
+            Vector3 normal = SampleRawNormal(heightData, numVertices, spacing, xPos, zPos);
+            *vertexData++ = normal.x_;
+            *vertexData++ = normal.y_;
+            *vertexData++ = normal.z_;
+
+            // Texture coordinate(s)
+            const Vector2 texCoord((float)xPos / (numVertices.x_ - 1), (float)(numVertices.y_ - 1 - zPos) / (numVertices.y_ - 1));
+            *vertexData++ = texCoord.x_;
+            *vertexData++ = texCoord.y_;
+
+            if (source.bakeLightmap_)
+            {
+                *vertexData++ = texCoord.x_;
+                *vertexData++ = texCoord.y_;
+            }
+
+            // Tangent
+            Vector3 xyz = (Vector3::RIGHT - normal * normal.DotProduct(Vector3::RIGHT)).Normalized();
+            *vertexData++ = xyz.x_;
+            *vertexData++ = xyz.y_;
+            *vertexData++ = xyz.z_;
+            *vertexData++ = 1.0f;
+        }
+    }
+
+    // Calculate LOD errors
+    int xStart = coords.x_ * patchSize;
+    int zStart = coords.y_ * patchSize;
+    int xEnd = xStart + patchSize;
+    int zEnd = zStart + patchSize;
+
+    geometry.lodErrors_.clear();
+    geometry.lodErrors_.reserve(source.numLodLevels_);
+
+    for (unsigned i = 0; i < source.numLodLevels_; ++i)
+    {
+        float maxError = 0.0f;
+        int divisor = 1u << i;
+
+        if (i > 0)
+        {
+            for (int z = zStart; z <= zEnd; ++z)
+            {
+                for (int x = xStart; x <= xEnd; ++x)
+                {
+                    if (x % divisor || z % divisor)
+                    {
+                        float error = Abs(SampleLodHeight(heightData, numVertices, x, z, i)
+                            - SampleRawHeight(heightData, numVertices, x, z));
+                        maxError = Max(error, maxError);
+                    }
+                }
+            }
+
+            // Set error to be at least same as (half vertex spacing x LOD) to prevent horizontal stretches getting too inaccurate
+            maxError = Max(maxError, 0.25f * (spacing.x_ + spacing.z_) * (float)(1u << i));
+        }
+
+        geometry.lodErrors_.push_back(maxError);
+    }
+}
+
+/// Generate patches from the queue until there are no more patches or generation is cancelled. May be called from any thread.
+static void GenerateQueuedPatches(TerrainPatchQueue& queue, unsigned maxPatches)
+{
+    for (unsigned i = 0; i < maxPatches && !queue.cancelled_; ++i)
+    {
+        const unsigned index = queue.nextPatch_++;
+        if (index >= queue.coordinates_.size())
+            return;
+
+        TerrainPatchGeometry geometry;
+        GeneratePatchGeometry(queue.source_, queue.coordinates_[index], geometry);
+
+        MutexLock lock(queue.mutex_);
+        queue.patches_.push_back(ea::move(geometry));
+        ++queue.numGeneratedPatches_;
+    }
+}
+
 Terrain::Terrain(Context* context) :
     Component(context),
     indexBuffer_(MakeShared<IndexBuffer>(context)),
@@ -88,7 +348,7 @@ Terrain::Terrain(Context* context) :
     patchSize_(DEFAULT_PATCH_SIZE),
     lastPatchSize_(0),
     numLodLevels_(1),
-    maxLodLevels_(MAX_LOD_LEVELS),
+    maxLodLevels_(DEFAULT_MAX_LOD_LEVELS),
     occlusionLodLevel_(M_MAX_UNSIGNED),
     smoothing_(false),
     visible_(true),
@@ -108,12 +368,17 @@ Terrain::Terrain(Context* context) :
     eastID_(0),
     recreateTerrain_(false),
     neighborsDirty_(false),
-    debugGeometry_(false)
+    debugGeometry_(false),
+    asyncPatchGeneration_(false),
+    maxPatchUpdatesPerFrame_(DEFAULT_MAX_PATCH_UPDATES_PER_FRAME)
 {
     indexBuffer_->SetShadowed(true);
 }
 
-Terrain::~Terrain() = default;
+Terrain::~Terrain()
+{
+    CancelPatchGeneration();
+}
 
 void Terrain::RegisterObject(Context* context)
 {
@@ -130,7 +395,7 @@ void Terrain::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE_EX("East Neighbor NodeID", unsigned, eastID_, MarkNeighborsDirty, 0, AM_DEFAULT | AM_NODEID);
     URHO3D_ATTRIBUTE_EX("Vertex Spacing", Vector3, spacing_, MarkTerrainDirty, DEFAULT_SPACING, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Patch Size", GetPatchSize, SetPatchSizeAttr, int, DEFAULT_PATCH_SIZE, AM_DEFAULT);
-    URHO3D_ACCESSOR_ATTRIBUTE("Max LOD Levels", GetMaxLodLevels, SetMaxLodLevelsAttr, unsigned, MAX_LOD_LEVELS, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max LOD Levels", GetMaxLodLevels, SetMaxLodLevelsAttr, unsigned, DEFAULT_MAX_LOD_LEVELS, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Smooth Height Map", bool, smoothing_, MarkTerrainDirty, false, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Is Occluder", IsOccluder, SetOccluder, bool, false, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Can Be Occluded", IsOccludee, SetOccludee, bool, true, AM_DEFAULT);
@@ -147,6 +412,9 @@ void Terrain::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE("Scale in Lightmap", float, scaleInLightmap_, 1.0f, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Lightmap Index", unsigned, lightmapIndex_, UpdatePatchesLightmaps, 0, AM_DEFAULT | AM_NOEDIT);
     URHO3D_ATTRIBUTE_EX("Lightmap Scale & Offset", Vector4, lightmapScaleOffset_, UpdatePatchesLightmaps, Vector4(1.0f, 1.0f, 0.0f, 0.0f), AM_DEFAULT | AM_NOEDIT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Async Patch Generation", GetAsyncPatchGeneration, SetAsyncPatchGeneration, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max Patch Updates Per Frame", GetMaxPatchUpdatesPerFrame, SetMaxPatchUpdatesPerFrame, unsigned,
+        DEFAULT_MAX_PATCH_UPDATES_PER_FRAME, AM_DEFAULT);
 }
 
 void Terrain::ApplyAttributes()
@@ -181,6 +449,13 @@ void Terrain::OnSetEnabled()
     }
 }
 
+void Terrain::OnNodeSet(Node* previousNode, Node* currentNode)
+{
+    // Generated patches can't be applied without the node
+    if (!currentNode)
+        CancelPatchGeneration();
+}
+
 void Terrain::SetPatchSize(int size)
 {
     if (size < MIN_PATCH_SIZE || size > MAX_PATCH_SIZE || !IsPowerOfTwo((unsigned)size))
@@ -470,6 +745,40 @@ void Terrain::SetEnableDebug(bool enable)
     debugGeometry_ = enable;
 }
 
+void Terrain::SetAsyncPatchGeneration(bool enable)
+{
+    if (enable == asyncPatchGeneration_)
+        return;
+
+    asyncPatchGeneration_ = enable;
+
+    // Finish pending work so patches are never left without geometry
+    if (!asyncPatchGeneration_)
+        CompletePatchGeneration();
+}
+
+void Terrain::SetMaxPatchUpdatesPerFrame(unsigned count)
+{
+    maxPatchUpdatesPerFrame_ = Max(count, 1u);
+}
+
+void Terrain::CompletePatchGeneration()
+{
+    if (!patchQueue_)
+        return;
+
+    URHO3D_PROFILE("CompletePatchGeneration");
+
+    // The main thread generates patches not taken by worker threads yet, then waits only for patches of this terrain
+    TerrainPatchQueue& queue = *patchQueue_;
+    GenerateQueuedPatches(queue, M_MAX_UNSIGNED);
+    while (queue.numGeneratedPatches_ < queue.coordinates_.size())
+        std::this_thread::yield();
+
+    ApplyGeneratedPatches(M_MAX_UNSIGNED);
+    URHO3D_ASSERT(!patchQueue_);
+}
+
 void Terrain::ApplyHeightMap()
 {
     if (heightMap_)
@@ -620,132 +929,22 @@ void Terrain::CreatePatchGeometry(TerrainPatch* patch)
 {
     URHO3D_PROFILE("CreatePatchGeometry");
 
-    auto row = (unsigned)(patchSize_ + 1);
-    VertexBuffer* vertexBuffer = patch->GetVertexBuffer();
-    Geometry* geometry = patch->GetGeometry();
-    Geometry* maxLodGeometry = patch->GetMaxLodGeometry();
-    Geometry* occlusionGeometry = patch->GetOcclusionGeometry();
-
-    vertexBuffer->SetDebugName(Format("Terrain patch at {}", patch->GetCoordinates().ToString()));
-
-    // Scale in lightmap is intentionally ignored here
-    // because lightmapper itself needs Terrain with lightmap UV but without lightmapping during rendering
-    VertexMaskFlags vertexMask{ MASK_POSITION | MASK_NORMAL | MASK_TEXCOORD1 | MASK_TANGENT };
-    if (bakeLightmap_)
-        vertexMask |= MASK_TEXCOORD2;
-
-    if (vertexBuffer->GetVertexCount() != row * row || vertexBuffer->GetElementMask() != vertexMask)
-        vertexBuffer->SetSize(row * row, vertexMask);
-
-    ea::shared_array<unsigned char> cpuVertexData(new unsigned char[row * row * sizeof(Vector3)]);
-    ea::shared_array<unsigned char> occlusionCpuVertexData(new unsigned char[row * row * sizeof(Vector3)]);
-
-    auto* vertexData = (float*)vertexBuffer->Map();
-    auto* positionData = (float*)cpuVertexData.get();
-    auto* occlusionData = (float*)occlusionCpuVertexData.get();
-    BoundingBox box;
-
-    unsigned occlusionLevel = occlusionLodLevel_;
-    if (occlusionLevel > numLodLevels_ - 1)
-        occlusionLevel = numLodLevels_ - 1;
-
-    if (vertexData)
-    {
-        const IntVector2& coords = patch->GetCoordinates();
-        unsigned lodExpand = (1u << (occlusionLevel)) - 1;
-        unsigned halfLodExpand = (1u << (occlusionLevel)) / 2;
-
-        for (unsigned z = 0; z <= patchSize_; ++z)
-        {
-            for (unsigned x = 0; x <= patchSize_; ++x)
-            {
-                int xPos = coords.x_ * patchSize_ + x;
-                int zPos = coords.y_ * patchSize_ + z;
-
-                // Position
-                Vector3 position((float)x * spacing_.x_, GetRawHeight(xPos, zPos), (float)z * spacing_.z_);
-                *vertexData++ = position.x_;
-                *vertexData++ = position.y_;
-                *vertexData++ = position.z_;
-                *positionData++ = position.x_;
-                *positionData++ = position.y_;
-                *positionData++ = position.z_;
-
-                box.Merge(position);
-
-                // For vertices that are part of the occlusion LOD, calculate the minimum height in the neighborhood
-                // to prevent false positive occlusion due to inaccuracy between occlusion LOD & visible LOD
-                float minHeight = position.y_;
-                if (halfLodExpand > 0 && (x & lodExpand) == 0 && (z & lodExpand) == 0)
-                {
-                    int minX = Max(xPos - halfLodExpand, 0);
-                    int maxX = Min(xPos + halfLodExpand, numVertices_.x_ - 1);
-                    int minZ = Max(zPos - halfLodExpand, 0);
-                    int maxZ = Min(zPos + halfLodExpand, numVertices_.y_ - 1);
-                    for (int nZ = minZ; nZ <= maxZ; ++nZ)
-                    {
-                        for (int nX = minX; nX <= maxX; ++nX)
-                            minHeight = Min(minHeight, GetRawHeight(nX, nZ));
-                    }
-                }
-                *occlusionData++ = position.x_;
-                *occlusionData++ = minHeight;
-                *occlusionData++ = position.z_;
-
-                // Normal
-                Vector3 normal = GetRawNormal(xPos, zPos);
-                *vertexData++ = normal.x_;
-                *vertexData++ = normal.y_;
-                *vertexData++ = normal.z_;
-
-                // Texture coordinate(s)
-                const Vector2 texCoord = HeightMapToUV({ xPos, numVertices_.y_ - 1 - zPos });
-                *vertexData++ = texCoord.x_;
-                *vertexData++ = texCoord.y_;
-
-                if (bakeLightmap_)
-                {
-                    *vertexData++ = texCoord.x_;
-                    *vertexData++ = texCoord.y_;
-                }
-
-                // Tangent
-                Vector3 xyz = (Vector3::RIGHT - normal * normal.DotProduct(Vector3::RIGHT)).Normalized();
-                *vertexData++ = xyz.x_;
-                *vertexData++ = xyz.y_;
-                *vertexData++ = xyz.z_;
-                *vertexData++ = 1.0f;
-            }
-        }
-
-        vertexBuffer->Unmap();
-        vertexBuffer->ClearDataLost();
-    }
-
-    patch->SetBoundingBox(box);
-
-    if (drawRanges_.size())
-    {
-        unsigned occlusionDrawRange = occlusionLevel << 4u;
-
-        geometry->SetIndexBuffer(indexBuffer_);
-        geometry->SetDrawRange(TRIANGLE_LIST, drawRanges_[0].first, drawRanges_[0].second, false);
-        geometry->SetRawVertexData(cpuVertexData, MASK_POSITION);
-        maxLodGeometry->SetIndexBuffer(indexBuffer_);
-        maxLodGeometry->SetDrawRange(TRIANGLE_LIST, drawRanges_[0].first, drawRanges_[0].second, false);
-        maxLodGeometry->SetRawVertexData(cpuVertexData, MASK_POSITION);
-        occlusionGeometry->SetIndexBuffer(indexBuffer_);
-        occlusionGeometry->SetDrawRange(TRIANGLE_LIST, drawRanges_[occlusionDrawRange].first, drawRanges_[occlusionDrawRange].second, false);
-        occlusionGeometry->SetRawVertexData(occlusionCpuVertexData, MASK_POSITION);
-    }
+    TerrainGeometrySource source;
+    FillGeometrySource(source);
 
-    patch->ResetLod();
+    TerrainPatchGeometry geometry;
+    GeneratePatchGeometry(source, patch->GetCoordinates(), geometry);
+    ApplyPatchGeometry(patch, geometry);
 }
 
 void Terrain::UpdatePatchLod(TerrainPatch* patch)
 {
     Geometry* geometry = patch->GetGeometry();
 
+    // Patch may be still waiting for asynchronously generated geometry
+    if (!geometry->GetIndexBuffer())
+        return;
+
     // All LOD levels except the coarsest have 16 versions for stitching
     unsigned lodLevel = patch->GetLodLevel();
     unsigned drawRangeIndex = lodLevel << 4u;
@@ -857,6 +1056,11 @@ void Terrain::CreateGeometry()
 
     URHO3D_PROFILE("CreateTerrainGeometry");
 
+    // Background generation uses old terrain parameters, so it is restarted for the patches that are still pending
+    CancelPatchGeneration();
+    const ea::unordered_set<IntVector2> pendingPatches = ea::move(pendingPatches_);
+    pendingPatches_.clear();
+
     unsigned prevNumPatches = patches_.size();
 
     // Determine number of LOD levels
@@ -1022,6 +1226,12 @@ void Terrain::CreateGeometry()
             }
         }
 
+        for (const IntVector2& coords : pendingPatches)
+        {
+            if (coords.x_ < numPatches_.x_ && coords.y_ < numPatches_.y_)
+                dirtyPatches[coords.y_ * numPatches_.x_ + coords.x_] = true;
+        }
+
         patches_.reserve((unsigned) (numPatches_.x_ * numPatches_.y_));
 
         bool enabled = IsEnabledEffective();
@@ -1120,18 +1330,18 @@ void Terrain::CreateGeometry()
             }
         }
 
+        ea::vector<TerrainPatch*> patchesToUpdate;
         for (unsigned i = 0; i < patches_.size(); ++i)
         {
             TerrainPatch* patch = patches_[i];
 
             if (dirtyPatches[i])
-            {
-                CreatePatchGeometry(patch);
-                CalculateLodErrors(patch);
-            }
+                patchesToUpdate.push_back(patch);
 
             SetPatchNeighbors(patch);
         }
+
+        UpdatePatchGeometries(patchesToUpdate);
     }
 
     // Send event only if new geometry was generated, or the old was cleared
@@ -1307,12 +1517,7 @@ void Terrain::CreateIndexData()
 
 float Terrain::GetRawHeight(int x, int z) const
 {
-    if (!heightData_)
-        return 0.0f;
-
-    x = Clamp(x, 0, numVertices_.x_ - 1);
-    z = Clamp(z, 0, numVertices_.y_ - 1);
-    return heightData_[z * numVertices_.x_ + x];
+    return SampleRawHeight(heightData_.get(), numVertices_, x, z);
 }
 
 float Terrain::GetSourceHeight(int x, int z) const
@@ -1325,93 +1530,175 @@ float Terrain::GetSourceHeight(int x, int z) const
     return sourceHeightData_[z * numVertices_.x_ + x];
 }
 
-float Terrain::GetLodHeight(int x, int z, unsigned lodLevel) const
+Vector3 Terrain::GetRawNormal(int x, int z) const
 {
-    unsigned offset = 1u << lodLevel;
-    auto xFrac = (float)(x % offset) / offset;
-    auto zFrac = (float)(z % offset) / offset;
-    float h1, h2, h3;
+    return SampleRawNormal(heightData_.get(), numVertices_, spacing_, x, z);
+}
 
-    if (xFrac + zFrac >= 1.0f)
-    {
-        h1 = GetRawHeight(x + offset, z + offset);
-        h2 = GetRawHeight(x, z + offset);
-        h3 = GetRawHeight(x + offset, z);
-        xFrac = 1.0f - xFrac;
-        zFrac = 1.0f - zFrac;
-    }
-    else
+void Terrain::FillGeometrySource(TerrainGeometrySource& source) const
+{
+    source.heightData_ = heightData_;
+    source.numVertices_ = numVertices_;
+    source.spacing_ = spacing_;
+    source.patchSize_ = patchSize_;
+    source.numLodLevels_ = numLodLevels_;
+    source.occlusionLodLevel_ = Min(occlusionLodLevel_, numLodLevels_ - 1);
+    source.bakeLightmap_ = bakeLightmap_;
+}
+
+void Terrain::ApplyPatchGeometry(TerrainPatch* patch, const TerrainPatchGeometry& geometry)
+{
+    auto row = (unsigned)(patchSize_ + 1);
+    VertexBuffer* vertexBuffer = patch->GetVertexBuffer();
+    Geometry* patchGeometry = patch->GetGeometry();
+    Geometry* maxLodGeometry = patch->GetMaxLodGeometry();
+    Geometry* occlusionGeometry = patch->GetOcclusionGeometry();
+
+    vertexBuffer->SetDebugName(Format("Terrain patch at {}", patch->GetCoordinates().ToString()));
+
+    if (vertexBuffer->GetVertexCount() != row * row || vertexBuffer->GetElementMask() != geometry.vertexMask_)
+        vertexBuffer->SetSize(row * row, geometry.vertexMask_);
+    vertexBuffer->Update(geometry.vertexData_.data());
+
+    patch->SetBoundingBox(geometry.boundingBox_);
+
+    if (drawRanges_.size())
     {
-        h1 = GetRawHeight(x, z);
-        h2 = GetRawHeight(x + offset, z);
-        h3 = GetRawHeight(x, z + offset);
+        unsigned occlusionDrawRange = Min(occlusionLodLevel_, numLodLevels_ - 1) << 4u;
+
+        patchGeometry->SetIndexBuffer(indexBuffer_);
+        patchGeometry->SetDrawRange(TRIANGLE_LIST, drawRanges_[0].first, drawRanges_[0].second, false);
+        patchGeometry->SetRawVertexData(geometry.positionData_, MASK_POSITION);
+        maxLodGeometry->SetIndexBuffer(indexBuffer_);
+        maxLodGeometry->SetDrawRange(TRIANGLE_LIST, drawRanges_[0].first, drawRanges_[0].second, false);
+        maxLodGeometry->SetRawVertexData(geometry.positionData_, MASK_POSITION);
+        occlusionGeometry->SetIndexBuffer(indexBuffer_);
+        occlusionGeometry->SetDrawRange(TRIANGLE_LIST, drawRanges_[occlusionDrawRange].first, drawRanges_[occlusionDrawRange].second, false);
+        occlusionGeometry->SetRawVertexData(geometry.occlusionPositionData_, MASK_POSITION);
     }
 
-    return h1 * (1.0f - xFrac - zFrac) + h2 * xFrac + h3 * zFrac;
+    patch->GetLodErrors() = geometry.lodErrors_;
+    patch->ResetLod();
 }
 
-Vector3 Terrain::GetRawNormal(int x, int z) const
+void Terrain::UpdatePatchGeometries(const ea::vector<TerrainPatch*>& patches)
 {
-    float baseHeight = GetRawHeight(x, z);
-    float nSlope = GetRawHeight(x, z - 1) - baseHeight;
-    float neSlope = GetRawHeight(x + 1, z - 1) - baseHeight;
-    float eSlope = GetRawHeight(x + 1, z) - baseHeight;
-    float seSlope = GetRawHeight(x + 1, z + 1) - baseHeight;
-    float sSlope = GetRawHeight(x, z + 1) - baseHeight;
-    float swSlope = GetRawHeight(x - 1, z + 1) - baseHeight;
-    float wSlope = GetRawHeight(x - 1, z) - baseHeight;
-    float nwSlope = GetRawHeight(x - 1, z - 1) - baseHeight;
-    float up = 0.5f * (spacing_.x_ + spacing_.z_);
+    if (patches.empty())
+        return;
 
-    return (Vector3(0.0f, up, nSlope) +
-            Vector3(-neSlope, up, neSlope) +
-            Vector3(-eSlope, up, 0.0f) +
-            Vector3(-seSlope, up, -seSlope) +
-            Vector3(0.0f, up, -sSlope) +
-            Vector3(swSlope, up, -swSlope) +
-            Vector3(wSlope, up, 0.0f) +
-            Vector3(nwSlope, up, nwSlope)).Normalized();
-}
+    auto workQueue = GetSubsystem<WorkQueue>();
 
-void Terrain::CalculateLodErrors(TerrainPatch* patch)
-{
-    URHO3D_PROFILE("CalculateLodErrors");
+    // Generate patches in worker threads, results are applied in the frame updates
+    if (asyncPatchGeneration_ && workQueue && workQueue->IsMultithreaded())
+    {
+        auto queue = MakeShared<TerrainPatchQueue>();
+        FillGeometrySource(queue->source_);
+        patchQueue_ = queue;
 
-    const IntVector2& coords = patch->GetCoordinates();
-    ea::vector<float>& lodErrors = patch->GetLodErrors();
-    lodErrors.clear();
-    lodErrors.reserve(numLodLevels_);
+        for (TerrainPatch* patch : patches)
+        {
+            queue->coordinates_.push_back(patch->GetCoordinates());
+            pendingPatches_.insert(patch->GetCoordinates());
+        }
 
-    int xStart = coords.x_ * patchSize_;
-    int zStart = coords.y_ * patchSize_;
-    int xEnd = xStart + patchSize_;
-    int zEnd = zStart + patchSize_;
+        // Each task takes next patches from the queue, so the tasks are interchangeable
+        for (unsigned begin = 0; begin < patches.size(); begin += NUM_PATCHES_PER_TASK)
+            workQueue->PostTask([queue]() { GenerateQueuedPatches(*queue, NUM_PATCHES_PER_TASK); }, TaskPriority::Low);
 
-    for (unsigned i = 0; i < numLodLevels_; ++i)
+        SubscribeToEvent(E_UPDATE, URHO3D_HANDLER(Terrain, HandleUpdate));
+        return;
+    }
+
+    TerrainGeometrySource source;
+    FillGeometrySource(source);
+
+    // Generate patches in parallel and apply them in the main thread, in batches to limit memory usage
+    ea::vector<TerrainPatchGeometry> geometries;
+    for (unsigned begin = 0; begin < patches.size(); begin += NUM_PATCHES_PER_BATCH)
     {
-        float maxError = 0.0f;
-        int divisor = 1u << i;
+        const unsigned end = Min(begin + NUM_PATCHES_PER_BATCH, patches.size());
+        geometries.resize(end - begin);
 
-        if (i > 0)
         {
-            for (int z = zStart; z <= zEnd; ++z)
+            URHO3D_PROFILE("GeneratePatchGeometry");
+
+            const auto generate = [&](unsigned beginIndex, unsigned endIndex)
             {
-                for (int x = xStart; x <= xEnd; ++x)
-                {
-                    if (x % divisor || z % divisor)
-                    {
-                        float error = Abs(GetLodHeight(x, z, i) - GetRawHeight(x, z));
-                        maxError = Max(error, maxError);
-                    }
-                }
-            }
+                for (unsigned i = beginIndex; i < endIndex; ++i)
+                    GeneratePatchGeometry(source, patches[begin + i]->GetCoordinates(), geometries[i]);
+            };
+
+            if (workQueue)
+                ForEachParallel(workQueue, 1, geometries.size(), generate);
+            else
+                generate(0, geometries.size());
+        }
 
-            // Set error to be at least same as (half vertex spacing x LOD) to prevent horizontal stretches getting too inaccurate
-            maxError = Max(maxError, 0.25f * (spacing_.x_ + spacing_.z_) * (float)(1u << i));
+        URHO3D_PROFILE("ApplyPatchGeometry");
+
+        for (unsigned i = begin; i < end; ++i)
+            ApplyPatchGeometry(patches[i], geometries[i - begin]);
+    }
+}
+
+void Terrain::ApplyGeneratedPatches(unsigned maxPatches)
+{
+    if (!patchQueue_)
+        return;
+
+    URHO3D_PROFILE("ApplyGeneratedPatches");
+
+    ea::vector<TerrainPatchGeometry> geometries;
+    {
+        TerrainPatchQueue& queue = *patchQueue_;
+        MutexLock lock(queue.mutex_);
+        if (queue.patches_.size() <= maxPatches)
+            ea::swap(geometries, queue.patches_);
+        else
+        {
+            const auto end = queue.patches_.begin() + maxPatches;
+            geometries.assign(ea::make_move_iterator(queue.patches_.begin()), ea::make_move_iterator(end));
+            queue.patches_.erase(queue.patches_.begin(), end);
         }
+    }
 
-        lodErrors.push_back(maxError);
+    for (const TerrainPatchGeometry& geometry : geometries)
+    {
+        pendingPatches_.erase(geometry.coordinates_);
+        if (TerrainPatch* patch = GetPatch(geometry.coordinates_.x_, geometry.coordinates_.y_))
+            ApplyPatchGeometry(patch, geometry);
+    }
+
+    if (pendingPatches_.empty())
+    {
+        patchQueue_ = nullptr;
+        UnsubscribeFromEvent(E_UPDATE);
+    }
+}
+
+void Terrain::CancelPatchGeneration()
+{
+    if (!patchQueue_)
+        return;
+
+    patchQueue_->cancelled_ = true;
+
+    // Worker threads may still read the height data, so the terrain should not modify it in place anymore
+    if (heightData_ && heightData_ == patchQueue_->source_.heightData_)
+    {
+        const unsigned dataSize = numVertices_.x_ * numVertices_.y_;
+        ea::shared_array<float> heightData(new float[dataSize]);
+        ea::copy(heightData_.get(), heightData_.get() + dataSize, heightData.get());
+        heightData_ = heightData;
     }
+
+    patchQueue_ = nullptr;
+    UnsubscribeFromEvent(E_UPDATE);
+}
+
+void Terrain::HandleUpdate(StringHash /*eventType*/, VariantMap& /*eventData*/)
+{
+    ApplyGeneratedPatches(maxPatchUpdatesPerFrame_);
 }
 
 void Terrain::SetPatchNeighbors(TerrainPatch* patch)
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <EASTL/shared_array.h>
+#include <EASTL/unordered_set.h>
 
 #include "../Scene/Component.h"
 
@@ -34,6 +35,9 @@ class IndexBuffer;
 class Material;
 class Node;
 class TerrainPatch;
+struct TerrainGeometrySource;
+struct TerrainPatchGeometry;
+struct TerrainPatchQueue;
 
 /// Heightmap terrain component.
 class URHO3D_API Terrain : public Component
@@ -62,7 +66,7 @@ public:
     /// Set vertex (XZ) and height (Y) spacing.
     /// @property
     void SetSpacing(const Vector3& spacing);
-    /// Set maximum number of LOD levels for terrain patches. This can be between 1-4.
+    /// Set maximum number of LOD levels for terrain patches. This can be between 1-6. The actual number of levels is also limited by the patch size.
     /// @property
     void SetMaxLodLevels(unsigned levels);
     /// Set LOD level used for terrain patch occlusion. By default (M_MAX_UNSIGNED) the coarsest. Since the LOD level used needs to be fixed, using finer LOD levels may result in false positive occlusion in cases where the actual rendered geometry is coarser, so use with caution.
@@ -125,6 +129,14 @@ public:
     void SetEnableDebug(bool enable);
     /// Apply changes from the heightmap image.
     void ApplyHeightMap();
+    /// Set whether patch geometry is generated in worker threads and applied over several frames. When disabled, patch geometry is generated immediately, still using all worker threads.
+    /// @property
+    void SetAsyncPatchGeneration(bool enable);
+    /// Set maximum number of asynchronously generated patches applied per frame.
+    /// @property
+    void SetMaxPatchUpdatesPerFrame(unsigned count);
+    /// Wait until all asynchronously generated patches are ready and apply them.
+    void CompletePatchGeneration();
 
     /// Return patch quads per side.
     /// @property
@@ -142,7 +154,7 @@ public:
     /// @property
     const IntVector2& GetNumPatches() const { return numPatches_; }
 
-    /// Return maximum number of LOD levels for terrain patches. This can be between 1-4.
+    /// Return maximum number of LOD levels for terrain patches. This can be between 1-6.
     /// @property
     unsigned GetMaxLodLevels() const { return maxLodLevels_; }
 
@@ -154,6 +166,17 @@ public:
     /// @property
     bool GetSmoothing() const { return smoothing_; }
 
+    /// Return whether patch geometry is generated asynchronously.
+    /// @property
+    bool GetAsyncPatchGeneration() const { return asyncPatchGeneration_; }
+
+    /// Return maximum number of asynchronously generated patches applied per frame.
+    /// @property
+    unsigned GetMaxPatchUpdatesPerFrame() const { return maxPatchUpdatesPerFrame_; }
+
+    /// Return number of patches waiting for asynchronously generated geometry.
+    unsigned GetNumPendingPatches() const { return pendingPatches_.size(); }
+
     /// Return heightmap image.
     /// @property
     Image* GetHeightMap() const;
@@ -281,6 +304,10 @@ public:
     /// Return lightmap scale and offset.
     const Vector4& GetLightmapScaleOffset() const { return lightmapScaleOffset_; }
 
+protected:
+    /// Handle node being assigned.
+    void OnNodeSet(Node* previousNode, Node* currentNode) override;
+
 private:
     /// Regenerate terrain geometry.
     void CreateGeometry();
@@ -290,12 +317,20 @@ private:
     float GetRawHeight(int x, int z) const;
     /// Return a source terrain height value, clamping to edges. The source data is used for smoothing.
     float GetSourceHeight(int x, int z) const;
-    /// Return interpolated height for a specific LOD level.
-    float GetLodHeight(int x, int z, unsigned lodLevel) const;
     /// Get slope-based terrain normal at position.
     Vector3 GetRawNormal(int x, int z) const;
-    /// Calculate LOD errors for a patch.
-    void CalculateLodErrors(TerrainPatch* patch);
+    /// Fill terrain parameters needed to generate patch geometry outside of the main thread.
+    void FillGeometrySource(TerrainGeometrySource& source) const;
+    /// Apply generated vertex data, bounding box and LOD errors to a patch.
+    void ApplyPatchGeometry(TerrainPatch* patch, const TerrainPatchGeometry& geometry);
+    /// Regenerate geometry of patches, either immediately or in worker threads.
+    void UpdatePatchGeometries(const ea::vector<TerrainPatch*>& patches);
+    /// Apply asynchronously generated patches that are ready.
+    void ApplyGeneratedPatches(unsigned maxPatches);
+    /// Stop asynchronous patch generation. Patches not generated yet stay pending.
+    void CancelPatchGeneration();
+    /// Handle frame update when asynchronous patch generation is in progress.
+    void HandleUpdate(StringHash eventType, VariantMap& eventData);
     /// Set neighbors for a patch.
     void SetPatchNeighbors(TerrainPatch* patch);
     /// Set heightmap image and optionally recreate the geometry immediately. Return true if successful.
@@ -405,6 +440,14 @@ private:
     bool neighborsDirty_;
     /// Enables vertex buffer shadowing.
     bool debugGeometry_;
+    /// Whether patch geometry is generated asynchronously.
+    bool asyncPatchGeneration_;
+    /// Maximum number of asynchronously generated patches applied per frame.
+    unsigned maxPatchUpdatesPerFrame_;
+    /// Patch geometry generated in worker threads.
+    SharedPtr<TerrainPatchQueue> patchQueue_;
+    /// Coordinates of patches waiting for asynchronously generated geometry.
+    ea::unordered_set<IntVector2> pendingPatches_;
 };
 
 }
@@ -24,6 +24,10 @@
 
 #include "../Math/Frustum.h"
 
+#ifdef URHO3D_SSE
+    #include <xmmintrin.h>
+#endif
+
 #include "../DebugNew.h"
 
 namespace Urho3D
@@ -222,6 +226,67 @@ Rect Frustum::Projected(const Matrix4& projection) const
     return rect;
 }
 
+void Frustum::AreInsideFast(ea::span<const BoundingBox> boxes, ea::span<bool> result) const
+{
+    assert(boxes.size() == result.size());
+
+    const unsigned numBoxes = boxes.size();
+    unsigned index = 0;
+
+#ifdef URHO3D_SSE
+    static_assert(sizeof(BoundingBox) == 8 * sizeof(float), "BoundingBox is expected to be padded to 8 floats");
+
+    const __m128 half = _mm_set1_ps(0.5f);
+    for (; index + 4 <= numBoxes; index += 4)
+    {
+        // Load four boxes and convert them to SoA layout
+        __m128 minX = _mm_loadu_ps(&boxes[index].min_.x_);
+        __m128 minY = _mm_loadu_ps(&boxes[index + 1].min_.x_);
+        __m128 minZ = _mm_loadu_ps(&boxes[index + 2].min_.x_);
+        __m128 minW = _mm_loadu_ps(&boxes[index + 3].min_.x_);
+        _MM_TRANSPOSE4_PS(minX, minY, minZ, minW);
+
+        __m128 maxX = _mm_loadu_ps(&boxes[index].max_.x_);
+        __m128 maxY = _mm_loadu_ps(&boxes[index + 1].max_.x_);
+        __m128 maxZ = _mm_loadu_ps(&boxes[index + 2].max_.x_);
+        __m128 maxW = _mm_loadu_ps(&boxes[index + 3].max_.x_);
+        _MM_TRANSPOSE4_PS(maxX, maxY, maxZ, maxW);
+
+        const __m128 centerX = _mm_mul_ps(_mm_add_ps(minX, maxX), half);
+        const __m128 centerY = _mm_mul_ps(_mm_add_ps(minY, maxY), half);
+        const __m128 centerZ = _mm_mul_ps(_mm_add_ps(minZ, maxZ), half);
+        const __m128 edgeX = _mm_sub_ps(centerX, minX);
+        const __m128 edgeY = _mm_sub_ps(centerY, minY);
+        const __m128 edgeZ = _mm_sub_ps(centerZ, minZ);
+
+        __m128 outside = _mm_setzero_ps();
+        for (const auto& plane : planes_)
+        {
+            const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(_mm_set1_ps(plane.normal_.x_), centerX),
+                _mm_mul_ps(_mm_set1_ps(plane.normal_.y_), centerY)),
+                _mm_mul_ps(_mm_set1_ps(plane.normal_.z_), centerZ)),
+                _mm_set1_ps(plane.d_));
+            const __m128 absDist = _mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(_mm_set1_ps(plane.absNormal_.x_), edgeX),
+                _mm_mul_ps(_mm_set1_ps(plane.absNormal_.y_), edgeY)),
+                _mm_mul_ps(_mm_set1_ps(plane.absNormal_.z_), edgeZ));
+
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, _mm_sub_ps(_mm_setzero_ps(), absDist)));
+        }
+
+        const int outsideMask = _mm_movemask_ps(outside);
+        result[index] = (outsideMask & 0x1) == 0;
+        result[index + 1] = (outsideMask & 0x2) == 0;
+        result[index + 2] = (outsideMask & 0x4) == 0;
+        result[index + 3] = (outsideMask & 0x8) == 0;
+    }
+#endif
+
+    for (; index < numBoxes; ++index)
+        result[index] = IsInsideFast(boxes[index]) != OUTSIDE;
+}
+
 void Frustum::UpdatePlanes()
 {
     planes_[PLANE_NEAR].Define(vertices_[2], vertices_[1], vertices_[0]);
@@ -30,6 +30,8 @@
 #include "../Math/Rect.h"
 #include "../Math/Sphere.h"
 
+#include <EASTL/span.h>
+
 namespace Urho3D
 {
 
@@ -158,6 +160,11 @@ public:
         return INSIDE;
     }
 
+    /// Test if bounding boxes are (partially) inside or outside. Equivalent to IsInsideFast for each box.
+    /// Result is true if the box is not outside. Boxes are processed in groups of four if SIMD is enabled.
+    /// @nobind
+    void AreInsideFast(ea::span<const BoundingBox> boxes, ea::span<bool> result) const;
+
     /// Return distance of a point to the frustum, or 0 if inside.
     float Distance(const Vector3& point) const
     {
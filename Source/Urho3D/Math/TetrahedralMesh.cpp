@@ -269,26 +269,130 @@ Vector4 TetrahedralMesh::GetInterpolationFactors(const Vector3& position, unsign
     if (tetrahedrons_.empty())
         return Vector4::ZERO;
 
+    // Number of steps to walk from the hint before falling back to lookup grid
+    static const unsigned maxHintSteps = 8;
+
     const unsigned maxIters = tetrahedrons_.size();
-    if (tetIndexHint >= maxIters)
+    Vector4 weights;
+    if (!lookupGrid_.empty())
+    {
+        if (tetIndexHint < maxIters && WalkToPosition(position, tetIndexHint, weights, maxHintSteps))
+            return weights;
+        tetIndexHint = GetLookupGridTetrahedron(position);
+    }
+    else if (tetIndexHint >= maxIters)
         tetIndexHint = 0;
 
-    for (unsigned i = 0; i < maxIters; ++i)
+    WalkToPosition(position, tetIndexHint, weights, maxIters);
+    return weights;
+}
+
+void TetrahedralMesh::GetInterpolationFactors(ea::span<const Vector3> positions,
+    ea::span<unsigned> tetIndexHints, ea::span<Vector4> weights) const
+{
+    assert(positions.size() == tetIndexHints.size() && positions.size() == weights.size());
+
+    const unsigned numPositions = positions.size();
+    if (numPositions == 0)
+        return;
+
+    // Sort positions along Z-order curve so consecutive lookups are close
+    const BoundingBox boundingBox(positions.data(), numPositions);
+    const Vector3 scale = VectorMax(Vector3::ONE * M_EPSILON, boundingBox.Size());
+    const auto getMortonCode = [&](const Vector3& position)
+    {
+        const Vector3 normalized = (position - boundingBox.min_) / scale;
+        unsigned code = 0;
+        const unsigned x = static_cast<unsigned>(Clamp(normalized.x_, 0.0f, 1.0f) * 1023.0f);
+        const unsigned y = static_cast<unsigned>(Clamp(normalized.y_, 0.0f, 1.0f) * 1023.0f);
+        const unsigned z = static_cast<unsigned>(Clamp(normalized.z_, 0.0f, 1.0f) * 1023.0f);
+        for (unsigned bit = 0; bit < 10; ++bit)
+        {
+            code |= ((x >> bit) & 1u) << (3 * bit);
+            code |= ((y >> bit) & 1u) << (3 * bit + 1);
+            code |= ((z >> bit) & 1u) << (3 * bit + 2);
+        }
+        return code;
+    };
+
+    ea::vector<ea::pair<unsigned, unsigned>> sortedPositions(numPositions);
+    for (unsigned i = 0; i < numPositions; ++i)
+        sortedPositions[i] = { getMortonCode(positions[i]), i };
+    ea::sort(sortedPositions.begin(), sortedPositions.end());
+
+    // Use previous result as hint if position doesn't have valid hint
+    unsigned previousTetIndex = M_MAX_UNSIGNED;
+    for (const auto& [code, index] : sortedPositions)
+    {
+        unsigned& tetIndexHint = tetIndexHints[index];
+        if (tetIndexHint >= tetrahedrons_.size())
+            tetIndexHint = previousTetIndex;
+
+        weights[index] = GetInterpolationFactors(positions[index], tetIndexHint);
+        previousTetIndex = tetIndexHint;
+    }
+}
+
+void TetrahedralMesh::BuildLookupGrid(unsigned maxGridSize)
+{
+    lookupGrid_.clear();
+    if (tetrahedrons_.empty() || vertices_.empty() || maxGridSize == 0)
+        return;
+
+    lookupGridBox_ = BoundingBox(vertices_.data(), vertices_.size());
+    const Vector3 size = VectorMax(Vector3::ONE * M_EPSILON, lookupGridBox_.Size());
+    const float cellSize = ea::max({ size.x_, size.y_, size.z_ }) / maxGridSize;
+    lookupGridSize_ = VectorMax(IntVector3::ONE, VectorCeilToInt(size / cellSize));
+    lookupGridSize_ = VectorMin(lookupGridSize_, IntVector3::ONE * static_cast<int>(maxGridSize));
+
+    const Vector3 gridSize = lookupGridSize_.ToVector3();
+    const Vector3 cellExtent = size / gridSize;
+
+    // Walk to the center of each cell from the previous one
+    unsigned tetIndex = 0;
+    Vector4 weights;
+    lookupGrid_.resize(lookupGridSize_.x_ * lookupGridSize_.y_ * lookupGridSize_.z_);
+    for (int z = 0; z < lookupGridSize_.z_; ++z)
+    {
+        for (int y = 0; y < lookupGridSize_.y_; ++y)
+        {
+            for (int x = 0; x < lookupGridSize_.x_; ++x)
+            {
+                const Vector3 cellCenter = lookupGridBox_.min_ + (IntVector3{ x, y, z }.ToVector3() + Vector3::ONE * 0.5f) * cellExtent;
+                WalkToPosition(cellCenter, tetIndex, weights, tetrahedrons_.size());
+                lookupGrid_[(z * lookupGridSize_.y_ + y) * lookupGridSize_.x_ + x] = tetIndex;
+            }
+        }
+    }
+}
+
+bool TetrahedralMesh::WalkToPosition(const Vector3& position, unsigned& tetIndex, Vector4& weights, unsigned maxSteps) const
+{
+    for (unsigned i = 0; i < maxSteps; ++i)
     {
-        const Vector4 weights = GetBarycentricCoords(tetIndexHint, position);
+        weights = GetBarycentricCoords(tetIndex, position);
         if (weights.x_ >= 0.0f && weights.y_ >= 0.0f && weights.z_ >= 0.0f && weights.w_ >= 0.0f)
-            return weights;
+            return true;
 
         if (weights.x_ < weights.y_ && weights.x_ < weights.z_ && weights.x_ < weights.w_)
-            tetIndexHint = tetrahedrons_[tetIndexHint].neighbors_[0];
+            tetIndex = tetrahedrons_[tetIndex].neighbors_[0];
         else if (weights.y_ < weights.z_ && weights.y_ < weights.w_)
-            tetIndexHint = tetrahedrons_[tetIndexHint].neighbors_[1];
+            tetIndex = tetrahedrons_[tetIndex].neighbors_[1];
         else if (weights.z_ < weights.w_)
-            tetIndexHint = tetrahedrons_[tetIndexHint].neighbors_[2];
+            tetIndex = tetrahedrons_[tetIndex].neighbors_[2];
         else
-            tetIndexHint = tetrahedrons_[tetIndexHint].neighbors_[3];
+            tetIndex = tetrahedrons_[tetIndex].neighbors_[3];
     }
-    return GetBarycentricCoords(tetIndexHint, position);
+    weights = GetBarycentricCoords(tetIndex, position);
+    return false;
+}
+
+unsigned TetrahedralMesh::GetLookupGridTetrahedron(const Vector3& position) const
+{
+    const Vector3 normalized = (position - lookupGridBox_.min_) / VectorMax(Vector3::ONE * M_EPSILON, lookupGridBox_.Size());
+    const IntVector3 cell = VectorMin(VectorMax(IntVector3::ZERO,
+        VectorFloorToInt(normalized * lookupGridSize_.ToVector3())), lookupGridSize_ - IntVector3::ONE);
+    return lookupGrid_[(cell.z_ * lookupGridSize_.y_ + cell.y_) * lookupGridSize_.x_ + cell.x_];
 }
 
 int TetrahedralMesh::SolveCubicEquation(double result[], double a, double b, double c, double eps)
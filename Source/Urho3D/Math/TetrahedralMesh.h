@@ -320,6 +320,14 @@ public:
 
     /// Find tetrahedron containing given position and calculate barycentric coordinates within this tetrahedron.
     Vector4 GetInterpolationFactors(const Vector3& position, unsigned& tetIndexHint) const;
+    /// Find tetrahedrons and calculate barycentric coordinates for multiple positions.
+    /// Positions are processed in spatially coherent order. Hints are updated with found tetrahedrons.
+    void GetInterpolationFactors(ea::span<const Vector3> positions,
+        ea::span<unsigned> tetIndexHints, ea::span<Vector4> weights) const;
+
+    /// Build uniform grid of tetrahedrons used as starting points of the search.
+    /// Speeds up search for positions far from the hint. Grid has up to given number of cells along each axis.
+    void BuildLookupGrid(unsigned maxGridSize);
 
     /// Sample value at given position from the arbitrary container of per-vertex data.
     template <class Container>
@@ -353,6 +361,11 @@ private:
         const Vector3& p1, const Vector3& p2, const Vector3& p3);
     /// Find tetrahedron for given position. Ignore removed tetrahedrons. Return invalid index if cannot find.
     unsigned FindTetrahedron(const Vector3& position, ea::vector<bool>& removed) const;
+    /// Walk from given tetrahedron towards given position for at most given number of steps.
+    /// Return whether the tetrahedron containing the position is found.
+    bool WalkToPosition(const Vector3& position, unsigned& tetIndex, Vector4& weights, unsigned maxSteps) const;
+    /// Return tetrahedron from lookup grid closest to given position.
+    unsigned GetLookupGridTetrahedron(const Vector3& position) const;
 
     /// Number of initial super-mesh vertices.
     static const unsigned NumSuperMeshVertices = 8;
@@ -424,6 +437,13 @@ public:
     /// Number of inner tetrahedrons.
     unsigned numInnerTetrahedrons_{};
 
+    /// Bounding box of lookup grid.
+    BoundingBox lookupGridBox_;
+    /// Number of lookup grid cells along each axis.
+    IntVector3 lookupGridSize_;
+    /// Tetrahedron near the center of each lookup grid cell. Empty if there's no lookup grid.
+    ea::vector<unsigned> lookupGrid_;
+
     /// Debug array of edges related to errors in generation.
     mutable ea::vector<ea::pair<unsigned, unsigned>> debugHighlightEdges_;
 };
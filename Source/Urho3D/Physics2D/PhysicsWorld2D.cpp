@@ -24,6 +24,7 @@
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/Renderer.h"
@@ -45,6 +46,35 @@ static const Vector2 DEFAULT_GRAVITY(0.0f, -9.81f);
 static const int DEFAULT_VELOCITY_ITERATIONS = 8;
 static const int DEFAULT_POSITION_ITERATIONS = 3;
 
+/// Fill contact report record from Box2D contact.
+static ea::tuple<const b2Fixture*, int, const b2Fixture*, int> GetContactKey(b2Contact* contact)
+{
+    return {contact->GetFixtureA(), contact->GetChildIndexA(), contact->GetFixtureB(), contact->GetChildIndexB()};
+}
+
+static void FillContact(PhysicsContact2D& result, PhysicsContactType2D type, b2Contact* contact)
+{
+    b2Fixture* fixtureA = contact->GetFixtureA();
+    b2Fixture* fixtureB = contact->GetFixtureB();
+    result.type_ = type;
+    result.bodyA_ = static_cast<RigidBody2D*>(fixtureA->GetBody()->GetUserData());
+    result.bodyB_ = static_cast<RigidBody2D*>(fixtureB->GetBody()->GetUserData());
+    result.shapeA_ = static_cast<CollisionShape2D*>(fixtureA->GetUserData());
+    result.shapeB_ = static_cast<CollisionShape2D*>(fixtureB->GetUserData());
+
+    b2WorldManifold worldManifold;
+    contact->GetWorldManifold(&worldManifold);
+    result.numPoints_ = contact->GetManifold()->pointCount;
+    // World manifold is not initialized for contacts without points
+    result.worldNormal_ =
+        result.numPoints_ > 0 ? Vector2(worldManifold.normal.x, worldManifold.normal.y) : Vector2::ZERO;
+    for (int i = 0; i < result.numPoints_; ++i)
+    {
+        result.worldPositions_[i] = Vector2(worldManifold.points[i].x, worldManifold.points[i].y);
+        result.separations_[i] = worldManifold.separations[i];
+    }
+}
+
 PhysicsWorld2D::PhysicsWorld2D(Context* context) :
     Component(context),
     gravity_(DEFAULT_GRAVITY),
@@ -88,6 +118,9 @@ void PhysicsWorld2D::RegisterObject(Context* context)
         AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Position Iterations", GetPositionIterations, SetPositionIterations, int, DEFAULT_POSITION_ITERATIONS,
         AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Contact Events", GetContactEventsEnabled, SetContactEventsEnabled, bool, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Contact Report", GetContactReportEnabled, SetContactReportEnabled, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Multi Threaded", IsMultiThreaded, SetMultiThreaded, bool, false, AM_DEFAULT);
 }
 
 void PhysicsWorld2D::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
@@ -114,24 +147,40 @@ void PhysicsWorld2D::BeginContact(b2Contact* contact)
     if (!fixtureA || !fixtureB)
         return;
 
-    beginContactInfos_.push_back(ContactInfo(contact));
+    if (contactEventsEnabled_)
+        beginContactInfos_.push_back(ContactInfo(contact));
+
+    if (contactReportEnabled_)
+    {
+        FillContact(contactReport_.emplace_back(), PhysicsContactType2D::Begin, contact);
+        beganContacts_.insert(GetContactKey(contact));
+    }
 }
 
 void PhysicsWorld2D::EndContact(b2Contact* contact)
 {
-    if (!physicsStepping_)
-        return;
-
     b2Fixture* fixtureA = contact->GetFixtureA();
     b2Fixture* fixtureB = contact->GetFixtureB();
     if (!fixtureA || !fixtureB)
         return;
 
-    endContactInfos_.push_back(ContactInfo(contact));
+    // Contacts destroyed outside of the step are reported with the next step
+    if (contactReportEnabled_)
+    {
+        auto& report = physicsStepping_ ? contactReport_ : pendingContactReport_;
+        FillContact(report.emplace_back(), PhysicsContactType2D::End, contact);
+    }
+
+    // Only handle contact event while stepping the physics simulation
+    if (physicsStepping_ && contactEventsEnabled_)
+        endContactInfos_.push_back(ContactInfo(contact));
 }
 
 void PhysicsWorld2D::PreSolve(b2Contact* contact, const b2Manifold* oldManifold)
 {
+    if (!contactEventsEnabled_)
+        return;
+
     b2Fixture* fixtureA = contact->GetFixtureA();
     b2Fixture* fixtureB = contact->GetFixtureB();
     if (!fixtureA || !fixtureB)
@@ -234,6 +283,19 @@ void PhysicsWorld2D::DrawPoint(const b2Vec2& p, float32 size, const b2Color& col
     DrawSolidCircle(p, size * 0.5f * PIXEL_SIZE, b2Vec2(), color);
 }
 
+void PhysicsWorld2D::ParallelFor(int32 count, b2ParallelTask& task)
+{
+    auto* workQueue = GetSubsystem<WorkQueue>();
+    if (!workQueue)
+    {
+        task.Execute(0, count);
+        return;
+    }
+
+    ForEachParallel(workQueue, 64u, static_cast<unsigned>(count),
+        [&task](unsigned beginIndex, unsigned endIndex) { task.Execute(beginIndex, endIndex); });
+}
+
 void PhysicsWorld2D::DrawSolidCircle(const b2Vec2& center, float32 radius, const b2Vec2& axis, const b2Color& color)
 {
     if (!debugRenderer_)
@@ -289,10 +351,18 @@ void PhysicsWorld2D::Update(float timeStep)
         SendEvent(E_PHYSICSPRESTEP, eventData);
     }
 
+    contactReport_.clear();
+    contactReport_.insert(contactReport_.end(), pendingContactReport_.begin(), pendingContactReport_.end());
+    pendingContactReport_.clear();
+    beganContacts_.clear();
+
     physicsStepping_ = true;
     world_->Step(timeStep, velocityIterations_, positionIterations_);
     physicsStepping_ = false;
 
+    if (contactReportEnabled_)
+        AddPersistentContacts();
+
     // Apply world transforms. Unparented transforms first
     for (unsigned i = 0; i < rigidBodies_.size();)
     {
@@ -436,6 +506,27 @@ void PhysicsWorld2D::SetPositionIterations(int positionIterations)
     positionIterations_ = positionIterations;
 }
 
+void PhysicsWorld2D::SetContactEventsEnabled(bool enable)
+{
+    contactEventsEnabled_ = enable;
+}
+
+void PhysicsWorld2D::SetContactReportEnabled(bool enable)
+{
+    contactReportEnabled_ = enable;
+    if (!contactReportEnabled_)
+    {
+        contactReport_.clear();
+        pendingContactReport_.clear();
+    }
+}
+
+void PhysicsWorld2D::SetMultiThreaded(bool enable)
+{
+    multiThreaded_ = enable;
+    world_->SetParallelExecutor(multiThreaded_ ? this : nullptr);
+}
+
 void PhysicsWorld2D::AddRigidBody(RigidBody2D* rigidBody)
 {
     if (!rigidBody)
@@ -831,6 +922,22 @@ void PhysicsWorld2D::SendEndContactEvents()
     endContactInfos_.clear();
 }
 
+void PhysicsWorld2D::AddPersistentContacts()
+{
+    for (b2Contact* contact = world_->GetContactList(); contact; contact = contact->GetNext())
+    {
+        if (!contact->IsTouching() || !contact->GetFixtureA() || !contact->GetFixtureB())
+            continue;
+
+        if (beganContacts_.contains(GetContactKey(contact)))
+            continue;
+
+        FillContact(contactReport_.emplace_back(), PhysicsContactType2D::Persist, contact);
+    }
+
+    beganContacts_.clear();
+}
+
 PhysicsWorld2D::ContactInfo::ContactInfo() = default;
 
 PhysicsWorld2D::ContactInfo::ContactInfo(b2Contact* contact)
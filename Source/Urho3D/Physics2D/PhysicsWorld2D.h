@@ -27,6 +27,9 @@
 
 #include <Box2D/Box2D.h>
 
+#include <EASTL/tuple.h>
+#include <EASTL/unordered_set.h>
+
 namespace Urho3D
 {
 
@@ -53,6 +56,41 @@ struct URHO3D_API PhysicsRaycastResult2D
     RigidBody2D* body_{};
 };
 
+/// Type of 2D physics contact report record.
+enum class PhysicsContactType2D
+{
+    /// Shapes started touching during the step.
+    Begin,
+    /// Shapes were touching before the step and are still touching.
+    Persist,
+    /// Shapes stopped touching during the step.
+    End
+};
+
+/// 2D physics contact report record.
+/// @nobind
+struct URHO3D_API PhysicsContact2D
+{
+    /// Type of the record.
+    PhysicsContactType2D type_{};
+    /// Rigid body A. Expires when the body is removed.
+    WeakPtr<RigidBody2D> bodyA_;
+    /// Rigid body B. Expires when the body is removed.
+    WeakPtr<RigidBody2D> bodyB_;
+    /// Shape A. Expires when the shape is removed.
+    WeakPtr<CollisionShape2D> shapeA_;
+    /// Shape B. Expires when the shape is removed.
+    WeakPtr<CollisionShape2D> shapeB_;
+    /// Number of contact points.
+    int numPoints_{};
+    /// Contact normal in world space.
+    Vector2 worldNormal_;
+    /// Contact positions in world space.
+    Vector2 worldPositions_[b2_maxManifoldPoints];
+    /// Contact overlap values.
+    float separations_[b2_maxManifoldPoints]{};
+};
+
 /// Delayed world transform assignment for parented 2D rigidbodies.
 struct DelayedWorldTransform2D
 {
@@ -67,7 +105,7 @@ struct DelayedWorldTransform2D
 };
 
 /// 2D physics simulation world component. Should be added only to the root scene node.
-class URHO3D_API PhysicsWorld2D : public Component, public b2ContactListener, public b2Draw
+class URHO3D_API PhysicsWorld2D : public Component, public b2ContactListener, public b2Draw, public b2ParallelExecutor
 {
     URHO3D_OBJECT(PhysicsWorld2D, Component);
 
@@ -107,6 +145,10 @@ public:
     /// Draw a point.
     void DrawPoint(const b2Vec2& p, float32 size, const b2Color& color) override;
 
+    // Implement b2ParallelExecutor
+    /// Process task in worker threads.
+    void ParallelFor(int32 count, b2ParallelTask& task) override;
+
     /// Step the simulation forward.
     void Update(float timeStep);
     /// Add debug geometry to the debug renderer.
@@ -153,6 +195,15 @@ public:
     /// Set position iterations.
     /// @property
     void SetPositionIterations(int positionIterations);
+    /// Set whether to send contact events. Enabled by default.
+    /// @property
+    void SetContactEventsEnabled(bool enable);
+    /// Set whether to collect contact report on each step. Disabled by default.
+    /// @property
+    void SetContactReportEnabled(bool enable);
+    /// Set whether to evaluate contacts in worker threads. Disabled by default.
+    /// @property
+    void SetMultiThreaded(bool enable);
     /// Add rigid body.
     void AddRigidBody(RigidBody2D* rigidBody);
     /// Remove rigid body.
@@ -225,6 +276,23 @@ public:
     /// @property
     int GetPositionIterations() const { return positionIterations_; }
 
+    /// Return whether contact events are sent.
+    /// @property
+    bool GetContactEventsEnabled() const { return contactEventsEnabled_; }
+
+    /// Return whether contact report is collected.
+    /// @property
+    bool GetContactReportEnabled() const { return contactReportEnabled_; }
+
+    /// Return whether contacts are evaluated in worker threads.
+    /// @property
+    bool IsMultiThreaded() const { return multiThreaded_; }
+
+    /// Return contacts that began, persisted or ended during the last step.
+    /// Contacts ended by removing shapes or bodies between steps are reported with the next step.
+    /// @nobind
+    const ea::vector<PhysicsContact2D>& GetContactReport() const { return contactReport_; }
+
     /// Return the Box2D physics world.
     b2World* GetWorld() { return world_.get(); }
 
@@ -244,6 +312,8 @@ protected:
     void SendBeginContactEvents();
     /// Send end contact events.
     void SendEndContactEvents();
+    /// Add contacts that were touching before the step to contact report.
+    void AddPersistentContacts();
 
     /// Box2D physics world.
     ea::unique_ptr<b2World> world_;
@@ -253,6 +323,12 @@ protected:
     int velocityIterations_{};
     /// Position iterations.
     int positionIterations_{};
+    /// Whether contact events are sent.
+    bool contactEventsEnabled_{true};
+    /// Whether contact report is collected.
+    bool contactReportEnabled_{};
+    /// Whether contacts are evaluated in worker threads.
+    bool multiThreaded_{};
 
     /// Extra weak pointer to scene to allow for cleanup in case the world is destroyed before other components.
     WeakPtr<Scene> scene_;
@@ -309,6 +385,13 @@ protected:
     ea::vector<ContactInfo> endContactInfos_;
     /// Temporary buffer with contact data.
     VectorBuffer contacts_;
+    /// Contact report of the last step.
+    ea::vector<PhysicsContact2D> contactReport_;
+    /// Contacts that ended between steps, added to the report of the next step.
+    ea::vector<PhysicsContact2D> pendingContactReport_;
+    /// Fixture pairs and child indices of contacts that began touching during the current step.
+    /// Box2D contacts are pooled, so contact pointers cannot be used as keys.
+    ea::unordered_set<ea::tuple<const b2Fixture*, int, const b2Fixture*, int>> beganContacts_;
 };
 
 }
@@ -57,4 +57,9 @@ void DeviceObject::RestoreDependency(DeviceObject* dependency)
         dependency->Restore();
 }
 
+bool DeviceObject::IsGPUAvailable() const
+{
+    return renderDevice_ && !renderDevice_->IsNullBackend();
+}
+
 } // namespace Urho3D
@@ -44,6 +44,8 @@ public:
 protected:
     /// Helper function to restore another object if present.
     void RestoreDependency(DeviceObject* dependency);
+    /// Return whether GPU resources can be created. False if there is no render device or it uses null backend.
+    bool IsGPUAvailable() const;
 
     /// Render device that owns this object.
     WeakPtr<RenderDevice> renderDevice_;
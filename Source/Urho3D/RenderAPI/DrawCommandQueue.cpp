@@ -70,6 +70,22 @@ void DrawCommandQueue::Reset()
     scissorRects_.push_back(IntRect::ZERO);
 }
 
+void DrawCommandQueue::ExecuteInNullContext(RenderDeviceStats& stats) const
+{
+    for (const DrawCommandDescription& cmd : drawCommands_)
+    {
+        if (cmd.pipelineState_->GetPipelineType() == PipelineStateType::Graphics)
+        {
+            stats.numDraws_ += 1;
+            stats.numPrimitives_ += cmd.indexCount_ * ea::max(1u, cmd.instanceCount_);
+        }
+        else if (cmd.pipelineState_->GetPipelineType() == PipelineStateType::Compute)
+        {
+            stats.numDispatches_ += 1;
+        }
+    }
+}
+
 void DrawCommandQueue::ExecuteInContext(RenderContext* renderContext)
 {
     if (drawCommands_.empty())
@@ -82,6 +98,13 @@ void DrawCommandQueue::ExecuteInContext(RenderContext* renderContext)
     const RenderBackend& backend = renderContext->GetRenderDevice()->GetBackend();
     const RenderDeviceCaps& caps = renderContext->GetRenderDevice()->GetCaps();
 
+    // Null backend has no device context, commands are only counted
+    if (!deviceContext)
+    {
+        ExecuteInNullContext(stats);
+        return;
+    }
+
     // Update constant buffers to store all shader parameters for queue
     const unsigned numUniformBuffers = constantBuffers_.collection_.GetNumBuffers();
     temp_.uniformBuffers_.resize(numUniformBuffers);
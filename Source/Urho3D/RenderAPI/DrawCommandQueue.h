@@ -311,6 +311,9 @@ public:
     void ExecuteInContext(RenderContext* renderContext);
 
 private:
+    /// Count commands in the queue without execution. Used by null backend.
+    void ExecuteInNullContext(RenderDeviceStats& stats) const;
+
     RenderDevice* renderDevice_{};
 
     /// Shader parameters data when constant buffers are used.
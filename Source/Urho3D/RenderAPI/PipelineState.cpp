@@ -330,13 +330,15 @@ const ComputePipelineStateDesc* PipelineStateDesc::AsCompute() const
     return GetType() == PipelineStateType::Compute ? &ea::get<1>(desc_) : nullptr;
 }
 
-PipelineState::PipelineState(PipelineStateCache* owner, const PipelineStateDesc& desc)
+PipelineState::PipelineState(PipelineStateCache* owner, const PipelineStateDesc& desc, bool connectToShaders)
     : Object(owner->GetContext())
     , DeviceObject(owner->GetContext())
     , owner_(owner)
     , desc_(desc)
 {
     SetDebugName(Format("{} #{}", desc_.GetDebugName(), desc_.ToHash()));
+    if (connectToShaders)
+        ConnectToShaders();
     CreateGPU();
 }
 
@@ -389,8 +391,35 @@ void PipelineState::Destroy()
     DestroyGPU();
 }
 
+void PipelineState::ConnectToShaders()
+{
+    if (const GraphicsPipelineStateDesc* graphicsDesc = desc_.AsGraphics())
+    {
+        for (RawShader* shader : {graphicsDesc->vertexShader_, graphicsDesc->pixelShader_, graphicsDesc->domainShader_,
+                 graphicsDesc->hullShader_, graphicsDesc->geometryShader_})
+        {
+            if (shader)
+                shader->OnReloaded.Subscribe(this, &PipelineState::Invalidate);
+        }
+    }
+
+    if (const ComputePipelineStateDesc* computeDesc = desc_.AsCompute())
+    {
+        if (computeDesc->computeShader_)
+            computeDesc->computeShader_->OnReloaded.Subscribe(this, &PipelineState::Invalidate);
+    }
+}
+
 void PipelineState::CreateGPU()
 {
+    if (!IsGPUAvailable())
+    {
+        // Null backend has nothing to create and nothing to reflect, pipeline state is valid without GPU handle
+        DestroyGPU();
+        reflection_ = MakeShared<ShaderProgramReflection>(ea::span<Diligent::IShader* const>{});
+        return;
+    }
+
     if (const GraphicsPipelineStateDesc* graphicsDesc = desc_.AsGraphics())
         CreateGPU(*graphicsDesc);
     else if (const ComputePipelineStateDesc* computeDesc = desc_.AsCompute())
@@ -525,6 +554,10 @@ void PipelineState::CreateGPU(const GraphicsPipelineStateDesc& desc)
     {
         if (shader && !shader->GetHandle())
         {
+            // Pipeline state will be recreated when the shader is ready
+            if (shader->IsCompilationPending())
+                return;
+
             URHO3D_LOGERROR("Failed to create PipelineState '{}' due to failed {} shader compilation", GetDebugName(),
                 ToString(shader->GetShaderType()));
             return;
@@ -550,13 +583,6 @@ void PipelineState::CreateGPU(const GraphicsPipelineStateDesc& desc)
     Diligent::IShader* geometryShader = desc.geometryShader_ ? desc.geometryShader_->GetHandle() : nullptr;
     Diligent::IShader* const shaderHandles[] = {vertexShader, pixelShader, domainShader, hullShader, geometryShader};
 
-    for (RawShader* shader :
-        {desc.vertexShader_, desc.pixelShader_, desc.domainShader_, desc.hullShader_, desc.geometryShader_})
-    {
-        if (shader)
-            shader->OnReloaded.Subscribe(this, &PipelineState::Invalidate);
-    }
-
     VertexShaderAttributeVector vertexAttributes;
     StringVector vertexAttributeNames;
     if (!isOpenGL)
@@ -702,6 +728,10 @@ void PipelineState::CreateGPU(const ComputePipelineStateDesc& desc)
 
     if (desc.computeShader_ && !desc.computeShader_->GetHandle())
     {
+        // Pipeline state will be recreated when the shader is ready
+        if (desc.computeShader_->IsCompilationPending())
+            return;
+
         URHO3D_LOGERROR("Failed to create PipelineState '{}' due to failed {} shader compilation", GetDebugName(),
             ToString(desc.computeShader_->GetShaderType()));
         return;
@@ -718,7 +748,6 @@ void PipelineState::CreateGPU(const ComputePipelineStateDesc& desc)
 
     Diligent::IShader* computeShader = desc.computeShader_->GetHandle();
     Diligent::IShader* const shaderHandles[] = {computeShader};
-    desc.computeShader_->OnReloaded.Subscribe(this, &PipelineState::Invalidate);
 
     if (hasSeparableShaderPrograms)
     {
@@ -808,10 +837,40 @@ SharedPtr<PipelineState> PipelineStateCache::GetPipelineState(const PipelineStat
     {
         pipelineState = MakeShared<PipelineState>(this, desc);
         weakPipelineState = pipelineState;
+        OnPipelineStateCreated(this, pipelineState);
     }
     return pipelineState;
 }
 
+bool PipelineStateCache::IsThreadedCreationSupported() const
+{
+    // OpenGL context is bound to the main thread
+    return renderDevice_ && renderDevice_->GetBackend() != RenderBackend::OpenGL;
+}
+
+SharedPtr<PipelineState> PipelineStateCache::CreateDetachedPipelineState(const PipelineStateDesc& desc)
+{
+    return MakeShared<PipelineState>(this, desc, false);
+}
+
+SharedPtr<PipelineState> PipelineStateCache::AttachPipelineState(PipelineState* pipelineState)
+{
+    const PipelineStateDesc& desc = pipelineState->GetDesc();
+    WeakPtr<PipelineState>& weakPipelineState = states_[desc];
+    if (SharedPtr<PipelineState> existingPipelineState = weakPipelineState.Lock())
+        return existingPipelineState;
+
+    weakPipelineState = pipelineState;
+    pipelineState->ConnectToShaders();
+
+    // Shaders may have been reloaded while the pipeline state was created
+    if (!pipelineState->IsValid())
+        pipelineState->Invalidate();
+
+    OnPipelineStateCreated(this, pipelineState);
+    return SharedPtr<PipelineState>(pipelineState);
+}
+
 SharedPtr<PipelineState> PipelineStateCache::GetGraphicsPipelineState(const GraphicsPipelineStateDesc& desc)
 {
     if (!desc.IsInitialized())
@@ -830,8 +889,13 @@ SharedPtr<PipelineState> PipelineStateCache::GetComputePipelineState(const Compu
 
 void PipelineStateCache::ReleasePipelineState(const PipelineStateDesc& desc)
 {
-    if (states_.erase(desc) != 1)
-        URHO3D_LOGERROR("Unexpected call of PipelineStateCache::ReleasePipelineState");
+    const auto iter = states_.find(desc);
+    if (iter == states_.end())
+        return;
+
+    // Detached pipeline state may be released while another instance with the same description is alive
+    if (iter->second.Refs() == 0)
+        states_.erase(iter);
 }
 
 void PipelineStateCache::UpdateCachedData()
@@ -7,6 +7,7 @@
 #include "Urho3D/Container/Hash.h"
 #include "Urho3D/Container/IndexAllocator.h"
 #include "Urho3D/Container/RefCounted.h"
+#include "Urho3D/Core/Signal.h"
 #include "Urho3D/IO/FileIdentifier.h"
 #include "Urho3D/RenderAPI/DeviceObject.h"
 #include "Urho3D/RenderAPI/RawShader.h"
@@ -180,7 +181,9 @@ class URHO3D_API PipelineState : public Object, public DeviceObject, public IDFa
     URHO3D_OBJECT(PipelineState, Object);
 
 public:
-    PipelineState(PipelineStateCache* owner, const PipelineStateDesc& desc);
+    /// Construct. If connectToShaders is false, the state is not recreated on shader reload
+    /// until it's attached to the cache.
+    PipelineState(PipelineStateCache* owner, const PipelineStateDesc& desc, bool connectToShaders = true);
     ~PipelineState() override;
 
     /// Implement DeviceObject.
@@ -201,6 +204,9 @@ public:
     /// @}
 
 private:
+    friend class PipelineStateCache;
+
+    void ConnectToShaders();
     void CreateGPU();
     void CreateGPU(const GraphicsPipelineStateDesc& desc);
     void CreateGPU(const ComputePipelineStateDesc& desc);
@@ -220,6 +226,9 @@ class URHO3D_API PipelineStateCache : public Object, public DeviceObject
     URHO3D_OBJECT(PipelineStateCache, Object);
 
 public:
+    /// Signals that new pipeline state was added to the cache.
+    Signal<void(PipelineState* pipelineState), PipelineStateCache> OnPipelineStateCreated;
+
     explicit PipelineStateCache(Context* context);
 
     /// Initialize pipeline state cache. Optionally loads cached pipeline states from memory blob.
@@ -238,6 +247,16 @@ public:
     /// Create new or return existing compute pipeline state.
     SharedPtr<PipelineState> GetComputePipelineState(const ComputePipelineStateDesc& desc);
 
+    /// Return whether pipeline states may be created from worker threads.
+    bool IsThreadedCreationSupported() const;
+    /// Create pipeline state without adding it to the cache.
+    /// May be called from worker threads if IsThreadedCreationSupported returns true.
+    /// Returned object should be released or attached to the cache on the main thread.
+    SharedPtr<PipelineState> CreateDetachedPipelineState(const PipelineStateDesc& desc);
+    /// Add detached pipeline state to the cache. Should be called from the main thread.
+    /// Return existing pipeline state if the same state was created in the meantime.
+    SharedPtr<PipelineState> AttachPipelineState(PipelineState* pipelineState);
+
     /// Internal. Remove pipeline state with given description from cache.
     void ReleasePipelineState(const PipelineStateDesc& desc);
 
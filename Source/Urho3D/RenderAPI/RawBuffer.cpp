@@ -99,9 +99,9 @@ bool RawBuffer::Create(const RawBufferParams& params, const void* data)
         return false;
     }
 
-    if (!renderDevice_)
+    if (!IsGPUAvailable())
     {
-        // If there's no render device, buffer must be shadowed
+        // If there's no GPU, buffer must be shadowed
         params_.flags_.Set(BufferFlag::Shadowed);
     }
     else
@@ -148,7 +148,7 @@ bool RawBuffer::Create(const RawBufferParams& params, const void* data)
     }
 
     // Create GPU buffer, postpone if Immutable and no data
-    if (renderDevice_ && (!params_.flags_.Test(BufferFlag::Immutable) || data != nullptr))
+    if (IsGPUAvailable() && (!params_.flags_.Test(BufferFlag::Immutable) || data != nullptr))
     {
         if (!CreateGPU(data))
             return false;
@@ -238,7 +238,7 @@ void RawBuffer::UpdateRange(const void* data, unsigned offset, unsigned size)
             memcpy(cpuBuffer, data, size);
     }
 
-    if (renderDevice_)
+    if (IsGPUAvailable())
     {
         Diligent::IDeviceContext* immediateContext = renderDevice_->GetImmediateContext();
         if (internalUsage_ == Diligent::USAGE_DYNAMIC)
@@ -260,9 +260,10 @@ void RawBuffer::UpdateRange(const void* data, unsigned offset, unsigned size)
             immediateContext->UpdateBuffer(
                 handle_, offset, size, data, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
         }
+    }
 
+    if (renderDevice_)
         lastUpdateFrameIndex_ = renderDevice_->GetFrameIndex();
-    }
 
     ClearDataLost();
 }
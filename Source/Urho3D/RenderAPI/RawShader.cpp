@@ -63,7 +63,7 @@ void RawShader::CreateGPU()
 {
     DestroyGPU();
 
-    if (bytecode_.IsEmpty())
+    if (bytecode_.IsEmpty() || !IsGPUAvailable())
         return;
 
     Diligent::ShaderCreateInfo createInfo;
@@ -42,6 +42,8 @@ public:
     const ShaderBytecode& GetBytecode() const { return bytecode_; }
     ShaderType GetShaderType() const { return bytecode_.type_; }
     Diligent::IShader* GetHandle() const { return handle_; }
+    /// Return whether the shader is still being compiled in the background and doesn't have bytecode yet.
+    bool IsCompilationPending() const { return compilationPending_; }
     /// @}
 
 protected:
@@ -49,6 +51,8 @@ protected:
 
     /// Create shader from platform-specific binary.
     void CreateFromBinary(ShaderBytecode bytecode);
+    /// Mark shader as waiting for asynchronous compilation.
+    void SetCompilationPending(bool pending) { compilationPending_ = pending; }
 
 private:
     void CreateGPU();
@@ -56,7 +60,7 @@ private:
 
     ShaderBytecode bytecode_;
     Diligent::RefCntAutoPtr<Diligent::IShader> handle_;
-
+    bool compilationPending_{};
 };
 
 } // namespace Urho3D
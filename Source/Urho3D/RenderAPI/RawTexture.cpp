@@ -179,7 +179,7 @@ bool ValidateLevels(RawTextureParams& params)
 
 bool ValidateCaps(RawTextureParams& params, RenderDevice* renderDevice)
 {
-    if (!renderDevice)
+    if (!renderDevice || renderDevice->IsNullBackend())
         return true;
 
     Diligent::IRenderDevice* device = renderDevice->GetRenderDevice();
@@ -450,7 +450,7 @@ bool RawTexture::Create(const RawTextureParams& params)
     if (!ValidateCaps(params_, renderDevice_))
         return false;
 
-    if (!renderDevice_)
+    if (!IsGPUAvailable())
         return true;
 
     if (!CreateGPU())
@@ -835,7 +835,7 @@ bool RawTexture::CreateRenderSurfaces(Diligent::ITextureView* defaultView, Dilig
 
 void RawTexture::GenerateLevels()
 {
-    if (params_.numLevels_ > 1)
+    if (params_.numLevels_ > 1 && IsGPUAvailable())
     {
         if (!handles_.srv_)
         {
@@ -890,7 +890,7 @@ void RawTexture::Update(unsigned level, const IntVector3& offset, const IntVecto
         URHO3D_ASSERT(IsAligned(offset.ToIntVector2(), blockSize), "Unaligned update region offset");
     }
 
-    if (!renderDevice_)
+    if (!IsGPUAvailable())
         return;
 
     if (!handles_)
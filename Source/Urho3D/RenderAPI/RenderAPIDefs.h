@@ -52,6 +52,9 @@ enum class RenderBackend
     OpenGL,
     /// Vulkan 1.0 or later.
     Vulkan,
+    /// No GPU. Resources and draw commands are accepted and ignored, draw commands are counted in statistics.
+    /// Used for headless benchmarking and testing of CPU side of rendering.
+    Null,
 
     Count
 };
@@ -100,6 +100,7 @@ const ea::string& ToString(RenderBackend backend)
         "D3D12",
         "OpenGL",
         "Vulkan",
+        "Null",
     }};
     return backendNames[backend];
 }
@@ -232,6 +233,8 @@ RenderBackend SelectRenderBackend(ea::optional<RenderBackend> requestedBackend)
 #if VULKAN_SUPPORTED
     supportedBackends.push_back(RenderBackend::Vulkan);
 #endif
+    // Null backend is always available but never selected by default
+    supportedBackends.push_back(RenderBackend::Null);
 
     URHO3D_ASSERT(!supportedBackends.empty(), "Unexpected engine configuration");\
 
@@ -250,11 +253,12 @@ ShaderTranslationPolicy SelectShaderTranslationPolicy(
         ShaderTranslationPolicy::Translate, // D3D11
         ShaderTranslationPolicy::Translate, // D3D12
         ShaderTranslationPolicy::Verbatim, // OpenGL
-        ShaderTranslationPolicy::Optimize // Vulkan
+        ShaderTranslationPolicy::Optimize, // Vulkan
+        ShaderTranslationPolicy::Verbatim, // Null
     }};
 
     ea::vector<ShaderTranslationPolicy> supportedPolicies;
-    if (backend == RenderBackend::OpenGL)
+    if (backend == RenderBackend::OpenGL || backend == RenderBackend::Null)
         supportedPolicies.push_back(ShaderTranslationPolicy::Verbatim);
 #ifdef URHO3D_SHADER_TRANSLATOR
     supportedPolicies.push_back(ShaderTranslationPolicy::Translate);
@@ -325,6 +329,76 @@ void SerializeValue(Archive& archive, const char* name, RenderDeviceSettingsD3D1
     // clang-format on
 }
 
+void SerializeValue(Archive& archive, const char* name, SamplerStateDesc& value)
+{
+    auto block = archive.OpenUnorderedBlock(name);
+    SerializeValue(archive, "filterMode", value.filterMode_);
+    SerializeValue(archive, "anisotropy", value.anisotropy_);
+    SerializeValue(archive, "shadowCompare", value.shadowCompare_);
+    SerializeValue(archive, "addressModeU", value.addressMode_[TextureCoordinate::U]);
+    SerializeValue(archive, "addressModeV", value.addressMode_[TextureCoordinate::V]);
+    SerializeValue(archive, "addressModeW", value.addressMode_[TextureCoordinate::W]);
+}
+
+void SerializeValue(Archive& archive, const char* name, PipelineStateOutputDesc& value)
+{
+    auto block = archive.OpenUnorderedBlock(name);
+    SerializeValue(archive, "depthStencilFormat", value.depthStencilFormat_);
+    SerializeValue(archive, "multiSample", value.multiSample_);
+
+    auto formatsBlock = archive.OpenArrayBlock("renderTargetFormats", value.numRenderTargets_);
+    if (archive.IsInput())
+    {
+        value.numRenderTargets_ = formatsBlock.GetSizeHint();
+        if (value.numRenderTargets_ > MaxRenderTargets)
+            throw ArchiveException("'{}/{}' has too many render targets", archive.GetCurrentBlockPath(), name);
+    }
+    for (unsigned i = 0; i < value.numRenderTargets_; ++i)
+        SerializeValue(archive, "format", value.renderTargetFormats_[i]);
+}
+
+void SerializeValue(Archive& archive, const char* name, InputLayoutElementDesc& value)
+{
+    auto block = archive.OpenUnorderedBlock(name);
+    SerializeValue(archive, "bufferIndex", value.bufferIndex_);
+    SerializeValue(archive, "bufferStride", value.bufferStride_);
+    SerializeValue(archive, "elementOffset", value.elementOffset_);
+    SerializeValue(archive, "instanceStepRate", value.instanceStepRate_);
+    SerializeValue(archive, "elementType", value.elementType_);
+    SerializeValue(archive, "elementSemantic", value.elementSemantic_);
+    SerializeValue(archive, "elementSemanticIndex", value.elementSemanticIndex_);
+}
+
+void SerializeValue(Archive& archive, const char* name, InputLayoutDesc& value)
+{
+    auto block = archive.OpenArrayBlock(name, value.size_);
+    if (archive.IsInput())
+    {
+        value.size_ = block.GetSizeHint();
+        if (value.size_ > MaxNumVertexElements)
+            throw ArchiveException("'{}/{}' has too many vertex elements", archive.GetCurrentBlockPath(), name);
+    }
+    for (unsigned i = 0; i < value.size_; ++i)
+        SerializeValue(archive, "element", value.elements_[i]);
+}
+
+void SerializeValue(Archive& archive, const char* name, ImmutableSamplersDesc& value)
+{
+    auto block = archive.OpenArrayBlock(name, value.size_);
+    if (archive.IsInput())
+    {
+        value.size_ = block.GetSizeHint();
+        if (value.size_ > MaxNumImmutableSamplers)
+            throw ArchiveException("'{}/{}' has too many samplers", archive.GetCurrentBlockPath(), name);
+    }
+    for (unsigned i = 0; i < value.size_; ++i)
+    {
+        auto samplerBlock = archive.OpenUnorderedBlock("sampler");
+        SerializeValue(archive, "name", value.names_[i]);
+        SerializeValue(archive, "desc", value.desc_[i]);
+    }
+}
+
 TextureFormat GetTextureFormatFromInternal(RenderBackend backend, unsigned internalFormat)
 {
     switch (backend)
@@ -41,6 +41,11 @@ URHO3D_API ShaderTranslationPolicy SelectShaderTranslationPolicy(
 
 URHO3D_API void SerializeValue(Archive& archive, const char* name, RenderDeviceSettingsVulkan& value);
 URHO3D_API void SerializeValue(Archive& archive, const char* name, RenderDeviceSettingsD3D12& value);
+URHO3D_API void SerializeValue(Archive& archive, const char* name, SamplerStateDesc& value);
+URHO3D_API void SerializeValue(Archive& archive, const char* name, PipelineStateOutputDesc& value);
+URHO3D_API void SerializeValue(Archive& archive, const char* name, InputLayoutElementDesc& value);
+URHO3D_API void SerializeValue(Archive& archive, const char* name, InputLayoutDesc& value);
+URHO3D_API void SerializeValue(Archive& archive, const char* name, ImmutableSamplersDesc& value);
 
 /// Try to find a suitable texture format for given internal GAPI format.
 /// Only a subset of formats is supported.
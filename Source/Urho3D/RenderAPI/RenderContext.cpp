@@ -76,6 +76,13 @@ void RenderContext::SetRenderTargets(OptionalRawTextureRTV depthStencil, ea::spa
             renderTarget.MarkDirty();
     }
 
+    // Null backend has no views, render target info is deduced from the view parameters
+    if (!handle_)
+    {
+        UpdateNullRenderTargetInfo(depthStencil, renderTargets);
+        return;
+    }
+
     currentDepthStencil_ = depthStencil ? depthStencil->GetView() : nullptr;
     currentRenderTargets_.clear();
     for (const RenderTargetView& renderTarget : renderTargets)
@@ -105,6 +112,9 @@ void RenderContext::SetViewport(const IntRect& viewport)
     const IntVector2 viewportMax = viewport.Max();
     currentViewport_ = IntRect{VectorMax(viewportMin, IntVector2::ZERO), VectorMin(viewportMax, currentDimensions_)};
 
+    if (!handle_)
+        return;
+
     Diligent::Viewport viewportDesc;
     viewportDesc.TopLeftX = currentViewport_.left_;
     viewportDesc.TopLeftY = currentViewport_.top_;
@@ -115,6 +125,9 @@ void RenderContext::SetViewport(const IntRect& viewport)
 
 void RenderContext::ClearDepthStencil(ClearTargetFlags flags, float depth, unsigned stencil)
 {
+    if (!handle_)
+        return;
+
     if (!flags.Test(CLEAR_DEPTH) && !flags.Test(CLEAR_STENCIL))
     {
         URHO3D_ASSERTLOG(false, "At least one of CLEAR_DEPTH or CLEAR_STENCIL must be set to call ClearDepthStencil");
@@ -137,6 +150,9 @@ void RenderContext::ClearDepthStencil(ClearTargetFlags flags, float depth, unsig
 
 void RenderContext::ClearRenderTarget(unsigned index, const Color& color)
 {
+    if (!handle_)
+        return;
+
     if (index >= currentRenderTargets_.size())
     {
         URHO3D_ASSERTLOG(false, "Render target must be bound to call ClearRenderTarget");
@@ -194,6 +210,23 @@ void RenderContext::UpdateCurrentRenderTargetInfo()
     currentOutputDesc_.multiSample_ = view ? view->GetTexture()->GetDesc().SampleCount : 1;
 }
 
+void RenderContext::UpdateNullRenderTargetInfo(
+    OptionalRawTextureRTV depthStencil, ea::span<const RenderTargetView> renderTargets)
+{
+    currentDepthStencil_ = nullptr;
+    currentRenderTargets_.clear();
+
+    currentOutputDesc_.depthStencilFormat_ =
+        depthStencil ? depthStencil->GetFormat() : Diligent::TEX_FORMAT_UNKNOWN;
+    currentOutputDesc_.numRenderTargets_ = renderTargets.size();
+    for (unsigned i = 0; i < renderTargets.size(); ++i)
+        currentOutputDesc_.renderTargetFormats_[i] = renderTargets[i].GetFormat();
+
+    const RenderTargetView* view = !renderTargets.empty() ? &renderTargets[0] : depthStencil ? &*depthStencil : nullptr;
+    currentDimensions_ = view ? view->GetSize() : IntVector2::ZERO;
+    currentOutputDesc_.multiSample_ = view ? view->GetMultiSample() : 1;
+}
+
 void RenderContext::ResetCachedContextState()
 {
     cachedContextState_ = {};
@@ -73,6 +73,7 @@ public:
 
 private:
     void UpdateCurrentRenderTargetInfo();
+    void UpdateNullRenderTargetInfo(OptionalRawTextureRTV depthStencil, ea::span<const RenderTargetView> renderTargets);
     void ResetCachedContextState();
 
     RenderDevice* renderDevice_{};
@@ -785,6 +785,14 @@ RenderDevice::RenderDevice(
     if (deviceSettings_.externalWindowHandle_)
         windowSettings_.mode_ = WindowMode::Windowed;
 
+    if (deviceSettings_.backend_ == RenderBackend::Null)
+    {
+        InitializeNullDevice();
+        URHO3D_LOGINFO("RenderDevice is initialized for {}: size={}x{}px", ToString(deviceSettings_.backend_),
+            windowSettings_.size_.x_, windowSettings_.size_.y_);
+        return;
+    }
+
     ValidateWindowSettings(windowSettings_);
     InitializeWindow();
     InitializeFactory();
@@ -806,7 +814,8 @@ void RenderDevice::PostInitialize()
 RenderDevice::~RenderDevice()
 {
     SendDeviceObjectEvent(DeviceObjectEvent::Destroy);
-    deviceContext_->WaitForIdle();
+    if (deviceContext_)
+        deviceContext_->WaitForIdle();
 }
 
 void RenderDevice::InitializeWindow()
@@ -1087,6 +1096,32 @@ void RenderDevice::InitializeCaps()
     }
 }
 
+void RenderDevice::InitializeNullDevice()
+{
+    // There is no window and no GPU, settings are used as is
+    windowSettings_.mode_ = WindowMode::Windowed;
+    windowSettings_.multiSample_ = 1;
+    if (windowSettings_.size_ == IntVector2::ZERO)
+        windowSettings_.size_ = {1024, 768};
+
+    defaultDepthStencilFormat_ = TextureFormat::TEX_FORMAT_D24_UNORM_S8_UINT;
+    defaultDepthFormat_ = TextureFormat::TEX_FORMAT_D32_FLOAT;
+
+    // Report typical desktop capabilities so the render pipeline takes the most common code paths
+    caps_.computeShaders_ = true;
+    caps_.drawBaseVertex_ = true;
+    caps_.drawBaseInstance_ = true;
+    caps_.clipDistance_ = true;
+    caps_.readOnlyDepth_ = true;
+    caps_.srgbOutput_ = true;
+    caps_.hdrOutput_ = true;
+    caps_.constantBufferOffsetAlignment_ = 256;
+    caps_.maxTextureSize_ = 16384;
+    caps_.maxRenderTargetSize_ = 16384;
+
+    renderContext_ = MakeShared<RenderContext>(this);
+}
+
 Diligent::RefCntAutoPtr<Diligent::ISwapChain> RenderDevice::CreateSecondarySwapChain(
     SDL_Window* sdlWindow, bool hasDepthBuffer)
 {
@@ -1151,6 +1186,9 @@ Diligent::RefCntAutoPtr<Diligent::ISwapChain> RenderDevice::CreateSecondarySwapC
 
 void RenderDevice::UpdateSwapChainSize()
 {
+    if (deviceSettings_.backend_ == RenderBackend::Null)
+        return;
+
     const IntVector2 oldWindowSize = windowSettings_.size_;
     const IntVector2 oldSwapChainSize = GetSwapChainSize();
 
@@ -1231,6 +1269,14 @@ void RenderDevice::UpdateSwapChainSize()
 
 void RenderDevice::UpdateWindowSettings(const WindowSettings& settings)
 {
+    if (deviceSettings_.backend_ == RenderBackend::Null)
+    {
+        // There is no window, only the size is tracked
+        if (settings.size_ != IntVector2::ZERO)
+            windowSettings_.size_ = settings.size_;
+        return;
+    }
+
     WindowSettings& oldSettings = windowSettings_;
     WindowSettings newSettings = settings;
     ValidateWindowSettings(newSettings);
@@ -1472,6 +1518,9 @@ void RenderDevice::QueuePipelineStateReload(PipelineState* pipelineState)
 
 bool RenderDevice::TakeScreenShot(IntVector2& size, ByteVector& data)
 {
+    if (deviceSettings_.backend_ == RenderBackend::Null)
+        return false;
+
     const bool flipY = deviceSettings_.backend_ == RenderBackend::OpenGL;
 
     const auto resolvedBackBuffer = GetResolvedBackBuffer();
@@ -1586,10 +1635,11 @@ Diligent::RefCntAutoPtr<Diligent::ITexture> RenderDevice::ReadTextureToStaging(D
 
 void RenderDevice::Present()
 {
-    swapChain_->Present(windowSettings_.vSync_ ? 1 : 0);
+    if (swapChain_)
+        swapChain_->Present(windowSettings_.vSync_ ? 1 : 0);
 
     // If using an external window, check it for size changes, and reset screen mode if necessary
-    if (deviceSettings_.externalWindowHandle_ != nullptr)
+    if (deviceSettings_.externalWindowHandle_ != nullptr && window_)
     {
         IntVector2 currentSize;
         SDL_GetWindowSize(window_.get(), &currentSize.x_, &currentSize.y_);
@@ -1646,6 +1696,8 @@ void RenderDevice::Present()
 
 IntVector2 RenderDevice::GetSwapChainSize() const
 {
+    if (deviceSettings_.backend_ == RenderBackend::Null)
+        return windowSettings_.size_;
     if (!swapChain_)
         return IntVector2::ZERO;
     const Diligent::SwapChainDesc& desc = swapChain_->GetDesc();
@@ -1753,23 +1805,31 @@ void RenderDevice::SendDeviceObjectEvent(DeviceObjectEvent event)
 
 bool RenderDevice::IsTextureFormatSupported(TextureFormat format) const
 {
+    if (deviceSettings_.backend_ == RenderBackend::Null)
+        return true;
     return renderDevice_->GetTextureFormatInfoExt(format).BindFlags != Diligent::BIND_NONE;
 }
 
 bool RenderDevice::IsRenderTargetFormatSupported(TextureFormat format) const
 {
+    if (deviceSettings_.backend_ == RenderBackend::Null)
+        return true;
     const Diligent::TextureFormatInfoExt& info = renderDevice_->GetTextureFormatInfoExt(format);
     return (info.BindFlags & (Diligent::BIND_RENDER_TARGET | Diligent::BIND_DEPTH_STENCIL)) != 0;
 }
 
 bool RenderDevice::IsUnorderedAccessFormatSupported(TextureFormat format) const
 {
+    if (deviceSettings_.backend_ == RenderBackend::Null)
+        return true;
     const Diligent::TextureFormatInfoExt& info = renderDevice_->GetTextureFormatInfoExt(format);
     return (info.BindFlags & Diligent::BIND_UNORDERED_ACCESS) != 0;
 }
 
 bool RenderDevice::IsMultiSampleSupported(TextureFormat format, int multiSample) const
 {
+    if (deviceSettings_.backend_ == RenderBackend::Null)
+        return true;
     const Diligent::TextureFormatInfoExt& info = renderDevice_->GetTextureFormatInfoExt(format);
     return (info.SampleCounts & multiSample) != 0;
 }
@@ -1777,6 +1837,8 @@ bool RenderDevice::IsMultiSampleSupported(TextureFormat format, int multiSample)
 int RenderDevice::GetSupportedMultiSample(TextureFormat format, int multiSample) const
 {
     multiSample = NextPowerOfTwo(Clamp(multiSample, 1, 16));
+    if (deviceSettings_.backend_ == RenderBackend::Null)
+        return multiSample;
 
     const Diligent::TextureFormatInfoExt& formatInfo = renderDevice_->GetTextureFormatInfoExt(format);
     while (multiSample > 1 && ((formatInfo.SampleCounts & multiSample) == 0))
@@ -1789,7 +1851,7 @@ void RenderDevice::InitializeDefaultObjects()
     const auto createDefaultTexture = [&](const TextureType type, Diligent::RESOURCE_DIMENSION_SUPPORT flag)
     {
         const TextureFormat format = TextureFormat::TEX_FORMAT_RGBA8_UNORM;
-        if (!(renderDevice_->GetTextureFormatInfoExt(format).Dimensions & flag))
+        if (renderDevice_ && !(renderDevice_->GetTextureFormatInfoExt(format).Dimensions & flag))
             return;
 
         RawTextureParams params;
@@ -118,6 +118,7 @@ public:
     /// Getters.
     /// @{
     const RenderBackend GetBackend() const { return deviceSettings_.backend_; }
+    bool IsNullBackend() const { return deviceSettings_.backend_ == RenderBackend::Null; }
     const RenderDeviceSettings& GetDeviceSettings() const { return deviceSettings_; }
     const WindowSettings& GetWindowSettings() const { return windowSettings_; }
     const RenderDeviceCaps& GetCaps() const { return caps_; }
@@ -162,6 +163,7 @@ private:
     void InitializeDevice();
     void InitializeMultiSampleSwapChain(Diligent::ISwapChain* nativeSwapChain);
     void InitializeCaps();
+    void InitializeNullDevice();
 
     void InitializeDefaultObjects();
     void ReleaseDefaultObjects();
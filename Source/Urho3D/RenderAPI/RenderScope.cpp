@@ -34,13 +34,15 @@ void ConsumeOpenGLError(RenderDevice* renderDevice)
 
 void RenderScope::BeginGroup(ea::string_view name)
 {
-    renderContext_->GetHandle()->BeginDebugGroup(name.data());
+    if (Diligent::IDeviceContext* handle = renderContext_->GetHandle())
+        handle->BeginDebugGroup(name.data());
     ConsumeOpenGLError(renderContext_->GetRenderDevice());
 }
 
 void RenderScope::EndGroup()
 {
-    renderContext_->GetHandle()->EndDebugGroup();
+    if (Diligent::IDeviceContext* handle = renderContext_->GetHandle())
+        handle->EndDebugGroup();
     ConsumeOpenGLError(renderContext_->GetRenderDevice());
 }
 
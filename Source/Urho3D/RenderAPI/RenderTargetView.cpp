@@ -67,6 +67,8 @@ void RenderTargetView::MarkDirty() const
 
 Diligent::ITextureView* RenderTargetView::GetView() const
 {
+    if (IsSwapChain() && !renderDevice_->GetSwapChain())
+        return nullptr;
     if (type_ == Type::SwapChainColor)
         return renderDevice_->GetSwapChain()->GetCurrentBackBufferRTV();
     if (type_ == Type::SwapChainDepthStencil)
@@ -116,9 +118,15 @@ TextureFormat RenderTargetView::GetFormat() const
 {
     switch (type_)
     {
-    case Type::SwapChainColor: return renderDevice_->GetSwapChain()->GetDesc().ColorBufferFormat;
+    case Type::SwapChainColor:
+        if (!renderDevice_->GetSwapChain())
+            return TextureFormat::TEX_FORMAT_RGBA8_UNORM;
+        return renderDevice_->GetSwapChain()->GetDesc().ColorBufferFormat;
 
-    case Type::SwapChainDepthStencil: return renderDevice_->GetSwapChain()->GetDesc().DepthBufferFormat;
+    case Type::SwapChainDepthStencil:
+        if (!renderDevice_->GetSwapChain())
+            return renderDevice_->GetDefaultDepthStencilFormat();
+        return renderDevice_->GetSwapChain()->GetDesc().DepthBufferFormat;
 
     case Type::Resource:
     case Type::ResourceSlice:
@@ -145,4 +153,11 @@ int RenderTargetView::GetMultiSample() const
     }
 }
 
+IntVector2 RenderTargetView::GetSize() const
+{
+    if (IsSwapChain())
+        return renderDevice_->GetSwapChainSize();
+    return texture_->GetParams().size_.ToIntVector2();
+}
+
 } // namespace Urho3D
@@ -40,6 +40,8 @@ public:
     TextureFormat GetFormat() const;
     /// Return multi-sample level.
     int GetMultiSample() const;
+    /// Return size in pixels.
+    IntVector2 GetSize() const;
 
     /// Return whether the view belongs to the swap chain.
     bool IsSwapChain() const { return type_ == Type::SwapChainColor || type_ == Type::SwapChainDepthStencil; }
@@ -48,18 +48,31 @@ BatchCompositorPass::BatchCompositorPass(RenderPipelineInterface* renderPipeline
 
 void BatchCompositorPass::SetForwardOutputDesc(const PipelineStateOutputDesc& desc)
 {
+    const unsigned oldRevision = unlitBaseCache_.GetRevision();
+
     unlitBaseCache_.SetOutputDesc(desc);
     litBaseCache_.SetOutputDesc(desc);
     lightCache_.SetOutputDesc(desc);
+
+    if (unlitBaseCache_.GetRevision() != oldRevision)
+        DiscardRetainedBatches();
 }
 
 void BatchCompositorPass::SetDeferredOutputDesc(const PipelineStateOutputDesc& desc)
 {
+    const unsigned oldRevision = deferredCache_.GetRevision();
+
     deferredCache_.SetOutputDesc(desc);
+
+    if (deferredCache_.GetRevision() != oldRevision)
+        DiscardRetainedBatches();
 }
 
 void BatchCompositorPass::ComposeBatches()
 {
+    // Reuse batches of geometries that haven't changed since previous frame
+    AddRetainedBatches();
+
     // Try to process batches in worker threads
     ForEachParallel(workQueue_, geometryBatches_,
         [&](unsigned /*index*/, const GeometryBatch& geometryBatch)
@@ -74,6 +87,8 @@ void BatchCompositorPass::ComposeBatches()
     ResolveDelayedBatches(BatchCompositorSubpass::Light, delayedLightBatches_, lightCache_, lightBatches_);
     ResolveDelayedBatches(BatchCompositorSubpass::Light, delayedNegativeLightBatches_, lightCache_, negativeLightBatches_);
 
+    StoreRetainedBatches();
+
     OnBatchesReady();
 }
 
@@ -91,6 +106,8 @@ void BatchCompositorPass::OnUpdateBegin(const CommonFrameInfo& frameInfo)
     delayedLitBaseBatches_.Clear();
     delayedLightBatches_.Clear();
     delayedNegativeLightBatches_.Clear();
+
+    newRetainedBatches_.Clear();
 }
 
 void BatchCompositorPass::OnPipelineStatesInvalidated()
@@ -99,6 +116,8 @@ void BatchCompositorPass::OnPipelineStatesInvalidated()
     unlitBaseCache_.Invalidate();
     litBaseCache_.Invalidate();
     lightCache_.Invalidate();
+
+    DiscardRetainedBatches();
 }
 
 void BatchCompositorPass::ProcessGeometryBatch(const GeometryBatch& geometryBatch)
@@ -111,6 +130,9 @@ void BatchCompositorPass::ProcessGeometryBatch(const GeometryBatch& geometryBatc
     if (!desc.material_)
         desc.material_ = defaultMaterial_;
 
+    // Only deferred and unlit base batches don't depend on lights and can be retained
+    desc.retain_ = geometryBatch.retain_ && !geometryBatch.lightPass_;
+
     // Always add deferred batch if possible.
     if (desc.pass_)
     {
@@ -185,8 +207,14 @@ void BatchCompositorPass::ResolveDelayedBatches(BatchCompositorSubpass subpass,
         {
             PipelineBatch& pipelineBatch = batches.Emplace(desc);
             if (pipelineState->IsValid())
+            {
                 pipelineBatch.pipelineState_ = pipelineState;
-            else if (PipelineState* placeholderPipelineState = GetPlaceholderPipelineState(cache, pipelineState))
+                if (desc.retain_)
+                    newRetainedBatches_.Insert({pipelineBatch, &batches == &deferredBatches_, desc.pass_});
+                continue;
+            }
+
+            if (PipelineState* placeholderPipelineState = GetPlaceholderPipelineState(cache, pipelineState))
             {
                 pipelineBatch.pipelineState_ = placeholderPipelineState;
                 pipelineBatch.geometryType_ = GEOM_STATIC_NOINSTANCING;
@@ -197,6 +225,10 @@ void BatchCompositorPass::ResolveDelayedBatches(BatchCompositorSubpass subpass,
                 batches.PopBack(WorkQueue::GetThreadIndex());
             }
         }
+
+        // Placeholder batches should be recreated on the next frame
+        if (desc.retain_)
+            drawableProcessor_->DiscardRetainedGeometry(desc.drawableIndex_);
     }
 }
 
@@ -208,6 +240,8 @@ void BatchCompositorPass::AddPipelineBatch(const PipelineBatchDesc& desc, BatchS
     {
         PipelineBatch& pipelineBatch = batches.Emplace(desc);
         pipelineBatch.pipelineState_ = pipelineState;
+        if (desc.retain_)
+            newRetainedBatches_.Insert({pipelineBatch, &batches == &deferredBatches_, desc.pass_});
     }
     else
         delayedBatches.Insert(desc);
@@ -224,6 +258,59 @@ PipelineState* BatchCompositorPass::GetPlaceholderPipelineState(BatchStateCache&
     return cache.GetOrCreatePlaceholderPipelineState(vertexSize, batchStateCacheCallback_);
 }
 
+void BatchCompositorPass::AddRetainedBatches()
+{
+    unsigned numRetainedBatches = 0;
+    for (unsigned i = 0; i < retainedBatches_.size(); ++i)
+    {
+        RetainedBatch& retainedBatch = retainedBatches_[i];
+        const PipelineBatch& batch = retainedBatch.batch_;
+        if (!drawableProcessor_->IsGeometryRetained(batch.drawable_, batch.drawableIndex_))
+            continue;
+
+        // Drawable is visible and therefore alive at this point, process it again if pass has changed
+        if (retainedBatch.pass_->GetPipelineStateHash() != retainedBatch.passHash_)
+        {
+            Pass* pass = retainedBatch.pass_;
+            GeometryBatch geometryBatch = retainedBatch.isDeferred_
+                ? GeometryBatch::Deferred(batch.drawable_, batch.sourceBatchIndex_, pass)
+                : GeometryBatch::Forward(batch.drawable_, batch.sourceBatchIndex_, pass, nullptr, nullptr);
+            geometryBatch.retain_ = true;
+            ProcessGeometryBatch(geometryBatch);
+            continue;
+        }
+
+        WorkQueueVector<PipelineBatch>& batches = retainedBatch.isDeferred_ ? deferredBatches_ : baseBatches_;
+        PipelineBatch& pipelineBatch = batches.Emplace(batch);
+        pipelineBatch.distance_ = pipelineBatch.GetSourceBatch().distance_;
+
+        if (i != numRetainedBatches)
+            retainedBatches_[numRetainedBatches] = ea::move(retainedBatch);
+        ++numRetainedBatches;
+    }
+    retainedBatches_.resize(numRetainedBatches);
+}
+
+void BatchCompositorPass::StoreRetainedBatches()
+{
+    for (const RetainedBatchDesc& desc : newRetainedBatches_)
+    {
+        RetainedBatch& retainedBatch = retainedBatches_.emplace_back();
+        retainedBatch.batch_ = desc.batch_;
+        retainedBatch.isDeferred_ = desc.isDeferred_;
+        retainedBatch.pipelineState_ = desc.batch_.pipelineState_;
+        retainedBatch.pass_ = desc.pass_;
+        retainedBatch.passHash_ = desc.pass_->GetPipelineStateHash();
+    }
+}
+
+void BatchCompositorPass::DiscardRetainedBatches()
+{
+    retainedBatches_.clear();
+    newRetainedBatches_.Clear();
+    drawableProcessor_->DiscardRetainedGeometries();
+}
+
 BatchCompositor::BatchCompositor(RenderPipelineInterface* renderPipeline,
     const DrawableProcessor* drawableProcessor, BatchStateCacheCallback* callback, unsigned shadowPassIndex)
     : Object(renderPipeline->GetContext())
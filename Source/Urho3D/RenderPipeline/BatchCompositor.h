@@ -95,6 +95,8 @@ struct PipelineBatchDesc : public PipelineBatch
     unsigned pixelLightForPipelineStateIndex_{};
     unsigned pixelLightForPipelineStateHash_{};
     /// @}
+    /// Whether the batch may be reused on the next frames.
+    bool retain_{};
 
     PipelineBatchDesc() = default;
     PipelineBatchDesc(Drawable* drawable, unsigned sourceBatchIndex, Pass* pass, void* userData = nullptr)
@@ -154,6 +156,9 @@ public:
 
     void ComposeBatches();
 
+    /// Deferred and unlit base batches of static geometries are retained unless custom batch callback is used.
+    bool CanRetainBatches() const override { return !IsFlagSet(DrawableProcessorPassFlag::BatchCallback); }
+
     bool HasBatches() const
     {
         return deferredBatches_.Size() > 0
@@ -185,6 +190,24 @@ protected:
     WorkQueueVector<PipelineBatch> negativeLightBatches_;
 
 private:
+    /// Batch kept between frames.
+    struct RetainedBatch
+    {
+        PipelineBatch batch_;
+        bool isDeferred_{};
+        SharedPtr<PipelineState> pipelineState_;
+        SharedPtr<Pass> pass_;
+        unsigned passHash_{};
+    };
+
+    /// Batch that should be retained, added in current frame.
+    struct RetainedBatchDesc
+    {
+        PipelineBatch batch_;
+        bool isDeferred_{};
+        Pass* pass_{};
+    };
+
     bool PreparePipelineBatch(PipelineBatchDesc& key, const GeometryBatch& geometryBatch) const;
 
     void ProcessGeometryBatch(const GeometryBatch& geometryBatch);
@@ -194,6 +217,10 @@ private:
         WorkQueueVector<PipelineBatch>& batches, WorkQueueVector<PipelineBatchDesc>& delayedBatches);
     PipelineState* GetPlaceholderPipelineState(BatchStateCache& cache, PipelineState* original);
 
+    void AddRetainedBatches();
+    void StoreRetainedBatches();
+    void DiscardRetainedBatches();
+
     /// Pipeline state caches
     /// @{
     BatchStateCache deferredCache_;
@@ -210,6 +237,12 @@ private:
     WorkQueueVector<PipelineBatchDesc> delayedLightBatches_;
     WorkQueueVector<PipelineBatchDesc> delayedNegativeLightBatches_;
     /// @}
+
+    /// Batches of static geometries retained between frames
+    /// @{
+    ea::vector<RetainedBatch> retainedBatches_;
+    WorkQueueVector<RetainedBatchDesc> newRetainedBatches_;
+    /// @}
 };
 
 /// Batch composition manager.
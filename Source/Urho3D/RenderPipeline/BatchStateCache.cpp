@@ -39,6 +39,7 @@ namespace Urho3D
 void BatchStateCache::Invalidate()
 {
     cache_.clear();
+    ++revision_;
 }
 
 void BatchStateCache::SetOutputDesc(const PipelineStateOutputDesc& outputDesc)
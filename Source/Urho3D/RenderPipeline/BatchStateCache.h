@@ -125,6 +125,8 @@ public:
     void Invalidate();
     /// Set currently used output description. Invalidates cache if it has changed.
     void SetOutputDesc(const PipelineStateOutputDesc& outputDesc);
+    /// Return revision of the cache. Revision is incremented on each invalidation.
+    unsigned GetRevision() const { return revision_; }
 
     /// Return existing pipeline state or nullptr if not found. Thread-safe.
     /// Resulting state may be invalid.
@@ -144,6 +146,8 @@ private:
     ea::unordered_map<BatchStateLookupKey, CachedBatchState> cache_;
     /// Cached placeholder states.
     ea::unordered_map<unsigned, SharedPtr<PipelineState>> placeholderCache_;
+    /// Number of invalidations.
+    unsigned revision_{};
 };
 
 /// Key used to lookup cached pipeline states for UI batches.
@@ -38,6 +38,7 @@
 #include "../RenderPipeline/RenderPipelineDefs.h"
 #include "../Scene/Scene.h"
 
+#include <EASTL/fixed_vector.h>
 #include <EASTL/sort.h>
 
 #include "../DebugNew.h"
@@ -130,14 +131,16 @@ DrawableProcessorPass::DrawableProcessorPass(RenderPipelineInterface* renderPipe
 }
 
 DrawableProcessorPass::AddBatchResult DrawableProcessorPass::AddBatch(unsigned threadIndex,
-    Drawable* drawable, unsigned sourceBatchIndex, Technique* technique)
+    Drawable* drawable, unsigned sourceBatchIndex, Technique* technique, bool retain)
 {
     if (useBatchCallback_)
         return AddCustomBatch(threadIndex, drawable, sourceBatchIndex, technique);
 
     if (Pass* deferredPass = technique->GetPass(deferredPassIndex_))
     {
-        geometryBatches_.PushBack(threadIndex, GeometryBatch::Deferred(drawable, sourceBatchIndex, deferredPass));
+        GeometryBatch batch = GeometryBatch::Deferred(drawable, sourceBatchIndex, deferredPass);
+        batch.retain_ = retain;
+        geometryBatches_.PushBack(threadIndex, batch);
         return { true, false };
     }
 
@@ -148,7 +151,9 @@ DrawableProcessorPass::AddBatchResult DrawableProcessorPass::AddBatch(unsigned t
     if (!unlitBasePass)
         return { false, false };
 
-    geometryBatches_.PushBack(threadIndex, GeometryBatch::Forward(drawable, sourceBatchIndex, unlitBasePass, litBasePass, lightPass));
+    GeometryBatch batch = GeometryBatch::Forward(drawable, sourceBatchIndex, unlitBasePass, litBasePass, lightPass);
+    batch.retain_ = retain;
+    geometryBatches_.PushBack(threadIndex, batch);
     return { true, !!lightPass };
 }
 
@@ -188,6 +193,22 @@ void DrawableProcessor::OnUpdateBegin(const FrameInfo& frameInfo)
     ea::copy_if(allPasses_.begin(), allPasses_.end(), ea::back_inserter(passes_),
         [](const SharedPtr<DrawableProcessorPass>& pass) { return pass->IsEnabled(); });
 
+    // Retained geometries are valid only for the same set of passes
+    unsigned retainingPassesHash = 0;
+    if (settings_.retainStaticBatches_)
+    {
+        for (DrawableProcessorPass* pass : passes_)
+        {
+            if (pass->CanRetainBatches())
+                CombineHash(retainingPassesHash, MakeHash(pass));
+        }
+    }
+    if (retainingPassesHash_ != retainingPassesHash)
+    {
+        retainingPassesHash_ = retainingPassesHash;
+        DiscardRetainedGeometries();
+    }
+
     // Initialize frame constants
     frameInfo_ = frameInfo;
     numDrawables_ = frameInfo_.octree_->GetAllDrawables().size();
@@ -216,12 +237,19 @@ void DrawableProcessor::OnUpdateBegin(const FrameInfo& frameInfo)
     geometryZRanges_.resize(numDrawables_);
     geometryLighting_.resize(numDrawables_);
 
+    ea::swap(visibleGeometries_, previousVisibleGeometries_);
+    visibleGeometries_.resize(numDrawables_);
+    ea::fill(visibleGeometries_.begin(), visibleGeometries_.end(), nullptr);
+    previousVisibleGeometries_.resize(numDrawables_);
+    retainedGeometries_.resize(numDrawables_);
+
     sortedOccluders_.clear();
     geometries_.Clear();
     threadedGeometryUpdates_.Clear();
     nonThreadedGeometryUpdates_.Clear();
 
     lightsTemp_.Clear();
+    lightProbeGeometries_.Clear();
 
     queuedDrawableUpdates_.Clear();
 
@@ -235,6 +263,29 @@ void DrawableProcessor::OnCollectStatistics(RenderPipelineStats& stats)
     stats.numLights_ += lights_.size();
     stats.numGeometries_ += geometries_.Size();
     stats.numShadowedLights_ += numShadowedLights_;
+
+    for (Drawable* drawable : geometries_)
+    {
+        if (geometryFlags_[drawable->GetDrawableIndex()] & GeometryRenderFlag::Retained)
+            ++stats.numRetainedGeometries_;
+    }
+}
+
+bool DrawableProcessor::IsGeometryRetained(const Drawable* drawable, unsigned drawableIndex) const
+{
+    return drawableIndex < numDrawables_ && visibleGeometries_[drawableIndex] == drawable
+        && (geometryFlags_[drawableIndex] & GeometryRenderFlag::Retained);
+}
+
+void DrawableProcessor::DiscardRetainedGeometry(unsigned drawableIndex)
+{
+    if (drawableIndex < retainedGeometries_.size())
+        retainedGeometries_[drawableIndex] = {};
+}
+
+void DrawableProcessor::DiscardRetainedGeometries()
+{
+    ea::fill(retainedGeometries_.begin(), retainedGeometries_.end(), RetainedGeometry{});
 }
 
 void DrawableProcessor::ProcessOccluders(const ea::vector<Drawable*>& occluders, float sizeThreshold)
@@ -305,6 +356,8 @@ void DrawableProcessor::ProcessVisibleDrawables(const ea::vector<Drawable*>& dra
         ProcessVisibleDrawable(drawable);
     });
 
+    ProcessLightProbes();
+
     // Sort lights by component ID for stability
     lights_.resize(lightsTemp_.Size());
     ea::copy(lightsTemp_.Begin(), lightsTemp_.End(), lights_.begin());
@@ -336,6 +389,47 @@ void DrawableProcessor::ProcessVisibleDrawables(const ea::vector<Drawable*>& dra
         sceneZRange_.second = sceneZRange_.first + minSceneZRange;
 }
 
+void DrawableProcessor::ProcessLightProbes()
+{
+    URHO3D_PROFILE("ProcessLightProbes");
+
+    // Number of light probe samples evaluated together
+    static const unsigned batchSize = 256;
+
+    const unsigned numGeometries = lightProbeGeometries_.Size();
+    if (!gi_ || numGeometries == 0)
+        return;
+
+    lightProbeSamples_.resize(numGeometries);
+    lightProbeHints_.resize(numGeometries);
+    lightProbePositions_.resize(numGeometries);
+
+    unsigned index = 0;
+    for (Drawable* drawable : lightProbeGeometries_)
+    {
+        lightProbePositions_[index] = drawable->GetWorldBoundingBox().Center();
+        lightProbeHints_[index] = drawable->GetMutableLightProbeTetrahedronHint();
+        ++index;
+    }
+
+    ForEachParallel(workQueue_, batchSize, numGeometries,
+        [&](unsigned beginIndex, unsigned endIndex)
+    {
+        const unsigned count = endIndex - beginIndex;
+        gi_->SampleAmbientSH(ea::span<const Vector3>(lightProbePositions_).subspan(beginIndex, count),
+            ea::span<unsigned>(lightProbeHints_).subspan(beginIndex, count),
+            ea::span<SphericalHarmonicsDot9>(lightProbeSamples_).subspan(beginIndex, count));
+    });
+
+    index = 0;
+    for (Drawable* drawable : lightProbeGeometries_)
+    {
+        drawable->GetMutableLightProbeTetrahedronHint() = lightProbeHints_[index];
+        geometryLighting_[drawable->GetDrawableIndex()].sphericalHarmonics_ += lightProbeSamples_[index];
+        ++index;
+    }
+}
+
 void DrawableProcessor::UpdateDrawableZone(const BoundingBox& boundingBox, Drawable* drawable) const
 {
     const Vector3 drawableCenter = boundingBox.Center();
@@ -446,6 +540,19 @@ void DrawableProcessor::CheckMaterialForAuxiliaryRenderSurfaces(Material* materi
     material->MarkForAuxView(frameInfo_.frameNumber_);
 }
 
+bool DrawableProcessor::CanRetainDrawableBatches(Drawable* drawable) const
+{
+    if (!retainingPassesHash_ || drawable->GetUpdateGeometryType() != UPDATE_NONE)
+        return false;
+
+    for (const SourceBatch& sourceBatch : drawable->GetBatches())
+    {
+        if (sourceBatch.geometryType_ != GEOM_STATIC && sourceBatch.geometryType_ != GEOM_STATIC_NOINSTANCING)
+            return false;
+    }
+    return true;
+}
+
 void DrawableProcessor::ProcessVisibleDrawable(Drawable* drawable)
 {
     const unsigned drawableIndex = drawable->GetDrawableIndex();
@@ -485,11 +592,18 @@ void DrawableProcessor::ProcessVisibleDrawable(Drawable* drawable)
         LightAccumulator& lightAccumulator = geometryLighting_[drawableIndex];
         lightAccumulator.ResetLights();
 
-        // Collect batches
-        bool isForwardLit = false;
-        bool needAmbient = false;
+        // Find techniques and calculate hash of batches if they may be retained
+        const bool canRetain = CanRetainDrawableBatches(drawable);
+        unsigned batchesHash = 0;
+        if (canRetain)
+        {
+            CombineHash(batchesHash, drawable->GetPipelineStateHash());
+            CombineHash(batchesHash, drawable->GetBatches().size());
+            CombineHash(batchesHash, MakeHash(drawable->GetZone()));
+        }
 
         const auto& sourceBatches = drawable->GetBatches();
+        ea::fixed_vector<Technique*, 4> techniques(sourceBatches.size());
         for (unsigned sourceBatchIndex = 0; sourceBatchIndex < sourceBatches.size(); ++sourceBatchIndex)
         {
             const SourceBatch& sourceBatch = sourceBatches[sourceBatchIndex];
@@ -502,37 +616,84 @@ void DrawableProcessor::ProcessVisibleDrawable(Drawable* drawable)
             if (!technique)
                 continue;
 
+            techniques[sourceBatchIndex] = technique;
+
             // Check for aux views
             CheckMaterialForAuxiliaryRenderSurfaces(sourceBatch.material_);
 
+            if (canRetain)
+            {
+                CombineHash(batchesHash, sourceBatchIndex);
+                CombineHash(batchesHash, MakeHash(sourceBatch.geometry_));
+                CombineHash(batchesHash, MakeHash(sourceBatch.material_));
+                CombineHash(batchesHash, MakeHash(technique));
+                CombineHash(batchesHash, sourceBatch.geometry_->GetPipelineStateHash());
+                CombineHash(batchesHash, material->GetPipelineStateHash());
+                CombineHash(batchesHash, sourceBatch.geometryType_);
+                CombineHash(batchesHash, sourceBatch.lightmapIndex_);
+            }
+        }
+
+        // Reuse batches from previous frame if nothing has changed
+        RetainedGeometry& retainedGeometry = retainedGeometries_[drawableIndex];
+        const bool isRetained = canRetain && batchesHash != 0 && retainedGeometry.batchesHash_ == batchesHash
+            && previousVisibleGeometries_[drawableIndex] == drawable;
+
+        // Collect batches
+        bool isForwardLit = false;
+        bool needAmbient = isRetained && retainedGeometry.needAmbient_;
+        bool isRetainedForwardLit = false;
+        bool retainedNeedAmbient = false;
+
+        for (unsigned sourceBatchIndex = 0; sourceBatchIndex < sourceBatches.size(); ++sourceBatchIndex)
+        {
+            Technique* technique = techniques[sourceBatchIndex];
+            if (!technique)
+                continue;
+
             // Update scene passes
             for (DrawableProcessorPass* pass : passes_)
             {
+                const bool retain = canRetain && pass->CanRetainBatches();
+                if (isRetained && retain)
+                    continue;
+
                 // TODO: Check whether pass is supported on mobile?
                 const DrawableProcessorPass::AddBatchResult result = pass->AddBatch(
-                    threadIndex, drawable, sourceBatchIndex, technique);
+                    threadIndex, drawable, sourceBatchIndex, technique, retain);
+                const bool addedAmbient = result.added_ && pass->GetFlags().Test(DrawableProcessorPassFlag::HasAmbientLighting);
                 if (result.forwardLitAdded_)
                     isForwardLit = true;
-                if (result.added_ && pass->GetFlags().Test(DrawableProcessorPassFlag::HasAmbientLighting))
+                if (addedAmbient)
                     needAmbient = true;
+
+                if (retain)
+                {
+                    isRetainedForwardLit |= result.forwardLitAdded_;
+                    retainedNeedAmbient |= addedAmbient;
+                }
             }
         }
 
+        // Forward lit batches depend on lights and are never retained
+        if (!isRetained)
+        {
+            if (canRetain && !isRetainedForwardLit)
+                retainedGeometry = {batchesHash, retainedNeedAmbient};
+            else
+                retainedGeometry = {};
+        }
+
         // Process lighting
         if (needAmbient)
         {
             const GlobalIlluminationType giType = drawable->GetGlobalIlluminationType();
             const ReflectionMode reflectionMode = drawable->GetReflectionMode();
 
-            // Reset SH from GI if possible/needed, reset to zero otherwise
+            // Reset SH, light probes are sampled later in batch if needed
+            lightAccumulator.sphericalHarmonics_ = {};
             if (gi_ && giType >= GlobalIlluminationType::BlendLightProbes)
-            {
-                unsigned& hint = drawable->GetMutableLightProbeTetrahedronHint();
-                const Vector3& samplePosition = boundingBox.Center();
-                lightAccumulator.sphericalHarmonics_ = gi_->SampleAmbientSH(samplePosition, hint);
-            }
-            else
-                lightAccumulator.sphericalHarmonics_ = {};
+                lightProbeGeometries_.PushBack(threadIndex, drawable);
 
             // Apply ambient from Zone
             const CachedDrawableZone& cachedZone = drawable->GetMutableCachedZone();
@@ -574,6 +735,7 @@ void DrawableProcessor::ProcessVisibleDrawable(Drawable* drawable)
 
         // Store geometry
         geometries_.PushBack(threadIndex, drawable);
+        visibleGeometries_[drawableIndex] = drawable;
 
         // Update flags
         unsigned char& flag = geometryFlags_[drawableIndex];
@@ -582,6 +744,8 @@ void DrawableProcessor::ProcessVisibleDrawable(Drawable* drawable)
             flag |= GeometryRenderFlag::Lit;
         if (isForwardLit)
             flag |= GeometryRenderFlag::ForwardLit;
+        if (isRetained)
+            flag |= GeometryRenderFlag::Retained;
 
         // Queue geometry update
         QueueDrawableGeometryUpdate(threadIndex, drawable);
@@ -681,7 +845,7 @@ void DrawableProcessor::FinalizeForwardLighting()
     });
 }
 
-void DrawableProcessor::ProcessForwardLighting()
+void DrawableProcessor::ProcessForwardLighting(bool clusteredLighting)
 {
     URHO3D_PROFILE("ProcessForwardLighting");
 
@@ -689,6 +853,9 @@ void DrawableProcessor::ProcessForwardLighting()
     for (unsigned i = 0; i < lightProcessors_.size(); ++i)
     {
         const LightProcessor* lightProcessor = lightProcessors_[i];
+        if (clusteredLighting && lightProcessor->IsClusterable())
+            continue;
+
         if (lightProcessor->HasForwardLitGeometries())
         {
             ProcessForwardLightingForLight(i, lightProcessor->GetLitGeometries());
@@ -704,7 +871,6 @@ void DrawableProcessor::PreprocessShadowCasters(ea::vector<Drawable*>& shadowCas
 {
     shadowCasters.clear();
 
-    const Frustum& shadowCameraFrustum = shadowCamera->GetFrustum();
     const Matrix3x4& worldToLightSpace = shadowCamera->GetView();
     const LightType lightType = light->GetLightType();
 
@@ -720,10 +886,6 @@ void DrawableProcessor::PreprocessShadowCasters(ea::vector<Drawable*>& shadowCas
 
     for (Drawable* drawable : candidates)
     {
-        // For point light, check that this drawable is inside the split shadow camera frustum
-        if (lightType == LIGHT_POINT && shadowCameraFrustum.IsInsideFast(drawable->GetWorldBoundingBox()) == OUTSIDE)
-            continue;
-
         // Queue shadow caster if it's visible
         const BoundingBox lightSpaceBoundingBox = drawable->GetWorldBoundingBox().Transformed(worldToLightSpace);
         const bool isDrawableVisible = !!(geometryFlags_[drawable->GetDrawableIndex()] & GeometryRenderFlag::VisibleInCullCamera);
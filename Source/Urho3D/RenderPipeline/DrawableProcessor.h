@@ -54,6 +54,8 @@ struct GeometryRenderFlag
         VisibleInCullCamera = 1 << 0,
         Lit = 1 << 1,
         ForwardLit = 1 << 2,
+        /// Batches of the geometry are reused from previous frame by passes that retain batches.
+        Retained = 1 << 3,
     };
 };
 
@@ -93,6 +95,8 @@ struct GeometryBatch
     Drawable* drawable_{};
     unsigned sourceBatchIndex_{};
     void* userData_{};
+    /// Whether the pass may keep resulting batches for the next frames.
+    bool retain_{};
 
     /// If deferred pass is present, unlit base, lit base and light passes are ignored.
     Pass* deferredPass_{};
@@ -136,7 +140,12 @@ public:
     /// Custom callback for adding batches.
     virtual AddBatchResult AddCustomBatch(unsigned threadIndex, Drawable* drawable, unsigned sourceBatchIndex, Technique* technique) { return {}; }
 
-    AddBatchResult AddBatch(unsigned threadIndex, Drawable* drawable, unsigned sourceBatchIndex, Technique* technique);
+    AddBatchResult AddBatch(unsigned threadIndex, Drawable* drawable, unsigned sourceBatchIndex, Technique* technique,
+        bool retain = false);
+
+    /// Return whether the pass can keep batches of static geometries between frames.
+    /// Such pass should reuse batches of geometries with GeometryRenderFlag::Retained set.
+    virtual bool CanRetainBatches() const { return false; }
 
     DrawableProcessorPassFlags GetFlags() const { return flags_; }
     bool IsFlagSet(DrawableProcessorPassFlags flag) const { return flags_.Test(flag); }
@@ -184,6 +193,7 @@ public:
 
     const FrameInfo& GetFrameInfo() const { return frameInfo_; }
     const DrawableProcessorSettings& GetSettings() const { return settings_; }
+    WorkQueue* GetWorkQueue() const { return workQueue_; }
 
     /// Process occluders. UpdateBatches for occluders may be called twice, but never reentrantly.
     void ProcessOccluders(const ea::vector<Drawable*>& occluders, float sizeThreshold);
@@ -217,7 +227,17 @@ public:
     const LightAccumulator& GetGeometryLighting(unsigned drawableIndex) const { return geometryLighting_[drawableIndex]; }
     /// @}
 
+    /// Retained geometries. Geometry is retained if it was visible in previous frame and its batches haven't changed.
+    /// Drawable may be expired, it is never dereferenced.
+    /// @{
+    bool IsGeometryRetained(const Drawable* drawable, unsigned drawableIndex) const;
+    /// Discard retained batches of the geometry. Batches will be added as usual on the next frame.
+    void DiscardRetainedGeometry(unsigned drawableIndex);
+    void DiscardRetainedGeometries();
+    /// @}
+
     /// Internal. Pre-process shadow caster candidates. Safe to call from worker thread.
+    /// Candidates of point light shadow split should be inside the split frustum.
     void PreprocessShadowCasters(ea::vector<Drawable*>& shadowCasters,
         const ea::vector<Drawable*>& candidates, const FloatRange& frustumSubRange, Light* light, Camera* shadowCamera);
     /// Internal. Finalize shadow casters processing.
@@ -230,19 +250,22 @@ public:
     /// Should be called after all forward lighting is processed.
     void FinalizeForwardLighting();
     /// Process forward lighting for all lights.
-    void ProcessForwardLighting();
+    /// If clustered lighting is enabled, lights that can be clustered are skipped.
+    void ProcessForwardLighting(bool clusteredLighting = false);
 
     /// Update drawable geometries if needed.
     void UpdateGeometries();
 
 protected:
     void ProcessVisibleDrawable(Drawable* drawable);
+    void ProcessLightProbes();
     void ProcessQueuedDrawable(Drawable* drawable);
     void UpdateDrawableZone(const BoundingBox& boundingBox, Drawable* drawable) const;
     void UpdateDrawableReflection(const BoundingBox& boundingBox, Drawable* drawable) const;
     void QueueDrawableUpdate(Drawable* drawable);
     void QueueDrawableGeometryUpdate(unsigned threadIndex, Drawable* drawable);
     void CheckMaterialForAuxiliaryRenderSurfaces(Material* material);
+    bool CanRetainDrawableBatches(Drawable* drawable) const;
 
     FloatRange CalculateBoundingBoxZRange(const BoundingBox& boundingBox) const;
 
@@ -259,6 +282,15 @@ private:
         UpdateFlag(UpdateFlag&& other) {}
     };
 
+    /// Properties of geometry whose batches may be reused on the next frame.
+    struct RetainedGeometry
+    {
+        /// Hash of all batches of the geometry. Zero if batches cannot be reused.
+        unsigned batchesHash_{};
+        /// Whether retained batches need ambient lighting.
+        bool needAmbient_{};
+    };
+
     /// External dependencies
     /// @{
     WorkQueue* workQueue_{};
@@ -271,6 +303,9 @@ private:
     ea::vector<DrawableProcessorPass*> passes_;
     DrawableProcessorSettings settings_;
     ea::unique_ptr<LightProcessorCache> lightProcessorCache_;
+    unsigned retainingPassesHash_{};
+    ea::vector<Drawable*> previousVisibleGeometries_;
+    ea::vector<RetainedGeometry> retainedGeometries_;
     /// @}
 
     /// Constant within frame, changes between frames
@@ -292,6 +327,7 @@ private:
     ea::vector<unsigned char> geometryFlags_;
     ea::vector<FloatRange> geometryZRanges_;
     ea::vector<LightAccumulator> geometryLighting_;
+    ea::vector<Drawable*> visibleGeometries_;
     /// @}
 
     ea::vector<FloatRange> sceneZRangeTemp_;
@@ -303,6 +339,11 @@ private:
     WorkQueueVector<Drawable*> threadedGeometryUpdates_;
     WorkQueueVector<Drawable*> nonThreadedGeometryUpdates_;
 
+    WorkQueueVector<Drawable*> lightProbeGeometries_;
+    ea::vector<Vector3> lightProbePositions_;
+    ea::vector<unsigned> lightProbeHints_;
+    ea::vector<SphericalHarmonicsDot9> lightProbeSamples_;
+
     WorkQueueVector<Light*> lightsTemp_;
     ea::vector<Light*> lights_;
     ea::vector<LightDataForAccumulator> lightDataForAccumulator_;
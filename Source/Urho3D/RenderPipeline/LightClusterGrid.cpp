@@ -0,0 +1,344 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../Precompiled.h"
+
+#include "../RenderPipeline/LightClusterGrid.h"
+
+#include "../Core/WorkQueue.h"
+#include "../Graphics/Camera.h"
+#include "../Graphics/Texture2D.h"
+#include "../Math/Rect.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Return point in view space that is projected to given position in NDC at given view depth.
+Vector3 UnprojectAtDepth(const Matrix4& projection, const Vector2& ndcPosition, float depth)
+{
+    const float w = projection.m32_ * depth + projection.m33_;
+    const float x = (ndcPosition.x_ * w - projection.m02_ * depth - projection.m03_) / projection.m00_;
+    const float y = (ndcPosition.y_ * w - projection.m12_ * depth - projection.m13_) / projection.m11_;
+    return {x, y, depth};
+}
+
+bool IsSphereIntersectingBox(const Vector3& center, float radius, const BoundingBox& box)
+{
+    const Vector3 closestPoint = VectorMin(VectorMax(center, box.min_), box.max_);
+    return (closestPoint - center).LengthSquared() <= radius * radius;
+}
+
+}
+
+LightClusterGrid::LightClusterGrid(Context* context)
+    : Object(context)
+{
+}
+
+LightClusterGrid::~LightClusterGrid()
+{
+}
+
+void LightClusterGrid::SetSettings(const LightClusterGridSettings& settings)
+{
+    LightClusterGridSettings validatedSettings = settings;
+    validatedSettings.Validate();
+    if (settings_ != validatedSettings)
+    {
+        settings_ = validatedSettings;
+        // Force rebuild of cluster boxes
+        clusterBoxes_.clear();
+    }
+}
+
+void LightClusterGrid::Build(Camera* camera, ea::span<const Sphere> lightBounds, WorkQueue* workQueue)
+{
+    Build(camera->GetView(), camera->GetProjection(true), camera->GetNearClip(), camera->GetFarClip(),
+        camera->IsOrthographic(), lightBounds, workQueue);
+}
+
+void LightClusterGrid::Build(const Matrix3x4& view, const Matrix4& projection, float nearClip, float farClip,
+    bool isOrthographic, ea::span<const Sphere> lightBounds, WorkQueue* workQueue)
+{
+    URHO3D_PROFILE("BuildLightClusters");
+
+    UpdateClusterBoxes(projection, nearClip, farClip, isOrthographic);
+    viewProj_ = projection * view;
+
+    const auto numLights = static_cast<unsigned>(lightBounds.size());
+    const auto numSlices = static_cast<unsigned>(settings_.gridSize_.z_);
+    lightRanges_.resize(numLights);
+    slices_.resize(numSlices);
+
+    // Find clusters affected by each light
+    const auto updateLightRanges = [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+            UpdateLightRange(view, lightBounds[i], lightRanges_[i]);
+    };
+
+    // Fill clusters slice by slice so each thread owns its output
+    const auto fillSlices = [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+            FillSlice(i);
+    };
+
+    if (workQueue)
+    {
+        ForEachParallel(workQueue, 64u, numLights, updateLightRanges);
+        ForEachParallel(workQueue, 1u, numSlices, fillSlices);
+    }
+    else
+    {
+        updateLightRanges(0, numLights);
+        fillSlices(0, numSlices);
+    }
+
+    MergeSlices();
+}
+
+void LightClusterGrid::UpdateTextures(ea::span<const Vector4> lightData)
+{
+    URHO3D_PROFILE("UpdateLightClusterTextures");
+
+    const unsigned numClusters = clusterHeaders_.size();
+    const unsigned numIndexTexels = (lightIndices_.size() + 3) / 4;
+
+    // Cluster headers are followed by light indices packed by four
+    clusterTextureData_.clear();
+    clusterTextureData_.resize(numClusters + numIndexTexels, Vector4::ZERO);
+    for (unsigned i = 0; i < numClusters; ++i)
+    {
+        const ClusterHeader& header = clusterHeaders_[i];
+        clusterTextureData_[i] = Vector4(static_cast<float>(header.offset_), static_cast<float>(header.count_), 0.0f, 0.0f);
+    }
+
+    auto packedIndices = reinterpret_cast<float*>(clusterTextureData_.data() + numClusters);
+    for (unsigned i = 0; i < lightIndices_.size(); ++i)
+        packedIndices[i] = static_cast<float>(lightIndices_[i]);
+
+    lightTextureData_.assign(lightData.begin(), lightData.end());
+
+    UpdateTexture(clusterTexture_, clusterTextureData_);
+    UpdateTexture(lightTexture_, lightTextureData_);
+}
+
+unsigned LightClusterGrid::GetClusterIndex(const IntVector3& cluster) const
+{
+    const IntVector3& gridSize = settings_.gridSize_;
+    return (cluster.z_ * gridSize.y_ + cluster.y_) * gridSize.x_ + cluster.x_;
+}
+
+ea::span<const unsigned> LightClusterGrid::GetClusterLights(unsigned clusterIndex) const
+{
+    const ClusterHeader& header = clusterHeaders_[clusterIndex];
+    return {lightIndices_.data() + header.offset_, header.count_};
+}
+
+Vector4 LightClusterGrid::GetGridSizeParameter() const
+{
+    return {settings_.gridSize_.ToVector3(), 0.0f};
+}
+
+Vector4 LightClusterGrid::GetDepthParameter() const
+{
+    // Shader receives linear depth normalized to far clip plane.
+    // For orthographic projection, depth 0 is near plane.
+    // For perspective projection, depth 0 is camera position.
+    const auto numSlices = static_cast<float>(settings_.gridSize_.z_);
+    if (isOrthographic_)
+        return {numSlices, 0.0f, 1.0f, 0.0f};
+
+    const float scale = numSlices / Ln(farClip_ / nearClip_);
+    return {scale, numSlices, 0.0f, 0.0f};
+}
+
+void LightClusterGrid::UpdateClusterBoxes(
+    const Matrix4& projection, float nearClip, float farClip, bool isOrthographic)
+{
+    nearClip = ea::max(nearClip, M_MIN_NEARCLIP);
+    farClip = ea::max(farClip, nearClip * (1.0f + M_LARGE_EPSILON));
+
+    const IntVector3& gridSize = settings_.gridSize_;
+    const auto numClusters = static_cast<unsigned>(gridSize.x_ * gridSize.y_ * gridSize.z_);
+    if (clusterBoxes_.size() == numClusters && projection_ == projection && nearClip_ == nearClip
+        && farClip_ == farClip && isOrthographic_ == isOrthographic)
+        return;
+
+    projection_ = projection;
+    nearClip_ = nearClip;
+    farClip_ = farClip;
+    isOrthographic_ = isOrthographic;
+
+    clusterBoxes_.resize(numClusters);
+    clusterHeaders_.resize(numClusters);
+
+    const Vector2 tileSize = Vector2::ONE * 2.0f / gridSize.ToVector2();
+    for (int z = 0; z < gridSize.z_; ++z)
+    {
+        const float sliceNear = GetSliceDepth(z);
+        const float sliceFar = GetSliceDepth(z + 1);
+        for (int y = 0; y < gridSize.y_; ++y)
+        {
+            for (int x = 0; x < gridSize.x_; ++x)
+            {
+                const Vector2 tileMin = IntVector2(x, y).ToVector2() * tileSize - Vector2::ONE;
+                const Vector2 tileMax = tileMin + tileSize;
+                const Vector2 tileCorners[] = {
+                    tileMin, {tileMax.x_, tileMin.y_}, {tileMin.x_, tileMax.y_}, tileMax};
+
+                BoundingBox& box = clusterBoxes_[GetClusterIndex({x, y, z})];
+                box.Clear();
+                for (const Vector2& corner : tileCorners)
+                {
+                    box.Merge(UnprojectAtDepth(projection, corner, sliceNear));
+                    box.Merge(UnprojectAtDepth(projection, corner, sliceFar));
+                }
+            }
+        }
+    }
+}
+
+float LightClusterGrid::GetSliceDepth(unsigned slice) const
+{
+    const float factor = static_cast<float>(slice) / settings_.gridSize_.z_;
+    return isOrthographic_ ? Lerp(nearClip_, farClip_, factor) : nearClip_ * Pow(farClip_ / nearClip_, factor);
+}
+
+int LightClusterGrid::GetSliceIndex(float depth) const
+{
+    const int numSlices = settings_.gridSize_.z_;
+    const float slice = isOrthographic_
+        ? (depth - nearClip_) / (farClip_ - nearClip_) * numSlices
+        : Ln(ea::max(depth, nearClip_) / nearClip_) / Ln(farClip_ / nearClip_) * numSlices;
+    return Clamp(FloorToInt(slice), 0, numSlices - 1);
+}
+
+IntVector2 LightClusterGrid::GetTileIndex(const Vector2& ndcPosition) const
+{
+    const IntVector2 gridSize = settings_.gridSize_.ToIntVector2();
+    const Vector2 position = (ndcPosition * 0.5f + Vector2::ONE * 0.5f) * gridSize.ToVector2();
+    return VectorMin(VectorMax(VectorFloorToInt(position), IntVector2::ZERO), gridSize - IntVector2::ONE);
+}
+
+void LightClusterGrid::UpdateLightRange(const Matrix3x4& view, const Sphere& bounds, LightRange& range) const
+{
+    range.center_ = view * bounds.center_;
+    range.radius_ = bounds.radius_;
+    range.isVisible_ = false;
+
+    const float minDepth = range.center_.z_ - range.radius_;
+    const float maxDepth = range.center_.z_ + range.radius_;
+    if (maxDepth < nearClip_ || minDepth > farClip_)
+        return;
+
+    const Vector3 extents = Vector3::ONE * range.radius_;
+    const Rect screenRect = BoundingBox(range.center_ - extents, range.center_ + extents).Projected(projection_);
+    if (screenRect.max_.x_ < -1.0f || screenRect.max_.y_ < -1.0f
+        || screenRect.min_.x_ > 1.0f || screenRect.min_.y_ > 1.0f)
+        return;
+
+    const IntVector2 minTile = GetTileIndex(screenRect.min_);
+    const IntVector2 maxTile = GetTileIndex(screenRect.max_);
+    range.min_ = {minTile.x_, minTile.y_, GetSliceIndex(minDepth)};
+    range.max_ = {maxTile.x_, maxTile.y_, GetSliceIndex(maxDepth)};
+    range.isVisible_ = true;
+}
+
+void LightClusterGrid::FillSlice(unsigned slice)
+{
+    SliceData& sliceData = slices_[slice];
+    sliceData.lights_.clear();
+    sliceData.lightIndices_.clear();
+
+    const auto sliceIndex = static_cast<int>(slice);
+    const auto numLights = static_cast<unsigned>(lightRanges_.size());
+    for (unsigned lightIndex = 0; lightIndex < numLights; ++lightIndex)
+    {
+        const LightRange& range = lightRanges_[lightIndex];
+        if (range.isVisible_ && range.min_.z_ <= sliceIndex && sliceIndex <= range.max_.z_)
+            sliceData.lights_.push_back(lightIndex);
+    }
+
+    const IntVector3& gridSize = settings_.gridSize_;
+    for (int y = 0; y < gridSize.y_; ++y)
+    {
+        for (int x = 0; x < gridSize.x_; ++x)
+        {
+            const unsigned clusterIndex = GetClusterIndex({x, y, sliceIndex});
+            const BoundingBox& clusterBox = clusterBoxes_[clusterIndex];
+
+            ClusterHeader& header = clusterHeaders_[clusterIndex];
+            header.offset_ = sliceData.lightIndices_.size();
+            header.count_ = 0;
+
+            for (unsigned lightIndex : sliceData.lights_)
+            {
+                const LightRange& range = lightRanges_[lightIndex];
+                if (x < range.min_.x_ || x > range.max_.x_ || y < range.min_.y_ || y > range.max_.y_)
+                    continue;
+
+                if (!IsSphereIntersectingBox(range.center_, range.radius_, clusterBox))
+                    continue;
+
+                sliceData.lightIndices_.push_back(lightIndex);
+                if (++header.count_ >= settings_.maxLightsPerCluster_)
+                    break;
+            }
+        }
+    }
+}
+
+void LightClusterGrid::MergeSlices()
+{
+    unsigned numLightIndices = 0;
+    for (SliceData& sliceData : slices_)
+    {
+        sliceData.offset_ = numLightIndices;
+        numLightIndices += sliceData.lightIndices_.size();
+    }
+
+    lightIndices_.resize(numLightIndices);
+    const IntVector3& gridSize = settings_.gridSize_;
+    const auto numClustersInSlice = static_cast<unsigned>(gridSize.x_ * gridSize.y_);
+    for (unsigned slice = 0; slice < slices_.size(); ++slice)
+    {
+        const SliceData& sliceData = slices_[slice];
+        ea::copy(sliceData.lightIndices_.begin(), sliceData.lightIndices_.end(),
+            lightIndices_.begin() + sliceData.offset_);
+
+        for (unsigned i = 0; i < numClustersInSlice; ++i)
+            clusterHeaders_[slice * numClustersInSlice + i].offset_ += sliceData.offset_;
+    }
+}
+
+void LightClusterGrid::UpdateTexture(SharedPtr<Texture2D>& texture, ea::vector<Vector4>& data)
+{
+    const unsigned numRows = ea::max(1u, (data.size() + TextureWidth - 1) / TextureWidth);
+    data.resize(numRows * TextureWidth, Vector4::ZERO);
+
+    if (!texture)
+    {
+        texture = MakeShared<Texture2D>(context_);
+        texture->SetName("LightClusterGrid");
+        texture->SetNumLevels(1);
+        texture->SetFilterMode(FILTER_NEAREST);
+    }
+
+    if (texture->GetHeight() < static_cast<int>(numRows))
+    {
+        const auto textureHeight = static_cast<int>(NextPowerOfTwo(numRows));
+        texture->SetSize(TextureWidth, textureHeight, TextureFormat::TEX_FORMAT_RGBA32_FLOAT);
+    }
+
+    texture->SetData(0, 0, 0, TextureWidth, numRows, data.data());
+}
+
+}
@@ -0,0 +1,168 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "../Core/Object.h"
+#include "../Math/BoundingBox.h"
+#include "../Math/Matrix3x4.h"
+#include "../Math/Sphere.h"
+
+#include <EASTL/span.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class Camera;
+class Texture2D;
+class WorkQueue;
+
+/// Parameters of light cluster grid.
+struct LightClusterGridSettings
+{
+    /// Number of clusters along screen width, screen height and view depth.
+    IntVector3 gridSize_{16, 9, 24};
+    /// Max number of lights in one cluster. Extra lights are ignored.
+    unsigned maxLightsPerCluster_{64};
+
+    /// Utility operators
+    /// @{
+    void Validate()
+    {
+        gridSize_.x_ = Clamp(gridSize_.x_, 1, 256);
+        gridSize_.y_ = Clamp(gridSize_.y_, 1, 256);
+        gridSize_.z_ = Clamp(gridSize_.z_, 1, 256);
+        maxLightsPerCluster_ = Clamp(maxLightsPerCluster_, 1u, 1024u);
+    }
+
+    bool operator==(const LightClusterGridSettings& rhs) const
+    {
+        return gridSize_ == rhs.gridSize_
+            && maxLightsPerCluster_ == rhs.maxLightsPerCluster_;
+    }
+
+    bool operator!=(const LightClusterGridSettings& rhs) const { return !(*this == rhs); }
+    /// @}
+};
+
+/// Grid of frustum-aligned light clusters (froxels) used by clustered forward lighting.
+/// Clusters are distributed evenly in screen space and exponentially along view depth.
+/// Orthographic cameras use linear distribution along view depth.
+///
+/// Each cluster contains compact list of indices of lights intersecting the cluster.
+/// Cluster lists and light data are stored in textures consumed by _ClusteredLighting.glsl.
+class URHO3D_API LightClusterGrid : public Object
+{
+    URHO3D_OBJECT(LightClusterGrid, Object);
+
+public:
+    /// Width of cluster and light textures in texels. Keep in sync with _ClusteredLighting.glsl.
+    static const unsigned TextureWidth = 1024;
+    /// Number of texels per light in light texture. Keep in sync with _ClusteredLighting.glsl.
+    static const unsigned LightStride = 4;
+
+    explicit LightClusterGrid(Context* context);
+    ~LightClusterGrid() override;
+
+    void SetSettings(const LightClusterGridSettings& settings);
+    const LightClusterGridSettings& GetSettings() const { return settings_; }
+
+    /// Build clusters for the camera. Lights are described by bounding spheres in world space.
+    /// Clusters are processed in worker threads if work queue is provided.
+    void Build(Camera* camera, ea::span<const Sphere> lightBounds, WorkQueue* workQueue);
+    /// Build clusters for arbitrary view and projection.
+    void Build(const Matrix3x4& view, const Matrix4& projection, float nearClip, float farClip, bool isOrthographic,
+        ea::span<const Sphere> lightBounds, WorkQueue* workQueue);
+    /// Upload clusters and light data to textures.
+    /// Light data should contain LightStride vectors per light in the same order as light bounds.
+    void UpdateTextures(ea::span<const Vector4> lightData);
+
+    /// Return cluster properties
+    /// @{
+    unsigned GetNumClusters() const { return clusterHeaders_.size(); }
+    unsigned GetClusterIndex(const IntVector3& cluster) const;
+    ea::span<const unsigned> GetClusterLights(unsigned clusterIndex) const;
+    /// Return bounding box of the cluster in view space.
+    const BoundingBox& GetClusterBoundingBox(unsigned clusterIndex) const { return clusterBoxes_[clusterIndex]; }
+    unsigned GetNumLightIndices() const { return lightIndices_.size(); }
+    /// @}
+
+    /// Return shader parameters and resources
+    /// @{
+    const Matrix4& GetViewProjection() const { return viewProj_; }
+    Vector4 GetGridSizeParameter() const;
+    Vector4 GetDepthParameter() const;
+    Texture2D* GetClusterTexture() const { return clusterTexture_; }
+    Texture2D* GetLightTexture() const { return lightTexture_; }
+    /// @}
+
+private:
+    /// Offset and size of light index list of the cluster.
+    struct ClusterHeader
+    {
+        unsigned offset_{};
+        unsigned count_{};
+    };
+
+    /// Light bounds in view space and range of affected clusters.
+    struct LightRange
+    {
+        Vector3 center_;
+        float radius_{};
+        IntVector3 min_;
+        IntVector3 max_;
+        bool isVisible_{};
+    };
+
+    /// Lights and light indices of one depth slice. Filled independently for each slice.
+    struct SliceData
+    {
+        ea::vector<unsigned> lights_;
+        ea::vector<unsigned> lightIndices_;
+        unsigned offset_{};
+    };
+
+    void UpdateClusterBoxes(const Matrix4& projection, float nearClip, float farClip, bool isOrthographic);
+    float GetSliceDepth(unsigned slice) const;
+    int GetSliceIndex(float depth) const;
+    IntVector2 GetTileIndex(const Vector2& ndcPosition) const;
+
+    void UpdateLightRange(const Matrix3x4& view, const Sphere& bounds, LightRange& range) const;
+    void FillSlice(unsigned slice);
+    void MergeSlices();
+
+    void UpdateTexture(SharedPtr<Texture2D>& texture, ea::vector<Vector4>& data);
+
+    LightClusterGridSettings settings_;
+
+    /// Projection used to build cluster boxes
+    /// @{
+    Matrix4 projection_;
+    float nearClip_{};
+    float farClip_{};
+    bool isOrthographic_{};
+    /// @}
+
+    /// Cluster data
+    /// @{
+    ea::vector<BoundingBox> clusterBoxes_;
+    ea::vector<ClusterHeader> clusterHeaders_;
+    ea::vector<unsigned> lightIndices_;
+    Matrix4 viewProj_;
+    /// @}
+
+    /// Temporary buffers
+    /// @{
+    ea::vector<LightRange> lightRanges_;
+    ea::vector<SliceData> slices_;
+    ea::vector<Vector4> clusterTextureData_;
+    ea::vector<Vector4> lightTextureData_;
+    /// @}
+
+    SharedPtr<Texture2D> clusterTexture_;
+    SharedPtr<Texture2D> lightTexture_;
+};
+
+}
@@ -252,23 +252,33 @@ void LightProcessor::Update(DrawableProcessor* drawableProcessor, const LightPro
 
     InitializeShadowSplits(drawableProcessor);
 
-    for (unsigned i = 0; i < numActiveSplits_; ++i)
+    // Point light splits share candidates, store their bounding boxes in contiguous array for faster culling
+    if (lightType == LIGHT_POINT)
+    {
+        shadowCasterCandidateBoxes_.clear();
+        for (Drawable* drawable : shadowCasterCandidates_)
+            shadowCasterCandidateBoxes_.push_back(drawable->GetWorldBoundingBox());
+    }
+
+    // Splits are independent, process them in parallel
+    ForEachParallel(drawableProcessor->GetWorkQueue(), GetMutableSplits(),
+        [&](unsigned /*index*/, ShadowSplitProcessor& split)
     {
         switch (lightType)
         {
         case LIGHT_SPOT:
-            splits_[i].ProcessSpotShadowCasters(drawableProcessor, shadowCasterCandidates_);
+            split.ProcessSpotShadowCasters(drawableProcessor, shadowCasterCandidates_);
             break;
         case LIGHT_POINT:
-            splits_[i].ProcessPointShadowCasters(drawableProcessor, shadowCasterCandidates_);
+            split.ProcessPointShadowCasters(drawableProcessor, shadowCasterCandidates_, shadowCasterCandidateBoxes_);
             break;
         case LIGHT_DIRECTIONAL:
-            splits_[i].ProcessDirectionalShadowCasters(drawableProcessor, shadowCasterCandidates_);
+            split.ProcessDirectionalShadowCasters(drawableProcessor);
             break;
         default:
             break;
         }
-    }
+    });
 
     const auto hasShadowCaster = [](const ShadowSplitProcessor& split) { return split.HasShadowCasters(); };
     if (!ea::any_of(splits_.begin(), splits_.begin() + numActiveSplits_, hasShadowCaster))
@@ -288,7 +298,27 @@ void LightProcessor::EndUpdate(DrawableProcessor* drawableProcessor,
     // Allocate shadow map
     if (numActiveSplits_ > 0)
     {
-        shadowMap_ = callback->AllocateTransientShadowMap(shadowMapSize_);
+        shadowMap_ = {};
+
+        // Shadow maps of directional lights follow the camera and cannot be cached
+        const bool isCacheable = light_->GetLightType() != LIGHT_DIRECTIONAL && !hadDynamicShadowCasters_;
+        if (isCacheable)
+        {
+            const bool isPersistentShadowMapReusable = persistentShadowMap_.rect_.Size() == shadowMapSize_
+                && callback->ReusePersistentShadowMap(persistentShadowMap_);
+            if (isPersistentShadowMapReusable)
+                shadowMap_ = persistentShadowMap_;
+            else
+            {
+                shadowMap_ = callback->AllocatePersistentShadowMap(shadowMapSize_);
+                isPersistentShadowMapContentValid_ = false;
+            }
+        }
+
+        persistentShadowMap_ = shadowMap_;
+        if (!shadowMap_)
+            shadowMap_ = callback->AllocateTransientShadowMap(shadowMapSize_);
+
         if (!shadowMap_)
             numActiveSplits_ = 0;
         else
@@ -303,6 +333,39 @@ void LightProcessor::EndUpdate(DrawableProcessor* drawableProcessor,
     UpdateHashes();
 }
 
+void LightProcessor::UpdateShadowMapCache()
+{
+    hadDynamicShadowCasters_ = false;
+    for (const ShadowSplitProcessor& split : GetSplits())
+    {
+        if (split.HasDynamicShadowCasters())
+            hadDynamicShadowCasters_ = true;
+    }
+
+    if (!shadowMap_.IsPersistent())
+    {
+        isPersistentShadowMapContentValid_ = false;
+        needShadowMapUpdate_ = true;
+        return;
+    }
+
+    unsigned contentHash = shadowMapStateHash_;
+    for (const ShadowSplitProcessor& split : GetSplits())
+        CombineHash(contentHash, split.GetShadowCasterHash());
+
+    needShadowMapUpdate_ = !isPersistentShadowMapContentValid_ || hadDynamicShadowCasters_
+        || contentHash != shadowMapContentHash_;
+    isPersistentShadowMapContentValid_ = !hadDynamicShadowCasters_;
+    shadowMapContentHash_ = contentHash;
+}
+
+bool LightProcessor::IsClusterable() const
+{
+    // Clustered lights don't support shadows, custom light textures and subtractive blending
+    return light_->GetLightType() != LIGHT_DIRECTIONAL && !HasShadow() && !light_->IsNegative()
+        && !light_->GetRampTexture() && !light_->GetShapeTexture();
+}
+
 void LightProcessor::InitializeShadowSplits(DrawableProcessor* drawableProcessor)
 {
     /// Setup splits
@@ -531,6 +594,20 @@ void LightProcessor::UpdateHashes()
     lightVolumeBatchHash_ = commonHash;
     CombineHash(lightVolumeBatchHash_, cameraIsInsideLightVolume_);
 
+    if (shadowMap_.IsPersistent())
+    {
+        shadowMapStateHash_ = commonHash;
+        CombineHash(shadowMapStateHash_, light_->GetNode()->GetWorldTransform().ToHash());
+        CombineHash(shadowMapStateHash_, MakeHash(light_->GetRange()));
+        CombineHash(shadowMapStateHash_, MakeHash(light_->GetFov()));
+        CombineHash(shadowMapStateHash_, MakeHash(light_->GetAspectRatio()));
+        CombineHash(shadowMapStateHash_, MakeHash(light_->GetShadowNearFarRatio()));
+        CombineHash(shadowMapStateHash_, shadowMap_.rect_.ToHash());
+        CombineHash(shadowMapStateHash_, numActiveSplits_);
+        if (numActiveSplits_ > 0)
+            CombineHash(shadowMapStateHash_, splits_[0].GetShadowMapPadding());
+    }
+
     if (light_->GetLightType() != LIGHT_DIRECTIONAL)
         shadowBatchStateHashes_.fill(commonHash);
     else
@@ -101,6 +101,8 @@ public:
     void Update(DrawableProcessor* drawableProcessor, const LightProcessorCallback* callback);
     /// End update from main thread.
     void EndUpdate(DrawableProcessor* drawableProcessor, LightProcessorCallback* callback, unsigned pcfKernelSize);
+    /// Check whether the contents of cached shadow map are still valid. Should be called after shadow batches are finalized.
+    void UpdateShadowMapCache();
 
     /// Return pipeline state hashes
     /// @{
@@ -124,6 +126,8 @@ public:
     bool HasShadow() const { return numActiveSplits_ != 0; }
     IntVector2 GetShadowMapSize() const { return numActiveSplits_ != 0 ? shadowMapSize_ : IntVector2::ZERO; }
     unsigned GetNumSplits() const { return numActiveSplits_; }
+    /// Return whether the light can be evaluated via light clusters instead of separate light pass.
+    bool IsClusterable() const;
     /// @}
 
     /// Return values are valid after update is finished
@@ -134,6 +138,8 @@ public:
     ea::span<ShadowSplitProcessor> GetMutableSplits() { return { splits_.data(), numActiveSplits_ }; }
 
     ShadowMapRegion GetShadowMap() const { return shadowMap_; }
+    /// Return whether the shadow map should be rendered. False if cached shadow map is up to date.
+    bool NeedShadowMapUpdate() const { return needShadowMapUpdate_; }
     const CookedLightParams& GetParams() const { return cookedParams_; }
     /// @}
 
@@ -166,13 +172,24 @@ private:
     /// Directional lights: all lit geometries, for shadow focusing.
     ea::vector<Drawable*> litGeometries_;
     /// Point and spot lights: all possible shadow casters.
-    /// Directional lights: temporary buffer for split queries.
     ea::vector<Drawable*> shadowCasterCandidates_;
+    /// Point lights: bounding boxes of shadow casters candidates.
+    ea::vector<BoundingBox> shadowCasterCandidateBoxes_;
     /// Accumulative shadow map region containing all the splits.
     ShadowMapRegion shadowMap_;
     CookedLightParams cookedParams_;
     /// @}
 
+    /// Cached shadow map, preserved between frames
+    /// @{
+    ShadowMapRegion persistentShadowMap_;
+    bool isPersistentShadowMapContentValid_{};
+    bool hadDynamicShadowCasters_{};
+    bool needShadowMapUpdate_{true};
+    unsigned shadowMapStateHash_{};
+    unsigned shadowMapContentHash_{};
+    /// @}
+
     /// Pipeline state hashes
     /// @{
     unsigned forwardLitBatchHash_{};
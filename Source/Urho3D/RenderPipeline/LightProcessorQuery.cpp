@@ -151,18 +151,46 @@ void DirectionalLightShadowCasterQuery::TestDrawables(Drawable** start, Drawable
 {
     for (Drawable* drawable : MakeIteratorRange(start, end))
     {
-        if (IsShadowCaster(drawable, inside))
+        if (!IsShadowCaster(drawable))
+            continue;
+
+        if (inside)
+        {
             result_.push_back(drawable);
+            continue;
+        }
+
+        // Test bounding boxes in batches
+        batchDrawables_[batchSize_] = drawable;
+        batchBoundingBoxes_[batchSize_] = drawable->GetWorldBoundingBox();
+        if (++batchSize_ == BatchSize)
+            FlushBatch();
     }
+
+    // Octree doesn't notify when the query is finished, so flush after each octant
+    FlushBatch();
 }
 
-bool DirectionalLightShadowCasterQuery::IsShadowCaster(Drawable* drawable, bool inside) const
+bool DirectionalLightShadowCasterQuery::IsShadowCaster(Drawable* drawable) const
 {
     return drawable->GetCastShadows()
         && (drawable->GetDrawableFlags() & drawableFlags_)
         && (drawable->GetViewMask() & viewMask_)
-        && (drawable->GetShadowMask() & lightMask_)
-        && (inside || frustum_.IsInsideFast(drawable->GetWorldBoundingBox()));
+        && (drawable->GetShadowMask() & lightMask_);
+}
+
+void DirectionalLightShadowCasterQuery::FlushBatch()
+{
+    if (batchSize_ == 0)
+        return;
+
+    frustum_.AreInsideFast({batchBoundingBoxes_.data(), batchSize_}, {batchIsInside_.data(), batchSize_});
+    for (unsigned i = 0; i < batchSize_; ++i)
+    {
+        if (batchIsInside_[i])
+            result_.push_back(batchDrawables_[i]);
+    }
+    batchSize_ = 0;
 }
 
 }
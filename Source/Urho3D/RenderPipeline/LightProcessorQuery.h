@@ -24,6 +24,7 @@
 
 #include "../Graphics/OctreeQuery.h"
 
+#include <EASTL/array.h>
 #include <EASTL/vector.h>
 
 namespace Urho3D
@@ -95,12 +96,24 @@ public:
     DirectionalLightShadowCasterQuery(ea::vector<Drawable*>& result,
         const Frustum& frustum, DrawableFlags drawableFlags, Light* light, unsigned viewMask);
 
+    /// Number of drawables tested against the frustum at once.
+    static const unsigned BatchSize = 64;
+
     void TestDrawables(Drawable** start, Drawable** end, bool inside) override;
 
 private:
-    bool IsShadowCaster(Drawable* drawable, bool inside) const;
+    bool IsShadowCaster(Drawable* drawable) const;
+    void FlushBatch();
 
     const unsigned lightMask_{};
+
+    /// Drawables waiting for frustum test, with bounding boxes in contiguous array.
+    /// @{
+    unsigned batchSize_{};
+    ea::array<Drawable*, BatchSize> batchDrawables_{};
+    ea::array<BoundingBox, BatchSize> batchBoundingBoxes_;
+    ea::array<bool, BatchSize> batchIsInside_{};
+    /// @}
 };
 
 }
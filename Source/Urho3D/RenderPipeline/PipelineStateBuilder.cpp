@@ -186,8 +186,18 @@ SharedPtr<PipelineState> PipelineStateBuilder::CreateBatchPipelineStatePlacehold
 
     desc.output_ = outputDesc;
 
-    desc.vertexShader_ = graphics_->GetShader(VS, "v2/X_PlaceholderShader", "");
-    desc.pixelShader_ = graphics_->GetShader(PS, "v2/X_PlaceholderShader", "");
+    ShaderVariation* vertexShader = graphics_->GetShader(VS, "v2/X_PlaceholderShader", "");
+    ShaderVariation* pixelShader = graphics_->GetShader(PS, "v2/X_PlaceholderShader", "");
+
+    // Placeholder is used instead of pipeline states with pending shaders, so it should never be pending itself
+    for (ShaderVariation* shader : {vertexShader, pixelShader})
+    {
+        if (shader)
+            shader->CompleteCompilation();
+    }
+
+    desc.vertexShader_ = vertexShader;
+    desc.pixelShader_ = pixelShader;
 
     return pipelineStateCache_->GetGraphicsPipelineState(desc);
 }
@@ -260,10 +260,22 @@ struct RenderPipelineStats
     unsigned numLights_{};
     /// Total number of lights with shadows processed.
     unsigned numShadowedLights_{};
+    /// Number of shadow maps rendered in the frame. Shadow maps reused from cache are not counted.
+    unsigned numRenderedShadowMaps_{};
     /// Total number of geometries in the frame (excluding shadow casters).
     unsigned numGeometries_{};
+    /// Number of geometries whose batches are reused from previous frame.
+    unsigned numRetainedGeometries_{};
     /// Number of occluders rendered.
     unsigned numOccluders_{};
+
+    /// CPU time spent in scene processing stages, in microseconds.
+    /// @{
+    long long occlusionAndVisibilityTime_{};
+    long long drawableProcessingTime_{};
+    long long batchCompositionTime_{};
+    long long batchRenderingTime_{};
+    /// @}
 };
 
 /// Base interface of render pipeline required by Render Pipeline classes.
@@ -292,9 +304,13 @@ struct ShadowMapRegion
     unsigned pageIndex_{};
     Texture2D* texture_;
     IntRect rect_;
+    /// Generation of atlas page for persistent shadow maps, 0 for transient shadow maps.
+    unsigned generation_{};
 
     /// Return whether the shadow map region is not empty.
     operator bool() const { return !!texture_; }
+    /// Return whether the shadow map region is preserved between frames.
+    bool IsPersistent() const { return generation_ != 0; }
     /// Return sub-region for split.
     /// Splits are indexed as elements in rectangle grid, from left to right, top to bottom, row-major.
     ShadowMapRegion GetSplit(unsigned split, const IntVector2& numSplits) const;
@@ -312,6 +328,10 @@ public:
     virtual unsigned GetShadowMapSize(Light* light, unsigned numActiveSplits) const = 0;
     /// Allocate shadow map for one frame.
     virtual ShadowMapRegion AllocateTransientShadowMap(const IntVector2& size) = 0;
+    /// Allocate shadow map that is preserved between frames. May return empty region if not supported.
+    virtual ShadowMapRegion AllocatePersistentShadowMap(const IntVector2& size) = 0;
+    /// Mark persistent shadow map as used in current frame. Return false if its contents are not preserved anymore.
+    virtual bool ReusePersistentShadowMap(const ShadowMapRegion& shadowMap) = 0;
 };
 
 struct LightProcessorCacheSettings
@@ -343,6 +363,8 @@ struct DrawableProcessorSettings
     unsigned maxPixelLights_{ 4 };
     unsigned pcfKernelSize_{ 1 };
     float normalOffsetScale_{1.0f};
+    /// Whether to keep batches of static unlit and deferred geometries between frames.
+    bool retainStaticBatches_{};
     LightProcessorCacheSettings lightProcessorCache_;
 
     /// Utility operators
@@ -375,7 +397,8 @@ struct DrawableProcessorSettings
             && maxPixelLights_ == rhs.maxPixelLights_
             && pcfKernelSize_ == rhs.pcfKernelSize_
             && lightProcessorCache_ == rhs.lightProcessorCache_
-            && normalOffsetScale_ == rhs.normalOffsetScale_;
+            && normalOffsetScale_ == rhs.normalOffsetScale_
+            && retainStaticBatches_ == rhs.retainStaticBatches_;
     }
 
     bool operator!=(const DrawableProcessorSettings& rhs) const { return !(*this == rhs); }
@@ -461,6 +484,12 @@ struct ShadowMapAllocatorSettings
     int varianceShadowMapMultiSample_{ 1 };
     bool use16bitShadowMaps_{};
     unsigned shadowAtlasPageSize_{ 2048 };
+    /// Whether to keep shadow maps of point and spot lights between frames
+    /// and re-render them only when light or shadow casters are changed.
+    /// Not supported for variance shadow maps.
+    bool cacheShadowMaps_{};
+    /// Max number of atlas pages used for cached shadow maps.
+    unsigned maxCachedShadowAtlasPages_{ 1 };
 
     float depthBiasScale_{1.0f};
     float depthBiasOffset_{0.0f};
@@ -481,6 +510,7 @@ struct ShadowMapAllocatorSettings
     {
         varianceShadowMapMultiSample_ = Clamp(ClosestPowerOfTwo(varianceShadowMapMultiSample_), 1u, 16u);
         shadowAtlasPageSize_ = Clamp(ClosestPowerOfTwo(shadowAtlasPageSize_), 128u, 16 * 1024u);
+        maxCachedShadowAtlasPages_ = Clamp(maxCachedShadowAtlasPages_, 1u, 16u);
         depthBiasScale_ = ea::max(0.0f, depthBiasScale_);
     }
 
@@ -490,6 +520,8 @@ struct ShadowMapAllocatorSettings
             && varianceShadowMapMultiSample_ == rhs.varianceShadowMapMultiSample_
             && use16bitShadowMaps_ == rhs.use16bitShadowMaps_
             && shadowAtlasPageSize_ == rhs.shadowAtlasPageSize_
+            && cacheShadowMaps_ == rhs.cacheShadowMaps_
+            && maxCachedShadowAtlasPages_ == rhs.maxCachedShadowAtlasPages_
             && depthBiasScale_ == rhs.depthBiasScale_
             && depthBiasOffset_ == rhs.depthBiasOffset_;
     }
@@ -533,7 +565,9 @@ enum class DirectLightingMode
 {
     Forward,
     DeferredBlinnPhong,
-    DeferredPBR
+    DeferredPBR,
+    /// Forward lighting where unshadowed point and spot lights are evaluated per-pixel via light clusters.
+    ForwardClustered
 };
 
 enum class SpecularQuality
@@ -577,6 +611,8 @@ struct SceneProcessorSettings
         }
     }
 
+    bool IsClusteredLighting() const { return lightingMode_ == DirectLightingMode::ForwardClustered; }
+
     unsigned CalculatePipelineStateHash() const
     {
         unsigned hash = 0;
@@ -24,6 +24,8 @@
 
 #include "../Core/Context.h"
 #include "../Core/IteratorRange.h"
+#include "../Core/Timer.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/Drawable.h"
 #include "../RenderAPI/DrawCommandQueue.h"
 #include "../Graphics/OcclusionBuffer.h"
@@ -39,6 +41,7 @@
 #include "../RenderPipeline/CameraProcessor.h"
 #include "../RenderPipeline/DrawableProcessor.h"
 #include "../RenderPipeline/InstancingBuffer.h"
+#include "../RenderPipeline/LightClusterGrid.h"
 #include "../RenderPipeline/LightProcessor.h"
 #include "../RenderPipeline/PipelineBatchSortKey.h"
 #include "../RenderPipeline/PipelineStateBuilder.h"
@@ -46,6 +49,7 @@
 #include "../RenderPipeline/RenderPipelineDefs.h"
 #include "../RenderPipeline/ScenePass.h"
 #include "../RenderPipeline/SceneProcessor.h"
+#include "../RenderPipeline/ShaderConsts.h"
 #include "../Graphics/OutlineGroup.h"
 #include "../RenderPipeline/ShadowMapAllocator.h"
 #include "../RenderAPI/RenderContext.h"
@@ -184,6 +188,26 @@ unsigned GetMaxShadowSplitSize(const SceneProcessorSettings& settings, unsigned
     }
 }
 
+Sphere GetLightBoundingSphere(Light* light)
+{
+    Node* lightNode = light->GetNode();
+    const Vector3 position = lightNode->GetWorldPosition();
+    const float range = light->GetRange();
+    const float halfAngle = light->GetFov() * 0.5f;
+    if (light->GetLightType() != LIGHT_SPOT || halfAngle >= 90.0f)
+        return Sphere{position, range};
+
+    // Narrow cone is bounded by sphere touching apex and cone rim, wide cone is bounded by sphere around the rim
+    const Vector3 direction = lightNode->GetWorldDirection();
+    const float cosAngle = Cos(halfAngle);
+    if (halfAngle <= 45.0f)
+    {
+        const float radius = range / (2.0f * cosAngle);
+        return Sphere{position + direction * radius, radius};
+    }
+    return Sphere{position + direction * (range * cosAngle), range * Sin(halfAngle)};
+}
+
 }
 
 SceneProcessor::SceneProcessor(RenderPipelineInterface* renderPipeline, const ea::string& shadowTechnique,
@@ -209,6 +233,7 @@ SceneProcessor::SceneProcessor(RenderPipelineInterface* renderPipeline, const ea
     renderPipeline_->OnUpdateBegin.Subscribe(this, &SceneProcessor::OnUpdateBegin);
     renderPipeline_->OnRenderBegin.Subscribe(this, &SceneProcessor::OnRenderBegin);
     renderPipeline_->OnRenderEnd.Subscribe(this, &SceneProcessor::OnRenderEnd);
+    renderPipeline_->OnCollectStatistics.Subscribe(this, &SceneProcessor::OnCollectStatistics);
 }
 
 SceneProcessor::~SceneProcessor()
@@ -279,6 +304,8 @@ void SceneProcessor::SetSettings(const ShaderProgramCompositorSettings& settings
 
 void SceneProcessor::Update()
 {
+    HiresTimer stageTimer;
+
     // Collect occluders
     currentOcclusionBuffer_ = nullptr;
     const Frustum& frustum = frameInfo_.camera_->GetFrustum();
@@ -319,17 +346,70 @@ void SceneProcessor::Update()
             DRAWABLE_GEOMETRY | DRAWABLE_LIGHT, frameInfo_.camera_->GetPrimaryViewMask());
         frameInfo_.octree_->GetDrawables(drawableQuery);
     }
+    occlusionAndVisibilityTime_ = stageTimer.GetUSec(true);
 
     // Process drawables
     drawableProcessor_->ProcessVisibleDrawables(drawables_, currentOcclusionBuffer_ ? ea::span(&currentOcclusionBuffer_, 1u) : ea::span<OcclusionBuffer*>() );
     drawableProcessor_->ProcessLights(this);
-    drawableProcessor_->ProcessForwardLighting();
+    drawableProcessor_->ProcessForwardLighting(settings_.IsClusteredLighting());
+    if (settings_.IsClusteredLighting())
+        UpdateLightClusters();
+    drawableProcessingTime_ = stageTimer.GetUSec(true);
 
     batchCompositor_->ComposeSceneBatches();
     if (settings_.enableShadows_)
+    {
         batchCompositor_->ComposeShadowBatches();
+        for (LightProcessor* lightProcessor : drawableProcessor_->GetLightProcessors())
+            lightProcessor->UpdateShadowMapCache();
+    }
     if (settings_.IsDeferredLighting())
         batchCompositor_->ComposeLightVolumeBatches();
+    batchCompositionTime_ = stageTimer.GetUSec(true);
+}
+
+void SceneProcessor::UpdateLightClusters()
+{
+    URHO3D_PROFILE("UpdateLightClusters");
+
+    if (!lightClusterGrid_)
+        lightClusterGrid_ = MakeShared<LightClusterGrid>(context_);
+
+    clusteredLightBounds_.clear();
+    clusteredLightData_.clear();
+
+    const bool linearColorSpace = renderPipeline_->IsLinearColorSpace();
+    for (LightProcessor* lightProcessor : drawableProcessor_->GetLightProcessors())
+    {
+        if (!lightProcessor->IsClusterable())
+            continue;
+
+        Light* light = lightProcessor->GetLight();
+        const CookedLightParams& params = lightProcessor->GetParams();
+        clusteredLightBounds_.push_back(GetLightBoundingSphere(light));
+        clusteredLightData_.emplace_back(params.GetColor(linearColorSpace), params.effectiveSpecularIntensity_);
+        clusteredLightData_.emplace_back(params.position_, params.inverseRange_);
+        clusteredLightData_.emplace_back(params.direction_, params.spotCutoff_);
+        clusteredLightData_.emplace_back(params.inverseSpotCutoff_, 0.0f, 0.0f, 0.0f);
+    }
+
+    lightClusterGrid_->Build(frameInfo_.camera_, clusteredLightBounds_, GetSubsystem<WorkQueue>());
+}
+
+void SceneProcessor::ApplyLightClusters(BatchRenderingContext& ctx,
+    ea::span<const ShaderResourceDesc> globalResources, ea::span<const ShaderParameterDesc> cameraParameters)
+{
+    clusteredGlobalResources_.assign(globalResources.begin(), globalResources.end());
+    clusteredGlobalResources_.push_back({ShaderResources::LightClusters, lightClusterGrid_->GetClusterTexture()});
+    clusteredGlobalResources_.push_back({ShaderResources::ClusteredLights, lightClusterGrid_->GetLightTexture()});
+
+    clusteredCameraParameters_.assign(cameraParameters.begin(), cameraParameters.end());
+    clusteredCameraParameters_.push_back({ShaderConsts::Camera_ClusterViewProj, lightClusterGrid_->GetViewProjection()});
+    clusteredCameraParameters_.push_back({ShaderConsts::Camera_ClusterGridSize, lightClusterGrid_->GetGridSizeParameter()});
+    clusteredCameraParameters_.push_back({ShaderConsts::Camera_ClusterDepthParams, lightClusterGrid_->GetDepthParameter()});
+
+    ctx.globalResources_ = clusteredGlobalResources_;
+    ctx.cameraParameters_ = clusteredCameraParameters_;
 }
 
 void SceneProcessor::PrepareInstancingBuffer()
@@ -345,6 +425,9 @@ void SceneProcessor::PrepareInstancingBuffer()
 
     for (LightProcessor* sceneLight : visibleLights)
     {
+        if (!sceneLight->NeedShadowMapUpdate())
+            continue;
+
         for (ShadowSplitProcessor& split : sceneLight->GetMutableSplits())
             batchRenderer_->PrepareInstancingBuffer(split.GetMutableShadowBatches());
     }
@@ -361,6 +444,8 @@ void SceneProcessor::PrepareInstancingBuffer()
 void SceneProcessor::PrepareDrawablesBeforeRendering()
 {
     drawableProcessor_->UpdateGeometries();
+    if (settings_.IsClusteredLighting() && lightClusterGrid_)
+        lightClusterGrid_->UpdateTextures(clusteredLightData_);
 }
 
 void SceneProcessor::RenderShadowMaps()
@@ -375,6 +460,10 @@ void SceneProcessor::RenderShadowMaps()
     const auto& lightsByShadowMap = drawableProcessor_->GetLightProcessorsByShadowMap();
     for (LightProcessor* sceneLight : lightsByShadowMap)
     {
+        // Cached shadow map is up to date
+        if (!sceneLight->NeedShadowMapUpdate())
+            continue;
+
         const RenderScope renderScopeLight(renderContext_, "Light 0x{} '{}'",
             static_cast<void*>(sceneLight->GetLight()), sceneLight->GetLight()->GetNode()->GetName());
 
@@ -389,10 +478,12 @@ void SceneProcessor::RenderShadowMaps()
                 debugger_->BeginPass(passName);
             }
 
+            HiresTimer renderTimer;
             drawQueue_->Reset();
             batchRenderer_->RenderBatches({ *drawQueue_, split }, split.GetShadowBatches());
             shadowMapAllocator_->BeginShadowMapRendering(split.GetShadowMap());
             renderContext_->Execute(drawQueue_);
+            batchRenderingTime_ += renderTimer.GetUSec(false);
 
             if (RenderPipelineDebugger::IsSnapshotInProgress(debugger_))
             {
@@ -424,6 +515,7 @@ void SceneProcessor::RenderLightVolumeBatches(ea::string_view debugName, Camera*
 
     const RenderScope renderScope(renderContext_, debugName);
 
+    HiresTimer renderTimer;
     drawQueue_->Reset();
 
     BatchRenderingContext ctx{ *drawQueue_, *camera };
@@ -434,6 +526,7 @@ void SceneProcessor::RenderLightVolumeBatches(ea::string_view debugName, Camera*
     batchRenderer_->RenderLightVolumeBatches(ctx, GetLightVolumeBatches());
 
     renderContext_->Execute(drawQueue_);
+    batchRenderingTime_ += renderTimer.GetUSec(false);
 
     if (RenderPipelineDebugger::IsSnapshotInProgress(debugger_))
         debugger_->EndPass();
@@ -448,6 +541,7 @@ void SceneProcessor::RenderBatchesInternal(ea::string_view debugName, Camera* ca
 
     const RenderScope renderScope(renderContext_, debugName);
 
+    HiresTimer renderTimer;
     drawQueue_->Reset();
 
     const bool needClipping = camera->GetUseClipping() || frameInfo_.additionalCameras_[1] != nullptr;
@@ -457,12 +551,15 @@ void SceneProcessor::RenderBatchesInternal(ea::string_view debugName, Camera* ca
     ctx.instanceMultiplier_ = instanceMultiplier;
     ctx.globalResources_ = globalResources;
     ctx.cameraParameters_ = cameraParameters;
+    if (settings_.IsClusteredLighting() && lightClusterGrid_)
+        ApplyLightClusters(ctx, globalResources, cameraParameters);
 
     if (batchGroup.scissorRect_ != IntRect::ZERO)
         drawQueue_->SetScissorRect(batchGroup.scissorRect_);
     batchRenderer_->RenderBatches(ctx, batchGroup);
 
     renderContext_->Execute(drawQueue_);
+    batchRenderingTime_ += renderTimer.GetUSec(false);
 
     if (RenderPipelineDebugger::IsSnapshotInProgress(debugger_))
         debugger_->EndPass();
@@ -483,6 +580,7 @@ void SceneProcessor::OnUpdateBegin(const CommonFrameInfo& frameInfo)
 
     occluders_.clear();
     drawables_.clear();
+    batchRenderingTime_ = 0;
 
     cameraProcessor_->OnUpdateBegin(frameInfo_);
     drawableProcessor_->OnUpdateBegin(frameInfo_);
@@ -499,6 +597,23 @@ void SceneProcessor::OnRenderEnd(const CommonFrameInfo& frameInfo)
     cameraProcessor_->OnRenderEnd(frameInfo_);
 }
 
+void SceneProcessor::OnCollectStatistics(RenderPipelineStats& stats)
+{
+    stats.occlusionAndVisibilityTime_ += occlusionAndVisibilityTime_;
+    stats.drawableProcessingTime_ += drawableProcessingTime_;
+    stats.batchCompositionTime_ += batchCompositionTime_;
+    stats.batchRenderingTime_ += batchRenderingTime_;
+
+    if (settings_.enableShadows_)
+    {
+        for (LightProcessor* sceneLight : drawableProcessor_->GetLightProcessorsByShadowMap())
+        {
+            if (sceneLight->HasShadow() && sceneLight->NeedShadowMapUpdate())
+                ++stats.numRenderedShadowMaps_;
+        }
+    }
+}
+
 bool SceneProcessor::IsLightShadowed(Light* light)
 {
     const bool shadowsEnabled = settings_.enableShadows_
@@ -536,6 +651,16 @@ ShadowMapRegion SceneProcessor::AllocateTransientShadowMap(const IntVector2& siz
     return shadowMapAllocator_->AllocateShadowMap(size);
 }
 
+ShadowMapRegion SceneProcessor::AllocatePersistentShadowMap(const IntVector2& size)
+{
+    return shadowMapAllocator_->AllocatePersistentShadowMap(size);
+}
+
+bool SceneProcessor::ReusePersistentShadowMap(const ShadowMapRegion& shadowMap)
+{
+    return shadowMapAllocator_->ReusePersistentShadowMap(shadowMap);
+}
+
 void SceneProcessor::DrawOccluders()
 {
     const auto& activeOccluders = drawableProcessor_->GetOccluders();
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "../Math/Sphere.h"
 #include "../RenderPipeline/RenderPipelineDefs.h"
 #include "../RenderPipeline/PipelineBatchSortKey.h"
 
@@ -35,12 +36,14 @@ class Drawable;
 class DrawableProcessor;
 class DrawCommandQueue;
 class InstancingBuffer;
+class LightClusterGrid;
 class PipelineStateBuilder;
 class RenderPipelineInterface;
 class RenderSurface;
 class ScenePass;
 class ShadowMapAllocator;
 class Viewport;
+struct BatchRenderingContext;
 struct ShaderParameterDesc;
 struct ShaderResourceDesc;
 
@@ -103,6 +106,8 @@ public:
     DrawableProcessor* GetDrawableProcessor() const { return drawableProcessor_; }
     BatchCompositor* GetBatchCompositor() const { return batchCompositor_; }
     BatchRenderer* GetBatchRenderer() const { return batchRenderer_; }
+    /// Return light cluster grid. Null if clustered lighting is disabled.
+    LightClusterGrid* GetLightClusterGrid() const { return lightClusterGrid_; }
     /// @}
 
 protected:
@@ -114,6 +119,7 @@ private:
     void OnUpdateBegin(const CommonFrameInfo& frameInfo);
     void OnRenderBegin(const CommonFrameInfo& frameInfo);
     void OnRenderEnd(const CommonFrameInfo& frameInfo);
+    void OnCollectStatistics(RenderPipelineStats& stats);
     /// @}
 
     /// LightProcessorCallback implementation
@@ -121,8 +127,16 @@ private:
     bool IsLightShadowed(Light* light) override;
     unsigned GetShadowMapSize(Light* light, unsigned numActiveSplits) const override;
     ShadowMapRegion AllocateTransientShadowMap(const IntVector2& size) override;
+    ShadowMapRegion AllocatePersistentShadowMap(const IntVector2& size) override;
+    bool ReusePersistentShadowMap(const ShadowMapRegion& shadowMap) override;
     /// @}
 
+    /// Build light clusters for lights that are not rendered in separate light passes.
+    void UpdateLightClusters();
+    /// Append light cluster resources and parameters to rendering context.
+    void ApplyLightClusters(BatchRenderingContext& ctx,
+        ea::span<const ShaderResourceDesc> globalResources, ea::span<const ShaderParameterDesc> cameraParameters);
+
     template <class T>
     void RenderBatchesInternal(ea::string_view debugName, Camera* camera, const PipelineBatchGroup<T>& batchGroup,
         ea::span<const ShaderResourceDesc> globalResources, ea::span<const ShaderParameterDesc> cameraParameters, unsigned instanceMultiplier = 1u);
@@ -149,6 +163,7 @@ protected:
     SharedPtr<BatchCompositor> batchCompositor_;
     SharedPtr<BatchRenderer> batchRenderer_;
     SharedPtr<OcclusionBuffer> occlusionBuffer_;
+    SharedPtr<LightClusterGrid> lightClusterGrid_;
     BatchStateCacheCallback* batchStateCacheCallback_{};
     /// @}
 
@@ -161,6 +176,22 @@ protected:
     OcclusionBuffer* currentOcclusionBuffer_{};
     ea::vector<Drawable*> occluders_;
     ea::vector<Drawable*> drawables_;
+
+    /// CPU time spent in scene processing stages during current frame, in microseconds.
+    /// @{
+    long long occlusionAndVisibilityTime_{};
+    long long drawableProcessingTime_{};
+    long long batchCompositionTime_{};
+    long long batchRenderingTime_{};
+    /// @}
+
+    /// Clustered lighting
+    /// @{
+    ea::vector<Sphere> clusteredLightBounds_;
+    ea::vector<Vector4> clusteredLightData_;
+    ea::vector<ShaderResourceDesc> clusteredGlobalResources_;
+    ea::vector<ShaderParameterDesc> clusteredCameraParameters_;
+    /// @}
 };
 
 }
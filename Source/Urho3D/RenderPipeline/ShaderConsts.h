@@ -50,6 +50,9 @@ namespace ShaderConsts
     URHO3D_SHADER_CONST(Camera, FogParams);
     URHO3D_SHADER_CONST(Camera, FogColor);
     URHO3D_SHADER_CONST(Camera, NormalOffsetScale);
+    URHO3D_SHADER_CONST(Camera, ClusterViewProj);
+    URHO3D_SHADER_CONST(Camera, ClusterGridSize);
+    URHO3D_SHADER_CONST(Camera, ClusterDepthParams);
 
     URHO3D_SHADER_CONST(Zone, CubemapCenter0);
     URHO3D_SHADER_CONST(Zone, CubemapCenter1);
@@ -123,6 +126,8 @@ namespace ShaderResources
     URHO3D_SHADER_RESOURCE(LightShape);
     URHO3D_SHADER_RESOURCE(ShadowMap);
     URHO3D_SHADER_RESOURCE(DepthBuffer);
+    URHO3D_SHADER_RESOURCE(LightClusters);
+    URHO3D_SHADER_RESOURCE(ClusteredLights);
 }
 
 }
@@ -287,6 +287,9 @@ void ShaderProgramCompositor::ApplyAmbientLightingVertexAndCommonDefinesForUserP
     else if (settings_.sceneProcessor_.maxVertexLights_ > 0)
         result.AddCommonShaderDefines(Format("URHO3D_NUM_VERTEX_LIGHTS={}", settings_.sceneProcessor_.maxVertexLights_));
 
+    if (!isGeometryBufferPass && settings_.sceneProcessor_.IsClusteredLighting())
+        result.AddCommonShaderDefines("URHO3D_CLUSTERED_LIGHTS");
+
     if (drawable->GetGlobalIlluminationType() == GlobalIlluminationType::UseLightMap)
         result.AddCommonShaderDefines("URHO3D_HAS_LIGHTMAP");
 
@@ -25,8 +25,14 @@
 #include "Urho3D/RenderPipeline/ShadowMapAllocator.h"
 
 #include "Urho3D/Core/Context.h"
+#include "Urho3D/Graphics/Geometry.h"
+#include "Urho3D/Graphics/Graphics.h"
+#include "Urho3D/Graphics/GraphicsUtils.h"
+#include "Urho3D/Graphics/Renderer.h"
+#include "Urho3D/RenderAPI/DrawCommandQueue.h"
 #include "Urho3D/RenderAPI/RenderContext.h"
 #include "Urho3D/RenderAPI/RenderDevice.h"
+#include "Urho3D/Resource/ResourceEvents.h"
 
 #include "Urho3D/DebugNew.h"
 
@@ -51,8 +57,12 @@ ShadowMapAllocator::ShadowMapAllocator(Context* context)
     : Object(context)
     , renderDevice_(context_->GetSubsystem<RenderDevice>())
     , renderContext_(renderDevice_->GetRenderContext())
+    , pipelineStates_(context_)
 {
     CacheSettings();
+
+    // Reloaded resources may change shadow casters in place, so cached shadow maps cannot be trusted
+    SubscribeToEvent(E_RELOADFINISHED, [this] { resetPersistentPages_ = true; });
 }
 
 void ShadowMapAllocator::SetSettings(const ShadowMapAllocatorSettings& settings)
@@ -63,6 +73,9 @@ void ShadowMapAllocator::SetSettings(const ShadowMapAllocatorSettings& settings)
         CacheSettings();
 
         pages_.clear();
+        resetPersistentPages_ = false;
+        overflowArea_ = 0;
+        minOverflowArea_ = 0;
     }
 }
 
@@ -103,9 +116,25 @@ void ShadowMapAllocator::ResetAllShadowMaps()
 {
     for (AtlasPage& element : pages_)
     {
+        if (element.generation_ != 0)
+            continue;
+
         element.areaAllocator_.Reset(shadowAtlasPageSize_.x_, shadowAtlasPageSize_.y_, shadowAtlasPageSize_.x_, shadowAtlasPageSize_.y_);
         element.clearBeforeRendering_ = false;
     }
+
+    if (resetPersistentPages_)
+    {
+        resetPersistentPages_ = false;
+        ResetPersistentPages();
+    }
+    else if (overflowArea_ > 0)
+        ReclaimUnusedPersistentPages();
+
+    for (AtlasPage& element : pages_)
+        element.usedArea_ = 0;
+    overflowArea_ = 0;
+    minOverflowArea_ = 0;
 }
 
 ShadowMapRegion ShadowMapAllocator::AllocateShadowMap(const IntVector2& size)
@@ -117,15 +146,120 @@ ShadowMapRegion ShadowMapAllocator::AllocateShadowMap(const IntVector2& size)
 
     for (AtlasPage& element : pages_)
     {
+        if (element.generation_ != 0)
+            continue;
+
         const ShadowMapRegion shadowMap = element.AllocateRegion(clampedSize);
         if (shadowMap)
             return shadowMap;
     }
 
-    AllocatePage();
+    AllocatePage(false);
     return pages_.back().AllocateRegion(clampedSize);
 }
 
+ShadowMapRegion ShadowMapAllocator::AllocatePersistentShadowMap(const IntVector2& size)
+{
+    if (!settings_.cacheShadowMaps_ || settings_.enableVarianceShadowMaps_)
+        return {};
+
+    if (!settings_.shadowAtlasPageSize_ || !shadowMapFormat_)
+        return {};
+
+    const IntVector2 clampedSize = VectorMin(size, shadowAtlasPageSize_);
+
+    const int area = clampedSize.x_ * clampedSize.y_;
+    const auto allocateInPage = [&](AtlasPage& page)
+    {
+        const ShadowMapRegion shadowMap = page.AllocateRegion(clampedSize);
+        if (shadowMap)
+        {
+            page.allocatedArea_ += area;
+            page.usedArea_ += area;
+        }
+        return shadowMap;
+    };
+
+    unsigned numPersistentPages = 0;
+    for (AtlasPage& element : pages_)
+    {
+        if (element.generation_ == 0)
+            continue;
+
+        ++numPersistentPages;
+        if (const ShadowMapRegion shadowMap = allocateInPage(element))
+            return shadowMap;
+    }
+
+    if (numPersistentPages < settings_.maxCachedShadowAtlasPages_)
+    {
+        AllocatePage(true);
+        return allocateInPage(pages_.back());
+    }
+
+    // Regions of persistent pages are never released individually.
+    // Overflown shadow map is transient in this frame, pages with unused regions are reclaimed on the next frame.
+    overflowArea_ += area;
+    minOverflowArea_ = minOverflowArea_ > 0 ? ea::min(minOverflowArea_, area) : area;
+    return {};
+}
+
+bool ShadowMapAllocator::IsPersistentShadowMapValid(const ShadowMapRegion& shadowMap) const
+{
+    if (!shadowMap.IsPersistent() || shadowMap.pageIndex_ >= pages_.size())
+        return false;
+
+    const AtlasPage& page = pages_[shadowMap.pageIndex_];
+    return page.generation_ == shadowMap.generation_ && page.texture_ == shadowMap.texture_;
+}
+
+bool ShadowMapAllocator::ReusePersistentShadowMap(const ShadowMapRegion& shadowMap)
+{
+    if (!IsPersistentShadowMapValid(shadowMap))
+        return false;
+
+    const IntVector2 size = shadowMap.rect_.Size();
+    pages_[shadowMap.pageIndex_].usedArea_ += size.x_ * size.y_;
+    return true;
+}
+
+void ShadowMapAllocator::ResetPersistentPages()
+{
+    for (AtlasPage& element : pages_)
+    {
+        if (element.generation_ != 0)
+            ResetPersistentPage(element);
+    }
+}
+
+void ShadowMapAllocator::ResetPersistentPage(AtlasPage& page)
+{
+    page.areaAllocator_.Reset(shadowAtlasPageSize_.x_, shadowAtlasPageSize_.y_, shadowAtlasPageSize_.x_, shadowAtlasPageSize_.y_);
+    page.generation_ = ++lastGeneration_;
+    page.allocatedArea_ = 0;
+}
+
+void ShadowMapAllocator::ReclaimUnusedPersistentPages()
+{
+    // Reset only pages that contain regions unused on the last frame and would fit overflown shadow maps.
+    // Shadow maps used on the last frame are kept if cache is full of them, so the cache is not dropped every frame.
+    const int pageArea = shadowAtlasPageSize_.x_ * shadowAtlasPageSize_.y_;
+    int remainingOverflowArea = overflowArea_;
+    for (AtlasPage& element : pages_)
+    {
+        if (element.generation_ == 0 || remainingOverflowArea <= 0)
+            continue;
+
+        const bool hasUnusedRegions = element.allocatedArea_ > element.usedArea_;
+        const int reclaimableArea = pageArea - element.usedArea_;
+        if (hasUnusedRegions && reclaimableArea >= minOverflowArea_)
+        {
+            ResetPersistentPage(element);
+            remainingOverflowArea -= reclaimableArea;
+        }
+    }
+}
+
 bool ShadowMapAllocator::BeginShadowMapRendering(const ShadowMapRegion& shadowMap)
 {
     if (!shadowMap || shadowMap.pageIndex_ >= pages_.size())
@@ -146,7 +280,7 @@ bool ShadowMapAllocator::BeginShadowMapRendering(const ShadowMapRegion& shadowMa
     }
 
     // Clear whole texture if needed
-    if (poolElement.clearBeforeRendering_)
+    if (poolElement.clearBeforeRendering_ && poolElement.generation_ == 0)
     {
         poolElement.clearBeforeRendering_ = false;
 
@@ -157,9 +291,53 @@ bool ShadowMapAllocator::BeginShadowMapRendering(const ShadowMapRegion& shadowMa
 
     renderContext_->SetViewport(shadowMap.rect_);
 
+    // Persistent page is shared with cached shadow maps, clear only the region being rendered
+    if (poolElement.generation_ != 0)
+        ClearShadowMapRegion();
+
     return true;
 }
 
+void ShadowMapAllocator::ClearShadowMapRegion()
+{
+    Geometry* quadGeometry = GetSubsystem<Renderer>()->GetQuadGeometry();
+    if (clearPipelineState_ == StaticPipelineStateId::Invalid)
+    {
+        const ea::string shaderName = "v2/X_ClearFramebuffer";
+        auto graphics = GetSubsystem<Graphics>();
+
+        GraphicsPipelineStateDesc desc;
+        desc.debugName_ = "Clear shadow map region";
+        desc.vertexShader_ = graphics->GetShader(VS, shaderName, "");
+        desc.pixelShader_ = graphics->GetShader(PS, shaderName, "");
+        desc.colorWriteEnabled_ = false;
+        desc.depthWriteEnabled_ = true;
+        desc.depthCompareFunction_ = CMP_ALWAYS;
+        InitializeInputLayoutAndPrimitiveType(desc, quadGeometry);
+
+        clearPipelineState_ = pipelineStates_.CreateState(desc);
+        clearQueue_ = MakeShared<DrawCommandQueue>(renderDevice_);
+    }
+
+    PipelineState* pipelineState = pipelineStates_.GetState(
+        clearPipelineState_, renderContext_->GetCurrentRenderTargetsDesc());
+    if (!pipelineState || !pipelineState->IsValid())
+        return;
+
+    clearQueue_->Reset();
+    clearQueue_->SetPipelineState(pipelineState);
+    if (clearQueue_->BeginShaderParameterGroup(SP_CUSTOM))
+    {
+        clearQueue_->AddShaderParameter(StringHash{"Depth"}, 1.0f);
+        clearQueue_->CommitShaderParameterGroup(SP_CUSTOM);
+    }
+    clearQueue_->CommitShaderResources();
+
+    SetBuffersFromGeometry(*clearQueue_, quadGeometry);
+    clearQueue_->DrawIndexed(quadGeometry->GetIndexStart(), quadGeometry->GetIndexCount());
+    renderContext_->Execute(clearQueue_);
+}
+
 ShadowMapRegion ShadowMapAllocator::AtlasPage::AllocateRegion(const IntVector2& size)
 {
     int x{}, y{};
@@ -171,6 +349,8 @@ ShadowMapRegion ShadowMapAllocator::AtlasPage::AllocateRegion(const IntVector2&
         shadowMap.texture_ = texture_;
         shadowMap.rect_ = IntRect(offset, offset + size);
 
+        shadowMap.generation_ = generation_;
+
         // Mark shadow map as used
         clearBeforeRendering_ = true;
         return shadowMap;
@@ -178,7 +358,7 @@ ShadowMapRegion ShadowMapAllocator::AtlasPage::AllocateRegion(const IntVector2&
     return {};
 }
 
-void ShadowMapAllocator::AllocatePage()
+void ShadowMapAllocator::AllocatePage(bool isPersistent)
 {
     const bool isDepthTexture = !settings_.enableVarianceShadowMaps_;
     const TextureFlags textureFlags = isDepthTexture ? TextureFlag::BindDepthStencil : TextureFlag::BindRenderTarget;
@@ -186,7 +366,7 @@ void ShadowMapAllocator::AllocatePage()
 
     auto newShadowMap = MakeShared<Texture2D>(context_);
 
-    newShadowMap->SetName(Format("Dynamic ShadowMap #{}", pages_.size()));
+    newShadowMap->SetName(Format("{} ShadowMap #{}", isPersistent ? "Cached" : "Dynamic", pages_.size()));
 
     // Disable mipmaps from the shadow map
     newShadowMap->SetNumLevels(1);
@@ -198,6 +378,7 @@ void ShadowMapAllocator::AllocatePage()
     AtlasPage& element = pages_.emplace_back();
     element.index_ = pages_.size() - 1;
     element.texture_ = newShadowMap;
+    element.generation_ = isPersistent ? ++lastGeneration_ : 0;
     element.areaAllocator_.Reset(shadowAtlasPageSize_.x_, shadowAtlasPageSize_.y_, shadowAtlasPageSize_.x_, shadowAtlasPageSize_.y_);
 
     if (!settings_.enableVarianceShadowMaps_)
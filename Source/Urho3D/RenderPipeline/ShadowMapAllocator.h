@@ -29,12 +29,14 @@
 #include "../Graphics/Light.h"
 #include "../RenderPipeline/RenderPipelineDefs.h"
 #include "Urho3D/RenderAPI/RenderAPIDefs.h"
+#include "Urho3D/RenderPipeline/StaticPipelineStateCache.h"
 
 #include <EASTL/vector.h>
 
 namespace Urho3D
 {
 
+class DrawCommandQueue;
 class RenderContext;
 class RenderDevice;
 class Renderer;
@@ -48,10 +50,18 @@ public:
     explicit ShadowMapAllocator(Context* context);
     void SetSettings(const ShadowMapAllocatorSettings& settings);
 
-    /// Reset allocated shadow maps.
+    /// Reset allocated transient shadow maps.
+    /// Persistent pages are reset only if cache was overflown on previous frame and they contain unused regions.
     void ResetAllShadowMaps();
     /// Allocate shadow map of given size. It is better to allocate from bigger to smaller sizes.
     ShadowMapRegion AllocateShadowMap(const IntVector2& size);
+    /// Allocate shadow map that is preserved between frames.
+    /// Returns empty region if shadow map cache is disabled or full.
+    ShadowMapRegion AllocatePersistentShadowMap(const IntVector2& size);
+    /// Return whether persistent shadow map is still allocated and its contents are preserved.
+    bool IsPersistentShadowMapValid(const ShadowMapRegion& shadowMap) const;
+    /// Mark persistent shadow map as used in current frame. Return false if it is not valid anymore.
+    bool ReusePersistentShadowMap(const ShadowMapRegion& shadowMap);
     /// Begin shadow map rendering. Clears shadow map if necessary.
     bool BeginShadowMapRendering(const ShadowMapRegion& shadowMap);
 
@@ -66,13 +76,23 @@ private:
         SharedPtr<Texture2D> texture_;
         AreaAllocator areaAllocator_;
         bool clearBeforeRendering_{};
+        /// Generation of persistent page, 0 for transient page. Changed whenever persistent page is reset.
+        unsigned generation_{};
+        /// Area of persistent regions allocated since last reset.
+        int allocatedArea_{};
+        /// Area of persistent regions used in current frame.
+        int usedArea_{};
 
         /// Allocate shadow map.
         ShadowMapRegion AllocateRegion(const IntVector2& size);
     };
 
     void CacheSettings();
-    void AllocatePage();
+    void AllocatePage(bool isPersistent);
+    void ResetPersistentPages();
+    void ResetPersistentPage(AtlasPage& page);
+    void ReclaimUnusedPersistentPages();
+    void ClearShadowMapRegion();
 
     /// External dependencies
     /// @{
@@ -91,6 +111,18 @@ private:
 
     ea::vector<AtlasPage> pages_;
     SharedPtr<Texture2D> vsmDepthTexture_;
+
+    /// Persistent shadow maps
+    /// @{
+    unsigned lastGeneration_{};
+    bool resetPersistentPages_{};
+    /// Total and minimal area of persistent shadow maps that didn't fit into cache in current frame.
+    int overflowArea_{};
+    int minOverflowArea_{};
+    StaticPipelineStateCache pipelineStates_;
+    StaticPipelineStateId clearPipelineState_{};
+    SharedPtr<DrawCommandQueue> clearQueue_;
+    /// @}
 };
 
 }
@@ -26,6 +26,7 @@
 #include "../Graphics/Drawable.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/Light.h"
+#include "../Graphics/Material.h"
 #include "../Graphics/Octree.h"
 #include "../Math/Polyhedron.h"
 #include "../RenderPipeline/BatchCompositor.h"
@@ -140,8 +141,7 @@ void ShadowSplitProcessor::InitializePoint(CubeMapFace face)
     shadowCamera_->SetZoom(1.0f);
 }
 
-void ShadowSplitProcessor::ProcessDirectionalShadowCasters(
-    DrawableProcessor* drawableProcessor, ea::vector<Drawable*>& shadowCastersBuffer)
+void ShadowSplitProcessor::ProcessDirectionalShadowCasters(DrawableProcessor* drawableProcessor)
 {
     shadowCasters_.clear();
     unsortedShadowBatches_.clear();
@@ -156,12 +156,13 @@ void ShadowSplitProcessor::ProcessDirectionalShadowCasters(
     Camera* cullCamera = frameInfo.camera_;
     Octree* octree = frameInfo.octree_;
 
+    shadowCasterCandidates_.clear();
     DirectionalLightShadowCasterQuery query(
-        shadowCastersBuffer, shadowCamera_->GetFrustum(), DRAWABLE_GEOMETRY, light_, cullCamera->GetShadowViewMask());
+        shadowCasterCandidates_, shadowCamera_->GetFrustum(), DRAWABLE_GEOMETRY, light_, cullCamera->GetShadowViewMask());
     octree->GetDrawables(query);
 
     // Preprocess shadow casters
-    drawableProcessor->PreprocessShadowCasters(shadowCasters_, shadowCastersBuffer, cascadeZRange_, light_, shadowCamera_);
+    drawableProcessor->PreprocessShadowCasters(shadowCasters_, shadowCasterCandidates_, cascadeZRange_, light_, shadowCamera_);
 }
 
 void ShadowSplitProcessor::ProcessSpotShadowCasters(
@@ -175,8 +176,8 @@ void ShadowSplitProcessor::ProcessSpotShadowCasters(
     drawableProcessor->PreprocessShadowCasters(shadowCasters_, shadowCasterCandidates, {}, light_, shadowCamera_);
 }
 
-void ShadowSplitProcessor::ProcessPointShadowCasters(
-    DrawableProcessor* drawableProcessor, const ea::vector<Drawable*>& shadowCasterCandidates)
+void ShadowSplitProcessor::ProcessPointShadowCasters(DrawableProcessor* drawableProcessor,
+    const ea::vector<Drawable*>& shadowCasterCandidates, ea::span<const BoundingBox> shadowCasterCandidateBoxes)
 {
     shadowCasters_.clear();
     unsortedShadowBatches_.clear();
@@ -190,8 +191,20 @@ void ShadowSplitProcessor::ProcessPointShadowCasters(
     if (cullCameraFrustum.IsInsideFast(BoundingBox(shadowCameraFrustum)) == OUTSIDE)
         return;
 
+    // Check that shadow casters are inside the face frustum
+    const unsigned numCandidates = shadowCasterCandidates.size();
+    isShadowCasterCandidateInside_.resize(numCandidates);
+    shadowCameraFrustum.AreInsideFast(shadowCasterCandidateBoxes, isShadowCasterCandidateInside_);
+
+    shadowCasterCandidates_.clear();
+    for (unsigned i = 0; i < numCandidates; ++i)
+    {
+        if (isShadowCasterCandidateInside_[i])
+            shadowCasterCandidates_.push_back(shadowCasterCandidates[i]);
+    }
+
     // Preprocess shadow casters
-    drawableProcessor->PreprocessShadowCasters(shadowCasters_, shadowCasterCandidates, {}, light_, shadowCamera_);
+    drawableProcessor->PreprocessShadowCasters(shadowCasters_, shadowCasterCandidates_, {}, light_, shadowCamera_);
 }
 
 void ShadowSplitProcessor::FinalizeShadow(const ShadowMapRegion& shadowMap, unsigned pcfKernelSize)
@@ -368,8 +381,49 @@ void ShadowSplitProcessor::FinalizeShadowBatches()
 {
     BatchCompositor::FillSortKeys(sortedShadowBatches_, unsortedShadowBatches_);
     ea::sort(sortedShadowBatches_.begin(), sortedShadowBatches_.end());
+    UpdateShadowCasterHash();
     shadowBatches_ = { sortedShadowBatches_,
         BatchRenderFlag::EnableInstancingForStaticGeometry | BatchRenderFlag::DisableColorOutput };
 }
 
+void ShadowSplitProcessor::UpdateShadowCasterHash()
+{
+    shadowCasterHash_ = 0;
+    hasDynamicShadowCasters_ = false;
+
+    for (const PipelineBatchByState& sortedBatch : sortedShadowBatches_)
+    {
+        const PipelineBatch& batch = *sortedBatch.pipelineBatch_;
+        const SourceBatch& sourceBatch = batch.GetSourceBatch();
+
+        CombineHash(shadowCasterHash_, MakeHash(batch.drawable_));
+        CombineHash(shadowCasterHash_, batch.sourceBatchIndex_);
+        CombineHash(shadowCasterHash_, MakeHash(batch.geometry_));
+        CombineHash(shadowCasterHash_, MakeHash(batch.pipelineState_));
+        if (sourceBatch.worldTransform_)
+        {
+            // Instanced casters have one transform per instance
+            CombineHash(shadowCasterHash_, sourceBatch.numWorldTransforms_);
+            for (unsigned i = 0; i < sourceBatch.numWorldTransforms_; ++i)
+                CombineHash(shadowCasterHash_, sourceBatch.worldTransform_[i].ToHash());
+        }
+
+        // Alpha-masked casters depend on material parameters and textures
+        if (const Material* material = batch.material_)
+        {
+            CombineHash(shadowCasterHash_, MakeHash(material));
+            CombineHash(shadowCasterHash_, material->GetShaderParameterHash());
+            for (const auto& [nameHash, texture] : material->GetTextures())
+            {
+                CombineHash(shadowCasterHash_, nameHash.Value());
+                CombineHash(shadowCasterHash_, MakeHash(texture.value_.Get()));
+            }
+        }
+
+        // Contents of skinned and procedurally updated geometries cannot be tracked by hash
+        if (batch.geometryType_ == GEOM_SKINNED || batch.drawable_->GetUpdateGeometryType() != UPDATE_NONE)
+            hasDynamicShadowCasters_ = true;
+    }
+}
+
 }
@@ -28,6 +28,7 @@
 #include "../RenderPipeline/PipelineBatchSortKey.h"
 #include "../Scene/Node.h"
 
+#include <EASTL/span.h>
 #include <EASTL/vector.h>
 
 namespace Urho3D
@@ -59,9 +60,10 @@ public:
 
     /// Process shadow casters
     /// @{
-    void ProcessDirectionalShadowCasters(DrawableProcessor* drawableProcessor, ea::vector<Drawable*>& shadowCastersBuffer);
+    void ProcessDirectionalShadowCasters(DrawableProcessor* drawableProcessor);
     void ProcessSpotShadowCasters(DrawableProcessor* drawableProcessor, const ea::vector<Drawable*>& shadowCasterCandidates);
-    void ProcessPointShadowCasters(DrawableProcessor* drawableProcessor, const ea::vector<Drawable*>& shadowCasterCandidates);
+    void ProcessPointShadowCasters(DrawableProcessor* drawableProcessor, const ea::vector<Drawable*>& shadowCasterCandidates,
+        ea::span<const BoundingBox> shadowCasterCandidateBoxes);
     /// @}
 
     void FinalizeShadow(const ShadowMapRegion& shadowMap, unsigned pcfKernelSize);
@@ -94,6 +96,12 @@ public:
     auto& GetMutableShadowBatches() { return shadowBatches_; }
     const auto& GetShadowBatches() const { return shadowBatches_; }
 
+    /// Return values are valid after shadow batches are finalized
+    /// @{
+    unsigned GetShadowCasterHash() const { return shadowCasterHash_; }
+    bool HasDynamicShadowCasters() const { return hasDynamicShadowCasters_; }
+    /// @}
+
 private:
     void InitializeBaseDirectionalCamera(Camera* cullCamera);
     BoundingBox GetLitGeometriesBoundingBox(
@@ -101,6 +109,7 @@ private:
     BoundingBox GetSplitShadowBoundingBoxInLightSpace(
         DrawableProcessor* drawableProcessor, const ea::vector<Drawable*>& litGeometries) const;
     void AdjustDirectionalLightCamera(const BoundingBox& lightSpaceBoundingBox, float shadowMapSize);
+    void UpdateShadowCasterHash();
 
     /// Immutable
     /// @{
@@ -121,6 +130,11 @@ private:
     FloatRange cascadeZRange_{};
     FloatRange focusedCascadeZRange_{};
     ea::vector<Drawable*> shadowCasters_;
+    /// Temporary buffers for shadow caster candidates of this split.
+    /// @{
+    ea::vector<Drawable*> shadowCasterCandidates_;
+    ea::vector<bool> isShadowCasterCandidateInside_;
+    /// @}
 
     ShadowMapRegion shadowMap_;
     float shadowMapWorldSpaceTexelSize_{};
@@ -132,6 +146,8 @@ private:
     ea::vector<PipelineBatch> unsortedShadowBatches_;
     ea::vector<PipelineBatchByState> sortedShadowBatches_;
     PipelineBatchGroup<PipelineBatchByState> shadowBatches_;
+    unsigned shadowCasterHash_{};
+    bool hasDynamicShadowCasters_{};
     /// @}
 };
 
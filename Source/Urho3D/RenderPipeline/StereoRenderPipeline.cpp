@@ -475,14 +475,21 @@ void StereoRenderPipelineView::Update(const FrameInfo& frameInfo)
     frameInfo_.timeStep_ = frameInfo.timeStep_;
 
     // Begin debug snapshot
+    bool takeSnapshot = false;
 #if URHO3D_SYSTEMUI
-    const bool shiftDown = ui::IsKeyDown(KEY_LSHIFT) || ui::IsKeyDown(KEY_RSHIFT);
-    const bool ctrlDown = ui::IsKeyDown(KEY_LCTRL) || ui::IsKeyDown(KEY_RCTRL);
-    const bool takeSnapshot = shiftDown && ctrlDown && ui::IsKeyPressed(KEY_F12);
-#else
-    auto input = GetSubsystem<Input>();
-    const bool takeSnapshot = input->GetQualifiers().Test(QUAL_CTRL | QUAL_SHIFT) && input->GetKeyPress(KEY_F12);
+    // SystemUI may be missing, e.g. for null render backend
+    if (GetSubsystem<SystemUI>())
+    {
+        const bool shiftDown = ui::IsKeyDown(KEY_LSHIFT) || ui::IsKeyDown(KEY_RSHIFT);
+        const bool ctrlDown = ui::IsKeyDown(KEY_LCTRL) || ui::IsKeyDown(KEY_RCTRL);
+        takeSnapshot = shiftDown && ctrlDown && ui::IsKeyPressed(KEY_F12);
+    }
+    else
 #endif
+    {
+        auto input = GetSubsystem<Input>();
+        takeSnapshot = input->GetQualifiers().Test(QUAL_CTRL | QUAL_SHIFT) && input->GetKeyPress(KEY_F12);
+    }
     if (takeSnapshot)
         debugger_.BeginSnapshot();
 
@@ -0,0 +1,452 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Scene/CookedScene.h"
+
+#include "Urho3D/Core/Context.h"
+#include "Urho3D/Core/Profiler.h"
+#include "Urho3D/Core/WorkQueue.h"
+#include "Urho3D/IO/Log.h"
+#include "Urho3D/IO/MemoryBuffer.h"
+#include "Urho3D/IO/VectorBuffer.h"
+#include "Urho3D/Scene/Component.h"
+#include "Urho3D/Scene/Node.h"
+#include "Urho3D/Scene/SceneResolver.h"
+
+#include <EASTL/algorithm.h>
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+const ea::string cookedSceneFileID = "CSCN";
+
+/// Objects are decoded in worker threads in buckets of this size.
+const unsigned decodeBucketSize = 64;
+
+/// Attribute as stored in cooked scene.
+struct CookedAttribute
+{
+    StringHash nameHash_;
+    VariantType type_{};
+
+    bool operator==(const CookedAttribute& rhs) const { return nameHash_ == rhs.nameHash_ && type_ == rhs.type_; }
+};
+
+/// Objects of the same type and attribute layout.
+struct CookedGroup
+{
+    StringHash type_;
+    bool isNode_{};
+    ea::vector<CookedAttribute> attributes_;
+
+    /// Offsets of object data in the data block. There's one extra offset at the end.
+    ea::vector<unsigned> offsets_;
+    /// Data block of the group. Writer only.
+    VectorBuffer data_;
+
+    /// Number of objects in the group.
+    unsigned numObjects_{};
+    /// Data block of the group. Loader only.
+    const unsigned char* loadedData_{};
+    /// Runtime attributes matching stored attributes. Null if attribute is unknown. Loader only.
+    ea::vector<const AttributeInfo*> runtimeAttributes_;
+    /// Decoded attribute values of all objects. Loader only.
+    ea::vector<Variant> values_;
+};
+
+/// Node or component as stored in cooked scene.
+struct CookedObject
+{
+    unsigned group_{};
+    /// Index of parent node for nodes and index of owner node for components.
+    unsigned owner_{};
+    unsigned id_{};
+    /// Index of object within the group. Loader only.
+    unsigned indexInGroup_{};
+};
+
+class CookedSceneWriter
+{
+public:
+    bool Write(const Node* root, Serializer& dest)
+    {
+        AddNode(root, 0);
+
+        dest.WriteFileID(cookedSceneFileID);
+        dest.WriteUInt(CookedSceneVersion);
+
+        dest.WriteVLE(groups_.size());
+        for (const CookedGroup& group : groups_)
+        {
+            dest.WriteStringHash(group.type_);
+            dest.WriteBool(group.isNode_);
+            dest.WriteVLE(group.attributes_.size());
+            for (const CookedAttribute& attribute : group.attributes_)
+            {
+                dest.WriteStringHash(attribute.nameHash_);
+                dest.WriteUByte(static_cast<unsigned char>(attribute.type_));
+            }
+        }
+
+        dest.WriteVLE(objects_.size());
+        for (const CookedObject& object : objects_)
+        {
+            dest.WriteVLE(object.group_);
+            dest.WriteVLE(object.owner_);
+            dest.WriteUInt(object.id_);
+        }
+
+        for (const CookedGroup& group : groups_)
+        {
+            for (unsigned offset : group.offsets_)
+                dest.WriteUInt(offset);
+            if (!dest.Write(group.data_.GetData(), group.data_.GetSize()))
+                return false;
+        }
+
+        return true;
+    }
+
+private:
+    void AddNode(const Node* node, unsigned parentIndex)
+    {
+        const unsigned nodeIndex = AddObject(node, true, parentIndex, node->GetID());
+
+        for (Component* component : node->GetComponents())
+        {
+            if (!component->IsTemporary())
+                AddObject(component, false, nodeIndex, component->GetID());
+        }
+
+        for (Node* child : node->GetChildren())
+        {
+            if (!child->IsTemporary())
+                AddNode(child, nodeIndex);
+        }
+    }
+
+    unsigned AddObject(const Serializable* object, bool isNode, unsigned owner, unsigned id)
+    {
+        attributes_.clear();
+        attributeInfos_.clear();
+        if (const ea::vector<AttributeInfo>* attributes = object->GetAttributes())
+        {
+            for (const AttributeInfo& attr : *attributes)
+            {
+                if (!attr.ShouldSave())
+                    continue;
+
+                attributes_.push_back({StringHash(attr.name_), attr.type_});
+                attributeInfos_.push_back(&attr);
+            }
+        }
+
+        const unsigned groupIndex = GetOrCreateGroup(object->GetType(), isNode);
+        CookedGroup& group = groups_[groupIndex];
+
+        group.offsets_.back() = group.data_.GetSize();
+        for (const AttributeInfo* attr : attributeInfos_)
+        {
+            object->OnGetAttribute(*attr, value_);
+            group.data_.WriteVariantData(value_);
+        }
+        group.offsets_.push_back(group.data_.GetSize());
+
+        objects_.push_back({groupIndex, owner, id});
+        return objects_.size() - 1;
+    }
+
+    unsigned GetOrCreateGroup(StringHash type, bool isNode)
+    {
+        for (unsigned i = 0; i < groups_.size(); ++i)
+        {
+            const CookedGroup& group = groups_[i];
+            if (group.type_ == type && group.isNode_ == isNode && group.attributes_ == attributes_)
+                return i;
+        }
+
+        CookedGroup& group = groups_.emplace_back();
+        group.type_ = type;
+        group.isNode_ = isNode;
+        group.attributes_ = attributes_;
+        group.offsets_.push_back(0);
+        return groups_.size() - 1;
+    }
+
+    ea::vector<CookedGroup> groups_;
+    ea::vector<CookedObject> objects_;
+
+    /// Temporary buffers.
+    /// @{
+    ea::vector<CookedAttribute> attributes_;
+    ea::vector<const AttributeInfo*> attributeInfos_;
+    Variant value_;
+    /// @}
+};
+
+class CookedSceneLoader
+{
+public:
+    explicit CookedSceneLoader(Context* context) : context_(context) {}
+
+    bool Load(Node* root, Deserializer& source)
+    {
+        if (source.ReadFileID() != cookedSceneFileID)
+        {
+            URHO3D_LOGERROR("{} is not a cooked scene file", source.GetName());
+            return false;
+        }
+
+        const unsigned version = source.ReadUInt();
+        if (version != CookedSceneVersion)
+        {
+            URHO3D_LOGERROR("{} has unsupported cooked scene version {}", source.GetName(), version);
+            return false;
+        }
+
+        // Read the rest of the file at once, attribute data is decoded directly from this buffer
+        fileData_.resize(source.GetSize() - source.Tell());
+        if (source.Read(fileData_.data(), fileData_.size()) != fileData_.size())
+        {
+            URHO3D_LOGERROR("Could not read cooked scene {}", source.GetName());
+            return false;
+        }
+
+        MemoryBuffer buffer(fileData_);
+        if (!ReadLayout(buffer))
+        {
+            URHO3D_LOGERROR("Cooked scene {} is corrupted", source.GetName());
+            return false;
+        }
+
+        ResolveAttributes();
+        DecodeValues();
+        return CreateObjects(root);
+    }
+
+private:
+    bool ReadLayout(MemoryBuffer& buffer)
+    {
+        groups_.resize(buffer.ReadVLE());
+        for (CookedGroup& group : groups_)
+        {
+            group.type_ = buffer.ReadStringHash();
+            group.isNode_ = buffer.ReadBool();
+            group.attributes_.resize(buffer.ReadVLE());
+            for (CookedAttribute& attribute : group.attributes_)
+            {
+                attribute.nameHash_ = buffer.ReadStringHash();
+                attribute.type_ = static_cast<VariantType>(buffer.ReadUByte());
+            }
+        }
+
+        objects_.resize(buffer.ReadVLE());
+        for (CookedObject& object : objects_)
+        {
+            object.group_ = buffer.ReadVLE();
+            object.owner_ = buffer.ReadVLE();
+            object.id_ = buffer.ReadUInt();
+            if (object.group_ >= groups_.size())
+                return false;
+
+            object.indexInGroup_ = groups_[object.group_].numObjects_++;
+        }
+
+        for (CookedGroup& group : groups_)
+        {
+            group.offsets_.resize(group.numObjects_ + 1);
+            for (unsigned& offset : group.offsets_)
+                offset = buffer.ReadUInt();
+
+            const unsigned dataSize = group.offsets_.back();
+            if (buffer.GetSize() - buffer.Tell() < dataSize)
+                return false;
+
+            group.loadedData_ = buffer.GetData() + buffer.Tell();
+            buffer.Seek(buffer.Tell() + dataSize);
+        }
+
+        return !objects_.empty();
+    }
+
+    void ResolveAttributes()
+    {
+        for (CookedGroup& group : groups_)
+        {
+            const ea::vector<AttributeInfo>* attributes = context_->GetAttributes(group.type_);
+
+            group.runtimeAttributes_.resize(group.attributes_.size());
+            for (unsigned i = 0; i < group.attributes_.size(); ++i)
+            {
+                const CookedAttribute& attribute = group.attributes_[i];
+                const AttributeInfo* runtimeAttribute = nullptr;
+                if (attributes)
+                {
+                    for (const AttributeInfo& attr : *attributes)
+                    {
+                        if (attr.ShouldLoad() && attr.type_ == attribute.type_
+                            && StringHash(attr.name_) == attribute.nameHash_)
+                        {
+                            runtimeAttribute = &attr;
+                            break;
+                        }
+                    }
+                }
+                group.runtimeAttributes_[i] = runtimeAttribute;
+            }
+        }
+    }
+
+    void DecodeValues()
+    {
+        URHO3D_PROFILE("DecodeCookedScene");
+
+        auto workQueue = context_->GetSubsystem<WorkQueue>();
+        for (CookedGroup& group : groups_)
+        {
+            group.values_.resize(group.numObjects_ * group.attributes_.size());
+
+            // Custom values are created via Context and cannot be decoded in worker threads
+            const bool hasCustomValues = ea::any_of(group.attributes_.begin(), group.attributes_.end(),
+                [](const CookedAttribute& attribute) { return attribute.type_ == VAR_CUSTOM; });
+
+            const auto decodeObjects = [&](unsigned beginIndex, unsigned endIndex)
+            {
+                for (unsigned i = beginIndex; i < endIndex; ++i)
+                    DecodeObject(group, i, hasCustomValues ? context_ : nullptr);
+            };
+
+            if (workQueue && !hasCustomValues)
+                ForEachParallel(workQueue, decodeBucketSize, group.numObjects_, decodeObjects);
+            else
+                decodeObjects(0, group.numObjects_);
+        }
+    }
+
+    static void DecodeObject(CookedGroup& group, unsigned index, Context* context)
+    {
+        const unsigned beginOffset = group.offsets_[index];
+        const unsigned endOffset = group.offsets_[index + 1];
+        if (beginOffset > endOffset || endOffset > group.offsets_.back())
+            return;
+
+        MemoryBuffer objectData(group.loadedData_ + beginOffset, endOffset - beginOffset);
+        Variant* values = &group.values_[index * group.attributes_.size()];
+        for (const CookedAttribute& attribute : group.attributes_)
+        {
+            if (objectData.IsEof())
+                break;
+            *values++ = objectData.ReadVariant(attribute.type_, context);
+        }
+    }
+
+    bool CreateObjects(Node* root)
+    {
+        URHO3D_PROFILE("CreateCookedSceneObjects");
+
+        const CookedGroup& rootGroup = groups_[objects_[0].group_];
+        if (!rootGroup.isNode_ || rootGroup.type_ != root->GetType())
+        {
+            URHO3D_LOGERROR("Cooked scene root type does not match {}", root->GetTypeName());
+            return false;
+        }
+
+        root->RemoveAllChildren();
+        root->RemoveAllComponents();
+
+        SceneResolver resolver;
+        ea::vector<Node*> nodes(objects_.size());
+        for (unsigned i = 0; i < objects_.size(); ++i)
+        {
+            const CookedObject& object = objects_[i];
+            const CookedGroup& group = groups_[object.group_];
+
+            Node* ownerNode = i != 0 && object.owner_ < i ? nodes[object.owner_] : nullptr;
+            if (i != 0 && !ownerNode)
+            {
+                URHO3D_LOGERROR("Cooked scene has invalid hierarchy");
+                return false;
+            }
+
+            Serializable* serializable = nullptr;
+            if (i == 0)
+            {
+                // Own ID is not applied, only stored for resolving possible references
+                nodes[i] = root;
+                resolver.AddNode(object.id_, root);
+                serializable = root;
+            }
+            else if (group.isNode_)
+            {
+                Node* node = ownerNode->CreateChild(EMPTY_STRING, object.id_);
+                nodes[i] = node;
+                resolver.AddNode(object.id_, node);
+                serializable = node;
+            }
+            else
+            {
+                Component* component = ownerNode->CreateComponent(group.type_, object.id_);
+                if (!component)
+                {
+                    URHO3D_LOGWARNING("Component type {} not known, skipping", group.type_.ToDebugString());
+                    continue;
+                }
+                resolver.AddComponent(object.id_, component);
+                serializable = component;
+            }
+
+            const Variant* values = &group.values_[object.indexInGroup_ * group.attributes_.size()];
+            for (unsigned j = 0; j < group.attributes_.size(); ++j)
+            {
+                const AttributeInfo* attr = group.runtimeAttributes_[j];
+                if (attr && !values[j].IsEmpty())
+                    serializable->OnSetAttribute(*attr, values[j]);
+            }
+        }
+
+        resolver.Resolve();
+        root->ApplyAttributes();
+        return true;
+    }
+
+    Context* context_{};
+    ByteVector fileData_;
+    ea::vector<CookedGroup> groups_;
+    ea::vector<CookedObject> objects_;
+};
+
+} // namespace
+
+bool SaveCookedScene(const Node* root, Serializer& dest)
+{
+    URHO3D_PROFILE("SaveCookedScene");
+
+    CookedSceneWriter writer;
+    return writer.Write(root, dest);
+}
+
+bool LoadCookedScene(Node* root, Deserializer& source)
+{
+    URHO3D_PROFILE("LoadCookedScene");
+
+    CookedSceneLoader loader(root->GetContext());
+    return loader.Load(root, source);
+}
+
+bool IsCookedScene(Deserializer& source)
+{
+    const unsigned basePosition = source.Tell();
+    const bool isCooked = source.ReadFileID() == cookedSceneFileID;
+    source.Seek(basePosition);
+    return isCooked;
+}
+
+} // namespace Urho3D
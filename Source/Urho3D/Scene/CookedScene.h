@@ -0,0 +1,30 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/IO/Deserializer.h"
+#include "Urho3D/IO/Serializer.h"
+
+namespace Urho3D
+{
+
+class Node;
+
+/// Version of cooked scene format. Cooked scenes of other versions are rejected.
+static const unsigned CookedSceneVersion = 1;
+
+/// Save node hierarchy in cooked binary format. Temporary nodes and components are skipped.
+///
+/// Cooked format is optimized for loading of large scenes and is not intended for editing.
+/// Objects are grouped by type and attribute layout. Layout of each group is stored once,
+/// and attribute values of all objects in the group are stored in one contiguous block with precomputed offsets.
+URHO3D_API bool SaveCookedScene(const Node* root, Serializer& dest);
+/// Load node hierarchy saved by SaveCookedScene into existing node. The type of the node should match.
+/// Attribute values are decoded in worker threads and applied in the main thread.
+URHO3D_API bool LoadCookedScene(Node* root, Deserializer& source);
+/// Return whether the stream contains cooked scene. Stream position is not changed.
+URHO3D_API bool IsCookedScene(Deserializer& source);
+
+} // namespace Urho3D
@@ -0,0 +1,202 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Scene/DetachedNode.h"
+
+#include "Urho3D/Core/Context.h"
+#include "Urho3D/IO/Deserializer.h"
+#include "Urho3D/IO/MemoryBuffer.h"
+#include "Urho3D/Scene/Node.h"
+
+#include <EASTL/algorithm.h>
+
+#include <thread>
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+bool ReadAttributes(Deserializer& source, const ea::vector<AttributeInfo>* attributes, ea::vector<Variant>& values)
+{
+    if (!attributes)
+        return true;
+
+    for (const AttributeInfo& attr : *attributes)
+    {
+        if (!attr.ShouldLoad())
+            continue;
+
+        if (source.IsEof())
+            return false;
+
+        values.push_back(source.ReadVariant(attr.type_));
+    }
+    return true;
+}
+
+} // namespace
+
+bool DetachedNodeData::Read(Deserializer& source, Context* context)
+{
+    if (!ReadAttributes(source, context->GetAttributes(Node::GetTypeStatic()), values_))
+        return false;
+
+    ByteVector componentData;
+    components_.resize(source.ReadVLE());
+    for (DetachedComponentData& component : components_)
+    {
+        componentData.resize(source.ReadVLE());
+        if (source.Read(componentData.data(), componentData.size()) != componentData.size())
+            return false;
+
+        MemoryBuffer componentBuffer(componentData);
+        component.type_ = componentBuffer.ReadStringHash();
+        component.id_ = componentBuffer.ReadUInt();
+
+        component.decoded_ = IsDecodedInAnyThread(context, component.type_);
+        if (component.decoded_)
+        {
+            // Do not abort if component fails to load, same as Node::Load
+            ReadAttributes(componentBuffer, context->GetAttributes(component.type_), component.values_);
+        }
+        else
+        {
+            const unsigned char* data = componentBuffer.GetData() + componentBuffer.Tell();
+            component.rawData_.assign(data, data + componentBuffer.GetSize() - componentBuffer.Tell());
+        }
+    }
+
+    children_.resize(source.ReadVLE());
+    for (DetachedNodeData& child : children_)
+    {
+        child.id_ = source.ReadUInt();
+        if (!child.Read(source, context))
+            return false;
+    }
+
+    return true;
+}
+
+bool DetachedNodeData::ReadRaw(Deserializer& source, Context* context, ByteVector& data)
+{
+    const unsigned beginPosition = source.GetPosition();
+    source.ReadUInt();
+    if (!Skip(source, context))
+        return false;
+
+    data.resize(source.GetPosition() - beginPosition);
+    source.Seek(beginPosition);
+    return source.Read(data.data(), data.size()) == data.size();
+}
+
+bool DetachedNodeData::Skip(Deserializer& source, Context* context)
+{
+    // Node attributes have no size prefix and have to be decoded, components are skipped without decoding
+    ea::vector<Variant> values;
+    if (!ReadAttributes(source, context->GetAttributes(Node::GetTypeStatic()), values))
+        return false;
+
+    const unsigned numComponents = source.ReadVLE();
+    for (unsigned i = 0; i < numComponents; ++i)
+    {
+        const unsigned dataSize = source.ReadVLE();
+        if (source.GetPosition() + dataSize > source.GetSize())
+            return false;
+        source.SeekRelative(static_cast<int>(dataSize));
+    }
+
+    const unsigned numChildren = source.ReadVLE();
+    for (unsigned i = 0; i < numChildren; ++i)
+    {
+        source.ReadUInt();
+        if (!Skip(source, context))
+            return false;
+    }
+
+    return true;
+}
+
+bool DetachedNodeData::IsDecodedInAnyThread(Context* context, StringHash type)
+{
+    // Unknown components are handled in the main thread.
+    // Custom values are created via Context and cannot be decoded in worker threads.
+    const ea::vector<AttributeInfo>* attributes = context->GetAttributes(type);
+    if (!attributes)
+        return false;
+
+    return ea::none_of(attributes->begin(), attributes->end(),
+        [](const AttributeInfo& attr) { return attr.ShouldLoad() && attr.type_ == VAR_CUSTOM; });
+}
+
+void DetachedNodeData::ApplyAttributes(Serializable* serializable, const ea::vector<Variant>& values)
+{
+    const ea::vector<AttributeInfo>* attributes = serializable->GetAttributes();
+    if (!attributes)
+        return;
+
+    unsigned index = 0;
+    for (const AttributeInfo& attr : *attributes)
+    {
+        if (!attr.ShouldLoad())
+            continue;
+
+        if (index >= values.size())
+            break;
+
+        serializable->OnSetAttribute(attr, values[index++]);
+    }
+}
+
+void DetachedNodeQueue::ProcessNode(unsigned index, const ByteVector& data, Context* context)
+{
+    {
+        MutexLock lock(mutex_);
+        if (cancelled_)
+            return;
+        ++numRunningTasks_;
+    }
+
+    DetachedNodeData node;
+    MemoryBuffer buffer(data);
+    node.id_ = buffer.ReadUInt();
+    const bool success = node.Read(buffer, context);
+
+    MutexLock lock(mutex_);
+    nodes_[index] = ea::move(node);
+    states_[index] = success ? NodeState::Ready : NodeState::Failed;
+    --numRunningTasks_;
+}
+
+DetachedNodeQueue::NodeState DetachedNodeQueue::GetState(unsigned index)
+{
+    MutexLock lock(mutex_);
+    return states_[index];
+}
+
+void DetachedNodeQueue::CancelAndWait()
+{
+    {
+        MutexLock lock(mutex_);
+        cancelled_ = true;
+    }
+
+    // Running tasks deserialize at most one node each
+    for (;;)
+    {
+        {
+            MutexLock lock(mutex_);
+            if (numRunningTasks_ == 0)
+                return;
+        }
+        std::this_thread::yield();
+    }
+}
+
+} // namespace Urho3D
@@ -0,0 +1,85 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Container/ByteVector.h"
+#include "Urho3D/Container/RefCounted.h"
+#include "Urho3D/Core/Mutex.h"
+#include "Urho3D/Core/Variant.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class Context;
+class Deserializer;
+class Serializable;
+
+/// Component deserialized from binary data without creating the component object.
+struct URHO3D_API DetachedComponentData
+{
+    StringHash type_;
+    unsigned id_{};
+    /// Whether the attributes are decoded. Raw data should be loaded otherwise.
+    bool decoded_{};
+    /// Values of loadable attributes in order of registration.
+    ea::vector<Variant> values_;
+    /// Raw binary data of the component if it cannot be decoded outside of the main thread.
+    ByteVector rawData_;
+};
+
+/// Node hierarchy deserialized from binary data without creating node and component objects.
+/// It can be deserialized in worker thread and then loaded into the scene via Node::LoadDetached in the main thread.
+struct URHO3D_API DetachedNodeData
+{
+    unsigned id_{};
+    /// Values of loadable attributes in order of registration.
+    ea::vector<Variant> values_;
+    ea::vector<DetachedComponentData> components_;
+    ea::vector<DetachedNodeData> children_;
+
+    /// Read node in the format of Node::Save, except node ID. Safe to call from any thread. Return true on success.
+    bool Read(Deserializer& source, Context* context);
+    /// Copy serialized node with its ID and children without decoding components. Return true on success.
+    static bool ReadRaw(Deserializer& source, Context* context, ByteVector& data);
+    /// Skip node in the format of Node::Save, except node ID. Return true on success.
+    static bool Skip(Deserializer& source, Context* context);
+
+    /// Return whether the objects of given type can be decoded outside of the main thread.
+    static bool IsDecodedInAnyThread(Context* context, StringHash type);
+    /// Apply values of loadable attributes to the object.
+    static void ApplyAttributes(Serializable* serializable, const ea::vector<Variant>& values);
+};
+
+/// Root-level nodes deserialized in worker threads during asynchronous scene loading, one task per node.
+struct DetachedNodeQueue : public RefCounted
+{
+    enum class NodeState : unsigned char
+    {
+        Pending,
+        Ready,
+        Failed
+    };
+
+    Mutex mutex_;
+    /// Deserialized nodes in the order of the file. Node is owned by the main thread once it's not pending.
+    ea::vector<DetachedNodeData> nodes_;
+    /// States of nodes. Protected by mutex.
+    ea::vector<NodeState> states_;
+    /// Number of tasks currently deserializing nodes. Protected by mutex.
+    unsigned numRunningTasks_{};
+    /// Set by the main thread to stop deserialization. Protected by mutex.
+    bool cancelled_{};
+
+    /// Deserialize node from data in worker thread.
+    void ProcessNode(unsigned index, const ByteVector& data, Context* context);
+    /// Return state of the node.
+    NodeState GetState(unsigned index);
+    /// Cancel tasks that are not started yet and wait for running tasks to finish.
+    void CancelAndWait();
+};
+
+} // namespace Urho3D
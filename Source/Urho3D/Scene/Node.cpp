@@ -28,10 +28,12 @@
 #include "Urho3D/IO/Archive.h"
 #include "Urho3D/IO/ArchiveSerialization.h"
 #include "Urho3D/IO/Log.h"
+#include "Urho3D/IO/MemoryBuffer.h"
 #include "Urho3D/Resource/JSONFile.h"
 #include "Urho3D/Resource/ResourceCache.h"
 #include "Urho3D/Resource/XMLFile.h"
 #include "Urho3D/Scene/Component.h"
+#include "Urho3D/Scene/DetachedNode.h"
 #include "Urho3D/Scene/PrefabReader.h"
 #include "Urho3D/Scene/PrefabResource.h"
 #include "Urho3D/Scene/PrefabWriter.h"
@@ -1803,6 +1805,39 @@ bool Node::Load(Deserializer& source, SceneResolver& resolver, bool loadChildren
     return true;
 }
 
+void Node::LoadDetached(const DetachedNodeData& source, SceneResolver& resolver)
+{
+    // Remove all children and components first in case this is not a fresh load
+    RemoveAllChildren();
+    RemoveAllComponents();
+
+    // ID has been read at the parent level
+    DetachedNodeData::ApplyAttributes(this, source.values_);
+
+    for (const DetachedComponentData& componentData : source.components_)
+    {
+        Component* newComponent = SafeCreateComponent(EMPTY_STRING, componentData.type_, componentData.id_);
+        if (!newComponent)
+            continue;
+
+        resolver.AddComponent(componentData.id_, newComponent);
+        if (componentData.decoded_)
+            DetachedNodeData::ApplyAttributes(newComponent, componentData.values_);
+        else
+        {
+            MemoryBuffer componentBuffer(componentData.rawData_);
+            newComponent->Load(componentBuffer);
+        }
+    }
+
+    for (const DetachedNodeData& childData : source.children_)
+    {
+        Node* newNode = CreateChild(childData.id_);
+        resolver.AddNode(childData.id_, newNode);
+        newNode->LoadDetached(childData, resolver);
+    }
+}
+
 bool Node::LoadXML(const XMLElement& source, SceneResolver& resolver, bool loadChildren, bool rewriteIDs, bool removeComponents)
 {
     // Remove all children and components first in case this is not a fresh load
@@ -41,6 +41,7 @@ namespace Urho3D
 class Connection;
 class Node;
 class PrefabReader;
+struct DetachedNodeData;
 class PrefabWriter;
 class Scene;
 class NodePrefab;
@@ -769,6 +770,8 @@ public:
     void ResetScene();
     /// Load components and optionally load child nodes.
     bool Load(Deserializer& source, SceneResolver& resolver, bool loadChildren = true, bool rewriteIDs = false);
+    /// Load components and child nodes from data deserialized in another thread. Should be called from the main thread.
+    void LoadDetached(const DetachedNodeData& source, SceneResolver& resolver);
     /// Load components from XML data and optionally load child nodes.
     bool LoadXML(const XMLElement& source, SceneResolver& resolver, bool loadChildren = true, bool rewriteIDs = false,
         bool removeComponents = true);
@@ -38,6 +38,7 @@
 #include "Urho3D/Resource/XMLArchive.h"
 #include "Urho3D/Resource/XMLFile.h"
 #include "Urho3D/Scene/Component.h"
+#include "Urho3D/Scene/CookedScene.h"
 #include "Urho3D/Scene/ObjectAnimation.h"
 #include "Urho3D/Scene/PrefabReference.h"
 #include "Urho3D/Scene/PrefabResource.h"
@@ -185,6 +186,9 @@ bool Scene::Load(Deserializer& source)
 
     StopAsyncLoading();
 
+    if (IsCookedScene(source))
+        return LoadCooked(source);
+
     constexpr BinaryMagic sceneBinaryMagic{{'U', 'S', 'C', 'N'}};
 
     const InternalResourceFormat format = PeekResourceFormat(source, sceneBinaryMagic);
@@ -201,6 +205,9 @@ bool Scene::Load(Deserializer& source)
 
     Clear();
 
+    // Skip the file ID, it is already checked
+    source.SeekRelative(BinaryMagicSize);
+
     // Load the whole scene, then perform post-load if successfully loaded
     if (Node::Load(source))
     {
@@ -361,6 +368,25 @@ bool Scene::LoadJSON(Deserializer& source)
         return false;
 }
 
+bool Scene::LoadCooked(Deserializer& source)
+{
+    URHO3D_PROFILE("LoadSceneCooked");
+
+    StopAsyncLoading();
+
+    URHO3D_LOGINFO("Loading cooked scene from " + source.GetName());
+
+    Clear();
+
+    if (LoadCookedScene(this, source))
+    {
+        FinishLoading(&source);
+        return true;
+    }
+    else
+        return false;
+}
+
 bool Scene::SaveXML(Serializer& dest, const ea::string& indentation) const
 {
     URHO3D_PROFILE("SaveSceneXML");
@@ -407,6 +433,26 @@ bool Scene::SaveJSON(Serializer& dest, const ea::string& indentation) const
         return false;
 }
 
+bool Scene::SaveCooked(Serializer& dest) const
+{
+    URHO3D_PROFILE("SaveSceneCooked");
+
+    auto* ptr = dynamic_cast<Deserializer*>(&dest);
+    if (ptr)
+        URHO3D_LOGINFO("Saving cooked scene to " + ptr->GetName());
+
+    if (SaveCookedScene(this, dest))
+    {
+        FinishSaving(&dest);
+        return true;
+    }
+    else
+    {
+        URHO3D_LOGERROR("Could not save cooked scene, writing to stream failed");
+        return false;
+    }
+}
+
 bool Scene::LoadAsync(AbstractFilePtr file, LoadMode mode)
 {
     if (!file)
@@ -468,6 +514,32 @@ bool Scene::LoadAsync(AbstractFilePtr file, LoadMode mode)
 
         // Then prepare to load child nodes in the async updates
         asyncProgress_.totalNodes_ = file->ReadVLE();
+
+        // Deserialize child nodes in worker threads if possible, only add them to the scene in the async updates.
+        // Each task owns a copy of its node data, the file is not accessed outside of the main thread
+        auto workQueue = GetSubsystem<WorkQueue>();
+        if (workQueue && workQueue->IsMultithreaded() && DetachedNodeData::IsDecodedInAnyThread(context_, Node::GetTypeStatic()))
+        {
+            auto queue = MakeShared<DetachedNodeQueue>();
+            queue->nodes_.resize(asyncProgress_.totalNodes_);
+            queue->states_.resize(asyncProgress_.totalNodes_, DetachedNodeQueue::NodeState::Pending);
+            asyncProgress_.detachedNodes_ = queue;
+
+            for (unsigned i = 0; i < asyncProgress_.totalNodes_; ++i)
+            {
+                ByteVector data;
+                if (!DetachedNodeData::ReadRaw(*file, context_, data))
+                {
+                    // Nodes before this one are still loaded, same as when loading in the main thread
+                    queue->states_[i] = DetachedNodeQueue::NodeState::Failed;
+                    break;
+                }
+
+                auto task = [queue, i, data = ea::move(data), context = context_]()
+                { queue->ProcessNode(i, data, context); };
+                workQueue->PostTask(ea::move(task), TaskPriority::Low);
+            }
+        }
     }
     else
     {
@@ -616,7 +688,11 @@ bool Scene::LoadAsyncJSON(AbstractFilePtr file, LoadMode mode)
 
 void Scene::StopAsyncLoading()
 {
+    if (asyncProgress_.detachedNodes_)
+        asyncProgress_.detachedNodes_->CancelAndWait();
+
     asyncLoading_ = false;
+    asyncProgress_.detachedNodes_.Reset();
     asyncProgress_.file_.Reset();
     asyncProgress_.xmlFile_.Reset();
     asyncProgress_.jsonFile_.Reset();
@@ -1100,6 +1176,27 @@ void Scene::UpdateAsyncLoading()
             newNode->LoadJSON(childValue, resolver_);
             ++asyncProgress_.jsonIndex_;
         }
+        else if (asyncProgress_.detachedNodes_) // Add nodes deserialized in worker threads
+        {
+            DetachedNodeQueue& queue = *asyncProgress_.detachedNodes_;
+            const unsigned index = asyncProgress_.loadedNodes_;
+            const DetachedNodeQueue::NodeState state = queue.GetState(index);
+            if (state == DetachedNodeQueue::NodeState::Pending)
+                break;
+
+            if (state == DetachedNodeQueue::NodeState::Failed)
+            {
+                // Finish with the nodes loaded so far, same as when loading in the main thread
+                URHO3D_LOGERROR("Failed to load scene content from " + asyncProgress_.file_->GetName());
+                asyncProgress_.totalNodes_ = asyncProgress_.loadedNodes_;
+                continue;
+            }
+
+            const DetachedNodeData nodeData = ea::move(queue.nodes_[index]);
+            Node* newNode = CreateChild(nodeData.id_);
+            resolver_.AddNode(nodeData.id_, newNode);
+            newNode->LoadDetached(nodeData, resolver_);
+        }
         else // Load from binary
         {
             unsigned nodeID = asyncProgress_.file_->ReadUInt();
@@ -27,6 +27,7 @@
 #include "../Core/Mutex.h"
 #include "../Resource/JSONFile.h"
 #include "../Resource/XMLElement.h"
+#include "../Scene/DetachedNode.h"
 #include "../Scene/Node.h"
 #include "../Scene/SceneResolver.h"
 
@@ -72,6 +73,9 @@ struct AsyncProgress
     /// Current JSON child array and for JSON mode.
     unsigned jsonIndex_;
 
+    /// Root-level nodes deserialized in worker threads for threaded binary mode.
+    SharedPtr<DetachedNodeQueue> detachedNodes_;
+
     /// Current load mode.
     LoadMode mode_;
     /// Resource name hashes left to load.
@@ -157,7 +161,12 @@ public:
     bool SaveXML(Serializer& dest, const ea::string& indentation = "\t") const;
     /// Save to a JSON file. Return true if successful.
     bool SaveJSON(Serializer& dest, const ea::string& indentation = "\t") const;
+    /// Load from a cooked binary file. Cooked files are also recognized by Load. Return true if successful.
+    bool LoadCooked(Deserializer& source);
+    /// Save to a cooked binary file, which is faster to load but cannot be edited. Return true if successful.
+    bool SaveCooked(Serializer& dest) const;
     /// Load from a binary file asynchronously. Return true if started successfully. The LOAD_RESOURCES_ONLY mode can also be used to preload resources from object prefab files.
+    /// Child nodes are deserialized in worker threads if possible, only adding them to the scene takes time of the main thread.
     bool LoadAsync(AbstractFilePtr file, LoadMode mode = LOAD_SCENE_AND_RESOURCES);
     /// Load from an XML file asynchronously. Return true if started successfully. The LOAD_RESOURCES_ONLY mode can also be used to preload resources from object prefab files.
     bool LoadAsyncXML(AbstractFilePtr file, LoadMode mode = LOAD_SCENE_AND_RESOURCES);
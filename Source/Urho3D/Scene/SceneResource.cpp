@@ -26,6 +26,7 @@
 #include <Urho3D/IO/Log.h>
 #include <Urho3D/IO/MemoryBuffer.h>
 #include <Urho3D/IO/VirtualFileSystem.h>
+#include <Urho3D/Scene/CookedScene.h>
 #include <Urho3D/Scene/PrefabResource.h>
 #include <Urho3D/Scene/SceneResource.h>
 #include <Urho3D/Resource/BinaryFile.h>
@@ -124,6 +125,16 @@ bool SceneResource::BeginLoad(Deserializer& source)
     loadBinaryFile_ = nullptr;
     loadJsonFile_ = nullptr;
     loadXmlFile_ = nullptr;
+    isCooked_ = IsCookedScene(source);
+
+    if (isCooked_)
+    {
+        loadBinaryFile_ = MakeShared<BinaryFile>(context_);
+        loadBinaryFile_->Load(source);
+
+        loadFormat_ = InternalResourceFormat::Binary;
+        return true;
+    }
 
     const auto format = PeekResourceFormat(source, DefaultBinaryMagic);
     switch (format)
@@ -203,6 +214,13 @@ bool SceneResource::EndLoad()
             case InternalResourceFormat::Binary:
             {
                 MemoryBuffer readBuffer{loadBinaryFile_->GetData()};
+                if (isCooked_)
+                {
+                    if (!scene_->LoadCooked(readBuffer))
+                        throw ArchiveException("Cannot load Scene from cooked format");
+                    break;
+                }
+
                 readBuffer.SeekRelative(BinaryMagicSize);
 
                 BinaryInputArchive archive{GetContext(), readBuffer};
@@ -73,6 +73,7 @@ private:
 
     ea::optional<InternalResourceFormat> loadFormat_;
     bool isPrefab_{};
+    bool isCooked_{};
 
     SharedPtr<BinaryFile> loadBinaryFile_;
     SharedPtr<JSONFile> loadJsonFile_;
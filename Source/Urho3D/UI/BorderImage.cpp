@@ -78,12 +78,14 @@ void BorderImage::SetTexture(Texture* texture)
     texture_ = texture;
     if (imageRect_ == IntRect::ZERO)
         SetFullImageRect();
+    MarkBatchesDirty();
 }
 
 void BorderImage::SetImageRect(const IntRect& rect)
 {
     if (rect != IntRect::ZERO)
         imageRect_ = rect;
+    MarkBatchesDirty();
 }
 
 void BorderImage::SetFullImageRect()
@@ -98,6 +100,7 @@ void BorderImage::SetBorder(const IntRect& rect)
     border_.top_ = Max(rect.top_, 0);
     border_.right_ = Max(rect.right_, 0);
     border_.bottom_ = Max(rect.bottom_, 0);
+    MarkBatchesDirty();
 }
 
 void BorderImage::SetImageBorder(const IntRect& rect)
@@ -106,36 +109,43 @@ void BorderImage::SetImageBorder(const IntRect& rect)
     imageBorder_.top_ = Max(rect.top_, 0);
     imageBorder_.right_ = Max(rect.right_, 0);
     imageBorder_.bottom_ = Max(rect.bottom_, 0);
+    MarkBatchesDirty();
 }
 
 void BorderImage::SetHoverOffset(const IntVector2& offset)
 {
     hoverOffset_ = offset;
+    MarkBatchesDirty();
 }
 
 void BorderImage::SetHoverOffset(int x, int y)
 {
     hoverOffset_ = IntVector2(x, y);
+    MarkBatchesDirty();
 }
 
 void BorderImage::SetDisabledOffset(const IntVector2& offset)
 {
     disabledOffset_ = offset;
+    MarkBatchesDirty();
 }
 
 void BorderImage::SetDisabledOffset(int x, int y)
 {
     disabledOffset_ = IntVector2(x, y);
+    MarkBatchesDirty();
 }
 
 void BorderImage::SetBlendMode(BlendMode mode)
 {
     blendMode_ = mode;
+    MarkBatchesDirty();
 }
 
 void BorderImage::SetTiled(bool enable)
 {
     tiled_ = enable;
+    MarkBatchesDirty();
 }
 
 void BorderImage::GetBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData, const IntRect& currentScissor,
@@ -240,6 +250,7 @@ ResourceRef BorderImage::GetMaterialAttr() const
 void BorderImage::SetMaterial(Material* material)
 {
     material_ = material;
+    MarkBatchesDirty();
 }
 
 Material* BorderImage::GetMaterial() const
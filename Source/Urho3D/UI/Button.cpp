@@ -108,7 +108,7 @@ void Button::OnClickBegin(const IntVector2& position, const IntVector2& screenPo
     {
         SetPressed(true);
         repeatTimer_ = repeatDelay_;
-        hovering_ = true;
+        SetHovering(true);
 
         using namespace Pressed;
 
@@ -126,7 +126,7 @@ void Button::OnClickEnd(const IntVector2& position, const IntVector2& screenPosi
         SetPressed(false);
         // If mouse was released on top of the element, consider it hovering on this frame yet (see issue #1453)
         if (IsInside(screenPosition, true))
-            hovering_ = true;
+            SetHovering(true);
 
         using namespace Released;
 
@@ -155,11 +155,13 @@ void Button::OnKey(Key key, MouseButtonFlags buttons, QualifierFlags qualifiers)
 void Button::SetPressedOffset(const IntVector2& offset)
 {
     pressedOffset_ = offset;
+    MarkBatchesDirty();
 }
 
 void Button::SetPressedOffset(int x, int y)
 {
     pressedOffset_ = IntVector2(x, y);
+    MarkBatchesDirty();
 }
 
 void Button::SetPressedChildOffset(const IntVector2& offset)
@@ -192,6 +194,7 @@ void Button::SetPressed(bool enable)
 {
     pressed_ = enable;
     SetChildOffset(pressed_ ? pressedChildOffset_ : IntVector2::ZERO);
+    MarkBatchesDirty();
 }
 
 }
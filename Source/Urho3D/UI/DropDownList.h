@@ -47,6 +47,8 @@ public:
     void ApplyAttributes() override;
     /// Return UI rendering batches.
     void GetBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData, const IntRect& currentScissor) override;
+    /// Return whether batches may be cached. Selected item is rendered with its own hover state.
+    bool IsBatchCachingAllowed() const override { return false; }
     /// React to the popup being shown.
     void OnShowPopup() override;
     /// React to the popup being hidden.
@@ -64,6 +64,11 @@ const FontGlyph* FontFace::GetGlyph(unsigned c)
         return nullptr;
 }
 
+SharedPtr<TextLayout> FontFace::GetTextLayout(const ea::vector<unsigned>& text, int maxWidth, const TextLayout* previousLayout)
+{
+    return layoutCache_.GetLayout(this, text, maxWidth, previousLayout);
+}
+
 float FontFace::GetKerning(unsigned c, unsigned d) const
 {
     if (kerningMapping_.empty())
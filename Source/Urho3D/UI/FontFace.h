@@ -28,6 +28,7 @@
 
 #include "../Container/Ptr.h"
 #include "../Math/AreaAllocator.h"
+#include "../UI/TextLayout.h"
 
 namespace Urho3D
 {
@@ -81,6 +82,13 @@ public:
 
     /// Return if font face uses mutable glyphs.
     virtual bool HasMutableGlyphs() const { return false; }
+    /// Upload glyphs rasterized since last call to textures. Should be called before face textures are rendered.
+    virtual void ApplyTextureUpdates() {}
+
+    /// Return cached layout of the text. Previous layout is extended if the text was appended to it.
+    SharedPtr<TextLayout> GetTextLayout(const ea::vector<unsigned>& text, int maxWidth, const TextLayout* previousLayout = nullptr);
+    /// Return text layout cache.
+    const TextLayoutCache& GetTextLayoutCache() const { return layoutCache_; }
 
     /// Return the kerning for a character and the next character.
     float GetKerning(unsigned c, unsigned d) const;
@@ -115,6 +123,8 @@ protected:
     float pointSize_{};
     /// Row height.
     float rowHeight_{};
+    /// Text layout cache. Layouts reference glyphs of this face.
+    TextLayoutCache layoutCache_;
 };
 
 }
@@ -23,11 +23,13 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../Core/Profiler.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/Texture2D.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
 #include "../IO/MemoryBuffer.h"
+#include "../Resource/Image.h"
 #include "../UI/Font.h"
 #include "../UI/FontFaceFreeType.h"
 #include "../UI/UI.h"
@@ -213,6 +215,10 @@ bool FontFaceFreeType::Load(const unsigned char* fontData, unsigned fontDataSize
     textures_.push_back(texture);
     font_->SetMemoryUse(font_->GetMemoryUse() + textureWidth * textureHeight);
 
+    // Keep the page image to render glyphs loaded on demand
+    if (hasMutableGlyph_)
+        pageImage_ = image;
+
     // Store kerning if face has kerning information
     if (FT_HAS_KERNING(face))
     {
@@ -316,8 +322,26 @@ const FontGlyph* FontFaceFreeType::GetGlyph(unsigned c)
     return nullptr;
 }
 
+void FontFaceFreeType::ApplyTextureUpdates()
+{
+    if (!pageImage_ || dirtyMinY_ >= dirtyMaxY_)
+        return;
+
+    // Upload all modified rows at once instead of each glyph separately
+    URHO3D_PROFILE("UploadFontGlyphs");
+    const int width = pageImage_->GetWidth();
+    const unsigned char* data = pageImage_->GetData() + dirtyMinY_ * width;
+    textures_.back()->SetData(0, 0, dirtyMinY_, width, dirtyMaxY_ - dirtyMinY_, data);
+
+    dirtyMinY_ = M_MAX_INT;
+    dirtyMaxY_ = 0;
+}
+
 bool FontFaceFreeType::SetupNextTexture(int textureWidth, int textureHeight)
 {
+    // Current page will not be modified anymore
+    ApplyTextureUpdates();
+
     auto image = MakeShared<Image>(font_->GetContext());
     image->SetSize(textureWidth, textureHeight, 1);
     unsigned char* imageData = image->GetData();
@@ -328,6 +352,7 @@ bool FontFaceFreeType::SetupNextTexture(int textureWidth, int textureHeight)
         return false;
 
     textures_.push_back(texture);
+    pageImage_ = image;
     allocator_.Reset(FONT_TEXTURE_MIN_SIZE, FONT_TEXTURE_MIN_SIZE, textureWidth, textureHeight);
 
     font_->SetMemoryUse(font_->GetMemoryUse() + textureWidth * textureHeight);
@@ -472,13 +497,15 @@ bool FontFaceFreeType::LoadCharGlyph(unsigned charCode, Image* image)
         fontGlyph.x_ = (short)x;
         fontGlyph.y_ = (short)y;
 
+        // In mutable mode, glyphs are rendered into the page image and uploaded later in batch
+        Image* destImage = image ? image : pageImage_.Get();
         unsigned char* dest = nullptr;
         unsigned pitch = 0;
-        if (image)
+        if (destImage)
         {
-            fontGlyph.page_ = 0;
-            dest = image->GetData() + fontGlyph.y_ * image->GetWidth() + fontGlyph.x_;
-            pitch = (unsigned)image->GetWidth();
+            fontGlyph.page_ = image ? 0 : textures_.size() - 1;
+            dest = destImage->GetData() + fontGlyph.y_ * destImage->GetWidth() + fontGlyph.x_;
+            pitch = (unsigned)destImage->GetWidth();
         }
         else
         {
@@ -509,7 +536,12 @@ bool FontFaceFreeType::LoadCharGlyph(unsigned charCode, Image* image)
             }
         }
 
-        if (!image)
+        if (!image && destImage)
+        {
+            dirtyMinY_ = Min(dirtyMinY_, y);
+            dirtyMaxY_ = Max(dirtyMaxY_, y + fontGlyph.texHeight_);
+        }
+        else if (!destImage)
         {
             textures_.back()->SetData(0, fontGlyph.x_, fontGlyph.y_, fontGlyph.texWidth_, fontGlyph.texHeight_, dest);
             delete[] dest;
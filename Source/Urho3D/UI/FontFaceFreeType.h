@@ -46,6 +46,8 @@ public:
 
     /// Return if font face uses mutable glyphs.
     bool HasMutableGlyphs() const override { return hasMutableGlyph_; }
+    /// Upload glyphs rasterized since last call to the current texture page.
+    void ApplyTextureUpdates() override;
 
 private:
     /// Setup next texture.
@@ -71,6 +73,12 @@ private:
     bool hasMutableGlyph_{};
     /// Glyph area allocator.
     AreaAllocator allocator_;
+    /// CPU copy of the current texture page. Present only in mutable mode.
+    SharedPtr<Image> pageImage_;
+    /// Top row of the current texture page modified since last upload.
+    int dirtyMinY_{M_MAX_INT};
+    /// Bottom row of the current texture page modified since last upload, exclusive.
+    int dirtyMaxY_{};
 };
 
 }
@@ -22,9 +22,11 @@
 
 #include "../Precompiled.h"
 
+#include <EASTL/algorithm.h>
 #include <EASTL/sort.h>
 
 #include "../Core/Context.h"
+#include "../Core/Profiler.h"
 #include "../Input/InputEvents.h"
 #include "../IO/Log.h"
 #include "../UI/CheckBox.h"
@@ -264,6 +266,13 @@ void ListView::OnKey(Key key, MouseButtonFlags buttons, QualifierFlags qualifier
             // Fallthru
 
         case KEY_PAGEDOWN:
+            if (virtualMode_)
+            {
+                // All items have the same height, so the number of items per page is known
+                const int pageItems = Max(static_cast<int>(pageStep_ * scrollPanel_->GetHeight()) / virtualItemHeight_ - 1, 1);
+                delta = pageDirection * pageItems;
+            }
+            else
             {
                 // Convert page step to pixels and see how many items have to be skipped to reach that many pixels
                 if (selection == M_MAX_UNSIGNED)
@@ -327,6 +336,9 @@ void ListView::OnResize(const IntVector2& newSize, const IntVector2& delta)
     // When in hierarchy mode also need to resize the overlay container
     if (hierarchyMode_)
         overlayContainer_->SetSize(scrollPanel_->GetSize());
+
+    // When in virtual mode more rows may be needed to fill the view
+    UpdateVirtualRows();
 }
 
 void ListView::UpdateInternalLayout()
@@ -360,6 +372,12 @@ void ListView::InsertItem(unsigned index, UIElement* item, UIElement* parentItem
     if (!item || item->GetParent() == contentElement_)
         return;
 
+    if (virtualMode_)
+    {
+        URHO3D_LOGERROR("Can not insert items into ListView in virtual mode");
+        return;
+    }
+
     // Enable input so that clicking the item can be detected
     item->SetEnabled(true);
     item->SetSelected(false);
@@ -422,7 +440,7 @@ void ListView::InsertItem(unsigned index, UIElement* item, UIElement* parentItem
 
 void ListView::RemoveItem(UIElement* item, unsigned index)
 {
-    if (!item)
+    if (!item || virtualMode_)
         return;
 
     unsigned numItems = GetNumItems();
@@ -503,6 +521,12 @@ void ListView::RemoveItem(unsigned index)
 
 void ListView::RemoveAllItems()
 {
+    if (virtualMode_)
+    {
+        SetNumVirtualItems(0);
+        return;
+    }
+
     contentElement_->DisableLayoutUpdate();
 
     ClearSelection();
@@ -676,6 +700,14 @@ void ListView::ChangeSelection(int delta, bool additive)
 
     // If going downwards, use the last selection as a base. Otherwise use first
     unsigned selection = delta > 0 ? selections_.back() : selections_.front();
+
+    // Items can not be hidden in virtual mode, so there is no need to iterate them
+    if (virtualMode_ && !additive)
+    {
+        SetSelection(static_cast<unsigned>(Clamp(static_cast<long long>(selection) + delta, 0ll, static_cast<long long>(numItems) - 1)));
+        return;
+    }
+
     int direction = delta > 0 ? 1 : -1;
     unsigned newSelection = selection;
     unsigned okSelection = selection;
@@ -687,8 +719,8 @@ void ListView::ChangeSelection(int delta, bool additive)
         if (newSelection >= numItems)
             break;
 
-        UIElement* item = GetItem(newSelection);
-        if (item->IsVisible())
+        // Items can not be hidden in virtual mode
+        if (virtualMode_ || GetItem(newSelection)->IsVisible())
         {
             indices.push_back(okSelection = newSelection);
             delta -= direction;
@@ -722,6 +754,14 @@ void ListView::SetHierarchyMode(bool enable)
     if (enable == hierarchyMode_)
         return;
 
+    // Rows are removed together with the old container
+    virtualMode_ = false;
+    numVirtualItems_ = 0;
+    virtualRowFactory_ = nullptr;
+    virtualRowBinder_ = nullptr;
+    virtualRows_.clear();
+    virtualRowItems_.clear();
+
     hierarchyMode_ = enable;
     SharedPtr<UIElement> container;
     if (enable)
@@ -779,6 +819,85 @@ void ListView::SetSelectOnClickEnd(bool enable)
     }
 }
 
+void ListView::SetVirtualItems(unsigned numItems, int itemHeight, const ListViewRowFactory& factory, const ListViewRowBinder& binder)
+{
+    if (hierarchyMode_)
+    {
+        URHO3D_LOGERROR("Virtual mode is not supported for ListView in hierarchy mode");
+        return;
+    }
+
+    if (itemHeight <= 0 || !factory || !binder)
+    {
+        URHO3D_LOGERROR("Item height, row factory and row binder are required for ListView in virtual mode");
+        return;
+    }
+
+    if (virtualMode_)
+        ResetVirtualItems();
+    else
+        RemoveAllItems();
+
+    virtualMode_ = true;
+    virtualItemHeight_ = itemHeight;
+    virtualRowFactory_ = factory;
+    virtualRowBinder_ = binder;
+    firstVirtualItem_ = 0;
+
+    // Rows are positioned manually, so the content element only defines the scrollable area
+    contentElement_->SetLayoutMode(LM_FREE);
+    contentElement_->SetHeight(0);
+
+    SubscribeToEvent(this, E_VIEWCHANGED, [this] { UpdateVirtualRows(); });
+    SetNumVirtualItems(numItems);
+}
+
+void ListView::SetNumVirtualItems(unsigned numItems)
+{
+    if (!virtualMode_)
+        return;
+
+    // Deselect items that no longer exist
+    if (!selections_.empty() && selections_.back() >= numItems)
+    {
+        ea::vector<unsigned> indices = selections_;
+        indices.erase(ea::lower_bound(indices.begin(), indices.end(), numItems), indices.end());
+        SetSelections(indices);
+    }
+
+    // Resizing content may update rows on view change, so bound items are invalidated beforehand
+    numVirtualItems_ = numItems;
+    ea::fill(virtualRowItems_.begin(), virtualRowItems_.end(), M_MAX_UNSIGNED);
+    contentElement_->SetHeight(static_cast<int>(numItems) * virtualItemHeight_);
+    UpdateVirtualRows();
+}
+
+void ListView::RefreshVirtualItems()
+{
+    ea::fill(virtualRowItems_.begin(), virtualRowItems_.end(), M_MAX_UNSIGNED);
+    UpdateVirtualRows();
+}
+
+void ListView::ResetVirtualItems()
+{
+    if (!virtualMode_)
+        return;
+
+    ClearSelection();
+    UnsubscribeFromEvent(this, E_VIEWCHANGED);
+
+    virtualMode_ = false;
+    numVirtualItems_ = 0;
+    virtualRowFactory_ = nullptr;
+    virtualRowBinder_ = nullptr;
+    virtualRows_.clear();
+    virtualRowItems_.clear();
+
+    contentElement_->RemoveAllChildren();
+    contentElement_->SetLayoutMode(LM_VERTICAL);
+    contentElement_->UpdateLayout();
+}
+
 void ListView::Expand(unsigned index, bool enable, bool recursive)
 {
     if (!hierarchyMode_)
@@ -836,18 +955,37 @@ void ListView::ToggleExpand(unsigned index, bool recursive)
 
 unsigned ListView::GetNumItems() const
 {
-    return contentElement_->GetNumChildren();
+    return virtualMode_ ? numVirtualItems_ : contentElement_->GetNumChildren();
 }
 
 UIElement* ListView::GetItem(unsigned index) const
 {
+    if (virtualMode_)
+    {
+        if (index >= numVirtualItems_ || virtualRows_.empty())
+            return nullptr;
+
+        const unsigned rowIndex = index % virtualRows_.size();
+        return virtualRowItems_[rowIndex] == index ? virtualRows_[rowIndex].Get() : nullptr;
+    }
+
     return contentElement_->GetChild(index);
 }
 
 ea::vector<UIElement*> ListView::GetItems() const
 {
     ea::vector<UIElement*> items;
-    contentElement_->GetChildren(items);
+    if (virtualMode_)
+    {
+        const unsigned lastItem = ea::min(firstVirtualItem_ + virtualRows_.size(), numVirtualItems_);
+        for (unsigned index = firstVirtualItem_; index < lastItem; ++index)
+        {
+            if (UIElement* item = GetItem(index))
+                items.push_back(item);
+        }
+    }
+    else
+        contentElement_->GetChildren(items);
     return items;
 }
 
@@ -860,6 +998,16 @@ unsigned ListView::FindItem(UIElement* item) const
     if (item->GetParent() != contentElement_)
         return M_MAX_UNSIGNED;
 
+    if (virtualMode_)
+    {
+        for (unsigned i = 0; i < virtualRows_.size(); ++i)
+        {
+            if (virtualRows_[i] == item)
+                return virtualRowItems_[i];
+        }
+        return M_MAX_UNSIGNED;
+    }
+
     const ea::vector<SharedPtr<UIElement> >& children = contentElement_->GetChildren();
 
     // Binary search for list item based on screen coordinate Y
@@ -900,7 +1048,7 @@ unsigned ListView::GetSelection() const
 
 UIElement* ListView::GetSelectedItem() const
 {
-    return contentElement_->GetChild(GetSelection());
+    return GetItem(GetSelection());
 }
 
 ea::vector<UIElement*> ListView::GetSelectedItems() const
@@ -939,7 +1087,7 @@ bool ListView::IsSelected(unsigned index) const
 
 bool ListView::IsExpanded(unsigned index) const
 {
-    return GetItemExpanded(contentElement_->GetChild(index));
+    return GetItemExpanded(GetItem(index));
 }
 
 bool ListView::FilterImplicitAttributes(XMLElement& dest) const
@@ -987,6 +1135,13 @@ bool ListView::FilterImplicitAttributes(XMLElement& dest) const
 
 void ListView::UpdateSelectionEffect()
 {
+    if (virtualMode_)
+    {
+        for (unsigned i = 0; i < virtualRows_.size(); ++i)
+            virtualRows_[i]->SetSelected(virtualRowItems_[i] != M_MAX_UNSIGNED && IsSelectionHighlighted(virtualRowItems_[i]));
+        return;
+    }
+
     unsigned numItems = GetNumItems();
     bool highlighted = highlightMode_ == HM_ALWAYS || HasFocus();
 
@@ -1002,11 +1157,37 @@ void ListView::UpdateSelectionEffect()
 
 void ListView::EnsureItemVisibility(unsigned index)
 {
+    if (virtualMode_)
+    {
+        if (index >= numVirtualItems_)
+            return;
+
+        // Item may be not bound to any row yet, so the position is calculated from index
+        IntVector2 newView = GetViewPosition();
+        const int currentOffset = static_cast<int>(index) * virtualItemHeight_ - newView.y_;
+        const IntRect& clipBorder = scrollPanel_->GetClipBorder();
+        const int windowHeight = scrollPanel_->GetHeight() - clipBorder.top_ - clipBorder.bottom_;
+
+        if (currentOffset < 0)
+            newView.y_ += currentOffset;
+        if (currentOffset + virtualItemHeight_ > windowHeight)
+            newView.y_ += currentOffset + virtualItemHeight_ - windowHeight;
+
+        SetViewPosition(newView);
+        return;
+    }
+
     EnsureItemVisibility(GetItem(index));
 }
 
 void ListView::EnsureItemVisibility(UIElement* item)
 {
+    if (virtualMode_)
+    {
+        EnsureItemVisibility(FindItem(item));
+        return;
+    }
+
     if (!item || !item->IsVisible())
         return;
 
@@ -1170,4 +1351,71 @@ void ListView::UpdateUIClickSubscription()
     SubscribeToEvent(selectOnClickEnd_ ? E_UIMOUSECLICKEND : E_UIMOUSECLICK, URHO3D_HANDLER(ListView, HandleUIMouseClick));
 }
 
+void ListView::UpdateVirtualRows()
+{
+    if (!virtualMode_)
+        return;
+
+    URHO3D_PROFILE("UpdateVirtualListView");
+
+    // Create enough rows to cover the view even if it is scrolled by partial item
+    const IntRect& clipBorder = scrollPanel_->GetClipBorder();
+    const int windowHeight = Max(scrollPanel_->GetHeight() - clipBorder.top_ - clipBorder.bottom_, 0);
+    const unsigned numRowsNeeded = ea::min(static_cast<unsigned>(windowHeight / virtualItemHeight_ + 2), numVirtualItems_);
+    while (virtualRows_.size() < numRowsNeeded)
+    {
+        SharedPtr<UIElement> row = virtualRowFactory_();
+        if (!row)
+        {
+            URHO3D_LOGERROR("Row factory of ListView has returned null");
+            break;
+        }
+
+        // Enable input so that clicking the row can be detected
+        row->SetTemporary(true);
+        row->SetEnabled(true);
+        row->SetVisible(false);
+        contentElement_->AddChild(row);
+        virtualRows_.push_back(row);
+        virtualRowItems_.push_back(M_MAX_UNSIGNED);
+    }
+
+    const unsigned numRows = virtualRows_.size();
+    if (numRows == 0)
+        return;
+
+    // Only rows that are bound to items no longer in view are rebound, so scrolling cost does not depend on number of items
+    const unsigned maxFirstItem = numVirtualItems_ > numRows ? numVirtualItems_ - numRows : 0;
+    firstVirtualItem_ = ea::min(static_cast<unsigned>(GetViewPosition().y_ / virtualItemHeight_), maxFirstItem);
+    const int rowWidth = contentElement_->GetWidth();
+    for (unsigned i = 0; i < numRows; ++i)
+    {
+        UIElement* row = virtualRows_[i];
+        const unsigned index = firstVirtualItem_ + (i + numRows - firstVirtualItem_ % numRows) % numRows;
+        if (index >= numVirtualItems_)
+        {
+            virtualRowItems_[i] = M_MAX_UNSIGNED;
+            row->SetVisible(false);
+            continue;
+        }
+
+        row->SetSize(rowWidth, virtualItemHeight_);
+        if (virtualRowItems_[i] != index)
+        {
+            virtualRowItems_[i] = index;
+            row->SetPosition(0, static_cast<int>(index) * virtualItemHeight_);
+            row->SetVisible(true);
+            row->SetSelected(IsSelectionHighlighted(index));
+            virtualRowBinder_(row, index);
+        }
+    }
+}
+
+bool ListView::IsSelectionHighlighted(unsigned index) const
+{
+    if (highlightMode_ == HM_NEVER || (highlightMode_ == HM_FOCUS && !HasFocus()))
+        return false;
+    return selections_.contains(index);
+}
+
 }
@@ -27,6 +27,8 @@
 #include "../Input/InputConstants.h"
 #include "../UI/ScrollView.h"
 
+#include <EASTL/functional.h>
+
 namespace Urho3D
 {
 
@@ -41,6 +43,11 @@ enum HighlightMode
     HM_ALWAYS
 };
 
+/// Callback that creates row element for %ListView in virtual mode.
+using ListViewRowFactory = ea::function<SharedPtr<UIElement>()>;
+/// Callback that fills row element with data of item at index for %ListView in virtual mode.
+using ListViewRowBinder = ea::function<void(UIElement* row, unsigned index)>;
+
 /// Scrollable list %UI element.
 class URHO3D_API ListView : public ScrollView
 {
@@ -115,6 +122,17 @@ public:
     /// @property
     void SetSelectOnClickEnd(bool enable);
 
+    /// \brief Enable virtual mode. Items are not stored as elements: only the rows that fit into the view are created by the factory
+    /// and reused for different items on scroll, the binder fills a row with data of an item at given index.
+    /// All items have the same height. Hierarchy mode is not supported. Existing items are removed.
+    void SetVirtualItems(unsigned numItems, int itemHeight, const ListViewRowFactory& factory, const ListViewRowBinder& binder);
+    /// Set number of items in virtual mode. Selection of removed items is cleared.
+    void SetNumVirtualItems(unsigned numItems);
+    /// Rebind all rows in virtual mode, e.g. when data of items is changed.
+    void RefreshVirtualItems();
+    /// Disable virtual mode and remove all rows.
+    void ResetVirtualItems();
+
     /// Expand item at index. Only has effect in hierarchy mode.
     void Expand(unsigned index, bool enable, bool recursive = false);
     /// Toggle item's expanded flag at index. Only has effect in hierarchy mode.
@@ -123,10 +141,10 @@ public:
     /// Return number of items.
     /// @property
     unsigned GetNumItems() const;
-    /// Return item at index.
+    /// Return item at index. In virtual mode, only items that are currently bound to rows are returned.
     /// @property{get_items}
     UIElement* GetItem(unsigned index) const;
-    /// Return all items.
+    /// Return all items. In virtual mode, only items that are currently bound to rows are returned.
     ea::vector<UIElement*> GetItems() const;
     /// Return index of item, or M_MAX_UNSIGNED If not found.
     unsigned FindItem(UIElement* item) const;
@@ -175,6 +193,13 @@ public:
     /// @property
     int GetBaseIndent() const { return baseIndent_; }
 
+    /// Return whether virtual mode enabled.
+    bool IsVirtual() const { return virtualMode_; }
+    /// Return item height in virtual mode.
+    int GetVirtualItemHeight() const { return virtualItemHeight_; }
+    /// Return number of row elements created in virtual mode.
+    unsigned GetNumVirtualRows() const { return virtualRows_.size(); }
+
     /// Ensure full visibility of the item.
     void EnsureItemVisibility(unsigned index);
     /// Ensure full visibility of the item.
@@ -202,6 +227,22 @@ protected:
     bool clearSelectionOnDefocus_;
     /// React to click end instead of click start flag.
     bool selectOnClickEnd_;
+    /// Virtual mode flag.
+    bool virtualMode_{};
+    /// Number of items in virtual mode.
+    unsigned numVirtualItems_{};
+    /// Height of each item in virtual mode.
+    int virtualItemHeight_{};
+    /// Row factory in virtual mode.
+    ListViewRowFactory virtualRowFactory_;
+    /// Row binder in virtual mode.
+    ListViewRowBinder virtualRowBinder_;
+    /// Row elements in virtual mode. Item at index is always bound to row at index modulo number of rows.
+    ea::vector<SharedPtr<UIElement>> virtualRows_;
+    /// Item index bound to each row in virtual mode, or M_MAX_UNSIGNED if none.
+    ea::vector<unsigned> virtualRowItems_;
+    /// First item bound to row in virtual mode.
+    unsigned firstVirtualItem_{};
 
 private:
     /// Handle global UI mouseclick to check for selection change.
@@ -214,6 +255,10 @@ private:
     void HandleFocusChanged(StringHash eventType, VariantMap& eventData);
     /// Update subscription to UI click events.
     void UpdateUIClickSubscription();
+    /// Create missing rows and bind them to the items in view. Only has effect in virtual mode.
+    void UpdateVirtualRows();
+    /// Return whether item at index should be displayed as selected.
+    bool IsSelectionHighlighted(unsigned index) const;
 };
 
 }
@@ -327,7 +327,7 @@ void Menu::ShowPopup(bool enable)
     SetVar(VAR_SHOW_POPUP, enable);
 
     showPopup_ = enable;
-    selected_ = enable;
+    SetSelected(enable);
 }
 
 void Menu::SetAccelerator(int key, int qualifiers)
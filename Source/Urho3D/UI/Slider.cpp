@@ -72,7 +72,7 @@ void Slider::RegisterObject(Context* context)
 void Slider::Update(float timeStep)
 {
     if (dragSlider_)
-        hovering_ = true;
+        SetHovering(true);
 
     // Propagate hover effect to the slider knob
     knob_->SetHovering(hovering_);
@@ -84,7 +84,7 @@ void Slider::OnHover(const IntVector2& position, const IntVector2& screenPositio
     BorderImage::OnHover(position, screenPosition, buttons, qualifiers, cursor);
 
     // Show hover effect if inside the slider knob
-    hovering_ = knob_->IsInside(screenPosition, true);
+    SetHovering(knob_->IsInside(screenPosition, true));
 
     // If not hovering on the knob, send it as page event
     if (!hovering_)
@@ -94,8 +94,8 @@ void Slider::OnHover(const IntVector2& position, const IntVector2& screenPositio
 void Slider::OnClickBegin(const IntVector2& position, const IntVector2& screenPosition, MouseButton button, MouseButtonFlags buttons, QualifierFlags qualifiers,
     Cursor* cursor)
 {
-    selected_ = true;
-    hovering_ = knob_->IsInside(screenPosition, true);
+    SetSelected(true);
+    SetHovering(knob_->IsInside(screenPosition, true));
     if (!hovering_ && button == MOUSEB_LEFT)
         Page(position, true);
 }
@@ -103,7 +103,7 @@ void Slider::OnClickBegin(const IntVector2& position, const IntVector2& screenPo
 void Slider::OnClickEnd(const IntVector2& position, const IntVector2& screenPosition, MouseButton button, MouseButtonFlags buttons, QualifierFlags qualifiers,
     Cursor* cursor, UIElement* beginElement)
 {
-    hovering_ = knob_->IsInside(screenPosition, true);
+    SetHovering(knob_->IsInside(screenPosition, true));
     if (!hovering_ && button == MOUSEB_LEFT)
         Page(position, false);
 }
@@ -152,7 +152,7 @@ void Slider::OnDragEnd(const IntVector2& position, const IntVector2& screenPosit
     if (dragButtons == MOUSEB_LEFT)
     {
         dragSlider_ = false;
-        selected_ = false;
+        SetSelected(false);
     }
 }
 
@@ -134,6 +134,8 @@ void Text::GetBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexDat
         for (unsigned i = 0; i < printText_.size(); ++i)
             face->GetGlyph(printText_[i]);
     }
+    // Upload glyphs rasterized since last frame
+    face->ApplyTextureUpdates();
 
     // Hovering and/or whole selection batch
     UISelectable::GetBatches(batches, vertexData, currentScissor);
@@ -236,6 +238,11 @@ void Text::GetBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexDat
     }
 }
 
+bool Text::IsBatchCachingAllowed() const
+{
+    return !fontFace_ || !fontFace_->HasMutableGlyphs();
+}
+
 void Text::OnResize(const IntVector2& newSize, const IntVector2& delta)
 {
     if (wordWrap_)
@@ -265,7 +272,7 @@ bool Text::SetFont(Font* font, float size)
 
     if (font != font_ || size != fontSize_)
     {
-        font_ = font;
+        SetFontInternal(font);
         fontSize_ = Max(size, 1);
         UpdateText();
     }
@@ -313,6 +320,7 @@ void Text::SetTextAlignment(HorizontalAlignment align)
     {
         textAlignment_ = align;
         charLocationsDirty_ = true;
+        MarkBatchesDirty();
     }
 }
 
@@ -358,6 +366,18 @@ void Text::SetAutoLocalizable(bool enable)
     }
 }
 
+void Text::SetFontInternal(Font* font)
+{
+    if (font_)
+        UnsubscribeFromEvent(font_, E_RELOADFINISHED);
+
+    font_ = font;
+
+    // Cached batches refer to textures of font faces that are released on reload
+    if (font_)
+        SubscribeToEvent(font_, E_RELOADFINISHED, [this] { MarkBatchesDirty(); });
+}
+
 void Text::HandleChangeLanguage(StringHash eventType, VariantMap& eventData)
 {
     auto* l10n = GetSubsystem<Localization>();
@@ -372,42 +392,50 @@ void Text::SetSelection(unsigned start, unsigned length)
     selectionStart_ = start;
     selectionLength_ = length;
     ValidateSelection();
+    MarkBatchesDirty();
 }
 
 void Text::ClearSelection()
 {
     selectionStart_ = 0;
     selectionLength_ = 0;
+    MarkBatchesDirty();
 }
 
 void Text::SetTextEffect(TextEffect textEffect)
 {
     textEffect_ = textEffect;
+    MarkBatchesDirty();
 }
 
 void Text::SetEffectShadowOffset(const IntVector2& offset)
 {
     shadowOffset_ = offset;
+    MarkBatchesDirty();
 }
 
 void Text::SetEffectStrokeThickness(int thickness)
 {
     strokeThickness_ = Abs(thickness);
+    MarkBatchesDirty();
 }
 
 void Text::SetEffectRoundStroke(bool roundStroke)
 {
     roundStroke_ = roundStroke;
+    MarkBatchesDirty();
 }
 
 void Text::SetEffectColor(const Color& effectColor)
 {
     effectColor_ = effectColor;
+    MarkBatchesDirty();
 }
 
 void Text::SetEffectDepthBias(float bias)
 {
     effectDepthBias_ = bias;
+    MarkBatchesDirty();
 }
 
 float Text::GetRowWidth(unsigned index) const
@@ -442,7 +470,7 @@ Vector2 Text::GetCharSize(unsigned index)
 void Text::SetFontAttr(const ResourceRef& value)
 {
     auto* cache = GetSubsystem<ResourceCache>();
-    font_ = cache->GetResource<Font>(value.name_);
+    SetFontInternal(cache->GetResource<Font>(value.name_));
 }
 
 ResourceRef Text::GetFontAttr() const
@@ -485,6 +513,7 @@ bool Text::FilterImplicitAttributes(XMLElement& dest) const
 
 void Text::UpdateText(bool onResize)
 {
+    MarkBatchesDirty();
     rowWidths_.clear();
     printText_.clear();
 
@@ -496,149 +525,16 @@ void Text::UpdateText(bool onResize)
 
         rowHeight_ = face->GetRowHeight();
 
-        int width = 0;
-        int height = 0;
-        int rowWidth = 0;
         auto rowHeight = RoundToInt(rowSpacing_ * rowHeight_);
 
-        // First see if the text must be split up
-        if (!wordWrap_)
-        {
-            printText_ = unicodeText_;
-            printToText_.resize(printText_.size());
-            for (unsigned i = 0; i < printText_.size(); ++i)
-                printToText_[i] = i;
-        }
-        else
-        {
-            int maxWidth = GetWidth();
-            unsigned nextBreak = 0;
-            unsigned lineStart = 0;
-            printToText_.clear();
-
-            for (unsigned i = 0; i < unicodeText_.size(); ++i)
-            {
-                unsigned j;
-                unsigned c = unicodeText_[i];
+        // Reuse cached layout if possible, or extend previous layout if text was appended
+        layout_ = face->GetTextLayout(unicodeText_, wordWrap_ ? GetWidth() : M_MAX_INT, layout_);
+        printText_ = layout_->printText_;
+        printToText_ = layout_->printToText_;
+        layout_->GetRowWidths(rowWidths_);
 
-                if (c != '\n')
-                {
-                    bool ok = true;
-
-                    if (nextBreak <= i)
-                    {
-                        int futureRowWidth = rowWidth;
-                        for (j = i; j < unicodeText_.size(); ++j)
-                        {
-                            unsigned d = unicodeText_[j];
-                            if (d == ' ' || d == '\n')
-                            {
-                                nextBreak = j;
-                                break;
-                            }
-                            const FontGlyph* glyph = face->GetGlyph(d);
-                            if (glyph)
-                            {
-                                futureRowWidth += glyph->advanceX_;
-                                if (j < unicodeText_.size() - 1)
-                                    futureRowWidth += face->GetKerning(d, unicodeText_[j + 1]);
-                            }
-                            if (d == '-' && futureRowWidth <= maxWidth)
-                            {
-                                nextBreak = j + 1;
-                                break;
-                            }
-                            if (futureRowWidth > maxWidth)
-                            {
-                                ok = false;
-                                break;
-                            }
-                        }
-                    }
-
-                    if (!ok)
-                    {
-                        // If did not find any breaks on the line, copy until j, or at least 1 char, to prevent infinite loop
-                        if (nextBreak == lineStart)
-                        {
-                            while (i < j)
-                            {
-                                printText_.push_back(unicodeText_[i]);
-                                printToText_.push_back(i);
-                                ++i;
-                            }
-                        }
-                        // Eliminate spaces that have been copied before the forced break
-                        while (printText_.size() && printText_.back() == ' ')
-                        {
-                            printText_.pop_back();
-                            printToText_.pop_back();
-                        }
-                        printText_.push_back('\n');
-                        printToText_.push_back(Min(i, unicodeText_.size() - 1));
-                        rowWidth = 0;
-                        nextBreak = lineStart = i;
-                    }
-
-                    if (i < unicodeText_.size())
-                    {
-                        // When copying a space, position is allowed to be over row width
-                        c = unicodeText_[i];
-                        const FontGlyph* glyph = face->GetGlyph(c);
-                        if (glyph)
-                        {
-                            rowWidth += glyph->advanceX_;
-                            if (i < unicodeText_.size() - 1)
-                                rowWidth += face->GetKerning(c, unicodeText_[i + 1]);
-                        }
-                        if (rowWidth <= maxWidth)
-                        {
-                            printText_.push_back(c);
-                            printToText_.push_back(i);
-                        }
-                    }
-                }
-                else
-                {
-                    printText_.push_back('\n');
-                    printToText_.push_back(Min(i, unicodeText_.size() - 1));
-                    rowWidth = 0;
-                    nextBreak = lineStart = i;
-                }
-            }
-        }
-
-        rowWidth = 0;
-
-        for (unsigned i = 0; i < printText_.size(); ++i)
-        {
-            unsigned c = printText_[i];
-
-            if (c != '\n')
-            {
-                const FontGlyph* glyph = face->GetGlyph(c);
-                if (glyph)
-                {
-                    rowWidth += glyph->advanceX_;
-                    if (i < printText_.size() - 1)
-                        rowWidth += face->GetKerning(c, printText_[i + 1]);
-                }
-            }
-            else
-            {
-                width = Max(width, rowWidth);
-                height += rowHeight;
-                rowWidths_.push_back(rowWidth);
-                rowWidth = 0;
-            }
-        }
-
-        if (rowWidth)
-        {
-            width = Max(width, rowWidth);
-            height += rowHeight;
-            rowWidths_.push_back(rowWidth);
-        }
+        const int width = layout_->width_;
+        int height = static_cast<int>(rowWidths_.size()) * rowHeight;
 
         // Set at least one row height even if text is empty
         if (!height)
@@ -683,6 +579,15 @@ void Text::UpdateCharLocations()
         return;
     fontFace_ = face;
 
+    // Layout glyphs belong to the face, so reacquire the layout if the face has changed
+    if (!layout_ || layout_->GetFace() != face)
+    {
+        layout_ = face->GetTextLayout(unicodeText_, wordWrap_ ? GetWidth() : M_MAX_INT);
+        printText_ = layout_->printText_;
+        printToText_ = layout_->printToText_;
+        layout_->GetRowWidths(rowWidths_);
+    }
+
     auto rowHeight = RoundToInt(rowSpacing_ * rowHeight_);
 
     // Store position & size of each character, and locations per texture page
@@ -707,7 +612,7 @@ void Text::UpdateCharLocations()
         unsigned c = printText_[i];
         if (c != '\n')
         {
-            const FontGlyph* glyph = face->GetGlyph(c);
+            const FontGlyph* glyph = layout_->glyphs_[i];
             loc.size_ = Vector2(glyph ? glyph->advanceX_ : 0, rowHeight_);
             if (glyph)
             {
@@ -715,8 +620,7 @@ void Text::UpdateCharLocations()
                 if (glyph->page_ < pageGlyphLocations_.size())
                     pageGlyphLocations_[glyph->page_].push_back(GlyphLocation(x, y, glyph));
                 x += glyph->advanceX_;
-                if (i < printText_.size() - 1)
-                    x += face->GetKerning(c, printText_[i + 1]);
+                x += layout_->kernings_[i];
             }
         }
         else
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "../UI/TextLayout.h"
 #include "../UI/UISelectable.h"
 
 namespace Urho3D
@@ -92,6 +93,8 @@ public:
     void ApplyAttributes() override;
     /// Return UI rendering batches.
     void GetBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData, const IntRect& currentScissor) override;
+    /// Return whether batches may be cached. Mutable glyphs may be moved in the font texture at any time.
+    bool IsBatchCachingAllowed() const override;
     /// React to resize.
     void OnResize(const IntVector2& newSize, const IntVector2& delta) override;
     /// React to indent change.
@@ -252,6 +255,8 @@ protected:
     SharedPtr<Font> font_;
     /// Current face.
     WeakPtr<FontFace> fontFace_;
+    /// Cached layout of the text.
+    SharedPtr<TextLayout> layout_;
     /// Font size.
     float fontSize_;
     /// UTF-8 encoded text.
@@ -300,6 +305,8 @@ protected:
     ea::string stringId_;
     /// Handle change Language.
     void HandleChangeLanguage(StringHash eventType, VariantMap& eventData);
+    /// Set font and subscribe to its reload.
+    void SetFontInternal(Font* font);
     /// UTF8 to Unicode.
     void DecodeToUnicode();
 };
@@ -0,0 +1,301 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../Precompiled.h"
+
+#include "../UI/TextLayout.h"
+
+#include "../Container/Hash.h"
+#include "../UI/FontFace.h"
+
+#include <EASTL/algorithm.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+TextLayout::TextLayout() = default;
+
+TextLayout::~TextLayout() = default;
+
+void TextLayout::Calculate(FontFace* face, const ea::vector<unsigned>& text, int maxWidth)
+{
+    face_ = face;
+    maxWidth_ = maxWidth;
+    text_ = text;
+
+    printText_.clear();
+    printToText_.clear();
+    glyphs_.clear();
+    kernings_.clear();
+    rowWidths_.clear();
+
+    CalculateFrom(0);
+}
+
+void TextLayout::Append(const TextLayout& baseLayout, const ea::vector<unsigned>& text)
+{
+    face_ = baseLayout.face_;
+    maxWidth_ = baseLayout.maxWidth_;
+    text_ = text;
+
+    // Find the last line break of the source text, everything before it does not depend on the appended text
+    const ea::vector<unsigned>& basePrintText = baseLayout.printText_;
+    const ea::vector<unsigned>& basePrintToText = baseLayout.printToText_;
+    unsigned printStart = basePrintText.size();
+    while (printStart > 0)
+    {
+        const unsigned index = printStart - 1;
+        if (basePrintText[index] == '\n' && baseLayout.text_[basePrintToText[index]] == '\n')
+            break;
+        --printStart;
+    }
+
+    unsigned numRemovedRows = 0;
+    for (unsigned i = printStart; i < basePrintText.size(); ++i)
+    {
+        if (basePrintText[i] == '\n')
+            ++numRemovedRows;
+    }
+
+    printText_.assign(basePrintText.begin(), basePrintText.begin() + printStart);
+    printToText_.assign(basePrintToText.begin(), basePrintToText.begin() + printStart);
+    glyphs_.assign(baseLayout.glyphs_.begin(), baseLayout.glyphs_.begin() + printStart);
+    kernings_.assign(baseLayout.kernings_.begin(), baseLayout.kernings_.begin() + printStart);
+    rowWidths_.assign(baseLayout.rowWidths_.begin(), baseLayout.rowWidths_.end() - numRemovedRows);
+
+    CalculateFrom(printStart > 0 ? printToText_[printStart - 1] + 1 : 0);
+}
+
+bool TextLayout::CanAppend(FontFace* face, const ea::vector<unsigned>& text, int maxWidth) const
+{
+    return face && face_ == face && maxWidth_ == maxWidth && text.size() > text_.size()
+        && ea::equal(text_.begin(), text_.end(), text.begin());
+}
+
+void TextLayout::GetRowWidths(ea::vector<float>& rowWidths) const
+{
+    rowWidths = rowWidths_;
+    if (lastRowWidth_)
+        rowWidths.push_back(lastRowWidth_);
+}
+
+void TextLayout::CalculateFrom(unsigned textStart)
+{
+    FontFace* face = face_;
+    const unsigned printStart = printText_.size();
+
+    // First see if the text must be split up
+    if (maxWidth_ == M_MAX_INT)
+    {
+        for (unsigned i = textStart; i < text_.size(); ++i)
+        {
+            printText_.push_back(text_[i]);
+            printToText_.push_back(i);
+        }
+    }
+    else
+    {
+        // Word wrap state is reset at line breaks, so the layout may be resumed after one
+        int rowWidth = 0;
+        unsigned nextBreak = textStart > 0 ? textStart - 1 : 0;
+        unsigned lineStart = nextBreak;
+
+        for (unsigned i = textStart; i < text_.size(); ++i)
+        {
+            unsigned j;
+            unsigned c = text_[i];
+
+            if (c != '\n')
+            {
+                bool ok = true;
+
+                if (nextBreak <= i)
+                {
+                    int futureRowWidth = rowWidth;
+                    for (j = i; j < text_.size(); ++j)
+                    {
+                        unsigned d = text_[j];
+                        if (d == ' ' || d == '\n')
+                        {
+                            nextBreak = j;
+                            break;
+                        }
+                        const FontGlyph* glyph = face->GetGlyph(d);
+                        if (glyph)
+                        {
+                            futureRowWidth += glyph->advanceX_;
+                            if (j < text_.size() - 1)
+                                futureRowWidth += face->GetKerning(d, text_[j + 1]);
+                        }
+                        if (d == '-' && futureRowWidth <= maxWidth_)
+                        {
+                            nextBreak = j + 1;
+                            break;
+                        }
+                        if (futureRowWidth > maxWidth_)
+                        {
+                            ok = false;
+                            break;
+                        }
+                    }
+                }
+
+                if (!ok)
+                {
+                    // If did not find any breaks on the line, copy until j, or at least 1 char, to prevent infinite loop
+                    if (nextBreak == lineStart)
+                    {
+                        while (i < j)
+                        {
+                            printText_.push_back(text_[i]);
+                            printToText_.push_back(i);
+                            ++i;
+                        }
+                    }
+                    // Eliminate spaces that have been copied before the forced break
+                    while (printText_.size() > printStart && printText_.back() == ' ')
+                    {
+                        printText_.pop_back();
+                        printToText_.pop_back();
+                    }
+                    printText_.push_back('\n');
+                    printToText_.push_back(Min(i, text_.size() - 1));
+                    rowWidth = 0;
+                    nextBreak = lineStart = i;
+                }
+
+                if (i < text_.size())
+                {
+                    // When copying a space, position is allowed to be over row width
+                    c = text_[i];
+                    const FontGlyph* glyph = face->GetGlyph(c);
+                    if (glyph)
+                    {
+                        rowWidth += glyph->advanceX_;
+                        if (i < text_.size() - 1)
+                            rowWidth += face->GetKerning(c, text_[i + 1]);
+                    }
+                    if (rowWidth <= maxWidth_)
+                    {
+                        printText_.push_back(c);
+                        printToText_.push_back(i);
+                    }
+                }
+            }
+            else
+            {
+                printText_.push_back('\n');
+                printToText_.push_back(Min(i, text_.size() - 1));
+                rowWidth = 0;
+                nextBreak = lineStart = i;
+            }
+        }
+    }
+
+    // Then measure rows and remember glyphs
+    int rowWidth = 0;
+    for (unsigned i = printStart; i < printText_.size(); ++i)
+    {
+        const unsigned c = printText_[i];
+        const FontGlyph* glyph = nullptr;
+        float kerning = 0.0f;
+
+        if (c != '\n')
+        {
+            glyph = face->GetGlyph(c);
+            if (glyph)
+            {
+                rowWidth += glyph->advanceX_;
+                if (i < printText_.size() - 1)
+                {
+                    kerning = face->GetKerning(c, printText_[i + 1]);
+                    rowWidth += kerning;
+                }
+            }
+        }
+        else
+        {
+            rowWidths_.push_back(rowWidth);
+            rowWidth = 0;
+        }
+
+        glyphs_.push_back(glyph);
+        kernings_.push_back(kerning);
+    }
+    lastRowWidth_ = rowWidth;
+
+    width_ = 0;
+    for (const float width : rowWidths_)
+        width_ = Max(width_, static_cast<int>(width));
+    if (lastRowWidth_)
+        width_ = Max(width_, lastRowWidth_);
+}
+
+TextLayoutCache::TextLayoutCache(unsigned maxCharacters)
+    : maxCharacters_(maxCharacters)
+{
+}
+
+SharedPtr<TextLayout> TextLayoutCache::GetLayout(
+    FontFace* face, const ea::vector<unsigned>& text, int maxWidth, const TextLayout* previousLayout)
+{
+    unsigned hash = MakeHash(maxWidth);
+    for (const unsigned c : text)
+        CombineHash(hash, c);
+
+    const auto iter = layoutsByHash_.find(hash);
+    if (iter != layoutsByHash_.end())
+    {
+        const LayoutList::iterator layoutIter = iter->second;
+        TextLayout* layout = layoutIter->second;
+        if (layout->maxWidth_ == maxWidth && layout->text_ == text)
+        {
+            ++numHits_;
+            layouts_.splice(layouts_.begin(), layouts_, layoutIter);
+            return layoutIter->second;
+        }
+
+        // Replace layout on hash collision
+        numCharacters_ -= layout->text_.size();
+        layouts_.erase(layoutIter);
+        layoutsByHash_.erase(iter);
+    }
+
+    auto layout = MakeShared<TextLayout>();
+    if (previousLayout && previousLayout->CanAppend(face, text, maxWidth))
+    {
+        layout->Append(*previousLayout, text);
+        ++numAppends_;
+    }
+    else
+    {
+        layout->Calculate(face, text, maxWidth);
+        ++numMisses_;
+    }
+
+    layouts_.emplace_front(hash, layout);
+    layoutsByHash_[hash] = layouts_.begin();
+    numCharacters_ += text.size();
+
+    // Evict the least recently used layouts
+    while (numCharacters_ > maxCharacters_ && layouts_.size() > 1)
+    {
+        numCharacters_ -= layouts_.back().second->text_.size();
+        layoutsByHash_.erase(layouts_.back().first);
+        layouts_.pop_back();
+    }
+
+    return layout;
+}
+
+void TextLayoutCache::Clear()
+{
+    layouts_.clear();
+    layoutsByHash_.clear();
+    numCharacters_ = 0;
+}
+
+}
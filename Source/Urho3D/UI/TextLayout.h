@@ -0,0 +1,117 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+/// \file
+
+#pragma once
+
+#include "../Container/Ptr.h"
+#include "../Math/MathDefs.h"
+
+#include <EASTL/list.h>
+#include <EASTL/unordered_map.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class FontFace;
+struct FontGlyph;
+
+/// Default max total number of characters in text layouts cached per font face.
+static const unsigned DEFAULT_TEXT_LAYOUT_CACHE_CHARACTERS = 64 * 1024;
+
+/// Layout of text rendered with specific font face. Does not depend on text alignment.
+class URHO3D_API TextLayout : public RefCounted
+{
+public:
+    /// Construct.
+    TextLayout();
+    /// Destruct.
+    ~TextLayout() override;
+
+    /// Calculate layout from scratch. Word wrap is disabled if max width is M_MAX_INT.
+    void Calculate(FontFace* face, const ea::vector<unsigned>& text, int maxWidth);
+    /// Calculate layout for the text that starts with the text of base layout.
+    /// Only the part after the last line break of base text is laid out again.
+    void Append(const TextLayout& baseLayout, const ea::vector<unsigned>& text);
+
+    /// Return whether the layout was calculated for given face and max width and may be extended to given text.
+    bool CanAppend(FontFace* face, const ea::vector<unsigned>& text, int maxWidth) const;
+    /// Return font face of the layout.
+    FontFace* GetFace() const { return face_; }
+    /// Return row widths, including the last row if it's not empty.
+    void GetRowWidths(ea::vector<float>& rowWidths) const;
+
+    /// Source text.
+    ea::vector<unsigned> text_;
+    /// Max row width, or M_MAX_INT if word wrap is disabled.
+    int maxWidth_{M_MAX_INT};
+    /// Text to print, with line breaks inserted by word wrap.
+    ea::vector<unsigned> printText_;
+    /// Index of source character for each printed character.
+    ea::vector<unsigned> printToText_;
+    /// Glyph for each printed character, null for missing glyphs and line breaks.
+    ea::vector<const FontGlyph*> glyphs_;
+    /// Kerning between each printed character and the next one.
+    ea::vector<float> kernings_;
+    /// Widths of rows terminated by line break.
+    ea::vector<float> rowWidths_;
+    /// Width of the last row that is not terminated by line break.
+    int lastRowWidth_{};
+    /// Max width of all rows.
+    int width_{};
+
+private:
+    /// Lay out source text starting from given index. Source character at previous index should be line break, if any.
+    void CalculateFrom(unsigned textStart);
+
+    /// Font face.
+    WeakPtr<FontFace> face_;
+};
+
+/// LRU cache of text layouts for single font face. Bounded by total length of cached text,
+/// so that long texts growing by appending don't keep many large layouts alive.
+class URHO3D_API TextLayoutCache
+{
+public:
+    /// Construct. The most recently used layout is kept even if it's longer than max number of characters.
+    explicit TextLayoutCache(unsigned maxCharacters = DEFAULT_TEXT_LAYOUT_CACHE_CHARACTERS);
+
+    /// Return layout of the text, calculate if missing. Previous layout of the same element is reused if the text is appended to it.
+    SharedPtr<TextLayout> GetLayout(FontFace* face, const ea::vector<unsigned>& text, int maxWidth, const TextLayout* previousLayout);
+    /// Remove all layouts.
+    void Clear();
+
+    /// Return number of cached layouts.
+    unsigned GetSize() const { return layouts_.size(); }
+    /// Return total number of characters in cached layouts.
+    unsigned GetNumCharacters() const { return numCharacters_; }
+    /// Return number of cache hits.
+    unsigned GetNumHits() const { return numHits_; }
+    /// Return number of layouts calculated incrementally.
+    unsigned GetNumAppends() const { return numAppends_; }
+    /// Return number of layouts calculated from scratch.
+    unsigned GetNumMisses() const { return numMisses_; }
+
+private:
+    using LayoutList = ea::list<ea::pair<unsigned, SharedPtr<TextLayout>>>;
+
+    /// Layouts with hashes from the most recently used to the least recently used.
+    LayoutList layouts_;
+    /// Layouts by hash of text and max width.
+    ea::unordered_map<unsigned, LayoutList::iterator> layoutsByHash_;
+    /// Max total number of characters in cached layouts.
+    unsigned maxCharacters_{};
+    /// Total number of characters in cached layouts.
+    unsigned numCharacters_{};
+    /// Number of cache hits.
+    unsigned numHits_{};
+    /// Number of layouts calculated incrementally.
+    unsigned numAppends_{};
+    /// Number of layouts calculated from scratch.
+    unsigned numMisses_{};
+};
+
+}
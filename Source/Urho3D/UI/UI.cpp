@@ -83,6 +83,13 @@ static MouseButton MakeTouchIDMask(int id)
     return static_cast<MouseButton>(1u << static_cast<MouseButtonFlags::Integer>(id)); // NOLINT(misc-misplaced-widening-cast)
 }
 
+static void MarkBatchesDirtyRecursive(UIElement* element)
+{
+    element->MarkBatchesDirty();
+    for (UIElement* child : element->GetChildren())
+        MarkBatchesDirtyRecursive(child);
+}
+
 ea::string VAR_ORIGIN("Origin");
 const ea::string VAR_ORIGINAL_PARENT("OriginalParent");
 const ea::string VAR_ORIGINAL_CHILD_INDEX("OriginalChildIndex");
@@ -213,6 +220,7 @@ void UI::SetFocusElement(UIElement* element, bool byKey)
     {
         UIElement* oldFocusElement = focusElement_;
         focusElement_.Reset();
+        oldFocusElement->MarkBatchesDirty();
 
         VariantMap& focusEventData = GetEventDataMap();
         focusEventData[Defocused::P_ELEMENT] = oldFocusElement;
@@ -223,6 +231,7 @@ void UI::SetFocusElement(UIElement* element, bool byKey)
     if (element && element->GetFocusMode() >= FM_FOCUSABLE)
     {
         focusElement_ = element;
+        element->MarkBatchesDirty();
 
         VariantMap& focusEventData = GetEventDataMap();
         focusEventData[Focused::P_ELEMENT] = element;
@@ -321,6 +330,8 @@ void UI::Clear()
     vertexData_.clear();
     debugDrawBatches_.clear();
     debugVertexData_.clear();
+    rootElement_->MarkHierarchyBatchesDirty();
+    rootModalElement_->MarkHierarchyBatchesDirty();
 }
 
 void UI::Update(float timeStep)
@@ -433,6 +444,22 @@ void UI::RenderUpdate()
     // If the OS cursor is visible, do not render the UI's own cursor
     bool osCursorVisible = GetSubsystem<Input>()->IsMouseVisible();
 
+    numElementBatchUpdates_ = 0;
+    if (batchCaching_)
+    {
+        // Nothing has changed since last update, reuse batches and vertex data as is.
+        // The cursor is parented to the root element and is tracked by its flag
+        if (!rootElement_->IsHierarchyBatchesDirty() && !rootModalElement_->IsHierarchyBatchesDirty()
+            && osCursorVisible == batchesOsCursorVisible_)
+            return;
+
+        // Reset flags before traversal so that elements may request regeneration next frame
+        rootElement_->ResetHierarchyBatchesDirty();
+        rootModalElement_->ResetHierarchyBatchesDirty();
+        batchesOsCursorVisible_ = osCursorVisible;
+        vertexDataDirty_ = true;
+    }
+
     // Get rendering batches from the non-modal UI elements
     batches_.clear();
     vertexData_.clear();
@@ -453,7 +480,7 @@ void UI::RenderUpdate()
     if (cursor_ && cursor_->IsVisible() && !osCursorVisible)
     {
         currentScissor = IntRect(0, 0, rootSize.x_, rootSize.y_);
-        cursor_->GetBatches(batches_, vertexData_, currentScissor);
+        GetElementBatches(batches_, vertexData_, cursor_, currentScissor);
         GetBatches(batches_, vertexData_, cursor_, currentScissor);
     }
 
@@ -479,7 +506,15 @@ void UI::Render()
     if (cursor_ && osCursorVisible)
         cursor_->ApplyOSCursorShape();
 
-    SetVertexData(vertexBuffer_, vertexData_);
+    if (batchCaching_)
+    {
+        // Skip comparison with uploaded data if batches were not regenerated
+        if (vertexDataDirty_)
+            UpdateVertexData(vertexBuffer_, vertexData_);
+        vertexDataDirty_ = false;
+    }
+    else
+        SetVertexData(vertexBuffer_, vertexData_);
     SetVertexData(debugVertexBuffer_, debugVertexData_);
 
     // Render non-modal batches
@@ -646,6 +681,17 @@ void UI::SetForceAutoHint(bool enable)
     }
 }
 
+void UI::SetBatchCaching(bool enable)
+{
+    if (enable != batchCaching_)
+    {
+        batchCaching_ = enable;
+        MarkBatchesDirtyRecursive(rootElement_);
+        MarkBatchesDirtyRecursive(rootModalElement_);
+        uploadedVertexData_.clear();
+    }
+}
+
 void UI::SetFontHintLevel(FontHintLevel level)
 {
     if (level != fontHintLevel_)
@@ -923,6 +969,48 @@ void UI::SetVertexData(VertexBuffer* dest, const ea::vector<float>& vertexData)
     dest->Update(&vertexData[0]);
 }
 
+void UI::UpdateVertexData(VertexBuffer* dest, const ea::vector<float>& vertexData)
+{
+    if (vertexData.empty())
+        return;
+
+    // Static buffer is used so that only the changed range of vertices is uploaded
+    const unsigned numVertices = vertexData.size() / UI_VERTEX_SIZE;
+    if (dest->IsDynamic() || dest->GetVertexCount() < numVertices || dest->GetVertexCount() > numVertices * 2)
+    {
+        dest->SetSize(numVertices, MASK_POSITION | MASK_COLOR | MASK_TEXCOORD1, false);
+        uploadedVertexData_.clear();
+    }
+
+    if (uploadedVertexData_.size() != vertexData.size())
+    {
+        dest->Update(vertexData.data(), numVertices * dest->GetVertexSize());
+        uploadedVertexData_ = vertexData;
+        return;
+    }
+
+    // Find first and last changed vertices. Colors are packed into floats, so values are compared bitwise
+    const auto isSame = [&](unsigned index)
+    { return memcmp(&vertexData[index], &uploadedVertexData_[index], sizeof(float)) == 0; };
+
+    unsigned first = 0;
+    while (first < vertexData.size() && isSame(first))
+        ++first;
+    if (first == vertexData.size())
+        return;
+
+    unsigned last = vertexData.size();
+    while (last > first && isSame(last - 1))
+        --last;
+
+    const unsigned firstVertex = first / UI_VERTEX_SIZE;
+    const unsigned endVertex = (last + UI_VERTEX_SIZE - 1) / UI_VERTEX_SIZE;
+    const unsigned vertexSize = dest->GetVertexSize();
+    dest->UpdateRange(&vertexData[firstVertex * UI_VERTEX_SIZE], firstVertex * vertexSize, (endVertex - firstVertex) * vertexSize);
+    ea::copy(vertexData.begin() + firstVertex * UI_VERTEX_SIZE, vertexData.begin() + endVertex * UI_VERTEX_SIZE,
+        uploadedVertexData_.begin() + firstVertex * UI_VERTEX_SIZE);
+}
+
 Material* UI::GetBatchMaterial(const UIBatch& batch) const
 {
     if (batch.customMaterial_)
@@ -1093,7 +1181,7 @@ void UI::GetBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData,
             while (j != children.end() && (*j)->GetPriority() == currentPriority)
             {
                 if ((*j)->IsWithinScissor(currentScissor) && (*j) != cursor_)
-                    (*j)->GetBatches(batches, vertexData, currentScissor);
+                    GetElementBatches(batches, vertexData, *j, currentScissor);
                 ++j;
             }
             // Now recurse into the children
@@ -1113,7 +1201,7 @@ void UI::GetBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData,
             if ((*i) != cursor_)
             {
                 if ((*i)->IsWithinScissor(currentScissor))
-                    (*i)->GetBatches(batches, vertexData, currentScissor);
+                    GetElementBatches(batches, vertexData, *i, currentScissor);
                 if ((*i)->IsVisible())
                     GetBatches(batches, vertexData, *i, currentScissor);
             }
@@ -1122,6 +1210,17 @@ void UI::GetBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData,
     }
 }
 
+void UI::GetElementBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData, UIElement* element, const IntRect& currentScissor)
+{
+    if (!batchCaching_)
+    {
+        element->GetBatches(batches, vertexData, currentScissor);
+        ++numElementBatchUpdates_;
+    }
+    else if (element->GetCachedBatches(batches, vertexData, currentScissor))
+        ++numElementBatchUpdates_;
+}
+
 void UI::GetElementAt(UIElement*& result, UIElement* current, const IntVector2& position, bool enabledOnly)
 {
     if (!current)
@@ -1259,6 +1358,10 @@ void UI::ReleaseFontFaces()
 
     for (unsigned i = 0; i < fonts.size(); ++i)
         fonts[i]->ReleaseFaces();
+
+    // Cached text batches reference released font textures
+    MarkBatchesDirtyRecursive(rootElement_);
+    MarkBatchesDirtyRecursive(rootModalElement_);
 }
 
 void UI::ProcessHover(const IntVector2& windowCursorPos, MouseButtonFlags buttons, QualifierFlags qualifiers, Cursor* cursor)
@@ -2152,6 +2255,7 @@ void UI::SetRenderTarget(Texture2D* texture, Color clearColor)
 {
     clearColor_ = clearColor;
     texture_ = texture;
+    rootElement_->MarkHierarchyBatchesDirty();
     if (texture == nullptr)
         UnsubscribeFromEvent(E_ENDALLVIEWSRENDER);
     else
@@ -2166,12 +2270,14 @@ void UI::SetRoot(UIElement* root)
     rootElement_ = root;
     customSize_ = root->GetSize();
     ResizeRootElement();
+    rootElement_->MarkHierarchyBatchesDirty();
 }
 
 void UI::SetRootModalElement(UIElement* rootModal)
 {
     rootModalElement_ = rootModal;
     ResizeRootElement();
+    rootModalElement_->MarkHierarchyBatchesDirty();
 }
 
 void RegisterUILibrary(Context* context)
@@ -128,6 +128,10 @@ public:
     /// Set whether to force font autohinting instead of using FreeType's TTF bytecode interpreter.
     /// @property
     void SetForceAutoHint(bool enable);
+    /// Set whether to cache rendering batches per element and regenerate only changed elements. Default false.
+    /// Custom elements that override GetBatches should call MarkBatchesDirty when their appearance changes.
+    /// @property
+    void SetBatchCaching(bool enable);
     /// Set the hinting level used by FreeType fonts.
     /// @property
     void SetFontHintLevel(FontHintLevel level);
@@ -245,6 +249,15 @@ public:
     /// @property
     bool GetForceAutoHint() const { return forceAutoHint_; }
 
+    /// Return whether rendering batches are cached per element.
+    /// @property
+    bool GetBatchCaching() const { return batchCaching_; }
+
+    /// Return number of elements whose batches were generated during last batch update.
+    unsigned GetNumElementBatchUpdates() const { return numElementBatchUpdates_; }
+    /// Return vertex data of rendering batches generated during last batch update.
+    const ea::vector<float>& GetVertexData() const { return vertexData_; }
+
     /// Return the current FreeType font hinting level.
     /// @property
     FontHintLevel GetFontHintLevel() const { return fontHintLevel_; }
@@ -307,10 +320,14 @@ private:
     void Update(float timeStep, UIElement* element);
     /// Upload UI geometry into a vertex buffer.
     void SetVertexData(VertexBuffer* dest, const ea::vector<float>& vertexData);
+    /// Upload only changed part of UI geometry into a static vertex buffer.
+    void UpdateVertexData(VertexBuffer* dest, const ea::vector<float>& vertexData);
     /// Render UI batches to the current rendertarget. Geometry must have been uploaded first.
     void Render(VertexBuffer* buffer, const ea::vector<UIBatch>& batches, unsigned batchStart, unsigned batchEnd);
     /// Generate batches from an UI element recursively. Skip the cursor element.
     void GetBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData, UIElement* element, IntRect currentScissor);
+    /// Generate batches from an UI element, either directly or from the element cache.
+    void GetElementBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData, UIElement* element, const IntRect& currentScissor);
     /// Return UI element at screen position recursively.
     void GetElementAt(UIElement*& result, UIElement* current, const IntVector2& position, bool enabledOnly);
     /// Return the first element in hierarchy that can alter focus.
@@ -409,6 +426,8 @@ private:
     ea::vector<UIBatch> batches_;
     /// UI rendering vertex data.
     ea::vector<float> vertexData_;
+    /// Vertex data that was last uploaded to the vertex buffer. Used to upload only changed vertices when batches are cached.
+    ea::vector<float> uploadedVertexData_;
     /// UI rendering batches for debug draw.
     ea::vector<UIBatch> debugDrawBatches_;
     /// UI rendering vertex data for debug draw.
@@ -461,6 +480,14 @@ private:
     bool uiRendered_;
     /// Non-modal batch size (used internally for rendering).
     unsigned nonModalBatchSize_;
+    /// Flag whether rendering batches are cached per element.
+    bool batchCaching_{};
+    /// OS cursor visibility during last batch update.
+    bool batchesOsCursorVisible_{};
+    /// Whether vertex data was regenerated since last upload. Only used when batches are cached.
+    bool vertexDataDirty_{true};
+    /// Number of elements whose batches were generated during last batch update.
+    unsigned numElementBatchUpdates_{};
     /// Timer used to trigger double click.
     Timer clickTimer_;
     /// UI element last clicked for tracking double clicks.
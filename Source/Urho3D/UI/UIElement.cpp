@@ -448,7 +448,7 @@ const IntVector2& UIElement::GetScreenPosition() const
 
 void UIElement::OnHover(const IntVector2& position, const IntVector2& screenPosition, MouseButtonFlags buttons, QualifierFlags qualifiers, Cursor* cursor)
 {
-    hovering_ = true;
+    SetHovering(true);
 }
 
 void UIElement::OnDragBegin(const IntVector2& position, const IntVector2& screenPosition, MouseButtonFlags buttons, QualifierFlags qualifiers,
@@ -845,6 +845,7 @@ void UIElement::SetClipBorder(const IntRect& rect)
     clipBorder_.top_ = Max(rect.top_, 0);
     clipBorder_.right_ = Max(rect.right_, 0);
     clipBorder_.bottom_ = Max(rect.bottom_, 0);
+    MarkHierarchyBatchesDirty();
 }
 
 void UIElement::SetColor(const Color& color)
@@ -853,6 +854,7 @@ void UIElement::SetColor(const Color& color)
         cornerColor = color;
     colorGradient_ = false;
     derivedColorDirty_ = true;
+    MarkBatchesDirty();
 }
 
 void UIElement::SetColor(Corner corner, const Color& color)
@@ -860,6 +862,7 @@ void UIElement::SetColor(Corner corner, const Color& color)
     colors_[corner] = color;
     colorGradient_ = false;
     derivedColorDirty_ = true;
+    MarkBatchesDirty();
 
     for (unsigned i = 0; i < MAX_UIELEMENT_CORNERS; ++i)
     {
@@ -876,6 +879,7 @@ void UIElement::SetPriority(int priority)
     priority_ = priority;
     if (parent_)
         parent_->sortOrderDirty_ = true;
+    MarkHierarchyBatchesDirty();
 }
 
 void UIElement::SetOpacity(float opacity)
@@ -897,6 +901,7 @@ void UIElement::SetBringToBack(bool enable)
 void UIElement::SetClipChildren(bool enable)
 {
     clipChildren_ = enable;
+    MarkHierarchyBatchesDirty();
 }
 
 void UIElement::SetSortChildren(bool enable)
@@ -905,22 +910,26 @@ void UIElement::SetSortChildren(bool enable)
         sortOrderDirty_ = true;
 
     sortChildren_ = enable;
+    MarkHierarchyBatchesDirty();
 }
 
 void UIElement::SetUseDerivedOpacity(bool enable)
 {
     useDerivedOpacity_ = enable;
+    MarkDirty();
 }
 
 void UIElement::SetEnabled(bool enable)
 {
     enabled_ = enable;
     enabledPrev_ = enable;
+    MarkBatchesDirty();
 }
 
 void UIElement::SetDeepEnabled(bool enable)
 {
     enabled_ = enable;
+    MarkBatchesDirty();
 
     for (auto i = children_.begin(); i != children_.end(); ++i)
         (*i)->SetDeepEnabled(enable);
@@ -929,6 +938,7 @@ void UIElement::SetDeepEnabled(bool enable)
 void UIElement::ResetDeepEnabled()
 {
     enabled_ = enabledPrev_;
+    MarkBatchesDirty();
 
     for (auto i = children_.begin(); i != children_.end(); ++i)
         (*i)->ResetDeepEnabled();
@@ -938,6 +948,7 @@ void UIElement::SetEnabledRecursive(bool enable)
 {
     enabled_ = enable;
     enabledPrev_ = enable;
+    MarkBatchesDirty();
 
     for (auto i = children_.begin(); i != children_.end(); ++i)
         (*i)->SetEnabledRecursive(enable);
@@ -979,7 +990,11 @@ void UIElement::SetFocus(bool enable)
 
 void UIElement::SetSelected(bool enable)
 {
-    selected_ = enable;
+    if (selected_ != enable)
+    {
+        selected_ = enable;
+        MarkBatchesDirty();
+    }
 }
 
 void UIElement::SetVisible(bool enable)
@@ -992,6 +1007,7 @@ void UIElement::SetVisible(bool enable)
     if (enable != visible_)
     {
         visible_ = enable;
+        MarkHierarchyBatchesDirty();
 
         // Parent's layout may change as a result of visibility change
         if (parent_)
@@ -1105,6 +1121,7 @@ void UIElement::SetLayoutFlexScale(const Vector2& scale)
 void UIElement::SetIndent(int indent)
 {
     indent_ = indent;
+    MarkBatchesDirty();
     if (parent_)
         parent_->UpdateLayout();
     UpdateLayout();
@@ -1114,6 +1131,7 @@ void UIElement::SetIndent(int indent)
 void UIElement::SetIndentSpacing(int indentSpacing)
 {
     indentSpacing_ = Max(indentSpacing, 0);
+    MarkBatchesDirty();
     if (parent_)
         parent_->UpdateLayout();
     UpdateLayout();
@@ -1346,6 +1364,8 @@ void UIElement::InsertChild(unsigned index, UIElement* element)
 
     element->parent_ = this;
     element->MarkDirty();
+    // Element may be already dirty, so MarkDirty wouldn't reach the new parent
+    MarkHierarchyBatchesDirty();
 
     // Apply style now if child element (and its children) has it defined
     ApplyStyleRecursive(element);
@@ -1485,6 +1505,7 @@ void UIElement::SetInternal(bool enable)
 void UIElement::SetTraversalMode(TraversalMode traversalMode)
 {
     traversalMode_ = traversalMode;
+    MarkHierarchyBatchesDirty();
 }
 
 void UIElement::SetElementEventSender(bool flag)
@@ -1855,7 +1876,11 @@ void UIElement::SetChildOffset(const IntVector2& offset)
 
 void UIElement::SetHovering(bool enable)
 {
-    hovering_ = enable;
+    if (hovering_ != enable)
+    {
+        hovering_ = enable;
+        MarkBatchesDirty();
+    }
 }
 
 void UIElement::AdjustScissor(IntRect& currentScissor)
@@ -1896,6 +1921,62 @@ void UIElement::GetBatchesWithOffset(IntVector2& offset, ea::vector<UIBatch>& ba
     }
 }
 
+void UIElement::MarkBatchesDirty()
+{
+    batchesDirty_ = true;
+    MarkHierarchyBatchesDirty();
+}
+
+void UIElement::MarkHierarchyBatchesDirty()
+{
+    // Ancestors of dirty element are always dirty, so the walk stops at the first dirty element
+    for (UIElement* element = this; element && !element->hierarchyBatchesDirty_; element = element->parent_)
+        element->hierarchyBatchesDirty_ = true;
+}
+
+void UIElement::ResetHierarchyBatchesDirty()
+{
+    // Only dirty elements may have dirty children
+    if (!hierarchyBatchesDirty_)
+        return;
+
+    hierarchyBatchesDirty_ = false;
+    for (UIElement* child : children_)
+        child->ResetHierarchyBatchesDirty();
+}
+
+bool UIElement::GetCachedBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData, const IntRect& currentScissor)
+{
+    const bool regenerate = batchesDirty_ || cachedScissor_ != currentScissor;
+    if (regenerate)
+    {
+        // GetBatches resets hovering, so the element should be regenerated next frame when hovering ends
+        const bool wasHovering = hovering_;
+
+        cachedBatches_.clear();
+        cachedVertexData_.clear();
+        GetBatches(cachedBatches_, cachedVertexData_, currentScissor);
+        cachedScissor_ = currentScissor;
+
+        batchesDirty_ = false;
+        if (wasHovering || !IsBatchCachingAllowed())
+            MarkBatchesDirty();
+    }
+
+    const unsigned vertexOffset = vertexData.size();
+    vertexData.insert(vertexData.end(), cachedVertexData_.begin(), cachedVertexData_.end());
+    for (const UIBatch& cachedBatch : cachedBatches_)
+    {
+        UIBatch batch = cachedBatch;
+        batch.vertexData_ = &vertexData;
+        batch.vertexStart_ += vertexOffset;
+        batch.vertexEnd_ += vertexOffset;
+        UIBatch::AddOrMerge(batch, batches);
+    }
+
+    return regenerate;
+}
+
 UIElement* UIElement::GetElementEventSender() const
 {
     auto* element = const_cast<UIElement*>(this);
@@ -1983,9 +2064,12 @@ void UIElement::MarkDirty()
     positionDirty_ = true;
     opacityDirty_ = true;
     derivedColorDirty_ = true;
+    batchesDirty_ = true;
 
     for (auto i = children_.begin(); i != children_.end(); ++i)
         (*i)->MarkDirty();
+
+    MarkHierarchyBatchesDirty();
 }
 
 bool UIElement::RemoveChildXML(XMLElement& parent, const ea::string& name) const
@@ -2268,6 +2352,8 @@ IntVector2 UIElement::GetLayoutChildPosition(UIElement* child)
 
 void UIElement::Detach()
 {
+    if (parent_)
+        parent_->MarkHierarchyBatchesDirty();
     parent_ = nullptr;
     MarkDirty();
 }
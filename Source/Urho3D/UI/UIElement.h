@@ -152,6 +152,8 @@ public:
     virtual const IntVector2& GetScreenPosition() const;
     /// Return UI rendering batches.
     virtual void GetBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData, const IntRect& currentScissor);
+    /// Return whether batches may be cached until marked dirty. Elements whose batches depend on external state should return false.
+    virtual bool IsBatchCachingAllowed() const { return true; }
     /// Return UI rendering batches for debug draw.
     virtual void GetDebugDrawBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData, const IntRect& currentScissor);
     /// React to mouse hover.
@@ -745,6 +747,16 @@ public:
     void AdjustScissor(IntRect& currentScissor);
     /// Get UI rendering batches with a specified offset. Also recurse to child elements.
     void GetBatchesWithOffset(IntVector2& offset, ea::vector<UIBatch>& batches, ea::vector<float>& vertexData, IntRect currentScissor);
+    /// Mark cached batches as needing regeneration. Should be called whenever anything used by GetBatches changes.
+    void MarkBatchesDirty();
+    /// Mark batches of the element hierarchy as needing update, e.g. when child elements are added, removed or reordered.
+    void MarkHierarchyBatchesDirty();
+    /// Return UI rendering batches from cache, regenerate the cache first if dirty. Return whether the cache was regenerated. Used internally by UI.
+    bool GetCachedBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData, const IntRect& currentScissor);
+    /// Return whether batches of the element or any element in its hierarchy are dirty. Used internally by UI.
+    bool IsHierarchyBatchesDirty() const { return hierarchyBatchesDirty_; }
+    /// Reset hierarchy batches dirty flag of the element and its dirty children. Used internally by UI.
+    void ResetHierarchyBatchesDirty();
 
     /// Return color attribute. Uses just the top-left color.
     const Color& GetColorAttr() const { return colors_[0]; }
@@ -914,6 +926,16 @@ private:
     mutable bool derivedColorDirty_{true};
     /// Child priority sorting dirty flag.
     bool sortOrderDirty_{};
+    /// Cached rendering batches. Vertex ranges refer to cached vertex data.
+    ea::vector<UIBatch> cachedBatches_;
+    /// Cached vertex data.
+    ea::vector<float> cachedVertexData_;
+    /// Scissor of cached batches.
+    IntRect cachedScissor_;
+    /// Cached batches dirty flag.
+    bool batchesDirty_{true};
+    /// Hierarchy batches dirty flag. If set, it's also set for all ancestors.
+    bool hierarchyBatchesDirty_{true};
     /// Has color gradient flag.
     bool colorGradient_{};
     /// Default style file.
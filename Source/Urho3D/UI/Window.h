@@ -60,6 +60,8 @@ public:
 
     /// Return UI rendering batches.
     void GetBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData, const IntRect& currentScissor) override;
+    /// Return whether batches may be cached. Modal shade depends on the size of the root element.
+    bool IsBatchCachingAllowed() const override { return !modal_; }
 
     /// React to mouse hover.
     void OnHover(const IntVector2& position, const IntVector2& screenPosition, MouseButtonFlags buttons, QualifierFlags qualifiers, Cursor* cursor) override;
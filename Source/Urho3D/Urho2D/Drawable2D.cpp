@@ -30,6 +30,8 @@
 #include "../Urho2D/Drawable2D.h"
 #include "../Urho2D/Renderer2D.h"
 
+#include <atomic>
+
 #include "../DebugNew.h"
 
 namespace Urho3D
@@ -37,6 +39,9 @@ namespace Urho3D
 
 const float PIXEL_SIZE = 0.01f;
 
+/// Last version of source batch vertices. Source batches may be updated from worker threads.
+static std::atomic<unsigned> lastSourceBatchVersion{0};
+
 SourceBatch2D::SourceBatch2D() :
     distance_(0.0f),
     drawOrder_(0)
@@ -97,8 +102,14 @@ void Drawable2D::SetOrderInLayer(int orderInLayer)
 const ea::vector<SourceBatch2D>& Drawable2D::GetSourceBatches()
 {
     if (sourceBatchesDirty_)
+    {
         UpdateSourceBatches();
 
+        const unsigned version = lastSourceBatchVersion.fetch_add(1, std::memory_order_relaxed) + 1;
+        for (SourceBatch2D& sourceBatch : sourceBatches_)
+            sourceBatch.version_ = version;
+    }
+
     return sourceBatches_;
 }
 
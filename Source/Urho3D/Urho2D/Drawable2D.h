@@ -70,10 +70,14 @@ struct SourceBatch2D
     mutable float distance_;
     /// Draw order.
     int drawOrder_;
+    /// Order among source batches of the same draw order and distance, e.g. batches of one drawable.
+    unsigned subOrder_{};
     /// Material.
     SharedPtr<Material> material_;
     /// Vertices.
     ea::vector<Vertex2D> vertices_;
+    /// Version of vertices. Changed whenever vertices are updated, unique among all source batches.
+    unsigned version_{};
 
     /// Equality comparison operator.
     bool operator==(const SourceBatch2D& other) const
@@ -81,7 +85,7 @@ struct SourceBatch2D
         if (this == &other)
             return true;
         return owner_ == other.owner_ && distance_ == other.distance_ && drawOrder_ == other.drawOrder_ &&
-            material_ == other.material_ && vertices_ == other.vertices_;
+            subOrder_ == other.subOrder_ && material_ == other.material_ && vertices_ == other.vertices_;
     }
 
     /// Inequality comparison operator.
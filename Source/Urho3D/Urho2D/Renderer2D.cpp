@@ -22,8 +22,6 @@
 
 #include "../Precompiled.h"
 
-#include <EASTL/sort.h>
-
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
 #include "../Core/WorkQueue.h"
@@ -44,6 +42,10 @@
 #include "../Urho2D/Drawable2D.h"
 #include "../Urho2D/Renderer2D.h"
 
+#include <EASTL/sort.h>
+
+#include <cstring>
+
 #include "../DebugNew.h"
 
 namespace Urho3D
@@ -51,6 +53,40 @@ namespace Urho3D
 
 static const unsigned MASK_VERTEX2D = MASK_POSITION | MASK_COLOR | MASK_TEXCOORD1;
 
+/// Return unsigned integer that has the same order as floating point value.
+static unsigned FloatToSortKey(float value)
+{
+    unsigned bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+/// Stable sort of keys by one byte of key field.
+static void RadixSortPass(ea::vector<SourceBatchSortKey2D>& keys, ea::vector<SourceBatchSortKey2D>& tempKeys,
+    unsigned SourceBatchSortKey2D::*field, unsigned shift)
+{
+    unsigned offsets[256]{};
+    for (const SourceBatchSortKey2D& key : keys)
+        ++offsets[(key.*field >> shift) & 0xffu];
+
+    // Skip the pass if all keys have the same digit
+    if (offsets[(keys[0].*field >> shift) & 0xffu] == keys.size())
+        return;
+
+    unsigned offset = 0;
+    for (unsigned& digitOffset : offsets)
+    {
+        const unsigned count = digitOffset;
+        digitOffset = offset;
+        offset += count;
+    }
+
+    for (const SourceBatchSortKey2D& key : keys)
+        tempKeys[offsets[(key.*field >> shift) & 0xffu]++] = key;
+
+    keys.swap(tempKeys);
+}
+
 ViewBatchInfo2D::ViewBatchInfo2D() :
     vertexBufferUpdateFrameNumber_(0),
     indexCount_(0),
@@ -142,6 +178,10 @@ void Renderer2D::UpdateBatchesDelayed(const FrameInfo& frame)
     // Fill index buffer
     if (indexBuffer_->GetIndexCount() < indexCount || indexBuffer_->IsDataLost())
     {
+        // Reserve space for more quads so that index data is not refilled every time sprite count grows
+        indexCount = Max(indexCount, indexBuffer_->GetIndexCount());
+        indexCount = NextPowerOfTwo(indexCount / 6) * 6;
+
         bool largeIndices = (indexCount * 4 / 6) > 0xffff;
         indexBuffer_->SetSize(indexCount, largeIndices);
 
@@ -194,33 +234,7 @@ void Renderer2D::UpdateBatchesDelayed(const FrameInfo& frame)
 
     if (viewBatchInfo.vertexBufferUpdateFrameNumber_ != frame_.frameNumber_)
     {
-        unsigned vertexCount = viewBatchInfo.vertexCount_;
-        VertexBuffer* vertexBuffer = viewBatchInfo.vertexBuffer_;
-        vertexBuffer->SetDebugName("Renderer2D Batches");
-
-        if (vertexBuffer->GetVertexCount() < vertexCount)
-            vertexBuffer->SetSize(vertexCount, MASK_VERTEX2D, true);
-
-        if (vertexCount)
-        {
-            auto* dest = reinterpret_cast<Vertex2D*>(vertexBuffer->Map());
-            if (dest)
-            {
-                const ea::vector<const SourceBatch2D*>& sourceBatches = viewBatchInfo.sourceBatches_;
-                for (unsigned b = 0; b < sourceBatches.size(); ++b)
-                {
-                    const ea::vector<Vertex2D>& vertices = sourceBatches[b]->vertices_;
-                    for (unsigned i = 0; i < vertices.size(); ++i)
-                        dest[i] = vertices[i];
-                    dest += vertices.size();
-                }
-
-                vertexBuffer->Unmap();
-            }
-            else
-                URHO3D_LOGERROR("Failed to lock vertex buffer");
-        }
-
+        UpdateVertexBuffer(viewBatchInfo);
         viewBatchInfo.vertexBufferUpdateFrameNumber_ = frame_.frameNumber_;
     }
 }
@@ -275,6 +289,40 @@ bool Renderer2D::CheckVisibility(Drawable2D* drawable) const
     return frustum_.IsInsideFast(box) != OUTSIDE;
 }
 
+void Renderer2D::SortSourceBatches(ea::vector<const SourceBatch2D*>& sourceBatches)
+{
+    const unsigned numBatches = sourceBatches.size();
+    if (numBatches < 2)
+        return;
+
+    sortKeys_.resize(numBatches);
+    tempSortKeys_.resize(numBatches);
+    for (unsigned i = 0; i < numBatches; ++i)
+    {
+        const SourceBatch2D* sourceBatch = sourceBatches[i];
+        SourceBatchSortKey2D& key = sortKeys_[i];
+        key.drawOrder_ = static_cast<unsigned>(sourceBatch->drawOrder_) ^ 0x80000000u;
+        key.distance_ = ~FloatToSortKey(sourceBatch->distance_);
+        key.subOrder_ = sourceBatch->subOrder_;
+        key.material_ = sourceBatch->material_ ? sourceBatch->material_->GetNameHash().Value() : 0;
+        key.index_ = i;
+    }
+
+    // Radix sort from the least significant byte of the least important key, each pass is stable
+    for (unsigned SourceBatchSortKey2D::*field :
+        {&SourceBatchSortKey2D::material_, &SourceBatchSortKey2D::subOrder_, &SourceBatchSortKey2D::distance_,
+            &SourceBatchSortKey2D::drawOrder_})
+    {
+        for (unsigned shift = 0; shift < 32; shift += 8)
+            RadixSortPass(sortKeys_, tempSortKeys_, field, shift);
+    }
+
+    tempSourceBatches_.resize(numBatches);
+    for (unsigned i = 0; i < numBatches; ++i)
+        tempSourceBatches_[i] = sourceBatches[sortKeys_[i].index_];
+    sourceBatches.swap(tempSourceBatches_);
+}
+
 void Renderer2D::OnWorldBoundingBoxUpdate()
 {
     // Set a large dummy bounding box to ensure the renderer is rendered
@@ -373,93 +421,104 @@ void Renderer2D::GetDrawables(ea::vector<Drawable2D*>& drawables, Node* node)
         GetDrawables(drawables, i->Get());
 }
 
-static inline bool CompareSourceBatch2Ds(const SourceBatch2D* lhs, const SourceBatch2D* rhs)
-{
-    if (lhs->drawOrder_ != rhs->drawOrder_)
-        return lhs->drawOrder_ < rhs->drawOrder_;
-
-    if (lhs->distance_ != rhs->distance_)
-        return lhs->distance_ > rhs->distance_;
-
-    if (lhs->material_ != rhs->material_)
-        return lhs->material_->GetNameHash() < rhs->material_->GetNameHash();
-
-    return lhs < rhs;
-}
-
 void Renderer2D::UpdateViewBatchInfo(ViewBatchInfo2D& viewBatchInfo, Camera* camera)
 {
     // Already update in same frame
     if (viewBatchInfo.batchUpdatedFrameNumber_ == frame_.frameNumber_)
         return;
 
-    ea::vector<const SourceBatch2D*>& sourceBatches = viewBatchInfo.sourceBatches_;
-    sourceBatches.clear();
+    visibleDrawables_.clear();
     for (unsigned d = 0; d < drawables_.size(); ++d)
     {
-        if (!drawables_[d]->IsInView(camera))
-            continue;
+        if (drawables_[d]->IsInView(camera))
+            visibleDrawables_.push_back(drawables_[d]);
+    }
+
+    // Update vertices and distances of visible drawables in worker threads
+    {
+        URHO3D_PROFILE("UpdateSourceBatches2D");
 
-        const ea::vector<SourceBatch2D>& batches = drawables_[d]->GetSourceBatches();
-        for (unsigned b = 0; b < batches.size(); ++b)
+        auto* queue = GetSubsystem<WorkQueue>();
+        ForEachParallel(queue, 16u, visibleDrawables_, [camera](unsigned, Drawable2D* drawable)
         {
-            if (batches[b].material_ && !batches[b].vertices_.empty())
-                sourceBatches.push_back(&batches[b]);
-        }
+            const float distance = camera->GetDistance(drawable->GetNode()->GetWorldPosition());
+            for (const SourceBatch2D& sourceBatch : drawable->GetSourceBatches())
+                sourceBatch.distance_ = distance;
+        });
     }
 
-    for (unsigned i = 0; i < sourceBatches.size(); ++i)
+    ea::vector<const SourceBatch2D*>& sourceBatches = viewBatchInfo.sourceBatches_;
+    sourceBatches.clear();
+    for (Drawable2D* drawable : visibleDrawables_)
     {
-        const SourceBatch2D* sourceBatch = sourceBatches[i];
-        // if (sourceBatch->owner_)
+        const ea::vector<SourceBatch2D>& batches = drawable->GetSourceBatches();
+        for (unsigned b = 0; b < batches.size(); ++b)
         {
-            Vector3 worldPos = sourceBatch->owner_->GetNode()->GetWorldPosition();
-            sourceBatch->distance_ = camera->GetDistance(worldPos);
+            if (batches[b].material_ && !batches[b].vertices_.empty())
+                sourceBatches.push_back(&batches[b]);
         }
     }
 
-    ea::quick_sort(sourceBatches.begin(), sourceBatches.end(), CompareSourceBatch2Ds);
-
-    viewBatchInfo.batchCount_ = 0;
-    Material* currMaterial = nullptr;
-    unsigned iStart = 0;
-    unsigned iCount = 0;
-    unsigned vStart = 0;
-    unsigned vCount = 0;
-    float distance = M_INFINITY;
+    SortSourceBatches(sourceBatches);
 
+    // Split sorted source batches into groups with the same material
+    materialGroups_.clear();
     for (unsigned b = 0; b < sourceBatches.size(); ++b)
     {
-        distance = Min(distance, sourceBatches[b]->distance_);
-        Material* material = sourceBatches[b]->material_;
-        const ea::vector<Vertex2D>& vertices = sourceBatches[b]->vertices_;
+        if (materialGroups_.empty() || sourceBatches[b]->material_ != sourceBatches[b - 1]->material_)
+            materialGroups_.push_back(MaterialGroup2D{b});
+        ++materialGroups_.back().batchCount_;
+    }
 
-        // When new material encountered, finish the current batch and start new
-        if (currMaterial != material)
+    // Count vertices and find distance of each group in worker threads
+    auto* queue = GetSubsystem<WorkQueue>();
+    ForEachParallel(queue, materialGroups_, [&](unsigned, MaterialGroup2D& group)
+    {
+        group.indexCount_ = 0;
+        group.vertexCount_ = 0;
+        group.distance_ = M_INFINITY;
+        for (unsigned b = group.batchStart_; b < group.batchStart_ + group.batchCount_; ++b)
         {
-            if (currMaterial)
-            {
-                AddViewBatch(viewBatchInfo, currMaterial, iStart, iCount, vStart, vCount, distance);
-                iStart += iCount;
-                iCount = 0;
-                vStart += vCount;
-                vCount = 0;
-                distance = M_INFINITY;
-            }
-
-            currMaterial = material;
+            const unsigned numVertices = sourceBatches[b]->vertices_.size();
+            group.indexCount_ += numVertices * 6 / 4;
+            group.vertexCount_ += numVertices;
+            group.distance_ = Min(group.distance_, sourceBatches[b]->distance_);
         }
+    });
 
-        iCount += vertices.size() * 6 / 4;
-        vCount += vertices.size();
+    // Allocate index and vertex ranges and add one view batch per group
+    viewBatchInfo.batchCount_ = 0;
+    unsigned indexStart = 0;
+    unsigned vertexStart = 0;
+    for (MaterialGroup2D& group : materialGroups_)
+    {
+        group.indexStart_ = indexStart;
+        group.vertexStart_ = vertexStart;
+        AddViewBatch(viewBatchInfo, sourceBatches[group.batchStart_]->material_, group.indexStart_, group.indexCount_,
+            group.vertexStart_, group.vertexCount_, group.distance_);
+
+        indexStart += group.indexCount_;
+        vertexStart += group.vertexCount_;
     }
 
-    // Add the final batch if necessary
-    if (currMaterial && vCount)
-        AddViewBatch(viewBatchInfo, currMaterial, iStart, iCount, vStart, vCount,distance);
+    // Fill vertex ranges of source batches in worker threads
+    viewBatchInfo.batchRanges_.resize(sourceBatches.size());
+    ForEachParallel(queue, materialGroups_, [&](unsigned, const MaterialGroup2D& group)
+    {
+        unsigned batchVertexStart = group.vertexStart_;
+        for (unsigned b = group.batchStart_; b < group.batchStart_ + group.batchCount_; ++b)
+        {
+            SourceBatchRange2D& batchRange = viewBatchInfo.batchRanges_[b];
+            batchRange.sourceBatch_ = sourceBatches[b];
+            batchRange.version_ = sourceBatches[b]->version_;
+            batchRange.vertexStart_ = batchVertexStart;
+            batchRange.vertexCount_ = sourceBatches[b]->vertices_.size();
+            batchVertexStart += batchRange.vertexCount_;
+        }
+    });
 
-    viewBatchInfo.indexCount_ = iStart + iCount;
-    viewBatchInfo.vertexCount_ = vStart + vCount;
+    viewBatchInfo.indexCount_ = indexStart;
+    viewBatchInfo.vertexCount_ = vertexStart;
     viewBatchInfo.batchUpdatedFrameNumber_ = frame_.frameNumber_;
 }
 
@@ -493,4 +552,53 @@ void Renderer2D::AddViewBatch(ViewBatchInfo2D& viewBatchInfo, Material* material
     viewBatchInfo.batchCount_++;
 }
 
+void Renderer2D::UpdateVertexBuffer(ViewBatchInfo2D& viewBatchInfo)
+{
+    URHO3D_PROFILE("UpdateVertexBuffer2D");
+
+    const unsigned vertexCount = viewBatchInfo.vertexCount_;
+    VertexBuffer* vertexBuffer = viewBatchInfo.vertexBuffer_;
+    vertexBuffer->SetDebugName("Renderer2D Batches");
+
+    // Static buffer is kept between frames so that only vertices of changed source batches are uploaded
+    if (vertexBuffer->IsDynamic() || vertexBuffer->GetVertexCount() < vertexCount || vertexBuffer->IsDataLost())
+    {
+        vertexBuffer->SetSize(NextPowerOfTwo(vertexCount), MASK_VERTEX2D, false);
+        viewBatchInfo.vertices_.resize(vertexBuffer->GetVertexCount());
+        viewBatchInfo.uploadedBatchRanges_.clear();
+    }
+
+    const ea::vector<SourceBatchRange2D>& batchRanges = viewBatchInfo.batchRanges_;
+    const ea::vector<SourceBatchRange2D>& uploadedBatchRanges = viewBatchInfo.uploadedBatchRanges_;
+    dirtyBatchIndices_.clear();
+    for (unsigned i = 0; i < batchRanges.size(); ++i)
+    {
+        if (i >= uploadedBatchRanges.size() || batchRanges[i] != uploadedBatchRanges[i])
+            dirtyBatchIndices_.push_back(i);
+    }
+
+    if (!dirtyBatchIndices_.empty())
+    {
+        // Copy vertices of changed source batches in worker threads
+        Vertex2D* vertices = viewBatchInfo.vertices_.data();
+        auto* queue = GetSubsystem<WorkQueue>();
+        ForEachParallel(queue, 64u, dirtyBatchIndices_, [&](unsigned, unsigned batchIndex)
+        {
+            const SourceBatchRange2D& batchRange = batchRanges[batchIndex];
+            const ea::vector<Vertex2D>& sourceVertices = batchRange.sourceBatch_->vertices_;
+            ea::copy(sourceVertices.begin(), sourceVertices.end(), vertices + batchRange.vertexStart_);
+        });
+
+        // Vertex ranges are ordered, so upload everything between the first and the last changed batch
+        const SourceBatchRange2D& firstRange = batchRanges[dirtyBatchIndices_.front()];
+        const SourceBatchRange2D& lastRange = batchRanges[dirtyBatchIndices_.back()];
+        const unsigned vertexStart = firstRange.vertexStart_;
+        const unsigned vertexEnd = lastRange.vertexStart_ + lastRange.vertexCount_;
+        const unsigned vertexSize = vertexBuffer->GetVertexSize();
+        vertexBuffer->UpdateRange(vertices + vertexStart, vertexStart * vertexSize, (vertexEnd - vertexStart) * vertexSize);
+    }
+
+    viewBatchInfo.uploadedBatchRanges_ = batchRanges;
+}
+
 }
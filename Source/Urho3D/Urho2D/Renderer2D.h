@@ -25,17 +25,76 @@
 #include "../Graphics/Drawable.h"
 #include "../Graphics/Texture2D.h"
 #include "../Math/Frustum.h"
+#include "../Urho2D/Drawable2D.h"
 
 namespace Urho3D
 {
 
-class Drawable2D;
 class IndexBuffer;
 class Material;
 class Technique;
 class VertexBuffer;
 struct FrameInfo;
-struct SourceBatch2D;
+
+/// Vertex range of source batch in view vertex buffer.
+/// @nobind
+struct SourceBatchRange2D
+{
+    /// Source batch.
+    const SourceBatch2D* sourceBatch_{};
+    /// Version of source batch vertices.
+    unsigned version_{};
+    /// Vertex start.
+    unsigned vertexStart_{};
+    /// Vertex count.
+    unsigned vertexCount_{};
+
+    /// Equality comparison operator.
+    bool operator==(const SourceBatchRange2D& rhs) const
+    {
+        return sourceBatch_ == rhs.sourceBatch_ && version_ == rhs.version_ && vertexStart_ == rhs.vertexStart_
+            && vertexCount_ == rhs.vertexCount_;
+    }
+
+    /// Inequality comparison operator.
+    bool operator!=(const SourceBatchRange2D& rhs) const { return !(*this == rhs); }
+};
+
+/// Sort key of source batch.
+/// @nobind
+struct SourceBatchSortKey2D
+{
+    /// Draw order, ascending.
+    unsigned drawOrder_{};
+    /// Distance, descending.
+    unsigned distance_{};
+    /// Sub-order, ascending.
+    unsigned subOrder_{};
+    /// Material name hash, ascending.
+    unsigned material_{};
+    /// Index of source batch.
+    unsigned index_{};
+};
+
+/// Range of sorted source batches with the same material. Each group becomes one view batch.
+/// @nobind
+struct MaterialGroup2D
+{
+    /// Index of first source batch.
+    unsigned batchStart_{};
+    /// Number of source batches.
+    unsigned batchCount_{};
+    /// Index start.
+    unsigned indexStart_{};
+    /// Index count.
+    unsigned indexCount_{};
+    /// Vertex start.
+    unsigned vertexStart_{};
+    /// Vertex count.
+    unsigned vertexCount_{};
+    /// Min distance of source batches.
+    float distance_{};
+};
 
 /// 2D view batch info.
 /// @nobind
@@ -56,6 +115,12 @@ struct ViewBatchInfo2D
     unsigned batchUpdatedFrameNumber_;
     /// Source batches.
     ea::vector<const SourceBatch2D*> sourceBatches_;
+    /// Vertex ranges of source batches.
+    ea::vector<SourceBatchRange2D> batchRanges_;
+    /// Vertex ranges of source batches uploaded to vertex buffer.
+    ea::vector<SourceBatchRange2D> uploadedBatchRanges_;
+    /// CPU copy of vertex buffer data.
+    ea::vector<Vertex2D> vertices_;
     /// Batch count.
     unsigned batchCount_;
     /// Distances.
@@ -96,6 +161,9 @@ public:
 
     /// Check visibility.
     bool CheckVisibility(Drawable2D* drawable) const;
+    /// Sort source batches by draw order, then by distance from far to near, then by material.
+    /// Source batches with equal keys keep their order.
+    void SortSourceBatches(ea::vector<const SourceBatch2D*>& sourceBatches);
 
 private:
     /// Recalculate the world-space bounding box.
@@ -111,6 +179,8 @@ private:
     /// Add view batch.
     void AddViewBatch(ViewBatchInfo2D& viewBatchInfo, Material* material,
         unsigned indexStart, unsigned indexCount, unsigned vertexStart, unsigned vertexCount, float distance);
+    /// Upload vertices of source batches changed since last upload.
+    void UpdateVertexBuffer(ViewBatchInfo2D& viewBatchInfo);
 
     /// Index buffer.
     SharedPtr<IndexBuffer> indexBuffer_;
@@ -118,6 +188,18 @@ private:
     SharedPtr<Material> material_;
     /// Drawables.
     ea::vector<Drawable2D*> drawables_;
+    /// Drawables visible in current view.
+    ea::vector<Drawable2D*> visibleDrawables_;
+    /// Source batch sort keys.
+    ea::vector<SourceBatchSortKey2D> sortKeys_;
+    /// Temporary source batch sort keys.
+    ea::vector<SourceBatchSortKey2D> tempSortKeys_;
+    /// Temporary source batches.
+    ea::vector<const SourceBatch2D*> tempSourceBatches_;
+    /// Indices of source batches that should be uploaded.
+    ea::vector<unsigned> dirtyBatchIndices_;
+    /// Material groups of current view.
+    ea::vector<MaterialGroup2D> materialGroups_;
     /// View frame info for current frame.
     FrameInfo frame_;
     /// View batch info.
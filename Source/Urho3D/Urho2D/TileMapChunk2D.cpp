@@ -0,0 +1,199 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "../Precompiled.h"
+
+#include "../Urho2D/TileMapChunk2D.h"
+
+#include "../Core/Context.h"
+#include "../Graphics/Material.h"
+#include "../Graphics/Texture2D.h"
+#include "../Scene/Node.h"
+#include "../Urho2D/Renderer2D.h"
+#include "../Urho2D/Sprite2D.h"
+#include "../Urho2D/TileMap2D.h"
+#include "../Urho2D/TileMapLayer2D.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+TileMapChunk2D::TileMapChunk2D(Context* context)
+    : Drawable2D(context)
+{
+}
+
+TileMapChunk2D::~TileMapChunk2D() = default;
+
+void TileMapChunk2D::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<TileMapChunk2D>();
+}
+
+void TileMapChunk2D::Initialize(TileMapLayer2D* layer, const IntRect& tileRect)
+{
+    layer_ = layer;
+    tileRect_ = tileRect;
+    MarkTilesDirty();
+}
+
+void TileMapChunk2D::MarkTilesDirty()
+{
+    UpdateMaterials();
+
+    // Same as transform change: both vertex data and bounding box should be updated
+    if (node_)
+        Drawable2D::OnMarkedDirty(node_);
+}
+
+void TileMapChunk2D::OnSceneSet(Scene* scene)
+{
+    Drawable2D::OnSceneSet(scene);
+
+    // Materials depend on renderer
+    if (scene)
+        MarkTilesDirty();
+}
+
+void TileMapChunk2D::OnWorldBoundingBoxUpdate()
+{
+    boundingBox_.Clear();
+    worldBoundingBox_.Clear();
+
+    for (const SourceBatch2D& sourceBatch : GetSourceBatches())
+    {
+        for (const Vertex2D& vertex : sourceBatch.vertices_)
+            worldBoundingBox_.Merge(vertex.position_);
+    }
+
+    if (worldBoundingBox_.Defined())
+        boundingBox_ = worldBoundingBox_.Transformed(node_->GetWorldTransform().Inverse());
+}
+
+void TileMapChunk2D::OnDrawOrderChanged()
+{
+    for (SourceBatch2D& sourceBatch : sourceBatches_)
+        sourceBatch.drawOrder_ = GetDrawOrder();
+}
+
+void TileMapChunk2D::UpdateSourceBatches()
+{
+    if (!sourceBatchesDirty_)
+        return;
+
+    for (SourceBatch2D& sourceBatch : sourceBatches_)
+        sourceBatch.vertices_.clear();
+
+    TileMap2D* tileMap = layer_ ? layer_->GetTileMap() : nullptr;
+    if (!tileMap || batchTextures_.empty())
+    {
+        sourceBatchesDirty_ = false;
+        return;
+    }
+
+    const TileMapInfo2D& info = tileMap->GetInfo();
+    const Matrix3x4& worldTransform = node_->GetWorldTransform();
+    const unsigned color = Color::WHITE.ToUInt();
+
+    // Tiles are emitted in the same order as they used to be drawn by individual sprites.
+    // Runs of tiles with the same texture are matched to batches in the same order as in UpdateMaterials
+    unsigned batchIndex = 0;
+    for (int y = tileRect_.top_; y < tileRect_.bottom_; ++y)
+    {
+        for (int x = tileRect_.left_; x < tileRect_.right_; ++x)
+        {
+            const TileSprite2D& tile = layer_->GetTileSprite(x, y);
+            Sprite2D* sprite = tile.sprite_;
+            Texture2D* texture = sprite ? sprite->GetTexture() : nullptr;
+            if (!texture)
+                continue;
+
+            if (batchTextures_[batchIndex] != texture)
+            {
+                // Textures may only mismatch if sprites were changed without MarkTilesDirty
+                if (batchIndex + 1 >= batchTextures_.size() || batchTextures_[batchIndex + 1] != texture)
+                    continue;
+                ++batchIndex;
+            }
+
+            Rect drawRect;
+            Rect textureRect;
+            if (!sprite->GetDrawRectangle(drawRect) || !sprite->GetTextureRectangle(textureRect, tile.flipX_, tile.flipY_))
+                continue;
+
+            ea::vector<Vertex2D>& vertices = sourceBatches_[batchIndex].vertices_;
+
+            const Vector2 position = info.TileIndexToPosition(x, y);
+            drawRect.min_ += position;
+            drawRect.max_ += position;
+
+            /*
+            V1---------V2
+            |         / |
+            |       /   |
+            |     /     |
+            |   /       |
+            | /         |
+            V0---------V3
+            */
+            Vertex2D vertex0;
+            Vertex2D vertex1;
+            Vertex2D vertex2;
+            Vertex2D vertex3;
+
+            vertex0.position_ = worldTransform * Vector3(drawRect.min_.x_, drawRect.min_.y_, 0.0f);
+            vertex1.position_ = worldTransform * Vector3(drawRect.min_.x_, drawRect.max_.y_, 0.0f);
+            vertex2.position_ = worldTransform * Vector3(drawRect.max_.x_, drawRect.max_.y_, 0.0f);
+            vertex3.position_ = worldTransform * Vector3(drawRect.max_.x_, drawRect.min_.y_, 0.0f);
+
+            vertex0.uv_ = textureRect.min_;
+            (tile.swapXY_ ? vertex3.uv_ : vertex1.uv_) = Vector2(textureRect.min_.x_, textureRect.max_.y_);
+            vertex2.uv_ = textureRect.max_;
+            (tile.swapXY_ ? vertex1.uv_ : vertex3.uv_) = Vector2(textureRect.max_.x_, textureRect.min_.y_);
+
+            vertex0.color_ = vertex1.color_ = vertex2.color_ = vertex3.color_ = color;
+
+            vertices.push_back(vertex0);
+            vertices.push_back(vertex1);
+            vertices.push_back(vertex2);
+            vertices.push_back(vertex3);
+        }
+    }
+
+    ++numRebuilds_;
+    sourceBatchesDirty_ = false;
+}
+
+void TileMapChunk2D::UpdateMaterials()
+{
+    batchTextures_.clear();
+    sourceBatches_.clear();
+
+    if (!layer_ || !renderer_)
+        return;
+
+    // Materials are resolved here because vertex data may be updated from worker threads.
+    // Tiles of different textures may overlap, so a new batch is started whenever the texture changes
+    for (int y = tileRect_.top_; y < tileRect_.bottom_; ++y)
+    {
+        for (int x = tileRect_.left_; x < tileRect_.right_; ++x)
+        {
+            Sprite2D* sprite = layer_->GetTileSprite(x, y).sprite_;
+            Texture2D* texture = sprite ? sprite->GetTexture() : nullptr;
+            if (!texture || (!batchTextures_.empty() && batchTextures_.back() == texture))
+                continue;
+
+            batchTextures_.push_back(texture);
+
+            SourceBatch2D& sourceBatch = sourceBatches_.emplace_back();
+            sourceBatch.owner_ = this;
+            sourceBatch.drawOrder_ = GetDrawOrder();
+            sourceBatch.subOrder_ = sourceBatches_.size() - 1;
+            sourceBatch.material_ = renderer_->GetMaterial(texture, BLEND_ALPHA);
+        }
+    }
+}
+
+}
@@ -0,0 +1,67 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+/// \file
+
+#pragma once
+
+#include "../Urho2D/Drawable2D.h"
+
+namespace Urho3D
+{
+
+class TileMapLayer2D;
+
+/// Default number of tile rows in tile map chunk.
+static const int DEFAULT_TILE_MAP_CHUNK_SIZE = 16;
+
+/// Rectangular group of tile map layer tiles rendered as single drawable. Created by TileMapLayer2D.
+class URHO3D_API TileMapChunk2D : public Drawable2D
+{
+    URHO3D_OBJECT(TileMapChunk2D, Drawable2D);
+
+public:
+    /// Construct.
+    explicit TileMapChunk2D(Context* context);
+    /// Destruct.
+    ~TileMapChunk2D() override;
+    /// Register object factory. Drawable2D must be registered first.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Initialize with layer and tile range. Max tile index is exclusive.
+    void Initialize(TileMapLayer2D* layer, const IntRect& tileRect);
+    /// Mark vertex data dirty after tiles of the chunk have changed. Materials are updated immediately.
+    void MarkTilesDirty();
+
+    /// Return tile range of the chunk.
+    const IntRect& GetTileRect() const { return tileRect_; }
+    /// Return number of vertex data rebuilds.
+    unsigned GetNumRebuilds() const { return numRebuilds_; }
+
+protected:
+    /// Handle scene being assigned.
+    void OnSceneSet(Scene* scene) override;
+    /// Recalculate the world-space bounding box.
+    void OnWorldBoundingBoxUpdate() override;
+    /// Handle draw order changed.
+    void OnDrawOrderChanged() override;
+    /// Update source batches.
+    void UpdateSourceBatches() override;
+
+private:
+    /// Create source batch for each run of consecutive tiles with the same texture.
+    void UpdateMaterials();
+
+    /// Tile map layer.
+    WeakPtr<TileMapLayer2D> layer_;
+    /// Tile range.
+    IntRect tileRect_;
+    /// Texture of each source batch. Same texture may be used by several batches.
+    ea::vector<Texture2D*> batchTextures_;
+    /// Number of vertex data rebuilds.
+    unsigned numRebuilds_{};
+};
+
+}
@@ -28,6 +28,7 @@
 #include "../Scene/Node.h"
 #include "../Urho2D/StaticSprite2D.h"
 #include "../Urho2D/TileMap2D.h"
+#include "../Urho2D/TileMapChunk2D.h"
 #include "../Urho2D/TileMapLayer2D.h"
 #include "../Urho2D/TmxFile2D.h"
 
@@ -181,6 +182,8 @@ void TileMapLayer2D::Initialize(TileMap2D* tileMap, const TmxLayer2D* tmxLayer)
         }
 
         nodes_.clear();
+        tileSprites_.clear();
+        chunks_.clear();
     }
 
     tileLayer_ = nullptr;
@@ -221,6 +224,12 @@ void TileMapLayer2D::SetDrawOrder(int drawOrder)
 
     drawOrder_ = drawOrder;
 
+    for (TileMapChunk2D* chunk : chunks_)
+    {
+        if (chunk)
+            chunk->SetLayer(drawOrder_);
+    }
+
     for (unsigned i = 0; i < nodes_.size(); ++i)
     {
         if (!nodes_[i])
@@ -289,7 +298,25 @@ Tile2D* TileMapLayer2D::GetTile(int x, int y) const
     return tileLayer_->GetTile(x, y);
 }
 
-Node* TileMapLayer2D::GetTileNode(int x, int y) const
+void TileMapLayer2D::SetTileSprite(int x, int y, Sprite2D* sprite, bool flipX, bool flipY, bool swapXY)
+{
+    if (!tileLayer_)
+        return;
+
+    if (x < 0 || x >= tileLayer_->GetWidth() || y < 0 || y >= tileLayer_->GetHeight())
+        return;
+
+    TileSprite2D& tile = tileSprites_[y * tileLayer_->GetWidth() + x];
+    tile.sprite_ = sprite;
+    tile.flipX_ = flipX;
+    tile.flipY_ = flipY;
+    tile.swapXY_ = swapXY;
+
+    if (TileMapChunk2D* chunk = GetChunk(x, y))
+        chunk->MarkTilesDirty();
+}
+
+TileMapChunk2D* TileMapLayer2D::GetChunk(int x, int y) const
 {
     if (!tileLayer_)
         return nullptr;
@@ -297,7 +324,8 @@ Node* TileMapLayer2D::GetTileNode(int x, int y) const
     if (x < 0 || x >= tileLayer_->GetWidth() || y < 0 || y >= tileLayer_->GetHeight())
         return nullptr;
 
-    return nodes_[y * tileLayer_->GetWidth() + x];
+    const unsigned index = y / DEFAULT_TILE_MAP_CHUNK_SIZE;
+    return index < chunks_.size() ? chunks_[index].Get() : nullptr;
 }
 
 unsigned TileMapLayer2D::GetNumObjects() const
@@ -341,9 +369,8 @@ void TileMapLayer2D::SetTileLayer(const TmxTileLayer2D* tileLayer)
 
     int width = tileLayer->GetWidth();
     int height = tileLayer->GetHeight();
-    nodes_.resize((unsigned) (width * height));
+    tileSprites_.resize((unsigned) (width * height));
 
-    const TileMapInfo2D& info = tileMap_->GetInfo();
     for (int y = 0; y < height; ++y)
     {
         for (int x = 0; x < width; ++x)
@@ -352,17 +379,33 @@ void TileMapLayer2D::SetTileLayer(const TmxTileLayer2D* tileLayer)
             if (!tile)
                 continue;
 
-            SharedPtr<Node> tileNode(GetNode()->CreateTemporaryChild("Tile"));
-            tileNode->SetPosition(info.TileIndexToPosition(x, y).ToVector3());
+            TileSprite2D& tileSprite = tileSprites_[y * width + x];
+            tileSprite.sprite_ = tile->GetSprite();
+            tileSprite.flipX_ = tile->GetFlipX();
+            tileSprite.flipY_ = tile->GetFlipY();
+            tileSprite.swapXY_ = tile->GetSwapXY();
+        }
+    }
 
-            auto* staticSprite = tileNode->CreateComponent<StaticSprite2D>();
-            staticSprite->SetSprite(tile->GetSprite());
-            staticSprite->SetFlip(tile->GetFlipX(), tile->GetFlipY(), tile->GetSwapXY());
-            staticSprite->SetLayer(drawOrder_);
-            staticSprite->SetOrderInLayer(y * width + x);
+    // Create drawable per chunk instead of node per tile. Chunks span full rows of the layer,
+    // so that drawing chunks one after another keeps the same row-major order as tiles
+    SharedPtr<Node> chunksNode(GetNode()->CreateTemporaryChild("Tiles"));
+    nodes_.push_back(chunksNode);
 
-            nodes_[y * width + x] = tileNode;
-        }
+    const int chunkSize = DEFAULT_TILE_MAP_CHUNK_SIZE;
+    const int numChunks = (height + chunkSize - 1) / chunkSize;
+    chunks_.resize((unsigned) numChunks);
+
+    for (int chunkY = 0; chunkY < numChunks; ++chunkY)
+    {
+        const IntRect tileRect{0, chunkY * chunkSize, width, Min((chunkY + 1) * chunkSize, height)};
+
+        auto* chunk = chunksNode->CreateComponent<TileMapChunk2D>();
+        chunk->SetLayer(drawOrder_);
+        chunk->SetOrderInLayer(chunkY);
+        chunk->Initialize(this, tileRect);
+
+        chunks_[chunkY] = chunk;
     }
 }
 
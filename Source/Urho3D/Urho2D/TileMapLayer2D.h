@@ -34,13 +34,28 @@ namespace Urho3D
 
 class DebugRenderer;
 class Node;
+class Sprite2D;
 class TileMap2D;
+class TileMapChunk2D;
 class TmxImageLayer2D;
 class TmxLayer2D;
 class TmxObjectGroup2D;
 class TmxTileLayer2D;
 
-/// Tile map component.
+/// Sprite of tile layer tile.
+struct TileSprite2D
+{
+    /// Sprite.
+    SharedPtr<Sprite2D> sprite_;
+    /// Flip X.
+    bool flipX_{};
+    /// Flip Y.
+    bool flipY_{};
+    /// Swap X and Y.
+    bool swapXY_{};
+};
+
+/// Tile map component. Tiles of tile layer are rendered in chunks by TileMapChunk2D components of single child node.
 class URHO3D_API TileMapLayer2D : public Component
 {
     URHO3D_OBJECT(TileMapLayer2D, Component);
@@ -94,10 +109,19 @@ public:
     /// Return height (for tile layer only).
     /// @property
     int GetHeight() const;
-    /// Return tile node (for tile layer only).
-    Node* GetTileNode(int x, int y) const;
+    /// Deprecated. Tiles are rendered in chunks and have no nodes, always return null.
+    Node* GetTileNode(int x, int y) const { return nullptr; }
     /// Return tile (for tile layer only).
     Tile2D* GetTile(int x, int y) const;
+    /// Set rendered sprite of the tile. Only the chunk that contains the tile is rebuilt (for tile layer only).
+    void SetTileSprite(int x, int y, Sprite2D* sprite, bool flipX = false, bool flipY = false, bool swapXY = false);
+    /// Return rendered sprite of the tile. Tile should be inside of the layer (for tile layer only).
+    const TileSprite2D& GetTileSprite(int x, int y) const { return tileSprites_[y * GetWidth() + x]; }
+    /// Return number of render chunks (for tile layer only).
+    /// @property
+    unsigned GetNumChunks() const { return chunks_.size(); }
+    /// Return render chunk that contains the tile (for tile layer only).
+    TileMapChunk2D* GetChunk(int x, int y) const;
 
     /// Return number of tile map objects (for object group only).
     /// @property
@@ -133,8 +157,12 @@ private:
     int drawOrder_{};
     /// Visible.
     bool visible_{true};
-    /// Tile node or image nodes.
+    /// Chunks node, object nodes or image node.
     ea::vector<SharedPtr<Node> > nodes_;
+    /// Tile sprites (for tile layer only).
+    ea::vector<TileSprite2D> tileSprites_;
+    /// Render chunks, one per row strip of the layer (for tile layer only).
+    ea::vector<WeakPtr<TileMapChunk2D> > chunks_;
 };
 
 }
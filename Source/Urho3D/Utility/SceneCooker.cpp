@@ -0,0 +1,64 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#include "Urho3D/Precompiled.h"
+
+#include "Urho3D/Utility/SceneCooker.h"
+
+#include "Urho3D/Core/Context.h"
+#include "Urho3D/IO/File.h"
+#include "Urho3D/IO/FileSystem.h"
+#include "Urho3D/IO/Log.h"
+#include "Urho3D/Resource/ResourceCache.h"
+#include "Urho3D/Scene/Scene.h"
+#include "Urho3D/Scene/SceneResource.h"
+
+#include "Urho3D/DebugNew.h"
+
+namespace Urho3D
+{
+
+SceneCooker::SceneCooker(Context* context)
+    : AssetTransformer(context)
+{
+}
+
+void SceneCooker::RegisterObject(Context* context)
+{
+    context->RegisterFactory<SceneCooker>(Category_Transformer);
+}
+
+bool SceneCooker::IsApplicable(const AssetTransformerInput& input)
+{
+    return input.inputFileName_.ends_with(".scene", false);
+}
+
+bool SceneCooker::Execute(
+    const AssetTransformerInput& input, AssetTransformerOutput& output, const AssetTransformerVector& transformers)
+{
+    auto cache = GetSubsystem<ResourceCache>();
+    auto fs = GetSubsystem<FileSystem>();
+
+    auto sceneResource = cache->GetTempResource<SceneResource>(input.resourceName_);
+    if (!sceneResource)
+    {
+        URHO3D_LOGERROR("Failed to load scene {}", input.resourceName_);
+        return false;
+    }
+
+    const ea::string outputFileName =
+        AddTrailingSlash(input.outputFileName_) + GetFileName(input.resourceName_) + ".cscn";
+    fs->CreateDirsRecursive(GetPath(outputFileName));
+
+    File file(context_, outputFileName, FILE_WRITE);
+    if (!file.IsOpen() || !sceneResource->GetScene()->SaveCooked(file))
+    {
+        URHO3D_LOGERROR("Failed to save cooked scene {}", outputFileName);
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace Urho3D
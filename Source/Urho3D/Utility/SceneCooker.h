@@ -0,0 +1,27 @@
+// Copyright (c) 2023-2023 the rbfx project.
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT> or the accompanying LICENSE file.
+
+#pragma once
+
+#include "Urho3D/Utility/AssetTransformer.h"
+
+namespace Urho3D
+{
+
+/// Asset transformer that saves scenes in cooked binary format, see SaveCookedScene.
+/// Cooked scene is written next to other outputs of the asset as "<scene name>.cscn".
+class URHO3D_API SceneCooker : public AssetTransformer
+{
+    URHO3D_OBJECT(SceneCooker, AssetTransformer);
+
+public:
+    explicit SceneCooker(Context* context);
+    static void RegisterObject(Context* context);
+
+    bool IsApplicable(const AssetTransformerInput& input) override;
+    bool Execute(const AssetTransformerInput& input, AssetTransformerOutput& output,
+        const AssetTransformerVector& transformers) override;
+};
+
+} // namespace Urho3D
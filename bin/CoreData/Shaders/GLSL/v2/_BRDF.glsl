@@ -100,7 +100,7 @@ half4 Indirect_PBRWater(half3 reflectionColor, half3 specular, half NoV)
 
 #endif // URHO3D_AMBIENT_PASS
 
-#ifdef URHO3D_LIGHT_PASS
+#if defined(URHO3D_LIGHT_PASS) || defined(URHO3D_CLUSTERED_LIGHTS)
 
 /// Evaluate Blinn-Phong BRDF.
 half BRDF_Direct_BlinnPhongSpecular(half3 normal, half3 halfVec, half specularPower)
@@ -183,7 +183,7 @@ half3 Direct_PBR(half3 lightColor, half3 albedo, half3 specular, half roughness,
 
 #endif // URHO3D_PHYSICAL_MATERIAL
 
-#endif // URHO3D_LIGHT_PASS
+#endif // defined(URHO3D_LIGHT_PASS) || defined(URHO3D_CLUSTERED_LIGHTS)
 
 #endif // URHO3D_IS_LIT
 
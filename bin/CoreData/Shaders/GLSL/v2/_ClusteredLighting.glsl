@@ -0,0 +1,92 @@
+#ifndef _CLUSTERED_LIGHTING_GLSL_
+#define _CLUSTERED_LIGHTING_GLSL_
+
+#ifndef _UNIFORMS_GLSL_
+    #error Include _Uniforms.glsl before _ClusteredLighting.glsl
+#endif
+
+#if defined(URHO3D_CLUSTERED_LIGHTS) && defined(URHO3D_PIXEL_SHADER)
+
+/// Light cluster headers followed by light indices packed by four.
+/// Cluster header: x - offset of the first light index, y - number of lights.
+SAMPLER_HIGHP(11, sampler2D sLightClusters)
+/// Light data, four texels per light:
+/// 0: xyz - color in current color space, w - specular intensity.
+/// 1: xyz - position in world space, w - inverse range.
+/// 2: xyz - direction in world space, w - spot cutoff.
+/// 3: x - inverse spot cutoff, yzw - unused. Point lights have cutoff parameters that never attenuate.
+SAMPLER_HIGHP(12, sampler2D sClusteredLights)
+
+/// Width of cluster textures. Keep in sync with LightClusterGrid::TextureWidth.
+#define URHO3D_CLUSTER_TEXTURE_WIDTH 1024
+
+/// Fetch texel of cluster texture by linear index.
+#define FetchClusterTexel(texture, index) \
+    texelFetch(texture, ivec2((index) % URHO3D_CLUSTER_TEXTURE_WIDTH, (index) / URHO3D_CLUSTER_TEXTURE_WIDTH), 0)
+
+/// Clustered light data unpacked from light texture.
+struct ClusteredLightData
+{
+    /// Light color, including spot attenuation.
+    half3 lightColor;
+    /// Normalized light vector. w component is normalized distance to light.
+    half4 lightVec;
+    /// Specular intensity of the light.
+    half specularIntensity;
+};
+
+/// Return index of the cluster containing given world position with given linear depth.
+int GetLightClusterIndex(vec3 worldPos, float depth)
+{
+    vec4 clipPos = vec4(worldPos, 1.0) * cClusterViewProj;
+    vec2 tilePos = (clipPos.xy / clipPos.w * 0.5 + 0.5) * cClusterGridSize.xy;
+    ivec2 tile = clamp(ivec2(floor(tilePos)), ivec2(0), ivec2(cClusterGridSize.xy) - 1);
+
+    float sliceDepth = cClusterDepthParams.z > 0.5 ? depth : log(max(depth, 1e-6));
+    int slice = int(floor(sliceDepth * cClusterDepthParams.x + cClusterDepthParams.y));
+    slice = clamp(slice, 0, int(cClusterGridSize.z) - 1);
+
+    return (slice * int(cClusterGridSize.y) + tile.y) * int(cClusterGridSize.x) + tile.x;
+}
+
+/// Return index of the light at given position in cluster light list.
+int GetClusteredLightIndex(int numClusters, int lightListIndex)
+{
+    vec4 packedIndices = FetchClusterTexel(sLightClusters, numClusters + lightListIndex / 4);
+    int component = lightListIndex % 4;
+    float index = component == 0 ? packedIndices.x
+        : component == 1 ? packedIndices.y
+        : component == 2 ? packedIndices.z : packedIndices.w;
+    return int(index);
+}
+
+/// Fetch light data and evaluate light vector and color for given world position.
+ClusteredLightData GetClusteredLightData(int lightIndex, vec3 worldPos)
+{
+    int firstTexel = lightIndex * 4;
+    vec4 colorAndSpecular = FetchClusterTexel(sClusteredLights, firstTexel);
+    vec4 positionAndInvRange = FetchClusterTexel(sClusteredLights, firstTexel + 1);
+    vec4 directionAndCutoff = FetchClusterTexel(sClusteredLights, firstTexel + 2);
+    vec4 inverseCutoff = FetchClusterTexel(sClusteredLights, firstTexel + 3);
+
+    half3 lightVec = (positionAndInvRange.xyz - worldPos) * positionAndInvRange.w;
+    half lightDist = max(0.001, length(lightVec));
+
+    ClusteredLightData result;
+    result.lightVec = vec4(lightVec / lightDist, lightDist);
+    result.specularIntensity = colorAndSpecular.w;
+    half spotFactor = (dot(result.lightVec.xyz, directionAndCutoff.xyz) - directionAndCutoff.w) * inverseCutoff.x;
+    result.lightColor = colorAndSpecular.rgb * clamp(spotFactor, 0.0, 1.0);
+    return result;
+}
+
+/// Return light attenuation caused by distance.
+half GetClusteredLightAttenuation(ClusteredLightData lightData)
+{
+    half invDistance = max(0.0, 1.0 - lightData.lightVec.w);
+    return invDistance * invDistance;
+}
+
+#endif // defined(URHO3D_CLUSTERED_LIGHTS) && defined(URHO3D_PIXEL_SHADER)
+
+#endif // _CLUSTERED_LIGHTING_GLSL_
@@ -110,6 +110,26 @@
 
         #endif // URHO3D_LIGHT_PASS
 
+        #if defined(URHO3D_AMBIENT_PASS) && defined(URHO3D_CLUSTERED_LIGHTS)
+
+            #if !defined(URHO3D_SURFACE_VOLUMETRIC)
+                #ifndef URHO3D_SURFACE_NEED_NORMAL
+                    #define URHO3D_SURFACE_NEED_NORMAL
+                #endif
+            #endif
+
+            #ifndef URHO3D_PIXEL_NEED_WORLD_POSITION
+                #define URHO3D_PIXEL_NEED_WORLD_POSITION
+            #endif
+
+            #if URHO3D_SPECULAR > 0
+                #ifndef URHO3D_PIXEL_NEED_EYE_VECTOR
+                    #define URHO3D_PIXEL_NEED_EYE_VECTOR
+                #endif
+            #endif
+
+        #endif // URHO3D_AMBIENT_PASS && URHO3D_CLUSTERED_LIGHTS
+
         #if defined(URHO3D_PHYSICAL_MATERIAL) || defined(URHO3D_GBUFFER_PASS)
             #ifndef URHO3D_SURFACE_NEED_NORMAL
                 #define URHO3D_SURFACE_NEED_NORMAL
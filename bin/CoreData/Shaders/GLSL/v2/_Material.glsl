@@ -25,6 +25,7 @@
 #include "_IndirectLighting.glsl"
 #include "_DirectLighting.glsl"
 #include "_Shadow.glsl"
+#include "_ClusteredLighting.glsl"
 #endif
 #include "_Fog.glsl"
 
@@ -92,6 +92,46 @@
     }
 #endif
 
+#if defined(URHO3D_AMBIENT_PASS) && defined(URHO3D_CLUSTERED_LIGHTS)
+    /// Calculate lighting from all lights of the light cluster containing the pixel.
+    half3 CalculateClusteredLighting(SurfaceData surfaceData)
+    {
+        int numClusters = int(cClusterGridSize.x * cClusterGridSize.y * cClusterGridSize.z);
+        vec4 clusterHeader = FetchClusterTexel(sLightClusters, GetLightClusterIndex(vWorldPos, vWorldDepth));
+        int lightListOffset = int(clusterHeader.x);
+        int numLights = int(clusterHeader.y);
+
+        half3 result = vec3(0.0);
+        for (int i = 0; i < numLights; ++i)
+        {
+            int lightIndex = GetClusteredLightIndex(numClusters, lightListOffset + i);
+            ClusteredLightData lightData = GetClusteredLightData(lightIndex, vWorldPos);
+
+        #if defined(URHO3D_PHYSICAL_MATERIAL) || URHO3D_SPECULAR > 0
+            half3 halfVec = normalize(surfaceData.eyeVec + lightData.lightVec.xyz);
+        #endif
+
+        #if defined(URHO3D_SURFACE_VOLUMETRIC)
+            half3 lightColor = Direct_Volumetric(lightData.lightColor, surfaceData.albedo.rgb);
+        #elif defined(URHO3D_PHYSICAL_MATERIAL)
+            half3 lightColor = Direct_PBR(lightData.lightColor, surfaceData.albedo.rgb,
+                surfaceData.specular, surfaceData.roughness,
+                lightData.lightVec.xyz, surfaceData.normal, surfaceData.eyeVec, halfVec);
+        #elif URHO3D_SPECULAR > 0
+            half3 lightColor = Direct_SimpleSpecular(lightData.lightColor,
+                surfaceData.albedo.rgb, surfaceData.specular,
+                lightData.lightVec.xyz, surfaceData.normal, halfVec,
+                RoughnessToSpecularPower(surfaceData.roughness), lightData.specularIntensity);
+        #else
+            half3 lightColor = Direct_Simple(lightData.lightColor,
+                surfaceData.albedo.rgb, lightData.lightVec.xyz, surfaceData.normal);
+        #endif
+            result += lightColor * GetClusteredLightAttenuation(lightData);
+        }
+        return result;
+    }
+#endif
+
 /// Return color with applied lighting, but without fog.
 /// Fills all channels of geometry buffer except destination color.
 half3 GetSurfaceColor(SurfaceData surfaceData)
@@ -108,6 +148,9 @@ half3 GetSurfaceColor(SurfaceData surfaceData)
     gl_FragData[3] = vec4(surfaceData.normal * 0.5 + 0.5, 0.0);
 #elif defined(URHO3D_LIGHT_PASS)
     surfaceColor += CalculateDirectLighting(surfaceData);
+#endif
+#if defined(URHO3D_AMBIENT_PASS) && defined(URHO3D_CLUSTERED_LIGHTS)
+    surfaceColor += CalculateClusteredLighting(surfaceData);
 #endif
     return surfaceColor;
 }
@@ -70,6 +70,19 @@ UNIFORM_BUFFER_BEGIN(1, Camera)
     UNIFORM(half3 cFogColor)
     /// Scale of normal shadow bias.
     UNIFORM(half cNormalOffsetScale)
+#ifdef URHO3D_CLUSTERED_LIGHTS
+    /// World to clip space matrix used to build light clusters.
+    UNIFORM_HIGHP(mat4 cClusterViewProj)
+    /// xyz: Number of light clusters along screen width, screen height and view depth.
+    /// w: Unused.
+    UNIFORM_HIGHP(vec4 cClusterGridSize)
+    /// Factors used to convert linear depth to cluster slice.
+    /// x: Scale applied to depth (or log of depth for perspective projection).
+    /// y: Offset applied after scale.
+    /// z: 1 for orthographic projection, 0 for perspective projection.
+    /// w: Unused.
+    UNIFORM_HIGHP(vec4 cClusterDepthParams)
+#endif
 UNIFORM_BUFFER_END(1, Camera)
 
 /// Zone: Reflection probe parameters.